@@ -60,6 +60,12 @@
 
 #define CHIP_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE 0
 
+// Keep the most used scene table records in memory (see DefaultSceneTableImpl).
+#define CHIP_CONFIG_SCENES_TABLE_CACHE_SIZE 4
+
+// Count per-session and per-exchange traffic (see SessionManager::GetFabricTrafficCounters).
+#define CHIP_CONFIG_ENABLE_TRAFFIC_COUNTERS 1
+
 #ifndef CHIP_DEVICE_CONFIG_DYNAMIC_ENDPOINT_COUNT
 #define CHIP_DEVICE_CONFIG_DYNAMIC_ENDPOINT_COUNT 4
 #endif
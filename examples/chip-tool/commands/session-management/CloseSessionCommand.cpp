@@ -20,6 +20,8 @@
 #include <protocols/secure_channel/StatusReport.h>
 #include <system/SystemPacketBuffer.h>
 
+#include <inttypes.h>
+
 using namespace chip;
 using namespace chip::Protocols;
 
@@ -93,6 +95,34 @@ void SendCloseSessionCommand::OnDeviceConnectionFailureFn(void * context, const
     command->SetCommandExitStatus(err);
 }
 
+namespace {
+
+void LogTrafficCounters(const char * label, const Transport::TrafficCounters & counters)
+{
+    ChipLogProgress(chipTool,
+                    "%s: tx %" PRIu32 " msgs/%" PRIu64 " B, rx %" PRIu32 " msgs/%" PRIu64 " B, retrans %" PRIu32
+                    ", auth failures %" PRIu32 ", crypto %" PRIu64 " us",
+                    label, counters.GetMessagesSent(), counters.GetBytesSent(), counters.GetMessagesReceived(),
+                    counters.GetBytesReceived(), counters.GetRetransmissions(), counters.GetAuthenticationFailures(),
+                    counters.GetCryptoTime().count());
+}
+
+} // namespace
+
+CHIP_ERROR ShowTrafficCommand::RunCommand()
+{
+    auto & controller   = CurrentCommissioner();
+    auto sessionManager = controller.SessionMgr();
+
+    ScopedNodeId peer(mDestinationNodeId, controller.GetFabricIndex());
+
+    LogTrafficCounters("Node", sessionManager->GetPeerTrafficCounters(peer));
+    LogTrafficCounters("Fabric", sessionManager->GetFabricTrafficCounters(controller.GetFabricIndex()));
+
+    SetCommandExitStatus(CHIP_NO_ERROR);
+    return CHIP_NO_ERROR;
+}
+
 CHIP_ERROR EvictLocalCASESessionsCommand::RunCommand()
 {
     auto & controller   = CurrentCommissioner();
@@ -76,6 +76,24 @@ private:
     chip::Callback::Callback<chip::OnDeviceConnectionFailure> mOnDeviceConnectionFailureCallback;
 };
 
+class ShowTrafficCommand : public detail::SessionManagementCommand
+{
+public:
+    ShowTrafficCommand(CredentialIssuerCommands * credIssuerCommands) :
+        detail::SessionManagementCommand("show-traffic", credIssuerCommands,
+                                         "Shows traffic counters of the local sessions to the given node id and of the current "
+                                         "fabric.")
+    {}
+
+    /////////// CHIPCommand Interface /////////
+    CHIP_ERROR RunCommand() override;
+    chip::System::Clock::Timeout GetWaitDuration() const override
+    {
+        // This command does all its work synchronously, so it really does not matter too much.
+        return chip::System::Clock::Seconds16(5);
+    }
+};
+
 class EvictLocalCASESessionsCommand : public detail::SessionManagementCommand
 {
 public:
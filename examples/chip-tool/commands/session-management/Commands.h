@@ -28,6 +28,7 @@ void registerCommandsSessionManagement(Commands & commands, CredentialIssuerComm
     commands_list clusterCommands = {
         make_unique<SendCloseSessionCommand>(credsIssuerConfig),
         make_unique<EvictLocalCASESessionsCommand>(credsIssuerConfig),
+        make_unique<ShowTrafficCommand>(credsIssuerConfig),
     };
 
     commands.RegisterCommandSet(clusterName, clusterCommands, "Commands for managing CASE and PASE session state.");
@@ -0,0 +1,44 @@
+/*
+ *   Copyright (c) 2024 Project CHIP Authors
+ *   All rights reserved.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ *
+ */
+
+#include <lib/core/ErrorStr.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <tracing/binary/trace_converter.h>
+
+#include <cstdio>
+#include <cstdlib>
+
+int main(int argc, char * argv[])
+{
+    if (argc != 3)
+    {
+        fprintf(stderr, "Usage: %s <binary trace> <output.json>\n", argv[0]);
+        fprintf(stderr, "Converts a trace recorded with --trace-to binary:<path> into Chrome trace JSON,\n"
+                        "loadable in chrome://tracing or https://ui.perfetto.dev.\n");
+        return EXIT_FAILURE;
+    }
+
+    CHIP_ERROR err = chip::Tracing::Binary::ConvertToChromeJson(argv[1], argv[2]);
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(NotSpecified, "Can not convert %s: %s", argv[1], chip::ErrorStr(err));
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -19,6 +19,7 @@
 
 #include <lib/support/StringSplitter.h>
 #include <lib/support/logging/CHIPLogging.h>
+#include <tracing/binary/binary_tracing.h>
 #include <tracing/json/json_tracing.h>
 #include <tracing/registry.h>
 
@@ -74,6 +75,20 @@ void TracingSetup::EnableTracingFor(const char * cliArg)
             }
             chip::Tracing::Register(mJsonBackend);
         }
+        else if (StartsWith(value, "binary:"))
+        {
+            std::string fileName(value.data() + 7, value.size() - 7);
+
+            CHIP_ERROR err = mBinaryBackend.OpenFile(fileName.c_str());
+            if (err != CHIP_NO_ERROR)
+            {
+                ChipLogError(AppServer, "Failed to open binary trace output: %" CHIP_ERROR_FORMAT, err.Format());
+            }
+            else
+            {
+                chip::Tracing::Register(mBinaryBackend);
+            }
+        }
 #if ENABLE_PERFETTO_TRACING
         else if (value.data_equal(CharSpan::fromCharString("perfetto")))
         {
@@ -113,6 +128,7 @@ void TracingSetup::StopTracing()
 #endif
 
     chip::Tracing::Unregister(mJsonBackend);
+    chip::Tracing::Unregister(mBinaryBackend);
 }
 
 } // namespace CommandLineApp
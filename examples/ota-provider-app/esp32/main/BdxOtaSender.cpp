@@ -23,6 +23,7 @@
 #include <messaging/ExchangeContext.h>
 #include <messaging/Flags.h>
 #include <protocols/bdx/BdxTransferSession.h>
+#include <system/SystemClock.h>
 
 using chip::bdx::StatusCode;
 using chip::bdx::TransferControlFlags;
@@ -37,6 +38,12 @@ CHIP_ERROR BdxOtaSender::InitializeTransfer(chip::FabricIndex fabricIndex, chip:
         {
             Reset();
         }
+        // Reset the transfer of a Requestor whose slot was given to another one by the scheduler
+        else if (mTransferScheduler != nullptr &&
+                 mTransferScheduler->GetSlot(GetRequestor()) == chip::ota::OTATransferScheduler::kNoSlot)
+        {
+            Reset();
+        }
         // Prevent a new node connection since another is active
         else if ((mFabricIndex.HasValue() && mFabricIndex.Value() != fabricIndex) ||
                  (mNodeId.HasValue() && mNodeId.Value() != nodeId))
@@ -96,7 +103,7 @@ void BdxOtaSender::HandleTransferSessionOutput(TransferSession::OutputEvent & ev
         else
         {
             ChipLogError(BDX, "SendMessage failed: %" CHIP_ERROR_FORMAT, err.Format());
-            Reset();
+            EndTransfer(false);
         }
         break;
     }
@@ -160,6 +167,10 @@ void BdxOtaSender::HandleTransferSessionOutput(TransferSession::OutputEvent & ev
             ChipLogError(BDX, "PrepareBlock failed: %" CHIP_ERROR_FORMAT, err.Format());
             mTransfer.AbortTransfer(StatusCode::kUnknown);
         }
+        else if (mTransferScheduler != nullptr)
+        {
+            mTransferScheduler->OnBlockSent(GetRequestor(), blockData.Length, chip::System::SystemClock().GetMonotonicTimestamp());
+        }
         break;
     }
     case TransferSession::OutputEventType::kAckReceived:
@@ -174,7 +185,7 @@ void BdxOtaSender::HandleTransferSessionOutput(TransferSession::OutputEvent & ev
         {
             ChipLogError(BDX, "onTransferComplete Callback not set");
         }
-        Reset();
+        EndTransfer(true);
         break;
     case TransferSession::OutputEventType::kStatusReceived:
         ChipLogError(BDX, "Got StatusReport %x", static_cast<uint16_t>(event.statusData.statusCode));
@@ -186,7 +197,7 @@ void BdxOtaSender::HandleTransferSessionOutput(TransferSession::OutputEvent & ev
         {
             ChipLogError(BDX, "onTransferFailed Callback not set");
         }
-        Reset();
+        EndTransfer(false);
         break;
     case TransferSession::OutputEventType::kInternalError:
         ChipLogError(BDX, "InternalError");
@@ -197,7 +208,7 @@ void BdxOtaSender::HandleTransferSessionOutput(TransferSession::OutputEvent & ev
         {
             ChipLogError(BDX, "onTransferFailed Callback not set");
         }
-        Reset();
+        EndTransfer(false);
         break;
     case TransferSession::OutputEventType::kTransferTimeout:
         ChipLogError(BDX, "Transfer timed out");
@@ -208,7 +219,7 @@ void BdxOtaSender::HandleTransferSessionOutput(TransferSession::OutputEvent & ev
         {
             ChipLogError(BDX, "onTransferFailed Callback not set");
         }
-        Reset();
+        EndTransfer(false);
         break;
     case TransferSession::OutputEventType::kAcceptReceived:
     case TransferSession::OutputEventType::kBlockReceived:
@@ -218,6 +229,20 @@ void BdxOtaSender::HandleTransferSessionOutput(TransferSession::OutputEvent & ev
     }
 }
 
+void BdxOtaSender::EndTransfer(bool completed)
+{
+    if (mTransferScheduler != nullptr)
+    {
+        mTransferScheduler->OnTransferEnded(GetRequestor(), completed, chip::System::SystemClock().GetMonotonicTimestamp());
+    }
+    Reset();
+}
+
+chip::ScopedNodeId BdxOtaSender::GetRequestor() const
+{
+    return chip::ScopedNodeId(mNodeId.ValueOr(chip::kUndefinedNodeId), mFabricIndex.ValueOr(chip::kUndefinedFabricIndex));
+}
+
 /* Reset() calls bdx::TransferSession::Reset() which sets the output event type to
  * TransferSession::OutputEventType::kNone. So, bdx::TransferFacilitator::PollForOutput()
  * will call HandleTransferSessionOutput() with event TransferSession::OutputEventType::kNone.
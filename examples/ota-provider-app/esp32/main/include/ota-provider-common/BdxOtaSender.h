@@ -15,6 +15,7 @@
  *    limitations under the License.
  */
 
+#include <app/clusters/ota-provider/OTATransferScheduler.h>
 #include <protocols/bdx/BdxTransferSession.h>
 #include <protocols/bdx/TransferFacilitator.h>
 
@@ -78,6 +79,9 @@ public:
 
     void SetCallbacks(BdxOtaSenderCallbacks callbacks);
 
+    // Reports the Blocks sent and the end of the transfers to the scheduler that admitted them.
+    void SetTransferScheduler(chip::ota::OTATransferScheduler * scheduler) { mTransferScheduler = scheduler; }
+
     /**
      * @brief
      *   Get negotiated bdx tranfer block size
@@ -108,6 +112,11 @@ private:
 
     void Reset();
 
+    // Reports the end of the transfer to the scheduler, then resets it.
+    void EndTransfer(bool completed);
+
+    chip::ScopedNodeId GetRequestor() const;
+
     uint32_t mNumBytesSent = 0;
 
     bool mInitialized = false;
@@ -120,6 +129,8 @@ private:
     chip::Callback::Callback<OnBdxTransferComplete> * mOnTransferCompleteCallback = nullptr;
     chip::Callback::Callback<OnBdxTransferFailed> * mOnTransferFailedCallback     = nullptr;
 
+    chip::ota::OTATransferScheduler * mTransferScheduler = nullptr;
+
     // Maximum file designator length
     static constexpr uint8_t kMaxFDLen = 30;
     // Null-terminated string representing file designator
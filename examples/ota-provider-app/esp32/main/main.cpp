@@ -84,9 +84,9 @@ static void InitServer(intptr_t context)
     BdxOtaSender * bdxOtaSender = otaProvider.GetBdxOtaSender();
     VerifyOrReturn(bdxOtaSender != nullptr, ESP_LOGE(TAG, "bdxOtaSender is nullptr"));
 
-    // Register handler to handle bdx messages
+    // Register handler to handle bdx messages, which the provider dispatches to the sender of their requestor
     CHIP_ERROR error = chip::Server::GetInstance().GetExchangeManager().RegisterUnsolicitedMessageHandlerForProtocol(
-        chip::Protocols::BDX::Id, bdxOtaSender);
+        chip::Protocols::BDX::Id, &otaProvider);
     if (error != CHIP_NO_ERROR)
     {
         ESP_LOGE(TAG, "RegisterUnsolicitedMessageHandler failed: %" CHIP_ERROR_FORMAT, error.Format());
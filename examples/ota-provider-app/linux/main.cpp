@@ -47,6 +47,7 @@ constexpr uint16_t kOptionUpdateAction              = 'a';
 constexpr uint16_t kOptionUserConsentNeeded         = 'c';
 constexpr uint16_t kOptionFilepath                  = 'f';
 constexpr uint16_t kOptionImageUri                  = 'i';
+constexpr uint16_t kOptionMaxConcurrentTransfers    = 'm';
 constexpr uint16_t kOptionOtaImageList              = 'o';
 constexpr uint16_t kOptionDelayedApplyActionTimeSec = 'p';
 constexpr uint16_t kOptionQueryImageStatus          = 'q';
@@ -72,6 +73,7 @@ static bool gUserConsentNeeded                       = false;
 static uint32_t gIgnoreQueryImageCount               = 0;
 static uint32_t gIgnoreApplyUpdateCount              = 0;
 static uint32_t gPollInterval                        = 0;
+static uint8_t gMaxConcurrentTransfers               = 1;
 
 // Parses the JSON filepath and extracts DeviceSoftwareVersionModel parameters
 static bool ParseJsonFileAndPopulateCandidates(const char * filepath,
@@ -245,6 +247,18 @@ bool HandleOptions(const char * aProgram, OptionSet * aOptions, int aIdentifier,
     case kOptionPollInterval:
         gPollInterval = static_cast<uint32_t>(strtoul(aValue, NULL, 0));
         break;
+    case kOptionMaxConcurrentTransfers: {
+        const unsigned long count = strtoul(aValue, NULL, 0);
+        if (count == 0 || count > chip::ota::OTATransferScheduler::kMaxConcurrentTransfers)
+        {
+            PrintArgError("%s: ERROR: maxConcurrentTransfers must be between 1 and %u\n", aProgram,
+                          static_cast<unsigned>(chip::ota::OTATransferScheduler::kMaxConcurrentTransfers));
+            retval = false;
+            break;
+        }
+        gMaxConcurrentTransfers = static_cast<uint8_t>(count);
+        break;
+    }
 
     default:
         PrintArgError("%s: INTERNAL ERROR: Unhandled option: %s\n", aProgram, aName);
@@ -268,6 +282,7 @@ OptionDef cmdLineOptionsDef[] = {
     { "ignoreQueryImage", chip::ArgParser::kArgumentRequired, kOptionIgnoreQueryImage },
     { "ignoreApplyUpdate", chip::ArgParser::kArgumentRequired, kOptionIgnoreApplyUpdate },
     { "pollInterval", chip::ArgParser::kArgumentRequired, kOptionPollInterval },
+    { "maxConcurrentTransfers", chip::ArgParser::kArgumentRequired, kOptionMaxConcurrentTransfers },
     {},
 };
 
@@ -285,6 +300,10 @@ OptionSet cmdLineOptions = { HandleOptions, cmdLineOptionsDef, "PROGRAM OPTIONS"
                              "  -i, --imageUri <uri>\n"
                              "        Value for the ImageURI field in the QueryImageResponse.\n"
                              "        If none is supplied, a valid URI is generated.\n"
+                             "  -m, --maxConcurrentTransfers <count>\n"
+                             "        Number of OTA Requestors that may download an image at the same time.\n"
+                             "        The others are told when to query again based on the transfers in progress.\n"
+                             "        Defaults to 1.\n"
                              "  -o, --otaImageList <file path>\n"
                              "        Path to a file containing a list of OTA images\n"
                              "  -p, --delayedApplyActionTimeSec <time in seconds>\n"
@@ -316,10 +335,9 @@ void ApplicationInit()
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
 
-    BdxOtaSender * bdxOtaSender = gOtaProvider.GetBdxOtaSender();
-    VerifyOrReturn(bdxOtaSender != nullptr);
+    // The provider dispatches the BDX messages to the BdxOtaSender of their Requestor
     err = chip::Server::GetInstance().GetExchangeManager().RegisterUnsolicitedMessageHandlerForProtocol(chip::Protocols::BDX::Id,
-                                                                                                        bdxOtaSender);
+                                                                                                        &gOtaProvider);
     if (err != CHIP_NO_ERROR)
     {
         ChipLogDetail(SoftwareUpdate, "RegisterUnsolicitedMessageHandler failed: %s", chip::ErrorStr(err));
@@ -361,6 +379,8 @@ void ApplicationInit()
         gOtaProvider.SetPollInterval(gPollInterval);
     }
 
+    VerifyOrDie(gOtaProvider.SetMaxConcurrentTransfers(gMaxConcurrentTransfers) == CHIP_NO_ERROR);
+
     ChipLogDetail(SoftwareUpdate, "Using ImageList file: %s", gOtaImageListFilepath ? gOtaImageListFilepath : "(none)");
 
     if (gOtaImageListFilepath != nullptr)
@@ -23,8 +23,7 @@
 #include <messaging/ExchangeContext.h>
 #include <messaging/Flags.h>
 #include <protocols/bdx/BdxTransferSession.h>
-
-#include <fstream>
+#include <system/SystemClock.h>
 
 using chip::bdx::StatusCode;
 using chip::bdx::TransferControlFlags;
@@ -44,6 +43,12 @@ CHIP_ERROR BdxOtaSender::InitializeTransfer(chip::FabricIndex fabricIndex, chip:
         {
             Reset();
         }
+        // Reset the transfer of a Requestor whose slot was given to another one by the scheduler
+        else if (mTransferScheduler != nullptr &&
+                 mTransferScheduler->GetSlot(GetRequestor()) == chip::ota::OTATransferScheduler::kNoSlot)
+        {
+            Reset();
+        }
         // Prevent a new node connection since another is active
         else if ((mFabricIndex.HasValue() && mFabricIndex.Value() != fabricIndex) ||
                  (mNodeId.HasValue() && mNodeId.Value() != nodeId))
@@ -97,7 +102,7 @@ void BdxOtaSender::HandleTransferSessionOutput(TransferSession::OutputEvent & ev
         else
         {
             ChipLogError(BDX, "SendMessage failed: %" CHIP_ERROR_FORMAT, err.Format());
-            Reset();
+            EndTransfer(false);
         }
 
         break;
@@ -126,7 +131,6 @@ void BdxOtaSender::HandleTransferSessionOutput(TransferSession::OutputEvent & ev
     }
     case TransferSession::OutputEventType::kQueryReceived:
     case TransferSession::OutputEventType::kQueryWithSkipReceived: {
-        TransferSession::BlockData blockData;
         uint16_t blockSize   = mTransfer.GetTransferBlockSize();
         uint16_t bytesToRead = blockSize;
         uint64_t bytesToSkip = 0;
@@ -144,69 +148,63 @@ void BdxOtaSender::HandleTransferSessionOutput(TransferSession::OutputEvent & ev
             bytesToRead = static_cast<uint16_t>(mTransfer.GetTransferLength() - seekOffset);
         }
 
-        chip::System::PacketBufferHandle blockBuf = chip::System::PacketBufferHandle::New(bytesToRead);
-        if (blockBuf.IsNull())
+        if (!mImage)
         {
-            // TODO(#13981): AbortTransfer() needs to support GeneralStatusCode failures as well as BDX specific errors.
-            mTransfer.AbortTransfer(StatusCode::kUnknown);
-            return;
-        }
-
-        std::ifstream otaFile(mFileDesignator, std::ifstream::in);
-        if (!otaFile.good())
-        {
-            ChipLogError(BDX, "OTA file open failed");
-            mTransfer.AbortTransfer(StatusCode::kFileDesignatorUnknown);
-            return;
+            mImage = SharedOtaImage::Open(mFileDesignator);
+            if (!mImage)
+            {
+                ChipLogError(BDX, "OTA file open failed");
+                mTransfer.AbortTransfer(StatusCode::kFileDesignatorUnknown);
+                return;
+            }
         }
 
-        if (seekOffset > static_cast<uint64_t>(std::numeric_limits<std::streamoff>::max()))
-        {
-            ChipLogError(BDX, "Seek offset too large");
-            mTransfer.AbortTransfer(StatusCode::kLengthTooLarge);
-            return;
-        }
-        otaFile.seekg(static_cast<std::streamoff>(seekOffset));
-        otaFile.read(reinterpret_cast<char *>(blockBuf->Start()), bytesToRead);
-        if (!(otaFile.good() || otaFile.eof()))
+        // The data is read from the file straight into the buffer of the Block message.
+        chip::System::PacketBufferHandle blockBuf;
+        err = mImage->ReadBlock(seekOffset, bytesToRead, blockBuf);
+        if (err != CHIP_NO_ERROR)
         {
-            ChipLogError(BDX, "OTA file read failed");
-            mTransfer.AbortTransfer(StatusCode::kFileDesignatorUnknown);
+            ChipLogError(BDX, "ReadBlock failed: %" CHIP_ERROR_FORMAT, err.Format());
+            // TODO(#13981): AbortTransfer() needs to support GeneralStatusCode failures as well as BDX specific errors.
+            mTransfer.AbortTransfer(StatusCode::kUnknown);
             return;
         }
 
-        blockData.Data   = blockBuf->Start();
-        blockData.Length = static_cast<size_t>(otaFile.gcount());
-        blockData.IsEof  = (blockData.Length < blockSize) ||
-            (seekOffset + static_cast<uint64_t>(blockData.Length) == mTransfer.GetTransferLength() || (otaFile.peek() == EOF));
-        mNumBytesSent = static_cast<uint32_t>(seekOffset + blockData.Length);
-        otaFile.close();
+        const size_t blockLength = blockBuf->DataLength();
+        const bool isEof         = (blockLength < blockSize) ||
+            (seekOffset + static_cast<uint64_t>(blockLength) == mTransfer.GetTransferLength()) ||
+            (seekOffset + static_cast<uint64_t>(blockLength) >= mImage->GetSize());
+        mNumBytesSent = static_cast<uint32_t>(seekOffset + blockLength);
 
-        err = mTransfer.PrepareBlock(blockData);
+        err = mTransfer.PrepareBlock(std::move(blockBuf), isEof);
         if (err != CHIP_NO_ERROR)
         {
             ChipLogError(BDX, "PrepareBlock failed: %" CHIP_ERROR_FORMAT, err.Format());
             mTransfer.AbortTransfer(StatusCode::kUnknown);
         }
+        else if (mTransferScheduler != nullptr)
+        {
+            mTransferScheduler->OnBlockSent(GetRequestor(), blockLength, chip::System::SystemClock().GetMonotonicTimestamp());
+        }
         break;
     }
     case TransferSession::OutputEventType::kAckReceived:
         break;
     case TransferSession::OutputEventType::kAckEOFReceived:
         ChipLogDetail(BDX, "Transfer completed, got AckEOF");
-        Reset();
+        EndTransfer(true);
         break;
     case TransferSession::OutputEventType::kStatusReceived:
         ChipLogError(BDX, "Got StatusReport %x", static_cast<uint16_t>(event.statusData.statusCode));
-        Reset();
+        EndTransfer(false);
         break;
     case TransferSession::OutputEventType::kInternalError:
         ChipLogError(BDX, "InternalError");
-        Reset();
+        EndTransfer(false);
         break;
     case TransferSession::OutputEventType::kTransferTimeout:
         ChipLogError(BDX, "Transfer timed out");
-        Reset();
+        EndTransfer(false);
         break;
     case TransferSession::OutputEventType::kAcceptReceived:
     case TransferSession::OutputEventType::kBlockReceived:
@@ -216,6 +214,20 @@ void BdxOtaSender::HandleTransferSessionOutput(TransferSession::OutputEvent & ev
     }
 }
 
+void BdxOtaSender::EndTransfer(bool completed)
+{
+    if (mTransferScheduler != nullptr)
+    {
+        mTransferScheduler->OnTransferEnded(GetRequestor(), completed, chip::System::SystemClock().GetMonotonicTimestamp());
+    }
+    Reset();
+}
+
+chip::ScopedNodeId BdxOtaSender::GetRequestor() const
+{
+    return chip::ScopedNodeId(mNodeId.ValueOr(chip::kUndefinedNodeId), mFabricIndex.ValueOr(chip::kUndefinedFabricIndex));
+}
+
 /* Reset() calls bdx::TransferSession::Reset() which sets the output event type to
  * TransferSession::OutputEventType::kNone. So, bdx::TransferFacilitator::PollForOutput()
  * will call HandleTransferSessionOutput() with event TransferSession::OutputEventType::kNone.
@@ -234,5 +246,6 @@ void BdxOtaSender::Reset()
 
     mInitialized  = false;
     mNumBytesSent = 0;
+    mImage.reset();
     memset(mFileDesignator, 0, chip::bdx::kMaxFileDesignatorLen);
 }
@@ -15,9 +15,13 @@
  *    limitations under the License.
  */
 
+#include <app/clusters/ota-provider/OTATransferScheduler.h>
+#include <ota-provider-common/SharedOtaImage.h>
 #include <protocols/bdx/BdxTransferSession.h>
 #include <protocols/bdx/TransferFacilitator.h>
 
+#include <memory>
+
 #pragma once
 
 class BdxOtaSender : public chip::bdx::Responder
@@ -28,20 +32,33 @@ public:
     // Initializes BDX transfer-related metadata. Should always be called first.
     CHIP_ERROR InitializeTransfer(chip::FabricIndex fabricIndex, chip::NodeId nodeId);
 
+    // Reports the Blocks sent and the end of the transfers to the scheduler that admitted them.
+    void SetTransferScheduler(chip::ota::OTATransferScheduler * scheduler) { mTransferScheduler = scheduler; }
+
 private:
     // Inherited from bdx::TransferFacilitator
     void HandleTransferSessionOutput(chip::bdx::TransferSession::OutputEvent & event) override;
 
     void Reset();
 
+    // Reports the end of the transfer to the scheduler, then resets it.
+    void EndTransfer(bool completed);
+
+    chip::ScopedNodeId GetRequestor() const;
+
     // Null-terminated string representing file designator
     char mFileDesignator[chip::bdx::kMaxFileDesignatorLen];
 
     uint32_t mNumBytesSent = 0;
 
+    // File being transferred, shared with the other transfers of the same file
+    std::shared_ptr<SharedOtaImage> mImage;
+
     bool mInitialized = false;
 
     chip::Optional<chip::FabricIndex> mFabricIndex;
 
     chip::Optional<chip::NodeId> mNodeId;
+
+    chip::ota::OTATransferScheduler * mTransferScheduler = nullptr;
 };
@@ -27,6 +27,7 @@
 #include <lib/core/TLV.h>
 #include <lib/support/CHIPMemString.h>
 #include <protocols/bdx/BdxUri.h>
+#include <system/SystemClock.h>
 
 #include <fstream>
 #include <string.h>
@@ -39,9 +40,11 @@ using chip::FabricInfo;
 using chip::MutableCharSpan;
 using chip::NodeId;
 using chip::Optional;
+using chip::ScopedNodeId;
 using chip::Server;
 using chip::Span;
 using chip::app::Clusters::OTAProviderDelegate;
+using chip::ota::OTATransferScheduler;
 using chip::bdx::TransferControlFlags;
 using chip::Protocols::InteractionModel::Status;
 using namespace chip;
@@ -90,6 +93,40 @@ OTAProviderExample::OTAProviderExample()
     mUserConsentNeeded         = false;
     mPollInterval              = kBdxServerPollIntervalMillis;
     mCandidates.clear();
+
+    // Serve one Requestor at a time unless told otherwise
+    mTransferScheduler.Init(1);
+    for (BdxOtaSender & bdxOtaSender : mBdxOtaSenders)
+    {
+        bdxOtaSender.SetTransferScheduler(&mTransferScheduler);
+    }
+}
+
+OTATransferScheduler::Metrics OTAProviderExample::GetTransferMetrics() const
+{
+    return mTransferScheduler.GetMetrics(chip::System::SystemClock().GetMonotonicTimestamp());
+}
+
+CHIP_ERROR OTAProviderExample::OnUnsolicitedMessageReceived(const PayloadHeader & payloadHeader, const SessionHandle & session,
+                                                            Messaging::ExchangeDelegate *& newDelegate)
+{
+    // A transfer is only accepted from a Requestor that was given a slot in response to its QueryImage
+    const uint8_t slot = mTransferScheduler.GetSlot(session->GetPeer());
+    VerifyOrReturnError(slot != OTATransferScheduler::kNoSlot, CHIP_ERROR_INCORRECT_STATE,
+                        ChipLogError(BDX, "No OTA transfer admitted for " ChipLogFormatScopedNodeId,
+                                     ChipLogValueScopedNodeId(session->GetPeer())));
+
+    newDelegate = &mBdxOtaSenders[slot];
+    return CHIP_NO_ERROR;
+}
+
+static uint64_t GetOTAFileSize(const char * otaFilePath)
+{
+    std::ifstream otaFile(otaFilePath, std::ifstream::binary | std::ifstream::ate);
+    VerifyOrReturnValue(otaFile.good(), 0);
+
+    const std::streamoff size = otaFile.tellg();
+    return (size > 0) ? static_cast<uint64_t>(size) : 0;
 }
 
 void OTAProviderExample::SetOTAFilePath(const char * path)
@@ -267,18 +304,27 @@ void OTAProviderExample::SendQueryImageResponse(app::CommandHandler * commandObj
             }
         }
 
+        // Admit the transfer, or tell the Requestor when to query again based on the transfers in progress
+        const ScopedNodeId requestor(commandObj->GetSubjectDescriptor().subject, commandObj->GetSubjectDescriptor().fabricIndex);
+        const System::Clock::Timestamp now = System::SystemClock().GetMonotonicTimestamp();
+        uint8_t slot                       = OTATransferScheduler::kNoSlot;
+        System::Clock::Seconds32 delayedActionTime;
+        CHIP_ERROR error =
+            mTransferScheduler.RequestTransfer(requestor, GetOTAFileSize(mOTAFilePath), now, slot, delayedActionTime);
+
         // Initialize the transfer session in prepartion for a BDX transfer
         BitFlags<TransferControlFlags> bdxFlags;
         bdxFlags.Set(TransferControlFlags::kReceiverDrive);
-        if (mBdxOtaSender.InitializeTransfer(commandObj->GetSubjectDescriptor().fabricIndex,
-                                             commandObj->GetSubjectDescriptor().subject) == CHIP_NO_ERROR)
+        if (error == CHIP_NO_ERROR &&
+            mBdxOtaSenders[slot].InitializeTransfer(requestor.GetFabricIndex(), requestor.GetNodeId()) == CHIP_NO_ERROR)
         {
-            CHIP_ERROR error =
-                mBdxOtaSender.PrepareForTransfer(&chip::DeviceLayer::SystemLayer(), chip::bdx::TransferRole::kSender, bdxFlags,
-                                                 kMaxBdxBlockSize, kBdxTimeout, chip::System::Clock::Milliseconds32(mPollInterval));
+            error = mBdxOtaSenders[slot].PrepareForTransfer(&chip::DeviceLayer::SystemLayer(), chip::bdx::TransferRole::kSender,
+                                                            bdxFlags, kMaxBdxBlockSize, kBdxTimeout,
+                                                            chip::System::Clock::Milliseconds32(mPollInterval));
             if (error != CHIP_NO_ERROR)
             {
                 ChipLogError(SoftwareUpdate, "Cannot prepare for transfer: %" CHIP_ERROR_FORMAT, error.Format());
+                mTransferScheduler.OnTransferEnded(requestor, false, now);
                 commandObj->AddStatus(commandPath, Status::Failure);
                 return;
             }
@@ -290,9 +336,19 @@ void OTAProviderExample::SendQueryImageResponse(app::CommandHandler * commandObj
         }
         else
         {
-            // Another BDX transfer in progress
-            mQueryImageStatus = OTAQueryStatus::kBusy;
+            // All the transfers are in use, or the admitted one could not be initialized
+            if (error == CHIP_NO_ERROR)
+            {
+                mTransferScheduler.OnTransferEnded(requestor, false, now);
+                delayedActionTime = OTATransferScheduler::kMinDelayedActionTime;
+            }
+            mQueryImageStatus          = OTAQueryStatus::kBusy;
+            mDelayedQueryActionTimeSec = std::max(mDelayedQueryActionTimeSec, delayedActionTime.count());
         }
+
+        OTATransferScheduler::Metrics metrics = mTransferScheduler.GetMetrics(now);
+        ChipLogDetail(SoftwareUpdate, "OTA transfers: %u active, %u queued, %" PRIu32 " B/s, %" PRIu32 " completed",
+                      metrics.activeTransfers, metrics.queueDepth, metrics.throughput, metrics.completedTransfers);
     }
 
     // Delay action time is only applicable when the provider is busy
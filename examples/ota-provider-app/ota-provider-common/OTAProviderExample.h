@@ -21,15 +21,22 @@
 #include <app-common/zap-generated/cluster-objects.h>
 #include <app/CommandHandler.h>
 #include <app/clusters/ota-provider/OTAProviderUserConsentDelegate.h>
+#include <app/clusters/ota-provider/OTATransferScheduler.h>
 #include <app/clusters/ota-provider/ota-provider-delegate.h>
 #include <lib/core/OTAImageHeader.h>
+#include <messaging/ExchangeDelegate.h>
 #include <ota-provider-common/BdxOtaSender.h>
 #include <vector>
 
 /**
  * A reference implementation for an OTA Provider. Includes a method for providing a path to a local OTA file to serve.
+ *
+ * Up to a configurable number of Requestors download the image at the same time, each one from its own BdxOtaSender. The
+ * others are told when to query again, based on the progress of the transfers in use (see chip::ota::OTATransferScheduler).
+ * The provider must be registered as the handler of the unsolicited BDX messages, which it dispatches to the BdxOtaSender of
+ * their Requestor.
  */
-class OTAProviderExample : public chip::app::Clusters::OTAProviderDelegate
+class OTAProviderExample : public chip::app::Clusters::OTAProviderDelegate, public chip::Messaging::UnsolicitedMessageHandler
 {
 public:
     OTAProviderExample();
@@ -69,7 +76,14 @@ public:
     //////////// OTAProviderExample public APIs ///////////////
     void SetOTAFilePath(const char * path);
     void SetImageUri(const char * imageUri);
-    BdxOtaSender * GetBdxOtaSender() { return &mBdxOtaSender; }
+    BdxOtaSender * GetBdxOtaSender(uint8_t slot = 0)
+    {
+        return (slot < chip::ota::OTATransferScheduler::kMaxConcurrentTransfers) ? &mBdxOtaSenders[slot] : nullptr;
+    }
+
+    // Sets how many Requestors may download the image at the same time. Defaults to 1.
+    CHIP_ERROR SetMaxConcurrentTransfers(uint8_t count) { return mTransferScheduler.Init(count); }
+    chip::ota::OTATransferScheduler::Metrics GetTransferMetrics() const;
 
     void SetOTACandidates(std::vector<OTAProviderExample::DeviceSoftwareVersionModel> candidates);
     void SetIgnoreQueryImageCount(uint32_t count) { mIgnoreQueryImageCount = count; }
@@ -90,6 +104,10 @@ public:
     }
 
 private:
+    //////////// UnsolicitedMessageHandler Implementation ///////////////
+    CHIP_ERROR OnUnsolicitedMessageReceived(const chip::PayloadHeader & payloadHeader, const chip::SessionHandle & session,
+                                            chip::Messaging::ExchangeDelegate *& newDelegate) override;
+
     bool SelectOTACandidate(const uint16_t requestorVendorID, const uint16_t requestorProductID,
                             const uint32_t requestorSoftwareVersion,
                             OTAProviderExample::DeviceSoftwareVersionModel & finalCandidate);
@@ -108,7 +126,8 @@ private:
     SendQueryImageResponse(chip::app::CommandHandler * commandObj, const chip::app::ConcreteCommandPath & commandPath,
                            const chip::app::Clusters::OtaSoftwareUpdateProvider::Commands::QueryImage::DecodableType & commandData);
 
-    BdxOtaSender mBdxOtaSender;
+    BdxOtaSender mBdxOtaSenders[chip::ota::OTATransferScheduler::kMaxConcurrentTransfers];
+    chip::ota::OTATransferScheduler mTransferScheduler;
     std::vector<DeviceSoftwareVersionModel> mCandidates;
     char mOTAFilePath[kFilepathBufLen]; // null-terminated
     char mImageUri[kUriMaxLen];
@@ -0,0 +1,127 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <ota-provider-common/SharedOtaImage.h>
+
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <protocols/bdx/BdxTransferSession.h>
+
+#include <algorithm>
+#include <errno.h>
+#include <fcntl.h>
+#include <map>
+#include <string>
+#include <string.h>
+#include <unistd.h>
+
+using chip::System::PacketBufferHandle;
+
+namespace {
+
+// The image files currently in use, by path. Entries expire when the last transfer using a file releases it.
+std::map<std::string, std::weak_ptr<SharedOtaImage>> sOpenImages;
+
+} // namespace
+
+std::shared_ptr<SharedOtaImage> SharedOtaImage::Open(const char * path)
+{
+    VerifyOrReturnValue(path != nullptr, nullptr);
+
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        ChipLogError(BDX, "Cannot open OTA image %s: %s", path, strerror(errno));
+        return nullptr;
+    }
+
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0 || !S_ISREG(fileStat.st_mode))
+    {
+        ChipLogError(BDX, "OTA image %s is not a regular file", path);
+        close(fd);
+        return nullptr;
+    }
+
+    std::shared_ptr<SharedOtaImage> image = sOpenImages[path].lock();
+    if (image && image->IsSameFile(fileStat))
+    {
+        close(fd);
+        return image;
+    }
+
+    // Concurrent transfers read the image at different offsets, so ask for all of it to be read ahead.
+    posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+
+    image.reset(new SharedOtaImage(fd, fileStat));
+    sOpenImages[path] = image;
+
+    // Forget the files that are no longer used by any transfer.
+    for (auto it = sOpenImages.begin(); it != sOpenImages.end();)
+    {
+        it = it->second.expired() ? sOpenImages.erase(it) : std::next(it);
+    }
+
+    ChipLogProgress(BDX, "Opened OTA image %s (%llu bytes)", path, static_cast<unsigned long long>(image->GetSize()));
+    return image;
+}
+
+SharedOtaImage::SharedOtaImage(int fd, const struct stat & fileStat) :
+    mFd(fd), mSize(static_cast<uint64_t>(fileStat.st_size)), mDevice(fileStat.st_dev), mInode(fileStat.st_ino),
+    mModified(fileStat.st_mtime)
+{}
+
+SharedOtaImage::~SharedOtaImage()
+{
+    close(mFd);
+}
+
+bool SharedOtaImage::IsSameFile(const struct stat & fileStat) const
+{
+    return mDevice == fileStat.st_dev && mInode == fileStat.st_ino && mSize == static_cast<uint64_t>(fileStat.st_size) &&
+        mModified == fileStat.st_mtime;
+}
+
+CHIP_ERROR SharedOtaImage::ReadBlock(uint64_t offset, size_t maxLength, PacketBufferHandle & outBlock) const
+{
+    const size_t length = (offset < mSize) ? static_cast<size_t>(std::min<uint64_t>(maxLength, mSize - offset)) : 0;
+
+    PacketBufferHandle blockBuf = chip::bdx::TransferSession::NewBlockBuffer(length);
+    VerifyOrReturnError(!blockBuf.IsNull(), CHIP_ERROR_NO_MEMORY);
+
+    size_t bytesRead = 0;
+    while (bytesRead < length)
+    {
+        ssize_t result = pread(mFd, blockBuf->Start() + bytesRead, length - bytesRead, static_cast<off_t>(offset + bytesRead));
+        if (result < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (result <= 0)
+        {
+            // Zero bytes read before the expected end means that the file was truncated.
+            ChipLogError(BDX, "Cannot read OTA image at offset %llu: %s", static_cast<unsigned long long>(offset + bytesRead),
+                         (result < 0) ? strerror(errno) : "file truncated");
+            return CHIP_ERROR_READ_FAILED;
+        }
+        bytesRead += static_cast<size_t>(result);
+    }
+
+    blockBuf->SetDataLength(length);
+    outBlock = std::move(blockBuf);
+    return CHIP_NO_ERROR;
+}
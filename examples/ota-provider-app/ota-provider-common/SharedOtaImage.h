@@ -0,0 +1,72 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <lib/core/CHIPError.h>
+#include <system/SystemPacketBuffer.h>
+
+#include <memory>
+#include <sys/stat.h>
+
+/**
+ * A read-only OTA image file, used as the source of the Blocks of BDX transfers.
+ *
+ * All the transfers that serve the same file at the same time share a single open file, and the Blocks are read from it straight
+ * into the buffers of the Block messages. The file is closed when the last of them releases it. A file that is replaced on disk is
+ * opened again for new transfers, while the transfers in progress keep reading the file they started with. Reading a file that
+ * is truncated during a transfer fails, and ends that transfer.
+ *
+ * Must only be used from the CHIP stack thread.
+ */
+class SharedOtaImage
+{
+public:
+    /**
+     * Returns the image file at the given path, opening it if no transfer currently uses it.
+     *
+     * @return The image, or nullptr if the file cannot be opened.
+     */
+    static std::shared_ptr<SharedOtaImage> Open(const char * path);
+
+    ~SharedOtaImage();
+
+    SharedOtaImage(const SharedOtaImage &)             = delete;
+    SharedOtaImage & operator=(const SharedOtaImage &) = delete;
+
+    uint64_t GetSize() const { return mSize; }
+
+    /**
+     * Allocates a buffer for a Block (see bdx::TransferSession::NewBlockBuffer()) and reads up to maxLength bytes of the image,
+     * starting at offset, into it. The buffer is empty if offset is past the end of the image.
+     *
+     * @retval CHIP_ERROR_NO_MEMORY   The buffer cannot be allocated.
+     * @retval CHIP_ERROR_READ_FAILED The file cannot be read, or was truncated since it was opened.
+     */
+    CHIP_ERROR ReadBlock(uint64_t offset, size_t maxLength, chip::System::PacketBufferHandle & outBlock) const;
+
+private:
+    SharedOtaImage(int fd, const struct stat & fileStat);
+
+    bool IsSameFile(const struct stat & fileStat) const;
+
+    int mFd;
+    uint64_t mSize;
+    dev_t mDevice;
+    ino_t mInode;
+    time_t mModified;
+};
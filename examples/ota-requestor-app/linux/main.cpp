@@ -73,6 +73,7 @@ constexpr uint16_t kOptionAutoApplyImage       = 'a';
 constexpr uint16_t kOptionRequestorCanConsent  = 'c';
 constexpr uint16_t kOptionDisableNotify        = 'd';
 constexpr uint16_t kOptionOtaDownloadPath      = 'f';
+constexpr uint16_t kOptionOtaDirectIO          = 'i';
 constexpr uint16_t kOptionPeriodicQueryTimeout = 'p';
 constexpr uint16_t kOptionUserConsentState     = 'u';
 constexpr uint16_t kOptionWatchdogTimeout      = 'w';
@@ -86,12 +87,14 @@ static char gOtaDownloadPath[kMaxFilePathSize] = "/tmp/test.bin";
 bool gAutoApplyImage                           = false;
 bool gSendNotifyUpdateApplied                  = true;
 bool gSkipExecImageFile                        = false;
+bool gOtaDirectIO                              = false;
 
 OptionDef cmdLineOptionsDef[] = {
     { "autoApplyImage", chip::ArgParser::kNoArgument, kOptionAutoApplyImage },
     { "requestorCanConsent", chip::ArgParser::kArgumentRequired, kOptionRequestorCanConsent },
     { "disableNotifyUpdateApplied", chip::ArgParser::kNoArgument, kOptionDisableNotify },
     { "otaDownloadPath", chip::ArgParser::kArgumentRequired, kOptionOtaDownloadPath },
+    { "otaDirectIO", chip::ArgParser::kNoArgument, kOptionOtaDirectIO },
     { "periodicQueryTimeout", chip::ArgParser::kArgumentRequired, kOptionPeriodicQueryTimeout },
     { "userConsentState", chip::ArgParser::kArgumentRequired, kOptionUserConsentState },
     { "watchdogTimeout", chip::ArgParser::kArgumentRequired, kOptionWatchdogTimeout },
@@ -114,6 +117,8 @@ OptionSet cmdLineOptions = {
     "  -f, --otaDownloadPath <file path>\n"
     "       If supplied, the OTA image is downloaded to the given fully-qualified file-path.\n"
     "       Otherwise, the default location for the downloaded image is at /tmp/test.bin\n"
+    "  -i, --otaDirectIO\n"
+    "       If supplied, the OTA image is written with O_DIRECT, bypassing the page cache, if the file system supports it.\n"
     "  -p, --periodicQueryTimeout <time in seconds>\n"
     "       The periodic time interval to wait before attempting to query a provider from the default OTA provider list.\n"
     "       If none or zero is supplied, the timeout is determined by the driver.\n"
@@ -213,6 +218,7 @@ static void InitOTARequestor(void)
 
     gImageProcessor.SetOTAImageFile(gOtaDownloadPath);
     gImageProcessor.SetOTADownloader(&gDownloader);
+    gImageProcessor.SetDirectIO(gOtaDirectIO);
 
     // Set the image processor instance used for handling image being downloaded
     gDownloader.SetImageProcessorDelegate(&gImageProcessor);
@@ -251,6 +257,9 @@ bool HandleOptions(const char * aProgram, OptionSet * aOptions, int aIdentifier,
     case kOptionOtaDownloadPath:
         chip::Platform::CopyString(gOtaDownloadPath, aValue);
         break;
+    case kOptionOtaDirectIO:
+        gOtaDirectIO = true;
+        break;
     case kOptionUserConsentState:
         if (strcmp(aValue, "granted") == 0)
         {
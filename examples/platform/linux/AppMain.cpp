@@ -66,6 +66,10 @@
 #include "TraceHandlers.h"
 #endif // CHIP_CONFIG_TRANSPORT_TRACE_ENABLED
 
+#if CHIP_CONFIG_TRANSPORT_CAPTURE_ENABLED
+#include <transport/PcapCapture.h>
+#endif // CHIP_CONFIG_TRANSPORT_CAPTURE_ENABLED
+
 #if ENABLE_TRACING
 #include <TracingCommandLineArgument.h> // nogncheck
 #endif
@@ -288,6 +292,10 @@ LinuxCommissionableDataProvider gCommissionableDataProvider;
 
 chip::DeviceLayer::DeviceInfoProviderImpl gExampleDeviceInfoProvider;
 
+#if CHIP_CONFIG_TRANSPORT_CAPTURE_ENABLED
+chip::Transport::PcapCaptureWriter gCaptureWriter;
+#endif // CHIP_CONFIG_TRANSPORT_CAPTURE_ENABLED
+
 void EventHandler(const DeviceLayer::ChipDeviceEvent * event, intptr_t arg)
 {
     (void) arg;
@@ -647,6 +655,22 @@ void ChipLinuxAppMainLoop(AppMainLoopImplementation * impl)
     // Init ZCL Data Model and CHIP App Server
     Server::GetInstance().Init(initParams);
 
+#if CHIP_CONFIG_TRANSPORT_CAPTURE_ENABLED
+    if (LinuxDeviceOptions::GetInstance().captureFilename.HasValue())
+    {
+        const char * captureFilename = LinuxDeviceOptions::GetInstance().captureFilename.Value().c_str();
+        CHIP_ERROR captureErr        = gCaptureWriter.Open(captureFilename);
+        if (captureErr == CHIP_NO_ERROR)
+        {
+            Server::GetInstance().GetTransportManager().SetCaptureDelegate(&gCaptureWriter);
+        }
+        else
+        {
+            ChipLogError(NotSpecified, "Cannot open capture file %s: %" CHIP_ERROR_FORMAT, captureFilename, captureErr.Format());
+        }
+    }
+#endif // CHIP_CONFIG_TRANSPORT_CAPTURE_ENABLED
+
 #if CHIP_CONFIG_USE_ACCESS_RESTRICTIONS
     if (LinuxDeviceOptions::GetInstance().commissioningArlEntries.HasValue())
     {
@@ -731,6 +755,11 @@ void ChipLinuxAppMainLoop(AppMainLoopImplementation * impl)
     shellThread.join();
 #endif
 
+#if CHIP_CONFIG_TRANSPORT_CAPTURE_ENABLED
+    Server::GetInstance().GetTransportManager().SetCaptureDelegate(nullptr);
+    gCaptureWriter.Close();
+#endif // CHIP_CONFIG_TRANSPORT_CAPTURE_ENABLED
+
     Server::GetInstance().Shutdown();
 
 #if CHIP_DEVICE_CONFIG_ENABLE_BOTH_COMMISSIONER_AND_COMMISSIONEE
@@ -93,6 +93,7 @@ enum
     kDeviceOption_TraceFile,
     kDeviceOption_TraceLog,
     kDeviceOption_TraceDecode,
+    kDeviceOption_CaptureFile,
 #if CHIP_CONFIG_USE_ACCESS_RESTRICTIONS
     kDeviceOption_CommissioningArlEntries,
     kDeviceOption_ArlEntries,
@@ -173,6 +174,9 @@ OptionDef sDeviceOptionDefs[] = {
     { "trace_log", kArgumentRequired, kDeviceOption_TraceLog },
     { "trace_decode", kArgumentRequired, kDeviceOption_TraceDecode },
 #endif // CHIP_CONFIG_TRANSPORT_TRACE_ENABLED
+#if CHIP_CONFIG_TRANSPORT_CAPTURE_ENABLED
+    { "capture_file", kArgumentRequired, kDeviceOption_CaptureFile },
+#endif // CHIP_CONFIG_TRANSPORT_CAPTURE_ENABLED
 #if CHIP_CONFIG_USE_ACCESS_RESTRICTIONS
     { "commissioning-arl-entries", kArgumentRequired, kDeviceOption_CommissioningArlEntries },
     { "arl-entries", kArgumentRequired, kDeviceOption_ArlEntries },
@@ -307,6 +311,11 @@ const char * sDeviceOptionHelp =
     "  --trace_decode <1/0>\n"
     "       A value of 1 enables traces decoding, 0 disables this (default 0).\n"
 #endif // CHIP_CONFIG_TRANSPORT_TRACE_ENABLED
+#if CHIP_CONFIG_TRANSPORT_CAPTURE_ENABLED
+    "\n"
+    "  --capture_file <file>\n"
+    "       Record the messages sent and received by the server to the provided pcap file.\n"
+#endif // CHIP_CONFIG_TRANSPORT_CAPTURE_ENABLED
 #if CHIP_CONFIG_USE_ACCESS_RESTRICTIONS
     "  --commissioning-arl-entries <CommissioningARL JSON>\n"
     "       Enable ACL cluster access restrictions used during commissioning with the provided JSON. Example:\n"
@@ -612,6 +621,12 @@ bool HandleOption(const char * aProgram, OptionSet * aOptions, int aIdentifier,
         break;
 #endif // CHIP_CONFIG_TRANSPORT_TRACE_ENABLED
 
+#if CHIP_CONFIG_TRANSPORT_CAPTURE_ENABLED
+    case kDeviceOption_CaptureFile:
+        LinuxDeviceOptions::GetInstance().captureFilename.SetValue(std::string{ aValue });
+        break;
+#endif // CHIP_CONFIG_TRANSPORT_CAPTURE_ENABLED
+
 #if CHIP_CONFIG_USE_ACCESS_RESTRICTIONS
     // TODO(#35189): change to use a path to JSON files instead
     case kDeviceOption_CommissioningArlEntries: {
@@ -76,6 +76,9 @@ struct LinuxDeviceOptions
     bool traceStreamToLogEnabled  = false;
     chip::Optional<std::string> traceStreamFilename;
 #endif // CHIP_CONFIG_TRANSPORT_TRACE_ENABLED
+#if CHIP_CONFIG_TRANSPORT_CAPTURE_ENABLED
+    chip::Optional<std::string> captureFilename;
+#endif // CHIP_CONFIG_TRANSPORT_CAPTURE_ENABLED
     chip::Credentials::DeviceAttestationCredentialsProvider * dacProvider = nullptr;
     chip::CSRResponseOptions mCSRResponseOptions;
     uint8_t testEventTriggerEnableKey[16] = { 0 };
@@ -479,16 +479,11 @@ Status CommandHandlerImpl::ProcessGroupCommandDataIB(CommandDataIB::Parser & aCo
     // always have an accessing fabric, by definition.
 
     // Find which endpoints can process the command, and dispatch to them.
-    iterator = groupDataProvider->IterateEndpoints(fabric);
+    iterator = groupDataProvider->IterateEndpoints(fabric, std::make_optional(groupId));
     VerifyOrReturnError(iterator != nullptr, Status::Failure);
 
     while (iterator->Next(mapping))
     {
-        if (groupId != mapping.group_id)
-        {
-            continue;
-        }
-
         ChipLogDetail(DataManagement,
                       "Processing group command for Endpoint=%u Cluster=" ChipLogFormatMEI " Command=" ChipLogFormatMEI,
                       mapping.endpoint_id, ChipLogValueMEI(clusterId), ChipLogValueMEI(commandId));
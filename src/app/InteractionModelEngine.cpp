@@ -53,6 +53,7 @@
 #include <lib/support/CodeUtils.h>
 #include <lib/support/FibonacciUtils.h>
 #include <protocols/interaction_model/StatusCode.h>
+#include <tracing/metric_event.h>
 
 namespace chip {
 namespace app {
@@ -182,6 +183,10 @@ void InteractionModelEngine::Shutdown()
     VerifyOrReturn(State::kUninitialized != mState);
 
     mpExchangeMgr->GetSessionManager()->SystemLayer()->CancelTimer(ResumeSubscriptionsTimerCallback, this);
+#if CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
+    mpExchangeMgr->GetSessionManager()->SystemLayer()->CancelTimer(ResumeNextSubscriptionPeersTimerCallback, this);
+    mSubscriptionResumptionQueue.Clear();
+#endif // CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
 
     // TODO: individual object clears the entire command handler interface registry.
     //       This may not be expected as IME does NOT own the command handler interface registry.
@@ -555,7 +560,9 @@ Status InteractionModelEngine::OnInvokeCommandRequest(Messaging::ExchangeContext
         commandResponder->TestOnlyInvokeCommandRequestWithFaultsInjected(
             apExchangeContext, std::move(aPayload), aIsTimedInvoke, CommandHandlerImpl::NlFaultInjectionType::SkipSecondResponse);
         return Status::Success;);
+    MATTER_LOG_METRIC_BEGIN(Tracing::kMetricDeviceInvokeHandling);
     commandResponder->OnInvokeCommandRequest(apExchangeContext, std::move(aPayload), aIsTimedInvoke);
+    MATTER_LOG_METRIC_END(Tracing::kMetricDeviceInvokeHandling);
     return Status::Success;
 }
 
@@ -2010,23 +2017,20 @@ CHIP_ERROR InteractionModelEngine::ResumeSubscriptions()
     // to do for now because it's both simple and avoids the timer resource and multiple-wake problems. This issue is to track
     // future improvements: https://github.com/project-chip/connectedhomeip/issues/25439
 
-    SubscriptionResumptionStorage::SubscriptionInfo subscriptionInfo;
-    auto * iterator             = mpSubscriptionResumptionStorage->IterateSubscriptions();
-    mNumOfSubscriptionsToResume = 0;
-    uint16_t minInterval        = 0;
-    while (iterator->Next(subscriptionInfo))
-    {
-        mNumOfSubscriptionsToResume++;
-        minInterval = std::max(minInterval, subscriptionInfo.mMinInterval);
-    }
-    iterator->Release();
+    // All the persisted subscriptions are loaded in a single pass over storage, grouped by peer so that the subscriptions of a
+    // peer share one CASE session, and resumed a few peers at a time (see ResumeNextSubscriptionPeers).
+    ReturnErrorOnFailure(
+        mSubscriptionResumptionQueue.Load(*mpSubscriptionResumptionStorage, ClassifySubscriptionForResumption, this));
+    mNumOfSubscriptionsToResume =
+        static_cast<uint16_t>(std::min<size_t>(mSubscriptionResumptionQueue.GetPendingCount(), UINT16_MAX));
+    uint16_t minInterval = mSubscriptionResumptionQueue.GetMaxMinInterval();
 
     if (mNumOfSubscriptionsToResume)
     {
 #if CHIP_CONFIG_SUBSCRIPTION_TIMEOUT_RESUMPTION
         mSubscriptionResumptionScheduled = true;
 #endif
-        ChipLogProgress(InteractionModel, "Resuming %d subscriptions in %u seconds", mNumOfSubscriptionsToResume, minInterval);
+        ChipLogProgress(InteractionModel, "Resuming %u subscriptions in %u seconds", mNumOfSubscriptionsToResume, minInterval);
         ReturnErrorOnFailure(mpExchangeMgr->GetSessionManager()->SystemLayer()->StartTimer(System::Clock::Seconds16(minInterval),
                                                                                            ResumeSubscriptionsTimerCallback, this));
     }
@@ -2046,55 +2050,111 @@ void InteractionModelEngine::ResumeSubscriptionsTimerCallback(System::Layer * ap
     InteractionModelEngine * imEngine = static_cast<InteractionModelEngine *>(apAppState);
 #if CHIP_CONFIG_SUBSCRIPTION_TIMEOUT_RESUMPTION
     imEngine->mSubscriptionResumptionScheduled = false;
-    bool resumedSubscriptions                  = false;
 #endif // CHIP_CONFIG_SUBSCRIPTION_TIMEOUT_RESUMPTION
-    SubscriptionResumptionStorage::SubscriptionInfo subscriptionInfo;
-    AutoReleaseSubscriptionInfoIterator iterator(imEngine->mpSubscriptionResumptionStorage->IterateSubscriptions());
-    while (iterator->Next(subscriptionInfo))
-    {
-        // If subscription happens between reboot and this timer callback, it's already live and should skip resumption
-        if (Loop::Break == imEngine->mReadHandlers.ForEachActiveObject([&](ReadHandler * handler) {
-                SubscriptionId subscriptionId;
-                handler->GetSubscriptionId(subscriptionId);
-                if (subscriptionId == subscriptionInfo.mSubscriptionId)
-                {
-                    return Loop::Break;
-                }
-                return Loop::Continue;
-            }))
-        {
-            ChipLogProgress(InteractionModel, "Skip resuming live subscriptionId %" PRIu32, subscriptionInfo.mSubscriptionId);
-            continue;
-        }
-
-        auto subscriptionResumptionSessionEstablisher = Platform::MakeUnique<SubscriptionResumptionSessionEstablisher>();
-        if (subscriptionResumptionSessionEstablisher == nullptr)
-        {
-            ChipLogProgress(InteractionModel, "Failed to create SubscriptionResumptionSessionEstablisher");
-            return;
-        }
 
-        if (subscriptionResumptionSessionEstablisher->ResumeSubscription(*imEngine->mpCASESessionMgr, subscriptionInfo) !=
-            CHIP_NO_ERROR)
+    // At boot the queue was loaded by ResumeSubscriptions(). Later resumption attempts reload the subscriptions that are neither
+    // live nor already being resumed.
+    if (!imEngine->mSubscriptionResumptionQueue.HasPending())
+    {
+        CHIP_ERROR err = imEngine->mSubscriptionResumptionQueue.Load(*imEngine->mpSubscriptionResumptionStorage,
+                                                                      ClassifySubscriptionForResumption, imEngine);
+        if (err != CHIP_NO_ERROR)
         {
-            ChipLogProgress(InteractionModel, "Failed to ResumeSubscription 0x%" PRIx32, subscriptionInfo.mSubscriptionId);
-            return;
+            ChipLogError(InteractionModel, "Failed to load persisted subscriptions: %" CHIP_ERROR_FORMAT, err.Format());
         }
-        subscriptionResumptionSessionEstablisher.release();
-#if CHIP_CONFIG_SUBSCRIPTION_TIMEOUT_RESUMPTION
-        resumedSubscriptions = true;
-#endif // CHIP_CONFIG_SUBSCRIPTION_TIMEOUT_RESUMPTION
     }
 
 #if CHIP_CONFIG_SUBSCRIPTION_TIMEOUT_RESUMPTION
     // If no persisted subscriptions needed resumption then all resumption retries are done
-    if (!resumedSubscriptions)
+    if (!imEngine->mSubscriptionResumptionQueue.HasPending())
     {
         imEngine->mNumSubscriptionResumptionRetries = 0;
     }
 #endif // CHIP_CONFIG_SUBSCRIPTION_TIMEOUT_RESUMPTION
 
+    imEngine->ResumeNextSubscriptionPeers();
+#endif // CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
+}
+
+#if CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
+void InteractionModelEngine::ResumeNextSubscriptionPeersTimerCallback(System::Layer * apSystemLayer, void * apAppState)
+{
+    VerifyOrReturn(apAppState != nullptr);
+    static_cast<InteractionModelEngine *>(apAppState)->ResumeNextSubscriptionPeers();
+}
+
+void InteractionModelEngine::ResumeNextSubscriptionPeers()
+{
+    while (mSubscriptionResumptionQueue.GetPeersInProgress() < CHIP_CONFIG_SUBSCRIPTION_RESUMPTION_MAX_CONCURRENT_PEERS &&
+           mSubscriptionResumptionQueue.StartNextPeer(StartSubscriptionResumption, this))
+    {
+    }
+}
+
+SubscriptionResumptionQueue::Disposition
+InteractionModelEngine::ClassifySubscriptionForResumption(void * context,
+                                                          const SubscriptionResumptionStorage::SubscriptionInfo & subscriptionInfo)
+{
+    auto * imEngine = static_cast<InteractionModelEngine *>(context);
+
+    // If subscription happens between reboot and resumption, it's already live and should skip resumption
+    if (imEngine->IsSubscriptionLive(subscriptionInfo.mSubscriptionId))
+    {
+        return SubscriptionResumptionQueue::Disposition::kSkip;
+    }
+
+    // Subscriptions of fabrics that no longer exist could never be resumed
+    if (imEngine->mpFabricTable != nullptr &&
+        imEngine->mpFabricTable->FindFabricWithIndex(subscriptionInfo.mFabricIndex) == nullptr)
+    {
+        return SubscriptionResumptionQueue::Disposition::kDiscard;
+    }
+
+    return SubscriptionResumptionQueue::Disposition::kResume;
+}
+
+CHIP_ERROR InteractionModelEngine::StartSubscriptionResumption(void * context,
+                                                               SubscriptionResumptionSessionEstablisher & establisher)
+{
+    auto * imEngine = static_cast<InteractionModelEngine *>(context);
+
+    // The queue may have been loaded a while ago, at boot: check again that the subscription still needs to be resumed.
+    if (ClassifySubscriptionForResumption(context, establisher.mSubscriptionInfo) !=
+        SubscriptionResumptionQueue::Disposition::kResume)
+    {
+        ChipLogProgress(InteractionModel, "Skip resuming subscriptionId %" PRIu32, establisher.mSubscriptionInfo.mSubscriptionId);
+        imEngine->DecrementNumSubscriptionsToResume();
+        return CHIP_ERROR_CANCELLED;
+    }
+
+    CHIP_ERROR err = establisher.ResumeSubscription(*imEngine->mpCASESessionMgr);
+    if (err != CHIP_NO_ERROR)
+    {
+        imEngine->DecrementNumSubscriptionsToResume();
+    }
+    return err;
+}
+
+void InteractionModelEngine::OnSubscriptionResumptionDone(SubscriptionResumptionSessionEstablisher & establisher, bool resumed)
+{
+    mSubscriptionResumptionQueue.OnResumptionDone(establisher, resumed);
+
+    // Start the next peers from a fresh stack: this is called from the session establishment callbacks.
+    if (mSubscriptionResumptionQueue.HasPending())
+    {
+        mpExchangeMgr->GetSessionManager()->SystemLayer()->StartTimer(System::Clock::kZero,
+                                                                      ResumeNextSubscriptionPeersTimerCallback, this);
+    }
+}
 #endif // CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
+
+bool InteractionModelEngine::IsSubscriptionLive(SubscriptionId subscriptionId)
+{
+    return Loop::Break == mReadHandlers.ForEachActiveObject([subscriptionId](ReadHandler * handler) {
+        SubscriptionId handlerSubscriptionId;
+        handler->GetSubscriptionId(handlerSubscriptionId);
+        return (handlerSubscriptionId == subscriptionId) ? Loop::Break : Loop::Continue;
+    });
 }
 
 #if CHIP_CONFIG_PERSIST_SUBSCRIPTIONS && CHIP_CONFIG_SUBSCRIPTION_TIMEOUT_RESUMPTION
@@ -2126,15 +2186,9 @@ bool InteractionModelEngine::HasSubscriptionsToResume()
     bool foundSubscriptionToResume = false;
     while (iterator->Next(subscriptionInfo))
     {
-        if (Loop::Break == mReadHandlers.ForEachActiveObject([&](ReadHandler * handler) {
-                SubscriptionId subscriptionId;
-                handler->GetSubscriptionId(subscriptionId);
-                if (subscriptionId == subscriptionInfo.mSubscriptionId)
-                {
-                    return Loop::Break;
-                }
-                return Loop::Continue;
-            }))
+        if (IsSubscriptionLive(subscriptionInfo.mSubscriptionId) ||
+            mSubscriptionResumptionQueue.IsInProgress(ScopedNodeId(subscriptionInfo.mNodeId, subscriptionInfo.mFabricIndex),
+                                                      subscriptionInfo.mSubscriptionId))
         {
             continue;
         }
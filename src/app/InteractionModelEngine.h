@@ -44,6 +44,7 @@
 #include <app/ReadClient.h>
 #include <app/ReadHandler.h>
 #include <app/StatusResponse.h>
+#include <app/SubscriptionResumptionQueue.h>
 #include <app/SubscriptionResumptionSessionEstablisher.h>
 #include <app/SubscriptionsInfoProvider.h>
 #include <app/TimedHandler.h>
@@ -327,6 +328,20 @@ public:
      *        was succesful or not.
      */
     void DecrementNumSubscriptionsToResume();
+
+    /**
+     * @brief Must be called by the SubscriptionResumptionSessionEstablisher once its resumption attempt completed, before it is
+     *        deleted. Starts the resumption of the next queued peers.
+     */
+    void OnSubscriptionResumptionDone(SubscriptionResumptionSessionEstablisher & establisher, bool resumed);
+
+    /**
+     * @brief Progress of the resumption of persisted subscriptions since they were last loaded from storage.
+     */
+    const SubscriptionResumptionQueue::Metrics & GetSubscriptionResumptionMetrics() const
+    {
+        return mSubscriptionResumptionQueue.GetMetrics();
+    }
 #endif // CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
 
 #if CONFIG_BUILD_FOR_HOST_UNIT_TEST
@@ -628,6 +643,14 @@ private:
     bool IsExistentAttributePath(const ConcreteAttributePath & path);
 
     static void ResumeSubscriptionsTimerCallback(System::Layer * apSystemLayer, void * apAppState);
+#if CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
+    static void ResumeNextSubscriptionPeersTimerCallback(System::Layer * apSystemLayer, void * apAppState);
+    static SubscriptionResumptionQueue::Disposition ClassifySubscriptionForResumption(
+        void * context, const SubscriptionResumptionStorage::SubscriptionInfo & subscriptionInfo);
+    static CHIP_ERROR StartSubscriptionResumption(void * context, SubscriptionResumptionSessionEstablisher & establisher);
+    void ResumeNextSubscriptionPeers();
+#endif // CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
+    bool IsSubscriptionLive(SubscriptionId subscriptionId);
 
     template <typename T, size_t N>
     void ReleasePool(SingleLinkedListNode<T> *& aObjectList, ObjectPool<SingleLinkedListNode<T>, N> & aObjectPool);
@@ -705,7 +728,8 @@ private:
      * When the subscription timeout resumption feature is present, after the boot up attempt, the next attempt will be determined
      * by ComputeTimeSecondsTillNextSubscriptionResumption.
      */
-    int8_t mNumOfSubscriptionsToResume = 0;
+    uint16_t mNumOfSubscriptionsToResume = 0;
+    SubscriptionResumptionQueue mSubscriptionResumptionQueue;
 #if CHIP_CONFIG_SUBSCRIPTION_TIMEOUT_RESUMPTION
     bool HasSubscriptionsToResume();
     uint32_t ComputeTimeSecondsTillNextSubscriptionResumption();
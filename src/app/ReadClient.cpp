@@ -347,6 +347,7 @@ CHIP_ERROR ReadClient::SendReadRequest(ReadPrepareParams & aReadPrepareParams)
     ReturnErrorOnFailure(writer.Finalize(&msgBuf));
 
     VerifyOrReturnError(aReadPrepareParams.mSessionHolder, CHIP_ERROR_MISSING_SECURE_SESSION);
+    ReturnErrorOnFailure(CheckLargePayloadSupport(aReadPrepareParams));
 
     auto exchange = mpExchangeMgr->NewContext(aReadPrepareParams.mSessionHolder.Get().Value(), this);
     VerifyOrReturnError(exchange != nullptr, err = CHIP_ERROR_NO_MEMORY);
@@ -1159,7 +1160,8 @@ CHIP_ERROR ReadClient::SendSubscribeRequestImpl(const ReadPrepareParams & aReadP
         mReadPrepareParams.mSessionHolder = aReadPrepareParams.mSessionHolder;
     }
 
-    mIsPeerLIT = aReadPrepareParams.mIsPeerLIT;
+    mIsPeerLIT         = aReadPrepareParams.mIsPeerLIT;
+    mAllowLargePayload = aReadPrepareParams.mAllowLargePayload;
 
     mMinIntervalFloorSeconds = aReadPrepareParams.mMinIntervalFloorSeconds;
 
@@ -1230,6 +1232,7 @@ CHIP_ERROR ReadClient::SendSubscribeRequestImpl(const ReadPrepareParams & aReadP
     ReturnErrorOnFailure(writer.Finalize(&msgBuf));
 
     VerifyOrReturnError(aReadPrepareParams.mSessionHolder, CHIP_ERROR_MISSING_SECURE_SESSION);
+    ReturnErrorOnFailure(CheckLargePayloadSupport(aReadPrepareParams));
 
     auto exchange = mpExchangeMgr->NewContext(aReadPrepareParams.mSessionHolder.Get().Value(), this);
     if (exchange == nullptr)
@@ -1441,7 +1444,28 @@ CHIP_ERROR ReadClient::EstablishSessionToPeer()
     ChipLogProgress(DataManagement, "Trying to establish a CASE session for subscription");
     auto * caseSessionManager = InteractionModelEngine::GetInstance()->GetCASESessionManager();
     VerifyOrReturnError(caseSessionManager != nullptr, CHIP_ERROR_INCORRECT_STATE);
-    caseSessionManager->FindOrEstablishSession(mPeer, &mOnConnectedCallback, &mOnConnectionFailureCallback);
+
+    // The new session needs to carry the same reports as the one it replaces.
+    TransportPayloadCapability transportPayloadCapability =
+        mAllowLargePayload ? TransportPayloadCapability::kLargePayload : TransportPayloadCapability::kMRPPayload;
+#if CHIP_DEVICE_CONFIG_ENABLE_AUTOMATIC_CASE_RETRIES
+    caseSessionManager->FindOrEstablishSession(mPeer, &mOnConnectedCallback, &mOnConnectionFailureCallback, 1 /* attemptCount */,
+                                               nullptr /* onRetry */, transportPayloadCapability);
+#else
+    caseSessionManager->FindOrEstablishSession(mPeer, &mOnConnectedCallback, &mOnConnectionFailureCallback,
+                                               transportPayloadCapability);
+#endif // CHIP_DEVICE_CONFIG_ENABLE_AUTOMATIC_CASE_RETRIES
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ReadClient::CheckLargePayloadSupport(const ReadPrepareParams & aReadPrepareParams)
+{
+    // If the reports are expected to be large, ensure that the underlying session supports them.
+    if (aReadPrepareParams.mAllowLargePayload && !aReadPrepareParams.mSessionHolder->AllowsLargePayload())
+    {
+        ChipLogError(DataManagement, "ReadClient[%p]: large payload requested, but the session does not support it", this);
+        return CHIP_ERROR_INCORRECT_STATE;
+    }
     return CHIP_NO_ERROR;
 }
 
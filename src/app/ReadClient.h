@@ -626,6 +626,11 @@ private:
      */
     CHIP_ERROR EstablishSessionToPeer();
 
+    /**
+     * Checks that the session of the request supports large payloads, if the request asks for them.
+     */
+    CHIP_ERROR CheckLargePayloadSupport(const ReadPrepareParams & aReadPrepareParams);
+
     Messaging::ExchangeManager * mpExchangeMgr = nullptr;
     Messaging::ExchangeHolder mExchange;
     Callback & mpCallback;
@@ -667,6 +672,9 @@ private:
 
     bool mIsPeerLIT = false;
 
+    // Whether the subscription was requested with large payload support, which re-established sessions also need.
+    bool mAllowLargePayload = false;
+
     // End Of Container (0x18) uses one byte.
     static constexpr uint16_t kReservedSizeForEndOfContainer = 1;
     // Reserved size for the uint8_t InteractionModelRevision flag, which takes up 1 byte for the control tag and 1 byte for the
@@ -926,7 +926,7 @@ size_t ReadHandler::GetReportBufferMaxSize()
     Transport::SecureSession * session = GetSession();
     if (session && session->AllowsLargePayload())
     {
-        return kMaxLargeSecureSduLengthBytes;
+        return mManagementCallback.GetInteractionModelEngine()->GetReportingEngine().GetMaxLargeReportSize();
     }
     return kMaxSecureSduLengthBytes;
 }
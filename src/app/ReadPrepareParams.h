@@ -48,6 +48,10 @@ struct ReadPrepareParams
     bool mKeepSubscriptions             = false;
     bool mIsFabricFiltered              = true;
     bool mIsPeerLIT                     = false;
+    // Requires the session to support large payloads (i.e. to run over TCP), so that reports are not limited to the
+    // size of an MRP message. Sessions re-established for resubscriptions are then also requested with large payload
+    // support.
+    bool mAllowLargePayload = false;
 
     ReadPrepareParams() {}
     ReadPrepareParams(const SessionHandle & sessionHandle) { mSessionHolder.Grab(sessionHandle); }
@@ -66,6 +70,7 @@ struct ReadPrepareParams
         mTimeout                           = other.mTimeout;
         mIsFabricFiltered                  = other.mIsFabricFiltered;
         mIsPeerLIT                         = other.mIsPeerLIT;
+        mAllowLargePayload                 = other.mAllowLargePayload;
         other.mpEventPathParamsList        = nullptr;
         other.mEventPathParamsListSize     = 0;
         other.mpAttributePathParamsList    = nullptr;
@@ -91,6 +96,7 @@ struct ReadPrepareParams
         mTimeout                           = other.mTimeout;
         mIsFabricFiltered                  = other.mIsFabricFiltered;
         mIsPeerLIT                         = other.mIsPeerLIT;
+        mAllowLargePayload                 = other.mAllowLargePayload;
         other.mpEventPathParamsList        = nullptr;
         other.mEventPathParamsListSize     = 0;
         other.mpAttributePathParamsList    = nullptr;
@@ -16,6 +16,7 @@
 #include <app/StorageDelegateWrapper.h>
 
 #include <lib/support/SafeInt.h>
+#include <tracing/metric_event.h>
 
 namespace chip {
 namespace app {
@@ -31,7 +32,11 @@ CHIP_ERROR StorageDelegateWrapper::WriteValue(const StorageKeyName & aKey, const
     {
         return CHIP_ERROR_BUFFER_TOO_SMALL;
     }
-    return mStorage->SyncSetKeyValue(aKey.KeyName(), aValue.data(), static_cast<uint16_t>(aValue.size()));
+
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    MATTER_LOG_METRIC_SCOPE(Tracing::kMetricDeviceStorageCommit, err);
+    err = mStorage->SyncSetKeyValue(aKey.KeyName(), aValue.data(), static_cast<uint16_t>(aValue.size()));
+    return err;
 }
 
 CHIP_ERROR StorageDelegateWrapper::ReadValue(const StorageKeyName & aKey, MutableByteSpan & aValue)
@@ -0,0 +1,274 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/SubscriptionResumptionQueue.h>
+
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <system/SystemClock.h>
+
+#include <algorithm>
+
+namespace chip {
+namespace app {
+
+CHIP_ERROR SubscriptionResumptionQueue::Load(SubscriptionResumptionStorage & storage, ClassifyFunction classify, void * context)
+{
+    VerifyOrReturnError(classify != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    System::Clock::Timestamp start = System::SystemClock().GetMonotonicTimestamp();
+    if (mInProgressHead == nullptr && mPendingHead == nullptr)
+    {
+        mMetrics        = Metrics();
+        mMaxMinInterval = 0;
+    }
+    mMetrics.mLoaded = 0;
+
+    SubscriptionResumptionStorage::SubscriptionInfoIterator * iterator = storage.IterateSubscriptions();
+    VerifyOrReturnError(iterator != nullptr, CHIP_ERROR_NO_MEMORY);
+
+    SubscriptionResumptionSessionEstablisher * discarded = nullptr;
+    CHIP_ERROR err                                       = CHIP_NO_ERROR;
+    SubscriptionInfo subscriptionInfo;
+    while (iterator->Next(subscriptionInfo))
+    {
+        mMetrics.mLoaded++;
+
+        ScopedNodeId peer(subscriptionInfo.mNodeId, subscriptionInfo.mFabricIndex);
+        Disposition disposition = classify(context, subscriptionInfo);
+        if (disposition == Disposition::kSkip || Contains(mPendingHead, peer, subscriptionInfo.mSubscriptionId) ||
+            Contains(mInProgressHead, peer, subscriptionInfo.mSubscriptionId))
+        {
+            mMetrics.mSkipped++;
+            continue;
+        }
+
+        auto * establisher = Platform::New<SubscriptionResumptionSessionEstablisher>();
+        if (establisher == nullptr)
+        {
+            err = CHIP_ERROR_NO_MEMORY;
+            break;
+        }
+        establisher->mSubscriptionInfo = std::move(subscriptionInfo);
+
+        if (disposition == Disposition::kDiscard)
+        {
+            establisher->mNext = discarded;
+            discarded          = establisher;
+            continue;
+        }
+
+        mMaxMinInterval = std::max(mMaxMinInterval, establisher->mSubscriptionInfo.mMinInterval);
+        Enqueue(establisher);
+    }
+    iterator->Release();
+
+    // Deleting is done once the iterator is released, so that it does not race with the iteration.
+    while (discarded != nullptr)
+    {
+        SubscriptionResumptionSessionEstablisher * next = discarded->mNext;
+        const SubscriptionInfo & info                   = discarded->mSubscriptionInfo;
+        ChipLogProgress(InteractionModel, "Discarding persisted subscription 0x%" PRIx32 " of peer " ChipLogFormatScopedNodeId,
+                        info.mSubscriptionId, ChipLogValueScopedNodeId(ScopedNodeId(info.mNodeId, info.mFabricIndex)));
+        storage.Delete(info.mNodeId, info.mFabricIndex, info.mSubscriptionId);
+        mMetrics.mDiscarded++;
+        Platform::Delete(discarded);
+        discarded = next;
+    }
+
+    mLoadTimestamp     = System::SystemClock().GetMonotonicTimestamp();
+    mMetrics.mLoadTime = std::chrono::duration_cast<System::Clock::Milliseconds32>(mLoadTimestamp - start);
+
+    ChipLogProgress(InteractionModel,
+                    "Loaded %u persisted subscriptions in %" PRIu32 " ms: %u to resume from %u peers, %u skipped, %u discarded",
+                    static_cast<unsigned>(mMetrics.mLoaded), mMetrics.mLoadTime.count(), static_cast<unsigned>(mPendingCount),
+                    static_cast<unsigned>(mMetrics.mPeers), static_cast<unsigned>(mMetrics.mSkipped),
+                    static_cast<unsigned>(mMetrics.mDiscarded));
+    return err;
+}
+
+void SubscriptionResumptionQueue::Enqueue(SubscriptionResumptionSessionEstablisher * establisher)
+{
+    ScopedNodeId peer = PeerOf(*establisher);
+
+    // Insert after the last queued subscription of the same peer, or at the end for a new peer.
+    SubscriptionResumptionSessionEstablisher ** link = &mPendingHead;
+    SubscriptionResumptionSessionEstablisher * last  = nullptr;
+    for (; *link != nullptr; link = &(*link)->mNext)
+    {
+        if (PeerOf(**link) == peer)
+        {
+            last = *link;
+        }
+    }
+
+    if (last != nullptr)
+    {
+        establisher->mNext = last->mNext;
+        last->mNext        = establisher;
+    }
+    else
+    {
+        establisher->mNext = nullptr;
+        *link              = establisher;
+        mMetrics.mPeers++;
+    }
+    mPendingCount++;
+}
+
+bool SubscriptionResumptionQueue::StartNextPeer(StartFunction start, void * context)
+{
+    VerifyOrReturnValue(mPendingHead != nullptr, false);
+
+    // Move all the subscriptions of the peer to the in-progress list before starting any of them: a resumption may complete
+    // synchronously, e.g. when a session to the peer already exists, and the peer must be seen as in progress until all of its
+    // subscriptions are done.
+    SubscriptionResumptionSessionEstablisher * first = mPendingHead;
+    SubscriptionResumptionSessionEstablisher * last  = first;
+    size_t count                                     = 1;
+    while (last->mNext != nullptr && PeerOf(*last->mNext) == PeerOf(*first))
+    {
+        last = last->mNext;
+        count++;
+    }
+    // A later Load() may have queued other subscriptions of a peer that is still in progress.
+    if (!HasPeerInProgress(PeerOf(*first)))
+    {
+        mPeersInProgress++;
+    }
+    mPendingHead    = last->mNext;
+    last->mNext     = mInProgressHead;
+    mInProgressHead = first;
+    mPendingCount -= count;
+
+    for (auto * establisher = first; count > 0; count--)
+    {
+        // Not started yet, so still linked whatever happens to the establishers started before it.
+        SubscriptionResumptionSessionEstablisher * next = establisher->mNext;
+        mMetrics.mStarted++;
+
+        CHIP_ERROR err = start(context, *establisher);
+        if (err == CHIP_ERROR_CANCELLED)
+        {
+            mMetrics.mStarted--;
+            mMetrics.mSkipped++;
+            Drop(*establisher);
+            Platform::Delete(establisher);
+        }
+        else if (err != CHIP_NO_ERROR)
+        {
+            ChipLogError(InteractionModel, "Failed to resume subscription 0x%" PRIx32 ": %" CHIP_ERROR_FORMAT,
+                         establisher->mSubscriptionInfo.mSubscriptionId, err.Format());
+            OnResumptionDone(*establisher, false);
+            Platform::Delete(establisher);
+        }
+        establisher = next;
+    }
+    return true;
+}
+
+void SubscriptionResumptionQueue::OnResumptionDone(SubscriptionResumptionSessionEstablisher & establisher, bool resumed)
+{
+    VerifyOrReturn(Drop(establisher));
+
+    if (resumed)
+    {
+        mMetrics.mResumed++;
+    }
+    else
+    {
+        mMetrics.mFailed++;
+    }
+
+    if (mInProgressHead == nullptr && mPendingHead == nullptr)
+    {
+        mMetrics.mResumeTime = std::chrono::duration_cast<System::Clock::Milliseconds32>(
+            System::SystemClock().GetMonotonicTimestamp() - mLoadTimestamp);
+        ChipLogProgress(InteractionModel, "Subscription resumption done in %" PRIu32 " ms: %u resumed, %u failed",
+                        mMetrics.mResumeTime.count(), static_cast<unsigned>(mMetrics.mResumed),
+                        static_cast<unsigned>(mMetrics.mFailed));
+    }
+    else
+    {
+        ChipLogDetail(InteractionModel, "Subscription resumption progress: %u of %u done, %u queued",
+                      static_cast<unsigned>(mMetrics.mResumed + mMetrics.mFailed), static_cast<unsigned>(mMetrics.mStarted),
+                      static_cast<unsigned>(mPendingCount));
+    }
+}
+
+bool SubscriptionResumptionQueue::Drop(SubscriptionResumptionSessionEstablisher & establisher)
+{
+    SubscriptionResumptionSessionEstablisher ** link = &mInProgressHead;
+    while (*link != nullptr && *link != &establisher)
+    {
+        link = &(*link)->mNext;
+    }
+    VerifyOrReturnValue(*link != nullptr, false);
+    *link             = establisher.mNext;
+    establisher.mNext = nullptr;
+
+    if (!HasPeerInProgress(PeerOf(establisher)) && mPeersInProgress > 0)
+    {
+        mPeersInProgress--;
+    }
+    return true;
+}
+
+bool SubscriptionResumptionQueue::HasPeerInProgress(const ScopedNodeId & peer) const
+{
+    for (auto * establisher = mInProgressHead; establisher != nullptr; establisher = establisher->mNext)
+    {
+        if (PeerOf(*establisher) == peer)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void SubscriptionResumptionQueue::Clear()
+{
+    while (mPendingHead != nullptr)
+    {
+        SubscriptionResumptionSessionEstablisher * next = mPendingHead->mNext;
+        Platform::Delete(mPendingHead);
+        mPendingHead = next;
+    }
+    mPendingCount = 0;
+}
+
+bool SubscriptionResumptionQueue::IsInProgress(const ScopedNodeId & peer, SubscriptionId subscriptionId) const
+{
+    return Contains(mInProgressHead, peer, subscriptionId);
+}
+
+bool SubscriptionResumptionQueue::Contains(const SubscriptionResumptionSessionEstablisher * list, const ScopedNodeId & peer,
+                                           SubscriptionId subscriptionId)
+{
+    for (; list != nullptr; list = list->mNext)
+    {
+        if (list->mSubscriptionInfo.mSubscriptionId == subscriptionId && PeerOf(*list) == peer)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace app
+} // namespace chip
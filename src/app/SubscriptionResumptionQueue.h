@@ -0,0 +1,130 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <app/SubscriptionResumptionSessionEstablisher.h>
+#include <app/SubscriptionResumptionStorage.h>
+#include <lib/core/ScopedNodeId.h>
+#include <system/SystemClock.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace chip {
+namespace app {
+
+/**
+ * Persisted subscriptions waiting to be resumed, grouped by peer.
+ *
+ * The queue is loaded with a single pass over the SubscriptionResumptionStorage, which keeps each subscription in the
+ * SubscriptionResumptionSessionEstablisher that will resume it. Subscriptions are then started one peer at a time: all the
+ * subscriptions of a peer are started together, so that they share the CASE session established for the first of them, and the
+ * caller limits how many peers are resumed concurrently with GetPeersInProgress().
+ */
+class SubscriptionResumptionQueue
+{
+public:
+    using SubscriptionInfo = SubscriptionResumptionStorage::SubscriptionInfo;
+
+    enum class Disposition : uint8_t
+    {
+        kResume,  ///< Queue the subscription for resumption
+        kSkip,    ///< Leave the subscription in storage without resuming it, e.g. because it is already live
+        kDiscard, ///< Delete the subscription from storage, as it can never be resumed
+    };
+
+    /// Decides what Load() does with a persisted subscription.
+    using ClassifyFunction = Disposition (*)(void * context, const SubscriptionInfo & subscriptionInfo);
+
+    /// Resumes a subscription. On failure the establisher is deleted by the queue; CHIP_ERROR_CANCELLED means that the
+    /// subscription no longer needs to be resumed.
+    using StartFunction = CHIP_ERROR (*)(void * context, SubscriptionResumptionSessionEstablisher & establisher);
+
+    struct Metrics
+    {
+        uint32_t mLoaded    = 0; ///< Subscriptions read from storage by the last Load()
+        uint32_t mSkipped   = 0; ///< Subscriptions not resumed because they were already live or being resumed
+        uint32_t mDiscarded = 0; ///< Subscriptions deleted from storage because they could not be resumed
+        uint32_t mPeers     = 0; ///< Distinct peers of the queued subscriptions
+        uint32_t mStarted   = 0; ///< Subscriptions for which a resumption was started
+        uint32_t mResumed   = 0; ///< Subscriptions successfully resumed
+        uint32_t mFailed    = 0; ///< Subscriptions whose resumption failed
+        System::Clock::Milliseconds32 mLoadTime{ 0 };   ///< Time taken by the last Load()
+        System::Clock::Milliseconds32 mResumeTime{ 0 }; ///< Time from the last Load() until the queue drained
+    };
+
+    SubscriptionResumptionQueue() = default;
+    ~SubscriptionResumptionQueue() { Clear(); }
+
+    SubscriptionResumptionQueue(const SubscriptionResumptionQueue &)             = delete;
+    SubscriptionResumptionQueue & operator=(const SubscriptionResumptionQueue &) = delete;
+
+    /**
+     * Reads all the subscriptions of the storage in a single pass and queues those that classify() accepts, grouped by peer.
+     * Subscriptions already queued or in progress are skipped. Resets the metrics if nothing was in progress.
+     */
+    CHIP_ERROR Load(SubscriptionResumptionStorage & storage, ClassifyFunction classify, void * context);
+
+    /**
+     * Starts the resumption of all the queued subscriptions of the next peer. Returns false when no subscription is queued.
+     */
+    bool StartNextPeer(StartFunction start, void * context);
+
+    /**
+     * Must be called when the resumption started for `establisher` completed, before the establisher is deleted.
+     */
+    void OnResumptionDone(SubscriptionResumptionSessionEstablisher & establisher, bool resumed);
+
+    /// Drops the queued subscriptions. Subscriptions in progress are left to complete.
+    void Clear();
+
+    bool HasPending() const { return mPendingHead != nullptr; }
+    size_t GetPendingCount() const { return mPendingCount; }
+    size_t GetPeersInProgress() const { return mPeersInProgress; }
+    bool IsInProgress(const ScopedNodeId & peer, SubscriptionId subscriptionId) const;
+
+    /// Largest min interval of the subscriptions queued by the last Load().
+    uint16_t GetMaxMinInterval() const { return mMaxMinInterval; }
+
+    const Metrics & GetMetrics() const { return mMetrics; }
+
+private:
+    static ScopedNodeId PeerOf(const SubscriptionResumptionSessionEstablisher & establisher)
+    {
+        return ScopedNodeId(establisher.mSubscriptionInfo.mNodeId, establisher.mSubscriptionInfo.mFabricIndex);
+    }
+
+    static bool Contains(const SubscriptionResumptionSessionEstablisher * list, const ScopedNodeId & peer,
+                         SubscriptionId subscriptionId);
+    void Enqueue(SubscriptionResumptionSessionEstablisher * establisher);
+    // Removes an establisher from the in-progress list, returns false if it was not in it.
+    bool Drop(SubscriptionResumptionSessionEstablisher & establisher);
+    bool HasPeerInProgress(const ScopedNodeId & peer) const;
+
+    // Singly linked lists through SubscriptionResumptionSessionEstablisher::mNext. Subscriptions of the same peer are adjacent.
+    SubscriptionResumptionSessionEstablisher * mPendingHead    = nullptr;
+    SubscriptionResumptionSessionEstablisher * mInProgressHead = nullptr;
+    size_t mPendingCount                                       = 0;
+    size_t mPeersInProgress                                    = 0;
+    uint16_t mMaxMinInterval                                   = 0;
+    System::Clock::Timestamp mLoadTimestamp;
+    Metrics mMetrics;
+};
+
+} // namespace app
+} // namespace chip
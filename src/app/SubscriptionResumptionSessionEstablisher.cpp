@@ -79,6 +79,11 @@ SubscriptionResumptionSessionEstablisher::ResumeSubscription(
         }
     }
 
+    return ResumeSubscription(caseSessionManager);
+}
+
+CHIP_ERROR SubscriptionResumptionSessionEstablisher::ResumeSubscription(CASESessionManager & caseSessionManager)
+{
     ScopedNodeId peerNode = ScopedNodeId(mSubscriptionInfo.mNodeId, mSubscriptionInfo.mFabricIndex);
     caseSessionManager.FindOrEstablishSession(peerNode, &mOnConnectedCallback, &mOnConnectionFailureCallback);
     return CHIP_NO_ERROR;
@@ -101,6 +106,7 @@ void SubscriptionResumptionSessionEstablisher::HandleDeviceConnected(void * cont
     {
         // TODO - Should we keep the subscription here?
         ChipLogProgress(InteractionModel, "no resource for subscription resumption");
+        imEngine->OnSubscriptionResumptionDone(*establisher, false);
         return;
     }
     ReadHandler * readHandler = imEngine->mReadHandlers.CreateObject(*imEngine, imEngine->GetReportScheduler());
@@ -108,9 +114,11 @@ void SubscriptionResumptionSessionEstablisher::HandleDeviceConnected(void * cont
     {
         // TODO - Should we keep the subscription here?
         ChipLogProgress(InteractionModel, "no resource for ReadHandler creation");
+        imEngine->OnSubscriptionResumptionDone(*establisher, false);
         return;
     }
     readHandler->OnSubscriptionResumed(sessionHandle, *establisher);
+    imEngine->OnSubscriptionResumptionDone(*establisher, true);
 #if CHIP_CONFIG_SUBSCRIPTION_TIMEOUT_RESUMPTION
     // Reset the resumption retries to 0 if subscription is resumed
     subscriptionInfo.mResumptionRetries  = 0;
@@ -135,6 +143,7 @@ void SubscriptionResumptionSessionEstablisher::HandleDeviceConnectionFailure(voi
     // We do this here since we were not able to connect to the subscriber thus we have completed our resumption attempt.
     // Counter only tracks the number of individual subscriptions we will try to resume.
     imEngine->DecrementNumSubscriptionsToResume();
+    imEngine->OnSubscriptionResumptionDone(*establisher, false);
 
     auto * subscriptionResumptionStorage = imEngine->GetSubscriptionResumptionStorage();
     if (!subscriptionResumptionStorage)
@@ -39,9 +39,19 @@ public:
     CHIP_ERROR ResumeSubscription(CASESessionManager & caseSessionManager,
                                   const SubscriptionResumptionStorage::SubscriptionInfo & subscriptionInfo);
 
+    /**
+     * Resumes the subscription already held in mSubscriptionInfo.
+     */
+    CHIP_ERROR ResumeSubscription(CASESessionManager & caseSessionManager);
+
     SubscriptionResumptionStorage::SubscriptionInfo mSubscriptionInfo;
 
 private:
+    friend class SubscriptionResumptionQueue;
+
+    // Link in the lists of the SubscriptionResumptionQueue
+    SubscriptionResumptionSessionEstablisher * mNext = nullptr;
+
     // Callback funstions for continuing the subscription resumption
     static void HandleDeviceConnected(void * context, Messaging::ExchangeManager & exchangeMgr,
                                       const SessionHandle & sessionHandle);
@@ -290,16 +290,11 @@ CHIP_ERROR WriteHandler::DeliverFinalListWriteEndForGroupWrite(bool writeWasSucc
     auto processingConcreteAttributePath = mProcessingAttributePath.Value();
     mProcessingAttributePath.ClearValue();
 
-    iterator = groupDataProvider->IterateEndpoints(fabricIndex);
+    iterator = groupDataProvider->IterateEndpoints(fabricIndex, std::make_optional(groupId));
     VerifyOrReturnError(iterator != nullptr, CHIP_ERROR_NO_MEMORY);
 
     while (iterator->Next(mapping))
     {
-        if (groupId != mapping.group_id)
-        {
-            continue;
-        }
-
         processingConcreteAttributePath.mEndpointId = mapping.endpoint_id;
 
         VerifyOrReturnError(mDelegate, CHIP_ERROR_INCORRECT_STATE);
@@ -475,7 +470,8 @@ CHIP_ERROR WriteHandler::ProcessGroupAttributeDataIBs(TLV::TLVReader & aAttribut
                       "Received group attribute write for Group=%u Cluster=" ChipLogFormatMEI " attribute=" ChipLogFormatMEI,
                       groupId, ChipLogValueMEI(dataAttributePath.mClusterId), ChipLogValueMEI(dataAttributePath.mAttributeId));
 
-        AutoReleaseGroupEndpointIterator iterator(Credentials::GetGroupDataProvider()->IterateEndpoints(fabric));
+        AutoReleaseGroupEndpointIterator iterator(
+            Credentials::GetGroupDataProvider()->IterateEndpoints(fabric, std::make_optional(groupId)));
         VerifyOrExit(!iterator.IsNull(), err = CHIP_ERROR_NO_MEMORY);
 
         bool shouldReportListWriteEnd = ShouldReportListWriteEnd(
@@ -487,11 +483,6 @@ CHIP_ERROR WriteHandler::ProcessGroupAttributeDataIBs(TLV::TLVReader & aAttribut
         Credentials::GroupDataProvider::GroupEndpoint mapping;
         while (iterator.Next(mapping))
         {
-            if (groupId != mapping.group_id)
-            {
-                continue;
-            }
-
             dataAttributePath.mEndpointId = mapping.endpoint_id;
 
             // Try to get the metadata from for the attribute from one of the expanded endpoints (it doesn't really matter which
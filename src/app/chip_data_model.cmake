@@ -168,7 +168,9 @@ function(chip_configure_data_model APP_TARGET)
         ${CHIP_APP_BASE_DIR}/util/privilege-storage.cpp
         ${CHIP_APP_BASE_DIR}/util/util.cpp
         ${CHIP_APP_BASE_DIR}/util/persistence/AttributePersistenceProvider.cpp
+        ${CHIP_APP_BASE_DIR}/util/persistence/CoalescingAttributePersistenceProvider.cpp
         ${CHIP_APP_BASE_DIR}/util/persistence/DefaultAttributePersistenceProvider.cpp
+        ${CHIP_APP_BASE_DIR}/util/persistence/PackedAttributePersistenceProvider.cpp
         ${CODEGEN_DATA_MODEL_SOURCES}
         ${APP_GEN_FILES}
         ${APP_TEMPLATES_GEN_FILES}
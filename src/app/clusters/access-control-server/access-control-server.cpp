@@ -101,6 +101,7 @@ private:
     CHIP_ERROR ReadAcl(AttributeValueEncoder & aEncoder);
     CHIP_ERROR ReadExtension(AttributeValueEncoder & aEncoder);
     CHIP_ERROR WriteAcl(const ConcreteDataAttributePath & aPath, AttributeValueDecoder & aDecoder);
+    CHIP_ERROR WriteAclEntries(const ConcreteDataAttributePath & aPath, AttributeValueDecoder & aDecoder);
     CHIP_ERROR WriteExtension(const ConcreteDataAttributePath & aPath, AttributeValueDecoder & aDecoder);
 #if CHIP_CONFIG_USE_ACCESS_RESTRICTIONS
     CHIP_ERROR ReadCommissioningArl(AttributeValueEncoder & aEncoder);
@@ -263,6 +264,18 @@ CHIP_ERROR AccessControlAttribute::WriteImpl(const ConcreteDataAttributePath & a
 }
 
 CHIP_ERROR AccessControlAttribute::WriteAcl(const ConcreteDataAttributePath & aPath, AttributeValueDecoder & aDecoder)
+{
+    // Entries are persisted one by one by the ACL storage entry listener. Group all of them into a
+    // single storage batch. The batch is committed even if the write fails part-way, since entries
+    // already changed remain in effect and storage must keep matching them.
+    PersistentStorageBatch storageBatch(&Server::GetInstance().GetPersistentStorage());
+    CHIP_ERROR err      = WriteAclEntries(aPath, aDecoder);
+    CHIP_ERROR batchErr = storageBatch.Commit();
+    ReturnErrorOnFailure(err);
+    return batchErr;
+}
+
+CHIP_ERROR AccessControlAttribute::WriteAclEntries(const ConcreteDataAttributePath & aPath, AttributeValueDecoder & aDecoder)
 {
     FabricIndex accessingFabricIndex = aDecoder.AccessingFabricIndex();
 
@@ -75,6 +75,8 @@ CHIP_ERROR BDXDiagnosticLogsProvider::InitializeTransfer(CommandHandler * comman
     initOptions.MaxBlockSize     = kBdxMaxBlockSize;
     initOptions.FileDesLength    = static_cast<uint16_t>(fileDesignator.size());
     initOptions.FileDesignator   = Uint8::from_const_char(fileDesignator.data());
+    // MRP allows a single unacknowledged message per exchange, so only propose a windowed transfer over TCP.
+    initOptions.Windowed = !sessionHandle->AllowsMRP();
 
     CHIP_ERROR err = Initiator::InitiateTransfer(&DeviceLayer::SystemLayer(), TransferRole::kSender, initOptions, kBdxTimeout,
                                                  kBdxPollIntervalMs);
@@ -114,11 +116,11 @@ void BDXDiagnosticLogsProvider::HandleTransferSessionOutput(TransferSession::Out
         break;
     case TransferSession::OutputEventType::kAcceptReceived:
         OnAcceptReceived();
-        // Upon acceptance of the transfer, the OnAckReceived method initiates the process of sending logs.
-        OnAckReceived();
+        // Upon acceptance of the transfer, the PrepareNextBlock method initiates the process of sending logs.
+        PrepareNextBlock();
         break;
     case TransferSession::OutputEventType::kAckReceived:
-        OnAckReceived();
+        PrepareNextBlock();
         break;
     case TransferSession::OutputEventType::kAckEOFReceived:
         OnAckEOFReceived();
@@ -162,7 +164,13 @@ void BDXDiagnosticLogsProvider::OnMsgToSend(TransferSession::OutputEvent & event
     auto err =
         mBDXTransferExchangeCtx->SendMessage(msgTypeData.ProtocolId, msgTypeData.MessageType, std::move(event.MsgData), sendFlags);
 
-    VerifyOrDo(CHIP_NO_ERROR == err, Reset(err));
+    VerifyOrReturn(CHIP_NO_ERROR == err, Reset(err));
+
+    // In a windowed transfer, keep sending blocks until the window is full instead of waiting for each BlockAck.
+    if (mTransfer.IsWindowed())
+    {
+        PrepareNextBlock();
+    }
 }
 
 void BDXDiagnosticLogsProvider::OnAcceptReceived()
@@ -174,8 +182,11 @@ void BDXDiagnosticLogsProvider::OnAcceptReceived()
     SendCommandResponse(StatusEnum::kSuccess);
 }
 
-void BDXDiagnosticLogsProvider::OnAckReceived()
+void BDXDiagnosticLogsProvider::PrepareNextBlock()
 {
+    // Nothing to do while a BlockAck is awaited, or once the BlockEOF has been sent.
+    VerifyOrReturn(mTransfer.IsWindowOpen());
+
     uint16_t blockSize = mTransfer.GetTransferBlockSize();
 
     auto blockBuf = System::PacketBufferHandle::New(blockSize);
@@ -65,7 +65,7 @@ public:
 private:
     void OnMsgToSend(bdx::TransferSession::OutputEvent & event);
     void OnAcceptReceived();
-    void OnAckReceived();
+    void PrepareNextBlock();
     void OnAckEOFReceived();
     void OnStatusReceived(bdx::TransferSession::OutputEvent & event);
     void OnInternalError();
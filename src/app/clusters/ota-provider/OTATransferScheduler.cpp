@@ -0,0 +1,290 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/clusters/ota-provider/OTATransferScheduler.h>
+
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+#include <algorithm>
+
+namespace chip {
+namespace ota {
+
+using System::Clock::Milliseconds64;
+using System::Clock::Seconds32;
+using System::Clock::Timestamp;
+
+CHIP_ERROR OTATransferScheduler::Init(uint8_t maxConcurrentTransfers)
+{
+    VerifyOrReturnError(maxConcurrentTransfers > 0 && maxConcurrentTransfers <= kMaxConcurrentTransfers,
+                        CHIP_ERROR_INVALID_ARGUMENT);
+
+    for (Transfer & transfer : mTransfers)
+    {
+        transfer = Transfer();
+    }
+    mQueueLength  = 0;
+    mMaxTransfers = maxConcurrentTransfers;
+    return CHIP_NO_ERROR;
+}
+
+void OTATransferScheduler::SetExpectedTransferRate(uint32_t bytesPerSecond)
+{
+    VerifyOrReturn(bytesPerSecond > 0);
+    mTransferRate = bytesPerSecond;
+}
+
+CHIP_ERROR OTATransferScheduler::RequestTransfer(const ScopedNodeId & requestor, uint64_t imageSize, Timestamp now, uint8_t & slot,
+                                                 Seconds32 & delayedActionTime)
+{
+    ExpireQueuedRequestors(now);
+    ExpireUnstartedTransfers(now);
+
+    Transfer * transfer = FindTransfer(requestor);
+    if (transfer != nullptr)
+    {
+        // The Requestor queried again, e.g. after a reboot: it starts its download over in the same slot.
+        ChipLogProgress(SoftwareUpdate, "Restarting OTA transfer to " ChipLogFormatScopedNodeId,
+                        ChipLogValueScopedNodeId(requestor));
+        transfer->imageSize = imageSize;
+        transfer->bytesSent = 0;
+        transfer->startTime = now;
+        slot                = static_cast<uint8_t>(transfer - mTransfers);
+        return CHIP_NO_ERROR;
+    }
+
+    // The free slots are kept for the Requestors ahead in line that are due to query again.
+    const size_t position = FindQueuedRequestor(requestor);
+    size_t numReserved    = 0;
+    for (size_t i = 0; i < position; i++)
+    {
+        numReserved += (mQueue[i].retryTime <= now) ? 1 : 0;
+    }
+
+    size_t numFree = 0;
+    slot           = kNoSlot;
+    for (uint8_t i = 0; i < mMaxTransfers; i++)
+    {
+        if (!mTransfers[i].inUse)
+        {
+            slot = (slot == kNoSlot) ? i : slot;
+            numFree++;
+        }
+    }
+
+    if (numFree > numReserved)
+    {
+        if (position < mQueueLength)
+        {
+            RemoveQueuedRequestor(position);
+        }
+
+        Transfer & admitted = mTransfers[slot];
+        admitted.requestor  = requestor;
+        admitted.imageSize  = imageSize;
+        admitted.bytesSent  = 0;
+        admitted.startTime  = now;
+        admitted.inUse      = true;
+        return CHIP_NO_ERROR;
+    }
+
+    slot              = kNoSlot;
+    delayedActionTime = GetDelayedActionTime(position, imageSize);
+
+    if (position == mQueueLength && mQueueLength < kMaxQueuedRequestors)
+    {
+        mQueue[mQueueLength++].requestor = requestor;
+    }
+    if (position < mQueueLength)
+    {
+        mQueue[position].retryTime = now + delayedActionTime;
+    }
+
+    ChipLogProgress(SoftwareUpdate, "OTA Requestor " ChipLogFormatScopedNodeId " is #%u in line, retry in %" PRIu32 "s",
+                    ChipLogValueScopedNodeId(requestor), static_cast<unsigned>(position + 1), delayedActionTime.count());
+    return CHIP_ERROR_BUSY;
+}
+
+uint8_t OTATransferScheduler::GetSlot(const ScopedNodeId & requestor) const
+{
+    for (uint8_t i = 0; i < mMaxTransfers; i++)
+    {
+        if (mTransfers[i].inUse && mTransfers[i].requestor == requestor)
+        {
+            return i;
+        }
+    }
+    return kNoSlot;
+}
+
+void OTATransferScheduler::OnBlockSent(const ScopedNodeId & requestor, size_t length, Timestamp now)
+{
+    UpdateThroughput(now);
+    mTotalBytes += length;
+    mWindowBytes += length;
+
+    Transfer * transfer = FindTransfer(requestor);
+    VerifyOrReturn(transfer != nullptr);
+    transfer->bytesSent += length;
+}
+
+void OTATransferScheduler::OnTransferEnded(const ScopedNodeId & requestor, bool completed, Timestamp now)
+{
+    Transfer * transfer = FindTransfer(requestor);
+    VerifyOrReturn(transfer != nullptr);
+
+    transfer->inUse = false;
+    if (!completed)
+    {
+        mFailed++;
+        return;
+    }
+
+    const Milliseconds64 elapsed = now - transfer->startTime;
+    if (elapsed.count() > 0 && transfer->bytesSent > 0)
+    {
+        // The estimate follows the recent transfers, as the load of the Provider and of the network changes.
+        const uint64_t sample = (transfer->bytesSent * 1000) / elapsed.count();
+        const uint64_t rate   = (mCompleted == 0) ? sample : (3 * static_cast<uint64_t>(mTransferRate) + sample) / 4;
+        mTransferRate         = static_cast<uint32_t>(std::min<uint64_t>(std::max<uint64_t>(rate, 1), UINT32_MAX));
+    }
+    mCompleted++;
+}
+
+OTATransferScheduler::Metrics OTATransferScheduler::GetMetrics(Timestamp now) const
+{
+    Metrics metrics;
+
+    for (uint8_t i = 0; i < mMaxTransfers; i++)
+    {
+        metrics.activeTransfers = static_cast<uint8_t>(metrics.activeTransfers + (mTransfers[i].inUse ? 1 : 0));
+    }
+    for (size_t i = 0; i < mQueueLength; i++)
+    {
+        metrics.queueDepth = static_cast<uint16_t>(metrics.queueDepth + ((mQueue[i].retryTime + kRetryGracePeriod >= now) ? 1 : 0));
+    }
+
+    // A window that should have ended, because no Block was sent since, reports the throughput since it started.
+    const Milliseconds64 elapsed = now - mWindowStart;
+    metrics.throughput           = mThroughput;
+    if (elapsed >= kThroughputWindow)
+    {
+        metrics.throughput = static_cast<uint32_t>(std::min<uint64_t>((mWindowBytes * 1000) / elapsed.count(), UINT32_MAX));
+    }
+
+    metrics.transferRate       = mTransferRate;
+    metrics.completedTransfers = mCompleted;
+    metrics.failedTransfers    = mFailed;
+    metrics.totalBytesSent     = mTotalBytes;
+    return metrics;
+}
+
+OTATransferScheduler::Transfer * OTATransferScheduler::FindTransfer(const ScopedNodeId & requestor)
+{
+    const uint8_t slot = GetSlot(requestor);
+    return (slot == kNoSlot) ? nullptr : &mTransfers[slot];
+}
+
+size_t OTATransferScheduler::FindQueuedRequestor(const ScopedNodeId & requestor) const
+{
+    for (size_t i = 0; i < mQueueLength; i++)
+    {
+        if (mQueue[i].requestor == requestor)
+        {
+            return i;
+        }
+    }
+    return mQueueLength;
+}
+
+void OTATransferScheduler::RemoveQueuedRequestor(size_t index)
+{
+    std::move(&mQueue[index + 1], &mQueue[mQueueLength], &mQueue[index]);
+    mQueueLength--;
+}
+
+void OTATransferScheduler::ExpireQueuedRequestors(Timestamp now)
+{
+    for (size_t i = 0; i < mQueueLength;)
+    {
+        if (mQueue[i].retryTime + kRetryGracePeriod < now)
+        {
+            ChipLogProgress(SoftwareUpdate, "OTA Requestor " ChipLogFormatScopedNodeId " did not come back, dropped from line",
+                            ChipLogValueScopedNodeId(mQueue[i].requestor));
+            RemoveQueuedRequestor(i);
+        }
+        else
+        {
+            i++;
+        }
+    }
+}
+
+void OTATransferScheduler::ExpireUnstartedTransfers(Timestamp now)
+{
+    for (uint8_t i = 0; i < mMaxTransfers; i++)
+    {
+        Transfer & transfer = mTransfers[i];
+        if (transfer.inUse && transfer.bytesSent == 0 && transfer.startTime + kTransferStartTimeout < now)
+        {
+            ChipLogProgress(SoftwareUpdate, "OTA Requestor " ChipLogFormatScopedNodeId " did not start its transfer",
+                            ChipLogValueScopedNodeId(transfer.requestor));
+            transfer.inUse = false;
+            mFailed++;
+        }
+    }
+}
+
+void OTATransferScheduler::UpdateThroughput(Timestamp now)
+{
+    const Milliseconds64 elapsed = now - mWindowStart;
+    VerifyOrReturn(elapsed >= kThroughputWindow);
+
+    mThroughput  = static_cast<uint32_t>(std::min<uint64_t>((mWindowBytes * 1000) / elapsed.count(), UINT32_MAX));
+    mWindowBytes = 0;
+    mWindowStart = now;
+}
+
+Milliseconds64 OTATransferScheduler::GetTransferDuration(uint64_t numBytes) const
+{
+    return Milliseconds64((numBytes * 1000) / mTransferRate);
+}
+
+Seconds32 OTATransferScheduler::GetDelayedActionTime(size_t position, uint64_t imageSize) const
+{
+    // When each slot is expected to free up: the Requestors in line take them in turn, each one for a whole transfer.
+    Milliseconds64 freeTimes[kMaxConcurrentTransfers];
+    for (uint8_t i = 0; i < mMaxTransfers; i++)
+    {
+        const Transfer & transfer = mTransfers[i];
+        freeTimes[i] = transfer.inUse ? GetTransferDuration(transfer.imageSize - std::min(transfer.bytesSent, transfer.imageSize))
+                                      : System::Clock::kZero;
+    }
+    std::sort(freeTimes, freeTimes + mMaxTransfers);
+
+    const uint64_t rounds     = position / mMaxTransfers;
+    const Milliseconds64 wait = freeTimes[position % mMaxTransfers] + GetTransferDuration(imageSize) * rounds;
+
+    // Round up, so that the slot has freed up when the Requestor comes back.
+    const uint64_t seconds = (wait.count() + 999) / 1000;
+    return std::max(kMinDelayedActionTime, Seconds32(static_cast<uint32_t>(std::min<uint64_t>(seconds, UINT32_MAX))));
+}
+
+} // namespace ota
+} // namespace chip
@@ -0,0 +1,162 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#pragma once
+
+#include <lib/core/CHIPConfig.h>
+#include <lib/core/CHIPError.h>
+#include <lib/core/ScopedNodeId.h>
+#include <system/SystemClock.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace chip {
+namespace ota {
+
+/**
+ * @brief Admission control for the BDX transfers of an OTA Provider that serves many OTA Requestors.
+ *
+ * The scheduler admits up to a configured number of concurrent transfers, each of which is assigned a slot, e.g. the index
+ * of the BDX sender that serves it. The Requestors that query while all the slots are in use are kept in line, in the order
+ * of their first query, and are told when to query again (the DelayedActionTime of a Busy QueryImageResponse). That time is
+ * derived from the progress of the transfers in use and from the throughput measured on completed transfers, so that each
+ * Requestor comes back about when a slot frees up for it. A slot that frees up is kept for the Requestors ahead in line until
+ * they are due, and a Requestor that does not come back in time loses its place, as does an admitted Requestor that does not
+ * start its transfer.
+ *
+ * All the methods take the current monotonic time, and must be called from the same thread, normally the CHIP stack thread.
+ */
+class OTATransferScheduler
+{
+public:
+    static constexpr uint8_t kMaxConcurrentTransfers = CHIP_CONFIG_OTA_PROVIDER_MAX_CONCURRENT_TRANSFERS;
+    static constexpr size_t kMaxQueuedRequestors     = CHIP_CONFIG_OTA_PROVIDER_MAX_QUEUED_REQUESTORS;
+    static constexpr uint8_t kNoSlot                 = UINT8_MAX;
+
+    // OTA Requestors wait at least 120 seconds before querying again, whatever the DelayedActionTime (see the OTA
+    // Requestor driver), so shorter delays are not handed out.
+    static constexpr System::Clock::Seconds32 kMinDelayedActionTime = System::Clock::Seconds32(120);
+
+    // How long an admitted Requestor has to send its first BlockQuery before its slot is given to another one.
+    static constexpr System::Clock::Seconds32 kTransferStartTimeout = System::Clock::Seconds32(5 * 60);
+
+    // How long a Requestor keeps its place in line after the time it was told to query again.
+    static constexpr System::Clock::Seconds32 kRetryGracePeriod = System::Clock::Seconds32(120);
+
+    // Per-transfer throughput assumed until a transfer has completed.
+    static constexpr uint32_t kDefaultTransferRate = 4096; // bytes per second
+
+    // Period over which the aggregate throughput reported by GetMetrics() is measured.
+    static constexpr System::Clock::Milliseconds64 kThroughputWindow = System::Clock::Milliseconds64(10000);
+
+    struct Metrics
+    {
+        uint8_t activeTransfers     = 0;
+        uint16_t queueDepth         = 0;
+        uint32_t throughput         = 0; // bytes per second, over all the transfers, during the last complete window
+        uint32_t transferRate       = 0; // bytes per second, estimated for a single transfer
+        uint32_t completedTransfers = 0;
+        uint32_t failedTransfers    = 0;
+        uint64_t totalBytesSent     = 0;
+    };
+
+    /**
+     * Sets the number of transfers admitted at the same time, and forgets all the transfers and Requestors in line.
+     *
+     * @retval CHIP_ERROR_INVALID_ARGUMENT if maxConcurrentTransfers is 0 or greater than kMaxConcurrentTransfers.
+     */
+    CHIP_ERROR Init(uint8_t maxConcurrentTransfers);
+
+    /**
+     * Sets the per-transfer throughput assumed until a transfer has completed, e.g. one suited to the transport in use.
+     */
+    void SetExpectedTransferRate(uint32_t bytesPerSecond);
+
+    /**
+     * Asks for a transfer of an image to a Requestor. A Requestor that already has a transfer keeps its slot, and the
+     * transfer is restarted.
+     *
+     * @param[in]  requestor            The Requestor that queried for an image.
+     * @param[in]  imageSize            The size of the image it will download, or 0 if unknown.
+     * @param[in]  now                  The current monotonic time.
+     * @param[out] slot                 The slot of the transfer, if admitted.
+     * @param[out] delayedActionTime    The time after which the Requestor should query again, if not admitted.
+     *
+     * @retval CHIP_NO_ERROR        if the transfer is admitted.
+     * @retval CHIP_ERROR_BUSY      if the Requestor must query again after delayedActionTime.
+     */
+    CHIP_ERROR RequestTransfer(const ScopedNodeId & requestor, uint64_t imageSize, System::Clock::Timestamp now, uint8_t & slot,
+                               System::Clock::Seconds32 & delayedActionTime);
+
+    /**
+     * Returns the slot of the transfer to a Requestor, or kNoSlot if it has none.
+     */
+    uint8_t GetSlot(const ScopedNodeId & requestor) const;
+
+    /**
+     * Records that a Block of a transfer to a Requestor was sent.
+     */
+    void OnBlockSent(const ScopedNodeId & requestor, size_t length, System::Clock::Timestamp now);
+
+    /**
+     * Releases the slot of the transfer to a Requestor. Completed transfers update the estimated per-transfer throughput.
+     */
+    void OnTransferEnded(const ScopedNodeId & requestor, bool completed, System::Clock::Timestamp now);
+
+    Metrics GetMetrics(System::Clock::Timestamp now) const;
+
+private:
+    struct Transfer
+    {
+        ScopedNodeId requestor;
+        uint64_t imageSize = 0;
+        uint64_t bytesSent = 0;
+        System::Clock::Timestamp startTime;
+        bool inUse = false;
+    };
+
+    struct QueuedRequestor
+    {
+        ScopedNodeId requestor;
+        System::Clock::Timestamp retryTime;
+    };
+
+    Transfer * FindTransfer(const ScopedNodeId & requestor);
+    size_t FindQueuedRequestor(const ScopedNodeId & requestor) const;
+    void RemoveQueuedRequestor(size_t index);
+    void ExpireQueuedRequestors(System::Clock::Timestamp now);
+    void ExpireUnstartedTransfers(System::Clock::Timestamp now);
+    void UpdateThroughput(System::Clock::Timestamp now);
+    System::Clock::Milliseconds64 GetTransferDuration(uint64_t numBytes) const;
+    System::Clock::Seconds32 GetDelayedActionTime(size_t position, uint64_t imageSize) const;
+
+    Transfer mTransfers[kMaxConcurrentTransfers];
+    QueuedRequestor mQueue[kMaxQueuedRequestors];
+    size_t mQueueLength                   = 0;
+    uint8_t mMaxTransfers                 = 1;
+    uint32_t mTransferRate                = kDefaultTransferRate;
+    uint32_t mCompleted                   = 0;
+    uint32_t mFailed                      = 0;
+    uint64_t mTotalBytes                  = 0;
+    uint64_t mWindowBytes                 = 0;
+    uint32_t mThroughput                  = 0;
+    System::Clock::Timestamp mWindowStart = System::Clock::kZero;
+};
+
+} // namespace ota
+} // namespace chip
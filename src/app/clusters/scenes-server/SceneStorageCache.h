@@ -0,0 +1,48 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <lib/core/CHIPConfig.h>
+#include <lib/support/PersistentStorageCache.h>
+
+#include <stddef.h>
+
+namespace chip {
+namespace scenes {
+
+/**
+ * @brief Write-through, in-memory cache of the scene table records.
+ *
+ * The scene table is made of an index (the scene count of each endpoint and the scene map of each fabric on each endpoint) and
+ * of the scenes themselves, each stored under its own key. Looking up a scene therefore takes several storage reads. Placing
+ * this cache between the scene table and its PersistentStorageDelegate keeps the most recently used records in memory, so that
+ * once a scene has been accessed, recalling it again or querying the index does not touch storage.
+ */
+using SceneStorageCacheBase = PersistentStorageCacheBase;
+
+/**
+ * @brief SceneStorageCacheBase holding up to kEntryCount records.
+ *
+ * A table with E endpoints and F fabrics needs E * (F + 1) entries to keep the whole index in memory, plus one entry per scene
+ * that should be recalled without accessing storage.
+ */
+template <size_t kEntryCount>
+using SceneStorageCache = PersistentStorageCache<kEntryCount, CHIP_CONFIG_SCENES_MAX_SERIALIZED_SCENE_SIZE_BYTES>;
+
+} // namespace scenes
+} // namespace chip
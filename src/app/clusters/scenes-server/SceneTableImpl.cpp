@@ -507,6 +507,12 @@ CHIP_ERROR DefaultSceneTableImpl::Init(PersistentStorageDelegate * storage)
     // Verified the initialized parameter respect the maximum allowed values for scene capacity
     VerifyOrReturnError(mMaxScenesPerFabric <= kMaxScenesPerFabric && mMaxScenesPerEndpoint <= kMaxScenesPerEndpoint,
                         CHIP_ERROR_INVALID_INTEGER_VALUE);
+
+    if (mStorageCache != nullptr)
+    {
+        ReturnErrorOnFailure(mStorageCache->Init(storage));
+        storage = mStorageCache;
+    }
     mStorage = storage;
     return CHIP_NO_ERROR;
 }
@@ -587,13 +593,15 @@ CHIP_ERROR DefaultSceneTableImpl::SetSceneTableEntry(FabricIndex fabric_index, c
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
 
     FabricSceneData fabric(mEndpointId, fabric_index, mMaxScenesPerFabric, mMaxScenesPerEndpoint);
+    PersistentStorageBatch storageBatch(mStorage);
 
     // Load fabric data (defaults to zero)
     CHIP_ERROR err = fabric.Load(mStorage);
     VerifyOrReturnError(CHIP_NO_ERROR == err || CHIP_ERROR_NOT_FOUND == err, err);
 
-    err = fabric.SaveScene(mStorage, entry);
-    return err;
+    // The scene, the fabric scene map and the endpoint scene count are committed together
+    ReturnErrorOnFailure(fabric.SaveScene(mStorage, entry));
+    return storageBatch.Commit();
 }
 
 CHIP_ERROR DefaultSceneTableImpl::GetSceneTableEntry(FabricIndex fabric_index, SceneStorageId scene_id, SceneTableEntry & entry)
@@ -626,10 +634,12 @@ CHIP_ERROR DefaultSceneTableImpl::RemoveSceneTableEntry(FabricIndex fabric_index
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
     FabricSceneData fabric(mEndpointId, fabric_index, mMaxScenesPerFabric, mMaxScenesPerEndpoint);
+    PersistentStorageBatch storageBatch(mStorage);
 
     ReturnErrorOnFailure(fabric.Load(mStorage));
+    ReturnErrorOnFailure(fabric.RemoveScene(mStorage, scene_id));
 
-    return fabric.RemoveScene(mStorage, scene_id);
+    return storageBatch.Commit();
 }
 
 /// @brief This function is meant to provide a way to empty the scene table without knowing any specific scene Id. Outside of this
@@ -645,13 +655,22 @@ CHIP_ERROR DefaultSceneTableImpl::RemoveSceneTableEntryAtPosition(EndpointId end
     CHIP_ERROR err = CHIP_NO_ERROR;
     FabricSceneData fabric(endpoint, fabric_index, mMaxScenesPerFabric, mMaxScenesPerEndpoint);
     SceneTableData scene(endpoint, fabric_index, scene_idx);
+    PersistentStorageBatch storageBatch(mStorage);
 
     ReturnErrorOnFailure(fabric.Load(mStorage));
     err = scene.Load(mStorage);
-    VerifyOrReturnValue(CHIP_ERROR_NOT_FOUND != err, CHIP_NO_ERROR);
+    if (CHIP_NO_ERROR == err)
+    {
+        err = fabric.RemoveScene(mStorage, scene.mStorageId);
+    }
+    else if (CHIP_ERROR_NOT_FOUND == err)
+    {
+        err = CHIP_NO_ERROR;
+    }
     ReturnErrorOnFailure(err);
 
-    return fabric.RemoveScene(mStorage, scene.mStorageId);
+    // Loading the fabric may also have removed scenes, commit in all cases
+    return storageBatch.Commit();
 }
 
 CHIP_ERROR DefaultSceneTableImpl::GetAllSceneIdsInGroup(FabricIndex fabric_index, GroupId group_id, Span<SceneId> & scene_list)
@@ -688,6 +707,7 @@ CHIP_ERROR DefaultSceneTableImpl::DeleteAllScenesInGroup(FabricIndex fabric_inde
 
     FabricSceneData fabric(mEndpointId, fabric_index, mMaxScenesPerFabric, mMaxScenesPerEndpoint);
     SceneTableData scene(mEndpointId, fabric_index);
+    PersistentStorageBatch storageBatch(mStorage);
 
     CHIP_ERROR err = fabric.Load(mStorage);
     VerifyOrReturnValue(CHIP_ERROR_NOT_FOUND != err, CHIP_NO_ERROR);
@@ -702,7 +722,7 @@ CHIP_ERROR DefaultSceneTableImpl::DeleteAllScenesInGroup(FabricIndex fabric_inde
         }
     }
 
-    return CHIP_NO_ERROR;
+    return storageBatch.Commit();
 }
 
 /// @brief Register a handler in the handler linked list
@@ -801,6 +821,7 @@ CHIP_ERROR DefaultSceneTableImpl::SceneApplyEFS(const SceneTableEntry & scene)
 CHIP_ERROR DefaultSceneTableImpl::RemoveFabric(FabricIndex fabric_index)
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
+    PersistentStorageBatch storageBatch(mStorage);
 
     for (auto endpoint : app::EnabledEndpointsWithServerCluster(chip::app::Clusters::ScenesManagement::Id))
     {
@@ -824,12 +845,13 @@ CHIP_ERROR DefaultSceneTableImpl::RemoveFabric(FabricIndex fabric_index)
         ReturnErrorOnFailure(fabric.Delete(mStorage));
     }
 
-    return CHIP_NO_ERROR;
+    return storageBatch.Commit();
 }
 
 CHIP_ERROR DefaultSceneTableImpl::RemoveEndpoint()
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
+    PersistentStorageBatch storageBatch(mStorage);
 
     for (FabricIndex fabric_index = kMinValidFabricIndex; fabric_index < kMaxValidFabricIndex; fabric_index++)
     {
@@ -853,7 +875,7 @@ CHIP_ERROR DefaultSceneTableImpl::RemoveEndpoint()
         ReturnErrorOnFailure(fabric.Delete(mStorage));
     }
 
-    return CHIP_NO_ERROR;
+    return storageBatch.Commit();
 }
 
 /// @brief wrapper function around emberAfGetClustersFromEndpoint to allow testing, shimmed in test configuration because
@@ -941,7 +963,12 @@ void DefaultSceneTableImpl::SceneEntryIteratorImpl::Release()
 
 namespace {
 
+#if CHIP_CONFIG_SCENES_TABLE_CACHE_SIZE > 0
+static SceneStorageCache<CHIP_CONFIG_SCENES_TABLE_CACHE_SIZE> gSceneStorageCache;
+static DefaultSceneTableImpl gSceneTableImpl(&gSceneStorageCache);
+#else
 static DefaultSceneTableImpl gSceneTableImpl;
+#endif // CHIP_CONFIG_SCENES_TABLE_CACHE_SIZE > 0
 
 } // namespace
 
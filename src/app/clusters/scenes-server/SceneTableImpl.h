@@ -18,6 +18,7 @@
 #pragma once
 #include <app/clusters/scenes-server/ExtensionFieldSetsImpl.h>
 #include <app/clusters/scenes-server/SceneHandlerImpl.h>
+#include <app/clusters/scenes-server/SceneStorageCache.h>
 #include <app/clusters/scenes-server/SceneTable.h>
 #include <app/util/attribute-storage.h>
 #include <app/util/config.h>
@@ -48,11 +49,18 @@ static constexpr uint16_t kMaxScenesPerFabric = (kMaxScenesPerEndpoint - 1) / 2;
  * It handles the storage of scenes by their ID, GroupID and EnpointID over multiple fabrics.
  * It is meant to be used exclusively when the scene cluster is enable for at least one endpoint
  * on the device.
+ *
+ * When constructed with a SceneStorageCacheBase, all storage accesses go through that cache, so that the scene table index and
+ * the recently used scenes are served from memory. The cache assumes that this table is the only writer of the scene keys in the
+ * storage: records written there by anything else, e.g. another DefaultSceneTableImpl on the same storage, are not seen until
+ * Init() is called again. In all cases, the storage writes made by a single operation on the table are committed as one
+ * PersistentStorageBatch.
  */
 class DefaultSceneTableImpl : public SceneTable<scenes::ExtensionFieldSetsImpl>
 {
 public:
     DefaultSceneTableImpl() {}
+    explicit DefaultSceneTableImpl(SceneStorageCacheBase * storageCache) : mStorageCache(storageCache) {}
     ~DefaultSceneTableImpl() { Finish(); };
 
     CHIP_ERROR Init(PersistentStorageDelegate * storage) override;
@@ -133,6 +141,7 @@ protected:
     uint16_t mMaxScenesPerEndpoint             = kMaxScenesPerEndpoint;
     EndpointId mEndpointId                     = kInvalidEndpointId;
     chip::PersistentStorageDelegate * mStorage = nullptr;
+    SceneStorageCacheBase * mStorageCache      = nullptr;
     ObjectPool<SceneEntryIteratorImpl, kIteratorsMax> mSceneEntryIterators;
 }; // class DefaultSceneTableImpl
 
@@ -183,6 +183,55 @@ CHIP_ERROR UpdateFabricSceneInfo(EndpointId endpoint, FabricIndex fabric, Option
     return CHIP_NO_ERROR;
 }
 
+/// @brief Creates the SceneInfoStruct of the fabrics that do not have one yet on an endpoint. Loading reads, and may trim, the
+/// scene table of every fabric, so it is scheduled by the endpoint init callback to run once startup is done.
+/// @param arg Endpoint to load
+void LoadFabricSceneInfo(intptr_t arg)
+{
+    EndpointId endpoint        = static_cast<EndpointId>(arg);
+    uint16_t endpointTableSize = 0;
+    VerifyOrReturn(Status::Success == Attributes::SceneTableSize::Get(endpoint, &endpointTableSize));
+
+    // Get Scene Table Instance
+    SceneTable * sceneTable = scenes::GetSceneTableImpl(endpoint, endpointTableSize);
+    VerifyOrReturn(nullptr != sceneTable);
+
+    bool loaded = false;
+    for (auto & fabricInfo : chip::Server::GetInstance().GetFabricTable())
+    {
+        FabricIndex fabric = fabricInfo.GetFabricIndex();
+        if (nullptr != ScenesServer::Instance().GetSceneInfoStruct(endpoint, fabric))
+        {
+            continue;
+        }
+
+        Structs::SceneInfoStruct::Type newSceneInfo;
+        newSceneInfo.fabricIndex = fabric;
+
+        CHIP_ERROR err = sceneTable->GetFabricSceneCount(fabric, newSceneInfo.sceneCount);
+        if (err == CHIP_NO_ERROR)
+        {
+            err = sceneTable->GetRemainingCapacity(fabric, newSceneInfo.remainingCapacity);
+        }
+        if (err == CHIP_NO_ERROR)
+        {
+            err = ScenesServer::Instance().SetSceneInfoStruct(endpoint, fabric, newSceneInfo);
+        }
+        if (err != CHIP_NO_ERROR)
+        {
+            ChipLogDetail(Zcl, "ERR: loading FabricSceneInfo on Endpoint %hu for fabric %u: %" CHIP_ERROR_FORMAT, endpoint,
+                          fabric, err.Format());
+            continue;
+        }
+        loaded = true;
+    }
+
+    if (loaded)
+    {
+        MatterReportingAttributeChangeCallback(endpoint, Id, Attributes::FabricSceneInfo::Id);
+    }
+}
+
 } // namespace
 
 /// @brief Gets the SceneInfoStruct array associated to an endpoint
@@ -1180,11 +1229,12 @@ void emberAfScenesManagementClusterServerInitCallback(EndpointId endpoint)
         ChipLogDetail(Zcl, "ERR: setting LastConfiguredBy on Endpoint %hu Status: %x", endpoint, to_underlying(status));
     }
 
-    // Initialize the FabricSceneInfo by getting the number of scenes and the remaining capacity for storing fabric scene data
-    for (auto & info : chip::Server::GetInstance().GetFabricTable())
+    // Initialize the FabricSceneInfo by getting the number of scenes and the remaining capacity for storing fabric scene data,
+    // once the server is up rather than while it starts.
+    CHIP_ERROR err = DeviceLayer::PlatformMgr().ScheduleWork(LoadFabricSceneInfo, static_cast<intptr_t>(endpoint));
+    if (err != CHIP_NO_ERROR)
     {
-        auto fabric = info.GetFabricIndex();
-        UpdateFabricSceneInfo(endpoint, fabric, Optional<GroupId>(), Optional<SceneId>(), Optional<bool>());
+        ChipLogDetail(Zcl, "ERR: scheduling FabricSceneInfo load on Endpoint %hu: %" CHIP_ERROR_FORMAT, endpoint, err.Format());
     }
 }
 
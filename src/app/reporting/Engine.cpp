@@ -18,6 +18,7 @@
 
 #include <access/AccessRestrictionProvider.h>
 #include <access/Privilege.h>
+#include <algorithm>
 #include <app/AppConfig.h>
 #include <app/AttributePathExpandIterator.h>
 #include <app/ConcreteEventPath.h>
@@ -37,6 +38,7 @@
 #include <lib/support/CodeUtils.h>
 #include <optional>
 #include <protocols/interaction_model/StatusCode.h>
+#include <tracing/metric_event.h>
 
 #if CHIP_CONFIG_ENABLE_ICD_SERVER
 #include <app/icd/server/ICDNotifier.h> // nogncheck
@@ -226,7 +228,7 @@ bool IsClusterDataVersionEqualTo(DataModel::Provider * dataModel, const Concrete
 
 } // namespace
 
-Engine::Engine(InteractionModelEngine * apImEngine) : mpImEngine(apImEngine) {}
+Engine::Engine(InteractionModelEngine * apImEngine) : mMaxLargeReportSize(kMaxLargeSecureSduLengthBytes), mpImEngine(apImEngine) {}
 
 CHIP_ERROR Engine::Init(EventManagement * apEventManagement)
 {
@@ -248,6 +250,11 @@ void Engine::Shutdown()
     mGlobalDirtySet.ReleaseAll();
 }
 
+void Engine::SetMaxLargeReportSize(size_t aMaxSize)
+{
+    mMaxLargeReportSize = std::min(std::max(aMaxSize, kMaxSecureSduLengthBytes), kMaxLargeSecureSduLengthBytes);
+}
+
 bool Engine::IsClusterDataVersionMatch(const SingleLinkedListNode<DataVersionFilter> * aDataVersionFilterList,
                                        const ConcreteReadAttributePath & aPath)
 {
@@ -676,6 +683,7 @@ exit:
 CHIP_ERROR Engine::BuildAndSendSingleReportData(ReadHandler * apReadHandler)
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
+    MATTER_LOG_METRIC_SCOPE(Tracing::kMetricDeviceReportBuild, err);
     System::PacketBufferTLVWriter reportDataWriter;
     ReportDataMessage::Builder reportDataBuilder;
     System::PacketBufferHandle bufHandle = nullptr;
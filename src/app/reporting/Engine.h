@@ -82,6 +82,14 @@ public:
     void SetMaxAttributesPerChunk(uint32_t aMaxAttributesPerChunk) { mMaxAttributesPerChunk = aMaxAttributesPerChunk; }
 #endif
 
+    /**
+     * Sets the largest report sent over sessions that support large payloads, e.g. TCP sessions. Large wildcard reads and
+     * subscription primes take fewer round trips with larger reports, at the cost of a larger buffer for each report in
+     * flight. The size is clamped between the size of MRP reports and kMaxLargeSecureSduLengthBytes, the default.
+     */
+    void SetMaxLargeReportSize(size_t aMaxSize);
+    size_t GetMaxLargeReportSize() const { return mMaxLargeReportSize; }
+
     /**
      * Should be invoked when the device receives a Status report, or when the Report data request times out.
      * This allows the engine to do some clean-up.
@@ -283,6 +291,8 @@ private:
      */
     uint64_t mDirtyGeneration = 1;
 
+    size_t mMaxLargeReportSize;
+
 #if CONFIG_BUILD_FOR_HOST_UNIT_TEST
     uint32_t mReservedSize          = 0;
     uint32_t mMaxAttributesPerChunk = UINT32_MAX;
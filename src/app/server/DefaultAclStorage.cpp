@@ -81,7 +81,10 @@ public:
 
         if (changeType == ChangeType::kRemoved)
         {
-            // Shuffle down entries past index, then delete entry at last index.
+            // Shuffle down entries past index, then delete entry at last index. All of it
+            // is done in a single storage batch so that no entry is lost or duplicated if
+            // interrupted.
+            PersistentStorageBatch storageBatch(mPersistentStorage);
             while (true)
             {
                 uint16_t size = static_cast<uint16_t>(sizeof(buffer));
@@ -98,6 +101,7 @@ public:
             }
             SuccessOrExit(err = mPersistentStorage->SyncDeleteKeyValue(
                               DefaultStorageKeyAllocator::AccessControlAclEntry(fabric, index).KeyName()));
+            SuccessOrExit(err = storageBatch.Commit());
         }
         else
         {
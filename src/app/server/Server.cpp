@@ -56,6 +56,8 @@
 #include <sys/param.h>
 #include <system/SystemPacketBuffer.h>
 #include <system/TLVPacketBufferBackingStore.h>
+#include <tracing/macros.h>
+#include <tracing/metric_event.h>
 #include <transport/SessionManager.h>
 
 #if CHIP_DEVICE_CONFIG_ENABLE_WIFIPAF
@@ -104,10 +106,14 @@ static app::CircularEventBuffer sLoggingBuffer[CHIP_NUM_EVENT_LOGGING_BUFFERS];
 
 CHIP_ERROR Server::Init(const ServerInitParams & initParams)
 {
+    MATTER_TRACE_SCOPE("Init", "Server");
+    MATTER_LOG_METRIC_BEGIN(Tracing::kMetricServerInit);
     ChipLogProgress(AppServer, "Server initializing...");
     assertChipStackLockedByCurrentThread();
 
-    mInitTimestamp = System::SystemClock().GetMonotonicMicroseconds64();
+    mInitTimestamp  = System::SystemClock().GetMonotonicMicroseconds64();
+    mInitPhaseCount = 0;
+    StartInitPhase("storage");
 
     CASESessionManagerConfig caseSessionManagerConfig;
     DeviceLayer::DeviceInfoProvider * deviceInfoprovider = nullptr;
@@ -175,6 +181,7 @@ CHIP_ERROR Server::Init(const ServerInitParams & initParams)
     SuccessOrExit(err = mAttributePersister.Init(mDeviceStorage));
     SetSafeAttributePersistenceProvider(&mAttributePersister);
 
+    StartInitPhase("fabrics");
     {
         FabricTable::InitParams fabricTableInitParams;
         fabricTableInitParams.storage             = mDeviceStorage;
@@ -185,6 +192,7 @@ CHIP_ERROR Server::Init(const ServerInitParams & initParams)
         SuccessOrExit(err);
     }
 
+    StartInitPhase("access control");
     SuccessOrExit(err = mAccessControl.Init(initParams.accessDelegate, sDeviceTypeResolver));
     Access::SetAccessControl(mAccessControl);
 
@@ -216,6 +224,7 @@ CHIP_ERROR Server::Init(const ServerInitParams & initParams)
     }
 
     // Init transport before operations with secure session mgr.
+    StartInitPhase("transports");
     err = mTransports.Init(UdpListenParameters(DeviceLayer::UDPEndPointManager())
                                .SetAddressType(IPAddressType::kIPv6)
                                .SetListenPort(mOperationalServicePort)
@@ -250,6 +259,7 @@ CHIP_ERROR Server::Init(const ServerInitParams & initParams)
 #endif
     SuccessOrExit(err);
 
+    StartInitPhase("sessions");
     err = mSessions.Init(&DeviceLayer::SystemLayer(), &mTransports, &mMessageCounterManager, mDeviceStorage, &GetFabricTable(),
                          *mSessionKeystore);
     SuccessOrExit(err);
@@ -276,6 +286,7 @@ CHIP_ERROR Server::Init(const ServerInitParams & initParams)
 
 #if CHIP_CONFIG_ENABLE_SERVER_IM_EVENT
     // Initialize event logging subsystem
+    StartInitPhase("events");
     err = sGlobalEventIdCounter.Init(mDeviceStorage, DefaultStorageKeyAllocator::IMEventNumber(),
                                      CHIP_DEVICE_CONFIG_EVENT_ID_COUNTER_EPOCH);
     SuccessOrExit(err);
@@ -311,13 +322,22 @@ CHIP_ERROR Server::Init(const ServerInitParams & initParams)
     //
     // This remains the single point of entry to ensure that all cluster-level
     // initialization is performed in the correct order.
-    app::InteractionModelEngine::GetInstance()->SetDataModelProvider(initParams.dataModelProvider);
+    StartInitPhase("data model");
+    {
+        // Cluster initialization stores many independent attribute values:
+        // commit them together.
+        PersistentStorageBatch storageBatch(mDeviceStorage);
+        app::InteractionModelEngine::GetInstance()->SetDataModelProvider(initParams.dataModelProvider);
+        SuccessOrExit(err = storageBatch.Commit());
+    }
 
 #if defined(CHIP_APP_USE_ECHO)
     err = InitEchoHandler(&mExchangeMgr);
     SuccessOrExit(err);
 #endif
 
+    StartInitPhase("dnssd");
+
     //
     // We need to advertise the port that we're listening to for unsolicited messages over UDP. However, we have both a IPv4
     // and IPv6 endpoint to pick from. Given that the listen port passed in may be set to 0 (which then has the kernel select
@@ -364,6 +384,7 @@ CHIP_ERROR Server::Init(const ServerInitParams & initParams)
     app::DnssdServer::Instance().StartServer();
 #endif
 
+    StartInitPhase("case");
     caseSessionManagerConfig = {
         .sessionInitParams =  {
             .sessionManager    = &mSessions,
@@ -387,6 +408,7 @@ CHIP_ERROR Server::Init(const ServerInitParams & initParams)
                                                     &mCertificateValidityPolicy, mGroupsProvider);
     SuccessOrExit(err);
 
+    StartInitPhase("interaction model");
     err = app::InteractionModelEngine::GetInstance()->Init(&mExchangeMgr, &GetFabricTable(), mReportScheduler, &mCASESessionManager,
                                                            mSubscriptionResumptionStorage);
     SuccessOrExit(err);
@@ -397,6 +419,7 @@ CHIP_ERROR Server::Init(const ServerInitParams & initParams)
 
     // ICD Init needs to be after data model init and InteractionModel Init
 #if CHIP_CONFIG_ENABLE_ICD_SERVER
+    StartInitPhase("icd");
 
     // Register the ICDStateObservers.
     // Call register before init so that observers are notified of any state change during the init.
@@ -429,9 +452,12 @@ CHIP_ERROR Server::Init(const ServerInitParams & initParams)
     // Thread LWIP devices using dedicated Inet endpoint implementations are excluded because they call this function from:
     // src/platform/OpenThread/GenericThreadStackManagerImpl_OpenThread_LwIP.cpp
 #if !CHIP_SYSTEM_CONFIG_USE_OPEN_THREAD_ENDPOINT
+    StartInitPhase("groups");
     RejoinExistingMulticastGroups();
 #endif // !CHIP_SYSTEM_CONFIG_USE_OPEN_THREAD_ENDPOINT
 
+    StartInitPhase("platform");
+
     // Handle deferred clean-up of a previously armed fail-safe that occurred during FabricTable commit.
     // This is done at the very end since at the earlier time above when FabricTable::Init() is called,
     // the delegates could not have been registered, and the other systems were not initialized. By now,
@@ -491,18 +517,50 @@ CHIP_ERROR Server::Init(const ServerInitParams & initParams)
     CheckServerReadyEvent();
 
 exit:
+    EndInitPhase();
+    MATTER_LOG_METRIC_END(Tracing::kMetricServerInit, err);
     if (err != CHIP_NO_ERROR)
     {
         ChipLogError(AppServer, "ERROR setting up transport: %" CHIP_ERROR_FORMAT, err.Format());
     }
     else
     {
+        LogInitPhases();
         // NOTE: this log is scraped by the test harness.
         ChipLogProgress(AppServer, "Server Listening...");
     }
     return err;
 }
 
+void Server::StartInitPhase(const char * name)
+{
+    EndInitPhase();
+    mCurrentInitPhase = name;
+    mInitPhaseStart   = System::SystemClock().GetMonotonicMicroseconds64();
+}
+
+void Server::EndInitPhase()
+{
+    VerifyOrReturn(mCurrentInitPhase != nullptr);
+
+    if (mInitPhaseCount < kMaxInitPhases)
+    {
+        mInitPhases[mInitPhaseCount++] = { mCurrentInitPhase,
+                                           System::SystemClock().GetMonotonicMicroseconds64() - mInitPhaseStart };
+    }
+    mCurrentInitPhase = nullptr;
+}
+
+void Server::LogInitPhases() const
+{
+    for (const InitPhase & phase : GetInitPhases())
+    {
+        ChipLogDetail(AppServer, "Init %s: %" PRIu32 " us", phase.name, static_cast<uint32_t>(phase.duration.count()));
+    }
+    ChipLogProgress(AppServer, "Server initialized in %" PRIu32 " ms",
+                    static_cast<uint32_t>(std::chrono::duration_cast<System::Clock::Milliseconds32>(TimeSinceInit()).count()));
+}
+
 void Server::OnPlatformEvent(const DeviceLayer::ChipDeviceEvent & event)
 {
     switch (event.Type)
@@ -811,6 +869,13 @@ KvsPersistentStorageDelegate CommonCaseDeviceServerInitParams::sKvsPersistenStor
 PersistentStorageOperationalKeystore CommonCaseDeviceServerInitParams::sPersistentStorageOperationalKeystore;
 Credentials::PersistentStorageOpCertStore CommonCaseDeviceServerInitParams::sPersistentStorageOpCertStore;
 Credentials::GroupDataProviderImpl CommonCaseDeviceServerInitParams::sGroupDataProvider;
+#if CHIP_CONFIG_GROUP_DATA_CACHE_SIZE > 0
+Credentials::GroupDataStorageCache<CHIP_CONFIG_GROUP_DATA_CACHE_SIZE> CommonCaseDeviceServerInitParams::sGroupDataStorageCache;
+#endif
+#if CHIP_CONFIG_GROUP_MEMBERSHIP_INDEX
+Credentials::GroupMembershipIndex<CHIP_CONFIG_MAX_FABRICS, CHIP_CONFIG_MAX_FABRICS * CHIP_CONFIG_MAX_GROUPS_PER_FABRIC>
+    CommonCaseDeviceServerInitParams::sGroupMembershipIndex;
+#endif
 app::DefaultTimerDelegate CommonCaseDeviceServerInitParams::sTimerDelegate;
 app::reporting::ReportSchedulerImpl
     CommonCaseDeviceServerInitParams::sReportScheduler(&CommonCaseDeviceServerInitParams::sTimerDelegate);
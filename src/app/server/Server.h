@@ -45,6 +45,7 @@
 #include <inet/InetConfig.h>
 #include <lib/core/CHIPConfig.h>
 #include <lib/support/SafeInt.h>
+#include <lib/support/Span.h>
 #include <messaging/ExchangeMgr.h>
 #include <platform/DeviceInstanceInfoProvider.h>
 #include <platform/KeyValueStoreManager.h>
@@ -281,7 +282,14 @@ struct CommonCaseDeviceServerInitParams : public ServerInitParams
         this->sessionKeystore = &sSessionKeystore;
 
         // Group Data provider injection
+#if CHIP_CONFIG_GROUP_DATA_CACHE_SIZE > 0
+        sGroupDataProvider.SetStorageDelegate(this->persistentStorageDelegate, &sGroupDataStorageCache);
+#else
         sGroupDataProvider.SetStorageDelegate(this->persistentStorageDelegate);
+#endif
+#if CHIP_CONFIG_GROUP_MEMBERSHIP_INDEX
+        sGroupDataProvider.SetMembershipIndex(&sGroupMembershipIndex);
+#endif
         sGroupDataProvider.SetSessionKeystore(this->sessionKeystore);
         ReturnErrorOnFailure(sGroupDataProvider.Init());
         this->groupDataProvider = &sGroupDataProvider;
@@ -322,6 +330,13 @@ private:
     static PersistentStorageOperationalKeystore sPersistentStorageOperationalKeystore;
     static Credentials::PersistentStorageOpCertStore sPersistentStorageOpCertStore;
     static Credentials::GroupDataProviderImpl sGroupDataProvider;
+#if CHIP_CONFIG_GROUP_DATA_CACHE_SIZE > 0
+    static Credentials::GroupDataStorageCache<CHIP_CONFIG_GROUP_DATA_CACHE_SIZE> sGroupDataStorageCache;
+#endif
+#if CHIP_CONFIG_GROUP_MEMBERSHIP_INDEX
+    static Credentials::GroupMembershipIndex<CHIP_CONFIG_MAX_FABRICS, CHIP_CONFIG_MAX_FABRICS * CHIP_CONFIG_MAX_GROUPS_PER_FABRIC>
+        sGroupMembershipIndex;
+#endif
     static chip::app::DefaultTimerDelegate sTimerDelegate;
     static app::reporting::ReportSchedulerImpl sReportScheduler;
 
@@ -447,6 +462,20 @@ public:
         return System::SystemClock().GetMonotonicMicroseconds64() - mInitTimestamp;
     }
 
+    /**
+     * Time spent in a phase of the last Init() call, to profile startup.
+     */
+    struct InitPhase
+    {
+        const char * name;
+        System::Clock::Microseconds64 duration;
+    };
+
+    /**
+     * Phases of the last Init() call, in the order they ran.
+     */
+    Span<const InitPhase> GetInitPhases() const { return Span<const InitPhase>(mInitPhases, mInitPhaseCount); }
+
     static Server & GetInstance() { return sServer; }
 
 private:
@@ -460,6 +489,11 @@ private:
 
     static void OnPlatformEventWrapper(const DeviceLayer::ChipDeviceEvent * event, intptr_t);
 
+    // Ends the current Init() phase, if any, and starts timing the next one.
+    void StartInitPhase(const char * name);
+    void EndInitPhase();
+    void LogInitPhases() const;
+
 #if CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
     /**
      * @brief Called at Server::Init time to resume persisted subscriptions if the feature flag is enabled
@@ -704,6 +738,13 @@ private:
     Inet::InterfaceId mInterfaceId;
 
     System::Clock::Microseconds64 mInitTimestamp;
+
+    static constexpr size_t kMaxInitPhases = 16;
+    InitPhase mInitPhases[kMaxInitPhases];
+    size_t mInitPhaseCount         = 0;
+    const char * mCurrentInitPhase = nullptr;
+    System::Clock::Microseconds64 mInitPhaseStart;
+
 #if CHIP_CONFIG_ENABLE_ICD_SERVER
     app::ICDManager mICDManager;
 #endif // CHIP_CONFIG_ENABLE_ICD_SERVER
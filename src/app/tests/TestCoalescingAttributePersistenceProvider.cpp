@@ -0,0 +1,265 @@
+/*
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app-common/zap-generated/attribute-type.h>
+#include <app/util/attribute-metadata.h>
+#include <app/util/persistence/CoalescingAttributePersistenceProvider.h>
+#include <lib/core/StringBuilderAdapters.h>
+#include <lib/support/CHIPMem.h>
+#include <platform/CHIPDeviceLayer.h>
+#include <system/SystemClock.h>
+
+#include <pw_unit_test/framework.h>
+
+#include <map>
+#include <tuple>
+#include <vector>
+
+using namespace chip;
+using namespace chip::app;
+using namespace chip::System::Clock::Literals;
+
+namespace {
+
+const ConcreteAttributePath kPathA(1, 0x0008, 0x0000);
+const ConcreteAttributePath kPathB(1, 0x0300, 0x0007);
+const ConcreteAttributePath kPathC(2, 0x0006, 0x0000);
+
+const EmberAfAttributeMetadata kUint8Metadata = {
+    .defaultValue  = EmberAfDefaultOrMinMaxAttributeValue(static_cast<uint32_t>(0)),
+    .attributeId   = 0,
+    .size          = 1,
+    .attributeType = ZCL_INT8U_ATTRIBUTE_TYPE,
+    .mask          = ATTRIBUTE_MASK_WRITABLE,
+};
+
+const EmberAfAttributeMetadata kUint16Metadata = {
+    .defaultValue  = EmberAfDefaultOrMinMaxAttributeValue(static_cast<uint32_t>(0)),
+    .attributeId   = 0,
+    .size          = 2,
+    .attributeType = ZCL_INT16U_ATTRIBUTE_TYPE,
+    .mask          = ATTRIBUTE_MASK_WRITABLE,
+};
+
+class TestPersister : public AttributePersistenceProvider
+{
+public:
+    CHIP_ERROR WriteValue(const ConcreteAttributePath & aPath, const ByteSpan & aValue) override
+    {
+        mWrites++;
+        mValues[Key(aPath)].assign(aValue.begin(), aValue.end());
+        return CHIP_NO_ERROR;
+    }
+
+    CHIP_ERROR ReadValue(const ConcreteAttributePath & aPath, const EmberAfAttributeMetadata * aMetadata,
+                         MutableByteSpan & aValue) override
+    {
+        auto it = mValues.find(Key(aPath));
+        VerifyOrReturnError(it != mValues.end(), CHIP_ERROR_NOT_FOUND);
+        return CopySpanToMutableSpan(ByteSpan(it->second.data(), it->second.size()), aValue);
+    }
+
+    bool Has(const ConcreteAttributePath & aPath, uint8_t value)
+    {
+        auto it = mValues.find(Key(aPath));
+        return it != mValues.end() && it->second.size() == 1 && it->second[0] == value;
+    }
+
+    unsigned mWrites = 0;
+
+private:
+    using PathKey = std::tuple<EndpointId, ClusterId, AttributeId>;
+    static PathKey Key(const ConcreteAttributePath & path)
+    {
+        return PathKey(path.mEndpointId, path.mClusterId, path.mAttributeId);
+    }
+
+    std::map<PathKey, std::vector<uint8_t>> mValues;
+};
+
+class TestCoalescingAttributePersistenceProvider : public ::testing::Test
+{
+public:
+    static void SetUpTestSuite()
+    {
+        ASSERT_EQ(chip::Platform::MemoryInit(), CHIP_NO_ERROR);
+        ASSERT_EQ(DeviceLayer::SystemLayer().Init(), CHIP_NO_ERROR);
+    }
+    static void TearDownTestSuite()
+    {
+        DeviceLayer::SystemLayer().Shutdown();
+        chip::Platform::MemoryShutdown();
+    }
+
+    void SetUp() override
+    {
+        mRealClock = &System::SystemClock();
+        System::Clock::Internal::SetSystemClockForTesting(&mMockClock);
+    }
+    void TearDown() override { System::Clock::Internal::SetSystemClockForTesting(mRealClock); }
+
+    CHIP_ERROR Write(AttributePersistenceProvider & provider, const ConcreteAttributePath & path, uint8_t value)
+    {
+        return provider.WriteValue(path, ByteSpan(&value, 1));
+    }
+
+    System::Clock::Internal::MockClock mMockClock;
+    System::Clock::ClockBase * mRealClock = nullptr;
+};
+
+CoalescingAttributePersistenceProvider::Config TestConfig()
+{
+    CoalescingAttributePersistenceProvider::Config config;
+    config.writeDelay    = 100_ms32;
+    config.maxWriteDelay = 1000_ms32;
+    config.maxDirtyBytes = 16;
+    return config;
+}
+
+TEST_F(TestCoalescingAttributePersistenceProvider, CoalescesUntilQuiet)
+{
+    TestPersister persister;
+    CoalescedAttribute slots[4];
+    CoalescingAttributePersistenceProvider provider(persister, Span<CoalescedAttribute>(slots), TestConfig());
+
+    for (uint8_t i = 1; i <= 5; i++)
+    {
+        EXPECT_EQ(Write(provider, kPathA, i), CHIP_NO_ERROR);
+        mMockClock.AdvanceMonotonic(10_ms64);
+    }
+    EXPECT_EQ(persister.mWrites, 0u);
+    EXPECT_EQ(provider.GetDirtyCount(), 1u);
+
+    // Reads observe the pending value
+    uint8_t buf[4];
+    MutableByteSpan readBack(buf);
+    EXPECT_EQ(provider.ReadValue(kPathA, &kUint8Metadata, readBack), CHIP_NO_ERROR);
+    ASSERT_EQ(readBack.size(), 1u);
+    EXPECT_EQ(buf[0], 5);
+
+    // Once the attribute has been quiet long enough, the next write flushes it.
+    mMockClock.AdvanceMonotonic(200_ms64);
+    EXPECT_EQ(Write(provider, kPathB, 1), CHIP_NO_ERROR);
+    EXPECT_EQ(persister.mWrites, 1u);
+    EXPECT_TRUE(persister.Has(kPathA, 5));
+
+    EXPECT_EQ(provider.GetMetrics().writesRequested, 6u);
+    EXPECT_EQ(provider.GetMetrics().writesCoalesced, 4u);
+    EXPECT_EQ(provider.GetMetrics().WritesAvoided(), 4u);
+}
+
+TEST_F(TestCoalescingAttributePersistenceProvider, MaxWriteDelayBoundsStaleness)
+{
+    TestPersister persister;
+    CoalescedAttribute slots[4];
+    CoalescingAttributePersistenceProvider provider(persister, Span<CoalescedAttribute>(slots), TestConfig());
+
+    // Keep changing faster than writeDelay: the value is still written after maxWriteDelay.
+    for (uint8_t i = 0; i < 30; i++)
+    {
+        EXPECT_EQ(Write(provider, kPathA, i), CHIP_NO_ERROR);
+        mMockClock.AdvanceMonotonic(50_ms64);
+    }
+    EXPECT_EQ(persister.mWrites, 1u);
+}
+
+TEST_F(TestCoalescingAttributePersistenceProvider, UnchangedValuesAreNotWritten)
+{
+    TestPersister persister;
+    CoalescedAttribute slots[4];
+    CoalescingAttributePersistenceProvider provider(persister, Span<CoalescedAttribute>(slots), TestConfig());
+
+    EXPECT_EQ(persister.WriteValue(kPathA, ByteSpan((const uint8_t *) "\x07", 1)), CHIP_NO_ERROR);
+    persister.mWrites = 0;
+
+    // Loading the stored value makes writing it back free.
+    uint8_t buf[4];
+    MutableByteSpan readBack(buf);
+    EXPECT_EQ(provider.ReadValue(kPathA, &kUint8Metadata, readBack), CHIP_NO_ERROR);
+    EXPECT_EQ(Write(provider, kPathA, 7), CHIP_NO_ERROR);
+    EXPECT_EQ(provider.Flush(), CHIP_NO_ERROR);
+    EXPECT_EQ(persister.mWrites, 0u);
+    EXPECT_EQ(provider.GetMetrics().writesUnchanged, 1u);
+
+    // Same once a written value has been flushed.
+    EXPECT_EQ(Write(provider, kPathA, 8), CHIP_NO_ERROR);
+    EXPECT_EQ(provider.Flush(), CHIP_NO_ERROR);
+    EXPECT_EQ(Write(provider, kPathA, 8), CHIP_NO_ERROR);
+    EXPECT_EQ(provider.Flush(), CHIP_NO_ERROR);
+    EXPECT_EQ(persister.mWrites, 1u);
+    EXPECT_EQ(provider.GetMetrics().writesUnchanged, 2u);
+}
+
+TEST_F(TestCoalescingAttributePersistenceProvider, FlushWritesEverything)
+{
+    TestPersister persister;
+    CoalescedAttribute slots[4];
+    CoalescingAttributePersistenceProvider provider(persister, Span<CoalescedAttribute>(slots), TestConfig());
+
+    EXPECT_EQ(Write(provider, kPathA, 1), CHIP_NO_ERROR);
+    EXPECT_EQ(Write(provider, kPathB, 2), CHIP_NO_ERROR);
+    EXPECT_EQ(provider.GetDirtyBytes(), 2u);
+
+    EXPECT_EQ(provider.Flush(), CHIP_NO_ERROR);
+    EXPECT_EQ(persister.mWrites, 2u);
+    EXPECT_TRUE(persister.Has(kPathA, 1));
+    EXPECT_TRUE(persister.Has(kPathB, 2));
+    EXPECT_EQ(provider.GetDirtyCount(), 0u);
+    EXPECT_EQ(provider.GetDirtyBytes(), 0u);
+}
+
+TEST_F(TestCoalescingAttributePersistenceProvider, SizeAndSlotPressure)
+{
+    TestPersister persister;
+    CoalescedAttribute slots[2];
+    CoalescingAttributePersistenceProvider::Config config = TestConfig();
+    config.maxDirtyBytes                                  = 4;
+    CoalescingAttributePersistenceProvider provider(persister, Span<CoalescedAttribute>(slots), config);
+
+    // Running out of slots writes the pending values to make room.
+    EXPECT_EQ(Write(provider, kPathA, 1), CHIP_NO_ERROR);
+    EXPECT_EQ(Write(provider, kPathB, 2), CHIP_NO_ERROR);
+    EXPECT_EQ(persister.mWrites, 0u);
+    EXPECT_EQ(Write(provider, kPathC, 3), CHIP_NO_ERROR);
+    EXPECT_EQ(persister.mWrites, 2u);
+    EXPECT_EQ(provider.GetDirtyCount(), 1u);
+
+    // Exceeding maxDirtyBytes writes everything.
+    uint8_t big[4] = { 1, 2, 3, 4 };
+    EXPECT_EQ(provider.WriteValue(kPathA, ByteSpan(big)), CHIP_NO_ERROR);
+    EXPECT_EQ(persister.mWrites, 4u);
+    EXPECT_EQ(provider.GetDirtyCount(), 0u);
+    EXPECT_EQ(provider.GetMetrics().sizeFlushes, 2u);
+}
+
+TEST_F(TestCoalescingAttributePersistenceProvider, CachedValuesAreValidated)
+{
+    TestPersister persister;
+    CoalescedAttribute slots[4];
+    CoalescingAttributePersistenceProvider provider(persister, Span<CoalescedAttribute>(slots), TestConfig());
+
+    // A pending value that does not match the attribute size is rejected, like a stored one.
+    EXPECT_EQ(Write(provider, kPathA, 1), CHIP_NO_ERROR);
+    uint8_t buf[4];
+    MutableByteSpan readBack(buf);
+    EXPECT_EQ(provider.ReadValue(kPathA, &kUint16Metadata, readBack), CHIP_ERROR_INVALID_ARGUMENT);
+
+    readBack = MutableByteSpan(buf);
+    EXPECT_EQ(provider.ReadValue(kPathA, &kUint8Metadata, readBack), CHIP_NO_ERROR);
+    EXPECT_EQ(readBack.size(), 1u);
+}
+
+} // namespace
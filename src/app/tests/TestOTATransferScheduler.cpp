@@ -0,0 +1,203 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/clusters/ota-provider/OTATransferScheduler.h>
+
+#include <lib/core/StringBuilderAdapters.h>
+#include <pw_unit_test/framework.h>
+
+using namespace chip;
+using namespace chip::ota;
+using namespace chip::System::Clock::Literals;
+
+using chip::System::Clock::Seconds32;
+using chip::System::Clock::Timestamp;
+
+namespace {
+
+constexpr uint64_t kImageSize    = 1024 * 1024;
+constexpr uint32_t kTransferRate = 1024; // bytes per second, so that a transfer of the image takes 1024 s
+
+ScopedNodeId MakeRequestor(NodeId nodeId)
+{
+    return ScopedNodeId(nodeId, FabricIndex(1));
+}
+
+TEST(TestOTATransferScheduler, TestInit)
+{
+    OTATransferScheduler scheduler;
+    EXPECT_EQ(scheduler.Init(0), CHIP_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(scheduler.Init(OTATransferScheduler::kMaxConcurrentTransfers + 1), CHIP_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(scheduler.Init(OTATransferScheduler::kMaxConcurrentTransfers), CHIP_NO_ERROR);
+}
+
+TEST(TestOTATransferScheduler, TestConcurrentTransfers)
+{
+    OTATransferScheduler scheduler;
+    ASSERT_EQ(scheduler.Init(2), CHIP_NO_ERROR);
+    scheduler.SetExpectedTransferRate(kTransferRate);
+
+    uint8_t slot = OTATransferScheduler::kNoSlot;
+    Seconds32 delay;
+
+    EXPECT_EQ(scheduler.RequestTransfer(MakeRequestor(1), kImageSize, Timestamp(0), slot, delay), CHIP_NO_ERROR);
+    EXPECT_EQ(slot, 0);
+    EXPECT_EQ(scheduler.RequestTransfer(MakeRequestor(2), kImageSize, Timestamp(0), slot, delay), CHIP_NO_ERROR);
+    EXPECT_EQ(slot, 1);
+    EXPECT_EQ(scheduler.GetSlot(MakeRequestor(1)), 0);
+    EXPECT_EQ(scheduler.GetSlot(MakeRequestor(2)), 1);
+    EXPECT_EQ(scheduler.GetSlot(MakeRequestor(3)), OTATransferScheduler::kNoSlot);
+
+    // A Requestor that queries again keeps its slot.
+    EXPECT_EQ(scheduler.RequestTransfer(MakeRequestor(1), kImageSize, Timestamp(0), slot, delay), CHIP_NO_ERROR);
+    EXPECT_EQ(slot, 0);
+
+    EXPECT_EQ(scheduler.RequestTransfer(MakeRequestor(3), kImageSize, Timestamp(0), slot, delay), CHIP_ERROR_BUSY);
+    EXPECT_EQ(slot, OTATransferScheduler::kNoSlot);
+
+    OTATransferScheduler::Metrics metrics = scheduler.GetMetrics(Timestamp(0));
+    EXPECT_EQ(metrics.activeTransfers, 2);
+    EXPECT_EQ(metrics.queueDepth, 1);
+
+    // A failed transfer frees its slot.
+    scheduler.OnTransferEnded(MakeRequestor(2), false, Timestamp(0));
+    EXPECT_EQ(scheduler.GetSlot(MakeRequestor(2)), OTATransferScheduler::kNoSlot);
+
+    metrics = scheduler.GetMetrics(Timestamp(0));
+    EXPECT_EQ(metrics.activeTransfers, 1);
+    EXPECT_EQ(metrics.failedTransfers, 1u);
+    EXPECT_EQ(metrics.completedTransfers, 0u);
+}
+
+TEST(TestOTATransferScheduler, TestDelayedActionTime)
+{
+    OTATransferScheduler scheduler;
+    ASSERT_EQ(scheduler.Init(2), CHIP_NO_ERROR);
+    scheduler.SetExpectedTransferRate(kTransferRate);
+
+    uint8_t slot = OTATransferScheduler::kNoSlot;
+    Seconds32 delay;
+
+    EXPECT_EQ(scheduler.RequestTransfer(MakeRequestor(1), kImageSize, Timestamp(0), slot, delay), CHIP_NO_ERROR);
+    EXPECT_EQ(scheduler.RequestTransfer(MakeRequestor(2), kImageSize, Timestamp(0), slot, delay), CHIP_NO_ERROR);
+
+    // Half of the first image is sent: its slot frees up in 512 s, the other one in 1024 s.
+    scheduler.OnBlockSent(MakeRequestor(1), kImageSize / 2, Timestamp(0));
+
+    EXPECT_EQ(scheduler.RequestTransfer(MakeRequestor(3), kImageSize, Timestamp(0), slot, delay), CHIP_ERROR_BUSY);
+    EXPECT_EQ(delay, Seconds32(512));
+    EXPECT_EQ(scheduler.RequestTransfer(MakeRequestor(4), kImageSize, Timestamp(0), slot, delay), CHIP_ERROR_BUSY);
+    EXPECT_EQ(delay, Seconds32(1024));
+
+    // The next Requestors wait for a whole transfer more.
+    EXPECT_EQ(scheduler.RequestTransfer(MakeRequestor(5), kImageSize, Timestamp(0), slot, delay), CHIP_ERROR_BUSY);
+    EXPECT_EQ(delay, Seconds32(512 + 1024));
+    EXPECT_EQ(scheduler.RequestTransfer(MakeRequestor(6), kImageSize, Timestamp(0), slot, delay), CHIP_ERROR_BUSY);
+    EXPECT_EQ(delay, Seconds32(1024 + 1024));
+    EXPECT_EQ(scheduler.GetMetrics(Timestamp(0)).queueDepth, 4);
+
+    // Requestors are never told to come back sooner than they would anyway.
+    scheduler.OnBlockSent(MakeRequestor(1), kImageSize / 2, Timestamp(0));
+    EXPECT_EQ(scheduler.RequestTransfer(MakeRequestor(3), kImageSize, Timestamp(0), slot, delay), CHIP_ERROR_BUSY);
+    EXPECT_EQ(delay, OTATransferScheduler::kMinDelayedActionTime);
+}
+
+TEST(TestOTATransferScheduler, TestQueueOrder)
+{
+    OTATransferScheduler scheduler;
+    ASSERT_EQ(scheduler.Init(1), CHIP_NO_ERROR);
+    scheduler.SetExpectedTransferRate(kTransferRate);
+
+    uint8_t slot = OTATransferScheduler::kNoSlot;
+    Seconds32 delay3;
+    Seconds32 delay4;
+    Seconds32 delay;
+
+    EXPECT_EQ(scheduler.RequestTransfer(MakeRequestor(1), kImageSize, Timestamp(0), slot, delay), CHIP_NO_ERROR);
+    EXPECT_EQ(scheduler.RequestTransfer(MakeRequestor(3), kImageSize, Timestamp(0), slot, delay3), CHIP_ERROR_BUSY);
+    EXPECT_EQ(scheduler.RequestTransfer(MakeRequestor(4), kImageSize, Timestamp(0), slot, delay4), CHIP_ERROR_BUSY);
+    EXPECT_LT(delay3, delay4);
+
+    // The slot that frees up is kept for the first Requestor in line once it is due, even if the second one queries first.
+    scheduler.OnTransferEnded(MakeRequestor(1), false, Timestamp(delay3));
+    EXPECT_EQ(scheduler.RequestTransfer(MakeRequestor(4), kImageSize, Timestamp(delay3), slot, delay), CHIP_ERROR_BUSY);
+    EXPECT_EQ(scheduler.RequestTransfer(MakeRequestor(3), kImageSize, Timestamp(delay3), slot, delay), CHIP_NO_ERROR);
+    EXPECT_EQ(scheduler.GetMetrics(Timestamp(delay3)).queueDepth, 1);
+
+    // A Requestor that does not come back in time loses its place.
+    scheduler.OnTransferEnded(MakeRequestor(3), false, Timestamp(delay3));
+    const Timestamp late = Timestamp(delay3) + Timestamp(delay4) + OTATransferScheduler::kRetryGracePeriod + 1_s;
+    EXPECT_EQ(scheduler.GetMetrics(late).queueDepth, 0);
+    EXPECT_EQ(scheduler.RequestTransfer(MakeRequestor(5), kImageSize, late, slot, delay), CHIP_NO_ERROR);
+}
+
+TEST(TestOTATransferScheduler, TestUnstartedTransfer)
+{
+    OTATransferScheduler scheduler;
+    ASSERT_EQ(scheduler.Init(1), CHIP_NO_ERROR);
+
+    uint8_t slot = OTATransferScheduler::kNoSlot;
+    Seconds32 delay;
+
+    EXPECT_EQ(scheduler.RequestTransfer(MakeRequestor(1), kImageSize, Timestamp(0), slot, delay), CHIP_NO_ERROR);
+    EXPECT_EQ(scheduler.RequestTransfer(MakeRequestor(2), kImageSize, Timestamp(0), slot, delay), CHIP_ERROR_BUSY);
+
+    // The slot of a Requestor that never starts its transfer is given to the next one.
+    const Timestamp later = Timestamp(OTATransferScheduler::kTransferStartTimeout + 1_s);
+    EXPECT_EQ(scheduler.RequestTransfer(MakeRequestor(2), kImageSize, later, slot, delay), CHIP_NO_ERROR);
+    EXPECT_EQ(slot, 0);
+    EXPECT_EQ(scheduler.GetSlot(MakeRequestor(1)), OTATransferScheduler::kNoSlot);
+    EXPECT_EQ(scheduler.GetMetrics(later).failedTransfers, 1u);
+}
+
+TEST(TestOTATransferScheduler, TestThroughput)
+{
+    OTATransferScheduler scheduler;
+    ASSERT_EQ(scheduler.Init(2), CHIP_NO_ERROR);
+    EXPECT_EQ(scheduler.GetMetrics(Timestamp(0)).transferRate, OTATransferScheduler::kDefaultTransferRate);
+
+    uint8_t slot = OTATransferScheduler::kNoSlot;
+    Seconds32 delay;
+
+    EXPECT_EQ(scheduler.RequestTransfer(MakeRequestor(1), 20000, Timestamp(0), slot, delay), CHIP_NO_ERROR);
+    EXPECT_EQ(scheduler.RequestTransfer(MakeRequestor(2), 20000, Timestamp(0), slot, delay), CHIP_NO_ERROR);
+
+    // Both transfers send 1000 bytes per second for 20 s.
+    for (uint32_t second = 1; second <= 20; second++)
+    {
+        const Timestamp now = Timestamp(Seconds32(second));
+        scheduler.OnBlockSent(MakeRequestor(1), 1000, now);
+        scheduler.OnBlockSent(MakeRequestor(2), 1000, now);
+    }
+    scheduler.OnTransferEnded(MakeRequestor(1), true, Timestamp(20_s));
+
+    OTATransferScheduler::Metrics metrics = scheduler.GetMetrics(Timestamp(20_s));
+    EXPECT_EQ(metrics.throughput, 2000u);
+    EXPECT_EQ(metrics.transferRate, 1000u);
+    EXPECT_EQ(metrics.completedTransfers, 1u);
+    EXPECT_EQ(metrics.totalBytesSent, 40000u);
+    EXPECT_EQ(metrics.activeTransfers, 1);
+
+    // Completed transfers update the estimated per-transfer throughput: the second one took 40 s.
+    scheduler.OnTransferEnded(MakeRequestor(2), true, Timestamp(40_s));
+    EXPECT_EQ(scheduler.GetMetrics(Timestamp(40_s)).transferRate, (3 * 1000u + 500u) / 4);
+
+    // Once no Block is sent anymore, the throughput is averaged since the last Block: 2000 bytes in 40 s.
+    EXPECT_EQ(scheduler.GetMetrics(Timestamp(60_s)).throughput, 50u);
+}
+
+} // namespace
@@ -0,0 +1,305 @@
+/*
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app-common/zap-generated/attribute-type.h>
+#include <app/util/attribute-metadata.h>
+#include <app/util/persistence/PackedAttributePersistenceProvider.h>
+#include <lib/core/StringBuilderAdapters.h>
+#include <lib/support/DefaultStorageKeyAllocator.h>
+#include <lib/support/TestPersistentStorageDelegate.h>
+
+#include <pw_unit_test/framework.h>
+
+#include <string.h>
+
+using namespace chip;
+using namespace chip::app;
+
+namespace {
+
+constexpr EndpointId kEndpoint = 1;
+constexpr ClusterId kCluster   = 0x0008;
+
+const EmberAfAttributeMetadata kUint16Metadata = {
+    .defaultValue  = EmberAfDefaultOrMinMaxAttributeValue(static_cast<uint32_t>(0)),
+    .attributeId   = 0,
+    .size          = 2,
+    .attributeType = ZCL_INT16U_ATTRIBUTE_TYPE,
+    .mask          = ATTRIBUTE_MASK_WRITABLE,
+};
+
+const EmberAfAttributeMetadata kStringMetadata = {
+    .defaultValue  = EmberAfDefaultOrMinMaxAttributeValue(static_cast<const uint8_t *>(nullptr)),
+    .attributeId   = 0,
+    .size          = 33,
+    .attributeType = ZCL_CHAR_STRING_ATTRIBUTE_TYPE,
+    .mask          = ATTRIBUTE_MASK_WRITABLE,
+};
+
+const EmberAfAttributeMetadata kLongStringMetadata = {
+    .defaultValue  = EmberAfDefaultOrMinMaxAttributeValue(static_cast<const uint8_t *>(nullptr)),
+    .attributeId   = 0,
+    .size          = 2 * PackedAttributePersistenceProvider::kMaxRecordSize,
+    .attributeType = ZCL_LONG_CHAR_STRING_ATTRIBUTE_TYPE,
+    .mask          = ATTRIBUTE_MASK_WRITABLE,
+};
+
+class CountingStorageDelegate : public TestPersistentStorageDelegate
+{
+public:
+    CHIP_ERROR SyncGetKeyValue(const char * key, void * buffer, uint16_t & size) override
+    {
+        mReads++;
+        return TestPersistentStorageDelegate::SyncGetKeyValue(key, buffer, size);
+    }
+
+    unsigned mReads = 0;
+};
+
+const char * RecordKey()
+{
+    static StorageKeyName key = DefaultStorageKeyAllocator::AttributeValues(kEndpoint, kCluster);
+    return key.KeyName();
+}
+
+std::string LegacyKey(AttributeId attribute)
+{
+    return DefaultStorageKeyAllocator::AttributeValue(kEndpoint, kCluster, attribute).KeyName();
+}
+
+CHIP_ERROR ReadUint16(AttributePersistenceProvider & provider, AttributeId attribute, uint16_t & value)
+{
+    MutableByteSpan span(reinterpret_cast<uint8_t *>(&value), sizeof(value));
+    ReturnErrorOnFailure(provider.ReadValue(ConcreteAttributePath(kEndpoint, kCluster, attribute), &kUint16Metadata, span));
+    VerifyOrReturnError(span.size() == sizeof(value), CHIP_ERROR_INTERNAL);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR WriteUint16(AttributePersistenceProvider & provider, AttributeId attribute, uint16_t value)
+{
+    return provider.WriteValue(ConcreteAttributePath(kEndpoint, kCluster, attribute),
+                               ByteSpan(reinterpret_cast<const uint8_t *>(&value), sizeof(value)));
+}
+
+TEST(TestPackedAttributePersistenceProvider, ClusterIsStoredInOneRecord)
+{
+    CountingStorageDelegate storage;
+    {
+        PackedAttributePersistenceProvider provider;
+        ASSERT_EQ(provider.Init(&storage), CHIP_NO_ERROR);
+
+        EXPECT_EQ(WriteUint16(provider, 0, 0x1234), CHIP_NO_ERROR);
+        EXPECT_EQ(WriteUint16(provider, 1, 0x5678), CHIP_NO_ERROR);
+        const uint8_t label[] = { 3, 'a', 'b', 'c' };
+        EXPECT_EQ(provider.WriteValue(ConcreteAttributePath(kEndpoint, kCluster, 2), ByteSpan(label)), CHIP_NO_ERROR);
+        EXPECT_EQ(WriteUint16(provider, 1, 0x9ABC), CHIP_NO_ERROR);
+    }
+
+    EXPECT_EQ(storage.GetNumKeys(), 1u);
+    EXPECT_TRUE(storage.HasKey(RecordKey()));
+
+    // Loading the cluster reads storage once.
+    PackedAttributePersistenceProvider provider;
+    ASSERT_EQ(provider.Init(&storage), CHIP_NO_ERROR);
+    storage.mReads = 0;
+
+    provider.StartClusterLoad(ConcreteClusterPath(kEndpoint, kCluster));
+    uint16_t value;
+    EXPECT_EQ(ReadUint16(provider, 0, value), CHIP_NO_ERROR);
+    EXPECT_EQ(value, 0x1234);
+    EXPECT_EQ(ReadUint16(provider, 1, value), CHIP_NO_ERROR);
+    EXPECT_EQ(value, 0x9ABC);
+
+    uint8_t buffer[33];
+    MutableByteSpan label(buffer);
+    EXPECT_EQ(provider.ReadValue(ConcreteAttributePath(kEndpoint, kCluster, 2), &kStringMetadata, label), CHIP_NO_ERROR);
+    EXPECT_EQ(label.size(), 4u);
+    EXPECT_EQ(memcmp(label.data(), "\x03" "abc", 4), 0);
+    provider.EndClusterLoad(ConcreteClusterPath(kEndpoint, kCluster));
+
+    EXPECT_EQ(storage.mReads, 1u);
+
+    // Attributes that were never written are not found in the record nor under their own key.
+    EXPECT_EQ(ReadUint16(provider, 3, value), CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+}
+
+TEST(TestPackedAttributePersistenceProvider, LegacyValuesAreMigrated)
+{
+    CountingStorageDelegate storage;
+    {
+        DefaultAttributePersistenceProvider legacy;
+        ASSERT_EQ(legacy.Init(&storage), CHIP_NO_ERROR);
+        EXPECT_EQ(WriteUint16(legacy, 0, 0x1111), CHIP_NO_ERROR);
+        EXPECT_EQ(WriteUint16(legacy, 1, 0x2222), CHIP_NO_ERROR);
+    }
+
+    {
+        PackedAttributePersistenceProvider provider;
+        ASSERT_EQ(provider.Init(&storage), CHIP_NO_ERROR);
+
+        provider.StartClusterLoad(ConcreteClusterPath(kEndpoint, kCluster));
+        uint16_t value;
+        EXPECT_EQ(ReadUint16(provider, 0, value), CHIP_NO_ERROR);
+        EXPECT_EQ(value, 0x1111);
+        EXPECT_EQ(ReadUint16(provider, 1, value), CHIP_NO_ERROR);
+        EXPECT_EQ(value, 0x2222);
+        provider.EndClusterLoad(ConcreteClusterPath(kEndpoint, kCluster));
+    }
+
+    EXPECT_EQ(storage.GetNumKeys(), 1u);
+    EXPECT_TRUE(storage.HasKey(RecordKey()));
+    EXPECT_FALSE(storage.HasKey(LegacyKey(0)));
+    EXPECT_FALSE(storage.HasKey(LegacyKey(1)));
+
+    PackedAttributePersistenceProvider provider;
+    ASSERT_EQ(provider.Init(&storage), CHIP_NO_ERROR);
+    uint16_t value;
+    EXPECT_EQ(ReadUint16(provider, 1, value), CHIP_NO_ERROR);
+    EXPECT_EQ(value, 0x2222);
+}
+
+TEST(TestPackedAttributePersistenceProvider, LegacyValuesAreKeptIfMigrationFails)
+{
+    CountingStorageDelegate storage;
+    {
+        DefaultAttributePersistenceProvider legacy;
+        ASSERT_EQ(legacy.Init(&storage), CHIP_NO_ERROR);
+        EXPECT_EQ(WriteUint16(legacy, 0, 0x1111), CHIP_NO_ERROR);
+    }
+    storage.AddPoisonKey(RecordKey());
+
+    PackedAttributePersistenceProvider provider;
+    ASSERT_EQ(provider.Init(&storage), CHIP_NO_ERROR);
+    provider.StartClusterLoad(ConcreteClusterPath(kEndpoint, kCluster));
+    uint16_t value;
+    EXPECT_EQ(ReadUint16(provider, 0, value), CHIP_NO_ERROR);
+    EXPECT_EQ(value, 0x1111);
+    provider.EndClusterLoad(ConcreteClusterPath(kEndpoint, kCluster));
+
+    EXPECT_TRUE(storage.HasKey(LegacyKey(0)));
+}
+
+TEST(TestPackedAttributePersistenceProvider, OversizedValuesUseTheirOwnKey)
+{
+    CountingStorageDelegate storage;
+    PackedAttributePersistenceProvider provider;
+    ASSERT_EQ(provider.Init(&storage), CHIP_NO_ERROR);
+
+    const uint8_t shortValue[] = { 2, 0, 'h', 'i' };
+    const ConcreteAttributePath path(kEndpoint, kCluster, 5);
+    EXPECT_EQ(provider.WriteValue(path, ByteSpan(shortValue)), CHIP_NO_ERROR);
+    EXPECT_TRUE(storage.HasKey(RecordKey()));
+
+    uint8_t longValue[PackedAttributePersistenceProvider::kMaxRecordSize + 2];
+    memset(longValue, 'x', sizeof(longValue));
+    longValue[0] = static_cast<uint8_t>((sizeof(longValue) - 2) & 0xFF);
+    longValue[1] = static_cast<uint8_t>((sizeof(longValue) - 2) >> 8);
+    EXPECT_EQ(provider.WriteValue(path, ByteSpan(longValue)), CHIP_NO_ERROR);
+
+    // The short value left the record, which is now empty.
+    EXPECT_FALSE(storage.HasKey(RecordKey()));
+    EXPECT_TRUE(storage.HasKey(LegacyKey(5)));
+
+    uint8_t buffer[2 * PackedAttributePersistenceProvider::kMaxRecordSize];
+    MutableByteSpan readBack(buffer);
+    EXPECT_EQ(provider.ReadValue(path, &kLongStringMetadata, readBack), CHIP_NO_ERROR);
+    EXPECT_TRUE(readBack.data_equal(ByteSpan(longValue)));
+}
+
+TEST(TestPackedAttributePersistenceProvider, InvalidRecordIsIgnored)
+{
+    CountingStorageDelegate storage;
+    const uint8_t futureRecord[] = { PackedAttributePersistenceProvider::kRecordVersion + 1, 0, 0, 0, 0, 2, 0, 1, 2 };
+    ASSERT_EQ(storage.SyncSetKeyValue(RecordKey(), futureRecord, sizeof(futureRecord)), CHIP_NO_ERROR);
+
+    PackedAttributePersistenceProvider provider;
+    ASSERT_EQ(provider.Init(&storage), CHIP_NO_ERROR);
+    uint16_t value;
+    EXPECT_EQ(ReadUint16(provider, 0, value), CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+
+    const uint8_t truncatedRecord[] = { PackedAttributePersistenceProvider::kRecordVersion, 0, 0, 0, 0, 4, 0, 1, 2 };
+    ASSERT_EQ(storage.SyncSetKeyValue(RecordKey(), truncatedRecord, sizeof(truncatedRecord)), CHIP_NO_ERROR);
+    PackedAttributePersistenceProvider otherProvider;
+    ASSERT_EQ(otherProvider.Init(&storage), CHIP_NO_ERROR);
+    EXPECT_EQ(ReadUint16(otherProvider, 0, value), CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+}
+
+void ExpectRecordIsNotRewritten(CountingStorageDelegate & storage, const ByteSpan & record)
+{
+    PackedAttributePersistenceProvider provider;
+    ASSERT_EQ(provider.Init(&storage), CHIP_NO_ERROR);
+
+    provider.StartClusterLoad(ConcreteClusterPath(kEndpoint, kCluster));
+    uint16_t value;
+    EXPECT_EQ(ReadUint16(provider, 0, value), CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+    provider.EndClusterLoad(ConcreteClusterPath(kEndpoint, kCluster));
+
+    // Writes go to the keys of the attributes.
+    EXPECT_EQ(WriteUint16(provider, 0, 0x1234), CHIP_NO_ERROR);
+    EXPECT_EQ(WriteUint16(provider, 1, 0x5678), CHIP_NO_ERROR);
+    EXPECT_TRUE(storage.HasKey(LegacyKey(0)));
+    EXPECT_TRUE(storage.HasKey(LegacyKey(1)));
+
+    uint8_t buffer[2 * PackedAttributePersistenceProvider::kMaxRecordSize];
+    uint16_t size = sizeof(buffer);
+    EXPECT_EQ(storage.SyncGetKeyValue(RecordKey(), buffer, size), CHIP_NO_ERROR);
+    EXPECT_TRUE(ByteSpan(buffer, size).data_equal(record));
+
+    // Values are not moved into the record either.
+    PackedAttributePersistenceProvider otherProvider;
+    ASSERT_EQ(otherProvider.Init(&storage), CHIP_NO_ERROR);
+    otherProvider.StartClusterLoad(ConcreteClusterPath(kEndpoint, kCluster));
+    EXPECT_EQ(ReadUint16(otherProvider, 0, value), CHIP_NO_ERROR);
+    EXPECT_EQ(value, 0x1234);
+    EXPECT_EQ(ReadUint16(otherProvider, 1, value), CHIP_NO_ERROR);
+    EXPECT_EQ(value, 0x5678);
+    otherProvider.EndClusterLoad(ConcreteClusterPath(kEndpoint, kCluster));
+
+    size = sizeof(buffer);
+    EXPECT_EQ(storage.SyncGetKeyValue(RecordKey(), buffer, size), CHIP_NO_ERROR);
+    EXPECT_TRUE(ByteSpan(buffer, size).data_equal(record));
+    EXPECT_TRUE(storage.HasKey(LegacyKey(0)));
+}
+
+TEST(TestPackedAttributePersistenceProvider, RecordOfNewerVersionIsNotRewritten)
+{
+    CountingStorageDelegate storage;
+    const uint8_t futureRecord[] = { PackedAttributePersistenceProvider::kRecordVersion + 1, 2, 0, 0, 0, 2, 0, 1, 2 };
+    ASSERT_EQ(storage.SyncSetKeyValue(RecordKey(), futureRecord, sizeof(futureRecord)), CHIP_NO_ERROR);
+
+    ExpectRecordIsNotRewritten(storage, ByteSpan(futureRecord));
+}
+
+TEST(TestPackedAttributePersistenceProvider, OversizedRecordIsNotRewritten)
+{
+    // Written by a build with a larger maximum record size.
+    CountingStorageDelegate storage;
+    uint8_t largeRecord[PackedAttributePersistenceProvider::kMaxRecordSize + 16];
+    const size_t valueSize = sizeof(largeRecord) - 1 - 6;
+    largeRecord[0]         = PackedAttributePersistenceProvider::kRecordVersion;
+    largeRecord[1]         = 2;
+    largeRecord[2]         = 0;
+    largeRecord[3]         = 0;
+    largeRecord[4]         = 0;
+    largeRecord[5]         = static_cast<uint8_t>(valueSize & 0xFF);
+    largeRecord[6]         = static_cast<uint8_t>(valueSize >> 8);
+    memset(&largeRecord[7], 'x', valueSize);
+    ASSERT_EQ(storage.SyncSetKeyValue(RecordKey(), largeRecord, sizeof(largeRecord)), CHIP_NO_ERROR);
+
+    ExpectRecordIsNotRewritten(storage, ByteSpan(largeRecord));
+}
+
+} // namespace
@@ -32,6 +32,7 @@
 #include <app/reporting/tests/MockReportScheduler.h>
 #include <app/tests/AppTestContext.h>
 #include <app/tests/test-interaction-model-api.h>
+#include <app/util/mock/Constants.h>
 #include <data-model-providers/codegen/Instance.h>
 #include <lib/core/CHIPCore.h>
 #include <lib/core/ErrorStr.h>
@@ -42,6 +43,7 @@
 #include <lib/support/tests/ExtraPwTestMacros.h>
 #include <messaging/ExchangeContext.h>
 #include <messaging/Flags.h>
+#include <transport/raw/tests/NetworkTestHelpers.h>
 
 namespace chip {
 
@@ -96,6 +98,8 @@ public:
     static bool InsertToDirtySet(const AttributePathParams & aPath);
 
     void TestBuildAndSendSingleReportData();
+    void TestMaxLargeReportSize();
+    void TestLargeReportsOnLargePayloadSession();
     void TestMergeOverlappedAttributePath();
     void TestMergeAttributePathWhenDirtySetPoolExhausted();
 
@@ -120,6 +124,18 @@ class TestExchangeDelegate : public Messaging::ExchangeDelegate
     void OnResponseTimeout(Messaging::ExchangeContext * ec) override {}
 };
 
+// Records the size of the largest message handed to the loopback transport.
+class MessageSizeRecorder : public chip::Test::LoopbackTransportDelegate
+{
+public:
+    void WillSendMessage(const Transport::PeerAddress & peer, const System::PacketBufferHandle & message) override
+    {
+        mMaxMessageSize = std::max(mMaxMessageSize, static_cast<size_t>(message->TotalLength()));
+    }
+
+    size_t mMaxMessageSize = 0;
+};
+
 class DummyDelegate : public ReadHandler::ManagementCallback
 {
 public:
@@ -218,6 +234,121 @@ TEST_F_FROM_FIXTURE(TestReportingEngine, TestBuildAndSendSingleReportData)
     DrainAndServiceIO();
 }
 
+TEST_F_FROM_FIXTURE(TestReportingEngine, TestMaxLargeReportSize)
+{
+    DummyDelegate dummy;
+
+    EXPECT_EQ(InteractionModelEngine::GetInstance()->Init(&GetExchangeManager(), &GetFabricTable(),
+                                                          app::reporting::GetDefaultReportScheduler()),
+              CHIP_NO_ERROR);
+    Engine & engine = InteractionModelEngine::GetInstance()->GetReportingEngine();
+    EXPECT_EQ(engine.GetMaxLargeReportSize(), kMaxLargeSecureSduLengthBytes);
+
+    // The size is kept between the MRP and the large packet buffer limits.
+    const size_t size = (kMaxSecureSduLengthBytes + kMaxLargeSecureSduLengthBytes) / 2;
+    engine.SetMaxLargeReportSize(size);
+    EXPECT_EQ(engine.GetMaxLargeReportSize(), size);
+    engine.SetMaxLargeReportSize(0);
+    EXPECT_EQ(engine.GetMaxLargeReportSize(), kMaxSecureSduLengthBytes);
+    engine.SetMaxLargeReportSize(SIZE_MAX);
+    EXPECT_EQ(engine.GetMaxLargeReportSize(), kMaxLargeSecureSduLengthBytes);
+
+    // Sessions that do not support large payloads keep MRP-sized reports.
+    engine.SetMaxLargeReportSize(size);
+    TestExchangeDelegate delegate;
+    Messaging::ExchangeContext * exchangeCtx = NewExchangeToAlice(&delegate);
+    app::ReadHandler readHandler(dummy, exchangeCtx, chip::app::ReadHandler::InteractionType::Read,
+                                 app::reporting::GetDefaultReportScheduler());
+    EXPECT_EQ(readHandler.GetReportBufferMaxSize(), kMaxSecureSduLengthBytes);
+
+    engine.SetMaxLargeReportSize(kMaxLargeSecureSduLengthBytes);
+    exchangeCtx->Close();
+    DrainAndServiceIO();
+}
+
+TEST_F_FROM_FIXTURE(TestReportingEngine, TestLargeReportsOnLargePayloadSession)
+{
+    using namespace chip::Test;
+
+    // MockAttributeId(4) is a list of 1.5 kB, so the priming report of these paths needs several MRP-sized chunks.
+    // clang-format off
+    SetMockNodeConfig(MockNodeConfig({
+        MockEndpointConfig(kMockEndpoint1, {
+            MockClusterConfig(MockClusterId(1), { MockAttributeId(4) }),
+            MockClusterConfig(MockClusterId(2), { MockAttributeId(4) }),
+            MockClusterConfig(MockClusterId(3), { MockAttributeId(4) }),
+        }),
+    }));
+    // clang-format on
+
+    System::PacketBufferTLVWriter writer;
+    System::PacketBufferHandle subscribeRequestbuf = System::PacketBufferHandle::New(System::PacketBuffer::kMaxSize);
+    SubscribeRequestMessage::Builder subscribeRequestBuilder;
+    DummyDelegate dummy;
+
+    EXPECT_EQ(InteractionModelEngine::GetInstance()->Init(&GetExchangeManager(), &GetFabricTable(),
+                                                          app::reporting::GetDefaultReportScheduler()),
+              CHIP_NO_ERROR);
+    Engine & engine                 = InteractionModelEngine::GetInstance()->GetReportingEngine();
+    const size_t maxLargeReportSize = 2 * kMaxSecureSduLengthBytes;
+    engine.SetMaxLargeReportSize(maxLargeReportSize);
+
+    TestExchangeDelegate delegate;
+    Messaging::ExchangeContext * exchangeCtx = NewExchangeToAlice(&delegate);
+
+    // Make the session look like a TCP session, which supports large payloads. The loopback transport cannot deliver messages
+    // of such sessions, so the report is only recorded and dropped.
+    Transport::SecureSession * session     = exchangeCtx->GetSessionHandle()->AsSecureSession();
+    const Transport::PeerAddress udpAddress = session->GetPeerAddress();
+    session->SetPeerAddress(Transport::PeerAddress::TCP(udpAddress.GetIPAddress(), udpAddress.GetPort()));
+    ASSERT_TRUE(session->AllowsLargePayload());
+
+    MessageSizeRecorder recorder;
+    GetLoopback().SetLoopbackTransportDelegate(&recorder);
+    GetLoopback().mNumMessagesToDrop = 1;
+
+    writer.Init(std::move(subscribeRequestbuf));
+    EXPECT_EQ(subscribeRequestBuilder.Init(&writer), CHIP_NO_ERROR);
+    subscribeRequestBuilder.KeepSubscriptions(true).MinIntervalFloorSeconds(0).MaxIntervalCeilingSeconds(60);
+    AttributePathIBs::Builder & attributePathListBuilder = subscribeRequestBuilder.CreateAttributeRequests();
+    EXPECT_EQ(subscribeRequestBuilder.GetError(), CHIP_NO_ERROR);
+    for (uint16_t cluster = 1; cluster <= 3; cluster++)
+    {
+        AttributePathIB::Builder & attributePathBuilder = attributePathListBuilder.CreatePath();
+        EXPECT_EQ(attributePathListBuilder.GetError(), CHIP_NO_ERROR);
+        attributePathBuilder.Endpoint(kMockEndpoint1)
+            .Cluster(MockClusterId(cluster))
+            .Attribute(MockAttributeId(4))
+            .EndOfAttributePathIB();
+        EXPECT_EQ(attributePathBuilder.GetError(), CHIP_NO_ERROR);
+    }
+    attributePathListBuilder.EndOfAttributePathIBs();
+    subscribeRequestBuilder.IsFabricFiltered(false).EndOfSubscribeRequestMessage();
+    EXPECT_EQ(subscribeRequestBuilder.GetError(), CHIP_NO_ERROR);
+    EXPECT_EQ(writer.Finalize(&subscribeRequestbuf), CHIP_NO_ERROR);
+
+    {
+        app::ReadHandler readHandler(dummy, exchangeCtx, chip::app::ReadHandler::InteractionType::Subscribe,
+                                     app::reporting::GetDefaultReportScheduler());
+        readHandler.OnInitialRequest(std::move(subscribeRequestbuf));
+        EXPECT_EQ(readHandler.GetReportBufferMaxSize(), maxLargeReportSize);
+
+        EXPECT_EQ(engine.BuildAndSendSingleReportData(&readHandler), CHIP_NO_ERROR);
+        EXPECT_TRUE(readHandler.IsChunkedReport());
+    }
+
+    // The first chunk is larger than any MRP-sized message, but the report with its headers stays within the cap.
+    EXPECT_EQ(GetLoopback().mDroppedMessageCount, 1u);
+    EXPECT_GT(recorder.mMaxMessageSize, kMaxSecureSduLengthBytes + CHIP_SYSTEM_HEADER_RESERVE_SIZE);
+    EXPECT_LE(recorder.mMaxMessageSize, maxLargeReportSize + CHIP_SYSTEM_HEADER_RESERVE_SIZE);
+
+    GetLoopback().SetLoopbackTransportDelegate(nullptr);
+    GetLoopback().mDroppedMessageCount = 0;
+    session->SetPeerAddress(udpAddress);
+    engine.SetMaxLargeReportSize(kMaxLargeSecureSduLengthBytes);
+    DrainAndServiceIO();
+}
+
 TEST_F_FROM_FIXTURE(TestReportingEngine, TestMergeOverlappedAttributePath)
 {
     EXPECT_EQ(InteractionModelEngine::GetInstance()->Init(&GetExchangeManager(), &GetFabricTable(),
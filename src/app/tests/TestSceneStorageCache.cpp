@@ -0,0 +1,243 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/clusters/scenes-server/SceneStorageCache.h>
+#include <app/clusters/scenes-server/SceneTableImpl.h>
+#include <lib/core/StringBuilderAdapters.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/Span.h>
+#include <lib/support/TestPersistentStorageDelegate.h>
+
+#include <pw_unit_test/framework.h>
+
+#include <string.h>
+
+using namespace chip;
+
+namespace {
+
+using SceneTableImpl  = scenes::DefaultSceneTableImpl;
+using SceneTableEntry = scenes::DefaultSceneTableImpl::SceneTableEntry;
+using SceneStorageId  = scenes::DefaultSceneTableImpl::SceneStorageId;
+using SceneData       = scenes::DefaultSceneTableImpl::SceneData;
+
+constexpr EndpointId kTestEndpoint = 1;
+constexpr FabricIndex kFabric1     = 1;
+constexpr FabricIndex kFabric2     = 2;
+constexpr GroupId kGroup1          = 0x101;
+
+class CountingStorageDelegate : public TestPersistentStorageDelegate
+{
+public:
+    CHIP_ERROR SyncGetKeyValue(const char * key, void * buffer, uint16_t & size) override
+    {
+        mReads++;
+        return TestPersistentStorageDelegate::SyncGetKeyValue(key, buffer, size);
+    }
+
+    CHIP_ERROR SyncSetKeyValue(const char * key, const void * value, uint16_t size) override
+    {
+        mWrites++;
+        mWritesOutsideBatch += (mDepth == 0) ? 1 : 0;
+        return TestPersistentStorageDelegate::SyncSetKeyValue(key, value, size);
+    }
+
+    CHIP_ERROR StartBatch() override
+    {
+        mDepth++;
+        return TestPersistentStorageDelegate::StartBatch();
+    }
+
+    CHIP_ERROR CommitBatch() override
+    {
+        mDepth--;
+        if (mDepth == 0 && mFailCommit)
+        {
+            // Emulate a storage that could not make the batch durable.
+            TestPersistentStorageDelegate::AbortBatch();
+            return CHIP_ERROR_PERSISTED_STORAGE_FAILED;
+        }
+        mCommits += (mDepth == 0) ? 1 : 0;
+        return TestPersistentStorageDelegate::CommitBatch();
+    }
+
+    void AbortBatch() override
+    {
+        mDepth--;
+        TestPersistentStorageDelegate::AbortBatch();
+    }
+
+    unsigned mReads              = 0;
+    unsigned mWrites             = 0;
+    unsigned mWritesOutsideBatch = 0;
+    unsigned mCommits            = 0;
+    unsigned mDepth              = 0;
+    bool mFailCommit             = false;
+};
+
+class TestSceneStorageCache : public ::testing::Test
+{
+public:
+    static void SetUpTestSuite() { ASSERT_EQ(Platform::MemoryInit(), CHIP_NO_ERROR); }
+    static void TearDownTestSuite() { Platform::MemoryShutdown(); }
+};
+
+TEST_F(TestSceneStorageCache, RecalledSceneIsServedFromMemory)
+{
+    CountingStorageDelegate storage;
+    scenes::SceneStorageCache<8> cache;
+    SceneTableImpl sceneTable(&cache);
+    ASSERT_EQ(sceneTable.Init(&storage), CHIP_NO_ERROR);
+    sceneTable.SetEndpoint(kTestEndpoint);
+
+    const SceneTableEntry scene(SceneStorageId(0x01, kGroup1), SceneData("Evening"_span, 1000));
+    ASSERT_EQ(sceneTable.SetSceneTableEntry(kFabric1, scene), CHIP_NO_ERROR);
+
+    storage.mReads = 0;
+
+    SceneTableEntry recalled;
+    EXPECT_EQ(sceneTable.GetSceneTableEntry(kFabric1, scene.mStorageId, recalled), CHIP_NO_ERROR);
+    EXPECT_EQ(recalled, scene);
+
+    uint8_t count = 0;
+    EXPECT_EQ(sceneTable.GetFabricSceneCount(kFabric1, count), CHIP_NO_ERROR);
+    EXPECT_EQ(count, 1u);
+    EXPECT_EQ(sceneTable.GetEndpointSceneCount(count), CHIP_NO_ERROR);
+    EXPECT_EQ(count, 1u);
+    uint8_t capacity = 0;
+    EXPECT_EQ(sceneTable.GetRemainingCapacity(kFabric1, capacity), CHIP_NO_ERROR);
+
+    EXPECT_EQ(storage.mReads, 0u);
+
+    // Fabrics without scenes are remembered as well.
+    EXPECT_EQ(sceneTable.GetFabricSceneCount(kFabric2, count), CHIP_NO_ERROR);
+    EXPECT_EQ(count, 0u);
+    storage.mReads = 0;
+    EXPECT_EQ(sceneTable.GetFabricSceneCount(kFabric2, count), CHIP_NO_ERROR);
+    EXPECT_EQ(storage.mReads, 0u);
+
+    // The cache writes through: a table without cache sees the same scenes.
+    SceneTableImpl uncachedTable;
+    ASSERT_EQ(uncachedTable.Init(&storage), CHIP_NO_ERROR);
+    uncachedTable.SetEndpoint(kTestEndpoint);
+    EXPECT_EQ(uncachedTable.GetSceneTableEntry(kFabric1, scene.mStorageId, recalled), CHIP_NO_ERROR);
+    EXPECT_EQ(recalled, scene);
+
+    uncachedTable.Finish();
+    sceneTable.Finish();
+}
+
+TEST_F(TestSceneStorageCache, StoreSceneIsOneBatch)
+{
+    CountingStorageDelegate storage;
+    scenes::SceneStorageCache<8> cache;
+    SceneTableImpl sceneTable(&cache);
+    ASSERT_EQ(sceneTable.Init(&storage), CHIP_NO_ERROR);
+    sceneTable.SetEndpoint(kTestEndpoint);
+
+    const SceneTableEntry scene(SceneStorageId(0x01, kGroup1), SceneData("Morning"_span, 500));
+    ASSERT_EQ(sceneTable.SetSceneTableEntry(kFabric1, scene), CHIP_NO_ERROR);
+
+    // The endpoint scene count, the fabric scene map and the scene are written in a single commit.
+    EXPECT_EQ(storage.mCommits, 1u);
+    EXPECT_EQ(storage.mWrites, 3u);
+    EXPECT_EQ(storage.mWritesOutsideBatch, 0u);
+
+    // Overwriting the scene only writes the scene.
+    storage.mCommits = 0;
+    storage.mWrites  = 0;
+    ASSERT_EQ(sceneTable.SetSceneTableEntry(kFabric1, scene), CHIP_NO_ERROR);
+    EXPECT_EQ(storage.mCommits, 1u);
+    EXPECT_EQ(storage.mWrites, 1u);
+
+    EXPECT_EQ(sceneTable.RemoveSceneTableEntry(kFabric1, scene.mStorageId), CHIP_NO_ERROR);
+    EXPECT_EQ(storage.mWritesOutsideBatch, 0u);
+
+    sceneTable.Finish();
+}
+
+TEST_F(TestSceneStorageCache, FailedCommitIsNotCached)
+{
+    CountingStorageDelegate storage;
+    scenes::SceneStorageCache<8> cache;
+    SceneTableImpl sceneTable(&cache);
+    ASSERT_EQ(sceneTable.Init(&storage), CHIP_NO_ERROR);
+    sceneTable.SetEndpoint(kTestEndpoint);
+
+    const SceneTableEntry scene(SceneStorageId(0x02, kGroup1), SceneData("Night"_span));
+    storage.mFailCommit = true;
+    EXPECT_EQ(sceneTable.SetSceneTableEntry(kFabric1, scene), CHIP_ERROR_PERSISTED_STORAGE_FAILED);
+    storage.mFailCommit = false;
+
+    EXPECT_EQ(storage.GetNumKeys(), 0u);
+
+    SceneTableEntry recalled;
+    EXPECT_EQ(sceneTable.GetSceneTableEntry(kFabric1, scene.mStorageId, recalled), CHIP_ERROR_NOT_FOUND);
+    uint8_t count = 0;
+    EXPECT_EQ(sceneTable.GetEndpointSceneCount(count), CHIP_NO_ERROR);
+    EXPECT_EQ(count, 0u);
+
+    sceneTable.Finish();
+}
+
+TEST_F(TestSceneStorageCache, LeastRecentlyUsedRecordIsEvicted)
+{
+    CountingStorageDelegate storage;
+    scenes::SceneStorageCache<2> cache;
+    ASSERT_EQ(cache.Init(&storage), CHIP_NO_ERROR);
+
+    const uint8_t a[] = { 1 };
+    const uint8_t b[] = { 2, 2 };
+    const uint8_t c[] = { 3, 3, 3 };
+    EXPECT_EQ(cache.SyncSetKeyValue("a", a, sizeof(a)), CHIP_NO_ERROR);
+    EXPECT_EQ(cache.SyncSetKeyValue("b", b, sizeof(b)), CHIP_NO_ERROR);
+
+    uint8_t buffer[4];
+    uint16_t size = sizeof(buffer);
+    EXPECT_EQ(cache.SyncGetKeyValue("a", buffer, size), CHIP_NO_ERROR);
+    EXPECT_EQ(storage.mReads, 0u);
+
+    // "b" is the least recently used record.
+    EXPECT_EQ(cache.SyncSetKeyValue("c", c, sizeof(c)), CHIP_NO_ERROR);
+    size = sizeof(buffer);
+    EXPECT_EQ(cache.SyncGetKeyValue("a", buffer, size), CHIP_NO_ERROR);
+    EXPECT_EQ(storage.mReads, 0u);
+    size = sizeof(buffer);
+    EXPECT_EQ(cache.SyncGetKeyValue("b", buffer, size), CHIP_NO_ERROR);
+    EXPECT_EQ(storage.mReads, 1u);
+    EXPECT_EQ(size, sizeof(b));
+    EXPECT_EQ(memcmp(buffer, b, sizeof(b)), 0);
+
+    // Too small a buffer still gets the start of the value.
+    size = 1;
+    EXPECT_EQ(cache.SyncGetKeyValue("b", buffer, size), CHIP_ERROR_BUFFER_TOO_SMALL);
+    EXPECT_EQ(buffer[0], 2);
+
+    // Values too large for an entry go straight to storage.
+    uint8_t large[CHIP_CONFIG_SCENES_MAX_SERIALIZED_SCENE_SIZE_BYTES + 1];
+    memset(large, 0x5A, sizeof(large));
+    EXPECT_EQ(cache.SyncSetKeyValue("large", large, sizeof(large)), CHIP_NO_ERROR);
+    uint8_t largeBuffer[sizeof(large)];
+    size           = sizeof(largeBuffer);
+    storage.mReads = 0;
+    EXPECT_EQ(cache.SyncGetKeyValue("large", largeBuffer, size), CHIP_NO_ERROR);
+    EXPECT_EQ(size, sizeof(large));
+    EXPECT_EQ(memcmp(largeBuffer, large, sizeof(large)), 0);
+    EXPECT_EQ(storage.mReads, 2u);
+}
+
+} // namespace
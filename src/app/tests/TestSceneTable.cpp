@@ -2350,6 +2350,10 @@ TEST_F(TestSceneTable, TestOTAChanges)
 
     ReducedSceneTable.Finish();
 
+    // The original scene table comes back as after a reboot, without the records it cached before the other tables wrote to
+    // the storage
+    EXPECT_EQ(CHIP_NO_ERROR, sceneTable->Init(mpTestStorage));
+
     // The Scene 8 should now have been truncated from the memory and thus not be accessible from both fabrics in the
     // original scene table
     EXPECT_EQ(CHIP_ERROR_NOT_FOUND, sceneTable->GetSceneTableEntry(kFabric1, sceneId8, scene));
@@ -0,0 +1,242 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/SimpleSubscriptionResumptionStorage.h>
+#include <app/SubscriptionResumptionQueue.h>
+#include <lib/core/StringBuilderAdapters.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/TestPersistentStorageDelegate.h>
+
+#include <pw_unit_test/framework.h>
+
+#include <vector>
+
+using namespace chip;
+using namespace chip::app;
+
+namespace {
+
+using Disposition      = SubscriptionResumptionQueue::Disposition;
+using SubscriptionInfo = SubscriptionResumptionStorage::SubscriptionInfo;
+
+constexpr FabricIndex kFabric        = 1;
+constexpr FabricIndex kRemovedFabric = 2;
+constexpr NodeId kPeerA              = 0xA;
+constexpr NodeId kPeerB              = 0xB;
+constexpr NodeId kPeerC              = 0xC;
+
+class TestSubscriptionResumptionQueue : public ::testing::Test
+{
+public:
+    static void SetUpTestSuite() { ASSERT_EQ(Platform::MemoryInit(), CHIP_NO_ERROR); }
+    static void TearDownTestSuite() { Platform::MemoryShutdown(); }
+
+    void SetUp() override
+    {
+        ASSERT_EQ(mSubscriptionStorage.Init(&mStorage), CHIP_NO_ERROR);
+        mStarted.clear();
+        mStartError = CHIP_NO_ERROR;
+    }
+
+    void Save(NodeId node, FabricIndex fabric, SubscriptionId subscriptionId, uint16_t minInterval = 1)
+    {
+        SubscriptionInfo info;
+        info.mNodeId         = node;
+        info.mFabricIndex    = fabric;
+        info.mSubscriptionId = subscriptionId;
+        info.mMinInterval    = minInterval;
+        info.mMaxInterval    = 60;
+        info.mFabricFiltered = false;
+#if CHIP_CONFIG_SUBSCRIPTION_TIMEOUT_RESUMPTION
+        info.mResumptionRetries = 0;
+#endif
+        ASSERT_EQ(mSubscriptionStorage.Save(info), CHIP_NO_ERROR);
+    }
+
+    size_t StoredCount()
+    {
+        auto * iterator = mSubscriptionStorage.IterateSubscriptions();
+        size_t count    = iterator->Count();
+        iterator->Release();
+        return count;
+    }
+
+    // Skips the live subscription 5 and discards the subscriptions of the removed fabric.
+    static Disposition Classify(void * context, const SubscriptionInfo & info)
+    {
+        if (info.mFabricIndex == kRemovedFabric)
+        {
+            return Disposition::kDiscard;
+        }
+        return (info.mSubscriptionId == 5) ? Disposition::kSkip : Disposition::kResume;
+    }
+
+    static CHIP_ERROR Start(void * context, SubscriptionResumptionSessionEstablisher & establisher)
+    {
+        auto * test = static_cast<TestSubscriptionResumptionQueue *>(context);
+        VerifyOrReturnError(test->mStartError == CHIP_NO_ERROR, test->mStartError);
+        test->mStarted.push_back(&establisher);
+        return CHIP_NO_ERROR;
+    }
+
+    std::vector<SubscriptionId> StartedIds() const
+    {
+        std::vector<SubscriptionId> ids;
+        for (auto * establisher : mStarted)
+        {
+            ids.push_back(establisher->mSubscriptionInfo.mSubscriptionId);
+        }
+        return ids;
+    }
+
+    // Completes a started resumption the way the establisher callbacks do.
+    void Complete(SubscriptionResumptionQueue & queue, size_t index, bool resumed)
+    {
+        queue.OnResumptionDone(*mStarted[index], resumed);
+        Platform::Delete(mStarted[index]);
+        mStarted[index] = nullptr;
+    }
+
+    TestPersistentStorageDelegate mStorage;
+    SimpleSubscriptionResumptionStorage mSubscriptionStorage;
+    std::vector<SubscriptionResumptionSessionEstablisher *> mStarted;
+    CHIP_ERROR mStartError = CHIP_NO_ERROR;
+};
+
+TEST_F(TestSubscriptionResumptionQueue, LoadGroupsSubscriptionsByPeer)
+{
+    Save(kPeerA, kFabric, 1, 10);
+    Save(kPeerB, kFabric, 2);
+    Save(kPeerA, kFabric, 3, 30);
+    Save(kPeerC, kFabric, 4);
+    Save(kPeerB, kFabric, 5, 50);
+    Save(kPeerA, kRemovedFabric, 6, 60);
+
+    SubscriptionResumptionQueue queue;
+    ASSERT_EQ(queue.Load(mSubscriptionStorage, Classify, this), CHIP_NO_ERROR);
+
+    const auto & metrics = queue.GetMetrics();
+    EXPECT_EQ(metrics.mLoaded, 6u);
+    EXPECT_EQ(metrics.mSkipped, 1u);
+    EXPECT_EQ(metrics.mDiscarded, 1u);
+    EXPECT_EQ(metrics.mPeers, 3u);
+    EXPECT_EQ(queue.GetPendingCount(), 4u);
+    EXPECT_EQ(queue.GetMaxMinInterval(), 30u);
+
+    // The discarded subscription is deleted, the skipped one is kept.
+    EXPECT_EQ(StoredCount(), 5u);
+
+    // All the subscriptions of a peer are started together, peers in load order.
+    EXPECT_TRUE(queue.StartNextPeer(Start, this));
+    EXPECT_EQ(StartedIds(), (std::vector<SubscriptionId>{ 1, 3 }));
+    EXPECT_EQ(queue.GetPeersInProgress(), 1u);
+
+    EXPECT_TRUE(queue.StartNextPeer(Start, this));
+    EXPECT_EQ(StartedIds(), (std::vector<SubscriptionId>{ 1, 3, 2 }));
+    EXPECT_EQ(queue.GetPeersInProgress(), 2u);
+
+    EXPECT_TRUE(queue.StartNextPeer(Start, this));
+    EXPECT_FALSE(queue.StartNextPeer(Start, this));
+    EXPECT_EQ(StartedIds(), (std::vector<SubscriptionId>{ 1, 3, 2, 4 }));
+    EXPECT_EQ(queue.GetPeersInProgress(), 3u);
+    EXPECT_EQ(metrics.mStarted, 4u);
+
+    // A peer is in progress until all of its subscriptions are done.
+    EXPECT_TRUE(queue.IsInProgress(ScopedNodeId(kPeerA, kFabric), 3));
+    Complete(queue, 0, true);
+    EXPECT_EQ(queue.GetPeersInProgress(), 3u);
+    Complete(queue, 1, false);
+    EXPECT_EQ(queue.GetPeersInProgress(), 2u);
+    EXPECT_FALSE(queue.IsInProgress(ScopedNodeId(kPeerA, kFabric), 3));
+
+    Complete(queue, 2, true);
+    Complete(queue, 3, true);
+    EXPECT_EQ(queue.GetPeersInProgress(), 0u);
+    EXPECT_EQ(metrics.mResumed, 3u);
+    EXPECT_EQ(metrics.mFailed, 1u);
+}
+
+TEST_F(TestSubscriptionResumptionQueue, SubscriptionsInProgressAreNotLoadedTwice)
+{
+    Save(kPeerA, kFabric, 1);
+    Save(kPeerB, kFabric, 2);
+
+    SubscriptionResumptionQueue queue;
+    ASSERT_EQ(queue.Load(mSubscriptionStorage, Classify, this), CHIP_NO_ERROR);
+    EXPECT_TRUE(queue.StartNextPeer(Start, this));
+
+    // Reloading while peer A is being resumed only queues peer B again.
+    queue.Clear();
+    EXPECT_FALSE(queue.HasPending());
+    ASSERT_EQ(queue.Load(mSubscriptionStorage, Classify, this), CHIP_NO_ERROR);
+    EXPECT_EQ(queue.GetPendingCount(), 1u);
+    EXPECT_EQ(queue.GetMetrics().mSkipped, 1u);
+
+    EXPECT_TRUE(queue.StartNextPeer(Start, this));
+    EXPECT_EQ(StartedIds(), (std::vector<SubscriptionId>{ 1, 2 }));
+    Complete(queue, 0, true);
+    Complete(queue, 1, true);
+}
+
+TEST_F(TestSubscriptionResumptionQueue, ReloadWhilePeerInProgressCountsPeerOnce)
+{
+    Save(kPeerA, kFabric, 1);
+
+    SubscriptionResumptionQueue queue;
+    ASSERT_EQ(queue.Load(mSubscriptionStorage, Classify, this), CHIP_NO_ERROR);
+    EXPECT_TRUE(queue.StartNextPeer(Start, this));
+    EXPECT_EQ(queue.GetPeersInProgress(), 1u);
+
+    // A new subscription of peer A is persisted and reloaded while its first one is still being resumed.
+    Save(kPeerA, kFabric, 2);
+    ASSERT_EQ(queue.Load(mSubscriptionStorage, Classify, this), CHIP_NO_ERROR);
+    EXPECT_EQ(queue.GetPendingCount(), 1u);
+    EXPECT_TRUE(queue.StartNextPeer(Start, this));
+    EXPECT_EQ(StartedIds(), (std::vector<SubscriptionId>{ 1, 2 }));
+    EXPECT_EQ(queue.GetPeersInProgress(), 1u);
+
+    Complete(queue, 0, true);
+    EXPECT_EQ(queue.GetPeersInProgress(), 1u);
+    Complete(queue, 1, true);
+    EXPECT_EQ(queue.GetPeersInProgress(), 0u);
+}
+
+TEST_F(TestSubscriptionResumptionQueue, StartFailures)
+{
+    Save(kPeerA, kFabric, 1);
+    Save(kPeerA, kFabric, 2);
+    Save(kPeerB, kFabric, 3);
+
+    SubscriptionResumptionQueue queue;
+    ASSERT_EQ(queue.Load(mSubscriptionStorage, Classify, this), CHIP_NO_ERROR);
+
+    // Subscriptions that no longer need resuming are skipped, the others that fail to start are failures.
+    mStartError = CHIP_ERROR_CANCELLED;
+    EXPECT_TRUE(queue.StartNextPeer(Start, this));
+    mStartError = CHIP_ERROR_NO_MEMORY;
+    EXPECT_TRUE(queue.StartNextPeer(Start, this));
+
+    const auto & metrics = queue.GetMetrics();
+    EXPECT_EQ(metrics.mSkipped, 2u);
+    EXPECT_EQ(metrics.mStarted, 1u);
+    EXPECT_EQ(metrics.mFailed, 1u);
+    EXPECT_EQ(queue.GetPeersInProgress(), 0u);
+    EXPECT_FALSE(queue.HasPending());
+    EXPECT_TRUE(mStarted.empty());
+}
+
+} // namespace
@@ -1183,6 +1183,13 @@ void emAfLoadAttributeDefaults(EndpointId endpoint, Optional<ClusterId> clusterI
             {
                 // halResetWatchdog();
             }
+
+            const ConcreteClusterPath clusterPath(de->endpoint, cluster->clusterId);
+            if (attrStorage != nullptr)
+            {
+                attrStorage->StartClusterLoad(clusterPath);
+            }
+
             for (attr = 0; attr < cluster->attributeCount; attr++)
             {
                 const EmberAfAttributeMetadata * am = &(cluster->attributes[attr]);
@@ -1274,6 +1281,11 @@ void emAfLoadAttributeDefaults(EndpointId endpoint, Optional<ClusterId> clusterI
                                              true); // write?
                 }
             }
+
+            if (attrStorage != nullptr)
+            {
+                attrStorage->EndClusterLoad(clusterPath);
+            }
         }
         if (endpoint != kInvalidEndpointId)
         {
@@ -70,6 +70,23 @@ public:
      */
     virtual CHIP_ERROR ReadValue(const ConcreteAttributePath & aPath, const EmberAfAttributeMetadata * aMetadata,
                                  MutableByteSpan & aValue) = 0;
+
+    /**
+     * Called before the persisted attributes of a cluster instance are read
+     * one after another with ReadValue(), and after the last of them.  Lets
+     * implementations that store all the attributes of a cluster together
+     * read them from storage only once.  Implementations that store each
+     * attribute separately do not need to override these.
+     */
+    virtual void StartClusterLoad(const ConcreteClusterPath & aPath) {}
+    virtual void EndClusterLoad(const ConcreteClusterPath & aPath) {}
+
+    /**
+     * Write to non-volatile memory any attribute value whose write was
+     * deferred by the implementation.  Called when the data model shuts down.
+     * Implementations that write synchronously do not need to override this.
+     */
+    virtual CHIP_ERROR Flush() { return CHIP_NO_ERROR; }
 };
 
 /**
@@ -0,0 +1,297 @@
+/*
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/util/persistence/CoalescingAttributePersistenceProvider.h>
+
+#include <app/util/persistence/DefaultAttributePersistenceProvider.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <platform/CHIPDeviceLayer.h>
+
+#include <algorithm>
+#include <string.h>
+
+namespace chip {
+namespace app {
+
+CHIP_ERROR CoalescedAttribute::SetValue(const ByteSpan & value)
+{
+    if (mValue.AllocatedSize() != value.size())
+    {
+        mValue.Alloc(value.size());
+        VerifyOrReturnError(mValue || value.empty(), CHIP_ERROR_NO_MEMORY);
+    }
+
+    if (!value.empty())
+    {
+        memcpy(mValue.Get(), value.data(), value.size());
+    }
+    return CHIP_NO_ERROR;
+}
+
+void CoalescedAttribute::Release()
+{
+    mValue.Free();
+    mState = State::kFree;
+}
+
+CoalescingAttributePersistenceProvider::~CoalescingAttributePersistenceProvider()
+{
+    DeviceLayer::SystemLayer().CancelTimer(HandleFlushTimer, this);
+}
+
+CHIP_ERROR CoalescingAttributePersistenceProvider::WriteValue(const ConcreteAttributePath & aPath, const ByteSpan & aValue)
+{
+    const System::Clock::Timestamp now = System::SystemClock().GetMonotonicTimestamp();
+    mMetrics.writesRequested++;
+
+    CoalescedAttribute * slot = FindSlot(aPath);
+    if (slot != nullptr && slot->GetValue().data_equal(aValue))
+    {
+        if (slot->IsDirty())
+        {
+            // Same value as the pending one: just push the write back.
+            slot->mLastWrite = now;
+            mMetrics.writesCoalesced++;
+            FlushAndScheduleNext();
+        }
+        else
+        {
+            mMetrics.writesUnchanged++;
+        }
+        return CHIP_NO_ERROR;
+    }
+
+    if (slot == nullptr)
+    {
+        slot = AllocateSlot();
+        if (slot == nullptr)
+        {
+            mMetrics.writesPassedThrough++;
+            mMetrics.writesPersisted++;
+            return mPersister.WriteValue(aPath, aValue);
+        }
+        slot->mPath = aPath;
+    }
+
+    if (slot->IsDirty())
+    {
+        mMetrics.writesCoalesced++;
+        mDirtyBytes -= slot->GetValue().size();
+    }
+    else
+    {
+        slot->mDirtySince = now;
+    }
+
+    if (slot->SetValue(aValue) != CHIP_NO_ERROR)
+    {
+        // Could not cache the value, write it through rather than lose it.
+        slot->Release();
+        mMetrics.writesPassedThrough++;
+        mMetrics.writesPersisted++;
+        return mPersister.WriteValue(aPath, aValue);
+    }
+
+    slot->mState     = CoalescedAttribute::State::kDirty;
+    slot->mLastWrite = now;
+    mDirtyBytes += aValue.size();
+
+    if (mDirtyBytes > mConfig.maxDirtyBytes)
+    {
+        mMetrics.sizeFlushes++;
+        return FlushAll();
+    }
+
+    FlushAndScheduleNext();
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR CoalescingAttributePersistenceProvider::ReadValue(const ConcreteAttributePath & aPath,
+                                                              const EmberAfAttributeMetadata * aMetadata, MutableByteSpan & aValue)
+{
+    CoalescedAttribute * slot = FindSlot(aPath);
+    if (slot != nullptr)
+    {
+        // Hold cached values to the same checks as values read from storage.
+        ReturnErrorOnFailure(CopySpanToMutableSpan(slot->GetValue(), aValue));
+        return DefaultAttributePersistenceProvider::ValidateStoredValue(aMetadata->attributeType, aMetadata->size, aValue);
+    }
+
+    ReturnErrorOnFailure(mPersister.ReadValue(aPath, aMetadata, aValue));
+
+    // Remember the stored value, so that writing it back is free. Only use free
+    // slots for this: pending values must not be flushed early to make room.
+    for (CoalescedAttribute & candidate : mSlots)
+    {
+        if (candidate.IsFree())
+        {
+            if (candidate.SetValue(aValue) == CHIP_NO_ERROR)
+            {
+                candidate.mPath  = aPath;
+                candidate.mState = CoalescedAttribute::State::kClean;
+            }
+            break;
+        }
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR CoalescingAttributePersistenceProvider::Flush()
+{
+    DeviceLayer::SystemLayer().CancelTimer(HandleFlushTimer, this);
+
+    CHIP_ERROR err          = FlushAll();
+    CHIP_ERROR persisterErr = mPersister.Flush();
+    return (err != CHIP_NO_ERROR) ? err : persisterErr;
+}
+
+size_t CoalescingAttributePersistenceProvider::GetDirtyCount() const
+{
+    size_t count = 0;
+    for (const CoalescedAttribute & slot : mSlots)
+    {
+        count += slot.IsDirty() ? 1 : 0;
+    }
+    return count;
+}
+
+CoalescedAttribute * CoalescingAttributePersistenceProvider::FindSlot(const ConcreteAttributePath & path)
+{
+    for (CoalescedAttribute & slot : mSlots)
+    {
+        if (slot.Matches(path))
+        {
+            return &slot;
+        }
+    }
+    return nullptr;
+}
+
+CoalescedAttribute * CoalescingAttributePersistenceProvider::AllocateSlot()
+{
+    CoalescedAttribute * clean = nullptr;
+    for (CoalescedAttribute & slot : mSlots)
+    {
+        if (slot.IsFree())
+        {
+            return &slot;
+        }
+        if (clean == nullptr && !slot.IsDirty())
+        {
+            clean = &slot;
+        }
+    }
+
+    if (clean == nullptr)
+    {
+        // All slots hold pending values: write them out to make room.
+        mMetrics.sizeFlushes++;
+        (void) FlushAll();
+        clean = mSlots.empty() ? nullptr : &mSlots[0];
+    }
+
+    if (clean != nullptr)
+    {
+        clean->Release();
+    }
+    return clean;
+}
+
+System::Clock::Timestamp CoalescingAttributePersistenceProvider::GetFlushTime(const CoalescedAttribute & slot) const
+{
+    return std::min<System::Clock::Timestamp>(slot.mLastWrite + mConfig.writeDelay, slot.mDirtySince + mConfig.maxWriteDelay);
+}
+
+CHIP_ERROR CoalescingAttributePersistenceProvider::FlushSlot(CoalescedAttribute & slot)
+{
+    VerifyOrReturnError(slot.IsDirty(), CHIP_NO_ERROR);
+
+    mDirtyBytes -= slot.GetValue().size();
+    mMetrics.writesPersisted++;
+
+    CHIP_ERROR err = mPersister.WriteValue(slot.mPath, slot.GetValue());
+    if (err != CHIP_NO_ERROR)
+    {
+        // Do not keep a value that may not match storage.
+        ChipLogError(Zcl, "Failed to persist attribute " ChipLogFormatMEI "/" ChipLogFormatMEI " on endpoint %u: %" CHIP_ERROR_FORMAT,
+                     ChipLogValueMEI(slot.mPath.mClusterId), ChipLogValueMEI(slot.mPath.mAttributeId), slot.mPath.mEndpointId,
+                     err.Format());
+        mMetrics.writeFailures++;
+        slot.Release();
+        return err;
+    }
+
+    slot.mState = CoalescedAttribute::State::kClean;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR CoalescingAttributePersistenceProvider::FlushAll()
+{
+    CHIP_ERROR firstError = CHIP_NO_ERROR;
+    for (CoalescedAttribute & slot : mSlots)
+    {
+        CHIP_ERROR err = FlushSlot(slot);
+        firstError     = (firstError != CHIP_NO_ERROR) ? firstError : err;
+    }
+    return firstError;
+}
+
+void CoalescingAttributePersistenceProvider::FlushAndScheduleNext()
+{
+    const System::Clock::Timestamp now     = System::SystemClock().GetMonotonicTimestamp();
+    System::Clock::Timestamp nextFlushTime = System::Clock::Timestamp::max();
+
+    for (CoalescedAttribute & slot : mSlots)
+    {
+        if (!slot.IsDirty())
+        {
+            continue;
+        }
+
+        const System::Clock::Timestamp flushTime = GetFlushTime(slot);
+        if (flushTime <= now)
+        {
+            (void) FlushSlot(slot);
+        }
+        else
+        {
+            nextFlushTime = std::min(nextFlushTime, flushTime);
+        }
+    }
+
+    if (nextFlushTime != System::Clock::Timestamp::max())
+    {
+        CHIP_ERROR err = DeviceLayer::SystemLayer().StartTimer(nextFlushTime - now, HandleFlushTimer, this);
+        if (err != CHIP_NO_ERROR)
+        {
+            ChipLogError(Zcl, "Failed to schedule attribute flush: %" CHIP_ERROR_FORMAT, err.Format());
+        }
+    }
+    else
+    {
+        DeviceLayer::SystemLayer().CancelTimer(HandleFlushTimer, this);
+    }
+}
+
+void CoalescingAttributePersistenceProvider::HandleFlushTimer(System::Layer * layer, void * context)
+{
+    static_cast<CoalescingAttributePersistenceProvider *>(context)->FlushAndScheduleNext();
+}
+
+} // namespace app
+} // namespace chip
@@ -0,0 +1,152 @@
+/*
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#pragma once
+
+#include <app/util/persistence/AttributePersistenceProvider.h>
+#include <lib/support/ScopedBuffer.h>
+#include <lib/support/Span.h>
+#include <system/SystemClock.h>
+#include <system/SystemLayer.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace chip {
+namespace app {
+
+/**
+ * Cache slot of a CoalescingAttributePersistenceProvider. Each slot holds the
+ * latest value of one attribute, either waiting to be written (dirty) or known
+ * to match what is in storage (clean).
+ */
+class CoalescedAttribute
+{
+public:
+    bool IsFree() const { return mState == State::kFree; }
+    bool IsDirty() const { return mState == State::kDirty; }
+    bool Matches(const ConcreteAttributePath & path) const { return !IsFree() && mPath == path; }
+    ByteSpan GetValue() const { return ByteSpan(mValue.Get(), mValue.AllocatedSize()); }
+
+private:
+    friend class CoalescingAttributePersistenceProvider;
+
+    enum class State : uint8_t
+    {
+        kFree,
+        kClean,
+        kDirty,
+    };
+
+    CHIP_ERROR SetValue(const ByteSpan & value);
+    void Release();
+
+    ConcreteAttributePath mPath;
+    System::Clock::Timestamp mDirtySince; // Time of the first write not yet persisted.
+    System::Clock::Timestamp mLastWrite;  // Time of the latest write.
+    Platform::ScopedMemoryBufferWithSize<uint8_t> mValue;
+    State mState = State::kFree;
+};
+
+/**
+ * Decorator class for the AttributePersistenceProvider implementation that
+ * coalesces writes of all attributes.
+ *
+ * Written values are kept in a small write-behind cache and only passed to the
+ * decorated persister once the attribute has not changed for `writeDelay`, or
+ * has been pending for `maxWriteDelay`, whichever comes first. All pending
+ * values are written at once when they exceed `maxDirtyBytes` or when Flush()
+ * is called, e.g. on shutdown.
+ *
+ * Values are kept in the cache after they are written, so that writing the
+ * value an attribute already has in storage costs nothing. This assumes all
+ * writes of the attributes go through this provider.
+ *
+ * When no slot is available for a new attribute, the write goes straight to
+ * the decorated persister.
+ */
+class CoalescingAttributePersistenceProvider : public AttributePersistenceProvider
+{
+public:
+    struct Config
+    {
+        System::Clock::Milliseconds32 writeDelay    = System::Clock::Milliseconds32(1000);
+        System::Clock::Milliseconds32 maxWriteDelay = System::Clock::Milliseconds32(10000);
+        size_t maxDirtyBytes                        = 1024;
+    };
+
+    struct Metrics
+    {
+        uint32_t writesRequested     = 0; // WriteValue() calls.
+        uint32_t writesPersisted     = 0; // Writes passed to the decorated persister.
+        uint32_t writesCoalesced     = 0; // Pending values replaced before being written.
+        uint32_t writesUnchanged     = 0; // Writes of the value already in storage.
+        uint32_t writesPassedThrough = 0; // Writes made immediately for lack of a free slot.
+        uint32_t writeFailures       = 0; // Writes rejected by the decorated persister.
+        uint32_t sizeFlushes         = 0; // Flushes triggered by maxDirtyBytes or running out of slots.
+
+        uint32_t WritesAvoided() const { return writesCoalesced + writesUnchanged; }
+    };
+
+    CoalescingAttributePersistenceProvider(AttributePersistenceProvider & persister, const Span<CoalescedAttribute> & slots,
+                                           const Config & config) :
+        mPersister(persister),
+        mSlots(slots), mConfig(config)
+    {}
+
+    CoalescingAttributePersistenceProvider(AttributePersistenceProvider & persister, const Span<CoalescedAttribute> & slots) :
+        CoalescingAttributePersistenceProvider(persister, slots, Config())
+    {}
+
+    ~CoalescingAttributePersistenceProvider() override;
+
+    CHIP_ERROR WriteValue(const ConcreteAttributePath & aPath, const ByteSpan & aValue) override;
+    CHIP_ERROR ReadValue(const ConcreteAttributePath & aPath, const EmberAfAttributeMetadata * aMetadata,
+                         MutableByteSpan & aValue) override;
+    void StartClusterLoad(const ConcreteClusterPath & aPath) override { mPersister.StartClusterLoad(aPath); }
+    void EndClusterLoad(const ConcreteClusterPath & aPath) override { mPersister.EndClusterLoad(aPath); }
+
+    /**
+     * Write all pending values to the decorated persister now.
+     *
+     * @return the first error returned by the decorated persister, if any.
+     */
+    CHIP_ERROR Flush() override;
+
+    const Metrics & GetMetrics() const { return mMetrics; }
+    void ResetMetrics() { mMetrics = Metrics(); }
+
+    size_t GetDirtyCount() const;
+    size_t GetDirtyBytes() const { return mDirtyBytes; }
+
+private:
+    CoalescedAttribute * FindSlot(const ConcreteAttributePath & path);
+    CoalescedAttribute * AllocateSlot();
+    System::Clock::Timestamp GetFlushTime(const CoalescedAttribute & slot) const;
+
+    CHIP_ERROR FlushSlot(CoalescedAttribute & slot);
+    CHIP_ERROR FlushAll();
+    void FlushAndScheduleNext();
+    static void HandleFlushTimer(System::Layer * layer, void * context);
+
+    AttributePersistenceProvider & mPersister;
+    const Span<CoalescedAttribute> mSlots;
+    const Config mConfig;
+    size_t mDirtyBytes = 0;
+    Metrics mMetrics;
+};
+
+} // namespace app
+} // namespace chip
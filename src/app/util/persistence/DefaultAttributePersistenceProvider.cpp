@@ -27,6 +27,12 @@ CHIP_ERROR DefaultAttributePersistenceProvider::InternalReadValue(const StorageK
                                                                   size_t aExpectedSize, MutableByteSpan & aValue)
 {
     ReturnErrorOnFailure(StorageDelegateWrapper::ReadValue(aKey, aValue));
+    return ValidateStoredValue(aType, aExpectedSize, aValue);
+}
+
+CHIP_ERROR DefaultAttributePersistenceProvider::ValidateStoredValue(EmberAfAttributeType aType, size_t aExpectedSize,
+                                                                    const ByteSpan & aValue)
+{
     size_t size = aValue.size();
     if (emberAfIsStringAttributeType(aType))
     {
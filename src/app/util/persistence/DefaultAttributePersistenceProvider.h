@@ -43,6 +43,12 @@ public:
     CHIP_ERROR ReadValue(const ConcreteAttributePath & aPath, const EmberAfAttributeMetadata * aMetadata,
                          MutableByteSpan & aValue) override;
 
+    /**
+     * Check that a stored value is consistent with the type and size of the
+     * attribute it is read for.
+     */
+    static CHIP_ERROR ValidateStoredValue(EmberAfAttributeType aType, size_t aExpectedSize, const ByteSpan & aValue);
+
 private:
     CHIP_ERROR InternalReadValue(const StorageKeyName & aKey, EmberAfAttributeType aType, size_t aExpectedSize,
                                  MutableByteSpan & aValue);
@@ -63,6 +63,16 @@ CHIP_ERROR DeferredAttributePersistenceProvider::ReadValue(const ConcreteAttribu
     return mPersister.ReadValue(aPath, aMetadata, aValue);
 }
 
+CHIP_ERROR DeferredAttributePersistenceProvider::Flush()
+{
+    for (DeferredAttribute & da : mDeferredAttributes)
+    {
+        da.Flush(mPersister);
+    }
+
+    return mPersister.Flush();
+}
+
 void DeferredAttributePersistenceProvider::FlushAndScheduleNext()
 {
     const System::Clock::Timestamp now     = System::SystemClock().GetMonotonicTimestamp();
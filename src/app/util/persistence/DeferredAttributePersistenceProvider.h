@@ -70,6 +70,13 @@ public:
     CHIP_ERROR WriteValue(const ConcreteAttributePath & aPath, const ByteSpan & aValue) override;
     CHIP_ERROR ReadValue(const ConcreteAttributePath & aPath, const EmberAfAttributeMetadata * aMetadata,
                          MutableByteSpan & aValue) override;
+    void StartClusterLoad(const ConcreteClusterPath & aPath) override { mPersister.StartClusterLoad(aPath); }
+    void EndClusterLoad(const ConcreteClusterPath & aPath) override { mPersister.EndClusterLoad(aPath); }
+
+    /*
+     * Immediately write all the deferred attributes that have a pending value.
+     */
+    CHIP_ERROR Flush() override;
 
 private:
     void FlushAndScheduleNext();
@@ -0,0 +1,271 @@
+/*
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#include <app/util/persistence/PackedAttributePersistenceProvider.h>
+
+#include <lib/core/CHIPEncoding.h>
+#include <lib/support/BufferWriter.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/DefaultStorageKeyAllocator.h>
+#include <lib/support/SafeInt.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+#include <string.h>
+
+namespace chip {
+namespace app {
+
+static_assert(PackedAttributePersistenceProvider::kMaxRecordSize <= UINT16_MAX, "Records are read with a 16-bit size");
+
+CHIP_ERROR PackedAttributePersistenceProvider::Init(PersistentStorageDelegate * storage)
+{
+    ReturnErrorOnFailure(DefaultAttributePersistenceProvider::Init(storage));
+    mStorage     = storage;
+    mRecordValid = false;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR PackedAttributePersistenceProvider::WriteValue(const ConcreteAttributePath & aPath, const ByteSpan & aValue)
+{
+    ReturnErrorOnFailure(LoadRecord(ConcreteClusterPath(aPath.mEndpointId, aPath.mClusterId)));
+    if (mRecordReadOnly)
+    {
+        return DefaultAttributePersistenceProvider::WriteValue(aPath, aValue);
+    }
+
+    bool removed = RemoveEntry(aPath.mAttributeId);
+    if (AppendEntry(aPath.mAttributeId, aValue))
+    {
+        return SaveRecord();
+    }
+
+    // Too large for the record: keep the value under its own key, making sure
+    // a previous value in the record does not shadow it.
+    if (removed)
+    {
+        ReturnErrorOnFailure(SaveRecord());
+    }
+    return DefaultAttributePersistenceProvider::WriteValue(aPath, aValue);
+}
+
+CHIP_ERROR PackedAttributePersistenceProvider::ReadValue(const ConcreteAttributePath & aPath,
+                                                         const EmberAfAttributeMetadata * aMetadata, MutableByteSpan & aValue)
+{
+    const ConcreteClusterPath clusterPath(aPath.mEndpointId, aPath.mClusterId);
+
+    CHIP_ERROR err = LoadRecord(clusterPath);
+    if (err == CHIP_NO_ERROR)
+    {
+        size_t offset;
+        size_t size;
+        if (FindEntry(aPath.mAttributeId, offset, size))
+        {
+            ByteSpan value(&mRecord[offset], size);
+            ReturnErrorOnFailure(ValidateStoredValue(aMetadata->attributeType, aMetadata->size, value));
+            return CopySpanToMutableSpan(value, aValue);
+        }
+    }
+    else
+    {
+        ChipLogError(Zcl, "Failed to read attributes of cluster " ChipLogFormatMEI " on endpoint %u: %" CHIP_ERROR_FORMAT,
+                     ChipLogValueMEI(aPath.mClusterId), aPath.mEndpointId, err.Format());
+    }
+
+    // Not in the record: the value may have been stored under its own key.
+    ReturnErrorOnFailure(DefaultAttributePersistenceProvider::ReadValue(aPath, aMetadata, aValue));
+
+    if (mLoading && mLoadingPath == clusterPath && mRecordValid && !mRecordReadOnly && mRecordPath == clusterPath &&
+        mMigratedCount < kMaxMigratedAttributes && AppendEntry(aPath.mAttributeId, aValue))
+    {
+        // Saved with the record once the whole cluster is loaded.
+        mMigrated[mMigratedCount++] = aPath.mAttributeId;
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+void PackedAttributePersistenceProvider::StartClusterLoad(const ConcreteClusterPath & aPath)
+{
+    // The record itself is only read if the cluster has persisted attributes.
+    mLoadingPath   = aPath;
+    mLoading       = true;
+    mMigratedCount = 0;
+}
+
+void PackedAttributePersistenceProvider::EndClusterLoad(const ConcreteClusterPath & aPath)
+{
+    VerifyOrReturn(mLoading && mLoadingPath == aPath);
+    mLoading = false;
+
+    VerifyOrReturn(mMigratedCount > 0);
+    if (!mRecordValid || mRecordPath != aPath)
+    {
+        // The record was evicted while loading; migrated values are simply
+        // read from their own keys again next time.
+        return;
+    }
+
+    PersistentStorageBatch storageBatch(mStorage);
+    CHIP_ERROR err = SaveRecord();
+    for (size_t i = 0; (i < mMigratedCount) && (err == CHIP_NO_ERROR); i++)
+    {
+        err = mStorage->SyncDeleteKeyValue(
+            DefaultStorageKeyAllocator::AttributeValue(aPath.mEndpointId, aPath.mClusterId, mMigrated[i]).KeyName());
+    }
+    if (err == CHIP_NO_ERROR)
+    {
+        err = storageBatch.Commit();
+    }
+
+    if (err != CHIP_NO_ERROR)
+    {
+        // Storage may not match the record in memory any more.
+        mRecordValid = false;
+        ChipLogError(Zcl, "Failed to pack attributes of cluster " ChipLogFormatMEI " on endpoint %u: %" CHIP_ERROR_FORMAT,
+                     ChipLogValueMEI(aPath.mClusterId), aPath.mEndpointId, err.Format());
+        return;
+    }
+
+    ChipLogProgress(Zcl, "Packed %u attribute(s) of cluster " ChipLogFormatMEI " on endpoint %u",
+                    static_cast<unsigned>(mMigratedCount), ChipLogValueMEI(aPath.mClusterId), aPath.mEndpointId);
+}
+
+CHIP_ERROR PackedAttributePersistenceProvider::LoadRecord(const ConcreteClusterPath & aPath)
+{
+    VerifyOrReturnError(!mRecordValid || mRecordPath != aPath, CHIP_NO_ERROR);
+    VerifyOrReturnError(mStorage != nullptr, CHIP_ERROR_INCORRECT_STATE);
+
+    mRecordValid    = false;
+    mRecordReadOnly = false;
+
+    uint16_t size = static_cast<uint16_t>(sizeof(mRecord));
+    CHIP_ERROR err =
+        mStorage->SyncGetKeyValue(DefaultStorageKeyAllocator::AttributeValues(aPath.mEndpointId, aPath.mClusterId).KeyName(),
+                                  mRecord, size);
+    if (err == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND)
+    {
+        size = 0;
+    }
+    else if (err == CHIP_ERROR_BUFFER_TOO_SMALL || (err == CHIP_NO_ERROR && !IsValidRecord(size)))
+    {
+        // Probably written by a newer version, or with a larger maximum
+        // record size: leave it untouched, and use the keys of the
+        // attributes instead.
+        ChipLogError(Zcl, "Ignoring unusable attribute record of cluster " ChipLogFormatMEI " on endpoint %u",
+                     ChipLogValueMEI(aPath.mClusterId), aPath.mEndpointId);
+        size            = 0;
+        mRecordReadOnly = true;
+    }
+    else
+    {
+        ReturnErrorOnFailure(err);
+    }
+
+    mRecordPath  = aPath;
+    mRecordSize  = size;
+    mRecordValid = true;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR PackedAttributePersistenceProvider::SaveRecord()
+{
+    VerifyOrReturnError(mRecordValid && !mRecordReadOnly, CHIP_ERROR_INCORRECT_STATE);
+
+    const StorageKeyName key = DefaultStorageKeyAllocator::AttributeValues(mRecordPath.mEndpointId, mRecordPath.mClusterId);
+    CHIP_ERROR err           = (mRecordSize > sizeof(kRecordVersion))
+                  ? mStorage->SyncSetKeyValue(key.KeyName(), mRecord, static_cast<uint16_t>(mRecordSize))
+                  : mStorage->SyncDeleteKeyValue(key.KeyName());
+    if (err == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND)
+    {
+        err = CHIP_NO_ERROR;
+    }
+
+    if (err != CHIP_NO_ERROR)
+    {
+        // Storage may not match the record in memory any more.
+        mRecordValid = false;
+    }
+    return err;
+}
+
+bool PackedAttributePersistenceProvider::IsValidRecord(size_t size) const
+{
+    VerifyOrReturnValue(size >= sizeof(kRecordVersion) && mRecord[0] == kRecordVersion, false);
+
+    size_t offset = sizeof(kRecordVersion);
+    while (offset < size)
+    {
+        VerifyOrReturnValue(size - offset >= kEntryHeaderSize, false);
+        size_t valueSize = Encoding::LittleEndian::Get16(&mRecord[offset + sizeof(uint32_t)]);
+        offset += kEntryHeaderSize;
+        VerifyOrReturnValue(size - offset >= valueSize, false);
+        offset += valueSize;
+    }
+    return true;
+}
+
+bool PackedAttributePersistenceProvider::FindEntry(AttributeId aId, size_t & aOffset, size_t & aValueSize) const
+{
+    // Entries are only ever added to records checked by IsValidRecord().
+    size_t offset = sizeof(kRecordVersion);
+    while (offset < mRecordSize)
+    {
+        AttributeId id   = Encoding::LittleEndian::Get32(&mRecord[offset]);
+        size_t valueSize = Encoding::LittleEndian::Get16(&mRecord[offset + sizeof(uint32_t)]);
+        offset += kEntryHeaderSize;
+        if (id == aId)
+        {
+            aOffset    = offset;
+            aValueSize = valueSize;
+            return true;
+        }
+        offset += valueSize;
+    }
+    return false;
+}
+
+bool PackedAttributePersistenceProvider::RemoveEntry(AttributeId aId)
+{
+    size_t offset;
+    size_t valueSize;
+    VerifyOrReturnValue(FindEntry(aId, offset, valueSize), false);
+
+    const size_t entryStart = offset - kEntryHeaderSize;
+    const size_t entryEnd   = offset + valueSize;
+    memmove(&mRecord[entryStart], &mRecord[entryEnd], mRecordSize - entryEnd);
+    mRecordSize -= entryEnd - entryStart;
+    return true;
+}
+
+bool PackedAttributePersistenceProvider::AppendEntry(AttributeId aId, const ByteSpan & aValue)
+{
+    const size_t headerSize = (mRecordSize == 0) ? sizeof(kRecordVersion) : 0;
+    VerifyOrReturnValue(CanCastTo<uint16_t>(aValue.size()), false);
+    VerifyOrReturnValue(mRecordSize + headerSize + kEntryHeaderSize + aValue.size() <= sizeof(mRecord), false);
+
+    Encoding::LittleEndian::BufferWriter writer(&mRecord[mRecordSize], sizeof(mRecord) - mRecordSize);
+    if (headerSize != 0)
+    {
+        writer.Put8(kRecordVersion);
+    }
+    writer.Put32(aId).Put16(static_cast<uint16_t>(aValue.size())).Put(aValue.data(), aValue.size());
+    VerifyOrReturnValue(writer.Fit(), false);
+
+    mRecordSize += writer.Needed();
+    return true;
+}
+
+} // namespace app
+} // namespace chip
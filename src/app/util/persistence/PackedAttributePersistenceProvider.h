@@ -0,0 +1,102 @@
+/*
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#pragma once
+
+#include <app/util/persistence/DefaultAttributePersistenceProvider.h>
+#include <lib/core/CHIPConfig.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace chip {
+namespace app {
+
+/**
+ * AttributePersistenceProvider that stores all the persisted attribute values
+ * of a cluster instance in a single storage record, so that loading them on
+ * startup takes a single storage read per cluster instead of one per
+ * attribute.
+ *
+ * The record, stored under DefaultStorageKeyAllocator::AttributeValues(), is
+ *
+ *     version      : uint8 (kRecordVersion)
+ *     0..n entries : attribute id (uint32, little-endian)
+ *                    value length (uint16, little-endian)
+ *                    value
+ *
+ * Values stored by DefaultAttributePersistenceProvider under their own key are
+ * still read, and are moved into the record of their cluster when that
+ * cluster is loaded between StartClusterLoad() and EndClusterLoad().  Values
+ * that do not fit in a record of CHIP_CONFIG_PACKED_ATTRIBUTE_RECORD_MAX_SIZE
+ * bytes keep being stored under their own key.
+ *
+ * A record that cannot be used, because it was written by a newer version or
+ * with a larger CHIP_CONFIG_PACKED_ATTRIBUTE_RECORD_MAX_SIZE, is never
+ * rewritten, so that the values it holds are not lost: the attributes of its
+ * cluster are then read from and written to their own keys.
+ *
+ * The record of the last cluster accessed is kept in memory, which assumes
+ * all writes to the records go through this provider.
+ */
+class PackedAttributePersistenceProvider : public DefaultAttributePersistenceProvider
+{
+public:
+    static constexpr uint8_t kRecordVersion = 1;
+    static constexpr size_t kMaxRecordSize  = CHIP_CONFIG_PACKED_ATTRIBUTE_RECORD_MAX_SIZE;
+
+    PackedAttributePersistenceProvider() = default;
+
+    CHIP_ERROR Init(PersistentStorageDelegate * storage);
+
+    // AttributePersistenceProvider implementation.
+    CHIP_ERROR WriteValue(const ConcreteAttributePath & aPath, const ByteSpan & aValue) override;
+    CHIP_ERROR ReadValue(const ConcreteAttributePath & aPath, const EmberAfAttributeMetadata * aMetadata,
+                         MutableByteSpan & aValue) override;
+    void StartClusterLoad(const ConcreteClusterPath & aPath) override;
+    void EndClusterLoad(const ConcreteClusterPath & aPath) override;
+
+private:
+    static constexpr size_t kEntryHeaderSize       = sizeof(uint32_t) + sizeof(uint16_t);
+    static constexpr size_t kMaxMigratedAttributes = 16;
+
+    CHIP_ERROR LoadRecord(const ConcreteClusterPath & aPath);
+    CHIP_ERROR SaveRecord();
+    bool IsValidRecord(size_t size) const;
+    bool FindEntry(AttributeId aId, size_t & aOffset, size_t & aValueSize) const;
+    bool RemoveEntry(AttributeId aId);
+    bool AppendEntry(AttributeId aId, const ByteSpan & aValue);
+
+    PersistentStorageDelegate * mStorage = nullptr;
+
+    // Last record read or written.  A size of 0 means there is no record.
+    // A read-only record exists in storage but cannot be used, and holds no
+    // entries in memory.
+    ConcreteClusterPath mRecordPath;
+    bool mRecordValid    = false;
+    bool mRecordReadOnly = false;
+    size_t mRecordSize = 0;
+    uint8_t mRecord[kMaxRecordSize];
+
+    // Cluster being loaded, and the attributes read from their own key while
+    // loading it.
+    ConcreteClusterPath mLoadingPath;
+    bool mLoading = false;
+    AttributeId mMigrated[kMaxMigratedAttributes];
+    size_t mMigratedCount = 0;
+};
+
+} // namespace app
+} // namespace chip
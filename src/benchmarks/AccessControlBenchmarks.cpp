@@ -0,0 +1,126 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <pw_perf_test/perf_test.h>
+
+#include <access/AccessControl.h>
+#include <access/examples/ExampleAccessControlDelegate.h>
+#include <lib/support/CodeUtils.h>
+
+namespace {
+
+using namespace chip;
+using namespace chip::Access;
+
+using Entry  = AccessControl::Entry;
+using Target = Entry::Target;
+
+constexpr FabricIndex kFabricIndex = 1;
+constexpr NodeId kAdminNodeId      = 0x0123'4567'89ab'cdef;
+constexpr NodeId kOperatorNodeId   = 0x0123'4567'89ab'cdf0;
+constexpr NodeId kUnknownNodeId    = 0x0123'4567'89ab'cdf1;
+constexpr ClusterId kOnOffCluster  = 0x0006;
+constexpr ClusterId kLevelCluster  = 0x0008;
+constexpr ClusterId kColorCluster  = 0x0300;
+
+class NoDeviceTypeResolver : public AccessControl::DeviceTypeResolver
+{
+public:
+    bool IsDeviceTypeOnEndpoint(DeviceTypeId deviceType, EndpointId endpoint) override { return false; }
+};
+
+struct EntryData
+{
+    AuthMode authMode;
+    Privilege privilege;
+    NodeId subject;
+    Target target;
+};
+
+// A full fabric, with the entry granting the checked privilege last so that
+// every check walks the whole list.
+const EntryData kEntries[] = {
+    { AuthMode::kCase, Privilege::kAdminister, kAdminNodeId, {} },
+    { AuthMode::kCase, Privilege::kView, kUndefinedNodeId, { Target::kCluster, kColorCluster, 0, 0 } },
+    { AuthMode::kCase, Privilege::kManage, kAdminNodeId, { Target::kEndpoint, 0, 0, 0 } },
+    { AuthMode::kCase, Privilege::kOperate, kOperatorNodeId, { Target::kCluster | Target::kEndpoint, kOnOffCluster, 1, 0 } },
+};
+
+class AccessControlContext
+{
+public:
+    AccessControlContext()
+    {
+        VerifyOrDie(mAccessControl.Init(Examples::GetAccessControlDelegate(), mDeviceTypeResolver) == CHIP_NO_ERROR);
+
+        for (const auto & data : kEntries)
+        {
+            Entry entry;
+            VerifyOrDie(mAccessControl.PrepareEntry(entry) == CHIP_NO_ERROR);
+            VerifyOrDie(entry.SetAuthMode(data.authMode) == CHIP_NO_ERROR);
+            VerifyOrDie(entry.SetFabricIndex(kFabricIndex) == CHIP_NO_ERROR);
+            VerifyOrDie(entry.SetPrivilege(data.privilege) == CHIP_NO_ERROR);
+            if (data.subject != kUndefinedNodeId)
+            {
+                VerifyOrDie(entry.AddSubject(nullptr, data.subject) == CHIP_NO_ERROR);
+            }
+            if (data.target.flags != 0)
+            {
+                VerifyOrDie(entry.AddTarget(nullptr, data.target) == CHIP_NO_ERROR);
+            }
+            VerifyOrDie(mAccessControl.CreateEntry(nullptr, entry) == CHIP_NO_ERROR);
+        }
+    }
+
+    ~AccessControlContext() { mAccessControl.Finish(); }
+
+    CHIP_ERROR Check(NodeId subject, ClusterId cluster, Privilege privilege)
+    {
+        SubjectDescriptor subjectDescriptor;
+        subjectDescriptor.fabricIndex = kFabricIndex;
+        subjectDescriptor.authMode    = AuthMode::kCase;
+        subjectDescriptor.subject     = subject;
+
+        RequestPath requestPath;
+        requestPath.cluster     = cluster;
+        requestPath.endpoint    = 1;
+        requestPath.requestType = RequestType::kAttributeWriteRequest;
+        requestPath.entityId    = 0x0000;
+
+        return mAccessControl.Check(subjectDescriptor, requestPath, privilege);
+    }
+
+private:
+    NoDeviceTypeResolver mDeviceTypeResolver;
+    AccessControl mAccessControl;
+};
+
+void AccessControlCheck(pw::perf_test::State & state, NodeId subject, ClusterId cluster, bool expectAllowed)
+{
+    AccessControlContext context;
+
+    while (state.KeepRunning())
+    {
+        CHIP_ERROR err = context.Check(subject, cluster, Privilege::kOperate);
+        VerifyOrDie((err == CHIP_NO_ERROR) == expectAllowed);
+    }
+}
+
+PW_PERF_TEST(AccessControlCheckAllowed, AccessControlCheck, kOperatorNodeId, kOnOffCluster, true);
+PW_PERF_TEST(AccessControlCheckDenied, AccessControlCheck, kUnknownNodeId, kLevelCluster, false);
+
+} // namespace
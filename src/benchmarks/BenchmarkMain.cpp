@@ -0,0 +1,145 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ * @file
+ *  Entry point of the benchmark suite. Runs every registered pw_perf_test
+ *  case and writes the results as a single JSON document, so that runs of
+ *  different releases can be compared by scripts.
+ */
+
+#include <pw_perf_test/event_handler.h>
+#include <pw_perf_test/perf_test.h>
+
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+#include <stdio.h>
+#include <string.h>
+
+namespace {
+
+// Bump when the layout of the output changes.
+constexpr int kOutputFormatVersion = 1;
+
+/**
+ * Writes benchmark results as JSON:
+ *
+ *   {
+ *     "format_version": 1,
+ *     "default_iterations": 10,
+ *     "benchmarks": [
+ *       { "name": "TlvEncode", "samples": [ ... ], "mean": 1.0, "min": 1.0, "max": 1.0 },
+ *       ...
+ *     ]
+ *   }
+ *
+ * Durations are in the units of the pw_perf_test timer backend, i.e.
+ * nanoseconds on host builds.
+ */
+class JsonEventHandler : public pw::perf_test::EventHandler
+{
+public:
+    explicit JsonEventHandler(FILE * output) : mOutput(output) {}
+
+    void RunAllTestsStart(const pw::perf_test::TestRunInfo & info) override
+    {
+        fprintf(mOutput, "{\n  \"format_version\": %d,\n  \"default_iterations\": %d,\n  \"benchmarks\": [", kOutputFormatVersion,
+                static_cast<int>(info.default_iterations));
+        mTestCount = 0;
+    }
+
+    void RunAllTestsEnd() override
+    {
+        fprintf(mOutput, "%s]\n}\n", (mTestCount != 0) ? "\n  " : "");
+        fflush(mOutput);
+    }
+
+    void TestCaseStart(const pw::perf_test::TestCase & info) override
+    {
+        fprintf(mOutput, "%s\n    { \"name\": \"%s\", \"samples\": [", (mTestCount != 0) ? "," : "", info.name);
+        mTestCount++;
+        mSampleCount = 0;
+    }
+
+    void TestCaseIteration(const pw::perf_test::TestIteration & iteration) override
+    {
+        fprintf(mOutput, "%s%.0f", (mSampleCount != 0) ? ", " : "", static_cast<double>(iteration.result));
+        mSampleCount++;
+    }
+
+    void TestCaseMeasure(const pw::perf_test::TestMeasurement & measurement) override
+    {
+        fprintf(mOutput, "], \"mean\": %.1f, \"min\": %.0f, \"max\": %.0f", static_cast<double>(measurement.mean),
+                static_cast<double>(measurement.min), static_cast<double>(measurement.max));
+    }
+
+    void TestCaseEnd(const pw::perf_test::TestCase & info) override { fprintf(mOutput, " }"); }
+
+private:
+    FILE * mOutput;
+    unsigned mTestCount   = 0;
+    unsigned mSampleCount = 0;
+};
+
+void PrintUsage(const char * program)
+{
+    fprintf(stderr, "Usage: %s [--output <file>]\n", program);
+}
+
+} // namespace
+
+int main(int argc, char ** argv)
+{
+    FILE * output = stdout;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if ((strcmp(argv[i], "--output") == 0 || strcmp(argv[i], "-o") == 0) && i + 1 < argc)
+        {
+            output = fopen(argv[++i], "w");
+            if (output == nullptr)
+            {
+                fprintf(stderr, "Cannot open %s\n", argv[i]);
+                return 1;
+            }
+        }
+        else
+        {
+            PrintUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    VerifyOrDie(chip::Platform::MemoryInit() == CHIP_NO_ERROR);
+
+    // Progress logs from the code under test would dominate some of the
+    // measurements and interleave with the results on stdout.
+    chip::Logging::SetLogFilter(chip::Logging::kLogCategory_Error);
+
+    JsonEventHandler handler(output);
+    pw::perf_test::RunAllTests(handler);
+
+    chip::Platform::MemoryShutdown();
+
+    if (output != stdout)
+    {
+        fclose(output);
+    }
+    return 0;
+}
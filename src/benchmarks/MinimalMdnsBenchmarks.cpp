@@ -0,0 +1,156 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <pw_perf_test/perf_test.h>
+
+#include <inet/IPAddress.h>
+#include <lib/dnssd/minimal_mdns/Parser.h>
+#include <lib/dnssd/minimal_mdns/RecordData.h>
+#include <lib/dnssd/minimal_mdns/ResponseBuilder.h>
+#include <lib/dnssd/minimal_mdns/records/IP.h>
+#include <lib/dnssd/minimal_mdns/records/Ptr.h>
+#include <lib/dnssd/minimal_mdns/records/Srv.h>
+#include <lib/dnssd/minimal_mdns/records/Txt.h>
+#include <lib/support/CodeUtils.h>
+#include <system/SystemPacketBuffer.h>
+
+namespace {
+
+using namespace chip;
+using namespace mdns::Minimal;
+
+constexpr size_t kMaxServices = 4;
+
+const QNamePart kServiceName[]                  = { "_matter", "_tcp", "local" };
+const QNamePart kInstanceNames[kMaxServices][4] = {
+    { "87E1B004E235A130-8FC7772401CD0696", "_matter", "_tcp", "local" },
+    { "87E1B004E235A130-0000000000000002", "_matter", "_tcp", "local" },
+    { "87E1B004E235A130-0000000000000003", "_matter", "_tcp", "local" },
+    { "2906C908D115D362-8FC7772401CD0696", "_matter", "_tcp", "local" },
+};
+const QNamePart kHostNames[kMaxServices][2] = {
+    { "E45F010B1F7D0000", "local" },
+    { "E45F010B1F7D0001", "local" },
+    { "E45F010B1F7D0002", "local" },
+    { "E45F010B1F7D0003", "local" },
+};
+const char * kTxtEntries[] = { "SII=5000", "SAI=300", "SAT=4000", "T=1" };
+const char * kAddresses[]  = { "fd00::1", "fd00::2", "fd00::3", "fd00::4" };
+
+// Decodes every record of interest to operational discovery, like the
+// resolver does.
+class RecordDecoder : public ParserDelegate, public TxtRecordDelegate
+{
+public:
+    explicit RecordDecoder(const BytesRange & packet) : mPacket(packet) {}
+
+    void OnHeader(ConstHeaderRef & header) override {}
+    void OnQuery(const QueryData & data) override {}
+    void OnResource(ResourceType type, const ResourceData & data) override
+    {
+        SerializedQNameIterator name = data.GetName();
+        WalkName(name);
+
+        switch (data.GetType())
+        {
+        case QType::PTR: {
+            SerializedQNameIterator ptr;
+            VerifyOrDie(ParsePtrRecord(data.GetData(), mPacket, &ptr));
+            WalkName(ptr);
+            break;
+        }
+        case QType::SRV: {
+            SrvRecord srv;
+            VerifyOrDie(srv.Parse(data.GetData(), mPacket));
+            SerializedQNameIterator target = srv.GetName();
+            WalkName(target);
+            break;
+        }
+        case QType::TXT:
+            VerifyOrDie(ParseTxtRecord(data.GetData(), this));
+            break;
+        case QType::AAAA: {
+            Inet::IPAddress address;
+            VerifyOrDie(ParseAAAARecord(data.GetData(), &address));
+            break;
+        }
+        default:
+            break;
+        }
+        mRecordCount++;
+    }
+
+    void OnRecord(const BytesRange & name, const BytesRange & value) override {}
+
+    size_t GetRecordCount() const { return mRecordCount; }
+
+private:
+    static void WalkName(SerializedQNameIterator & name)
+    {
+        while (name.Next())
+        {
+        }
+        VerifyOrDie(name.IsValid());
+    }
+
+    BytesRange mPacket;
+    size_t mRecordCount = 0;
+};
+
+System::PacketBufferHandle BuildResponse(size_t serviceCount)
+{
+    ResponseBuilder builder(System::PacketBufferHandle::New(System::PacketBuffer::kMaxSize));
+
+    // Records have to be grouped by section: answers first.
+    for (size_t i = 0; i < serviceCount; i++)
+    {
+        builder.AddRecord(ResourceType::kAnswer, PtrResourceRecord(FullQName(kServiceName), FullQName(kInstanceNames[i])));
+    }
+    for (size_t i = 0; i < serviceCount; i++)
+    {
+        Inet::IPAddress address;
+        VerifyOrDie(Inet::IPAddress::FromString(kAddresses[i], address));
+
+        FullQName instanceName(kInstanceNames[i]);
+        FullQName hostName(kHostNames[i]);
+
+        builder.AddRecord(ResourceType::kAdditional, SrvResourceRecord(instanceName, hostName, CHIP_PORT))
+            .AddRecord(ResourceType::kAdditional, TxtResourceRecord(instanceName, kTxtEntries))
+            .AddRecord(ResourceType::kAdditional, IPResourceRecord(hostName, address));
+    }
+    VerifyOrDie(builder.Ok());
+
+    return builder.ReleasePacket();
+}
+
+void MdnsParseResponse(pw::perf_test::State & state, size_t serviceCount)
+{
+    System::PacketBufferHandle packet = BuildResponse(serviceCount);
+    BytesRange packetRange(packet->Start(), packet->Start() + packet->DataLength());
+
+    while (state.KeepRunning())
+    {
+        RecordDecoder decoder(packetRange);
+        VerifyOrDie(ParsePacket(packetRange, &decoder));
+        VerifyOrDie(decoder.GetRecordCount() == serviceCount * 4);
+    }
+}
+
+PW_PERF_TEST(MdnsParseSingleService, MdnsParseResponse, 1);
+PW_PERF_TEST(MdnsParseManyServices, MdnsParseResponse, kMaxServices);
+
+} // namespace
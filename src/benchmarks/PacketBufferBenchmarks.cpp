@@ -0,0 +1,81 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <pw_perf_test/perf_test.h>
+
+#include <lib/support/CodeUtils.h>
+#include <system/SystemPacketBuffer.h>
+
+namespace {
+
+using namespace chip;
+using System::PacketBuffer;
+using System::PacketBufferHandle;
+
+void PacketBufferAllocate(pw::perf_test::State & state, size_t size)
+{
+    while (state.KeepRunning())
+    {
+        PacketBufferHandle buffer = PacketBufferHandle::New(size);
+        VerifyOrDie(!buffer.IsNull());
+    }
+}
+
+void PacketBufferAllocateWithData(pw::perf_test::State & state, size_t size)
+{
+    uint8_t data[PacketBuffer::kMaxSize];
+    VerifyOrDie(size <= sizeof(data));
+    for (size_t i = 0; i < size; i++)
+    {
+        data[i] = static_cast<uint8_t>(i);
+    }
+
+    while (state.KeepRunning())
+    {
+        PacketBufferHandle buffer = PacketBufferHandle::NewWithData(data, size);
+        VerifyOrDie(!buffer.IsNull());
+    }
+}
+
+// Allocates several buffers before releasing any, as happens when messages
+// are queued for retransmission.
+void PacketBufferAllocateBurst(pw::perf_test::State & state, size_t count)
+{
+    constexpr size_t kMaxCount = 8;
+    VerifyOrDie(count <= kMaxCount);
+
+    PacketBufferHandle buffers[kMaxCount];
+    while (state.KeepRunning())
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            buffers[i] = PacketBufferHandle::New(PacketBuffer::kMaxSize);
+            VerifyOrDie(!buffers[i].IsNull());
+        }
+        for (size_t i = 0; i < count; i++)
+        {
+            buffers[i] = nullptr;
+        }
+    }
+}
+
+PW_PERF_TEST(PacketBufferAllocateSmall, PacketBufferAllocate, 64);
+PW_PERF_TEST(PacketBufferAllocateMax, PacketBufferAllocate, PacketBuffer::kMaxSize);
+PW_PERF_TEST(PacketBufferAllocateWithDataMax, PacketBufferAllocateWithData, PacketBuffer::kMaxSize);
+PW_PERF_TEST(PacketBufferAllocateBurstOfFour, PacketBufferAllocateBurst, 4);
+
+} // namespace
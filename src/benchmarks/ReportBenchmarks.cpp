@@ -0,0 +1,100 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ * @file
+ *  Benchmarks the construction of ReportData messages. The messages are built
+ *  the way the reporting engine builds them (packet buffer backed writer,
+ *  space reserved for the MIC, one AttributeReportIB per attribute), without
+ *  the data model and exchange layers, whose cost depends on the application.
+ */
+
+#include <pw_perf_test/perf_test.h>
+
+#include <app/MessageDef/ReportDataMessage.h>
+#include <crypto/CHIPCryptoPAL.h>
+#include <lib/support/CodeUtils.h>
+#include <system/SystemPacketBuffer.h>
+#include <system/TLVPacketBufferBackingStore.h>
+
+namespace {
+
+using namespace chip;
+using namespace chip::app;
+
+constexpr EndpointId kEndpointId         = 1;
+constexpr ClusterId kClusterId           = 0x0008; // Level Control
+constexpr DataVersion kDataVersion       = 0x5a5a5a5a;
+constexpr SubscriptionId kSubscriptionId = 0x12345678;
+
+CHIP_ERROR EncodeAttribute(AttributeReportIBs::Builder & attributeReportIBs, AttributeId attributeId)
+{
+    AttributeReportIB::Builder & attributeReport = attributeReportIBs.CreateAttributeReport();
+    ReturnErrorOnFailure(attributeReportIBs.GetError());
+
+    AttributeDataIB::Builder & attributeData = attributeReport.CreateAttributeData();
+    ReturnErrorOnFailure(attributeReport.GetError());
+
+    attributeData.DataVersion(kDataVersion);
+    ReturnErrorOnFailure(attributeData.CreatePath()
+                             .Endpoint(kEndpointId)
+                             .Cluster(kClusterId)
+                             .Attribute(attributeId)
+                             .EndOfAttributePathIB());
+    ReturnErrorOnFailure(attributeData.GetWriter()->Put(TLV::ContextTag(to_underlying(AttributeDataIB::Tag::kData)),
+                                                        static_cast<uint16_t>(attributeId * 3 + 1)));
+    ReturnErrorOnFailure(attributeData.EndOfAttributeDataIB());
+    return attributeReport.EndOfAttributeReportIB();
+}
+
+CHIP_ERROR BuildReport(uint16_t attributeCount)
+{
+    System::PacketBufferHandle buffer = System::PacketBufferHandle::New(System::PacketBuffer::kMaxSize);
+    VerifyOrReturnError(!buffer.IsNull(), CHIP_ERROR_NO_MEMORY);
+
+    System::PacketBufferTLVWriter writer;
+    writer.Init(std::move(buffer));
+    ReturnErrorOnFailure(writer.ReserveBuffer(Crypto::CHIP_CRYPTO_AEAD_MIC_LENGTH_BYTES));
+
+    ReportDataMessage::Builder reportData;
+    ReturnErrorOnFailure(reportData.Init(&writer));
+    reportData.SubscriptionId(kSubscriptionId);
+
+    AttributeReportIBs::Builder & attributeReportIBs = reportData.CreateAttributeReportIBs();
+    ReturnErrorOnFailure(reportData.GetError());
+    for (uint16_t i = 0; i < attributeCount; i++)
+    {
+        ReturnErrorOnFailure(EncodeAttribute(attributeReportIBs, i));
+    }
+    ReturnErrorOnFailure(attributeReportIBs.EndOfAttributeReportIBs());
+
+    ReturnErrorOnFailure(reportData.EndOfReportDataMessage());
+    return writer.Finalize(&buffer);
+}
+
+void ReportBuild(pw::perf_test::State & state, uint16_t attributeCount)
+{
+    while (state.KeepRunning())
+    {
+        VerifyOrDie(BuildReport(attributeCount) == CHIP_NO_ERROR);
+    }
+}
+
+PW_PERF_TEST(ReportBuildSingleAttribute, ReportBuild, 1);
+PW_PERF_TEST(ReportBuildManyAttributes, ReportBuild, 32);
+
+} // namespace
@@ -0,0 +1,151 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <pw_perf_test/perf_test.h>
+
+#include <crypto/DefaultSessionKeystore.h>
+#include <lib/support/CodeUtils.h>
+#include <protocols/Protocols.h>
+#include <system/SystemPacketBuffer.h>
+#include <transport/CryptoContext.h>
+#include <transport/SecureMessageCodec.h>
+#include <transport/raw/MessageHeader.h>
+
+#include <string.h>
+
+namespace {
+
+using namespace chip;
+using System::PacketBufferHandle;
+
+constexpr uint16_t kSessionId      = 0x1234;
+constexpr uint32_t kMessageCounter = 0x00abcdef;
+constexpr NodeId kSourceNodeId     = 0x0000'0000'0001'b669;
+constexpr size_t kMaxPayloadLength = 1024;
+constexpr size_t kMaxMessageLength = kMaxPayloadLength + 32; // Room for the payload header and the MIC.
+
+// Fixed key material, so that every run encrypts the same bytes.
+constexpr uint8_t kSharedSecret[32] = { 0x8b, 0x30, 0x4d, 0x17, 0x9c, 0x62, 0x1e, 0xa4, 0x55, 0x0f, 0xd3,
+                                        0x7e, 0x21, 0xb8, 0x46, 0xc9, 0x3a, 0x94, 0x6d, 0x02, 0xf7, 0x58,
+                                        0xe1, 0x8a, 0x13, 0xbc, 0x67, 0x29, 0xd0, 0x4f, 0x85, 0x3e };
+constexpr uint8_t kSalt[16]         = { 0x53, 0x50, 0x41, 0x4b, 0x45, 0x32, 0x50, 0x20,
+                                        0x4b, 0x65, 0x79, 0x20, 0x53, 0x61, 0x6c, 0x74 };
+
+class CodecContext
+{
+public:
+    explicit CodecContext(size_t payloadLength) : mPayloadLength(payloadLength)
+    {
+        VerifyOrDie(payloadLength <= kMaxPayloadLength);
+        for (size_t i = 0; i < payloadLength; i++)
+        {
+            mPayload[i] = static_cast<uint8_t>(i * 7);
+        }
+
+        // Both ends derive the same keys, with swapped directions.
+        VerifyOrDie(mInitiator.InitFromSecret(mKeystore, ByteSpan(kSharedSecret), ByteSpan(kSalt),
+                                              CryptoContext::SessionInfoType::kSessionEstablishment,
+                                              CryptoContext::SessionRole::kInitiator) == CHIP_NO_ERROR);
+        VerifyOrDie(mResponder.InitFromSecret(mKeystore, ByteSpan(kSharedSecret), ByteSpan(kSalt),
+                                              CryptoContext::SessionInfoType::kSessionEstablishment,
+                                              CryptoContext::SessionRole::kResponder) == CHIP_NO_ERROR);
+
+        mPacketHeader.SetMessageCounter(kMessageCounter)
+            .SetSessionId(kSessionId)
+            .SetSessionType(Header::SessionType::kUnicastSession);
+        VerifyOrDie(CryptoContext::BuildNonce(mNonce, mPacketHeader.GetSecurityFlags(), kMessageCounter, kSourceNodeId) ==
+                    CHIP_NO_ERROR);
+
+        mBuffer = PacketBufferHandle::New(kMaxMessageLength);
+        VerifyOrDie(!mBuffer.IsNull());
+        mBufferStart = mBuffer->Start();
+    }
+
+    // Restore the buffer to hold @p length bytes of @p data, without
+    // reallocating it, so that only the codec is measured.
+    void Load(const uint8_t * data, size_t length)
+    {
+        mBuffer->SetStart(mBufferStart);
+        memcpy(mBuffer->Start(), data, length);
+        mBuffer->SetDataLength(length);
+    }
+
+    void LoadPayload() { Load(mPayload, mPayloadLength); }
+
+    CHIP_ERROR Encrypt()
+    {
+        PayloadHeader payloadHeader;
+        payloadHeader.SetMessageType(Protocols::InteractionModel::Id, 0x05).SetExchangeID(0x4321).SetInitiator(true);
+        return SecureMessageCodec::Encrypt(mInitiator, mNonce, payloadHeader, mPacketHeader, mBuffer);
+    }
+
+    CHIP_ERROR Decrypt()
+    {
+        PayloadHeader payloadHeader;
+        return SecureMessageCodec::Decrypt(mResponder, mNonce, payloadHeader, mPacketHeader, mBuffer);
+    }
+
+    PacketBufferHandle & Buffer() { return mBuffer; }
+
+private:
+    Crypto::DefaultSessionKeystore mKeystore;
+    CryptoContext mInitiator;
+    CryptoContext mResponder;
+    PacketHeader mPacketHeader;
+    CryptoContext::NonceStorage mNonce;
+    PacketBufferHandle mBuffer;
+    uint8_t * mBufferStart = nullptr;
+    uint8_t mPayload[kMaxPayloadLength];
+    size_t mPayloadLength;
+};
+
+void MessageEncrypt(pw::perf_test::State & state, size_t payloadLength)
+{
+    CodecContext context(payloadLength);
+
+    while (state.KeepRunning())
+    {
+        context.LoadPayload();
+        VerifyOrDie(context.Encrypt() == CHIP_NO_ERROR);
+    }
+}
+
+void MessageDecrypt(pw::perf_test::State & state, size_t payloadLength)
+{
+    CodecContext context(payloadLength);
+
+    context.LoadPayload();
+    VerifyOrDie(context.Encrypt() == CHIP_NO_ERROR);
+
+    size_t encryptedLength = context.Buffer()->DataLength();
+    uint8_t encrypted[kMaxMessageLength];
+    VerifyOrDie(encryptedLength <= sizeof(encrypted));
+    memcpy(encrypted, context.Buffer()->Start(), encryptedLength);
+
+    while (state.KeepRunning())
+    {
+        context.Load(encrypted, encryptedLength);
+        VerifyOrDie(context.Decrypt() == CHIP_NO_ERROR);
+    }
+}
+
+PW_PERF_TEST(MessageEncryptSmall, MessageEncrypt, 64);
+PW_PERF_TEST(MessageEncryptLarge, MessageEncrypt, kMaxPayloadLength);
+PW_PERF_TEST(MessageDecryptSmall, MessageDecrypt, 64);
+PW_PERF_TEST(MessageDecryptLarge, MessageDecrypt, kMaxPayloadLength);
+
+} // namespace
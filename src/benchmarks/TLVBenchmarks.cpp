@@ -0,0 +1,148 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <pw_perf_test/perf_test.h>
+
+#include <lib/core/TLVReader.h>
+#include <lib/core/TLVWriter.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/Span.h>
+
+namespace {
+
+using namespace chip;
+using namespace chip::TLV;
+
+constexpr size_t kBufferSize = 1024;
+
+// A structure shaped like a typical cluster attribute value: scalar fields,
+// strings, a list and a nested structure.
+CHIP_ERROR EncodeSample(TLVWriter & writer, uint8_t listLength)
+{
+    static const uint8_t kOctets[32] = { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a,
+                                         0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15,
+                                         0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f };
+
+    TLVType outer;
+    ReturnErrorOnFailure(writer.StartContainer(AnonymousTag(), kTLVType_Structure, outer));
+    ReturnErrorOnFailure(writer.Put(ContextTag(0), static_cast<uint8_t>(1)));
+    ReturnErrorOnFailure(writer.Put(ContextTag(1), static_cast<uint16_t>(0x1234)));
+    ReturnErrorOnFailure(writer.Put(ContextTag(2), static_cast<uint32_t>(0x12345678)));
+    ReturnErrorOnFailure(writer.Put(ContextTag(3), static_cast<uint64_t>(0x123456789abcdef0)));
+    ReturnErrorOnFailure(writer.Put(ContextTag(4), static_cast<int32_t>(-2000)));
+    ReturnErrorOnFailure(writer.PutBoolean(ContextTag(5), true));
+    ReturnErrorOnFailure(writer.PutString(ContextTag(6), "Living Room Light"_span));
+    ReturnErrorOnFailure(writer.Put(ContextTag(7), ByteSpan(kOctets)));
+
+    TLVType list;
+    ReturnErrorOnFailure(writer.StartContainer(ContextTag(8), kTLVType_Array, list));
+    for (uint8_t i = 0; i < listLength; i++)
+    {
+        TLVType entry;
+        ReturnErrorOnFailure(writer.StartContainer(AnonymousTag(), kTLVType_Structure, entry));
+        ReturnErrorOnFailure(writer.Put(ContextTag(0), static_cast<uint16_t>(0x0100 + i)));
+        ReturnErrorOnFailure(writer.Put(ContextTag(1), static_cast<uint8_t>(i)));
+        ReturnErrorOnFailure(writer.EndContainer(entry));
+    }
+    ReturnErrorOnFailure(writer.EndContainer(list));
+
+    ReturnErrorOnFailure(writer.EndContainer(outer));
+    return writer.Finalize();
+}
+
+// Reads every element of the container the reader is positioned in.
+CHIP_ERROR DecodeElements(TLVReader & reader)
+{
+    CHIP_ERROR err;
+    while ((err = reader.Next()) == CHIP_NO_ERROR)
+    {
+        switch (reader.GetType())
+        {
+        case kTLVType_Structure:
+        case kTLVType_Array:
+        case kTLVType_List: {
+            TLVType container;
+            ReturnErrorOnFailure(reader.EnterContainer(container));
+            ReturnErrorOnFailure(DecodeElements(reader));
+            ReturnErrorOnFailure(reader.ExitContainer(container));
+            break;
+        }
+        case kTLVType_UnsignedInteger: {
+            uint64_t value;
+            ReturnErrorOnFailure(reader.Get(value));
+            break;
+        }
+        case kTLVType_SignedInteger: {
+            int64_t value;
+            ReturnErrorOnFailure(reader.Get(value));
+            break;
+        }
+        case kTLVType_Boolean: {
+            bool value;
+            ReturnErrorOnFailure(reader.Get(value));
+            break;
+        }
+        case kTLVType_UTF8String: {
+            CharSpan value;
+            ReturnErrorOnFailure(reader.Get(value));
+            break;
+        }
+        case kTLVType_ByteString: {
+            ByteSpan value;
+            ReturnErrorOnFailure(reader.Get(value));
+            break;
+        }
+        default:
+            break;
+        }
+    }
+    return (err == CHIP_END_OF_TLV) ? CHIP_NO_ERROR : err;
+}
+
+void TlvEncode(pw::perf_test::State & state, uint8_t listLength)
+{
+    uint8_t buffer[kBufferSize];
+    TLVWriter writer;
+
+    while (state.KeepRunning())
+    {
+        writer.Init(buffer);
+        VerifyOrDie(EncodeSample(writer, listLength) == CHIP_NO_ERROR);
+    }
+}
+
+void TlvDecode(pw::perf_test::State & state, uint8_t listLength)
+{
+    uint8_t buffer[kBufferSize];
+    TLVWriter writer;
+    writer.Init(buffer);
+    VerifyOrDie(EncodeSample(writer, listLength) == CHIP_NO_ERROR);
+
+    TLVReader reader;
+    while (state.KeepRunning())
+    {
+        reader.Init(buffer, writer.GetLengthWritten());
+        VerifyOrDie(DecodeElements(reader) == CHIP_NO_ERROR);
+    }
+}
+
+PW_PERF_TEST(TlvEncodeSmall, TlvEncode, 1);
+PW_PERF_TEST(TlvEncodeLarge, TlvEncode, 32);
+PW_PERF_TEST(TlvDecodeSmall, TlvDecode, 1);
+PW_PERF_TEST(TlvDecodeLarge, TlvDecode, 32);
+
+} // namespace
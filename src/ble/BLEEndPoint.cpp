@@ -92,6 +92,14 @@
 namespace chip {
 namespace Ble {
 
+namespace {
+
+// Smallest receive window for which the race condition avoidance logic in DriveSending() cannot wedge the connection;
+// see BLE_MAX_RECEIVE_WINDOW_SIZE.
+constexpr uint8_t kMinReceiveWindowSize = 3;
+
+} // namespace
+
 CHIP_ERROR BLEEndPoint::StartConnect()
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
@@ -114,7 +122,7 @@ CHIP_ERROR BLEEndPoint::StartConnect()
 
     req.mMtu = mBle->mPlatformDelegate->GetMTU(mConnObj);
 
-    req.mWindowSize = BLE_MAX_RECEIVE_WINDOW_SIZE;
+    req.mWindowSize = GetLocalMaxReceiveWindowSize();
 
     // Populate request with highest supported protocol versions
     for (uint8_t i = 0; i < numVersions; i++)
@@ -531,6 +539,8 @@ CHIP_ERROR BLEEndPoint::Init(BleLayer * bleLayer, BLE_CONNECTION_OBJECT connObj,
     mLocalReceiveWindowSize  = 0;
     mRemoteReceiveWindowSize = 0;
     mReceiveWindowMaxSize    = 0;
+    mPendingSends            = 0;
+    mMaxPendingSends         = 1;
     mSendQueue               = nullptr;
     mAckToSend               = nullptr;
 
@@ -643,8 +653,9 @@ exit:
 
 bool BLEEndPoint::PrepareNextFragment(PacketBufferHandle && data, bool & sentAck)
 {
-    // If we have a pending fragment acknowledgement to send, piggyback it on the fragment we're about to transmit.
-    if (mTimerStateFlags.Has(TimerStateFlag::kSendAckTimerRunning))
+    // If we have a pending fragment acknowledgement to send, piggyback it on the fragment we're about to transmit. This
+    // includes a stand-alone ack that was queued but not yet sent, which is coalesced into the fragment instead.
+    if (mTimerStateFlags.Has(TimerStateFlag::kSendAckTimerRunning) || (!mAckToSend.IsNull() && mBtpEngine.HasUnackedData()))
     {
         // Reset local receive window counter.
         mLocalReceiveWindowSize = mReceiveWindowMaxSize;
@@ -690,8 +701,9 @@ CHIP_ERROR BLEEndPoint::SendNextMessage()
 
     if (sentAck)
     {
-        // If sent piggybacked ack, stop send-ack timer.
+        // If sent piggybacked ack, stop send-ack timer and drop any stand-alone ack it replaced.
         StopSendAckTimer();
+        mAckToSend = nullptr;
     }
 
     // Start ack received timer, if it's not already running.
@@ -715,8 +727,9 @@ CHIP_ERROR BLEEndPoint::ContinueMessageSend()
 
     if (sentAck)
     {
-        // If sent piggybacked ack, stop send-ack timer.
+        // If sent piggybacked ack, stop send-ack timer and drop any stand-alone ack it replaced.
         StopSendAckTimer();
+        mAckToSend = nullptr;
     }
 
     // Start ack received timer, if it's not already running.
@@ -841,17 +854,22 @@ CHIP_ERROR BLEEndPoint::HandleGattSendConfirmationReceived()
 {
     ChipLogDebugBleEndPoint(Ble, "entered HandleGattSendConfirmationReceived");
 
-    // Mark outstanding GATT operation as finished.
-    mConnStateFlags.Clear(ConnectionStateFlag::kGattOperationInFlight);
-
     // If confirmation was for outbound portion of BTP connect handshake...
     if (!mConnStateFlags.Has(ConnectionStateFlag::kCapabilitiesConfReceived))
     {
+        // Mark outstanding GATT operation as finished.
+        mConnStateFlags.Clear(ConnectionStateFlag::kGattOperationInFlight);
         mConnStateFlags.Set(ConnectionStateFlag::kCapabilitiesConfReceived);
 
         return HandleHandshakeConfirmationReceived();
     }
 
+    // Confirmations arrive in send order, so this one is for the oldest pending fragment or stand-alone ack.
+    if (mPendingSends > 0)
+    {
+        mPendingSends--;
+    }
+
     return HandleFragmentConfirmationReceived();
 }
 
@@ -893,11 +911,29 @@ CHIP_ERROR BLEEndPoint::DriveSending()
 {
     ChipLogDebugBleEndPoint(Ble, "entered DriveSending");
 
+    // Each pass sends at most one fragment or stand-alone ack. Keep going while the platform accepts more pending sends,
+    // so that fragments are pipelined up to the negotiated receive window.
+    bool didSend;
+
+    do
+    {
+        ReturnErrorOnFailure(DriveSendingOnce(didSend));
+    } while (didSend);
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR BLEEndPoint::DriveSendingOnce(bool & didSend)
+{
+    didSend = false;
+
     // If receiver's window is almost closed and we don't have an ack to send, OR we do have an ack to send but
-    // receiver's window is completely empty, OR another GATT operation is in flight, awaiting confirmation...
+    // receiver's window is completely empty, OR a handshake or stand-alone ack GATT operation is in flight, OR the
+    // platform can't accept any more pending sends, awaiting GATT confirmation...
     if ((mRemoteReceiveWindowSize <= BTP_WINDOW_NO_ACK_SEND_THRESHOLD &&
          !mTimerStateFlags.Has(TimerStateFlag::kSendAckTimerRunning) && mAckToSend.IsNull()) ||
-        (mRemoteReceiveWindowSize == 0) || (mConnStateFlags.Has(ConnectionStateFlag::kGattOperationInFlight)))
+        (mRemoteReceiveWindowSize == 0) || (mConnStateFlags.Has(ConnectionStateFlag::kGattOperationInFlight)) ||
+        (mConnStateFlags.Has(ConnectionStateFlag::kStandAloneAckInFlight)) || (mPendingSends >= mMaxPendingSends))
     {
 #ifdef CHIP_BLE_END_POINT_DEBUG_LOGGING_ENABLED
         if (mRemoteReceiveWindowSize <= BTP_WINDOW_NO_ACK_SEND_THRESHOLD &&
@@ -911,10 +947,16 @@ CHIP_ERROR BLEEndPoint::DriveSending()
             ChipLogDebugBleEndPoint(Ble, "NO SEND: remote receive window closed");
         }
 
-        if (mConnStateFlags.Has(ConnectionStateFlag::kGattOperationInFlight))
+        if (mConnStateFlags.Has(ConnectionStateFlag::kGattOperationInFlight) ||
+            mConnStateFlags.Has(ConnectionStateFlag::kStandAloneAckInFlight))
         {
             ChipLogDebugBleEndPoint(Ble, "NO SEND: Gatt op in flight");
         }
+
+        if (mPendingSends >= mMaxPendingSends)
+        {
+            ChipLogDebugBleEndPoint(Ble, "NO SEND: %u sends pending", mPendingSends);
+        }
 #endif
 
         // Can't send anything.
@@ -923,9 +965,15 @@ CHIP_ERROR BLEEndPoint::DriveSending()
 
     // Otherwise, let's see what we can send.
 
-    if (!mAckToSend.IsNull()) // If immediate, stand-alone ack is pending, send it.
+    // A pending stand-alone ack is coalesced into the next message fragment, if there is one. Otherwise it is sent
+    // once all pipelined sends have been confirmed, so that its GATT confirmation can't be mistaken for another's.
+    const bool haveFragmentToSend = (mBtpEngine.TxState() == BtpEngine::kState_InProgress) || !mSendQueue.IsNull();
+
+    if (!mAckToSend.IsNull() && !haveFragmentToSend) // If immediate, stand-alone ack is pending, send it.
     {
+        VerifyOrReturnError(mPendingSends == 0, CHIP_NO_ERROR);
         ReturnErrorOnFailure(DoSendStandAloneAck());
+        didSend = true;
     }
     else if (mBtpEngine.TxState() == BtpEngine::kState_Idle) // Else send next message fragment, if any.
     {
@@ -934,6 +982,7 @@ CHIP_ERROR BLEEndPoint::DriveSending()
         {
             // Transmit first fragment of next whole message in send queue.
             ReturnErrorOnFailure(SendNextMessage());
+            didSend = true;
         }
         else
         {
@@ -944,27 +993,38 @@ CHIP_ERROR BLEEndPoint::DriveSending()
     {
         // Send next fragment of message currently held by fragmenter.
         ReturnErrorOnFailure(ContinueMessageSend());
+        didSend = true;
     }
     else if (mBtpEngine.TxState() == BtpEngine::kState_Complete)
     {
-        // Clear fragmenter's pointer to sent message buffer and reset its Tx state.
-        // Buffer will be freed at scope exit.
-        PacketBufferHandle sentBuf = mBtpEngine.TakeTxPacket();
-
         if (!mSendQueue.IsNull())
         {
+            // Clear fragmenter's pointer to sent message buffer and reset its Tx state.
+            mBtpEngine.TakeTxPacket();
+
             // Transmit first fragment of next whole message in send queue.
             ReturnErrorOnFailure(SendNextMessage());
+            didSend = true;
         }
-        else if (mState == kState_Closing && !mBtpEngine.ExpectingAck()) // and mSendQueue is NULL, per above...
+        else if (mPendingSends > 0)
         {
-            // If end point closing, got last ack, and got out-of-order confirmation for last send, finalize close.
-            FinalizeClose(mState, kBleCloseFlag_SuppressCallback, CHIP_NO_ERROR);
+            // Wait for the last pipelined fragments to be confirmed before reporting the message as sent.
         }
         else
         {
-            // Nothing to send!
-            mBle->mApplicationDelegate->CheckNonConcurrentBleClosing();
+            // Clear fragmenter's pointer to sent message buffer and reset its Tx state.
+            mBtpEngine.TakeTxPacket();
+
+            if (mState == kState_Closing && !mBtpEngine.ExpectingAck()) // and mSendQueue is NULL, per above...
+            {
+                // If end point closing, got last ack, and got out-of-order confirmation for last send, finalize close.
+                FinalizeClose(mState, kBleCloseFlag_SuppressCallback, CHIP_NO_ERROR);
+            }
+            else
+            {
+                // Nothing to send!
+                mBle->mApplicationDelegate->CheckNonConcurrentBleClosing();
+            }
         }
     }
 
@@ -1011,8 +1071,7 @@ CHIP_ERROR BLEEndPoint::HandleCapabilitiesRequestReceived(PacketBufferHandle &&
 
     // Select local and remote max receive window size based on local resources available for both incoming writes AND
     // GATT confirmations.
-    mRemoteReceiveWindowSize = mLocalReceiveWindowSize = mReceiveWindowMaxSize =
-        std::min(req.mWindowSize, static_cast<uint8_t>(BLE_MAX_RECEIVE_WINDOW_SIZE));
+    SetReceiveWindowMaxSize(std::min(req.mWindowSize, GetLocalMaxReceiveWindowSize()));
     resp.mWindowSize = mReceiveWindowMaxSize;
 
     ChipLogProgress(Ble, "local and remote recv window sizes = %u", resp.mWindowSize);
@@ -1077,7 +1136,7 @@ CHIP_ERROR BLEEndPoint::HandleCapabilitiesResponseReceived(PacketBufferHandle &&
 
     // Select local and remote max receive window size based on local resources available for both incoming indications
     // AND GATT confirmations.
-    mRemoteReceiveWindowSize = mLocalReceiveWindowSize = mReceiveWindowMaxSize = resp.mWindowSize;
+    SetReceiveWindowMaxSize(resp.mWindowSize);
 
     ChipLogProgress(Ble, "local and remote recv window size = %u", resp.mWindowSize);
 
@@ -1095,6 +1154,23 @@ CHIP_ERROR BLEEndPoint::HandleCapabilitiesResponseReceived(PacketBufferHandle &&
     return HandleConnectComplete();
 }
 
+uint8_t BLEEndPoint::GetLocalMaxReceiveWindowSize() const
+{
+    // Fall back to the build-time window if the platform offers one too small for stable operation.
+    const uint8_t size = mBle->mPlatformDelegate->GetMaxReceiveWindowSize(mConnObj);
+    return (size < kMinReceiveWindowSize) ? static_cast<uint8_t>(BLE_MAX_RECEIVE_WINDOW_SIZE) : size;
+}
+
+void BLEEndPoint::SetReceiveWindowMaxSize(SequenceNumber_t size)
+{
+    mRemoteReceiveWindowSize = mLocalReceiveWindowSize = mReceiveWindowMaxSize = size;
+
+    // Never pipeline more fragments than the peer may receive without acknowledgement.
+    const uint8_t maxPendingSends = mBle->mPlatformDelegate->GetMaxPendingSends(mConnObj);
+    mMaxPendingSends              = std::max<uint8_t>(1, std::min(maxPendingSends, size));
+    ChipLogDebugBleEndPoint(Ble, "max pending sends = %u", mMaxPendingSends);
+}
+
 // Returns number of open slots in remote receive window given the input values.
 SequenceNumber_t BLEEndPoint::AdjustRemoteReceiveWindow(SequenceNumber_t lastReceivedAck, SequenceNumber_t maxRemoteWindowSize,
                                                         SequenceNumber_t newestUnackedSentSeqNum)
@@ -1255,7 +1331,7 @@ CHIP_ERROR BLEEndPoint::Receive(PacketBufferHandle && data)
     if (mBtpEngine.HasUnackedData())
     {
         if (mLocalReceiveWindowSize <= BLE_CONFIG_IMMEDIATE_ACK_WINDOW_THRESHOLD &&
-            !mConnStateFlags.Has(ConnectionStateFlag::kGattOperationInFlight))
+            !IsGattOperationInFlight())
         {
             ChipLogDebugBleEndPoint(Ble, "sending immediate ack");
             err = DriveStandAloneAck();
@@ -1296,9 +1372,27 @@ exit:
     return err;
 }
 
+bool BLEEndPoint::IsGattOperationInFlight() const
+{
+    return mConnStateFlags.Has(ConnectionStateFlag::kGattOperationInFlight) || mPendingSends > 0;
+}
+
+void BLEEndPoint::MarkSendPending()
+{
+    if (mConnStateFlags.Has(ConnectionStateFlag::kCapabilitiesConfReceived))
+    {
+        // Post-handshake fragments and stand-alone acks may be pipelined up to mMaxPendingSends.
+        mPendingSends++;
+    }
+    else
+    {
+        mConnStateFlags.Set(ConnectionStateFlag::kGattOperationInFlight);
+    }
+}
+
 CHIP_ERROR BLEEndPoint::SendWrite(PacketBufferHandle && buf)
 {
-    mConnStateFlags.Set(ConnectionStateFlag::kGattOperationInFlight);
+    MarkSendPending();
 
     auto err = mBle->mPlatformDelegate->SendWriteRequest(mConnObj, &CHIP_BLE_SVC_ID, &CHIP_BLE_CHAR_1_UUID, std::move(buf));
     VerifyOrReturnError(err == CHIP_NO_ERROR, err,
@@ -1309,7 +1403,7 @@ CHIP_ERROR BLEEndPoint::SendWrite(PacketBufferHandle && buf)
 
 CHIP_ERROR BLEEndPoint::SendIndication(PacketBufferHandle && buf)
 {
-    mConnStateFlags.Set(ConnectionStateFlag::kGattOperationInFlight);
+    MarkSendPending();
 
     auto err = mBle->mPlatformDelegate->SendIndication(mConnObj, &CHIP_BLE_SVC_ID, &CHIP_BLE_CHAR_2_UUID, std::move(buf));
     VerifyOrReturnError(err == CHIP_NO_ERROR, err, ChipLogError(Ble, "Send indication failed: %" CHIP_ERROR_FORMAT, err.Format()));
@@ -141,8 +141,8 @@ private:
     // connection is established.
     PacketBufferHandle mSendQueue;
 
-    // Pending stand-alone BTP acknowledgement. Pre-empts regular send queue or fragmented message transmission in
-    // progress.
+    // Pending stand-alone BTP acknowledgement. Pre-empts the regular send queue when no message fragment is ready to
+    // carry it; otherwise it is piggybacked on the next fragment sent.
     PacketBufferHandle mAckToSend;
 
     BtpEngine mBtpEngine;
@@ -153,6 +153,12 @@ private:
     SequenceNumber_t mRemoteReceiveWindowSize;
     SequenceNumber_t mReceiveWindowMaxSize;
 
+    // Number of BTP fragments and stand-alone acks sent after the handshake and still awaiting GATT confirmation, and
+    // the number the platform allows in flight at once. Handshake and subscription operations are tracked by
+    // ConnectionStateFlag::kGattOperationInFlight instead, since they are never pipelined.
+    uint8_t mPendingSends;
+    uint8_t mMaxPendingSends;
+
     // Private functions:
     BLEEndPoint()  = delete;
     ~BLEEndPoint() = delete;
@@ -163,7 +169,11 @@ private:
 
     // Transmit path:
     CHIP_ERROR DriveSending();
+    CHIP_ERROR DriveSendingOnce(bool & didSend);
     CHIP_ERROR DriveStandAloneAck();
+    bool IsGattOperationInFlight() const;
+    uint8_t GetLocalMaxReceiveWindowSize() const;
+    void SetReceiveWindowMaxSize(SequenceNumber_t size);
     bool PrepareNextFragment(PacketBufferHandle && data, bool & sentAck);
     CHIP_ERROR SendNextMessage();
     CHIP_ERROR ContinueMessageSend();
@@ -171,6 +181,7 @@ private:
     CHIP_ERROR SendCharacteristic(PacketBufferHandle && buf);
     CHIP_ERROR SendIndication(PacketBufferHandle && buf);
     CHIP_ERROR SendWrite(PacketBufferHandle && buf);
+    void MarkSendPending();
 
     // Receive path:
     CHIP_ERROR HandleConnectComplete();
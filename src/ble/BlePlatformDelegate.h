@@ -69,6 +69,21 @@ public:
     // Send GATT characteristic write request
     virtual CHIP_ERROR SendWriteRequest(BLE_CONNECTION_OBJECT connObj, const ChipBleUUID * svcId, const ChipBleUUID * charId,
                                         PacketBufferHandle pBuf) = 0;
+
+    // Following APIs may be overridden by platforms with deeper GATT pipelines:
+
+    // Get the BTP receive window size to offer for the specified BLE connection, i.e. the number of fragments the
+    // platform can buffer for incoming writes or indications AND their GATT confirmations. The window actually used is
+    // negotiated with the peer during the BTP handshake. Values below 3 are ignored.
+    virtual uint8_t GetMaxReceiveWindowSize(BLE_CONNECTION_OBJECT connObj) const { return BLE_MAX_RECEIVE_WINDOW_SIZE; }
+
+    // Get the number of BTP fragments the platform accepts via SendWriteRequest() or SendIndication() before the first
+    // of them is confirmed, e.g. when fragments are sent as GATT Write Without Response or queued by the BLE stack.
+    // Every fragment must still be confirmed, in order, via HandleWriteConfirmation() or HandleIndicationConfirmation().
+    // When this returns more than 1, SendWriteRequest() and SendIndication() must copy the fragment or take ownership of
+    // its buffer before returning: the BTP engine reuses its tx buffer for the next fragment without waiting for the
+    // confirmation.
+    virtual uint8_t GetMaxPendingSends(BLE_CONNECTION_OBJECT connObj) const { return 1; }
 };
 
 } /* namespace Ble */
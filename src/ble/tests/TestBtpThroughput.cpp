@@ -0,0 +1,559 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Simulates a BTP session between a central BLEEndPoint and a peripheral over a loopback
+ *      BlePlatformDelegate, and measures how long a commissioning-sized message exchange takes
+ *      with the default window and with a larger window plus pipelined writes.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <type_traits>
+#include <utility>
+
+#include <pw_unit_test/framework.h>
+
+#include <lib/core/CHIPError.h>
+#include <lib/core/StringBuilderAdapters.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <platform/CHIPDeviceLayer.h>
+#include <system/SystemLayer.h>
+#include <system/SystemPacketBuffer.h>
+
+#define _CHIP_BLE_BLE_H
+#include <ble/BLEEndPoint.h>
+#include <ble/BleApplicationDelegate.h>
+#include <ble/BleLayer.h>
+#include <ble/BleLayerDelegate.h>
+#include <ble/BlePlatformDelegate.h>
+#include <ble/BtpEngine.h>
+
+namespace chip {
+namespace Ble {
+
+namespace {
+
+constexpr uint16_t kAttMtu                   = 247;
+constexpr uint64_t kConnectionIntervalUs     = 15000;
+constexpr uint32_t kPdusPerConnectionEvent   = 4;
+constexpr uint8_t kImmediateAckThreshold     = 1;
+constexpr uint32_t kMaxSimulationEventCount  = 100000;
+constexpr uint8_t kThroughputModeWindowSize  = 16;
+constexpr uint8_t kThroughputModePendingSend = 8;
+
+// Message sizes of a typical commissioning flow over PASE, including session overhead.
+struct ExchangeStep
+{
+    bool fromCentral;
+    uint16_t length;
+};
+
+constexpr ExchangeStep kCommissioningExchange[] = {
+    { true, 120 },  // AttestationRequest
+    { false, 900 }, // AttestationResponse
+    { true, 100 },  // CertificateChainRequest (DAC)
+    { false, 600 }, // CertificateChainResponse
+    { true, 100 },  // CertificateChainRequest (PAI)
+    { false, 600 }, // CertificateChainResponse
+    { true, 150 },  // CSRRequest
+    { false, 400 }, // CSRResponse
+    { true, 1000 }, // AddTrustedRootCertificate and AddNOC
+    { false, 100 }, // NOCResponse
+};
+
+struct LinkConfig
+{
+    uint8_t centralWindowSize;
+    uint8_t centralPendingSends; // > 1 models GATT Write Without Response.
+    uint8_t peripheralWindowSize;
+};
+
+// One direction of the simulated BLE link. PDUs go out in connection events, at most kPdusPerConnectionEvent each.
+struct LinkDirection
+{
+    uint64_t event = 0;
+    uint32_t pdus  = 0;
+};
+
+// Simulation event, optionally carrying a GATT payload to its handler.
+struct LinkEvent
+{
+    std::function<void(System::PacketBufferHandle &&)> action;
+    System::PacketBufferHandle payload;
+};
+
+uint8_t PayloadByte(size_t step, size_t offset)
+{
+    return static_cast<uint8_t>(step * 31 + offset);
+}
+
+} // namespace
+
+class TestBtpThroughput : public BleLayer,
+                          private BleApplicationDelegate,
+                          private BleLayerDelegate,
+                          private BlePlatformDelegate,
+                          public ::testing::Test
+{
+public:
+    static void SetUpTestSuite()
+    {
+        ASSERT_EQ(chip::Platform::MemoryInit(), CHIP_NO_ERROR);
+        ASSERT_EQ(DeviceLayer::SystemLayer().Init(), CHIP_NO_ERROR);
+    }
+
+    static void TearDownTestSuite()
+    {
+        DeviceLayer::SystemLayer().Shutdown();
+        chip::Platform::MemoryShutdown();
+    }
+
+    // Runs the commissioning exchange over the simulated link and returns the simulated time it took, in microseconds,
+    // from BTP connection establishment until the last message was reassembled. Returns 0 if the exchange stalled.
+    uint64_t RunCommissioningExchange(const LinkConfig & config);
+
+    static size_t CommissioningPayloadSize()
+    {
+        size_t total = 0;
+        for (const auto & step : kCommissioningExchange)
+        {
+            total += step.length;
+        }
+        return total;
+    }
+
+    // Largest number of writes handed to the platform by the last exchange and not confirmed yet.
+    uint8_t PeakPendingSends() const { return mPeakPendingSends; }
+
+private:
+    template <typename T = BLE_CONNECTION_OBJECT>
+    T GetConnectionObject()
+    {
+        if constexpr (std::is_pointer_v<T>)
+        {
+            return reinterpret_cast<T>(&mConnectionToken);
+        }
+        else
+        {
+            return static_cast<T>(1);
+        }
+    }
+
+    // Simulation scheduler.
+    void At(uint64_t time, std::function<void(System::PacketBufferHandle &&)> action, System::PacketBufferHandle && payload)
+    {
+        mEvents.emplace(time, LinkEvent{ std::move(action), std::move(payload) });
+    }
+    void At(uint64_t time, std::function<void()> action)
+    {
+        At(time, [action = std::move(action)](System::PacketBufferHandle &&) { action(); }, nullptr);
+    }
+    uint64_t NextTransmitTime(LinkDirection & direction);
+    bool RunNextEvent();
+
+    // Exchange script.
+    void SendStep();
+    void HandleMessage(bool atCentral, System::PacketBufferHandle && msg);
+
+    // Simulated peripheral.
+    void PeerHandleWrite(System::PacketBufferHandle && buf);
+    void PeerHandleSubscribe();
+    void PeerIndicate(System::PacketBufferHandle && buf);
+    void PeerDriveSending();
+
+    ///
+    // Implementation of BleApplicationDelegate
+
+    void NotifyChipConnectionClosed(BLE_CONNECTION_OBJECT connObj) override {}
+
+    ///
+    // Implementation of BleLayerDelegate
+
+    void OnBleConnectionComplete(BLEEndPoint * endpoint) override {}
+    void OnBleConnectionError(CHIP_ERROR err) override {}
+    void OnEndPointConnectComplete(BLEEndPoint * endPoint, CHIP_ERROR err) override
+    {
+        EXPECT_EQ(err, CHIP_NO_ERROR);
+        mStartTime = mNow;
+        SendStep();
+    }
+    void OnEndPointMessageReceived(BLEEndPoint * endPoint, System::PacketBufferHandle && msg) override
+    {
+        HandleMessage(true, std::move(msg));
+    }
+    void OnEndPointConnectionClosed(BLEEndPoint * endPoint, CHIP_ERROR err) override { mEndPoint = nullptr; }
+    CHIP_ERROR SetEndPoint(BLEEndPoint * endPoint) override { return CHIP_NO_ERROR; }
+
+    ///
+    // Implementation of BlePlatformDelegate (central side of the loopback link)
+
+    CHIP_ERROR SubscribeCharacteristic(BLE_CONNECTION_OBJECT connObj, const ChipBleUUID *, const ChipBleUUID *) override
+    {
+        const uint64_t time = NextTransmitTime(mCentralToPeripheral);
+        At(time, [this] { PeerHandleSubscribe(); });
+        At(time + kConnectionIntervalUs,
+           [this, connObj] { HandleSubscribeComplete(connObj, &CHIP_BLE_SVC_ID, &CHIP_BLE_CHAR_2_UUID); });
+        return CHIP_NO_ERROR;
+    }
+    CHIP_ERROR UnsubscribeCharacteristic(BLE_CONNECTION_OBJECT, const ChipBleUUID *, const ChipBleUUID *) override
+    {
+        return CHIP_NO_ERROR;
+    }
+    CHIP_ERROR CloseConnection(BLE_CONNECTION_OBJECT) override { return CHIP_NO_ERROR; }
+    uint16_t GetMTU(BLE_CONNECTION_OBJECT) const override { return kAttMtu; }
+    CHIP_ERROR SendIndication(BLE_CONNECTION_OBJECT, const ChipBleUUID *, const ChipBleUUID *, PacketBufferHandle) override
+    {
+        return CHIP_ERROR_NOT_IMPLEMENTED;
+    }
+    CHIP_ERROR SendWriteRequest(BLE_CONNECTION_OBJECT connObj, const ChipBleUUID *, const ChipBleUUID *,
+                                PacketBufferHandle pBuf) override
+    {
+        // The BTP engine reuses the buffer for the next fragment, so copy it as a platform stack would.
+        auto copy = System::PacketBufferHandle::NewWithData(pBuf->Start(), pBuf->DataLength());
+        VerifyOrReturnError(!copy.IsNull(), CHIP_ERROR_NO_MEMORY);
+
+        const uint64_t time = NextTransmitTime(mCentralToPeripheral);
+        At(time, [this](System::PacketBufferHandle && buf) { PeerHandleWrite(std::move(buf)); }, std::move(copy));
+
+        // A Write Request is confirmed by the Write Response in the next connection event; a Write Without Response as
+        // soon as the stack has transmitted it.
+        const uint64_t confirmTime = (mConfig.centralPendingSends > 1) ? time : time + kConnectionIntervalUs;
+        At(confirmTime, [this, connObj] {
+            mPendingSends--;
+            HandleWriteConfirmation(connObj, &CHIP_BLE_SVC_ID, &CHIP_BLE_CHAR_1_UUID);
+        });
+
+        mPendingSends++;
+        mPeakPendingSends = std::max(mPeakPendingSends, mPendingSends);
+        return CHIP_NO_ERROR;
+    }
+    uint8_t GetMaxReceiveWindowSize(BLE_CONNECTION_OBJECT) const override { return mConfig.centralWindowSize; }
+    uint8_t GetMaxPendingSends(BLE_CONNECTION_OBJECT) const override { return mConfig.centralPendingSends; }
+
+    LinkConfig mConfig;
+    uint8_t mConnectionToken = 0;
+    BLEEndPoint * mEndPoint  = nullptr;
+
+    uint64_t mNow       = 0;
+    uint64_t mStartTime = 0;
+    uint64_t mDoneTime  = 0;
+
+    // Writes handed to the platform and not confirmed yet.
+    uint8_t mPendingSends     = 0;
+    uint8_t mPeakPendingSends = 0;
+
+    std::multimap<uint64_t, LinkEvent> mEvents;
+    LinkDirection mCentralToPeripheral;
+    LinkDirection mPeripheralToCentral;
+    size_t mStep = 0;
+
+    // Simulated peripheral BTP state, following the same window and ack rules as BLEEndPoint.
+    BtpEngine mPeerBtp;
+    System::PacketBufferHandle mPeerCapabilitiesResponse;
+    std::deque<System::PacketBufferHandle> mPeerSendQueue;
+    bool mPeerCapabilitiesReceived = false;
+    bool mPeerConnected            = false;
+    bool mPeerIndicationInFlight   = false;
+    bool mPeerAckPending           = false;
+    uint8_t mPeerWindowSize        = 0;
+    uint8_t mPeerLocalWindowSize   = 0;
+    uint8_t mPeerRemoteWindowSize  = 0;
+};
+
+uint64_t TestBtpThroughput::NextTransmitTime(LinkDirection & direction)
+{
+    uint64_t event = std::max(mNow / kConnectionIntervalUs + 1, direction.event);
+
+    if (event == direction.event && direction.pdus >= kPdusPerConnectionEvent)
+    {
+        event++;
+    }
+
+    if (event != direction.event)
+    {
+        direction.event = event;
+        direction.pdus  = 0;
+    }
+
+    direction.pdus++;
+    return event * kConnectionIntervalUs;
+}
+
+bool TestBtpThroughput::RunNextEvent()
+{
+    if (mEvents.empty())
+    {
+        return false;
+    }
+
+    auto it         = mEvents.begin();
+    mNow            = it->first;
+    LinkEvent event = std::move(it->second);
+    mEvents.erase(it);
+    event.action(std::move(event.payload));
+    return true;
+}
+
+void TestBtpThroughput::SendStep()
+{
+    const ExchangeStep & step = kCommissioningExchange[mStep];
+
+    auto buf = System::PacketBufferHandle::New(step.length);
+    ASSERT_FALSE(buf.IsNull());
+    for (size_t i = 0; i < step.length; i++)
+    {
+        buf->Start()[i] = PayloadByte(mStep, i);
+    }
+    buf->SetDataLength(step.length);
+
+    if (step.fromCentral)
+    {
+        ASSERT_NE(mEndPoint, nullptr);
+        EXPECT_EQ(mEndPoint->Send(std::move(buf)), CHIP_NO_ERROR);
+    }
+    else
+    {
+        mPeerSendQueue.push_back(std::move(buf));
+        PeerDriveSending();
+    }
+}
+
+void TestBtpThroughput::HandleMessage(bool atCentral, System::PacketBufferHandle && msg)
+{
+    ASSERT_LT(mStep, std::size(kCommissioningExchange));
+    const ExchangeStep & step = kCommissioningExchange[mStep];
+
+    EXPECT_NE(step.fromCentral, atCentral);
+    ASSERT_FALSE(msg.IsNull());
+    ASSERT_EQ(msg->DataLength(), step.length);
+    for (size_t i = 0; i < step.length; i++)
+    {
+        ASSERT_EQ(msg->Start()[i], PayloadByte(mStep, i));
+    }
+
+    if (++mStep == std::size(kCommissioningExchange))
+    {
+        mDoneTime = mNow;
+        return;
+    }
+
+    // Respond from the event loop, as the application would.
+    At(mNow, [this] { SendStep(); });
+}
+
+void TestBtpThroughput::PeerHandleWrite(System::PacketBufferHandle && buf)
+{
+    if (!mPeerCapabilitiesReceived)
+    {
+        BleTransportCapabilitiesRequestMessage req;
+        ASSERT_EQ(BleTransportCapabilitiesRequestMessage::Decode(buf, req), CHIP_NO_ERROR);
+        mPeerCapabilitiesReceived = true;
+
+        BleTransportCapabilitiesResponseMessage resp;
+        resp.mSelectedProtocolVersion = CHIP_BLE_TRANSPORT_PROTOCOL_MAX_SUPPORTED_VERSION;
+        resp.mFragmentSize            = std::min(static_cast<uint16_t>(req.mMtu - 3), BtpEngine::sMaxFragmentSize);
+        resp.mWindowSize              = std::min(req.mWindowSize, mConfig.peripheralWindowSize);
+
+        mPeerCapabilitiesResponse = System::PacketBufferHandle::New(kCapabilitiesResponseLength);
+        ASSERT_FALSE(mPeerCapabilitiesResponse.IsNull());
+        ASSERT_EQ(resp.Encode(mPeerCapabilitiesResponse), CHIP_NO_ERROR);
+
+        ASSERT_EQ(mPeerBtp.Init(nullptr, true), CHIP_NO_ERROR);
+        mPeerBtp.SetRxFragmentSize(resp.mFragmentSize);
+        mPeerBtp.SetTxFragmentSize(resp.mFragmentSize);
+        mPeerWindowSize = mPeerLocalWindowSize = mPeerRemoteWindowSize = resp.mWindowSize;
+        return;
+    }
+
+    SequenceNumber_t receivedAck = 0;
+    bool didReceiveAck           = false;
+    ASSERT_EQ(mPeerBtp.HandleCharacteristicReceived(std::move(buf), receivedAck, didReceiveAck), CHIP_NO_ERROR);
+    mPeerLocalWindowSize--;
+
+    if (didReceiveAck)
+    {
+        mPeerRemoteWindowSize =
+            static_cast<uint8_t>(receivedAck + mPeerWindowSize - mPeerBtp.GetNewestUnackedSentSequenceNumber());
+    }
+
+    mPeerAckPending = mPeerBtp.HasUnackedData();
+
+    if (mPeerBtp.RxState() == BtpEngine::kState_Complete)
+    {
+        HandleMessage(false, mPeerBtp.TakeRxPacket());
+    }
+
+    PeerDriveSending();
+}
+
+void TestBtpThroughput::PeerHandleSubscribe()
+{
+    ASSERT_FALSE(mPeerCapabilitiesResponse.IsNull());
+
+    // The capabilities response indication counts against the central's window and is acked with sequence number 0.
+    mPeerConnected = true;
+    mPeerRemoteWindowSize--;
+    PeerIndicate(std::move(mPeerCapabilitiesResponse));
+}
+
+void TestBtpThroughput::PeerIndicate(System::PacketBufferHandle && buf)
+{
+    auto copy = System::PacketBufferHandle::NewWithData(buf->Start(), buf->DataLength());
+    ASSERT_FALSE(copy.IsNull());
+
+    // Indications are confirmed by the central in the next connection event; only one may be outstanding.
+    const uint64_t time = NextTransmitTime(mPeripheralToCentral);
+    At(
+        time,
+        [this](System::PacketBufferHandle && ind) {
+            HandleIndicationReceived(GetConnectionObject(), &CHIP_BLE_SVC_ID, &CHIP_BLE_CHAR_2_UUID, std::move(ind));
+        },
+        std::move(copy));
+    At(time + kConnectionIntervalUs, [this] {
+        mPeerIndicationInFlight = false;
+        PeerDriveSending();
+    });
+    mPeerIndicationInFlight = true;
+}
+
+void TestBtpThroughput::PeerDriveSending()
+{
+    if (!mPeerConnected || mPeerIndicationInFlight)
+    {
+        return;
+    }
+
+    if (mPeerBtp.TxState() == BtpEngine::kState_Complete)
+    {
+        mPeerBtp.ClearTxPacket();
+    }
+
+    const bool haveFragment = (mPeerBtp.TxState() == BtpEngine::kState_InProgress) || !mPeerSendQueue.empty();
+
+    if (haveFragment && (mPeerRemoteWindowSize > 1 || (mPeerRemoteWindowSize > 0 && mPeerAckPending)))
+    {
+        System::PacketBufferHandle data;
+        if (mPeerBtp.TxState() == BtpEngine::kState_Idle)
+        {
+            data = std::move(mPeerSendQueue.front());
+            mPeerSendQueue.pop_front();
+        }
+
+        const bool sendAck = mPeerAckPending;
+        ASSERT_TRUE(mPeerBtp.HandleCharacteristicSend(std::move(data), sendAck));
+        if (sendAck)
+        {
+            mPeerAckPending      = false;
+            mPeerLocalWindowSize = mPeerWindowSize;
+        }
+
+        mPeerRemoteWindowSize--;
+        PeerIndicate(mPeerBtp.BorrowTxPacket());
+    }
+    else if (mPeerAckPending && mPeerLocalWindowSize <= kImmediateAckThreshold && mPeerRemoteWindowSize > 0)
+    {
+        auto ack = System::PacketBufferHandle::New(kTransferProtocolStandaloneAckHeaderSize);
+        ASSERT_FALSE(ack.IsNull());
+        ASSERT_EQ(mPeerBtp.EncodeStandAloneAck(ack), CHIP_NO_ERROR);
+
+        mPeerAckPending      = false;
+        mPeerLocalWindowSize = mPeerWindowSize;
+        mPeerRemoteWindowSize--;
+        PeerIndicate(std::move(ack));
+    }
+}
+
+uint64_t TestBtpThroughput::RunCommissioningExchange(const LinkConfig & config)
+{
+    mConfig = config;
+    mNow = mStartTime = mDoneTime = 0;
+    mStep                         = 0;
+    mCentralToPeripheral          = {};
+    mPeripheralToCentral          = {};
+    mPeerCapabilitiesReceived = mPeerConnected = mPeerIndicationInFlight = mPeerAckPending = false;
+    mPendingSends = mPeakPendingSends = 0;
+
+    EXPECT_EQ(Init(this, this, &DeviceLayer::SystemLayer()), CHIP_NO_ERROR);
+    mBleTransport = this;
+
+    EXPECT_EQ(NewBleEndPoint(&mEndPoint, GetConnectionObject(), kBleRole_Central, true), CHIP_NO_ERROR);
+    if (mEndPoint != nullptr)
+    {
+        EXPECT_EQ(mEndPoint->StartConnect(), CHIP_NO_ERROR);
+    }
+
+    for (uint32_t i = 0; mDoneTime == 0 && i < kMaxSimulationEventCount && RunNextEvent(); i++)
+    {
+    }
+
+    mBleTransport = nullptr;
+    Shutdown();
+    mEndPoint = nullptr;
+
+    mEvents.clear();
+    mPeerSendQueue.clear();
+    mPeerCapabilitiesResponse = nullptr;
+    mPeerBtp.ClearRxPacket();
+    mPeerBtp.ClearTxPacket();
+
+    return (mDoneTime > mStartTime) ? (mDoneTime - mStartTime) : 0;
+}
+
+TEST_F(TestBtpThroughput, CommissioningExchangeDefaultWindow)
+{
+    const uint64_t elapsedUs = RunCommissioningExchange({ BLE_MAX_RECEIVE_WINDOW_SIZE, 1, BLE_MAX_RECEIVE_WINDOW_SIZE });
+    ASSERT_GT(elapsedUs, 0u);
+
+    ChipLogProgress(Test, "default window: %u bytes in %u ms (%u B/s)", static_cast<unsigned>(CommissioningPayloadSize()),
+                    static_cast<unsigned>(elapsedUs / 1000),
+                    static_cast<unsigned>(CommissioningPayloadSize() * 1000000 / elapsedUs));
+}
+
+TEST_F(TestBtpThroughput, CommissioningExchangeThroughputMode)
+{
+    const uint64_t baselineUs = RunCommissioningExchange({ BLE_MAX_RECEIVE_WINDOW_SIZE, 1, BLE_MAX_RECEIVE_WINDOW_SIZE });
+    ASSERT_GT(baselineUs, 0u);
+
+    const uint64_t elapsedUs =
+        RunCommissioningExchange({ kThroughputModeWindowSize, kThroughputModePendingSend, kThroughputModeWindowSize });
+    ASSERT_GT(elapsedUs, 0u);
+
+    ChipLogProgress(Test, "throughput mode: %u bytes in %u ms (%u B/s), default window took %u ms",
+                    static_cast<unsigned>(CommissioningPayloadSize()), static_cast<unsigned>(elapsedUs / 1000),
+                    static_cast<unsigned>(CommissioningPayloadSize() * 1000000 / elapsedUs),
+                    static_cast<unsigned>(baselineUs / 1000));
+
+    EXPECT_LT(elapsedUs, baselineUs);
+}
+
+TEST_F(TestBtpThroughput, PendingSendsLimitedByNegotiatedWindow)
+{
+    // The peripheral only supports the default window, so the central can't pipeline past it.
+    const uint64_t elapsedUs = RunCommissioningExchange({ kThroughputModeWindowSize, UINT8_MAX, BLE_MAX_RECEIVE_WINDOW_SIZE });
+    EXPECT_GT(elapsedUs, 0u);
+    EXPECT_GT(PeakPendingSends(), 1u);
+    EXPECT_LE(PeakPendingSends(), BLE_MAX_RECEIVE_WINDOW_SIZE);
+}
+
+} // namespace Ble
+} // namespace chip
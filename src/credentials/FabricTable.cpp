@@ -1920,6 +1920,11 @@ CHIP_ERROR FabricTable::CommitPendingFabricData()
     }
 
     // ==== Start of actual commit transaction after pre-flight checks ====
+    // All the writes below are grouped into a single storage batch, so that
+    // backends supporting it persist the commit atomically. The commit marker
+    // still covers backends that do not.
+    PersistentStorageBatch storageBatch(mStorage);
+
     CHIP_ERROR stickyError  = StoreCommitMarker(CommitMarker{ fabricIndexBeingCommitted, isAdding });
     bool failedCommitMarker = (stickyError != CHIP_NO_ERROR);
     if (failedCommitMarker)
@@ -1985,6 +1990,9 @@ CHIP_ERROR FabricTable::CommitPendingFabricData()
                 mFabricIndexWithPendingState = kUndefinedFabricIndex;
                 mPendingFabric.Reset();
 
+                // Persist the partial commit so that the commit marker clean-up can be exercised
+                (void) storageBatch.Commit();
+
                 ChipLogError(FabricProvisioning, "Aborting commit in middle of transaction for testing.");
                 return CHIP_ERROR_INTERNAL;
             }
@@ -2027,6 +2035,21 @@ CHIP_ERROR FabricTable::CommitPendingFabricData()
         stickyError = (stickyError != CHIP_NO_ERROR) ? stickyError : fabricIndexErr;
     }
 
+    if (stickyError == CHIP_NO_ERROR)
+    {
+        stickyError = storageBatch.Commit();
+        if (stickyError != CHIP_NO_ERROR)
+        {
+            ChipLogError(FabricProvisioning, "Failed to persist fabric commit: %" CHIP_ERROR_FORMAT, stickyError.Format());
+        }
+    }
+    else
+    {
+        // Do not persist any part of a failed commit. The batch has to be closed before the clean-up below,
+        // whose writes must not be discarded with it.
+        storageBatch.Abort();
+    }
+
     // Commit must have same side-effect as reverting all pending data
     mStateFlags.ClearAll();
     mFabricIndexWithPendingState = kUndefinedFabricIndex;
@@ -22,7 +22,10 @@
 #include <lib/support/DefaultStorageKeyAllocator.h>
 #include <lib/support/PersistentData.h>
 #include <lib/support/Pool.h>
+
+#include <ctype.h>
 #include <stdlib.h>
+#include <string.h>
 
 namespace chip {
 namespace Credentials {
@@ -43,7 +46,7 @@ struct FabricList : public CommonPersistentData::FabricList
     }
 };
 
-constexpr size_t kPersistentBufferMax = 128;
+constexpr size_t kPersistentBufferMax = GroupDataProviderImpl::kRecordSizeMax;
 
 struct LinkedData : public PersistentData<kPersistentBufferMax>
 {
@@ -840,6 +843,206 @@ void GroupDataProviderImpl::SetStorageDelegate(PersistentStorageDelegate * stora
     mStorage = storage;
 }
 
+void GroupDataProviderImpl::SetStorageDelegate(PersistentStorageDelegate * storage, GroupDataStorageCacheBase * cache)
+{
+    VerifyOrDie(storage != nullptr && cache != nullptr);
+    VerifyOrDie(CHIP_NO_ERROR == cache->Init(storage));
+    mStorage = cache;
+}
+
+//
+// Storage cache
+//
+
+bool GroupDataStorageCacheBase::IsCacheable(const char * key) const
+{
+    // Keysets are stored under "f/<fabric>/k/<keyset>", see DefaultStorageKeyAllocator::FabricKeyset()
+    VerifyOrReturnValue(strncmp(key, "f/", 2) == 0, true);
+    key += 2;
+    while (isxdigit(static_cast<unsigned char>(*key)))
+    {
+        key++;
+    }
+    return strncmp(key, "/k/", 3) != 0;
+}
+
+//
+// Group membership index
+//
+
+namespace {
+
+// Drops the membership index when leaving a method that changes groups or group endpoints
+class MembershipIndexInvalidator
+{
+public:
+    explicit MembershipIndexInvalidator(GroupMembershipIndexBase * index) : mIndex(index) {}
+    ~MembershipIndexInvalidator()
+    {
+        if (mIndex != nullptr)
+        {
+            mIndex->Clear();
+        }
+    }
+
+private:
+    GroupMembershipIndexBase * const mIndex;
+};
+
+} // namespace
+
+bool GroupMembershipIndexBase::Group::HasEndpoint(EndpointId endpoint_id) const
+{
+    for (uint16_t i = 0; i < endpoint_count; i++)
+    {
+        if (endpoints[i] == endpoint_id)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void GroupMembershipIndexBase::Clear()
+{
+    for (size_t i = 0; i < mFabricCount; i++)
+    {
+        mFabrics[i] = Fabric();
+    }
+    for (size_t i = 0; i < mSlotCount; i++)
+    {
+        mSlots[i].fabric_index   = kUndefinedFabricIndex;
+        mSlots[i].endpoint_count = 0;
+    }
+    mGroupCount = 0;
+}
+
+GroupMembershipIndexBase::FabricState GroupMembershipIndexBase::GetFabricState(FabricIndex fabric_index) const
+{
+    for (size_t i = 0; i < mFabricCount; i++)
+    {
+        if (mFabrics[i].fabric_index == fabric_index)
+        {
+            return mFabrics[i].state;
+        }
+    }
+    return FabricState::kUnknown;
+}
+
+CHIP_ERROR GroupMembershipIndexBase::SetFabricState(FabricIndex fabric_index, FabricState state)
+{
+    Fabric * free_entry = nullptr;
+    for (size_t i = 0; i < mFabricCount; i++)
+    {
+        if (mFabrics[i].fabric_index == fabric_index)
+        {
+            mFabrics[i].state = state;
+            return CHIP_NO_ERROR;
+        }
+        if (free_entry == nullptr && mFabrics[i].fabric_index == kUndefinedFabricIndex)
+        {
+            free_entry = &mFabrics[i];
+        }
+    }
+    VerifyOrReturnError(free_entry != nullptr, CHIP_ERROR_NO_MEMORY);
+    free_entry->fabric_index = fabric_index;
+    free_entry->state        = state;
+    return CHIP_NO_ERROR;
+}
+
+size_t GroupMembershipIndexBase::SlotOf(FabricIndex fabric_index, GroupId group_id) const
+{
+    // Multiplicative hashing, the slot count is a power of two
+    uint32_t hash = ((static_cast<uint32_t>(fabric_index) << 16) | group_id) * 2654435761u;
+    return (hash ^ (hash >> 16)) & (mSlotCount - 1);
+}
+
+CHIP_ERROR GroupMembershipIndexBase::AddEndpoint(FabricIndex fabric_index, GroupId group_id, EndpointId endpoint_id)
+{
+    size_t slot = SlotOf(fabric_index, group_id);
+    while (mSlots[slot].fabric_index != kUndefinedFabricIndex &&
+           (mSlots[slot].fabric_index != fabric_index || mSlots[slot].group_id != group_id))
+    {
+        slot = (slot + 1) & (mSlotCount - 1);
+    }
+
+    Group & group = mSlots[slot];
+    if (group.fabric_index == kUndefinedFabricIndex)
+    {
+        // New group
+        VerifyOrReturnError(mGroupCount < mMaxGroups, CHIP_ERROR_NO_MEMORY);
+        group.fabric_index   = fabric_index;
+        group.group_id       = group_id;
+        group.endpoint_count = 0;
+        mGroupCount++;
+    }
+    VerifyOrReturnError(!group.HasEndpoint(endpoint_id), CHIP_NO_ERROR);
+    VerifyOrReturnError(group.endpoint_count < kMaxEndpointsPerGroup, CHIP_ERROR_NO_MEMORY);
+    group.endpoints[group.endpoint_count++] = endpoint_id;
+    return CHIP_NO_ERROR;
+}
+
+const GroupMembershipIndexBase::Group * GroupMembershipIndexBase::FindGroup(FabricIndex fabric_index, GroupId group_id) const
+{
+    size_t slot = SlotOf(fabric_index, group_id);
+    while (mSlots[slot].fabric_index != kUndefinedFabricIndex)
+    {
+        if (mSlots[slot].fabric_index == fabric_index && mSlots[slot].group_id == group_id)
+        {
+            return &mSlots[slot];
+        }
+        slot = (slot + 1) & (mSlotCount - 1);
+    }
+    return nullptr;
+}
+
+void GroupDataProviderImpl::SetMembershipIndex(GroupMembershipIndexBase * index)
+{
+    VerifyOrDie(index != nullptr);
+    index->Clear();
+    mIndex = index;
+}
+
+bool GroupDataProviderImpl::IndexFabric(FabricIndex fabric_index)
+{
+    VerifyOrReturnValue(mIndex != nullptr, false);
+
+    switch (mIndex->GetFabricState(fabric_index))
+    {
+    case GroupMembershipIndexBase::FabricState::kIndexed:
+        return true;
+    case GroupMembershipIndexBase::FabricState::kTooLarge:
+        return false;
+    default:
+        break;
+    }
+
+    // Load fabric data (defaults to zero)
+    FabricData fabric(fabric_index);
+    CHIP_ERROR err = fabric.Load(mStorage);
+    VerifyOrReturnValue(CHIP_NO_ERROR == err || CHIP_ERROR_NOT_FOUND == err, false);
+
+    GroupData group(fabric_index, fabric.first_group);
+    for (size_t group_index = 0; group_index < fabric.group_count; group_index++, group.group_id = group.next)
+    {
+        // On storage errors, leave the fabric unindexed and let the next lookup retry
+        VerifyOrReturnValue(CHIP_NO_ERROR == group.Load(mStorage), false);
+
+        EndpointData endpoint(fabric_index, group.group_id, group.first_endpoint);
+        for (size_t endpoint_index = 0; endpoint_index < group.endpoint_count;
+             endpoint_index++, endpoint.endpoint_id = endpoint.next)
+        {
+            VerifyOrReturnValue(CHIP_NO_ERROR == endpoint.Load(mStorage), false);
+            if (CHIP_NO_ERROR != mIndex->AddEndpoint(fabric_index, group.group_id, endpoint.endpoint_id))
+            {
+                mIndex->SetFabricState(fabric_index, GroupMembershipIndexBase::FabricState::kTooLarge);
+                return false;
+            }
+        }
+    }
+    return CHIP_NO_ERROR == mIndex->SetFabricState(fabric_index, GroupMembershipIndexBase::FabricState::kIndexed);
+}
+
 //
 // Group Info
 //
@@ -847,6 +1050,8 @@ void GroupDataProviderImpl::SetStorageDelegate(PersistentStorageDelegate * stora
 CHIP_ERROR GroupDataProviderImpl::SetGroupInfo(chip::FabricIndex fabric_index, const GroupInfo & info)
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
+    MembershipIndexInvalidator indexInvalidator(mIndex);
+    PersistentStorageBatch storageBatch(mStorage);
 
     FabricData fabric(fabric_index);
     GroupData group;
@@ -859,13 +1064,15 @@ CHIP_ERROR GroupDataProviderImpl::SetGroupInfo(chip::FabricIndex fabric_index, c
     {
         // Existing group_id
         group.SetName(info.name);
-        return group.Save(mStorage);
+        ReturnErrorOnFailure(group.Save(mStorage));
+        return storageBatch.Commit();
     }
 
     // New group_id
     group.group_id = info.group_id;
     group.SetName(info.name);
-    return SetGroupInfoAt(fabric_index, fabric.group_count, group);
+    ReturnErrorOnFailure(SetGroupInfoAt(fabric_index, fabric.group_count, group));
+    return storageBatch.Commit();
 }
 
 CHIP_ERROR GroupDataProviderImpl::GetGroupInfo(chip::FabricIndex fabric_index, chip::GroupId group_id, GroupInfo & info)
@@ -895,6 +1102,8 @@ CHIP_ERROR GroupDataProviderImpl::RemoveGroupInfo(chip::FabricIndex fabric_index
 CHIP_ERROR GroupDataProviderImpl::SetGroupInfoAt(chip::FabricIndex fabric_index, size_t index, const GroupInfo & info)
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
+    MembershipIndexInvalidator indexInvalidator(mIndex);
+    PersistentStorageBatch storageBatch(mStorage);
 
     FabricData fabric(fabric_index);
     GroupData group;
@@ -914,7 +1123,8 @@ CHIP_ERROR GroupDataProviderImpl::SetGroupInfoAt(chip::FabricIndex fabric_index,
     if (found)
     {
         // Update existing entry
-        return group.Save(mStorage);
+        ReturnErrorOnFailure(group.Save(mStorage));
+        return storageBatch.Commit();
     }
     if (index < fabric.group_count)
     {
@@ -955,7 +1165,7 @@ CHIP_ERROR GroupDataProviderImpl::SetGroupInfoAt(chip::FabricIndex fabric_index,
     // Update fabric
     ReturnErrorOnFailure(fabric.Save(mStorage));
     GroupAdded(fabric_index, group);
-    return CHIP_NO_ERROR;
+    return storageBatch.Commit();
 }
 
 CHIP_ERROR GroupDataProviderImpl::GetGroupInfoAt(chip::FabricIndex fabric_index, size_t index, GroupInfo & info)
@@ -977,6 +1187,8 @@ CHIP_ERROR GroupDataProviderImpl::GetGroupInfoAt(chip::FabricIndex fabric_index,
 CHIP_ERROR GroupDataProviderImpl::RemoveGroupInfoAt(chip::FabricIndex fabric_index, size_t index)
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
+    MembershipIndexInvalidator indexInvalidator(mIndex);
+    PersistentStorageBatch storageBatch(mStorage);
 
     FabricData fabric(fabric_index);
     GroupData group;
@@ -1018,13 +1230,20 @@ CHIP_ERROR GroupDataProviderImpl::RemoveGroupInfoAt(chip::FabricIndex fabric_ind
     // Update fabric info
     ReturnErrorOnFailure(fabric.Save(mStorage));
     GroupRemoved(fabric_index, group);
-    return CHIP_NO_ERROR;
+    return storageBatch.Commit();
 }
 
 bool GroupDataProviderImpl::HasEndpoint(chip::FabricIndex fabric_index, chip::GroupId group_id, chip::EndpointId endpoint_id)
 {
     VerifyOrReturnError(IsInitialized(), false);
 
+    if (IndexFabric(fabric_index))
+    {
+        const GroupMembershipIndexBase::Group * indexed = mIndex->FindGroup(fabric_index, group_id);
+        return (indexed != nullptr) && indexed->HasEndpoint(endpoint_id);
+    }
+
+    // Walk the lists rather than loading the records by key: a record left behind by an interrupted removal is not a member.
     FabricData fabric(fabric_index);
     GroupData group;
     EndpointData endpoint;
@@ -1037,6 +1256,8 @@ bool GroupDataProviderImpl::HasEndpoint(chip::FabricIndex fabric_index, chip::Gr
 CHIP_ERROR GroupDataProviderImpl::AddEndpoint(chip::FabricIndex fabric_index, chip::GroupId group_id, chip::EndpointId endpoint_id)
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
+    MembershipIndexInvalidator indexInvalidator(mIndex);
+    PersistentStorageBatch storageBatch(mStorage);
 
     FabricData fabric(fabric_index);
     GroupData group;
@@ -1063,7 +1284,7 @@ CHIP_ERROR GroupDataProviderImpl::AddEndpoint(chip::FabricIndex fabric_index, ch
         fabric.group_count++;
         ReturnErrorOnFailure(fabric.Save(mStorage));
         GroupAdded(fabric_index, group);
-        return CHIP_NO_ERROR;
+        return storageBatch.Commit();
     }
 
     // Existing group
@@ -1088,13 +1309,16 @@ CHIP_ERROR GroupDataProviderImpl::AddEndpoint(chip::FabricIndex fabric_index, ch
         ReturnErrorOnFailure(prev.Save(mStorage));
     }
     group.endpoint_count++;
-    return group.Save(mStorage);
+    ReturnErrorOnFailure(group.Save(mStorage));
+    return storageBatch.Commit();
 }
 
 CHIP_ERROR GroupDataProviderImpl::RemoveEndpoint(chip::FabricIndex fabric_index, chip::GroupId group_id,
                                                  chip::EndpointId endpoint_id)
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
+    MembershipIndexInvalidator indexInvalidator(mIndex);
+    PersistentStorageBatch storageBatch(mStorage);
 
     FabricData fabric(fabric_index);
     GroupData group;
@@ -1124,16 +1348,20 @@ CHIP_ERROR GroupDataProviderImpl::RemoveEndpoint(chip::FabricIndex fabric_index,
     if (group.endpoint_count > 1)
     {
         group.endpoint_count--;
-        return group.Save(mStorage);
+        ReturnErrorOnFailure(group.Save(mStorage));
+        return storageBatch.Commit();
     }
 
     // No more endpoints, remove the group
-    return RemoveGroupInfoAt(fabric_index, group.index);
+    ReturnErrorOnFailure(RemoveGroupInfoAt(fabric_index, group.index));
+    return storageBatch.Commit();
 }
 
 CHIP_ERROR GroupDataProviderImpl::RemoveEndpoint(chip::FabricIndex fabric_index, chip::EndpointId endpoint_id)
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
+    MembershipIndexInvalidator indexInvalidator(mIndex);
+    PersistentStorageBatch storageBatch(mStorage);
 
     FabricData fabric(fabric_index);
 
@@ -1160,7 +1388,7 @@ CHIP_ERROR GroupDataProviderImpl::RemoveEndpoint(chip::FabricIndex fabric_index,
         group_index++;
     }
 
-    return CHIP_NO_ERROR;
+    return storageBatch.Commit();
 }
 
 GroupDataProvider::GroupInfoIterator * GroupDataProviderImpl::IterateGroupInfo(chip::FabricIndex fabric_index)
@@ -1219,6 +1447,20 @@ GroupDataProviderImpl::EndpointIteratorImpl::EndpointIteratorImpl(GroupDataProvi
     mProvider(provider),
     mFabric(fabric_index)
 {
+    if (group_id.has_value() && provider.IndexFabric(fabric_index))
+    {
+        const GroupMembershipIndexBase::Group * indexed = provider.mIndex->FindGroup(fabric_index, *group_id);
+
+        mIndexed       = true;
+        mGroup         = *group_id;
+        mEndpointCount = (indexed != nullptr) ? indexed->endpoint_count : 0;
+        for (size_t i = 0; i < mEndpointCount; i++)
+        {
+            mIndexedEndpoints[i] = indexed->endpoints[i];
+        }
+        return;
+    }
+
     FabricData fabric(fabric_index);
     VerifyOrReturn(CHIP_NO_ERROR == fabric.Load(provider.mStorage));
 
@@ -1248,6 +1490,8 @@ GroupDataProviderImpl::EndpointIteratorImpl::EndpointIteratorImpl(GroupDataProvi
 
 size_t GroupDataProviderImpl::EndpointIteratorImpl::Count()
 {
+    VerifyOrReturnValue(!mIndexed, mEndpointCount);
+
     GroupData group(mFabric, mFirstGroup);
     size_t group_index    = 0;
     size_t endpoint_index = 0;
@@ -1277,6 +1521,14 @@ size_t GroupDataProviderImpl::EndpointIteratorImpl::Count()
 
 bool GroupDataProviderImpl::EndpointIteratorImpl::Next(GroupEndpoint & output)
 {
+    if (mIndexed)
+    {
+        VerifyOrReturnValue(mEndpointIndex < mEndpointCount, false);
+        output.group_id    = mGroup;
+        output.endpoint_id = mIndexedEndpoints[mEndpointIndex++];
+        return true;
+    }
+
     while (mGroupIndex < mGroupCount)
     {
         GroupData group(mFabric, mGroup);
@@ -1319,6 +1571,8 @@ void GroupDataProviderImpl::EndpointIteratorImpl::Release()
 CHIP_ERROR GroupDataProviderImpl::RemoveEndpoints(chip::FabricIndex fabric_index, chip::GroupId group_id)
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
+    MembershipIndexInvalidator indexInvalidator(mIndex);
+    PersistentStorageBatch storageBatch(mStorage);
 
     FabricData fabric(fabric_index);
     GroupData group;
@@ -1339,7 +1593,7 @@ CHIP_ERROR GroupDataProviderImpl::RemoveEndpoints(chip::FabricIndex fabric_index
     group.endpoint_count = 0;
     ReturnErrorOnFailure(group.Save(mStorage));
 
-    return CHIP_NO_ERROR;
+    return storageBatch.Commit();
 }
 
 //
@@ -1349,6 +1603,7 @@ CHIP_ERROR GroupDataProviderImpl::RemoveEndpoints(chip::FabricIndex fabric_index
 CHIP_ERROR GroupDataProviderImpl::SetGroupKeyAt(chip::FabricIndex fabric_index, size_t index, const GroupKey & in_map)
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
+    PersistentStorageBatch storageBatch(mStorage);
 
     FabricData fabric(fabric_index);
     KeyMapData map(fabric_index);
@@ -1368,7 +1623,8 @@ CHIP_ERROR GroupDataProviderImpl::SetGroupKeyAt(chip::FabricIndex fabric_index,
     if (found)
     {
         // Update existing map
-        return map.Save(mStorage);
+        ReturnErrorOnFailure(map.Save(mStorage));
+        return storageBatch.Commit();
     }
 
     // Insert last
@@ -1393,7 +1649,8 @@ CHIP_ERROR GroupDataProviderImpl::SetGroupKeyAt(chip::FabricIndex fabric_index,
     }
     // Update fabric
     fabric.map_count++;
-    return fabric.Save(mStorage);
+    ReturnErrorOnFailure(fabric.Save(mStorage));
+    return storageBatch.Commit();
 }
 
 CHIP_ERROR GroupDataProviderImpl::GetGroupKeyAt(chip::FabricIndex fabric_index, size_t index, GroupKey & out_map)
@@ -1415,6 +1672,7 @@ CHIP_ERROR GroupDataProviderImpl::GetGroupKeyAt(chip::FabricIndex fabric_index,
 CHIP_ERROR GroupDataProviderImpl::RemoveGroupKeyAt(chip::FabricIndex fabric_index, size_t index)
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
+    PersistentStorageBatch storageBatch(mStorage);
 
     FabricData fabric(fabric_index);
     KeyMapData map;
@@ -1441,12 +1699,14 @@ CHIP_ERROR GroupDataProviderImpl::RemoveGroupKeyAt(chip::FabricIndex fabric_inde
         fabric.map_count--;
     }
     // Update fabric
-    return fabric.Save(mStorage);
+    ReturnErrorOnFailure(fabric.Save(mStorage));
+    return storageBatch.Commit();
 }
 
 CHIP_ERROR GroupDataProviderImpl::RemoveGroupKeys(chip::FabricIndex fabric_index)
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
+    PersistentStorageBatch storageBatch(mStorage);
 
     FabricData fabric(fabric_index);
     VerifyOrReturnError(CHIP_NO_ERROR == fabric.Load(mStorage), CHIP_ERROR_INVALID_FABRIC_INDEX);
@@ -1466,7 +1726,8 @@ CHIP_ERROR GroupDataProviderImpl::RemoveGroupKeys(chip::FabricIndex fabric_index
     // Update fabric
     fabric.first_map = 0;
     fabric.map_count = 0;
-    return fabric.Save(mStorage);
+    ReturnErrorOnFailure(fabric.Save(mStorage));
+    return storageBatch.Commit();
 }
 
 GroupDataProvider::GroupKeyIterator * GroupDataProviderImpl::IterateGroupKeys(chip::FabricIndex fabric_index)
@@ -1523,6 +1784,7 @@ CHIP_ERROR GroupDataProviderImpl::SetKeySet(chip::FabricIndex fabric_index, cons
                                             const KeySet & in_keyset)
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
+    PersistentStorageBatch storageBatch(mStorage);
 
     FabricData fabric(fabric_index);
     KeySetData keyset;
@@ -1553,7 +1815,8 @@ CHIP_ERROR GroupDataProviderImpl::SetKeySet(chip::FabricIndex fabric_index, cons
     if (found)
     {
         // Update existing keyset info, keep next
-        return keyset.Save(mStorage);
+        ReturnErrorOnFailure(keyset.Save(mStorage));
+        return storageBatch.Commit();
     }
 
     // New keyset
@@ -1565,7 +1828,8 @@ CHIP_ERROR GroupDataProviderImpl::SetKeySet(chip::FabricIndex fabric_index, cons
     // Update fabric
     fabric.keyset_count++;
     fabric.first_keyset = in_keyset.keyset_id;
-    return fabric.Save(mStorage);
+    ReturnErrorOnFailure(fabric.Save(mStorage));
+    return storageBatch.Commit();
 }
 
 CHIP_ERROR GroupDataProviderImpl::GetKeySet(chip::FabricIndex fabric_index, uint16_t target_id, KeySet & out_keyset)
@@ -1594,6 +1858,7 @@ CHIP_ERROR GroupDataProviderImpl::GetKeySet(chip::FabricIndex fabric_index, uint
 CHIP_ERROR GroupDataProviderImpl::RemoveKeySet(chip::FabricIndex fabric_index, uint16_t target_id)
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
+    PersistentStorageBatch storageBatch(mStorage);
 
     FabricData fabric(fabric_index);
     KeySetData keyset;
@@ -1633,12 +1898,11 @@ CHIP_ERROR GroupDataProviderImpl::RemoveKeySet(chip::FabricIndex fabric_index, u
         {
             break;
         }
-        // NOTE: It's unclear what should happen here if we have removed the key set
-        // and possibly some mappings before failing. For now, ignoring errors, but
-        // open to suggestsions for the correct behavior.
+        // A failure aborts the whole batch, so with storage that supports batches either the key set and all of
+        // its mappings are removed, or none of them are.
         RemoveGroupKeyAt(fabric_index, idx);
     }
-    return CHIP_NO_ERROR;
+    return storageBatch.Commit();
 }
 
 GroupDataProvider::KeySetIterator * GroupDataProviderImpl::IterateKeySets(chip::FabricIndex fabric_index)
@@ -1695,6 +1959,8 @@ void GroupDataProviderImpl::KeySetIteratorImpl::Release()
 
 CHIP_ERROR GroupDataProviderImpl::RemoveFabric(chip::FabricIndex fabric_index)
 {
+    // Removal is best effort, so it is not batched as a whole: failing to remove one item must not keep the others.
+    MembershipIndexInvalidator indexInvalidator(mIndex);
     FabricData fabric(fabric_index);
 
     // Fabric data defaults to zero, so if not entry is found, no mappings, or keys are removed
@@ -19,15 +19,107 @@
 #include <credentials/GroupDataProvider.h>
 #include <crypto/SessionKeystore.h>
 #include <lib/core/CHIPPersistentStorageDelegate.h>
+#include <lib/support/PersistentStorageCache.h>
 #include <lib/support/Pool.h>
 
 namespace chip {
 namespace Credentials {
 
+/**
+ * @brief Write-through, in-memory mirror of the group data records.
+ *
+ * Group data is stored as linked lists of records (fabrics, groups, group endpoints and group key maps), so that iterating the
+ * endpoints of a group or looking up a membership reads several records from storage. When the provider is given a cache of
+ * this type, these records are served from memory once read or written. Keyset records hold the epoch keys and are never cached.
+ */
+class GroupDataStorageCacheBase : public PersistentStorageCacheBase
+{
+protected:
+    GroupDataStorageCacheBase(Entry * entries, uint8_t * values, size_t entryCount, size_t valueSize) :
+        PersistentStorageCacheBase(entries, values, entryCount, valueSize)
+    {}
+
+    bool IsCacheable(const char * key) const override;
+};
+
+/**
+ * @brief In-memory index of the endpoints of each group.
+ *
+ * When the provider is given an index, membership checks and the iteration of the endpoints of a group are answered from
+ * memory, without reading storage. The groups of a fabric are indexed from storage on first use, and the whole index is
+ * dropped after every change to groups or group endpoints, so it cannot diverge from the stored lists. A fabric that does
+ * not fit, or with more than kMaxEndpointsPerGroup endpoints in a group, is served from storage.
+ */
+class GroupMembershipIndexBase
+{
+public:
+    static constexpr size_t kMaxEndpointsPerGroup = CHIP_CONFIG_MAX_GROUP_ENDPOINTS_PER_FABRIC;
+
+    enum class FabricState : uint8_t
+    {
+        kUnknown,  // Not indexed yet
+        kIndexed,  // All the groups of the fabric are in the index
+        kTooLarge, // The groups of the fabric do not fit in the index
+    };
+
+    struct Group
+    {
+        FabricIndex fabric_index = kUndefinedFabricIndex;
+        GroupId group_id         = kUndefinedGroupId;
+        uint16_t endpoint_count  = 0;
+        EndpointId endpoints[kMaxEndpointsPerGroup];
+
+        bool HasEndpoint(EndpointId endpoint_id) const;
+    };
+
+    /// Forget all the indexed fabrics.
+    void Clear();
+
+    FabricState GetFabricState(FabricIndex fabric_index) const;
+
+    /// @retval CHIP_ERROR_NO_MEMORY  The index already tracks as many fabrics as it can hold.
+    CHIP_ERROR SetFabricState(FabricIndex fabric_index, FabricState state);
+
+    /// @retval CHIP_ERROR_NO_MEMORY  The group, or the endpoint of the group, does not fit in the index.
+    CHIP_ERROR AddEndpoint(FabricIndex fabric_index, GroupId group_id, EndpointId endpoint_id);
+
+    /// Indexed group with at least one endpoint, or nullptr.
+    const Group * FindGroup(FabricIndex fabric_index, GroupId group_id) const;
+
+protected:
+    struct Fabric
+    {
+        FabricIndex fabric_index = kUndefinedFabricIndex;
+        FabricState state        = FabricState::kUnknown;
+    };
+
+    // Open addressing with at least twice as many slots as groups, so that probing always ends on an empty slot.
+    static constexpr size_t SlotCountFor(size_t groupCount, size_t slotCount = 1)
+    {
+        return (slotCount >= 2 * groupCount) ? slotCount : SlotCountFor(groupCount, slotCount * 2);
+    }
+
+    GroupMembershipIndexBase(Fabric * fabrics, size_t fabricCount, Group * slots, size_t slotCount, size_t groupCount) :
+        mFabrics(fabrics), mFabricCount(fabricCount), mSlots(slots), mSlotCount(slotCount), mMaxGroups(groupCount)
+    {}
+
+private:
+    size_t SlotOf(FabricIndex fabric_index, GroupId group_id) const;
+
+    Fabric * const mFabrics;
+    const size_t mFabricCount;
+    Group * const mSlots;
+    const size_t mSlotCount;
+    const size_t mMaxGroups;
+    size_t mGroupCount = 0;
+};
+
 class GroupDataProviderImpl : public GroupDataProvider
 {
 public:
     static constexpr size_t kIteratorsMax = CHIP_CONFIG_MAX_GROUP_CONCURRENT_ITERATORS;
+    // Largest serialized record
+    static constexpr size_t kRecordSizeMax = 128;
 
     GroupDataProviderImpl() = default;
     GroupDataProviderImpl(uint16_t maxGroupsPerFabric, uint16_t maxGroupKeysPerFabric) :
@@ -43,6 +135,23 @@ public:
      */
     void SetStorageDelegate(PersistentStorageDelegate * storage);
 
+    /**
+     * @brief Set the storage implementation, accessed through the given write-through cache.
+     *        This method MUST be called before Init().
+     *
+     * @param storage Pointer to storage instance to set. Cannot be nullptr, will assert.
+     * @param cache Cache mirroring the group data records in memory, must outlive the provider. Cannot be nullptr, will assert.
+     */
+    void SetStorageDelegate(PersistentStorageDelegate * storage, GroupDataStorageCacheBase * cache);
+
+    /**
+     * @brief Serve membership checks and group endpoint iteration from the given in-memory index.
+     *        This method MUST be called before Init().
+     *
+     * @param index Index of the group endpoints, must outlive the provider.
+     */
+    void SetMembershipIndex(GroupMembershipIndexBase * index);
+
     void SetSessionKeystore(Crypto::SessionKeystore * keystore) { mSessionKeystore = keystore; }
     Crypto::SessionKeystore * GetSessionKeystore() const { return mSessionKeystore; }
 
@@ -149,6 +258,9 @@ protected:
         size_t mEndpointIndex = 0;
         size_t mEndpointCount = 0;
         bool mFirstEndpoint   = true;
+        // Endpoints of the group copied from the membership index, which may be dropped while iterating
+        bool mIndexed = false;
+        EndpointId mIndexedEndpoints[GroupMembershipIndexBase::kMaxEndpointsPerGroup];
     };
 
     class GroupKeyContext : public Crypto::SymmetricKeyContext
@@ -245,8 +357,11 @@ protected:
     };
     bool IsInitialized() { return (mStorage != nullptr); }
     CHIP_ERROR RemoveEndpoints(FabricIndex fabric_index, GroupId group_id);
+    // Returns true if the groups of the fabric are in the membership index, indexing them first if needed.
+    bool IndexFabric(FabricIndex fabric_index);
 
     PersistentStorageDelegate * mStorage       = nullptr;
+    GroupMembershipIndexBase * mIndex          = nullptr;
     Crypto::SessionKeystore * mSessionKeystore = nullptr;
     ObjectPool<GroupInfoIteratorImpl, kIteratorsMax> mGroupInfoIterators;
     ObjectPool<GroupKeyIteratorImpl, kIteratorsMax> mGroupKeyIterators;
@@ -256,5 +371,44 @@ protected:
     ObjectPool<GroupKeyContext, kIteratorsMax> mGroupKeyContexPool;
 };
 
+/**
+ * @brief GroupDataStorageCacheBase holding up to kEntryCount records.
+ *
+ * Keeping all the group data of a fabric in memory takes 1 entry for the fabric, plus 1 entry per group, per group endpoint and
+ * per group key map. One more entry holds the list of fabrics.
+ */
+template <size_t kEntryCount>
+class GroupDataStorageCache : public GroupDataStorageCacheBase
+{
+public:
+    static_assert(kEntryCount > 0, "A group data storage cache needs at least one entry");
+
+    GroupDataStorageCache() :
+        GroupDataStorageCacheBase(mEntryStorage, mValueStorage, kEntryCount, GroupDataProviderImpl::kRecordSizeMax)
+    {}
+
+private:
+    Entry mEntryStorage[kEntryCount];
+    uint8_t mValueStorage[kEntryCount * GroupDataProviderImpl::kRecordSizeMax];
+};
+
+/**
+ * @brief GroupMembershipIndexBase holding the groups of up to kFabricCount fabrics, kGroupCount groups in total.
+ */
+template <size_t kFabricCount, size_t kGroupCount>
+class GroupMembershipIndex : public GroupMembershipIndexBase
+{
+public:
+    static_assert(kFabricCount > 0 && kGroupCount > 0, "A group membership index needs at least one fabric and one group");
+
+    GroupMembershipIndex() : GroupMembershipIndexBase(mFabricStorage, kFabricCount, mSlotStorage, kSlotCount, kGroupCount) {}
+
+private:
+    static constexpr size_t kSlotCount = SlotCountFor(kGroupCount);
+
+    Fabric mFabricStorage[kFabricCount];
+    Group mSlotStorage[kSlotCount];
+};
+
 } // namespace Credentials
 } // namespace chip
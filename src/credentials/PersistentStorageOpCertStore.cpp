@@ -333,7 +333,11 @@ CHIP_ERROR PersistentStorageOpCertStore::CommitOpCertsForFabric(FabricIndex fabr
         VerifyOrReturnError(mStateFlags.Has(StateFlags::kAddNewTrustedRootCalled), CHIP_ERROR_INCORRECT_STATE);
     }
 
-    // TODO: Handle transaction marking to revert partial certs at next boot if we get interrupted by reboot.
+    // Storage backends that support batches persist the whole chain atomically, and discard partial
+    // writes if the batch is aborted on failure below.
+    // TODO: Handle transaction marking to revert partial certs at next boot if we get interrupted by reboot
+    //       on backends without batch support.
+    PersistentStorageBatch storageBatch(mStorage);
 
     // Start committing NOC first so we don't have dangling roots if one was added.
     ByteSpan pendingNocSpan{ mPendingNoc.Get(), mPendingNoc.AllocatedSize() };
@@ -370,13 +374,15 @@ CHIP_ERROR PersistentStorageOpCertStore::CommitOpCertsForFabric(FabricIndex fabr
         }
         if (mStateFlags.Has(StateFlags::kUpdateOpCertsCalled))
         {
-            // Can't do anything to clean-up here, but pretty sure the fabric is broken now...
+            // Without batch support, can't do anything to clean-up here, but pretty sure the fabric is broken now...
             // TODO: Handle transaction marking to revert certs if somehow failing store on update by pre-backing-up opcerts
         }
 
         return stickyErr;
     }
 
+    ReturnErrorOnFailure(storageBatch.Commit());
+
     // If we got here, we succeeded and can reset the pending certs: next `GetCertificate` will use the stored certs
     RevertPendingOpCerts();
     return CHIP_NO_ERROR;
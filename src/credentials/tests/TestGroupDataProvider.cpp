@@ -28,6 +28,7 @@
 #include <lib/core/StringBuilderAdapters.h>
 #include <lib/core/TLV.h>
 #include <lib/support/CHIPMem.h>
+#include <lib/support/DefaultStorageKeyAllocator.h>
 #include <lib/support/TestPersistentStorageDelegate.h>
 #include <platform/KeyValueStoreManager.h>
 
@@ -1222,6 +1223,193 @@ TEST_F(TestGroupDataProvider, TestGroupDecryption)
     it->Release();
 }
 
+class CountingStorageDelegate : public chip::TestPersistentStorageDelegate
+{
+public:
+    CHIP_ERROR SyncGetKeyValue(const char * key, void * buffer, uint16_t & size) override
+    {
+        mReads++;
+        return TestPersistentStorageDelegate::SyncGetKeyValue(key, buffer, size);
+    }
+
+    unsigned mReads = 0;
+};
+
+TEST_F(TestGroupDataProvider, TestStorageCache)
+{
+    CountingStorageDelegate delegate;
+    GroupDataStorageCache<16> cache;
+    GroupDataProviderImpl provider(kMaxGroupsPerFabric, kMaxGroupKeysPerFabric);
+    provider.SetStorageDelegate(&delegate, &cache);
+    provider.SetSessionKeystore(&sSessionKeystore);
+    ASSERT_EQ(provider.Init(), CHIP_NO_ERROR);
+
+    EXPECT_EQ(provider.SetGroupInfo(kFabric1, kGroupInfo1_1), CHIP_NO_ERROR);
+    EXPECT_EQ(provider.AddEndpoint(kFabric1, kGroup1, kEndpointId0), CHIP_NO_ERROR);
+    EXPECT_EQ(provider.AddEndpoint(kFabric1, kGroup1, kEndpointId1), CHIP_NO_ERROR);
+    EXPECT_EQ(provider.AddEndpoint(kFabric1, kGroup2, kEndpointId2), CHIP_NO_ERROR);
+    EXPECT_EQ(provider.SetGroupKeyAt(kFabric1, 0, kGroup1Keyset1), CHIP_NO_ERROR);
+    EXPECT_EQ(provider.SetKeySet(kFabric1, kCompressedFabricId1, kKeySet1), CHIP_NO_ERROR);
+
+    // Missing records are read once, then remembered
+    EXPECT_FALSE(provider.HasEndpoint(kFabric1, kGroup1, kEndpointId2));
+
+    // Membership lookups and group endpoint iteration are served from memory
+    delegate.mReads = 0;
+
+    EXPECT_TRUE(provider.HasEndpoint(kFabric1, kGroup1, kEndpointId0));
+    EXPECT_TRUE(provider.HasEndpoint(kFabric1, kGroup1, kEndpointId1));
+    EXPECT_FALSE(provider.HasEndpoint(kFabric1, kGroup1, kEndpointId2));
+    EXPECT_TRUE(provider.HasEndpoint(kFabric1, kGroup2, kEndpointId2));
+
+    GroupEndpoint mapping;
+    size_t count = 0;
+    auto it      = provider.IterateEndpoints(kFabric1, std::make_optional(kGroup1));
+    ASSERT_NE(it, nullptr);
+    EXPECT_EQ(it->Count(), 2u);
+    while (it->Next(mapping))
+    {
+        EXPECT_EQ(mapping.group_id, kGroup1);
+        count++;
+    }
+    it->Release();
+    EXPECT_EQ(count, 2u);
+
+    GroupInfo group;
+    EXPECT_EQ(provider.GetGroupInfo(kFabric1, kGroup1, group), CHIP_NO_ERROR);
+    EXPECT_STREQ(group.name, kGroupInfo1_1.name);
+
+    EXPECT_EQ(delegate.mReads, 0u);
+
+    // Keysets are always read from storage
+    KeySet keyset;
+    EXPECT_EQ(provider.GetKeySet(kFabric1, kKeysetId1, keyset), CHIP_NO_ERROR);
+    EXPECT_GT(delegate.mReads, 0u);
+
+    // Keep a copy of an endpoint record to leave it behind after its removal
+    const StorageKeyName orphanKey = DefaultStorageKeyAllocator::FabricGroupEndpoint(kFabric1, kGroup1, kEndpointId0);
+    uint8_t orphan[GroupDataProviderImpl::kRecordSizeMax];
+    uint16_t orphanSize = sizeof(orphan);
+    EXPECT_EQ(delegate.SyncGetKeyValue(orphanKey.KeyName(), orphan, orphanSize), CHIP_NO_ERROR);
+
+    // Removals are mirrored
+    EXPECT_EQ(provider.RemoveEndpoint(kFabric1, kGroup1, kEndpointId0), CHIP_NO_ERROR);
+    EXPECT_FALSE(provider.HasEndpoint(kFabric1, kGroup1, kEndpointId0));
+    EXPECT_TRUE(provider.HasEndpoint(kFabric1, kGroup1, kEndpointId1));
+
+    // The cache writes through: a provider without cache sees the same data
+    GroupDataProviderImpl uncached(kMaxGroupsPerFabric, kMaxGroupKeysPerFabric);
+    uncached.SetStorageDelegate(&delegate);
+    uncached.SetSessionKeystore(&sSessionKeystore);
+    ASSERT_EQ(uncached.Init(), CHIP_NO_ERROR);
+    EXPECT_FALSE(uncached.HasEndpoint(kFabric1, kGroup1, kEndpointId0));
+    EXPECT_TRUE(uncached.HasEndpoint(kFabric1, kGroup1, kEndpointId1));
+    EXPECT_TRUE(uncached.HasEndpoint(kFabric1, kGroup2, kEndpointId2));
+
+    // A record that is not linked to its group is not a member
+    EXPECT_EQ(delegate.SyncSetKeyValue(orphanKey.KeyName(), orphan, orphanSize), CHIP_NO_ERROR);
+    EXPECT_FALSE(uncached.HasEndpoint(kFabric1, kGroup1, kEndpointId0));
+
+    EXPECT_EQ(provider.RemoveFabric(kFabric1), CHIP_NO_ERROR);
+    EXPECT_FALSE(provider.HasEndpoint(kFabric1, kGroup1, kEndpointId1));
+    EXPECT_FALSE(uncached.HasEndpoint(kFabric1, kGroup1, kEndpointId1));
+    EXPECT_FALSE(uncached.HasEndpoint(kFabric1, kGroup2, kEndpointId2));
+
+    uncached.Finish();
+    provider.Finish();
+}
+
+TEST_F(TestGroupDataProvider, TestMembershipIndex)
+{
+    CountingStorageDelegate delegate;
+    GroupMembershipIndex<2, 4> index;
+    GroupDataProviderImpl provider(kMaxGroupsPerFabric, kMaxGroupKeysPerFabric);
+    provider.SetStorageDelegate(&delegate);
+    provider.SetMembershipIndex(&index);
+    provider.SetSessionKeystore(&sSessionKeystore);
+    ASSERT_EQ(provider.Init(), CHIP_NO_ERROR);
+
+    EXPECT_EQ(provider.AddEndpoint(kFabric1, kGroup1, kEndpointId0), CHIP_NO_ERROR);
+    EXPECT_EQ(provider.AddEndpoint(kFabric1, kGroup2, kEndpointId2), CHIP_NO_ERROR);
+    EXPECT_EQ(provider.AddEndpoint(kFabric2, kGroup1, kEndpointId1), CHIP_NO_ERROR);
+
+    // The groups of a fabric are indexed on first use
+    EXPECT_TRUE(provider.HasEndpoint(kFabric1, kGroup1, kEndpointId0));
+    EXPECT_TRUE(provider.HasEndpoint(kFabric2, kGroup1, kEndpointId1));
+
+    // Group command dispatch does not read storage
+    delegate.mReads = 0;
+
+    EXPECT_TRUE(provider.HasEndpoint(kFabric1, kGroup1, kEndpointId0));
+    EXPECT_FALSE(provider.HasEndpoint(kFabric1, kGroup1, kEndpointId1));
+    EXPECT_TRUE(provider.HasEndpoint(kFabric1, kGroup2, kEndpointId2));
+    EXPECT_FALSE(provider.HasEndpoint(kFabric1, kGroup3, kEndpointId0));
+    EXPECT_TRUE(provider.HasEndpoint(kFabric2, kGroup1, kEndpointId1));
+    EXPECT_FALSE(provider.HasEndpoint(kFabric2, kGroup1, kEndpointId0));
+
+    GroupEndpoint mapping;
+    auto it = provider.IterateEndpoints(kFabric1, std::make_optional(kGroup1));
+    ASSERT_NE(it, nullptr);
+    EXPECT_EQ(it->Count(), 1u);
+    EXPECT_TRUE(it->Next(mapping));
+    EXPECT_EQ(mapping.group_id, kGroup1);
+    EXPECT_EQ(mapping.endpoint_id, kEndpointId0);
+    EXPECT_FALSE(it->Next(mapping));
+    it->Release();
+
+    it = provider.IterateEndpoints(kFabric1, std::make_optional(kGroup3));
+    ASSERT_NE(it, nullptr);
+    EXPECT_EQ(it->Count(), 0u);
+    EXPECT_FALSE(it->Next(mapping));
+    it->Release();
+
+    EXPECT_EQ(delegate.mReads, 0u);
+
+    // Changes are reflected
+    EXPECT_EQ(provider.RemoveEndpoint(kFabric1, kGroup2, kEndpointId2), CHIP_NO_ERROR);
+    EXPECT_FALSE(provider.HasEndpoint(kFabric1, kGroup2, kEndpointId2));
+    EXPECT_EQ(provider.AddEndpoint(kFabric1, kGroup3, kEndpointId3), CHIP_NO_ERROR);
+    EXPECT_TRUE(provider.HasEndpoint(kFabric1, kGroup3, kEndpointId3));
+
+    // A group with more endpoints than the index holds is served from storage
+    const size_t endpointCount = GroupMembershipIndexBase::kMaxEndpointsPerGroup + 1;
+    for (size_t i = 0; i < endpointCount; i++)
+    {
+        EXPECT_EQ(provider.AddEndpoint(kFabric1, kGroup4, static_cast<EndpointId>(i)), CHIP_NO_ERROR);
+    }
+    delegate.mReads = 0;
+    EXPECT_TRUE(provider.HasEndpoint(kFabric1, kGroup4, static_cast<EndpointId>(endpointCount - 1)));
+    EXPECT_TRUE(provider.HasEndpoint(kFabric1, kGroup1, kEndpointId0));
+    EXPECT_FALSE(provider.HasEndpoint(kFabric1, kGroup1, kEndpointId1));
+    it = provider.IterateEndpoints(kFabric1, std::make_optional(kGroup4));
+    ASSERT_NE(it, nullptr);
+    EXPECT_EQ(it->Count(), endpointCount);
+    it->Release();
+    EXPECT_GT(delegate.mReads, 0u);
+
+    // Other fabrics are still indexed
+    EXPECT_TRUE(provider.HasEndpoint(kFabric2, kGroup1, kEndpointId1));
+    delegate.mReads = 0;
+    EXPECT_TRUE(provider.HasEndpoint(kFabric2, kGroup1, kEndpointId1));
+    EXPECT_EQ(delegate.mReads, 0u);
+
+    // Once the group fits again, the fabric is indexed again
+    EXPECT_EQ(provider.RemoveGroupInfo(kFabric1, kGroup4), CHIP_NO_ERROR);
+    EXPECT_FALSE(provider.HasEndpoint(kFabric1, kGroup4, 0));
+    delegate.mReads = 0;
+    EXPECT_TRUE(provider.HasEndpoint(kFabric1, kGroup3, kEndpointId3));
+    EXPECT_FALSE(provider.HasEndpoint(kFabric1, kGroup4, 0));
+    EXPECT_EQ(delegate.mReads, 0u);
+
+    EXPECT_EQ(provider.RemoveFabric(kFabric1), CHIP_NO_ERROR);
+    EXPECT_FALSE(provider.HasEndpoint(kFabric1, kGroup1, kEndpointId0));
+    EXPECT_FALSE(provider.HasEndpoint(kFabric1, kGroup3, kEndpointId3));
+    EXPECT_TRUE(provider.HasEndpoint(kFabric2, kGroup1, kEndpointId1));
+
+    EXPECT_EQ(provider.RemoveFabric(kFabric2), CHIP_NO_ERROR);
+    provider.Finish();
+}
+
 } // namespace TestGroups
 } // namespace app
 } // namespace chip
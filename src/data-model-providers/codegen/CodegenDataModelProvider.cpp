@@ -35,7 +35,9 @@
 #include <app/util/attribute-storage.h>
 #include <app/util/endpoint-config-api.h>
 #include <app/util/persistence/AttributePersistenceProvider.h>
+#include <app/util/persistence/CoalescingAttributePersistenceProvider.h>
 #include <app/util/persistence/DefaultAttributePersistenceProvider.h>
+#include <app/util/persistence/PackedAttributePersistenceProvider.h>
 #include <lib/core/CHIPError.h>
 #include <lib/core/DataModelTypes.h>
 #include <lib/support/CodeUtils.h>
@@ -120,7 +122,17 @@ DataModel::AttributeEntry AttributeEntryFrom(const ConcreteClusterPath & cluster
 
 const ConcreteCommandPath kInvalidCommandPath(kInvalidEndpointId, kInvalidClusterId, kInvalidCommandId);
 
+#if CHIP_CONFIG_PACKED_ATTRIBUTE_PERSISTENCE
+PackedAttributePersistenceProvider gDefaultAttributePersistence;
+#else
 DefaultAttributePersistenceProvider gDefaultAttributePersistence;
+#endif
+
+#if CHIP_CONFIG_COALESCED_ATTRIBUTE_PERSISTENCE
+CoalescedAttribute gCoalescedAttributes[CHIP_CONFIG_COALESCED_ATTRIBUTE_PERSISTENCE_SLOTS];
+CoalescingAttributePersistenceProvider gCoalescingAttributePersistence(gDefaultAttributePersistence,
+                                                                       Span<CoalescedAttribute>(gCoalescedAttributes));
+#endif
 
 } // namespace
 
@@ -140,7 +152,11 @@ CHIP_ERROR CodegenDataModelProvider::Startup(DataModel::InteractionModelContext
         if (mPersistentStorageDelegate != nullptr)
         {
             ReturnErrorOnFailure(gDefaultAttributePersistence.Init(mPersistentStorageDelegate));
+#if CHIP_CONFIG_COALESCED_ATTRIBUTE_PERSISTENCE
+            SetAttributePersistenceProvider(&gCoalescingAttributePersistence);
+#else
             SetAttributePersistenceProvider(&gDefaultAttributePersistence);
+#endif
 #if CHIP_CONFIG_DATA_MODEL_EXTRA_LOGGING
         }
         else
@@ -155,6 +171,24 @@ CHIP_ERROR CodegenDataModelProvider::Startup(DataModel::InteractionModelContext
     return CHIP_NO_ERROR;
 }
 
+CHIP_ERROR CodegenDataModelProvider::Shutdown()
+{
+    Reset();
+
+    // Make sure no attribute write deferred by the persistence provider is lost.
+    AttributePersistenceProvider * attributePersistence = GetAttributePersistenceProvider();
+    if (attributePersistence != nullptr)
+    {
+        CHIP_ERROR err = attributePersistence->Flush();
+        if (err != CHIP_NO_ERROR)
+        {
+            ChipLogError(DataManagement, "Failed to flush attribute persistence: %" CHIP_ERROR_FORMAT, err.Format());
+        }
+    }
+
+    return CHIP_NO_ERROR;
+}
+
 std::optional<DataModel::ActionReturnStatus> CodegenDataModelProvider::Invoke(const DataModel::InvokeRequest & request,
                                                                               TLV::TLVReader & input_arguments,
                                                                               CommandHandler * handler)
@@ -51,11 +51,7 @@ public:
     PersistentStorageDelegate * GetPersistentStorageDelegate() { return mPersistentStorageDelegate; }
 
     /// Generic model implementations
-    CHIP_ERROR Shutdown() override
-    {
-        Reset();
-        return CHIP_NO_ERROR;
-    }
+    CHIP_ERROR Shutdown() override;
 
     CHIP_ERROR Startup(DataModel::InteractionModelContext context) override;
 
@@ -30,6 +30,7 @@
 #include <type_traits>
 
 #include <lib/core/CHIPError.h>
+#include <lib/core/CHIPPersistentStorageDelegate.h>
 #include <platform/CHIPDeviceConfig.h>
 
 namespace chip {
@@ -170,10 +171,64 @@ public:
      */
     CHIP_ERROR Delete(const char * key);
 
+    /**
+     * @brief
+     * Starts a batch of writes. All Put and Delete calls made until the
+     * matching CommitBatch are persisted atomically. Batches may be nested,
+     * in which case writes are only persisted by the outermost CommitBatch,
+     * and aborting a nested batch aborts the outermost one.
+     *
+     * Platforms that do not support batching apply writes immediately and
+     * treat CommitBatch and AbortBatch as no-ops.
+     *
+     * @return CHIP_NO_ERROR the batch was started.
+     *         CHIP_ERROR_UNINITIALIZED the KVS is not initialized
+     */
+    CHIP_ERROR StartBatch();
+
+    /**
+     * @brief
+     * Commits the batch started by the matching StartBatch.
+     *
+     * @return CHIP_NO_ERROR the writes of the batch were persisted.
+     *         CHIP_ERROR_INCORRECT_STATE no batch is in progress
+     *         CHIP_ERROR_CANCELLED a nested batch was aborted, none of the
+     *                              writes of the batch were kept.
+     *         CHIP_ERROR_PERSISTED_STORAGE_FAILED failed to persist the batch,
+     *                                             none of its writes were kept.
+     */
+    CHIP_ERROR CommitBatch();
+
+    /**
+     * @brief
+     * Discards all the writes made since the matching StartBatch.
+     */
+    void AbortBatch();
+
+    /**
+     * @brief
+     * Calls the visitor for each key held by the KVS, in no particular order.
+     *
+     * @return CHIP_NO_ERROR all the keys were visited.
+     *         CHIP_ERROR_NOT_IMPLEMENTED the platform cannot enumerate its keys
+     *         Any error returned by the visitor, which stops the enumeration.
+     */
+    CHIP_ERROR ForEachKey(PersistentStorageKeyVisitor & visitor);
+
 private:
     using ImplClass = ::chip::DeviceLayer::PersistedStorage::KeyValueStoreManagerImpl;
 
 protected:
+    // Default batching implementation, which provides no atomicity. Platforms
+    // may shadow these in their KeyValueStoreManagerImpl.
+    CHIP_ERROR _StartBatch() { return CHIP_NO_ERROR; }
+    CHIP_ERROR _CommitBatch() { return CHIP_NO_ERROR; }
+    void _AbortBatch() {}
+
+    // Default enumeration implementation. Platforms that can list their keys
+    // may shadow it in their KeyValueStoreManagerImpl.
+    CHIP_ERROR _ForEachKey(PersistentStorageKeyVisitor & visitor) { return CHIP_ERROR_NOT_IMPLEMENTED; }
+
     // Construction/destruction limited to subclasses.
     KeyValueStoreManager()  = default;
     ~KeyValueStoreManager() = default;
@@ -233,6 +288,26 @@ inline CHIP_ERROR KeyValueStoreManager::Delete(const char * key)
     return static_cast<ImplClass *>(this)->_Delete(key);
 }
 
+inline CHIP_ERROR KeyValueStoreManager::StartBatch()
+{
+    return static_cast<ImplClass *>(this)->_StartBatch();
+}
+
+inline CHIP_ERROR KeyValueStoreManager::CommitBatch()
+{
+    return static_cast<ImplClass *>(this)->_CommitBatch();
+}
+
+inline void KeyValueStoreManager::AbortBatch()
+{
+    static_cast<ImplClass *>(this)->_AbortBatch();
+}
+
+inline CHIP_ERROR KeyValueStoreManager::ForEachKey(PersistentStorageKeyVisitor & visitor)
+{
+    return static_cast<ImplClass *>(this)->_ForEachKey(visitor);
+}
+
 } // namespace PersistedStorage
 } // namespace DeviceLayer
 } // namespace chip
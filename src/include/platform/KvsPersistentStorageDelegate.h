@@ -103,6 +103,30 @@ public:
         return mKvsManager->Delete(key);
     }
 
+    CHIP_ERROR StartBatch() override
+    {
+        VerifyOrReturnError(mKvsManager != nullptr, CHIP_ERROR_INCORRECT_STATE);
+        return mKvsManager->StartBatch();
+    }
+
+    CHIP_ERROR CommitBatch() override
+    {
+        VerifyOrReturnError(mKvsManager != nullptr, CHIP_ERROR_INCORRECT_STATE);
+        return mKvsManager->CommitBatch();
+    }
+
+    void AbortBatch() override
+    {
+        VerifyOrReturn(mKvsManager != nullptr);
+        mKvsManager->AbortBatch();
+    }
+
+    CHIP_ERROR SyncForEachKey(PersistentStorageKeyVisitor & visitor) override
+    {
+        VerifyOrReturnError(mKvsManager != nullptr, CHIP_ERROR_INCORRECT_STATE);
+        return mKvsManager->ForEachKey(visitor);
+    }
+
 protected:
     DeviceLayer::PersistedStorage::KeyValueStoreManager * mKvsManager = nullptr;
 };
@@ -37,6 +37,7 @@
 #include <lib/support/CHIPMem.h>
 #include <lib/support/CodeUtils.h>
 #include <lib/support/logging/CHIPLogging.h>
+#include <system/SystemEventLoopProfiler.h>
 
 namespace chip {
 namespace DeviceLayer {
@@ -296,16 +297,22 @@ void GenericPlatformManagerImpl<ImplClass>::_DispatchEvent(const ChipDeviceEvent
         // Do nothing for no-op events.
         break;
 
-    case DeviceEventType::kChipLambdaEvent:
+    case DeviceEventType::kChipLambdaEvent: {
+        SYSTEM_PROFILE_DISPATCH(kLambda, event->LambdaEvent.GetOrigin());
         event->LambdaEvent();
         break;
+    }
 
-    case DeviceEventType::kCallWorkFunct:
+    case DeviceEventType::kCallWorkFunct: {
         // If the event is a "call work function" event, call the specified function.
+        SYSTEM_PROFILE_DISPATCH(kWork, System::EventLoopProfiler::OriginOf(event->CallWorkFunct.WorkFunct));
         event->CallWorkFunct.WorkFunct(event->CallWorkFunct.Arg);
         break;
+    }
+
+    default: {
+        SYSTEM_PROFILE_DISPATCH(kDeviceEvent, event->Type);
 
-    default:
         // For all other events, deliver the event to each of the components in the Device Layer.
         Impl()->DispatchEventToDeviceLayer(event);
 
@@ -318,6 +325,7 @@ void GenericPlatformManagerImpl<ImplClass>::_DispatchEvent(const ChipDeviceEvent
 
         break;
     }
+    }
 
 #if (CHIP_DISPATCH_EVENT_LONG_DISPATCH_TIME_WARNING_THRESHOLD_MS != 0)
     uint32_t deltaMs = System::Clock::Milliseconds32(System::SystemClock().GetMonotonicTimestamp() - start).count();
@@ -769,6 +769,20 @@
 #define CHIP_CONFIG_SECURE_SESSION_POOL_SIZE (CHIP_CONFIG_MAX_FABRICS * 3 + 2)
 #endif // CHIP_CONFIG_SECURE_SESSION_POOL_SIZE
 
+/**
+ * @def CHIP_CONFIG_ENABLE_TRAFFIC_COUNTERS
+ *
+ * @brief Count messages, bytes, MRP retransmissions and time spent in
+ * message encryption/decryption per secure session and per exchange, and
+ * keep per-fabric totals of released sessions (see SessionManager).
+ *
+ * Costs two monotonic clock reads per message, plus a few counters per
+ * session and exchange.
+ */
+#ifndef CHIP_CONFIG_ENABLE_TRAFFIC_COUNTERS
+#define CHIP_CONFIG_ENABLE_TRAFFIC_COUNTERS 0
+#endif // CHIP_CONFIG_ENABLE_TRAFFIC_COUNTERS
+
 /**
  *  @def CHIP_CONFIG_MAX_GROUP_DATA_PEERS
  *
@@ -1107,6 +1121,36 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_MAX_GROUP_CONCURRENT_ITERATORS 2
 #endif
 
+/**
+ * @def CHIP_CONFIG_GROUP_MEMBERSHIP_INDEX
+ *
+ * @brief Enables the in-memory index of group endpoints in the group data provider set up by the server
+ *
+ * When enabled, group membership lookups and the iteration of the endpoints of a group, used to dispatch group commands,
+ * are answered from memory instead of reading the group lists from storage. The index holds up to
+ * CHIP_CONFIG_MAX_GROUPS_PER_FABRIC groups of CHIP_CONFIG_MAX_GROUP_ENDPOINTS_PER_FABRIC endpoints for each of the
+ * CHIP_CONFIG_MAX_FABRICS fabrics, using 2 * (3 + CHIP_CONFIG_MAX_GROUP_ENDPOINTS_PER_FABRIC) bytes for each slot, with
+ * twice as many slots as groups rounded up to a power of two. A fabric whose groups do not fit is served from storage.
+ */
+#ifndef CHIP_CONFIG_GROUP_MEMBERSHIP_INDEX
+#define CHIP_CONFIG_GROUP_MEMBERSHIP_INDEX 1
+#endif
+
+/**
+ * @def CHIP_CONFIG_GROUP_DATA_CACHE_SIZE
+ *
+ * @brief Defines the number of group data records the server keeps in memory
+ *
+ * When non-zero, the group data provider set up by the server reads and writes its records (fabrics, groups, group
+ * endpoints and group key maps) through a write-through cache of that many records. Each record takes about 170 bytes of
+ * RAM. Keeping all the group data of F fabrics in memory takes 1 + F * (1 + groups + group endpoints + group key maps)
+ * records; the least recently used records are dropped when the cache is full. Group command dispatch does not need the
+ * cache, see CHIP_CONFIG_GROUP_MEMBERSHIP_INDEX. Set to 0 to disable the cache.
+ */
+#ifndef CHIP_CONFIG_GROUP_DATA_CACHE_SIZE
+#define CHIP_CONFIG_GROUP_DATA_CACHE_SIZE 0
+#endif
+
 /**
  * @def CHIP_CONFIG_MAX_GROUP_NAME_LENGTH
  *
@@ -1470,6 +1514,19 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_MAX_SUBSCRIPTION_RESUMPTION_STORAGE_CONCURRENT_ITERATORS 2
 #endif
 
+/**
+ * @def CHIP_CONFIG_SUBSCRIPTION_RESUMPTION_MAX_CONCURRENT_PEERS
+ *
+ * @brief Maximum number of peers whose persisted subscriptions are resumed at the same time
+ *
+ * All the subscriptions of a peer are resumed together over a single CASE session. Peers beyond this limit wait for the
+ * resumptions in progress to complete, which bounds the number of concurrent CASE establishments and priming reports after a
+ * reboot.
+ */
+#ifndef CHIP_CONFIG_SUBSCRIPTION_RESUMPTION_MAX_CONCURRENT_PEERS
+#define CHIP_CONFIG_SUBSCRIPTION_RESUMPTION_MAX_CONCURRENT_PEERS 4
+#endif
+
 /**
  * @brief Maximum length of Scene names
  */
@@ -1581,6 +1638,18 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #endif // CHIP_CONFIG_TEST
 #endif // CHIP_CONFIG_MAX_SCENES_TABLE_SIZE
 
+/**
+ * @def CHIP_CONFIG_SCENES_TABLE_CACHE_SIZE
+ *
+ * @brief Number of scene table records (endpoint scene counts, fabric scene maps and scenes) kept in memory by the default scene
+ * table, so that they are read from storage only once. Each record takes about CHIP_CONFIG_SCENES_MAX_SERIALIZED_SCENE_SIZE_BYTES
+ * of RAM. Keeping the index of E endpoints used by F fabrics in memory takes E * (F + 1) records. The least recently used
+ * records are dropped when the cache is full. 0 disables the cache.
+ */
+#ifndef CHIP_CONFIG_SCENES_TABLE_CACHE_SIZE
+#define CHIP_CONFIG_SCENES_TABLE_CACHE_SIZE 0
+#endif // CHIP_CONFIG_SCENES_TABLE_CACHE_SIZE
+
 /**
  * @def CHIP_CONFIG_SCENES_USE_DEFAULT_HANDLERS
  *
@@ -1845,6 +1914,94 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_MAX_BDX_LOG_TRANSFERS 5
 #endif // CHIP_CONFIG_MAX_BDX_LOG_TRANSFERS
 
+/**
+ *  @def CHIP_CONFIG_BDX_WINDOW_SIZE
+ *
+ *  @brief
+ *    Default number of Block (sender drive) or BlockQuery (receiver drive) messages that the driving side of a windowed BDX
+ *    transfer keeps in flight. Only used on transports that allow more than one message in flight on an exchange, e.g. TCP.
+ */
+#ifndef CHIP_CONFIG_BDX_WINDOW_SIZE
+#define CHIP_CONFIG_BDX_WINDOW_SIZE 8
+#endif // CHIP_CONFIG_BDX_WINDOW_SIZE
+
+/**
+ *  @def CHIP_CONFIG_OTA_PROVIDER_MAX_CONCURRENT_TRANSFERS
+ *
+ *  @brief
+ *    Maximum number of BDX transfers of OTA images that an OTA Provider using chip::ota::OTATransferScheduler can admit at
+ *    the same time.
+ */
+#ifndef CHIP_CONFIG_OTA_PROVIDER_MAX_CONCURRENT_TRANSFERS
+#define CHIP_CONFIG_OTA_PROVIDER_MAX_CONCURRENT_TRANSFERS 4
+#endif // CHIP_CONFIG_OTA_PROVIDER_MAX_CONCURRENT_TRANSFERS
+
+/**
+ *  @def CHIP_CONFIG_OTA_PROVIDER_MAX_QUEUED_REQUESTORS
+ *
+ *  @brief
+ *    Maximum number of OTA Requestors that chip::ota::OTATransferScheduler keeps in line while all the transfers are in use.
+ *    Requestors beyond that number are still told when to come back, but do not hold a place in line.
+ */
+#ifndef CHIP_CONFIG_OTA_PROVIDER_MAX_QUEUED_REQUESTORS
+#define CHIP_CONFIG_OTA_PROVIDER_MAX_QUEUED_REQUESTORS 32
+#endif // CHIP_CONFIG_OTA_PROVIDER_MAX_QUEUED_REQUESTORS
+
+/**
+ *  @def CHIP_CONFIG_PACKED_ATTRIBUTE_PERSISTENCE
+ *
+ *  @brief
+ *    If asserted (1), the codegen data model stores the persisted attribute
+ *    values of each cluster instance in a single storage record, using
+ *    PackedAttributePersistenceProvider, instead of one record per attribute.
+ *    Values stored one per record are still read, and moved into the packed
+ *    records on startup.  Firmware built without this option does not read
+ *    packed records.
+ *
+ */
+#ifndef CHIP_CONFIG_PACKED_ATTRIBUTE_PERSISTENCE
+#define CHIP_CONFIG_PACKED_ATTRIBUTE_PERSISTENCE 0
+#endif // CHIP_CONFIG_PACKED_ATTRIBUTE_PERSISTENCE
+
+/**
+ *  @def CHIP_CONFIG_PACKED_ATTRIBUTE_RECORD_MAX_SIZE
+ *
+ *  @brief
+ *    Maximum size of the storage record PackedAttributePersistenceProvider
+ *    keeps the persisted attribute values of a cluster instance in.  Values
+ *    that do not fit are stored under their own key instead.
+ *
+ */
+#ifndef CHIP_CONFIG_PACKED_ATTRIBUTE_RECORD_MAX_SIZE
+#define CHIP_CONFIG_PACKED_ATTRIBUTE_RECORD_MAX_SIZE 1024
+#endif // CHIP_CONFIG_PACKED_ATTRIBUTE_RECORD_MAX_SIZE
+
+/**
+ *  @def CHIP_CONFIG_COALESCED_ATTRIBUTE_PERSISTENCE
+ *
+ *  @brief
+ *    If asserted (1), the codegen data model installs a
+ *    CoalescingAttributePersistenceProvider in front of its default attribute
+ *    persister, so that attributes written in quick succession reach storage
+ *    once.  Pending values are written on shutdown.
+ *
+ */
+#ifndef CHIP_CONFIG_COALESCED_ATTRIBUTE_PERSISTENCE
+#define CHIP_CONFIG_COALESCED_ATTRIBUTE_PERSISTENCE 0
+#endif // CHIP_CONFIG_COALESCED_ATTRIBUTE_PERSISTENCE
+
+/**
+ *  @def CHIP_CONFIG_COALESCED_ATTRIBUTE_PERSISTENCE_SLOTS
+ *
+ *  @brief
+ *    Number of attribute values the CoalescingAttributePersistenceProvider
+ *    installed by CHIP_CONFIG_COALESCED_ATTRIBUTE_PERSISTENCE keeps in memory.
+ *
+ */
+#ifndef CHIP_CONFIG_COALESCED_ATTRIBUTE_PERSISTENCE_SLOTS
+#define CHIP_CONFIG_COALESCED_ATTRIBUTE_PERSISTENCE_SLOTS 8
+#endif // CHIP_CONFIG_COALESCED_ATTRIBUTE_PERSISTENCE_SLOTS
+
 /**
  *  @def CHIP_CONFIG_TEST_GOOGLETEST
  *
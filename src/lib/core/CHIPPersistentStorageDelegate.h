@@ -25,6 +25,20 @@
 
 namespace chip {
 
+/**
+ * Receives the keys enumerated by PersistentStorageDelegate::SyncForEachKey().
+ */
+class DLL_EXPORT PersistentStorageKeyVisitor
+{
+public:
+    virtual ~PersistentStorageKeyVisitor() {}
+
+    /**
+     * Called once for each stored key. Returning an error stops the enumeration, which then returns that error.
+     */
+    virtual CHIP_ERROR OnKey(const char * key) = 0;
+};
+
 class DLL_EXPORT PersistentStorageDelegate
 {
 public:
@@ -110,6 +124,106 @@ public:
         CHIP_ERROR err = SyncGetKeyValue(key, nullptr, size);
         return (err == CHIP_ERROR_BUFFER_TOO_SMALL) || (err == CHIP_NO_ERROR);
     }
+
+    /**
+     * @brief
+     *   Start a batch of writes. All SyncSetKeyValue and SyncDeleteKeyValue calls made until the matching
+     *   CommitBatch() are made durable together: after a power loss either all of them or none of them
+     *   are visible. Reads made while a batch is open observe the writes already made in the batch.
+     *
+     *   Batches may be nested. Nested batches are merged into the outermost one: the writes of a committed
+     *   nested batch only become durable with the outermost CommitBatch(), and aborting a nested batch aborts
+     *   the outermost one as well, whose CommitBatch() then discards all the writes and fails with
+     *   CHIP_ERROR_CANCELLED.
+     *
+     *   The default implementation provides no atomicity: writes are applied as they are made, and
+     *   CommitBatch() and AbortBatch() do nothing. Callers must therefore still leave storage in a
+     *   consistent state if a batch is aborted.
+     *
+     * @return CHIP_NO_ERROR on success, or another CHIP_ERROR value from implementation on failure.
+     */
+    virtual CHIP_ERROR StartBatch() { return CHIP_NO_ERROR; }
+
+    /**
+     * @brief
+     *   Commit the batch started by the matching StartBatch().
+     *
+     * @return CHIP_NO_ERROR if the writes of the batch were made durable, CHIP_ERROR_CANCELLED if a nested batch
+     *         was aborted, or another CHIP_ERROR value from implementation on failure. On failure, none of the
+     *         writes of the batch are persisted.
+     */
+    virtual CHIP_ERROR CommitBatch() { return CHIP_NO_ERROR; }
+
+    /**
+     * @brief
+     *   Abort the batch started by the matching StartBatch(), discarding all the writes made since.
+     */
+    virtual void AbortBatch() {}
+
+    /**
+     * @brief
+     *   Enumerate all the keys held by the storage, in no particular order.
+     *
+     *   The visitor may read values, but must not write or delete keys while the enumeration is in progress.
+     *
+     *   The default implementation does not support enumeration.
+     *
+     * @param[in] visitor Visitor called for each key.
+     *
+     * @return CHIP_NO_ERROR once all the keys were visited, CHIP_ERROR_NOT_IMPLEMENTED if the storage cannot
+     *         enumerate its keys, or the first error returned by the visitor.
+     */
+    virtual CHIP_ERROR SyncForEachKey(PersistentStorageKeyVisitor & visitor) { return CHIP_ERROR_NOT_IMPLEMENTED; }
+};
+
+/**
+ * Scoped helper for PersistentStorageDelegate batches.
+ *
+ * A batch is started on construction and aborted on destruction unless Commit() or Abort() was called first.
+ * A null storage delegate is accepted, in which case Commit() and Abort() are no-ops.
+ */
+class PersistentStorageBatch
+{
+public:
+    explicit PersistentStorageBatch(PersistentStorageDelegate * storage) : mStorage(storage)
+    {
+        if ((mStorage != nullptr) && (mStorage->StartBatch() != CHIP_NO_ERROR))
+        {
+            // Writes will simply not be batched.
+            mStorage = nullptr;
+        }
+    }
+
+    ~PersistentStorageBatch()
+    {
+        if (mStorage != nullptr)
+        {
+            mStorage->AbortBatch();
+        }
+    }
+
+    PersistentStorageBatch(const PersistentStorageBatch &)             = delete;
+    PersistentStorageBatch & operator=(const PersistentStorageBatch &) = delete;
+
+    CHIP_ERROR Commit()
+    {
+        PersistentStorageDelegate * storage = mStorage;
+        mStorage                            = nullptr;
+        return (storage != nullptr) ? storage->CommitBatch() : CHIP_NO_ERROR;
+    }
+
+    void Abort()
+    {
+        PersistentStorageDelegate * storage = mStorage;
+        mStorage                            = nullptr;
+        if (storage != nullptr)
+        {
+            storage->AbortBatch();
+        }
+    }
+
+private:
+    PersistentStorageDelegate * mStorage;
 };
 
 } // namespace chip
@@ -56,6 +56,24 @@ void RegisterOtaCommands();
  */
 void RegisterStatCommands();
 
+/**
+ * This function registers the latency histogram commands.
+ *
+ */
+void RegisterHistogramCommands();
+
+/**
+ * This function registers the event loop profiler commands.
+ *
+ */
+void RegisterEventLoopCommands();
+
+/**
+ * This function registers the session traffic accounting commands.
+ *
+ */
+void RegisterTrafficCommands();
+
 /**
  * This function registers the device onboarding codes commands.
  *
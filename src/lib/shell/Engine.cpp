@@ -28,6 +28,7 @@
 #include <lib/support/CHIPMem.h>
 #include <lib/support/CodeUtils.h>
 #include <lib/support/logging/CHIPLogging.h>
+#include <matter/tracing/build_config.h>
 #include <platform/CHIPDeviceLayer.h>
 
 #include <assert.h>
@@ -118,6 +119,9 @@ void Engine::RegisterDefaultCommands()
     RegisterConfigCommands();
     RegisterDeviceCommands();
     RegisterOnboardingCodesCommands();
+#if CHIP_CONFIG_ENABLE_TRAFFIC_COUNTERS
+    RegisterTrafficCommands();
+#endif
 #endif
 #if CHIP_DEVICE_CONFIG_ENABLE_NFC_ONBOARDING_PAYLOAD
     RegisterNFCCommands();
@@ -129,6 +133,12 @@ void Engine::RegisterDefaultCommands()
 #if CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
     RegisterStatCommands();
 #endif
+#if MATTER_TRACING_HISTOGRAMS_ENABLED
+    RegisterHistogramCommands();
+#endif
+#if CHIP_SYSTEM_CONFIG_EVENT_LOOP_PROFILER
+    RegisterEventLoopCommands();
+#endif
 }
 
 } // namespace Shell
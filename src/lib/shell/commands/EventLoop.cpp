@@ -0,0 +1,140 @@
+/*
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <lib/shell/Commands.h>
+#include <lib/shell/Engine.h>
+#include <lib/shell/SubShellCommand.h>
+#include <matter/tracing/build_config.h>
+#include <platform/PlatformManager.h>
+#include <system/SystemEventLoopProfiler.h>
+
+#if MATTER_TRACING_ENABLED
+#include <tracing/event_loop/event_loop_backend.h>
+#include <tracing/registry.h>
+#endif // MATTER_TRACING_ENABLED
+
+#include <inttypes.h>
+
+using namespace chip;
+
+namespace chip {
+namespace Shell {
+namespace {
+
+using System::EventLoopProfiler;
+
+CHIP_ERROR EventLoopEnableHandler(int argc, char ** argv)
+{
+    DeviceLayer::StackLock lock;
+    EventLoopProfiler::GetInstance().SetEnabled(true);
+#if MATTER_TRACING_ENABLED
+    Tracing::Register(Tracing::EventLoop::EventLoopBackend::GetInstance());
+#endif // MATTER_TRACING_ENABLED
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR EventLoopDisableHandler(int argc, char ** argv)
+{
+    DeviceLayer::StackLock lock;
+#if MATTER_TRACING_ENABLED
+    Tracing::Unregister(Tracing::EventLoop::EventLoopBackend::GetInstance());
+#endif // MATTER_TRACING_ENABLED
+    EventLoopProfiler::GetInstance().SetEnabled(false);
+    return CHIP_NO_ERROR;
+}
+
+void PrintKindStats(const EventLoopProfiler & profiler, EventLoopProfiler::DispatchKind kind)
+{
+    const EventLoopProfiler::KindStats & stats = profiler.GetStats(kind);
+    VerifyOrReturn(stats.count != 0);
+
+    streamer_printf(streamer_get(), "%s: %" PRIu32 " dispatches, total %" PRIu64 " us, max %" PRIu32 " us\r\n",
+                    EventLoopProfiler::KindToString(kind), stats.count, stats.totalTime.count(), stats.maxDuration.count());
+
+    for (size_t i = 0; i < EventLoopProfiler::kLagBucketCount; i++)
+    {
+        if (stats.lagHistogram[i] == 0)
+        {
+            continue;
+        }
+        if (i + 1 < EventLoopProfiler::kLagBucketCount)
+        {
+            streamer_printf(streamer_get(), "  lag < %" PRIu32 " ms: %" PRIu32 "\r\n",
+                            EventLoopProfiler::GetLagBucketLimit(i).count(), stats.lagHistogram[i]);
+        }
+        else
+        {
+            streamer_printf(streamer_get(), "  lag >= %" PRIu32 " ms: %" PRIu32 "\r\n",
+                            EventLoopProfiler::GetLagBucketLimit(i - 1).count(), stats.lagHistogram[i]);
+        }
+    }
+}
+
+CHIP_ERROR EventLoopShowHandler(int argc, char ** argv)
+{
+    DeviceLayer::StackLock lock;
+    const EventLoopProfiler & profiler = EventLoopProfiler::GetInstance();
+
+    for (size_t i = 0; i < EventLoopProfiler::kKindCount; i++)
+    {
+        PrintKindStats(profiler, static_cast<EventLoopProfiler::DispatchKind>(i));
+    }
+
+    EventLoopProfiler::DispatchRecord slowest[EventLoopProfiler::kSlowestCount];
+    size_t count = profiler.GetSlowestDispatches(slowest, ArraySize(slowest));
+
+    streamer_printf(streamer_get(), "Slowest dispatches:\r\n");
+    for (size_t i = 0; i < count; i++)
+    {
+        const EventLoopProfiler::DispatchRecord & record = slowest[i];
+        streamer_printf(streamer_get(), "  %" PRIu32 " us at %" PRIu64 " ms: %s 0x%" PRIxPTR, record.duration.count(),
+                        record.start.count(), EventLoopProfiler::KindToString(record.kind), record.origin);
+        for (uint8_t j = 0; j < record.labelCount; j++)
+        {
+            streamer_printf(streamer_get(), "%s%s", (j == 0) ? " [" : " > ", record.labels[j]);
+        }
+        streamer_printf(streamer_get(), "%s\r\n", (record.labelCount != 0) ? "]" : "");
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR EventLoopResetHandler(int argc, char ** argv)
+{
+    DeviceLayer::StackLock lock;
+    EventLoopProfiler::GetInstance().Reset();
+    return CHIP_NO_ERROR;
+}
+
+} // namespace
+
+void RegisterEventLoopCommands()
+{
+    static constexpr Command subCommands[] = {
+        { &EventLoopEnableHandler, "enable", "Start profiling event loop dispatches and attributing them to trace scopes" },
+        { &EventLoopDisableHandler, "disable", "Stop profiling event loop dispatches" },
+        { &EventLoopShowHandler, "show", "Print dispatch times, loop lag and the slowest dispatches" },
+        { &EventLoopResetHandler, "reset", "Clear recorded dispatches" },
+    };
+
+    static constexpr Command eventLoopCommand = { &SubShellCommand<ArraySize(subCommands), subCommands>, "eventloop",
+                                                  "Event loop profiler commands" };
+
+    Engine::Root().RegisterCommands(&eventLoopCommand, 1);
+}
+
+} // namespace Shell
+} // namespace chip
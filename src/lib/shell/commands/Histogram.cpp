@@ -0,0 +1,81 @@
+/*
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <lib/shell/Commands.h>
+#include <lib/shell/Engine.h>
+#include <lib/shell/SubShellCommand.h>
+#include <lib/support/StringBuilder.h>
+#include <platform/PlatformManager.h>
+#include <tracing/histogram/histogram_backend.h>
+#include <tracing/registry.h>
+
+using namespace chip;
+
+namespace chip {
+namespace Shell {
+namespace {
+
+using Tracing::Histograms::HistogramBackend;
+
+CHIP_ERROR HistogramEnableHandler(int argc, char ** argv)
+{
+    HistogramBackend & backend = HistogramBackend::GetInstance();
+    ReturnErrorOnFailure(backend.TrackDefaults());
+
+    DeviceLayer::StackLock lock;
+    Tracing::Register(backend);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR HistogramDisableHandler(int argc, char ** argv)
+{
+    DeviceLayer::StackLock lock;
+    Tracing::Unregister(HistogramBackend::GetInstance());
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR HistogramShowHandler(int argc, char ** argv)
+{
+    StringBuilder<1024> snapshot;
+    ReturnErrorOnFailure(HistogramBackend::GetInstance().WriteTextSnapshot(snapshot));
+    streamer_printf(streamer_get(), "%s", snapshot.c_str());
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR HistogramResetHandler(int argc, char ** argv)
+{
+    return HistogramBackend::GetInstance().Reset();
+}
+
+} // namespace
+
+void RegisterHistogramCommands()
+{
+    static constexpr Command subCommands[] = {
+        { &HistogramEnableHandler, "enable", "Start recording latencies of core operations" },
+        { &HistogramDisableHandler, "disable", "Stop recording latencies" },
+        { &HistogramShowHandler, "show", "Print latency percentiles in microseconds" },
+        { &HistogramResetHandler, "reset", "Clear recorded latencies" },
+    };
+
+    static constexpr Command histogramCommand = { &SubShellCommand<ArraySize(subCommands), subCommands>, "histogram",
+                                                  "Latency histogram commands" };
+
+    Engine::Root().RegisterCommands(&histogramCommand, 1);
+}
+
+} // namespace Shell
+} // namespace chip
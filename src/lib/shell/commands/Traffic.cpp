@@ -0,0 +1,85 @@
+/*
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/server/Server.h>
+#include <inttypes.h>
+#include <lib/shell/Commands.h>
+#include <lib/shell/Engine.h>
+#include <lib/shell/SubShellCommand.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <platform/PlatformManager.h>
+#include <transport/TrafficCounters.h>
+
+using namespace chip;
+
+namespace chip {
+namespace Shell {
+namespace {
+
+void PrintTrafficCounters(const Transport::TrafficCounters & counters)
+{
+    streamer_printf(streamer_get(),
+                    "tx %" PRIu32 " msgs/%" PRIu64 " B, rx %" PRIu32 " msgs/%" PRIu64 " B, retrans %" PRIu32
+                    ", auth failures %" PRIu32 ", crypto %" PRIu64 " us\r\n",
+                    counters.GetMessagesSent(), counters.GetBytesSent(), counters.GetMessagesReceived(), counters.GetBytesReceived(),
+                    counters.GetRetransmissions(), counters.GetAuthenticationFailures(), counters.GetCryptoTime().count());
+}
+
+CHIP_ERROR TrafficPeersHandler(int argc, char ** argv)
+{
+    DeviceLayer::StackLock lock;
+
+    Server::GetInstance().GetSecureSessionManager().ForEachPeerTrafficCounters(
+        [](const ScopedNodeId & peer, const Transport::TrafficCounters & counters) {
+            streamer_printf(streamer_get(), "%u:" ChipLogFormatX64 " ", peer.GetFabricIndex(), ChipLogValueX64(peer.GetNodeId()));
+            PrintTrafficCounters(counters);
+        });
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR TrafficFabricsHandler(int argc, char ** argv)
+{
+    DeviceLayer::StackLock lock;
+
+    SessionManager & sessionManager = Server::GetInstance().GetSecureSessionManager();
+    for (const auto & fabricInfo : Server::GetInstance().GetFabricTable())
+    {
+        streamer_printf(streamer_get(), "Fabric %u: ", fabricInfo.GetFabricIndex());
+        PrintTrafficCounters(sessionManager.GetFabricTrafficCounters(fabricInfo.GetFabricIndex()));
+    }
+
+    streamer_printf(streamer_get(), "No fabric: ");
+    PrintTrafficCounters(sessionManager.GetFabricTrafficCounters(kUndefinedFabricIndex));
+    return CHIP_NO_ERROR;
+}
+
+} // namespace
+
+void RegisterTrafficCommands()
+{
+    static constexpr Command subCommands[] = {
+        { &TrafficPeersHandler, "peers", "Print traffic counters of each peer with an open secure session" },
+        { &TrafficFabricsHandler, "fabrics", "Print traffic counters of each fabric, including closed sessions" },
+    };
+
+    static constexpr Command trafficCommand = { &SubShellCommand<ArraySize(subCommands), subCommands>, "traffic",
+                                                "Traffic accounting commands" };
+
+    Engine::Root().RegisterCommands(&trafficCommand, 1);
+}
+
+} // namespace Shell
+} // namespace chip
@@ -0,0 +1,60 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <lib/support/Crc32.h>
+
+#include <array>
+
+namespace chip {
+namespace {
+
+constexpr uint32_t kPolynomial = 0xEDB88320u;
+
+constexpr std::array<uint32_t, 256> MakeTable()
+{
+    std::array<uint32_t, 256> table{};
+    for (uint32_t i = 0; i < 256; i++)
+    {
+        uint32_t value = i;
+        for (int bit = 0; bit < 8; bit++)
+        {
+            value = (value & 1u) ? ((value >> 1) ^ kPolynomial) : (value >> 1);
+        }
+        table[i] = value;
+    }
+    return table;
+}
+
+constexpr std::array<uint32_t, 256> kTable = MakeTable();
+
+} // namespace
+
+Crc32 & Crc32::Update(const void * data, size_t length)
+{
+    const uint8_t * bytes = static_cast<const uint8_t *>(data);
+    uint32_t state        = mState;
+
+    for (size_t i = 0; i < length; i++)
+    {
+        state = kTable[(state ^ bytes[i]) & 0xFFu] ^ (state >> 8);
+    }
+
+    mState = state;
+    return *this;
+}
+
+} // namespace chip
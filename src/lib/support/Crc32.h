@@ -0,0 +1,50 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace chip {
+
+/**
+ * Incremental CRC-32 (IEEE 802.3, reflected polynomial 0xEDB88320) calculator.
+ *
+ * Intended for detecting torn or corrupted records in persisted data, not for
+ * any security purpose.
+ */
+class Crc32
+{
+public:
+    /// Feed more data into the checksum.
+    Crc32 & Update(const void * data, size_t length);
+
+    /// Get the checksum of all the data fed so far.
+    uint32_t Value() const { return ~mState; }
+
+    /// Reset to the initial state.
+    void Reset() { mState = 0xFFFFFFFFu; }
+
+    /// Convenience for computing the checksum of a single buffer.
+    static uint32_t Compute(const void * data, size_t length) { return Crc32().Update(data, length).Value(); }
+
+private:
+    uint32_t mState = 0xFFFFFFFFu;
+};
+
+} // namespace chip
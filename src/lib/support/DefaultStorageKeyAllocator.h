@@ -173,6 +173,14 @@ public:
         return StorageKeyName::Formatted("g/a/%x/%" PRIx32 "/%" PRIx32, endpointId, clusterId, attributeId);
     }
 
+    // Returns the key for all the attribute values of a cluster instance, packed in a single record.
+    static StorageKeyName AttributeValues(EndpointId endpointId, ClusterId clusterId)
+    {
+        // Needs at most 18 chars: 6 for "g/av//", 4 for the endpoint id, 8 for
+        // the cluster id.
+        return StorageKeyName::Formatted("g/av/%x/%" PRIx32, endpointId, clusterId);
+    }
+
     // Returns the key for Safely stored attributes.
     static StorageKeyName SafeAttributeValue(EndpointId endpointId, ClusterId clusterId, AttributeId attributeId)
     {
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <stdint.h>
 #include <string.h>
 #include <type_traits>
 
@@ -42,6 +43,9 @@ public:
 
     void operator()() const { mLambdaProxy(mLambdaBody); }
 
+    // Address of the code invoking the lambda, which is distinct for each lambda type.
+    uintptr_t GetOrigin() const { return reinterpret_cast<uintptr_t>(mLambdaProxy); }
+
 private:
     using LambdaStorage = std::aligned_storage_t<CHIP_CONFIG_LAMBDA_EVENT_SIZE, CHIP_CONFIG_LAMBDA_EVENT_ALIGN>;
     void (*mLambdaProxy)(const LambdaStorage & body);
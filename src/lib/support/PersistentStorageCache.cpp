@@ -0,0 +1,276 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <lib/support/PersistentStorageCache.h>
+
+#include <lib/support/CodeUtils.h>
+
+#include <string.h>
+
+namespace chip {
+
+CHIP_ERROR PersistentStorageCacheBase::Init(PersistentStorageDelegate * storage)
+{
+    VerifyOrReturnError(storage != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    mStorage    = storage;
+    mBatchDepth = 0;
+    Clear();
+    return CHIP_NO_ERROR;
+}
+
+void PersistentStorageCacheBase::Clear()
+{
+    for (size_t i = 0; i < mEntryCount; i++)
+    {
+        mEntries[i].mInUse = false;
+    }
+}
+
+CHIP_ERROR PersistentStorageCacheBase::SyncGetKeyValue(const char * key, void * buffer, uint16_t & size)
+{
+    VerifyOrReturnError(mStorage != nullptr, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(key != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    VerifyOrReturnError(IsCacheable(key), mStorage->SyncGetKeyValue(key, buffer, size));
+
+    Entry * entry = Find(key);
+    if (entry == nullptr)
+    {
+        entry = Allocate(key);
+        VerifyOrReturnError(entry != nullptr, mStorage->SyncGetKeyValue(key, buffer, size));
+
+        uint16_t storedSize = static_cast<uint16_t>(mValueSize);
+        CHIP_ERROR err      = mStorage->SyncGetKeyValue(key, ValueOf(*entry), storedSize);
+        if (err != CHIP_NO_ERROR && err != CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND)
+        {
+            // Includes values too large to be cached.
+            entry->mInUse = false;
+            return mStorage->SyncGetKeyValue(key, buffer, size);
+        }
+
+        entry->mPresent = (err == CHIP_NO_ERROR);
+        entry->mSize    = entry->mPresent ? storedSize : 0;
+        // Reads made in a batch may observe writes that end up being aborted.
+        entry->mWrittenInBatch = (mBatchDepth > 0);
+    }
+
+    Touch(*entry);
+    VerifyOrReturnError(entry->mPresent, CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+
+    if (size < entry->mSize)
+    {
+        if (size > 0)
+        {
+            memcpy(buffer, ValueOf(*entry), size);
+        }
+        return CHIP_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    if (entry->mSize > 0)
+    {
+        memcpy(buffer, ValueOf(*entry), entry->mSize);
+    }
+    size = entry->mSize;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR PersistentStorageCacheBase::SyncSetKeyValue(const char * key, const void * value, uint16_t size)
+{
+    VerifyOrReturnError(mStorage != nullptr, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(key != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    CHIP_ERROR err = mStorage->SyncSetKeyValue(key, value, size);
+    if (err != CHIP_NO_ERROR || size > mValueSize || !IsCacheable(key))
+    {
+        // The stored value is unknown, or too large to be cached.
+        Invalidate(key);
+        return err;
+    }
+
+    Entry * entry = Find(key);
+    if (entry == nullptr)
+    {
+        entry = Allocate(key);
+        VerifyOrReturnError(entry != nullptr, CHIP_NO_ERROR);
+    }
+
+    if (size > 0)
+    {
+        memcpy(ValueOf(*entry), value, size);
+    }
+    entry->mSize    = size;
+    entry->mPresent = true;
+    entry->mWrittenInBatch |= (mBatchDepth > 0);
+    Touch(*entry);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR PersistentStorageCacheBase::SyncDeleteKeyValue(const char * key)
+{
+    VerifyOrReturnError(mStorage != nullptr, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(key != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    CHIP_ERROR err = mStorage->SyncDeleteKeyValue(key);
+    if ((err != CHIP_NO_ERROR && err != CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND) || !IsCacheable(key))
+    {
+        Invalidate(key);
+        return err;
+    }
+
+    Entry * entry = Find(key);
+    if (entry == nullptr)
+    {
+        entry = Allocate(key);
+        VerifyOrReturnError(entry != nullptr, err);
+    }
+
+    entry->mSize    = 0;
+    entry->mPresent = false;
+    entry->mWrittenInBatch |= (mBatchDepth > 0);
+    Touch(*entry);
+    return err;
+}
+
+CHIP_ERROR PersistentStorageCacheBase::StartBatch()
+{
+    VerifyOrReturnError(mStorage != nullptr, CHIP_ERROR_INCORRECT_STATE);
+    ReturnErrorOnFailure(mStorage->StartBatch());
+    mBatchDepth++;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR PersistentStorageCacheBase::CommitBatch()
+{
+    VerifyOrReturnError(mStorage != nullptr, CHIP_ERROR_INCORRECT_STATE);
+    CHIP_ERROR err = mStorage->CommitBatch();
+    EndBatch(err == CHIP_NO_ERROR);
+    return err;
+}
+
+void PersistentStorageCacheBase::AbortBatch()
+{
+    VerifyOrReturn(mStorage != nullptr);
+    mStorage->AbortBatch();
+    EndBatch(false);
+}
+
+CHIP_ERROR PersistentStorageCacheBase::SyncForEachKey(PersistentStorageKeyVisitor & visitor)
+{
+    VerifyOrReturnError(mStorage != nullptr, CHIP_ERROR_INCORRECT_STATE);
+    // Writes go through to storage, which therefore holds all the keys.
+    return mStorage->SyncForEachKey(visitor);
+}
+
+PersistentStorageCacheBase::Entry * PersistentStorageCacheBase::Find(const char * key)
+{
+    for (size_t i = 0; i < mEntryCount; i++)
+    {
+        if (mEntries[i].mInUse && strcmp(mEntries[i].mKey, key) == 0)
+        {
+            return &mEntries[i];
+        }
+    }
+    return nullptr;
+}
+
+PersistentStorageCacheBase::Entry * PersistentStorageCacheBase::Allocate(const char * key)
+{
+    size_t keyLength = strlen(key);
+    VerifyOrReturnValue(keyLength <= kKeyLengthMax, nullptr);
+
+    // Use a free entry if there is one. Otherwise evict the least recently used record of a missing key, as these are the
+    // cheapest to get back, and only then the least recently used record.
+    Entry * victim        = nullptr;
+    Entry * missingVictim = nullptr;
+    for (size_t i = 0; i < mEntryCount; i++)
+    {
+        Entry & entry = mEntries[i];
+        if (!entry.mInUse)
+        {
+            victim        = &entry;
+            missingVictim = nullptr;
+            break;
+        }
+        if (!entry.mPresent && (missingVictim == nullptr || entry.mLastUse < missingVictim->mLastUse))
+        {
+            missingVictim = &entry;
+        }
+        if (victim == nullptr || entry.mLastUse < victim->mLastUse)
+        {
+            victim = &entry;
+        }
+    }
+    if (missingVictim != nullptr)
+    {
+        victim = missingVictim;
+    }
+    VerifyOrReturnValue(victim != nullptr, nullptr);
+
+    memcpy(victim->mKey, key, keyLength + 1);
+    victim->mInUse          = true;
+    victim->mPresent        = false;
+    victim->mSize           = 0;
+    victim->mWrittenInBatch = false;
+    return victim;
+}
+
+uint8_t * PersistentStorageCacheBase::ValueOf(const Entry & entry) const
+{
+    return mValues + static_cast<size_t>(&entry - mEntries) * mValueSize;
+}
+
+void PersistentStorageCacheBase::Touch(Entry & entry)
+{
+    entry.mLastUse = ++mUseCounter;
+}
+
+void PersistentStorageCacheBase::Invalidate(const char * key)
+{
+    Entry * entry = Find(key);
+    if (entry != nullptr)
+    {
+        entry->mInUse = false;
+    }
+}
+
+void PersistentStorageCacheBase::EndBatch(bool keepWrites)
+{
+    VerifyOrReturn(mBatchDepth > 0);
+    mBatchDepth--;
+
+    for (size_t i = 0; i < mEntryCount; i++)
+    {
+        Entry & entry = mEntries[i];
+        if (!entry.mInUse || !entry.mWrittenInBatch)
+        {
+            continue;
+        }
+
+        if (!keepWrites)
+        {
+            // Storage may or may not hold the records written in the batch: read them again when next needed. Dropping them is
+            // also correct for nested batches, whose writes only become durable with the outermost one.
+            entry.mInUse = false;
+        }
+        else if (mBatchDepth == 0)
+        {
+            entry.mWrittenInBatch = false;
+        }
+    }
+}
+
+} // namespace chip
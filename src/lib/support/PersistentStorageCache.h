@@ -0,0 +1,113 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <lib/core/CHIPPersistentStorageDelegate.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace chip {
+
+/**
+ * @brief Write-through, in-memory cache of persistent storage records.
+ *
+ * Sits between a consumer and its PersistentStorageDelegate and keeps the most recently used records in memory, so that reading
+ * them again does not touch storage. Missing keys are remembered as well.
+ *
+ * Writes are applied to the underlying storage before the cache is updated, and records written in a batch that is then aborted
+ * or fails to commit are dropped from the cache. Values larger than the value size of the cache, and keys for which
+ * IsCacheable() returns false, are never cached.
+ *
+ * The cache assumes it is the only writer of the keys it caches.
+ */
+class PersistentStorageCacheBase : public PersistentStorageDelegate
+{
+public:
+    struct Entry
+    {
+        char mKey[kKeyLengthMax + 1] = { 0 };
+        uint32_t mLastUse            = 0;
+        uint16_t mSize               = 0;
+        bool mInUse                  = false;
+        bool mPresent                = false;
+        bool mWrittenInBatch         = false;
+    };
+
+    /// @brief Sets the storage the cache is in front of, and empties the cache.
+    /// @param storage Underlying storage, must outlive the cache
+    CHIP_ERROR Init(PersistentStorageDelegate * storage);
+
+    /// @brief Drops all the cached records.
+    void Clear();
+
+    /// @brief Size of the largest value that can be cached.
+    size_t GetMaxValueSize() const { return mValueSize; }
+
+    // PersistentStorageDelegate implementation
+    CHIP_ERROR SyncGetKeyValue(const char * key, void * buffer, uint16_t & size) override;
+    CHIP_ERROR SyncSetKeyValue(const char * key, const void * value, uint16_t size) override;
+    CHIP_ERROR SyncDeleteKeyValue(const char * key) override;
+    CHIP_ERROR StartBatch() override;
+    CHIP_ERROR CommitBatch() override;
+    void AbortBatch() override;
+    CHIP_ERROR SyncForEachKey(PersistentStorageKeyVisitor & visitor) override;
+
+protected:
+    PersistentStorageCacheBase(Entry * entries, uint8_t * values, size_t entryCount, size_t valueSize) :
+        mEntries(entries), mValues(values), mEntryCount(entryCount), mValueSize(valueSize)
+    {}
+
+    /// @brief Whether the record stored under `key` may be kept in memory. All records are cacheable by default.
+    virtual bool IsCacheable(const char * key) const { return true; }
+
+private:
+    Entry * Find(const char * key);
+    Entry * Allocate(const char * key);
+    uint8_t * ValueOf(const Entry & entry) const;
+    void Touch(Entry & entry);
+    void Invalidate(const char * key);
+    void EndBatch(bool keepWrites);
+
+    Entry * mEntries;
+    uint8_t * mValues;
+    size_t mEntryCount;
+    size_t mValueSize;
+    PersistentStorageDelegate * mStorage = nullptr;
+    uint32_t mUseCounter                 = 0;
+    uint32_t mBatchDepth                 = 0;
+};
+
+/**
+ * @brief PersistentStorageCacheBase holding up to kEntryCount records of at most kValueSize bytes each.
+ */
+template <size_t kEntryCount, size_t kValueSize>
+class PersistentStorageCache : public PersistentStorageCacheBase
+{
+public:
+    static_assert(kEntryCount > 0, "A persistent storage cache needs at least one entry");
+    static_assert(kValueSize > 0 && kValueSize <= UINT16_MAX, "Cached values must fit in a storage record");
+
+    PersistentStorageCache() : PersistentStorageCacheBase(mEntryStorage, mValueStorage, kEntryCount, kValueSize) {}
+
+private:
+    Entry mEntryStorage[kEntryCount];
+    uint8_t mValueStorage[kEntryCount * kValueSize];
+};
+
+} // namespace chip
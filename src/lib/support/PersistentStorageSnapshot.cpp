@@ -0,0 +1,264 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <lib/support/PersistentStorageSnapshot.h>
+
+#include <lib/core/CHIPEncoding.h>
+#include <lib/core/CHIPSafeCasts.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+#include <algorithm>
+#include <string.h>
+
+namespace chip {
+
+using namespace PersistentStorageSnapshot;
+
+//
+// Exporter
+//
+
+CHIP_ERROR PersistentStorageSnapshotExporter::Begin()
+{
+    VerifyOrReturnError(mState == State::kIdle, CHIP_ERROR_INCORRECT_STATE);
+
+    uint8_t header[kHeaderSize] = { 0 };
+    memcpy(header, kMagic, sizeof(kMagic));
+    header[sizeof(kMagic)] = kVersion;
+
+    mCrc.Reset();
+    mRecordCount = 0;
+    ReturnErrorOnFailure(Emit(header, sizeof(header)));
+    mState = State::kRecords;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR PersistentStorageSnapshotExporter::ExportKey(const char * key)
+{
+    VerifyOrReturnError(mState == State::kRecords, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(key != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    size_t keyLength = strlen(key);
+    VerifyOrReturnError(keyLength > 0 && keyLength <= PersistentStorageDelegate::kKeyLengthMax, CHIP_ERROR_INVALID_ARGUMENT);
+
+    uint16_t valueLength = static_cast<uint16_t>(std::min<size_t>(mValueBuffer.size(), UINT16_MAX));
+    CHIP_ERROR err       = mStorage.SyncGetKeyValue(key, mValueBuffer.data(), valueLength);
+    VerifyOrReturnError(err != CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND, CHIP_NO_ERROR);
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(Support, "Snapshot export of key %s failed: %" CHIP_ERROR_FORMAT, key, err.Format());
+        return err;
+    }
+    VerifyOrReturnError(mRecordCount < UINT32_MAX, CHIP_ERROR_NO_MEMORY);
+
+    uint8_t field[2];
+    field[0] = static_cast<uint8_t>(keyLength);
+    ReturnErrorOnFailure(Emit(field, 1));
+    ReturnErrorOnFailure(Emit(Uint8::from_const_char(key), keyLength));
+    Encoding::LittleEndian::Put16(field, valueLength);
+    ReturnErrorOnFailure(Emit(field, sizeof(field)));
+    ReturnErrorOnFailure(Emit(mValueBuffer.data(), valueLength));
+
+    mRecordCount++;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR PersistentStorageSnapshotExporter::ExportAllKeys()
+{
+    VerifyOrReturnError(mState == State::kRecords, CHIP_ERROR_INCORRECT_STATE);
+    return mStorage.SyncForEachKey(*this);
+}
+
+CHIP_ERROR PersistentStorageSnapshotExporter::End()
+{
+    VerifyOrReturnError(mState == State::kRecords, CHIP_ERROR_INCORRECT_STATE);
+
+    uint8_t trailer[kTrailerSize] = { 0 };
+    Encoding::LittleEndian::Put32(&trailer[1], mRecordCount);
+    ReturnErrorOnFailure(Emit(trailer, 5));
+    // The checksum covers everything that precedes it.
+    Encoding::LittleEndian::Put32(&trailer[5], mCrc.Value());
+    ReturnErrorOnFailure(mSink.Write(ByteSpan(&trailer[5], 4)));
+
+    mState = State::kDone;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR PersistentStorageSnapshotExporter::Emit(const uint8_t * data, size_t length)
+{
+    VerifyOrReturnError(length > 0, CHIP_NO_ERROR);
+    mCrc.Update(data, length);
+    return mSink.Write(ByteSpan(data, length));
+}
+
+//
+// Importer
+//
+
+PersistentStorageSnapshotImporter::~PersistentStorageSnapshotImporter()
+{
+    if (mBatchOpen)
+    {
+        mStorage->AbortBatch();
+    }
+}
+
+CHIP_ERROR PersistentStorageSnapshotImporter::Feed(ByteSpan data)
+{
+    ReturnErrorOnFailure(mError);
+
+    CHIP_ERROR err = Consume(data);
+    if (err != CHIP_NO_ERROR)
+    {
+        Fail(err);
+    }
+    return err;
+}
+
+CHIP_ERROR PersistentStorageSnapshotImporter::Finish()
+{
+    ReturnErrorOnFailure(mError);
+
+    if (mState != State::kDone)
+    {
+        Fail(CHIP_ERROR_MESSAGE_INCOMPLETE);
+        return mError;
+    }
+
+    VerifyOrReturnError(mBatchOpen, CHIP_NO_ERROR);
+    mBatchOpen     = false;
+    CHIP_ERROR err = mStorage->CommitBatch();
+    if (err != CHIP_NO_ERROR)
+    {
+        mError = err;
+    }
+    return err;
+}
+
+bool PersistentStorageSnapshotImporter::Collect(ByteSpan & data, uint8_t * dest, size_t length)
+{
+    size_t chunk = std::min(length - mFieldOffset, data.size());
+    if (chunk > 0)
+    {
+        memcpy(dest + mFieldOffset, data.data(), chunk);
+        if (mState != State::kChecksum)
+        {
+            mCrc.Update(data.data(), chunk);
+        }
+        data = data.SubSpan(chunk);
+        mFieldOffset += chunk;
+    }
+
+    VerifyOrReturnValue(mFieldOffset == length, false);
+    mFieldOffset = 0;
+    return true;
+}
+
+CHIP_ERROR PersistentStorageSnapshotImporter::Consume(ByteSpan & data)
+{
+    while (!data.empty())
+    {
+        switch (mState)
+        {
+        case State::kHeader:
+            VerifyOrReturnError(Collect(data, mField, kHeaderSize), CHIP_NO_ERROR);
+            VerifyOrReturnError(memcmp(mField, kMagic, sizeof(kMagic)) == 0, CHIP_ERROR_INVALID_ARGUMENT);
+            VerifyOrReturnError(mField[sizeof(kMagic)] == kVersion, CHIP_ERROR_VERSION_MISMATCH);
+            if (mStorage != nullptr)
+            {
+                ReturnErrorOnFailure(mStorage->StartBatch());
+                mBatchOpen = true;
+            }
+            mState = State::kKeyLength;
+            break;
+
+        case State::kKeyLength:
+            VerifyOrReturnError(Collect(data, mField, 1), CHIP_NO_ERROR);
+            mKeyLength = mField[0];
+            VerifyOrReturnError(mKeyLength <= PersistentStorageDelegate::kKeyLengthMax, CHIP_ERROR_INVALID_ARGUMENT);
+            mState = (mKeyLength == 0) ? State::kRecordCount : State::kKey;
+            break;
+
+        case State::kKey:
+            VerifyOrReturnError(Collect(data, Uint8::from_char(mKey), mKeyLength), CHIP_NO_ERROR);
+            mKey[mKeyLength] = '\0';
+            VerifyOrReturnError(strlen(mKey) == mKeyLength, CHIP_ERROR_INVALID_ARGUMENT);
+            mState = State::kValueLength;
+            break;
+
+        case State::kValueLength:
+            VerifyOrReturnError(Collect(data, mField, 2), CHIP_NO_ERROR);
+            mValueLength = Encoding::LittleEndian::Get16(mField);
+            VerifyOrReturnError(mValueLength <= mValueBuffer.size(), CHIP_ERROR_BUFFER_TOO_SMALL);
+            mState = State::kValue;
+            if (mValueLength == 0)
+            {
+                ReturnErrorOnFailure(StoreRecord());
+            }
+            break;
+
+        case State::kValue:
+            VerifyOrReturnError(Collect(data, mValueBuffer.data(), mValueLength), CHIP_NO_ERROR);
+            ReturnErrorOnFailure(StoreRecord());
+            break;
+
+        case State::kRecordCount:
+            VerifyOrReturnError(Collect(data, mField, 4), CHIP_NO_ERROR);
+            VerifyOrReturnError(Encoding::LittleEndian::Get32(mField) == mRecordCount, CHIP_ERROR_INTEGRITY_CHECK_FAILED);
+            mState = State::kChecksum;
+            break;
+
+        case State::kChecksum:
+            VerifyOrReturnError(Collect(data, mField, 4), CHIP_NO_ERROR);
+            VerifyOrReturnError(Encoding::LittleEndian::Get32(mField) == mCrc.Value(), CHIP_ERROR_INTEGRITY_CHECK_FAILED);
+            mState = State::kDone;
+            break;
+
+        case State::kDone:
+            // Trailing data
+            return CHIP_ERROR_INVALID_MESSAGE_LENGTH;
+        }
+    }
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR PersistentStorageSnapshotImporter::StoreRecord()
+{
+    VerifyOrReturnError(mRecordCount < UINT32_MAX, CHIP_ERROR_INVALID_ARGUMENT);
+    if (mStorage != nullptr)
+    {
+        ReturnErrorOnFailure(mStorage->SyncSetKeyValue(mKey, mValueBuffer.data(), mValueLength));
+    }
+    mRecordCount++;
+    mState = State::kKeyLength;
+    return CHIP_NO_ERROR;
+}
+
+void PersistentStorageSnapshotImporter::Fail(CHIP_ERROR err)
+{
+    ChipLogError(Support, "Snapshot import failed after %u records: %" CHIP_ERROR_FORMAT, static_cast<unsigned>(mRecordCount),
+                 err.Format());
+    mError = err;
+    if (mBatchOpen)
+    {
+        mBatchOpen = false;
+        mStorage->AbortBatch();
+    }
+}
+
+} // namespace chip
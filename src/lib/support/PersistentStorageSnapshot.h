@@ -0,0 +1,181 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Streaming export and import of the whole contents of a PersistentStorageDelegate, used to back up a node or to
+ *      migrate it to new hardware.
+ *
+ *      A snapshot is a sequence of little-endian fields:
+ *
+ *        header   magic "MTSS" (4 bytes) | format version (1 byte) | reserved (3 bytes, zero)
+ *        record   key length (1 byte, 1 to PersistentStorageDelegate::kKeyLengthMax) | key | value length (2 bytes) | value
+ *        trailer  zero (1 byte) | record count (4 bytes) | CRC-32 of all the preceding bytes (4 bytes)
+ *
+ *      Records hold the raw values of the storage keys, so a snapshot covers every namespace of DefaultStorageKeyAllocator
+ *      (fabrics, access control, groups, scenes, attributes, subscriptions, ...) without knowing their layout.
+ */
+
+#pragma once
+
+#include <lib/core/CHIPPersistentStorageDelegate.h>
+#include <lib/support/Crc32.h>
+#include <lib/support/Span.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace chip {
+
+/**
+ * Destination of the bytes of an exported snapshot, e.g. a file or a BDX transfer.
+ */
+class PersistentStorageSnapshotSink
+{
+public:
+    virtual ~PersistentStorageSnapshotSink() = default;
+
+    virtual CHIP_ERROR Write(ByteSpan data) = 0;
+};
+
+namespace PersistentStorageSnapshot {
+
+inline constexpr uint8_t kMagic[] = { 'M', 'T', 'S', 'S' };
+inline constexpr uint8_t kVersion = 1;
+
+inline constexpr size_t kHeaderSize  = sizeof(kMagic) + 4;
+inline constexpr size_t kTrailerSize = 1 + 4 + 4;
+
+} // namespace PersistentStorageSnapshot
+
+/**
+ * Writes a snapshot of a storage to a sink.
+ *
+ * Usage: Begin(), then ExportAllKeys() and/or ExportKey() for individual keys, then End(). The snapshot is streamed: only one
+ * value is held in memory at a time, in the buffer given at construction, which must be large enough for the largest value.
+ */
+class PersistentStorageSnapshotExporter : private PersistentStorageKeyVisitor
+{
+public:
+    PersistentStorageSnapshotExporter(PersistentStorageDelegate & storage, PersistentStorageSnapshotSink & sink,
+                                      MutableByteSpan valueBuffer) :
+        mStorage(storage),
+        mSink(sink), mValueBuffer(valueBuffer)
+    {}
+
+    /// Writes the snapshot header.
+    CHIP_ERROR Begin();
+
+    /// Adds the current value of `key` to the snapshot. Keys not present in storage are skipped.
+    CHIP_ERROR ExportKey(const char * key);
+
+    /// Adds all the keys of the storage. Fails with CHIP_ERROR_NOT_IMPLEMENTED if the storage cannot enumerate its keys,
+    /// in which case the keys of interest can still be exported one by one with ExportKey().
+    CHIP_ERROR ExportAllKeys();
+
+    /// Writes the snapshot trailer. No record may be added afterwards.
+    CHIP_ERROR End();
+
+    uint32_t GetRecordCount() const { return mRecordCount; }
+
+private:
+    enum class State : uint8_t
+    {
+        kIdle,
+        kRecords,
+        kDone,
+    };
+
+    CHIP_ERROR OnKey(const char * key) override { return ExportKey(key); }
+    CHIP_ERROR Emit(const uint8_t * data, size_t length);
+
+    PersistentStorageDelegate & mStorage;
+    PersistentStorageSnapshotSink & mSink;
+    MutableByteSpan mValueBuffer;
+    Crc32 mCrc;
+    uint32_t mRecordCount = 0;
+    State mState          = State::kIdle;
+};
+
+/**
+ * Restores a snapshot into a storage.
+ *
+ * The snapshot can be fed in chunks of any size with Feed(), then Finish() checks that it was complete and that its checksum
+ * matches. All the records are written in a single PersistentStorageDelegate batch, which is only committed by a successful
+ * Finish(): on storages with atomic batches, an invalid or truncated snapshot leaves storage untouched. Storages without atomic
+ * batches may be left with part of the records, and snapshots from an untrusted source should first be validated by an
+ * importer constructed without storage.
+ *
+ * Keys present in storage but not in the snapshot are left as they are: importing is meant for storage that was just cleared.
+ */
+class PersistentStorageSnapshotImporter
+{
+public:
+    /**
+     * @param storage Storage to restore into, or nullptr to only validate the snapshot.
+     * @param valueBuffer Buffer large enough for the largest value of the snapshot.
+     */
+    PersistentStorageSnapshotImporter(PersistentStorageDelegate * storage, MutableByteSpan valueBuffer) :
+        mStorage(storage), mValueBuffer(valueBuffer)
+    {}
+    ~PersistentStorageSnapshotImporter();
+
+    PersistentStorageSnapshotImporter(const PersistentStorageSnapshotImporter &)             = delete;
+    PersistentStorageSnapshotImporter & operator=(const PersistentStorageSnapshotImporter &) = delete;
+
+    /// Consumes the next bytes of the snapshot. Once an error is returned, all subsequent calls fail with the same error.
+    CHIP_ERROR Feed(ByteSpan data);
+
+    /// Checks that the whole snapshot was consumed and commits the restored records.
+    CHIP_ERROR Finish();
+
+    uint32_t GetRecordCount() const { return mRecordCount; }
+
+private:
+    enum class State : uint8_t
+    {
+        kHeader,
+        kKeyLength,
+        kKey,
+        kValueLength,
+        kValue,
+        kRecordCount,
+        kChecksum,
+        kDone,
+    };
+
+    // Collects `length` bytes of a field into `dest`, returns true once the field is complete.
+    bool Collect(ByteSpan & data, uint8_t * dest, size_t length);
+    CHIP_ERROR Consume(ByteSpan & data);
+    CHIP_ERROR StoreRecord();
+    void Fail(CHIP_ERROR err);
+
+    PersistentStorageDelegate * mStorage;
+    MutableByteSpan mValueBuffer;
+    Crc32 mCrc;
+    uint8_t mField[PersistentStorageSnapshot::kHeaderSize];
+    char mKey[PersistentStorageDelegate::kKeyLengthMax + 1];
+    size_t mFieldOffset   = 0;
+    size_t mKeyLength     = 0;
+    uint16_t mValueLength = 0;
+    uint32_t mRecordCount = 0;
+    CHIP_ERROR mError     = CHIP_NO_ERROR;
+    State mState          = State::kHeader;
+    bool mBatchOpen       = false;
+};
+
+} // namespace chip
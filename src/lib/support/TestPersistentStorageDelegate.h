@@ -126,6 +126,55 @@ public:
         return err;
     }
 
+    /**
+     * Batches are emulated by snapshotting the storage contents when the
+     * outermost batch starts and restoring the snapshot if it is aborted.
+     */
+    CHIP_ERROR StartBatch() override
+    {
+        if (mBatchDepth++ == 0)
+        {
+            mBatchSnapshot = mStorage;
+        }
+        return CHIP_NO_ERROR;
+    }
+
+    CHIP_ERROR CommitBatch() override
+    {
+        VerifyOrReturnError(mBatchDepth > 0, CHIP_ERROR_INCORRECT_STATE);
+        if (--mBatchDepth > 0)
+        {
+            return mBatchAborted ? CHIP_ERROR_CANCELLED : CHIP_NO_ERROR;
+        }
+
+        if (mBatchAborted)
+        {
+            RestoreBatchSnapshot();
+            return CHIP_ERROR_CANCELLED;
+        }
+        mBatchSnapshot.clear();
+        return CHIP_NO_ERROR;
+    }
+
+    void AbortBatch() override
+    {
+        VerifyOrReturn(mBatchDepth > 0);
+        mBatchAborted = true;
+        if (--mBatchDepth == 0)
+        {
+            RestoreBatchSnapshot();
+        }
+    }
+
+    CHIP_ERROR SyncForEachKey(PersistentStorageKeyVisitor & visitor) override
+    {
+        for (const auto & key : GetKeys())
+        {
+            ReturnErrorOnFailure(visitor.OnKey(key.c_str()));
+        }
+        return CHIP_NO_ERROR;
+    }
+
     /**
      * @brief Adds a "poison key": a key that, if read/written, implies some bad
      *        behavior occurred.
@@ -276,7 +325,22 @@ protected:
         return CHIP_NO_ERROR;
     }
 
+    void RestoreBatchSnapshot()
+    {
+        if (mLoggingLevel >= LoggingLevel::kLogMutation)
+        {
+            ChipLogDetail(Test, "TestPersistentStorageDelegate::AbortBatch, Restoring %u keys",
+                          static_cast<unsigned>(mBatchSnapshot.size()));
+        }
+        mStorage = std::move(mBatchSnapshot);
+        mBatchSnapshot.clear();
+        mBatchAborted = false;
+    }
+
     std::map<std::string, std::vector<uint8_t>> mStorage;
+    std::map<std::string, std::vector<uint8_t>> mBatchSnapshot;
+    unsigned mBatchDepth = 0;
+    bool mBatchAborted   = false;
     std::set<std::string> mPoisonKeys;
     bool mRejectWrites         = false;
     LoggingLevel mLoggingLevel = LoggingLevel::kDisabled;
@@ -0,0 +1,59 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <string.h>
+
+#include <pw_unit_test/framework.h>
+
+#include <lib/core/StringBuilderAdapters.h>
+#include <lib/support/Crc32.h>
+
+using namespace chip;
+
+namespace {
+
+TEST(TestCrc32, TestKnownVectors)
+{
+    // Standard CRC-32 check value.
+    const char * check = "123456789";
+    EXPECT_EQ(Crc32::Compute(check, strlen(check)), 0xCBF43926u);
+
+    EXPECT_EQ(Crc32::Compute(nullptr, 0), 0u);
+
+    const char * fox = "The quick brown fox jumps over the lazy dog";
+    EXPECT_EQ(Crc32::Compute(fox, strlen(fox)), 0x414FA339u);
+}
+
+TEST(TestCrc32, TestIncremental)
+{
+    const char * fox = "The quick brown fox jumps over the lazy dog";
+    size_t length    = strlen(fox);
+
+    for (size_t split = 0; split <= length; split++)
+    {
+        Crc32 crc;
+        crc.Update(fox, split).Update(fox + split, length - split);
+        EXPECT_EQ(crc.Value(), 0x414FA339u);
+    }
+
+    Crc32 crc;
+    crc.Update(fox, length);
+    crc.Reset();
+    EXPECT_EQ(crc.Update("123456789", 9).Value(), 0xCBF43926u);
+}
+
+} // namespace
@@ -0,0 +1,191 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+#include <pw_unit_test/framework.h>
+
+#include <lib/core/StringBuilderAdapters.h>
+#include <lib/support/DefaultStorageKeyAllocator.h>
+#include <lib/support/PersistentStorageSnapshot.h>
+#include <lib/support/TestPersistentStorageDelegate.h>
+
+using namespace chip;
+
+namespace {
+
+class VectorSink : public PersistentStorageSnapshotSink
+{
+public:
+    CHIP_ERROR Write(ByteSpan data) override
+    {
+        mData.insert(mData.end(), data.begin(), data.end());
+        return CHIP_NO_ERROR;
+    }
+
+    std::vector<uint8_t> mData;
+};
+
+class NonEnumerableStorage : public TestPersistentStorageDelegate
+{
+public:
+    CHIP_ERROR SyncForEachKey(PersistentStorageKeyVisitor & visitor) override { return CHIP_ERROR_NOT_IMPLEMENTED; }
+};
+
+void Populate(TestPersistentStorageDelegate & storage)
+{
+    const uint8_t noc[]   = { 0x15, 0x30, 0x01, 0x08, 0x18 };
+    const uint8_t group[] = { 0x01, 0x02, 0x03 };
+    uint8_t large[1024];
+    memset(large, 0xA5, sizeof(large));
+
+    EXPECT_EQ(storage.SyncSetKeyValue(DefaultStorageKeyAllocator::FabricNOC(1).KeyName(), noc, sizeof(noc)), CHIP_NO_ERROR);
+    EXPECT_EQ(storage.SyncSetKeyValue(DefaultStorageKeyAllocator::FabricGroup(1, 0x101).KeyName(), group, sizeof(group)),
+              CHIP_NO_ERROR);
+    EXPECT_EQ(storage.SyncSetKeyValue(DefaultStorageKeyAllocator::AttributeValue(1, 6, 0).KeyName(), large, sizeof(large)),
+              CHIP_NO_ERROR);
+    EXPECT_EQ(storage.SyncSetKeyValue(DefaultStorageKeyAllocator::FabricIndexInfo().KeyName(), nullptr, 0), CHIP_NO_ERROR);
+}
+
+std::vector<uint8_t> Export(PersistentStorageDelegate & storage)
+{
+    uint8_t buffer[2048];
+    VectorSink sink;
+    PersistentStorageSnapshotExporter exporter(storage, sink, MutableByteSpan(buffer));
+    EXPECT_EQ(exporter.Begin(), CHIP_NO_ERROR);
+    EXPECT_EQ(exporter.ExportAllKeys(), CHIP_NO_ERROR);
+    EXPECT_EQ(exporter.End(), CHIP_NO_ERROR);
+    return sink.mData;
+}
+
+CHIP_ERROR Import(PersistentStorageDelegate * storage, const std::vector<uint8_t> & snapshot, size_t chunkSize)
+{
+    uint8_t buffer[2048];
+    PersistentStorageSnapshotImporter importer(storage, MutableByteSpan(buffer));
+    for (size_t offset = 0; offset < snapshot.size(); offset += chunkSize)
+    {
+        size_t length = std::min(chunkSize, snapshot.size() - offset);
+        ReturnErrorOnFailure(importer.Feed(ByteSpan(snapshot.data() + offset, length)));
+    }
+    return importer.Finish();
+}
+
+void ExpectSameContents(TestPersistentStorageDelegate & a, TestPersistentStorageDelegate & b)
+{
+    ASSERT_EQ(a.GetKeys(), b.GetKeys());
+    for (const auto & key : a.GetKeys())
+    {
+        uint8_t valueA[2048];
+        uint8_t valueB[2048];
+        uint16_t sizeA = sizeof(valueA);
+        uint16_t sizeB = sizeof(valueB);
+        EXPECT_EQ(a.SyncGetKeyValue(key.c_str(), valueA, sizeA), CHIP_NO_ERROR);
+        EXPECT_EQ(b.SyncGetKeyValue(key.c_str(), valueB, sizeB), CHIP_NO_ERROR);
+        EXPECT_EQ(sizeA, sizeB);
+        EXPECT_EQ(memcmp(valueA, valueB, sizeA), 0);
+    }
+}
+
+TEST(TestPersistentStorageSnapshot, TestRoundTrip)
+{
+    TestPersistentStorageDelegate source;
+    Populate(source);
+    std::vector<uint8_t> snapshot = Export(source);
+
+    // Any chunking of the snapshot restores the same contents.
+    for (size_t chunkSize : { size_t(1), size_t(7), snapshot.size() })
+    {
+        TestPersistentStorageDelegate destination;
+        EXPECT_EQ(Import(&destination, snapshot, chunkSize), CHIP_NO_ERROR);
+        ExpectSameContents(source, destination);
+    }
+}
+
+TEST(TestPersistentStorageSnapshot, TestExportSelectedKeys)
+{
+    NonEnumerableStorage source;
+    Populate(source);
+
+    uint8_t buffer[2048];
+    VectorSink sink;
+    PersistentStorageSnapshotExporter exporter(source, sink, MutableByteSpan(buffer));
+    EXPECT_EQ(exporter.Begin(), CHIP_NO_ERROR);
+    EXPECT_EQ(exporter.ExportAllKeys(), CHIP_ERROR_NOT_IMPLEMENTED);
+    EXPECT_EQ(exporter.ExportKey(DefaultStorageKeyAllocator::FabricNOC(1).KeyName()), CHIP_NO_ERROR);
+    // Missing keys are skipped
+    EXPECT_EQ(exporter.ExportKey(DefaultStorageKeyAllocator::FabricNOC(2).KeyName()), CHIP_NO_ERROR);
+    EXPECT_EQ(exporter.End(), CHIP_NO_ERROR);
+    EXPECT_EQ(exporter.GetRecordCount(), 1u);
+    EXPECT_EQ(exporter.ExportKey(DefaultStorageKeyAllocator::FabricNOC(1).KeyName()), CHIP_ERROR_INCORRECT_STATE);
+
+    TestPersistentStorageDelegate destination;
+    EXPECT_EQ(Import(&destination, sink.mData, sink.mData.size()), CHIP_NO_ERROR);
+    EXPECT_EQ(destination.GetNumKeys(), 1u);
+    EXPECT_TRUE(destination.HasKey(DefaultStorageKeyAllocator::FabricNOC(1).KeyName()));
+
+    // Values larger than the export buffer are reported
+    uint8_t smallBuffer[16];
+    VectorSink otherSink;
+    PersistentStorageSnapshotExporter smallExporter(source, otherSink, MutableByteSpan(smallBuffer));
+    EXPECT_EQ(smallExporter.Begin(), CHIP_NO_ERROR);
+    EXPECT_EQ(smallExporter.ExportKey(DefaultStorageKeyAllocator::AttributeValue(1, 6, 0).KeyName()),
+              CHIP_ERROR_BUFFER_TOO_SMALL);
+}
+
+TEST(TestPersistentStorageSnapshot, TestCorruptSnapshotIsNotApplied)
+{
+    TestPersistentStorageDelegate source;
+    Populate(source);
+    std::vector<uint8_t> snapshot = Export(source);
+
+    const char kExistingKey[] = "g/existing";
+    const uint8_t kExisting[] = { 42 };
+
+    // Flip one bit of a value: the checksum no longer matches and the batch is aborted.
+    std::vector<uint8_t> corrupt = snapshot;
+    corrupt[corrupt.size() / 2] ^= 0x10;
+    TestPersistentStorageDelegate destination;
+    EXPECT_EQ(destination.SyncSetKeyValue(kExistingKey, kExisting, sizeof(kExisting)), CHIP_NO_ERROR);
+    EXPECT_EQ(Import(&destination, corrupt, 64), CHIP_ERROR_INTEGRITY_CHECK_FAILED);
+    EXPECT_EQ(destination.GetNumKeys(), 1u);
+    EXPECT_TRUE(destination.HasKey(kExistingKey));
+
+    // Truncated snapshot
+    std::vector<uint8_t> truncated(snapshot.begin(), snapshot.end() - 1);
+    EXPECT_EQ(Import(&destination, truncated, truncated.size()), CHIP_ERROR_MESSAGE_INCOMPLETE);
+    EXPECT_EQ(destination.GetNumKeys(), 1u);
+
+    // Trailing data
+    std::vector<uint8_t> extended = snapshot;
+    extended.push_back(0);
+    EXPECT_EQ(Import(&destination, extended, extended.size()), CHIP_ERROR_INVALID_MESSAGE_LENGTH);
+    EXPECT_EQ(destination.GetNumKeys(), 1u);
+
+    // Unknown format version
+    std::vector<uint8_t> future = snapshot;
+    future[sizeof(PersistentStorageSnapshot::kMagic)]++;
+    EXPECT_EQ(Import(&destination, future, future.size()), CHIP_ERROR_VERSION_MISMATCH);
+
+    // Validation without storage
+    EXPECT_EQ(Import(nullptr, snapshot, 5), CHIP_NO_ERROR);
+    EXPECT_EQ(Import(nullptr, corrupt, 5), CHIP_ERROR_INTEGRITY_CHECK_FAILED);
+}
+
+} // namespace
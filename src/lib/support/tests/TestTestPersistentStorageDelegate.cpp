@@ -341,4 +341,77 @@ TEST(TestTestPersistentStorageDelegate, TestClearStorage)
     EXPECT_EQ(size, sizeof(buf));
 }
 
+TEST(TestTestPersistentStorageDelegate, TestBatches)
+{
+    TestPersistentStorageDelegate storage;
+
+    uint8_t buf[16];
+    uint16_t size;
+    const uint8_t kValue1[] = { 1, 2, 3 };
+    const uint8_t kValue2[] = { 4, 5 };
+
+    EXPECT_EQ(storage.SyncSetKeyValue("a", kValue1, sizeof(kValue1)), CHIP_NO_ERROR);
+
+    // Committed batch keeps all of its writes
+    {
+        PersistentStorageBatch batch(&storage);
+        EXPECT_EQ(storage.SyncSetKeyValue("b", kValue2, sizeof(kValue2)), CHIP_NO_ERROR);
+        EXPECT_EQ(storage.SyncDeleteKeyValue("a"), CHIP_NO_ERROR);
+        EXPECT_EQ(batch.Commit(), CHIP_NO_ERROR);
+    }
+    EXPECT_TRUE(SetMatches(storage.GetKeys(), std::array<std::string, 1>{ "b" }));
+
+    // Aborted batch discards all of its writes, but they are visible while it is open
+    {
+        PersistentStorageBatch batch(&storage);
+        EXPECT_EQ(storage.SyncSetKeyValue("a", kValue1, sizeof(kValue1)), CHIP_NO_ERROR);
+        EXPECT_EQ(storage.SyncSetKeyValue("b", kValue1, sizeof(kValue1)), CHIP_NO_ERROR);
+
+        size = sizeof(buf);
+        EXPECT_EQ(storage.SyncGetKeyValue("b", buf, size), CHIP_NO_ERROR);
+        EXPECT_EQ(size, sizeof(kValue1));
+    }
+    EXPECT_TRUE(SetMatches(storage.GetKeys(), std::array<std::string, 1>{ "b" }));
+    size = sizeof(buf);
+    EXPECT_EQ(storage.SyncGetKeyValue("b", buf, size), CHIP_NO_ERROR);
+    EXPECT_EQ(size, sizeof(kValue2));
+    EXPECT_EQ(0, memcmp(buf, kValue2, sizeof(kValue2)));
+
+    // Nested batches are merged into the outermost one
+    {
+        PersistentStorageBatch outer(&storage);
+        {
+            PersistentStorageBatch inner(&storage);
+            EXPECT_EQ(storage.SyncSetKeyValue("c", kValue1, sizeof(kValue1)), CHIP_NO_ERROR);
+            EXPECT_EQ(inner.Commit(), CHIP_NO_ERROR);
+        }
+        EXPECT_TRUE(storage.HasKey("c"));
+    }
+    EXPECT_FALSE(storage.HasKey("c"));
+
+    // Aborting a nested batch aborts the outermost one
+    {
+        PersistentStorageBatch outer(&storage);
+        EXPECT_EQ(storage.SyncSetKeyValue("c", kValue1, sizeof(kValue1)), CHIP_NO_ERROR);
+        {
+            PersistentStorageBatch inner(&storage);
+            EXPECT_EQ(storage.SyncSetKeyValue("d", kValue1, sizeof(kValue1)), CHIP_NO_ERROR);
+        }
+        EXPECT_EQ(storage.SyncSetKeyValue("e", kValue1, sizeof(kValue1)), CHIP_NO_ERROR);
+        EXPECT_EQ(outer.Commit(), CHIP_ERROR_CANCELLED);
+    }
+    EXPECT_TRUE(SetMatches(storage.GetKeys(), std::array<std::string, 1>{ "b" }));
+
+    // The next batch is not affected
+    {
+        PersistentStorageBatch batch(&storage);
+        EXPECT_EQ(storage.SyncSetKeyValue("c", kValue1, sizeof(kValue1)), CHIP_NO_ERROR);
+        EXPECT_EQ(batch.Commit(), CHIP_NO_ERROR);
+    }
+    EXPECT_TRUE(storage.HasKey("c"));
+
+    // Unbalanced commit is rejected
+    EXPECT_EQ(storage.CommitBatch(), CHIP_ERROR_INCORRECT_STATE);
+}
+
 } // namespace
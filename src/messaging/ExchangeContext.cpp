@@ -160,6 +160,7 @@ CHIP_ERROR ExchangeContext::SendMessage(Protocols::Id protocolId, uint8_t msgTyp
 
         SessionHandle session = GetSessionHandle();
         CHIP_ERROR err;
+        size_t payloadLength = msgBuf.IsNull() ? 0 : msgBuf->TotalLength();
 
 #if CONFIG_BUILD_FOR_HOST_UNIT_TEST
         if (mInjectedFailures.Has(InjectedFailureType::kFailOnSend))
@@ -202,6 +203,8 @@ CHIP_ERROR ExchangeContext::SendMessage(Protocols::Id protocolId, uint8_t msgTyp
             // Standalone acks are not application-level message sends.
             if (!isStandaloneAck)
             {
+                mTrafficCounters.OnMessageSent(payloadLength);
+
                 //
                 // Once we've sent the message successfully, we can clear out the WillSendMessage flag.
                 //
@@ -302,6 +305,7 @@ ExchangeContext::ExchangeContext(ExchangeManager * em, uint16_t ExchangeId, cons
     mFlags.Set(Flags::kFlagInitiator, Initiator);
     mFlags.Set(Flags::kFlagEphemeralExchange, isEphemeralExchange);
     mDelegate = delegate;
+    mExchangeMgr->AddToExchangeIndex(this, session);
 
     //
     // If we're an initiator and we just created this exchange, we obviously did so to send a message. Let's go ahead and
@@ -351,10 +355,16 @@ ExchangeContext::~ExchangeContext()
     // the boolean parameter passed to DoClose() should not matter.
 
     DoClose(false);
+    mExchangeMgr->RemoveFromExchangeIndex(this);
     mExchangeMgr = nullptr;
 
 #if defined(CHIP_EXCHANGE_CONTEXT_DETAIL_LOGGING)
-    ChipLogDetail(ExchangeManager, "ec-- id: " ChipLogFormatExchange, ChipLogValueExchange(this));
+    ChipLogDetail(ExchangeManager,
+                  "ec-- id: " ChipLogFormatExchange " tx: %" PRIu32 " msgs/%" PRIu64 " bytes rx: %" PRIu32 " msgs/%" PRIu64
+                  " bytes retrans: %" PRIu32,
+                  ChipLogValueExchange(this), mTrafficCounters.GetMessagesSent(), mTrafficCounters.GetBytesSent(),
+                  mTrafficCounters.GetMessagesReceived(), mTrafficCounters.GetBytesReceived(),
+                  mTrafficCounters.GetRetransmissions());
 #endif
     SYSTEM_STATS_DECREMENT(chip::System::Stats::kExchangeMgr_NumContexts);
 }
@@ -515,6 +525,11 @@ CHIP_ERROR ExchangeContext::HandleMessage(uint32_t messageCounter, const Payload
     bool isStandaloneAck = payloadHeader.HasMessageType(Protocols::SecureChannel::MsgType::StandaloneAck);
     bool isDuplicate     = msgFlags.Has(MessageFlagValues::kDuplicateMessage);
 
+    if (!isStandaloneAck && !isDuplicate)
+    {
+        mTrafficCounters.OnMessageReceived(msgBuf.IsNull() ? 0 : msgBuf->TotalLength());
+    }
+
     auto deferred = MakeDefer([&]() {
         // Duplicates and standalone acks are not application-level messages, so they should generally not lead to any state
         // changes.  The one exception to that is that if we have a null mDelegate then our lifetime is not application-defined,
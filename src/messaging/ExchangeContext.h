@@ -167,6 +167,14 @@ public:
 
     uint16_t GetExchangeId() const { return mExchangeId; }
 
+    /**
+     * Messages and application payload bytes sent and received on this exchange, and MRP
+     * retransmissions of its messages.  The session's counters include those of all its exchanges.
+     */
+    const Transport::TrafficCounters & GetTrafficCounters() const { return mTrafficCounters; }
+
+    Transport::TrafficCounters & GetTrafficCounters() { return mTrafficCounters; }
+
     /*
      * In order to use reference counting (see refCount below) we use a hold/free paradigm where users of the exchange
      * can hold onto it while it's out of their direct control to make sure it isn't closed before everyone's ready.
@@ -262,8 +270,11 @@ private:
 
     ExchangeMessageDispatch & mDispatch;
 
-    ExchangeSessionHolder mSession; // The connection state
-    uint16_t mExchangeId;           // Assigned exchange ID.
+    ExchangeSessionHolder mSession;           // The connection state
+    ExchangeContext * mNextInIndex = nullptr; // Next exchange in the same ExchangeManager index bucket
+    uint16_t mIndexBucket          = 0;       // ExchangeManager index bucket of the exchange
+    uint16_t mExchangeId;                     // Assigned exchange ID.
+    Transport::TrafficCounters mTrafficCounters;
 
     /**
      *  Track whether we are now expecting a response to a message sent via this exchange (because that
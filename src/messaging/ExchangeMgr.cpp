@@ -74,6 +74,7 @@ CHIP_ERROR ExchangeManager::Init(SessionManager * sessionManager)
         // then re-initializes without removing registered handlers.
         handler.Reset();
     }
+    RebuildUMHIndex();
 
     sessionManager->SetMessageDelegate(this);
 
@@ -164,6 +165,7 @@ CHIP_ERROR ExchangeManager::RegisterUMH(Protocols::Id protocolId, int16_t msgTyp
     selected->Handler     = handler;
     selected->ProtocolId  = protocolId;
     selected->MessageType = msgType;
+    RebuildUMHIndex();
 
     SYSTEM_STATS_INCREMENT(chip::System::Stats::kExchangeMgr_NumUMHandlers);
 
@@ -177,6 +179,7 @@ CHIP_ERROR ExchangeManager::UnregisterUMH(Protocols::Id protocolId, int16_t msgT
         if (umh.IsInUse() && umh.Matches(protocolId, msgType))
         {
             umh.Reset();
+            RebuildUMHIndex();
             SYSTEM_STATS_DECREMENT(chip::System::Stats::kExchangeMgr_NumUMHandlers);
             return CHIP_NO_ERROR;
         }
@@ -185,6 +188,95 @@ CHIP_ERROR ExchangeManager::UnregisterUMH(Protocols::Id protocolId, int16_t msgT
     return CHIP_ERROR_NO_UNSOLICITED_MESSAGE_HANDLER;
 }
 
+namespace {
+
+size_t UMHIndexHash(Protocols::Id protocolId, int16_t msgType)
+{
+    uint32_t hash = protocolId.ToFullyQualifiedSpecForm() * 0x9E3779B1u;
+    hash ^= static_cast<uint16_t>(msgType) * 0x85EBCA6Bu;
+    return static_cast<size_t>(hash ^ (hash >> 16));
+}
+
+} // namespace
+
+void ExchangeManager::RebuildUMHIndex()
+{
+    memset(mUMHIndex, 0, sizeof(mUMHIndex));
+    for (size_t slot = 0; slot < ArraySize(UMHandlerPool); slot++)
+    {
+        const auto & umh = UMHandlerPool[slot];
+        VerifyOrDo(umh.IsInUse(), continue);
+
+        size_t i = UMHIndexHash(umh.ProtocolId, umh.MessageType) & (kUMHIndexSize - 1);
+        while (mUMHIndex[i] != 0)
+        {
+            i = (i + 1) & (kUMHIndexSize - 1);
+        }
+        mUMHIndex[i] = static_cast<uint8_t>(slot + 1);
+    }
+}
+
+ExchangeManager::UnsolicitedMessageHandlerSlot * ExchangeManager::FindUMH(Protocols::Id protocolId, int16_t msgType)
+{
+    // The index is never more than half full, so there is always an empty entry ending the probe sequence.
+    for (size_t i = UMHIndexHash(protocolId, msgType) & (kUMHIndexSize - 1); mUMHIndex[i] != 0; i = (i + 1) & (kUMHIndexSize - 1))
+    {
+        auto & umh = UMHandlerPool[mUMHIndex[i] - 1];
+        if (umh.IsInUse() && umh.Matches(protocolId, msgType))
+        {
+            return &umh;
+        }
+    }
+    return nullptr;
+}
+
+uint16_t ExchangeManager::ExchangeIndexBucket(const Transport::Session * session, uint16_t exchangeId, bool isInitiator)
+{
+    // Sessions are pool objects, the low bits of their address are mostly the same.
+    const size_t sessionHash = static_cast<size_t>(reinterpret_cast<uintptr_t>(session) >> 4) * 0x9E3779B1u;
+    const size_t hash        = sessionHash ^ (sessionHash >> 16) ^ exchangeId ^ (isInitiator ? kExchangeIndexBuckets / 2 : 0);
+    return static_cast<uint16_t>(hash & (kExchangeIndexBuckets - 1));
+}
+
+void ExchangeManager::AddToExchangeIndex(ExchangeContext * ec, const SessionHandle & session)
+{
+    ec->mIndexBucket        = ExchangeIndexBucket(session.operator->(), ec->GetExchangeId(), ec->IsInitiator());
+    ExchangeContext *& head = mExchangeIndex[ec->mIndexBucket];
+    ec->mNextInIndex        = head;
+    head                    = ec;
+}
+
+void ExchangeManager::RemoveFromExchangeIndex(ExchangeContext * ec)
+{
+    ExchangeContext ** link = &mExchangeIndex[ec->mIndexBucket];
+    while (*link != nullptr && *link != ec)
+    {
+        link = &(*link)->mNextInIndex;
+    }
+    if (*link != nullptr)
+    {
+        *link = ec->mNextInIndex;
+    }
+    ec->mNextInIndex = nullptr;
+}
+
+ExchangeContext * ExchangeManager::FindExchange(const SessionHandle & session, const PacketHeader & packetHeader,
+                                                const PayloadHeader & payloadHeader)
+{
+    // A message sent by the initiator of an exchange belongs to our responder exchange, and vice versa. The chain still holds
+    // other exchanges of the bucket, and MatchExchange() checks the whole exchange identity.
+    for (ExchangeContext * ec = mExchangeIndex[ExchangeIndexBucket(session.operator->(), payloadHeader.GetExchangeID(),
+                                                                   !payloadHeader.IsInitiator())];
+         ec != nullptr; ec = ec->mNextInIndex)
+    {
+        if (ec->MatchExchange(session, packetHeader, payloadHeader))
+        {
+            return ec;
+        }
+    }
+    return nullptr;
+}
+
 void ExchangeManager::OnMessageReceived(const PacketHeader & packetHeader, const PayloadHeader & payloadHeader,
                                         const SessionHandle & session, DuplicateMessage isDuplicate,
                                         System::PacketBufferHandle && msgBuf)
@@ -262,23 +354,14 @@ void ExchangeManager::OnMessageReceived(const PacketHeader & packetHeader, const
     if (!packetHeader.IsGroupSession())
     {
         // Search for an existing exchange that the message applies to. If a match is found...
-        bool found = false;
-        mContextPool.ForEachActiveObject([&](auto * ec) {
-            if (ec->MatchExchange(session, packetHeader, payloadHeader))
-            {
-                ChipLogDetail(ExchangeManager, "Found matching exchange: " ChipLogFormatExchange ", Delegate: %p",
-                              ChipLogValueExchange(ec), ec->GetDelegate());
-
-                // Matched ExchangeContext; send to message handler.
-                ec->HandleMessage(packetHeader.GetMessageCounter(), payloadHeader, msgFlags, std::move(msgBuf));
-                found = true;
-                return Loop::Break;
-            }
-            return Loop::Continue;
-        });
-
-        if (found)
+        ExchangeContext * ec = FindExchange(session, packetHeader, payloadHeader);
+        if (ec != nullptr)
         {
+            ChipLogDetail(ExchangeManager, "Found matching exchange: " ChipLogFormatExchange ", Delegate: %p",
+                          ChipLogValueExchange(ec), ec->GetDelegate());
+
+            // Matched ExchangeContext; send to message handler.
+            ec->HandleMessage(packetHeader.GetMessageCounter(), payloadHeader, msgFlags, std::move(msgBuf));
             return;
         }
     }
@@ -310,21 +393,10 @@ void ExchangeManager::OnMessageReceived(const PacketHeader & packetHeader, const
     {
         // Search for an unsolicited message handler that can handle the message. Prefer handlers that can explicitly
         // handle the message type over handlers that handle all messages for a profile.
-        matchingUMH = nullptr;
-
-        for (auto & umh : UMHandlerPool)
+        matchingUMH = FindUMH(payloadHeader.GetProtocolID(), static_cast<int16_t>(payloadHeader.GetMessageType()));
+        if (matchingUMH == nullptr)
         {
-            if (umh.IsInUse() && payloadHeader.HasProtocol(umh.ProtocolId))
-            {
-                if (umh.MessageType == payloadHeader.GetMessageType())
-                {
-                    matchingUMH = &umh;
-                    break;
-                }
-
-                if (umh.MessageType == kAnyMessageType)
-                    matchingUMH = &umh;
-            }
+            matchingUMH = FindUMH(payloadHeader.GetProtocolID(), kAnyMessageType);
         }
     }
     // Discard the message if it isn't marked as being sent by an initiator and the message does not need to send
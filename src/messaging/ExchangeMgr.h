@@ -42,6 +42,12 @@ class ExchangeDelegate;
 
 static constexpr int16_t kAnyMessageType = -1;
 
+// Smallest power of two that is at least the given number.
+constexpr size_t PowerOfTwoAtLeast(size_t count, size_t size = 1)
+{
+    return (size >= count) ? size : PowerOfTwoAtLeast(count, size * 2);
+}
+
 /**
  *  @brief
  *    This class is used to manage ExchangeContexts with other CHIP nodes.
@@ -230,6 +236,19 @@ private:
         UnsolicitedMessageHandler * Handler;
     };
 
+    // Hash index of the exchanges by session, exchange ID and initiator flag, with about one bucket per exchange. Exchanges of a
+    // bucket are chained through ExchangeContext::mNextInIndex, and each exchange remembers its bucket, since its session may be
+    // released before the exchange is.
+    static constexpr size_t kExchangeIndexBuckets = PowerOfTwoAtLeast(CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS);
+    static_assert(kExchangeIndexBuckets <= UINT16_MAX + 1, "Exchange index buckets are 16 bits");
+
+    static uint16_t ExchangeIndexBucket(const Transport::Session * session, uint16_t exchangeId, bool isInitiator);
+
+    // Open-addressed index of UMHandlerPool by (protocol, message type), holding slot index + 1 and 0 for empty entries. It is
+    // twice the size of the pool, so that it never fills up, and rebuilt when handlers are registered or unregistered.
+    static constexpr size_t kUMHIndexSize = PowerOfTwoAtLeast(2 * CHIP_CONFIG_MAX_UNSOLICITED_MESSAGE_HANDLERS);
+    static_assert(CHIP_CONFIG_MAX_UNSOLICITED_MESSAGE_HANDLERS < UINT8_MAX, "UMH index entries are 8 bits");
+
     uint16_t mNextExchangeId;
     uint16_t mNextKeyId;
     State mState;
@@ -242,9 +261,19 @@ private:
     ReliableMessageMgr mReliableMessageMgr;
 
     UnsolicitedMessageHandlerSlot UMHandlerPool[CHIP_CONFIG_MAX_UNSOLICITED_MESSAGE_HANDLERS];
+    uint8_t mUMHIndex[kUMHIndexSize] = {};
+
+    ExchangeContext * mExchangeIndex[kExchangeIndexBuckets] = {};
 
     CHIP_ERROR RegisterUMH(Protocols::Id protocolId, int16_t msgType, UnsolicitedMessageHandler * handler);
     CHIP_ERROR UnregisterUMH(Protocols::Id protocolId, int16_t msgType);
+    void RebuildUMHIndex();
+    UnsolicitedMessageHandlerSlot * FindUMH(Protocols::Id protocolId, int16_t msgType);
+
+    void AddToExchangeIndex(ExchangeContext * ec, const SessionHandle & session);
+    void RemoveFromExchangeIndex(ExchangeContext * ec);
+    ExchangeContext * FindExchange(const SessionHandle & session, const PacketHeader & packetHeader,
+                                   const PayloadHeader & payloadHeader);
 
     void OnMessageReceived(const PacketHeader & packetHeader, const PayloadHeader & payloadHeader, const SessionHandle & session,
                            DuplicateMessage isDuplicate, System::PacketBufferHandle && msgBuf) override;
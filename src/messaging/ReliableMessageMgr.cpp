@@ -21,6 +21,7 @@
  *
  */
 
+#include <algorithm>
 #include <errno.h>
 #include <inttypes.h>
 
@@ -182,6 +183,12 @@ void ReliableMessageMgr::ExecuteActions()
                         Transport::GetSessionTypeString(session), fabricIndex, ChipLogValueX64(destination));
         MATTER_LOG_METRIC(Tracing::kMetricDeviceRMPRetryCount, entry->sendCount);
 
+        entry->ec->GetTrafficCounters().OnRetransmission();
+        if (session->IsSecureSession())
+        {
+            session->AsSecureSession()->GetTrafficCounters().OnRetransmission();
+        }
+
         CalculateNextRetransTime(*entry);
         SendFromRetransTable(entry);
 
@@ -285,6 +292,9 @@ System::Clock::Timeout ReliableMessageMgr::GetBackoff(System::Clock::Timeout bas
 
 void ReliableMessageMgr::StartRetransmision(RetransTableEntry * entry)
 {
+#if MATTER_TRACING_ENABLED
+    entry->firstSendTime = System::SystemClock().GetMonotonicMicroseconds64();
+#endif
     CalculateNextRetransTime(*entry);
     StartTimer();
 }
@@ -295,6 +305,16 @@ bool ReliableMessageMgr::CheckAndRemRetransTable(ReliableMessageContext * rc, ui
     mRetransTable.ForEachActiveObject([&](auto * entry) {
         if (entry->ec->GetReliableMessageContext() == rc && entry->retainedBuf.GetMessageCounter() == ackMessageCounter)
         {
+#if MATTER_TRACING_ENABLED
+            // Once retransmitted, the ack cannot be attributed to a particular transmission.
+            if (entry->sendCount == 0)
+            {
+                uint64_t roundTrip = (System::SystemClock().GetMonotonicMicroseconds64() - entry->firstSendTime).count();
+                roundTrip          = std::min<uint64_t>(roundTrip, UINT32_MAX);
+                MATTER_LOG_METRIC(Tracing::kMetricDeviceMRPRoundTrip, static_cast<uint32_t>(roundTrip));
+            }
+#endif
+
             // Clear the entry from the retransmision table.
             ClearRetransTable(*entry);
 
@@ -30,6 +30,7 @@
 #include <lib/core/Optional.h>
 #include <lib/support/BitFlags.h>
 #include <lib/support/Pool.h>
+#include <matter/tracing/build_config.h>
 #include <messaging/ExchangeContext.h>
 #include <messaging/ReliableMessageProtocolConfig.h>
 #include <system/SystemLayer.h>
@@ -66,6 +67,9 @@ public:
         System::Clock::Timestamp nextRetransTime; /**< A counter representing the next retransmission time for the message. */
         uint8_t sendCount;                        /**< The number of times we have tried to send this entry,
                                                        including both successfully and failure send. */
+#if MATTER_TRACING_ENABLED
+        System::Clock::Microseconds64 firstSendTime{ 0 }; /**< When the message was first sent, for round trip time metrics. */
+#endif
     };
 
     ReliableMessageMgr(ObjectPool<ExchangeContext, CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS> & contextPool);
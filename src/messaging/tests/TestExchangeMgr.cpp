@@ -86,6 +86,42 @@ public:
     bool IsOnMessageReceivedCalled = false;
 };
 
+class CountingDelegate : public ExchangeDelegate
+{
+public:
+    CHIP_ERROR OnMessageReceived(ExchangeContext * ec, const PayloadHeader & payloadHeader,
+                                 System::PacketBufferHandle && buffer) override
+    {
+        ReceivedCount++;
+        LastExchangeId = ec->GetExchangeId();
+        return CHIP_NO_ERROR;
+    }
+
+    void OnResponseTimeout(ExchangeContext * ec) override {}
+
+    int ReceivedCount       = 0;
+    uint16_t LastExchangeId = 0;
+};
+
+class EchoingAppDelegate : public UnsolicitedMessageHandler, public ExchangeDelegate
+{
+public:
+    CHIP_ERROR OnUnsolicitedMessageReceived(const PayloadHeader & payloadHeader, ExchangeDelegate *& newDelegate) override
+    {
+        newDelegate = this;
+        return CHIP_NO_ERROR;
+    }
+
+    CHIP_ERROR OnMessageReceived(ExchangeContext * ec, const PayloadHeader & payloadHeader,
+                                 System::PacketBufferHandle && buffer) override
+    {
+        return ec->SendMessage(payloadHeader.GetProtocolID(), payloadHeader.GetMessageType(), std::move(buffer),
+                               SendFlags(Messaging::SendMessageFlags::kNoAutoRequestAck));
+    }
+
+    void OnResponseTimeout(ExchangeContext * ec) override {}
+};
+
 class WaitForTimeoutDelegate : public ExchangeDelegate
 {
 public:
@@ -226,6 +262,83 @@ TEST_F(TestExchangeMgr, CheckUmhRegistrationTest)
     EXPECT_NE(err, CHIP_NO_ERROR);
 }
 
+TEST_F(TestExchangeMgr, CheckUmhDispatchPrecedence)
+{
+    MockAppDelegate protocolDelegate;
+    MockAppDelegate typeDelegate;
+    MockAppDelegate sendDelegate;
+
+    auto send = [&](uint8_t msgType) {
+        ExchangeContext * ec = NewExchangeToAlice(&sendDelegate);
+        ASSERT_NE(ec, nullptr);
+        EXPECT_EQ(ec->SendMessage(Protocols::BDX::Id, msgType, System::PacketBufferHandle::New(System::PacketBuffer::kMaxSize),
+                                  SendFlags(Messaging::SendMessageFlags::kNoAutoRequestAck)),
+                  CHIP_NO_ERROR);
+        DrainAndServiceIO();
+    };
+
+    EXPECT_EQ(GetExchangeManager().RegisterUnsolicitedMessageHandlerForProtocol(Protocols::BDX::Id, &protocolDelegate),
+              CHIP_NO_ERROR);
+    EXPECT_EQ(GetExchangeManager().RegisterUnsolicitedMessageHandlerForType(Protocols::BDX::Id, kMsgType_TEST1, &typeDelegate),
+              CHIP_NO_ERROR);
+
+    // A handler for the message type is preferred over the handler for the whole protocol, whatever the registration order.
+    send(kMsgType_TEST1);
+    EXPECT_TRUE(typeDelegate.IsOnMessageReceivedCalled);
+    EXPECT_FALSE(protocolDelegate.IsOnMessageReceivedCalled);
+
+    send(kMsgType_TEST2);
+    EXPECT_TRUE(protocolDelegate.IsOnMessageReceivedCalled);
+
+    // Once the type handler is gone, the protocol handler gets its messages.
+    EXPECT_EQ(GetExchangeManager().UnregisterUnsolicitedMessageHandlerForType(Protocols::BDX::Id, kMsgType_TEST1), CHIP_NO_ERROR);
+    typeDelegate.IsOnMessageReceivedCalled     = false;
+    protocolDelegate.IsOnMessageReceivedCalled = false;
+    send(kMsgType_TEST1);
+    EXPECT_FALSE(typeDelegate.IsOnMessageReceivedCalled);
+    EXPECT_TRUE(protocolDelegate.IsOnMessageReceivedCalled);
+
+    EXPECT_EQ(GetExchangeManager().UnregisterUnsolicitedMessageHandlerForProtocol(Protocols::BDX::Id), CHIP_NO_ERROR);
+
+    // Clean up the exchanges left open on both sides.
+    GetExchangeManager().CloseAllContextsForDelegate(&sendDelegate);
+    GetExchangeManager().CloseAllContextsForDelegate(&typeDelegate);
+    GetExchangeManager().CloseAllContextsForDelegate(&protocolDelegate);
+}
+
+TEST_F(TestExchangeMgr, CheckResponsesRoutedToTheirExchange)
+{
+    constexpr size_t kExchangeCount = 6;
+
+    EchoingAppDelegate echoDelegate;
+    EXPECT_EQ(GetExchangeManager().RegisterUnsolicitedMessageHandlerForType(Protocols::BDX::Id, kMsgType_TEST1, &echoDelegate),
+              CHIP_NO_ERROR);
+
+    // Several exchanges on the same session, all waiting for a response at the same time.
+    CountingDelegate delegates[kExchangeCount];
+    uint16_t exchangeIds[kExchangeCount];
+    for (size_t i = 0; i < kExchangeCount; i++)
+    {
+        ExchangeContext * ec = NewExchangeToBob(&delegates[i]);
+        ASSERT_NE(ec, nullptr);
+        exchangeIds[i] = ec->GetExchangeId();
+        EXPECT_EQ(ec->SendMessage(Protocols::BDX::Id, kMsgType_TEST1,
+                                  System::PacketBufferHandle::New(System::PacketBuffer::kMaxSize),
+                                  SendFlags(Messaging::SendMessageFlags::kExpectResponse)
+                                      .Set(Messaging::SendMessageFlags::kNoAutoRequestAck)),
+                  CHIP_NO_ERROR);
+    }
+    DrainAndServiceIO();
+
+    for (size_t i = 0; i < kExchangeCount; i++)
+    {
+        EXPECT_EQ(delegates[i].ReceivedCount, 1);
+        EXPECT_EQ(delegates[i].LastExchangeId, exchangeIds[i]);
+    }
+
+    EXPECT_EQ(GetExchangeManager().UnregisterUnsolicitedMessageHandlerForType(Protocols::BDX::Id, kMsgType_TEST1), CHIP_NO_ERROR);
+}
+
 TEST_F(TestExchangeMgr, CheckExchangeMessages)
 {
     CHIP_ERROR err;
@@ -54,6 +54,27 @@
 // These are configuration options that are unique to Linux platforms.
 // These can be overridden by the application as needed.
 
+/**
+ * CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_STORAGE
+ *
+ * Back the KeyValueStoreManager with the append-only log-structured storage
+ * (ChipLinuxLogStorage) instead of the INI file storage.
+ */
+#ifndef CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_STORAGE
+#define CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_STORAGE 0
+#endif // CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_STORAGE
+
+/**
+ * CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_COMPACTION_THRESHOLD
+ *
+ * Minimum size, in bytes, of the KVS log file before it is considered for
+ * compaction. Compaction only happens once more than half of the log is
+ * made of stale records.
+ */
+#ifndef CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_COMPACTION_THRESHOLD
+#define CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_COMPACTION_THRESHOLD (64 * 1024)
+#endif // CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_COMPACTION_THRESHOLD
+
 // ========== Platform-specific Configuration Overrides =========
 
 #ifndef CHIP_DEVICE_CONFIG_CHIP_TASK_STACK_SIZE
@@ -0,0 +1,591 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *         Implementation of the append-only, log-structured key-value storage
+ *         used by the Linux KVS.
+ *
+ *         File layout (all integers little-endian):
+ *
+ *           header: magic (u32) | version (u16) | reserved (u16)
+ *           record: crc32 (u32) | type (u8) | key length (u16) | value length (u32) | key | value
+ *
+ *         The checksum covers everything in the record that follows it.
+ *
+ *         When a commit contains more than one record, it is preceded by a
+ *         batch record whose value is the length (u32) of the records that
+ *         make up the commit. On load, a batch is only applied if all of its
+ *         records are present and valid, so multi-record commits are atomic.
+ */
+
+#include <platform/Linux/CHIPLinuxLogStorage.h>
+
+#include <algorithm>
+#include <errno.h>
+#include <fcntl.h>
+#include <sstream>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <inipp/inipp.h>
+#include <lib/core/CHIPEncoding.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/Crc32.h>
+#include <lib/support/IniEscaping.h>
+#include <lib/support/TypeTraits.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <platform/CHIPDeviceConfig.h>
+
+namespace chip {
+namespace DeviceLayer {
+namespace Internal {
+
+namespace {
+
+constexpr uint32_t kLogMagic             = 0x4C564B43; // "CKVL"
+constexpr uint16_t kLogVersion           = 1;
+constexpr size_t kLogHeaderSize          = 8;
+constexpr size_t kRecordHeaderSize       = 11;
+constexpr size_t kRecordChecksummedStart = 4;
+constexpr size_t kMaxValueSize           = 1024 * 1024;
+
+void EncodeHeader(uint8_t * header)
+{
+    Encoding::LittleEndian::Put32(&header[0], kLogMagic);
+    Encoding::LittleEndian::Put16(&header[4], kLogVersion);
+    Encoding::LittleEndian::Put16(&header[6], 0);
+}
+
+} // namespace
+
+size_t ChipLinuxLogStorage::RecordSize(size_t keyLen, size_t valueLen)
+{
+    return kRecordHeaderSize + keyLen + valueLen;
+}
+
+void ChipLinuxLogStorage::EncodeRecord(std::vector<uint8_t> & out, RecordType type, const std::string & key, const uint8_t * value,
+                                       size_t valueLen)
+{
+    size_t start = out.size();
+    out.resize(start + RecordSize(key.size(), valueLen));
+
+    uint8_t * p = out.data() + start;
+    p[4]        = to_underlying(type);
+    Encoding::LittleEndian::Put16(&p[5], static_cast<uint16_t>(key.size()));
+    Encoding::LittleEndian::Put32(&p[7], static_cast<uint32_t>(valueLen));
+    if (!key.empty())
+    {
+        memcpy(&p[kRecordHeaderSize], key.data(), key.size());
+    }
+    if (valueLen > 0)
+    {
+        memcpy(&p[kRecordHeaderSize + key.size()], value, valueLen);
+    }
+
+    size_t checksummedLen = RecordSize(key.size(), valueLen) - kRecordChecksummedStart;
+    Encoding::LittleEndian::Put32(&p[0], Crc32::Compute(&p[kRecordChecksummedStart], checksummedLen));
+}
+
+size_t ChipLinuxLogStorage::ValidRecordSize(const std::vector<uint8_t> & contents, size_t offset)
+{
+    const uint8_t * p = &contents[offset];
+    size_t remaining  = contents.size() - offset;
+    if (remaining < kRecordHeaderSize)
+    {
+        return 0;
+    }
+
+    size_t keyLen   = Encoding::LittleEndian::Get16(&p[5]);
+    size_t valueLen = Encoding::LittleEndian::Get32(&p[7]);
+    if (valueLen > kMaxValueSize || remaining < RecordSize(keyLen, valueLen))
+    {
+        return 0;
+    }
+
+    size_t recordLen = RecordSize(keyLen, valueLen);
+    if (Crc32::Compute(&p[kRecordChecksummedStart], recordLen - kRecordChecksummedStart) != Encoding::LittleEndian::Get32(p))
+    {
+        return 0;
+    }
+
+    return recordLen;
+}
+
+CHIP_ERROR ChipLinuxLogStorage::Init(const char * logFile)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+
+    if (mInitialized)
+    {
+        ChipLogError(DeviceLayer, "ChipLinuxLogStorage::Init: Attempt to re-initialize with KVS log file: %s",
+                     StringOrNullMarker(logFile));
+        return CHIP_NO_ERROR;
+    }
+
+    VerifyOrReturnError(logFile != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    ChipLogDetail(DeviceLayer, "ChipLinuxLogStorage::Init: Using KVS log file: %s", logFile);
+
+    mLogPath.assign(logFile);
+    ReturnErrorOnFailure(Load());
+
+    mInitialized = true;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ChipLinuxLogStorage::Load()
+{
+    mEntries.clear();
+    mPendingRecords.clear();
+    mPendingRecordCount = 0;
+    mLiveSize           = kLogHeaderSize;
+
+    mFd = FileDescriptor(open(mLogPath.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, S_IRUSR | S_IWUSR));
+    VerifyOrReturnError(mFd.Get() != -1, CHIP_ERROR_OPEN_FAILED,
+                        ChipLogError(DeviceLayer, "Failed to open KVS log %s: %s", mLogPath.c_str(), strerror(errno)));
+
+    struct stat st;
+    VerifyOrReturnError(fstat(mFd.Get(), &st) == 0, CHIP_ERROR_OPEN_FAILED);
+
+    std::vector<uint8_t> contents(static_cast<size_t>(st.st_size));
+    size_t readLen = 0;
+    while (readLen < contents.size())
+    {
+        ssize_t rv = pread(mFd.Get(), contents.data() + readLen, contents.size() - readLen, static_cast<off_t>(readLen));
+        if (rv < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        VerifyOrReturnError(rv > 0, CHIP_ERROR_READ_FAILED,
+                            ChipLogError(DeviceLayer, "Failed to read KVS log %s: %s", mLogPath.c_str(), strerror(errno)));
+        readLen += static_cast<size_t>(rv);
+    }
+
+    uint8_t header[kLogHeaderSize];
+    EncodeHeader(header);
+
+    // A new log, or one whose creation was interrupted before its header was
+    // fully written.
+    if (contents.empty() || (contents.size() < kLogHeaderSize && memcmp(contents.data(), header, contents.size()) == 0))
+    {
+        ReturnErrorOnFailure(WriteAll(mFd.Get(), 0, header, sizeof(header)));
+        VerifyOrReturnError(fdatasync(mFd.Get()) == 0, CHIP_ERROR_WRITE_FAILED);
+        mLogSize = kLogHeaderSize;
+        return CHIP_NO_ERROR;
+    }
+
+    if (contents.size() < kLogHeaderSize || Encoding::LittleEndian::Get32(contents.data()) != kLogMagic)
+    {
+        return ImportLegacyIni(contents);
+    }
+
+    VerifyOrReturnError(Encoding::LittleEndian::Get16(&contents[4]) == kLogVersion, CHIP_ERROR_VERSION_MISMATCH,
+                        ChipLogError(DeviceLayer, "Unsupported KVS log version in %s", mLogPath.c_str()));
+
+    size_t offset = kLogHeaderSize;
+    while (offset < contents.size())
+    {
+        size_t recordLen = ValidRecordSize(contents, offset);
+        if (recordLen == 0)
+        {
+            break;
+        }
+
+        const uint8_t * p = &contents[offset];
+        uint8_t type      = p[4];
+        size_t keyLen     = Encoding::LittleEndian::Get16(&p[5]);
+        size_t valueLen   = Encoding::LittleEndian::Get32(&p[7]);
+
+        if (type == to_underlying(RecordType::kBatch))
+        {
+            // Only replay the batch if every one of its records made it to
+            // the file; otherwise the whole batch is treated as a torn tail.
+            if (valueLen != sizeof(uint32_t))
+            {
+                break;
+            }
+
+            size_t batchEnd = offset + recordLen + Encoding::LittleEndian::Get32(&p[kRecordHeaderSize + keyLen]);
+            size_t cursor   = offset + recordLen;
+            while (cursor < batchEnd && cursor < contents.size())
+            {
+                size_t len = ValidRecordSize(contents, cursor);
+                if (len == 0)
+                {
+                    break;
+                }
+                cursor += len;
+            }
+
+            if (cursor != batchEnd)
+            {
+                break;
+            }
+
+            offset += recordLen;
+            continue;
+        }
+
+        std::string key(reinterpret_cast<const char *>(&p[kRecordHeaderSize]), keyLen);
+        auto it = mEntries.find(key);
+        if (it != mEntries.end())
+        {
+            mLiveSize -= RecordSize(keyLen, it->second.size());
+        }
+
+        if (type == to_underlying(RecordType::kPut))
+        {
+            const uint8_t * value = &p[kRecordHeaderSize + keyLen];
+            mEntries[key].assign(value, value + valueLen);
+            mLiveSize += recordLen;
+        }
+        else if (it != mEntries.end())
+        {
+            mEntries.erase(it);
+        }
+
+        offset += recordLen;
+    }
+
+    if (offset != contents.size())
+    {
+        // Anything past the last valid record is a torn or corrupted write
+        // that was never acknowledged, so it is safe to drop it.
+        ChipLogError(DeviceLayer, "KVS log %s: discarding %u bytes of incomplete or corrupted records", mLogPath.c_str(),
+                     static_cast<unsigned>(contents.size() - offset));
+        VerifyOrReturnError(ftruncate(mFd.Get(), static_cast<off_t>(offset)) == 0, CHIP_ERROR_WRITE_FAILED);
+        VerifyOrReturnError(fdatasync(mFd.Get()) == 0, CHIP_ERROR_WRITE_FAILED);
+    }
+
+    mLogSize = offset;
+    ChipLogDetail(DeviceLayer, "KVS log %s: loaded %u entries", mLogPath.c_str(), static_cast<unsigned>(mEntries.size()));
+
+    return ShouldCompact() ? CompactLocked() : CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ChipLinuxLogStorage::ImportLegacyIni(const std::vector<uint8_t> & contents)
+{
+    std::istringstream stream(std::string(contents.begin(), contents.end()));
+    inipp::Ini<char> ini;
+    ini.parse(stream);
+
+    // Anything else is a log whose header was damaged. Importing it would
+    // replace the whole store with an empty one, so leave the file alone.
+    bool isText = std::find(contents.begin(), contents.end(), 0) == contents.end();
+    VerifyOrReturnError(isText && ini.errors.empty(), CHIP_ERROR_INTEGRITY_CHECK_FAILED,
+                        ChipLogError(DeviceLayer, "KVS log %s is neither a valid log nor an INI file", mLogPath.c_str()));
+
+    auto section = ini.sections.find("DEFAULT");
+    if (section != ini.sections.end())
+    {
+        for (const auto & entry : section->second)
+        {
+            std::string key = IniEscaping::UnescapeKey(entry.first);
+            if (key.empty())
+            {
+                continue;
+            }
+
+            std::string value = IniEscaping::Base64ToString(entry.second);
+            mEntries[key].assign(value.begin(), value.end());
+            mLiveSize += RecordSize(key.size(), value.size());
+        }
+    }
+
+    ChipLogProgress(DeviceLayer, "KVS log %s: imported %u entries from legacy INI storage", mLogPath.c_str(),
+                    static_cast<unsigned>(mEntries.size()));
+
+    return CompactLocked();
+}
+
+CHIP_ERROR ChipLinuxLogStorage::ReadValueBin(const char * key, uint8_t * buf, size_t bufSize, size_t & outLen)
+{
+    VerifyOrReturnError(key != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    std::lock_guard<std::mutex> lock(mLock);
+
+    auto it = mEntries.find(key);
+    VerifyOrReturnError(it != mEntries.end(), CHIP_ERROR_KEY_NOT_FOUND);
+
+    outLen = it->second.size();
+    VerifyOrReturnError(outLen <= bufSize, CHIP_ERROR_BUFFER_TOO_SMALL);
+
+    if (outLen > 0)
+    {
+        memcpy(buf, it->second.data(), outLen);
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ChipLinuxLogStorage::ReadValueBin(const char * key, uint8_t * buf, size_t bufSize, size_t offset, size_t & readLen,
+                                             size_t & valueLen)
+{
+    VerifyOrReturnError(key != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    std::lock_guard<std::mutex> lock(mLock);
+
+    auto it = mEntries.find(key);
+    VerifyOrReturnError(it != mEntries.end(), CHIP_ERROR_KEY_NOT_FOUND);
+    VerifyOrReturnError(offset <= it->second.size(), CHIP_ERROR_INVALID_ARGUMENT);
+
+    valueLen = it->second.size();
+    readLen  = std::min(bufSize, valueLen - offset);
+    if (readLen > 0)
+    {
+        memcpy(buf, it->second.data() + offset, readLen);
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ChipLinuxLogStorage::WriteValueBin(const char * key, const uint8_t * data, size_t dataLen)
+{
+    VerifyOrReturnError(key != nullptr && (data != nullptr || dataLen == 0), CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(strlen(key) <= UINT16_MAX && dataLen <= kMaxValueSize, CHIP_ERROR_INVALID_ARGUMENT);
+
+    std::lock_guard<std::mutex> lock(mLock);
+
+    std::string keyString(key);
+    auto it = mEntries.find(keyString);
+    if (it != mEntries.end())
+    {
+        mLiveSize -= RecordSize(keyString.size(), it->second.size());
+    }
+    mEntries[keyString].assign(data, data + dataLen);
+    mLiveSize += RecordSize(keyString.size(), dataLen);
+
+    EncodeRecord(mPendingRecords, RecordType::kPut, keyString, data, dataLen);
+    mPendingRecordCount++;
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ChipLinuxLogStorage::ClearValue(const char * key)
+{
+    VerifyOrReturnError(key != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    std::lock_guard<std::mutex> lock(mLock);
+
+    std::string keyString(key);
+    auto it = mEntries.find(keyString);
+    VerifyOrReturnError(it != mEntries.end(), CHIP_ERROR_KEY_NOT_FOUND);
+
+    mLiveSize -= RecordSize(keyString.size(), it->second.size());
+    mEntries.erase(it);
+
+    EncodeRecord(mPendingRecords, RecordType::kDelete, keyString, nullptr, 0);
+    mPendingRecordCount++;
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ChipLinuxLogStorage::ClearAll()
+{
+    std::lock_guard<std::mutex> lock(mLock);
+
+    mEntries.clear();
+    mPendingRecords.clear();
+    mPendingRecordCount = 0;
+    mLiveSize           = kLogHeaderSize;
+
+    return CompactLocked();
+}
+
+CHIP_ERROR ChipLinuxLogStorage::Revert()
+{
+    std::lock_guard<std::mutex> lock(mLock);
+
+    VerifyOrReturnError(mInitialized, CHIP_ERROR_INCORRECT_STATE);
+
+    return Load();
+}
+
+void ChipLinuxLogStorage::DiscardPendingWrites()
+{
+    std::lock_guard<std::mutex> lock(mLock);
+
+    mPendingRecords.clear();
+    mPendingRecordCount = 0;
+}
+
+bool ChipLinuxLogStorage::HasValue(const char * key)
+{
+    VerifyOrReturnValue(key != nullptr, false);
+
+    std::lock_guard<std::mutex> lock(mLock);
+
+    return mEntries.find(key) != mEntries.end();
+}
+
+CHIP_ERROR ChipLinuxLogStorage::GetKeys(std::vector<std::string> & keys)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+
+    keys.clear();
+    keys.reserve(mEntries.size());
+    for (const auto & entry : mEntries)
+    {
+        keys.push_back(entry.first);
+    }
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ChipLinuxLogStorage::Commit()
+{
+    std::lock_guard<std::mutex> lock(mLock);
+
+    VerifyOrReturnError(mFd.Get() != -1, CHIP_ERROR_INCORRECT_STATE);
+
+    if (mPendingRecords.empty())
+    {
+        return CHIP_NO_ERROR;
+    }
+
+    std::vector<uint8_t> batchRecord;
+    if (mPendingRecordCount > 1)
+    {
+        uint8_t batchLength[sizeof(uint32_t)];
+        Encoding::LittleEndian::Put32(batchLength, static_cast<uint32_t>(mPendingRecords.size()));
+        EncodeRecord(batchRecord, RecordType::kBatch, std::string(), batchLength, sizeof(batchLength));
+    }
+
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    if (!batchRecord.empty())
+    {
+        err = WriteAll(mFd.Get(), mLogSize, batchRecord.data(), batchRecord.size());
+    }
+    if (err == CHIP_NO_ERROR)
+    {
+        err = WriteAll(mFd.Get(), mLogSize + batchRecord.size(), mPendingRecords.data(), mPendingRecords.size());
+    }
+    if (err == CHIP_NO_ERROR && fdatasync(mFd.Get()) != 0)
+    {
+        ChipLogError(DeviceLayer, "Failed to sync KVS log %s: %s", mLogPath.c_str(), strerror(errno));
+        err = CHIP_ERROR_WRITE_FAILED;
+    }
+
+    if (err != CHIP_NO_ERROR)
+    {
+        // Drop whatever part of the batch may have made it to the file so
+        // that the log still ends on a record boundary.
+        if (ftruncate(mFd.Get(), static_cast<off_t>(mLogSize)) != 0)
+        {
+            ChipLogError(DeviceLayer, "Failed to roll back KVS log %s: %s", mLogPath.c_str(), strerror(errno));
+        }
+
+        // The entries already hold the failed writes: reload them from the
+        // log so that they match what is on disk.
+        CHIP_ERROR reloadErr = Load();
+        if (reloadErr != CHIP_NO_ERROR)
+        {
+            ChipLogError(DeviceLayer, "Failed to reload KVS log %s: %" CHIP_ERROR_FORMAT, mLogPath.c_str(), reloadErr.Format());
+        }
+        return err;
+    }
+
+    mLogSize += batchRecord.size() + mPendingRecords.size();
+    mPendingRecords.clear();
+    mPendingRecordCount = 0;
+
+    return ShouldCompact() ? CompactLocked() : CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ChipLinuxLogStorage::Compact()
+{
+    std::lock_guard<std::mutex> lock(mLock);
+
+    return CompactLocked();
+}
+
+bool ChipLinuxLogStorage::ShouldCompact() const
+{
+    return (mLogSize >= CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_COMPACTION_THRESHOLD) && (mLogSize > 2 * mLiveSize);
+}
+
+// Compaction follows the same atomic replacement scheme as the INI storage:
+// write a new log to a temporary file, sync it, then rename() it over the
+// existing one.
+CHIP_ERROR ChipLinuxLogStorage::CompactLocked()
+{
+    std::vector<uint8_t> contents;
+    contents.reserve(mLiveSize);
+    contents.resize(kLogHeaderSize);
+    EncodeHeader(contents.data());
+
+    for (const auto & entry : mEntries)
+    {
+        EncodeRecord(contents, RecordType::kPut, entry.first, entry.second.data(), entry.second.size());
+    }
+
+    std::string tmpPath = mLogPath + "-XXXXXX";
+    FileDescriptor tmpFd(mkstemp(tmpPath.data()));
+    VerifyOrReturnError(tmpFd.Get() != -1, CHIP_ERROR_OPEN_FAILED,
+                        ChipLogError(DeviceLayer, "Failed to create temp file %s: %s", tmpPath.c_str(), strerror(errno)));
+
+    CHIP_ERROR err = WriteAll(tmpFd.Get(), 0, contents.data(), contents.size());
+    if (err == CHIP_NO_ERROR && fdatasync(tmpFd.Get()) != 0)
+    {
+        ChipLogError(DeviceLayer, "Failed to sync temp file %s: %s", tmpPath.c_str(), strerror(errno));
+        err = CHIP_ERROR_WRITE_FAILED;
+    }
+    if (err == CHIP_NO_ERROR && rename(tmpPath.c_str(), mLogPath.c_str()) != 0)
+    {
+        ChipLogError(DeviceLayer, "Failed to rename %s to %s: %s", tmpPath.c_str(), mLogPath.c_str(), strerror(errno));
+        err = CHIP_ERROR_WRITE_FAILED;
+    }
+    if (err != CHIP_NO_ERROR)
+    {
+        unlink(tmpPath.c_str());
+        return err;
+    }
+
+    // The temporary file is now the log: keep appending to it.
+    mFd       = std::move(tmpFd);
+    mLogSize  = contents.size();
+    mLiveSize = contents.size();
+    mPendingRecords.clear();
+    mPendingRecordCount = 0;
+
+    ChipLogDetail(DeviceLayer, "Compacted KVS log %s to %u bytes", mLogPath.c_str(), static_cast<unsigned>(mLogSize));
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ChipLinuxLogStorage::WriteAll(int fd, size_t offset, const uint8_t * data, size_t length)
+{
+    while (length > 0)
+    {
+        ssize_t rv = pwrite(fd, data, length, static_cast<off_t>(offset));
+        if (rv < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        VerifyOrReturnError(rv > 0, CHIP_ERROR_WRITE_FAILED,
+                            ChipLogError(DeviceLayer, "Failed to write KVS log %s: %s", mLogPath.c_str(), strerror(errno)));
+        data += rv;
+        offset += static_cast<size_t>(rv);
+        length -= static_cast<size_t>(rv);
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+} // namespace Internal
+} // namespace DeviceLayer
+} // namespace chip
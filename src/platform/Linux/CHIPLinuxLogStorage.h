@@ -0,0 +1,126 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *         Append-only, log-structured key-value storage for the Linux KVS.
+ *
+ *         Every write or delete is appended to the log file as a single
+ *         checksummed record, so the cost of a commit is proportional to the
+ *         size of the change rather than to the size of the whole store.
+ *         Values are stored as raw binary. All the records written by a
+ *         single Commit() are applied atomically.
+ *
+ *         The whole store is replayed into memory on Init(). A torn or
+ *         corrupted tail (e.g. after a power loss in the middle of a commit)
+ *         is detected through the record checksum and truncated away. Once
+ *         the log is mostly made of stale records, it is compacted by
+ *         atomically replacing it with a log containing only live entries.
+ *
+ *         An existing INI-format KVS file found at the same path is imported
+ *         on first use. A file that is neither a log nor an INI file (e.g. a
+ *         log with a damaged header) is left untouched and Init() fails.
+ */
+
+#pragma once
+
+#include <lib/core/CHIPError.h>
+#include <lib/support/FileDescriptor.h>
+
+#include <map>
+#include <mutex>
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace chip {
+namespace DeviceLayer {
+namespace Internal {
+
+class ChipLinuxLogStorage
+{
+public:
+    ChipLinuxLogStorage()  = default;
+    ~ChipLinuxLogStorage() = default;
+
+    CHIP_ERROR Init(const char * logFile);
+    CHIP_ERROR ReadValueBin(const char * key, uint8_t * buf, size_t bufSize, size_t & outLen);
+    CHIP_ERROR ReadValueBin(const char * key, uint8_t * buf, size_t bufSize, size_t offset, size_t & readLen, size_t & valueLen);
+    CHIP_ERROR WriteValueBin(const char * key, const uint8_t * data, size_t dataLen);
+    CHIP_ERROR ClearValue(const char * key);
+    CHIP_ERROR ClearAll();
+    CHIP_ERROR Commit();
+    bool HasValue(const char * key);
+
+    /**
+     * Get the names of all the entries of the store.
+     */
+    CHIP_ERROR GetKeys(std::vector<std::string> & keys);
+
+    /**
+     * Discard all uncommitted writes and reload the store from the log file.
+     */
+    CHIP_ERROR Revert();
+
+    /**
+     * Drop the records of the uncommitted writes without touching the
+     * entries. Only valid once the entries were brought back to their
+     * committed values.
+     */
+    void DiscardPendingWrites();
+
+    /**
+     * Rewrite the log so that it only contains live entries. This is done
+     * automatically by Commit() once enough stale records accumulate.
+     */
+    CHIP_ERROR Compact();
+
+private:
+    enum class RecordType : uint8_t
+    {
+        kPut    = 1,
+        kDelete = 2,
+        kBatch  = 3,
+    };
+
+    static size_t RecordSize(size_t keyLen, size_t valueLen);
+    static void EncodeRecord(std::vector<uint8_t> & out, RecordType type, const std::string & key, const uint8_t * value,
+                             size_t valueLen);
+    static size_t ValidRecordSize(const std::vector<uint8_t> & contents, size_t offset);
+
+    CHIP_ERROR Load();
+    CHIP_ERROR ImportLegacyIni(const std::vector<uint8_t> & contents);
+    CHIP_ERROR WriteAll(int fd, size_t offset, const uint8_t * data, size_t length);
+    CHIP_ERROR CompactLocked();
+    bool ShouldCompact() const;
+
+    std::mutex mLock;
+    std::map<std::string, std::vector<uint8_t>> mEntries;
+    std::vector<uint8_t> mPendingRecords;
+    size_t mPendingRecordCount = 0;
+    std::string mLogPath;
+    FileDescriptor mFd;
+    size_t mLogSize   = 0; // Size of the log file on disk.
+    size_t mLiveSize  = 0; // Size the log would have if it only contained live entries.
+    bool mInitialized = false;
+};
+
+} // namespace Internal
+} // namespace DeviceLayer
+} // namespace chip
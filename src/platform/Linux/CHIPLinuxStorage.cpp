@@ -23,16 +23,19 @@
  *
  */
 
+#include <algorithm>
 #include <errno.h>
 #include <fstream>
 #include <inttypes.h>
 #include <libgen.h>
+#include <string.h>
 #include <string>
 #include <unistd.h>
 
 #include <lib/support/Base64.h>
 #include <lib/support/CHIPMem.h>
 #include <lib/support/CodeUtils.h>
+#include <lib/support/IniEscaping.h>
 #include <lib/support/ScopedBuffer.h>
 #include <lib/support/logging/CHIPLogging.h>
 #include <platform/Linux/CHIPLinuxStorage.h>
@@ -163,13 +166,113 @@ CHIP_ERROR ChipLinuxStorage::ReadValueBin(const char * key, uint8_t * buf, size_
 
     mLock.lock();
 
-    retval = ChipLinuxStorageIni::GetBinaryBlobValue(key, buf, bufSize, outLen);
+    if (mBinaryValuesLoaded)
+    {
+        auto it = mBinaryValues.find(key);
+        if (it == mBinaryValues.end())
+        {
+            retval = CHIP_ERROR_KEY_NOT_FOUND;
+        }
+        else
+        {
+            outLen = it->second.size();
+            if (outLen > bufSize)
+            {
+                retval = CHIP_ERROR_BUFFER_TOO_SMALL;
+            }
+            else if (outLen > 0)
+            {
+                memcpy(buf, it->second.data(), outLen);
+            }
+        }
+    }
+    else
+    {
+        retval = ChipLinuxStorageIni::GetBinaryBlobValue(key, buf, bufSize, outLen);
+    }
+
+    mLock.unlock();
+
+    return retval;
+}
+
+CHIP_ERROR ChipLinuxStorage::ReadValueBin(const char * key, uint8_t * buf, size_t bufSize, size_t offset, size_t & readLen,
+                                          size_t & valueLen)
+{
+    CHIP_ERROR retval = CHIP_NO_ERROR;
+
+    mLock.lock();
+
+    // Partial reads are served from the decoded values only.
+    if (!mBinaryValuesLoaded)
+    {
+        LoadBinaryValuesLocked();
+    }
+
+    auto it = mBinaryValues.find(key);
+    if (it == mBinaryValues.end())
+    {
+        retval = CHIP_ERROR_KEY_NOT_FOUND;
+    }
+    else if (offset > it->second.size())
+    {
+        retval = CHIP_ERROR_INVALID_ARGUMENT;
+    }
+    else
+    {
+        valueLen = it->second.size();
+        readLen  = std::min(bufSize, valueLen - offset);
+        if (readLen > 0)
+        {
+            memcpy(buf, it->second.data() + offset, readLen);
+        }
+    }
 
     mLock.unlock();
 
     return retval;
 }
 
+CHIP_ERROR ChipLinuxStorage::LoadBinaryValues()
+{
+    mLock.lock();
+    LoadBinaryValuesLocked();
+    mLock.unlock();
+
+    return CHIP_NO_ERROR;
+}
+
+void ChipLinuxStorage::LoadBinaryValuesLocked()
+{
+    std::map<std::string, std::string> section;
+
+    mBinaryValues.clear();
+
+    if (ChipLinuxStorageIni::GetDefaultSection(section) == CHIP_NO_ERROR)
+    {
+        for (const auto & entry : section)
+        {
+            std::string key = IniEscaping::UnescapeKey(entry.first);
+            if (key.empty() || entry.second.size() > UINT32_MAX)
+            {
+                continue;
+            }
+
+            std::vector<uint8_t> value(BASE64_MAX_DECODED_LEN(entry.second.size()));
+            uint32_t decodedLen = Base64Decode32(entry.second.data(), static_cast<uint32_t>(entry.second.size()), value.data());
+            if (decodedLen == UINT32_MAX)
+            {
+                continue;
+            }
+
+            value.resize(decodedLen);
+            mBinaryValues.emplace(std::move(key), std::move(value));
+        }
+    }
+
+    mBinaryValuesLoaded = true;
+}
+
 CHIP_ERROR ChipLinuxStorage::WriteValue(const char * key, bool val)
 {
     CHIP_ERROR retval = CHIP_NO_ERROR;
@@ -221,6 +324,12 @@ CHIP_ERROR ChipLinuxStorage::WriteValueStr(const char * key, const char * val)
 
     retval = ChipLinuxStorageIni::AddEntry(key, val);
 
+    // A string value is not a binary blob: drop any decoded copy.
+    if (mBinaryValuesLoaded && key != nullptr)
+    {
+        mBinaryValues.erase(key);
+    }
+
     mDirty = true;
 
     mLock.unlock();
@@ -265,7 +374,18 @@ CHIP_ERROR ChipLinuxStorage::WriteValueBin(const char * key, const uint8_t * dat
     // Store it
     if (retval == CHIP_NO_ERROR)
     {
-        WriteValueStr(key, encodedData.Get());
+        mLock.lock();
+
+        retval = ChipLinuxStorageIni::AddEntry(key, encodedData.Get());
+
+        if (retval == CHIP_NO_ERROR && mBinaryValuesLoaded)
+        {
+            mBinaryValues[key].assign(data, data + dataLen);
+        }
+
+        mDirty = true;
+
+        mLock.unlock();
     }
 
     return retval;
@@ -279,6 +399,11 @@ CHIP_ERROR ChipLinuxStorage::ClearValue(const char * key)
 
     retval = ChipLinuxStorageIni::RemoveEntry(key);
 
+    if (mBinaryValuesLoaded)
+    {
+        mBinaryValues.erase(key);
+    }
+
     if (retval == CHIP_NO_ERROR)
     {
         mDirty = true;
@@ -300,6 +425,7 @@ CHIP_ERROR ChipLinuxStorage::ClearAll()
     mLock.lock();
 
     retval = ChipLinuxStorageIni::RemoveAll();
+    mBinaryValues.clear();
 
     mLock.unlock();
 
@@ -329,6 +455,39 @@ bool ChipLinuxStorage::HasValue(const char * key)
     return retval;
 }
 
+CHIP_ERROR ChipLinuxStorage::GetKeys(std::vector<std::string> & keys)
+{
+    std::map<std::string, std::string> section;
+
+    mLock.lock();
+
+    CHIP_ERROR retval = ChipLinuxStorageIni::GetDefaultSection(section);
+
+    mLock.unlock();
+
+    keys.clear();
+    if (retval == CHIP_NO_ERROR)
+    {
+        keys.reserve(section.size());
+        for (const auto & entry : section)
+        {
+            // Keys are escaped in the INI representation.
+            std::string key = IniEscaping::UnescapeKey(entry.first);
+            if (!key.empty())
+            {
+                keys.push_back(std::move(key));
+            }
+        }
+    }
+    else if (retval == CHIP_ERROR_KEY_NOT_FOUND)
+    {
+        // Empty store
+        retval = CHIP_NO_ERROR;
+    }
+
+    return retval;
+}
+
 CHIP_ERROR ChipLinuxStorage::Commit()
 {
     CHIP_ERROR retval = CHIP_NO_ERROR;
@@ -33,9 +33,11 @@
 
 #pragma once
 
+#include <map>
 #include <mutex>
 #include <platform/Linux/CHIPLinuxStorageIni.h>
 #include <string>
+#include <vector>
 
 #ifndef FATCONFDIR
 #define FATCONFDIR "/tmp"
@@ -76,6 +78,7 @@ public:
     CHIP_ERROR ReadValue(const char * key, uint64_t & val);
     CHIP_ERROR ReadValueStr(const char * key, char * buf, size_t bufSize, size_t & outLen);
     CHIP_ERROR ReadValueBin(const char * key, uint8_t * buf, size_t bufSize, size_t & outLen);
+    CHIP_ERROR ReadValueBin(const char * key, uint8_t * buf, size_t bufSize, size_t offset, size_t & readLen, size_t & valueLen);
     CHIP_ERROR WriteValue(const char * key, bool val);
     CHIP_ERROR WriteValue(const char * key, uint16_t val);
     CHIP_ERROR WriteValue(const char * key, uint32_t val);
@@ -87,8 +90,26 @@ public:
     CHIP_ERROR Commit();
     bool HasValue(const char * key);
 
+    /**
+     * Get the names of all the entries of the store.
+     */
+    CHIP_ERROR GetKeys(std::vector<std::string> & keys);
+
+    /**
+     * Decode every entry of the store once and keep the binary values in
+     * memory, so that subsequent ReadValueBin() calls are served without
+     * touching the INI representation. Entries that are not valid base64
+     * are skipped.
+     */
+    CHIP_ERROR LoadBinaryValues();
+
 private:
+    // Same as LoadBinaryValues(), with mLock already held.
+    void LoadBinaryValuesLocked();
+
     std::mutex mLock;
+    std::map<std::string, std::vector<uint8_t>> mBinaryValues;
+    bool mBinaryValuesLoaded = false;
     bool mDirty;
     std::string mConfigPath;
     bool mInitialized = false;
@@ -53,9 +53,9 @@ protected:
     CHIP_ERROR AddEntry(const char * key, const char * value);
     CHIP_ERROR RemoveEntry(const char * key);
     CHIP_ERROR RemoveAll();
+    CHIP_ERROR GetDefaultSection(std::map<std::string, std::string> & section);
 
 private:
-    CHIP_ERROR GetDefaultSection(std::map<std::string, std::string> & section);
     CHIP_ERROR GetBinaryBlobDataAndLengths(const char * key, chip::Platform::ScopedMemoryBuffer<char> & encodedData,
                                            size_t & encodedDataLen, size_t & decodedDataLen);
     inipp::Ini<char> mConfigStore;
@@ -24,11 +24,13 @@
 #include <platform/KeyValueStoreManager.h>
 
 #include <algorithm>
+#include <mutex>
 #include <string.h>
+#include <string>
+#include <vector>
 
 #include <lib/support/CodeUtils.h>
 #include <lib/support/logging/CHIPLogging.h>
-#include <platform/Linux/CHIPLinuxStorage.h>
 
 namespace chip {
 namespace DeviceLayer {
@@ -36,55 +38,60 @@ namespace PersistedStorage {
 
 KeyValueStoreManagerImpl KeyValueStoreManagerImpl::sInstance;
 
+CHIP_ERROR KeyValueStoreManagerImpl::Init(const char * file)
+{
+    ReturnErrorOnFailure(mStorage.Init(file));
+
+#if !CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_STORAGE
+    // Decode all values once so that reads never go through base64 again.
+    // The log-structured storage keeps binary values in memory already.
+    ReturnErrorOnFailure(mStorage.LoadBinaryValues());
+#endif
+
+    return CHIP_NO_ERROR;
+}
+
 CHIP_ERROR KeyValueStoreManagerImpl::_Get(const char * key, void * value, size_t value_size, size_t * read_bytes_size,
                                           size_t offset_bytes)
 {
-    size_t read_size;
+    size_t copy_size;
+    size_t value_len;
 
     // Copy data into value buffer
     VerifyOrReturnError(value != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
 
-    // On linux read first without a buffer which returns the size, and then
-    // use a local buffer to read the entire object, which allows partial and
-    // offset reads.
-    CHIP_ERROR err = mStorage.ReadValueBin(key, nullptr, 0, read_size);
+    // The storage keeps decoded values in memory, so this is a lookup and a
+    // single copy of the requested window straight into the caller's buffer.
+    CHIP_ERROR err =
+        mStorage.ReadValueBin(key, reinterpret_cast<uint8_t *>(value), value_size, offset_bytes, copy_size, value_len);
     if (err == CHIP_ERROR_KEY_NOT_FOUND)
     {
         return CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND;
     }
-    if ((err != CHIP_NO_ERROR) && (err != CHIP_ERROR_BUFFER_TOO_SMALL))
-    {
-        return err;
-    }
-    if (offset_bytes > read_size)
-    {
-        return CHIP_ERROR_INVALID_ARGUMENT;
-    }
-
-    Platform::ScopedMemoryBuffer<uint8_t> buf;
-    VerifyOrReturnError(buf.Alloc(read_size), CHIP_ERROR_NO_MEMORY);
-    ReturnErrorOnFailure(mStorage.ReadValueBin(key, buf.Get(), read_size, read_size));
+    ReturnErrorOnFailure(err);
 
-    size_t total_size_to_read = read_size - offset_bytes;
-    size_t copy_size          = std::min(value_size, total_size_to_read);
     if (read_bytes_size != nullptr)
     {
         *read_bytes_size = copy_size;
     }
-    ::memcpy(value, buf.Get() + offset_bytes, copy_size);
 
-    return (value_size < total_size_to_read) ? CHIP_ERROR_BUFFER_TOO_SMALL : CHIP_NO_ERROR;
+    return (value_size < value_len - offset_bytes) ? CHIP_ERROR_BUFFER_TOO_SMALL : CHIP_NO_ERROR;
 }
 
 CHIP_ERROR KeyValueStoreManagerImpl::_Put(const char * key, const void * value, size_t value_size)
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
 
+    std::lock_guard<std::mutex> lock(mBatchLock);
+
+    err = SaveForRollBack(key);
+    SuccessOrExit(err);
+
     err = mStorage.WriteValueBin(key, reinterpret_cast<const uint8_t *>(value), value_size);
     SuccessOrExit(err);
 
     // Commit the value to the persistent store.
-    err = mStorage.Commit();
+    err = CommitOrDefer();
     SuccessOrExit(err);
 
 exit:
@@ -94,8 +101,13 @@ exit:
 CHIP_ERROR KeyValueStoreManagerImpl::_Delete(const char * key)
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
-    err            = mStorage.ClearValue(key);
 
+    std::lock_guard<std::mutex> lock(mBatchLock);
+
+    err = SaveForRollBack(key);
+    SuccessOrExit(err);
+
+    err = mStorage.ClearValue(key);
     if (err == CHIP_ERROR_KEY_NOT_FOUND)
     {
         ExitNow(err = CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
@@ -103,13 +115,156 @@ CHIP_ERROR KeyValueStoreManagerImpl::_Delete(const char * key)
     SuccessOrExit(err);
 
     // Commit the value to the persistent store.
-    err = mStorage.Commit();
+    err = CommitOrDefer();
     SuccessOrExit(err);
 
 exit:
     return err;
 }
 
+CHIP_ERROR KeyValueStoreManagerImpl::_StartBatch()
+{
+    std::lock_guard<std::mutex> lock(mBatchLock);
+
+    mBatchDepth++;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR KeyValueStoreManagerImpl::_CommitBatch()
+{
+    std::lock_guard<std::mutex> lock(mBatchLock);
+
+    VerifyOrReturnError(mBatchDepth > 0, CHIP_ERROR_INCORRECT_STATE);
+
+    if (--mBatchDepth > 0)
+    {
+        return mBatchAborted ? CHIP_ERROR_CANCELLED : CHIP_NO_ERROR;
+    }
+
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    if (mBatchAborted)
+    {
+        // A nested batch was aborted: none of the writes of the batch may be kept.
+        err = CHIP_ERROR_CANCELLED;
+    }
+    else if (mBatchDirty)
+    {
+        err = mStorage.Commit();
+        if (err != CHIP_NO_ERROR)
+        {
+            ChipLogError(DeviceLayer, "KVS batch commit failed: %" CHIP_ERROR_FORMAT, err.Format());
+        }
+    }
+
+    if (err != CHIP_NO_ERROR)
+    {
+        RollBackBatch();
+    }
+    EndBatch();
+
+    return err;
+}
+
+void KeyValueStoreManagerImpl::_AbortBatch()
+{
+    std::lock_guard<std::mutex> lock(mBatchLock);
+
+    VerifyOrReturn(mBatchDepth > 0);
+
+    // Aborting a nested batch aborts the outermost one as well.
+    mBatchAborted = true;
+    if (--mBatchDepth > 0)
+    {
+        return;
+    }
+
+    RollBackBatch();
+    EndBatch();
+}
+
+CHIP_ERROR KeyValueStoreManagerImpl::_ForEachKey(PersistentStorageKeyVisitor & visitor)
+{
+    // Work on a copy of the key names, so that the visitor is free to access the KVS.
+    std::vector<std::string> keys;
+    ReturnErrorOnFailure(mStorage.GetKeys(keys));
+
+    for (const auto & key : keys)
+    {
+        ReturnErrorOnFailure(visitor.OnKey(key.c_str()));
+    }
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR KeyValueStoreManagerImpl::CommitOrDefer()
+{
+    if (mBatchDepth > 0)
+    {
+        mBatchDirty = true;
+        return CHIP_NO_ERROR;
+    }
+
+    return mStorage.Commit();
+}
+
+CHIP_ERROR KeyValueStoreManagerImpl::SaveForRollBack(const char * key)
+{
+    VerifyOrReturnError(key != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(mBatchDepth > 0 && mBatchOriginalValues.find(key) == mBatchOriginalValues.end(), CHIP_NO_ERROR);
+
+    OriginalValue original;
+    size_t readLen  = 0;
+    size_t valueLen = 0;
+    CHIP_ERROR err  = mStorage.ReadValueBin(key, nullptr, 0, 0, readLen, valueLen);
+    if (err == CHIP_NO_ERROR)
+    {
+        original.present = true;
+        original.value.resize(valueLen);
+        err = mStorage.ReadValueBin(key, original.value.data(), valueLen, 0, readLen, valueLen);
+    }
+    else if (err == CHIP_ERROR_KEY_NOT_FOUND)
+    {
+        err = CHIP_NO_ERROR;
+    }
+    ReturnErrorOnFailure(err);
+
+    mBatchOriginalValues.emplace(key, std::move(original));
+    return CHIP_NO_ERROR;
+}
+
+void KeyValueStoreManagerImpl::RollBackBatch()
+{
+    // Only the keys written in the batch are restored, in memory: the storage
+    // file still holds their original values.
+    for (const auto & entry : mBatchOriginalValues)
+    {
+        const char * key = entry.first.c_str();
+        CHIP_ERROR err;
+        if (entry.second.present)
+        {
+            err = mStorage.WriteValueBin(key, entry.second.value.data(), entry.second.value.size());
+        }
+        else
+        {
+            err = mStorage.ClearValue(key);
+        }
+        if (err != CHIP_NO_ERROR && err != CHIP_ERROR_KEY_NOT_FOUND)
+        {
+            ChipLogError(DeviceLayer, "Failed to roll back KVS key %s: %" CHIP_ERROR_FORMAT, key, err.Format());
+        }
+    }
+
+#if CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_STORAGE
+    mStorage.DiscardPendingWrites();
+#endif
+}
+
+void KeyValueStoreManagerImpl::EndBatch()
+{
+    mBatchDirty   = false;
+    mBatchAborted = false;
+    mBatchOriginalValues.clear();
+}
+
 } // namespace PersistedStorage
 } // namespace DeviceLayer
 } // namespace chip
@@ -23,7 +23,19 @@
 
 #pragma once
 
+#include <platform/CHIPDeviceConfig.h>
+
+#include <map>
+#include <mutex>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#if CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_STORAGE
+#include <platform/Linux/CHIPLinuxLogStorage.h>
+#else
 #include <platform/Linux/CHIPLinuxStorage.h>
+#endif
 
 namespace chip {
 namespace DeviceLayer {
@@ -36,14 +48,45 @@ public:
      * @brief
      * Initalize the KVS, must be called before using.
      */
-    CHIP_ERROR Init(const char * file) { return mStorage.Init(file); }
+    CHIP_ERROR Init(const char * file);
 
     CHIP_ERROR _Get(const char * key, void * value, size_t value_size, size_t * read_bytes_size = nullptr, size_t offset = 0);
     CHIP_ERROR _Delete(const char * key);
     CHIP_ERROR _Put(const char * key, const void * value, size_t value_size);
 
+    CHIP_ERROR _StartBatch();
+    CHIP_ERROR _CommitBatch();
+    void _AbortBatch();
+
+    CHIP_ERROR _ForEachKey(PersistentStorageKeyVisitor & visitor);
+
 private:
+    struct OriginalValue
+    {
+        bool present = false;
+        std::vector<uint8_t> value;
+    };
+
+    CHIP_ERROR CommitOrDefer();
+    CHIP_ERROR SaveForRollBack(const char * key);
+    void RollBackBatch();
+    void EndBatch();
+
+#if CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_STORAGE
+    DeviceLayer::Internal::ChipLinuxLogStorage mStorage;
+#else
     DeviceLayer::Internal::ChipLinuxStorage mStorage;
+#endif
+
+    // Writes made while a batch is open are kept in memory and only written
+    // to the storage file when the outermost batch is committed. The original
+    // values of the keys written in the batch are kept until then, so that
+    // aborting the batch only restores these keys.
+    std::mutex mBatchLock;
+    unsigned mBatchDepth = 0;
+    bool mBatchDirty     = false;
+    bool mBatchAborted   = false;
+    std::map<std::string, OriginalValue> mBatchOriginalValues;
 
     // ===== Members for internal use by the following friends.
     friend KeyValueStoreManager & KeyValueStoreMgr();
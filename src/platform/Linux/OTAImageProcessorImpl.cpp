@@ -21,10 +21,58 @@
 
 #include "OTAImageProcessorImpl.h"
 
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
 #include <sys/stat.h>
+#include <system/SystemError.h>
+#include <unistd.h>
+
+#include <algorithm>
 
 namespace chip {
 
+namespace {
+
+// O_DIRECT requires the buffer, the file offset and the length of each write to be aligned on the logical block size of
+// the file system, which is at most the page size.
+constexpr size_t kDirectIOAlignment  = 4096;
+constexpr size_t kDirectIOBufferSize = 256 * 1024;
+
+/**
+ * Returns the length of the SHA-256 digest of the given type, or 0 if the digest is not a SHA-256 digest.
+ */
+size_t GetSha256DigestLength(OTAImageDigestType type)
+{
+    switch (type)
+    {
+    case OTAImageDigestType::kSha256:
+        return 32;
+    case OTAImageDigestType::kSha256_128:
+        return 16;
+    case OTAImageDigestType::kSha256_120:
+        return 15;
+    case OTAImageDigestType::kSha256_96:
+        return 12;
+    case OTAImageDigestType::kSha256_64:
+        return 8;
+    case OTAImageDigestType::kSha256_32:
+        return 4;
+    default:
+        return 0;
+    }
+}
+
+} // namespace
+
+OTAImageProcessorImpl::~OTAImageProcessorImpl()
+{
+    StopWriter();
+    CloseImageFile();
+    ReleaseBlock();
+}
+
 CHIP_ERROR OTAImageProcessorImpl::PrepareDownload()
 {
     if (mImageFile == nullptr)
@@ -63,7 +111,7 @@ CHIP_ERROR OTAImageProcessorImpl::Abort()
 
 CHIP_ERROR OTAImageProcessorImpl::ProcessBlock(ByteSpan & block)
 {
-    if (!mOfs.is_open() || !mOfs.good())
+    if (mFd < 0)
     {
         return CHIP_ERROR_INTERNAL;
     }
@@ -125,18 +173,33 @@ void OTAImageProcessorImpl::HandlePrepareDownload(intptr_t context)
         return;
     }
 
+    // A previous download may not have been finalized nor aborted
+    imageProcessor->StopWriter();
+    imageProcessor->CloseImageFile();
     unlink(imageProcessor->mImageFile);
 
     imageProcessor->mParams.downloadedBytes = 0;
     imageProcessor->mParams.totalFileBytes  = 0;
     imageProcessor->mHeaderParser.Init();
-    imageProcessor->mOfs.open(imageProcessor->mImageFile, std::ofstream::out | std::ofstream::ate | std::ofstream::app);
-    if (!imageProcessor->mOfs.good())
+    imageProcessor->mDigestLength = 0;
+    imageProcessor->mFinalized    = false;
+    imageProcessor->mApplyPending = false;
+
+    CHIP_ERROR error = imageProcessor->OpenImageFile();
+    if (error != CHIP_NO_ERROR)
     {
         imageProcessor->mDownloader->OnPreparedForDownload(CHIP_ERROR_OPEN_FAILED);
         return;
     }
 
+    error = imageProcessor->StartWriter();
+    if (error != CHIP_NO_ERROR)
+    {
+        imageProcessor->CloseImageFile();
+        imageProcessor->mDownloader->OnPreparedForDownload(error);
+        return;
+    }
+
     imageProcessor->mDownloader->OnPreparedForDownload(CHIP_NO_ERROR);
 }
 
@@ -148,10 +211,20 @@ void OTAImageProcessorImpl::HandleFinalize(intptr_t context)
         return;
     }
 
-    imageProcessor->mOfs.close();
     imageProcessor->ReleaseBlock();
 
-    ChipLogProgress(SoftwareUpdate, "OTA image downloaded to %s", imageProcessor->mImageFile);
+    // The I/O thread writes the blocks still queued, then syncs and verifies the image before it stops
+    {
+        std::lock_guard<std::mutex> lock(imageProcessor->mMutex);
+        imageProcessor->mFinalizeRequested = true;
+    }
+    imageProcessor->mQueueCondition.notify_one();
+
+    if (!imageProcessor->mWriter.joinable())
+    {
+        // The I/O thread already stopped on a write error
+        HandleWriterDone(context);
+    }
 }
 
 void OTAImageProcessorImpl::HandleApply(intptr_t context)
@@ -162,6 +235,21 @@ void OTAImageProcessorImpl::HandleApply(intptr_t context)
     OTARequestorInterface * requestor = chip::GetRequestorInstance();
     VerifyOrReturn(requestor != nullptr);
 
+    if (!imageProcessor->mFinalized)
+    {
+        // The image is applied once it is written and verified
+        imageProcessor->mApplyPending = true;
+        return;
+    }
+
+    if (imageProcessor->mWriteResult != CHIP_NO_ERROR)
+    {
+        ChipLogError(SoftwareUpdate, "Not applying invalid OTA image: %" CHIP_ERROR_FORMAT, imageProcessor->mWriteResult.Format());
+        unlink(imageProcessor->mImageFile);
+        requestor->CancelImageUpdate();
+        return;
+    }
+
     // Move the downloaded image to the location where the new image is to be executed from
     unlink(kImageExecPath);
     rename(imageProcessor->mImageFile, kImageExecPath);
@@ -180,9 +268,11 @@ void OTAImageProcessorImpl::HandleAbort(intptr_t context)
         return;
     }
 
-    imageProcessor->mOfs.close();
+    imageProcessor->StopWriter();
+    imageProcessor->CloseImageFile();
     unlink(imageProcessor->mImageFile);
     imageProcessor->ReleaseBlock();
+    imageProcessor->mApplyPending = false;
 }
 
 void OTAImageProcessorImpl::HandleProcessBlock(intptr_t context)
@@ -208,16 +298,68 @@ void OTAImageProcessorImpl::HandleProcessBlock(intptr_t context)
         return;
     }
 
-    if (!imageProcessor->mOfs.write(reinterpret_cast<const char *>(block.data()), static_cast<std::streamsize>(block.size())))
+    imageProcessor->mParams.downloadedBytes += block.size();
+
+    // Otherwise, the next block is fetched once the I/O thread catches up, or the download ends on a write error
+    if (imageProcessor->QueueBlock(block))
     {
-        imageProcessor->mDownloader->EndDownload(CHIP_ERROR_WRITE_FAILED);
-        return;
+        imageProcessor->mDownloader->FetchNextData();
     }
+}
+
+void OTAImageProcessorImpl::HandleBlockWritten(intptr_t context)
+{
+    auto * imageProcessor = reinterpret_cast<OTAImageProcessorImpl *>(context);
+    VerifyOrReturn(imageProcessor != nullptr && imageProcessor->mDownloader != nullptr);
 
-    imageProcessor->mParams.downloadedBytes += block.size();
     imageProcessor->mDownloader->FetchNextData();
 }
 
+void OTAImageProcessorImpl::HandleWriterDone(intptr_t context)
+{
+    auto * imageProcessor = reinterpret_cast<OTAImageProcessorImpl *>(context);
+    VerifyOrReturn(imageProcessor != nullptr);
+
+    {
+        // Ignore a notification of the I/O thread of an aborted download
+        std::lock_guard<std::mutex> lock(imageProcessor->mMutex);
+        VerifyOrReturn(imageProcessor->mWriterDone);
+    }
+    if (imageProcessor->mWriter.joinable())
+    {
+        imageProcessor->mWriter.join();
+    }
+    imageProcessor->CloseImageFile();
+
+    if (!imageProcessor->mFinalizeRequested)
+    {
+        ChipLogError(SoftwareUpdate, "Cannot write OTA image: %" CHIP_ERROR_FORMAT, imageProcessor->mWriteResult.Format());
+        if (imageProcessor->mDownloader != nullptr)
+        {
+            imageProcessor->mDownloader->EndDownload(CHIP_ERROR_WRITE_FAILED);
+        }
+        return;
+    }
+
+    if (imageProcessor->mHeaderParser.IsInitialized() && imageProcessor->mWriteResult == CHIP_NO_ERROR)
+    {
+        ChipLogError(SoftwareUpdate, "Image ended before its header");
+        imageProcessor->mWriteResult = CHIP_ERROR_INVALID_FILE_IDENTIFIER;
+    }
+
+    imageProcessor->mFinalized = true;
+    if (imageProcessor->mWriteResult == CHIP_NO_ERROR)
+    {
+        ChipLogProgress(SoftwareUpdate, "OTA image downloaded to %s", imageProcessor->mImageFile);
+    }
+
+    if (imageProcessor->mApplyPending)
+    {
+        imageProcessor->mApplyPending = false;
+        HandleApply(context);
+    }
+}
+
 CHIP_ERROR OTAImageProcessorImpl::ProcessHeader(ByteSpan & block)
 {
     if (mHeaderParser.IsInitialized())
@@ -230,6 +372,17 @@ CHIP_ERROR OTAImageProcessorImpl::ProcessHeader(ByteSpan & block)
         ReturnErrorOnFailure(error);
 
         mParams.totalFileBytes = header.mPayloadSize;
+
+        // The digest of the header does not outlive the parser
+        mDigestLength = GetSha256DigestLength(header.mImageDigestType);
+        VerifyOrReturnError(mDigestLength == 0 || header.mImageDigest.size() == mDigestLength, CHIP_ERROR_INVALID_FILE_IDENTIFIER);
+        if (mDigestLength == 0)
+        {
+            ChipLogProgress(SoftwareUpdate, "Image digest type %u cannot be verified",
+                            static_cast<unsigned>(header.mImageDigestType));
+        }
+        memcpy(mDigest, header.mImageDigest.data(), mDigestLength);
+
         mHeaderParser.Clear();
     }
 
@@ -276,4 +429,231 @@ CHIP_ERROR OTAImageProcessorImpl::ReleaseBlock()
     return CHIP_NO_ERROR;
 }
 
+CHIP_ERROR OTAImageProcessorImpl::OpenImageFile()
+{
+    constexpr int kFlags   = O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC;
+    constexpr mode_t kMode = S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH;
+
+    if (mDirectIO)
+    {
+        mFd = open(mImageFile, kFlags | O_DIRECT, kMode);
+        if (mFd >= 0)
+        {
+            void * buffer = nullptr;
+            if (posix_memalign(&buffer, kDirectIOAlignment, kDirectIOBufferSize) == 0)
+            {
+                mDirectBuffer     = static_cast<uint8_t *>(buffer);
+                mDirectBufferUsed = 0;
+                return CHIP_NO_ERROR;
+            }
+            close(mFd);
+        }
+        // e.g. tmpfs does not support O_DIRECT
+        ChipLogProgress(SoftwareUpdate, "Cannot write %s with O_DIRECT, using the page cache", mImageFile);
+    }
+
+    mFd = open(mImageFile, kFlags, kMode);
+    VerifyOrReturnError(mFd >= 0, CHIP_ERROR_POSIX(errno));
+    return CHIP_NO_ERROR;
+}
+
+void OTAImageProcessorImpl::CloseImageFile()
+{
+    if (mFd >= 0)
+    {
+        close(mFd);
+        mFd = -1;
+    }
+
+    free(mDirectBuffer);
+    mDirectBuffer     = nullptr;
+    mDirectBufferUsed = 0;
+}
+
+CHIP_ERROR OTAImageProcessorImpl::StartWriter()
+{
+    VerifyOrReturnError(!mWriter.joinable(), CHIP_ERROR_INCORRECT_STATE);
+    ReturnErrorOnFailure(mHash.Begin());
+
+    mQueue.clear();
+    mFinalizeRequested = false;
+    mStopRequested     = false;
+    mFetchPending      = false;
+    mWriterDone        = false;
+    mWriteResult       = CHIP_NO_ERROR;
+    mBytesSinceSync    = 0;
+
+    mWriter = std::thread(&OTAImageProcessorImpl::WriterMain, this);
+    return CHIP_NO_ERROR;
+}
+
+void OTAImageProcessorImpl::StopWriter()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStopRequested = true;
+        mQueue.clear();
+    }
+    mQueueCondition.notify_one();
+
+    if (mWriter.joinable())
+    {
+        mWriter.join();
+    }
+
+    // The I/O thread may have stopped on a write error just before, and its notification is still scheduled
+    std::lock_guard<std::mutex> lock(mMutex);
+    mWriterDone = false;
+}
+
+bool OTAImageProcessorImpl::QueueBlock(const ByteSpan & block)
+{
+    bool hasRoom;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        VerifyOrReturnValue(mWriteResult == CHIP_NO_ERROR, false);
+
+        mQueue.emplace_back(block.begin(), block.end());
+        hasRoom       = mQueue.size() < mMaxQueuedBlocks;
+        mFetchPending = !hasRoom;
+    }
+    mQueueCondition.notify_one();
+
+    return hasRoom;
+}
+
+void OTAImageProcessorImpl::WriterMain()
+{
+    CHIP_ERROR error = CHIP_NO_ERROR;
+
+    while (true)
+    {
+        std::vector<uint8_t> block;
+        bool fetchNext = false;
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mQueueCondition.wait(lock, [this] { return mStopRequested || mFinalizeRequested || !mQueue.empty(); });
+
+            // The download was aborted: nothing is reported
+            VerifyOrReturn(!mStopRequested);
+
+            if (mQueue.empty())
+            {
+                break;
+            }
+
+            block = std::move(mQueue.front());
+            mQueue.pop_front();
+            if (mFetchPending && mQueue.size() < mMaxQueuedBlocks)
+            {
+                mFetchPending = false;
+                fetchNext     = true;
+            }
+        }
+
+        error = WriteBlock(ByteSpan(block.data(), block.size()));
+        if (error != CHIP_NO_ERROR)
+        {
+            break;
+        }
+
+        if (fetchNext)
+        {
+            DeviceLayer::PlatformMgr().ScheduleWork(HandleBlockWritten, reinterpret_cast<intptr_t>(this));
+        }
+    }
+
+    if (error == CHIP_NO_ERROR)
+    {
+        error = FlushAndVerify();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mWriteResult = error;
+        mWriterDone  = true;
+    }
+    DeviceLayer::PlatformMgr().ScheduleWork(HandleWriterDone, reinterpret_cast<intptr_t>(this));
+}
+
+CHIP_ERROR OTAImageProcessorImpl::WriteBlock(const ByteSpan & block)
+{
+    ReturnErrorOnFailure(mHash.AddData(block));
+
+    if (mDirectBuffer == nullptr)
+    {
+        ReturnErrorOnFailure(WriteFully(block.data(), block.size()));
+    }
+    else
+    {
+        // Writes go out in whole staging buffers, which keeps them aligned
+        for (size_t offset = 0; offset < block.size();)
+        {
+            const size_t length = std::min(block.size() - offset, kDirectIOBufferSize - mDirectBufferUsed);
+            memcpy(mDirectBuffer + mDirectBufferUsed, block.data() + offset, length);
+            mDirectBufferUsed += length;
+            offset += length;
+
+            if (mDirectBufferUsed == kDirectIOBufferSize)
+            {
+                ReturnErrorOnFailure(WriteFully(mDirectBuffer, kDirectIOBufferSize));
+                mDirectBufferUsed = 0;
+            }
+        }
+    }
+
+    mBytesSinceSync += block.size();
+    if (mSyncInterval > 0 && mBytesSinceSync >= mSyncInterval)
+    {
+        VerifyOrReturnError(fdatasync(mFd) == 0, CHIP_ERROR_POSIX(errno));
+        mBytesSinceSync = 0;
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR OTAImageProcessorImpl::WriteFully(const uint8_t * data, size_t length)
+{
+    while (length > 0)
+    {
+        const ssize_t written = write(mFd, data, length);
+        if (written < 0)
+        {
+            VerifyOrReturnError(errno == EINTR, CHIP_ERROR_POSIX(errno));
+            continue;
+        }
+
+        data += written;
+        length -= static_cast<size_t>(written);
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR OTAImageProcessorImpl::FlushAndVerify()
+{
+    if (mDirectBufferUsed > 0)
+    {
+        // The tail of the image is not a whole number of blocks, so it is written through the page cache
+        const int flags = fcntl(mFd, F_GETFL);
+        VerifyOrReturnError(flags >= 0 && fcntl(mFd, F_SETFL, flags & ~O_DIRECT) == 0, CHIP_ERROR_POSIX(errno));
+        ReturnErrorOnFailure(WriteFully(mDirectBuffer, mDirectBufferUsed));
+        mDirectBufferUsed = 0;
+    }
+    VerifyOrReturnError(fsync(mFd) == 0, CHIP_ERROR_POSIX(errno));
+
+    uint8_t digestBuffer[Crypto::kSHA256_Hash_Length];
+    MutableByteSpan digest(digestBuffer);
+    ReturnErrorOnFailure(mHash.Finish(digest));
+
+    // Truncated digests are the leading bytes of the SHA-256 digest
+    if (mDigestLength > 0 && memcmp(digest.data(), mDigest, mDigestLength) != 0)
+    {
+        ChipLogError(SoftwareUpdate, "OTA image digest mismatch");
+        return CHIP_ERROR_INTEGRITY_CHECK_FAILED;
+    }
+
+    return CHIP_NO_ERROR;
+}
+
 } // namespace chip
@@ -19,20 +19,42 @@
 #pragma once
 
 #include <app/clusters/ota-requestor/OTADownloader.h>
+#include <crypto/CHIPCryptoPAL.h>
 #include <lib/core/OTAImageHeader.h>
 #include <platform/CHIPDeviceLayer.h>
 #include <platform/OTAImageProcessor.h>
 
-#include <fstream>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 namespace chip {
 
 // Full file path to where the new image will be executed from post-download
 static char kImageExecPath[] = "/tmp/ota.update";
 
+/**
+ * Stores the payload of a downloaded OTA image in a file.
+ *
+ * The blocks are written behind the download by a dedicated I/O thread: a block is queued and the next one is fetched right
+ * away, unless the queue is full, so that disk latency neither throttles the transfer nor stalls the CHIP event loop. The
+ * SHA-256 digest of the payload is computed by the I/O thread as the blocks are written, and compared with the digest of the
+ * image header once the download is finalized, so that verifying the image takes no extra pass over the file. An image that
+ * fails the verification is not applied.
+ */
 class OTAImageProcessorImpl : public OTAImageProcessorInterface
 {
 public:
+    // Number of downloaded blocks that may wait to be written before the next block is fetched
+    static constexpr size_t kDefaultMaxQueuedBlocks = 16;
+
+    // Number of bytes written between two syncs of the file to the disk
+    static constexpr size_t kDefaultSyncInterval = 1024 * 1024;
+
+    ~OTAImageProcessorImpl();
+
     //////////// OTAImageProcessorInterface Implementation ///////////////
     CHIP_ERROR PrepareDownload() override;
     CHIP_ERROR Finalize() override;
@@ -45,6 +67,14 @@ public:
     void SetOTADownloader(OTADownloader * downloader) { mDownloader = downloader; }
     void SetOTAImageFile(const char * imageFile) { mImageFile = imageFile; }
 
+    // The following settings take effect on the next download.
+
+    // Writes the image with O_DIRECT, bypassing the page cache, if the file system supports it
+    void SetDirectIO(bool enable) { mDirectIO = enable; }
+    void SetMaxQueuedBlocks(size_t count) { mMaxQueuedBlocks = (count > 0) ? count : 1; }
+    // Syncs the file to the disk every given number of bytes, or only once the download is finalized if 0
+    void SetSyncInterval(size_t bytes) { mSyncInterval = bytes; }
+
 private:
     //////////// Actual handlers for the OTAImageProcessorInterface ///////////////
     static void HandlePrepareDownload(intptr_t context);
@@ -53,6 +83,10 @@ private:
     static void HandleAbort(intptr_t context);
     static void HandleProcessBlock(intptr_t context);
 
+    //////////// Notifications of the I/O thread, run on the CHIP event loop ///////////////
+    static void HandleBlockWritten(intptr_t context);
+    static void HandleWriterDone(intptr_t context);
+
     CHIP_ERROR ProcessHeader(ByteSpan & block);
 
     /**
@@ -65,11 +99,59 @@ private:
      */
     CHIP_ERROR ReleaseBlock();
 
-    std::ofstream mOfs;
+    //////////// I/O thread ///////////////
+    CHIP_ERROR OpenImageFile();
+    void CloseImageFile();
+    CHIP_ERROR StartWriter();
+    void StopWriter();
+
+    /**
+     * Queues a block to be written.
+     *
+     * @return Whether the queue has room for another block, in which case the next block can be fetched.
+     */
+    bool QueueBlock(const ByteSpan & block);
+
+    void WriterMain();
+    CHIP_ERROR WriteBlock(const ByteSpan & block);
+    CHIP_ERROR WriteFully(const uint8_t * data, size_t length);
+    CHIP_ERROR FlushAndVerify();
+
+    int mFd = -1;
     MutableByteSpan mBlock;
     OTADownloader * mDownloader;
     OTAImageHeaderParser mHeaderParser;
     const char * mImageFile = nullptr;
+
+    // Settings
+    bool mDirectIO          = false;
+    size_t mMaxQueuedBlocks = kDefaultMaxQueuedBlocks;
+    size_t mSyncInterval    = kDefaultSyncInterval;
+
+    // Expected digest of the payload, from the image header
+    uint8_t mDigest[Crypto::kSHA256_Hash_Length];
+    size_t mDigestLength = 0;
+
+    // State of the download, only accessed from the CHIP event loop
+    bool mFinalized    = false;
+    bool mApplyPending = false;
+
+    // State shared with the I/O thread, guarded by mMutex
+    std::mutex mMutex;
+    std::condition_variable mQueueCondition;
+    std::deque<std::vector<uint8_t>> mQueue;
+    bool mFinalizeRequested = false;
+    bool mStopRequested     = false;
+    bool mFetchPending      = false;
+    bool mWriterDone        = false;
+    CHIP_ERROR mWriteResult = CHIP_NO_ERROR;
+    std::thread mWriter;
+
+    // State owned by the I/O thread while it runs, then by the CHIP event loop once it is joined
+    Crypto::Hash_SHA256_stream mHash;
+    uint8_t * mDirectBuffer  = nullptr; // Aligned staging buffer of the O_DIRECT writes
+    size_t mDirectBufferUsed = 0;
+    size_t mBytesSinceSync   = 0;
 };
 
 } // namespace chip
@@ -0,0 +1,182 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test suite for the Linux implementation
+ *      of the Key Value Store Manager, with whichever storage backend the
+ *      build selects.
+ *
+ */
+
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include <pw_unit_test/framework.h>
+
+#include <lib/core/StringBuilderAdapters.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/PersistentStorageSnapshot.h>
+#include <platform/KeyValueStoreManager.h>
+#include <platform/KvsPersistentStorageDelegate.h>
+
+using namespace chip;
+using namespace chip::DeviceLayer::PersistedStorage;
+
+namespace {
+
+struct TestLinuxKeyValueStoreMgr : public ::testing::Test
+{
+    static void SetUpTestSuite() { ASSERT_EQ(chip::Platform::MemoryInit(), CHIP_NO_ERROR); }
+    static void TearDownTestSuite() { chip::Platform::MemoryShutdown(); }
+
+    void SetUp() override
+    {
+        char path[] = "/tmp/chip_kvs_mgr_test-XXXXXX";
+        int fd      = mkstemp(path);
+        ASSERT_NE(fd, -1);
+        close(fd);
+        unlink(path);
+        mPath = path;
+    }
+
+    void TearDown() override { unlink(mPath.c_str()); }
+
+    std::string mPath;
+};
+
+class VectorSink : public PersistentStorageSnapshotSink
+{
+public:
+    CHIP_ERROR Write(ByteSpan data) override
+    {
+        mData.insert(mData.end(), data.begin(), data.end());
+        return CHIP_NO_ERROR;
+    }
+
+    std::vector<uint8_t> mData;
+};
+
+TEST_F(TestLinuxKeyValueStoreMgr, AbortRestoresBatchKeysOnly)
+{
+    KeyValueStoreManagerImpl kvs;
+    ASSERT_EQ(kvs.Init(mPath.c_str()), CHIP_NO_ERROR);
+
+    EXPECT_EQ(kvs.Put("kept", uint32_t(1)), CHIP_NO_ERROR);
+    EXPECT_EQ(kvs.Put("updated", uint32_t(1)), CHIP_NO_ERROR);
+    EXPECT_EQ(kvs.Put("deleted", uint32_t(1)), CHIP_NO_ERROR);
+
+    EXPECT_EQ(kvs.StartBatch(), CHIP_NO_ERROR);
+    EXPECT_EQ(kvs.Put("updated", uint32_t(2)), CHIP_NO_ERROR);
+    EXPECT_EQ(kvs.Put("added", uint32_t(2)), CHIP_NO_ERROR);
+    EXPECT_EQ(kvs.Delete("deleted"), CHIP_NO_ERROR);
+    kvs.AbortBatch();
+
+    uint32_t value = 0;
+    EXPECT_EQ(kvs.Get("kept", &value), CHIP_NO_ERROR);
+    EXPECT_EQ(value, 1u);
+    EXPECT_EQ(kvs.Get("updated", &value), CHIP_NO_ERROR);
+    EXPECT_EQ(value, 1u);
+    EXPECT_EQ(kvs.Get("deleted", &value), CHIP_NO_ERROR);
+    EXPECT_EQ(kvs.Get("added", &value), CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+
+    // Nothing of the aborted batch reaches the file.
+    KeyValueStoreManagerImpl reloaded;
+    ASSERT_EQ(reloaded.Init(mPath.c_str()), CHIP_NO_ERROR);
+    EXPECT_EQ(reloaded.Get("updated", &value), CHIP_NO_ERROR);
+    EXPECT_EQ(value, 1u);
+    EXPECT_EQ(reloaded.Get("added", &value), CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+}
+
+TEST_F(TestLinuxKeyValueStoreMgr, NestedAbortAbortsOutermostBatch)
+{
+    KeyValueStoreManagerImpl kvs;
+    ASSERT_EQ(kvs.Init(mPath.c_str()), CHIP_NO_ERROR);
+
+    EXPECT_EQ(kvs.StartBatch(), CHIP_NO_ERROR);
+    EXPECT_EQ(kvs.Put("outer", uint32_t(1)), CHIP_NO_ERROR);
+
+    EXPECT_EQ(kvs.StartBatch(), CHIP_NO_ERROR);
+    EXPECT_EQ(kvs.Put("inner", uint32_t(1)), CHIP_NO_ERROR);
+    kvs.AbortBatch();
+
+    EXPECT_EQ(kvs.Put("after", uint32_t(1)), CHIP_NO_ERROR);
+    EXPECT_EQ(kvs.CommitBatch(), CHIP_ERROR_CANCELLED);
+
+    uint32_t value = 0;
+    EXPECT_EQ(kvs.Get("outer", &value), CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+    EXPECT_EQ(kvs.Get("inner", &value), CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+    EXPECT_EQ(kvs.Get("after", &value), CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+
+    // The next batch is committed normally.
+    EXPECT_EQ(kvs.StartBatch(), CHIP_NO_ERROR);
+    EXPECT_EQ(kvs.Put("outer", uint32_t(2)), CHIP_NO_ERROR);
+    EXPECT_EQ(kvs.CommitBatch(), CHIP_NO_ERROR);
+
+    KeyValueStoreManagerImpl reloaded;
+    ASSERT_EQ(reloaded.Init(mPath.c_str()), CHIP_NO_ERROR);
+    EXPECT_EQ(reloaded.Get("outer", &value), CHIP_NO_ERROR);
+    EXPECT_EQ(value, 2u);
+    EXPECT_EQ(reloaded.Get("inner", &value), CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+}
+
+TEST_F(TestLinuxKeyValueStoreMgr, SnapshotKeepsKeysThatNeedEscaping)
+{
+    // Spaces, '=' and '\' are escaped in the INI representation.
+    const char * kKeys[] = { "plain", "with space", "a=b", "back\\slash" };
+
+    KeyValueStoreManagerImpl kvs;
+    ASSERT_EQ(kvs.Init(mPath.c_str()), CHIP_NO_ERROR);
+    for (uint32_t i = 0; i < ArraySize(kKeys); i++)
+    {
+        EXPECT_EQ(kvs.Put(kKeys[i], i), CHIP_NO_ERROR);
+    }
+
+    uint8_t buffer[64];
+    VectorSink sink;
+    KvsPersistentStorageDelegate storage;
+    ASSERT_EQ(storage.Init(&kvs), CHIP_NO_ERROR);
+    PersistentStorageSnapshotExporter exporter(storage, sink, MutableByteSpan(buffer));
+    EXPECT_EQ(exporter.Begin(), CHIP_NO_ERROR);
+    EXPECT_EQ(exporter.ExportAllKeys(), CHIP_NO_ERROR);
+    EXPECT_EQ(exporter.End(), CHIP_NO_ERROR);
+    EXPECT_EQ(exporter.GetRecordCount(), ArraySize(kKeys));
+
+    std::string restoredPath = mPath + ".restored";
+    unlink(restoredPath.c_str());
+    {
+        KeyValueStoreManagerImpl restored;
+        ASSERT_EQ(restored.Init(restoredPath.c_str()), CHIP_NO_ERROR);
+        KvsPersistentStorageDelegate restoredStorage;
+        ASSERT_EQ(restoredStorage.Init(&restored), CHIP_NO_ERROR);
+
+        PersistentStorageSnapshotImporter importer(&restoredStorage, MutableByteSpan(buffer));
+        EXPECT_EQ(importer.Feed(ByteSpan(sink.mData.data(), sink.mData.size())), CHIP_NO_ERROR);
+        EXPECT_EQ(importer.Finish(), CHIP_NO_ERROR);
+
+        for (uint32_t i = 0; i < ArraySize(kKeys); i++)
+        {
+            uint32_t value = UINT32_MAX;
+            EXPECT_EQ(restored.Get(kKeys[i], &value), CHIP_NO_ERROR);
+            EXPECT_EQ(value, i);
+        }
+    }
+    unlink(restoredPath.c_str());
+}
+
+} // namespace
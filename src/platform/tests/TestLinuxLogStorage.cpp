@@ -0,0 +1,447 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test suite for the Linux log-structured
+ *      key-value storage.
+ *
+ */
+
+#include <fcntl.h>
+#include <fstream>
+#include <signal.h>
+#include <string>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+#include <pw_unit_test/framework.h>
+
+#include <lib/core/StringBuilderAdapters.h>
+#include <platform/CHIPDeviceConfig.h>
+#include <platform/Linux/CHIPLinuxLogStorage.h>
+
+using namespace chip;
+using namespace chip::DeviceLayer::Internal;
+
+namespace {
+
+struct TestLinuxLogStorage : public ::testing::Test
+{
+    void SetUp() override
+    {
+        char path[] = "/tmp/chip_kvs_log_test-XXXXXX";
+        int fd      = mkstemp(path);
+        ASSERT_NE(fd, -1);
+        close(fd);
+        unlink(path);
+        mPath = path;
+    }
+
+    void TearDown() override { unlink(mPath.c_str()); }
+
+    off_t FileSize()
+    {
+        struct stat st;
+        return (stat(mPath.c_str(), &st) == 0) ? st.st_size : -1;
+    }
+
+    std::string mPath;
+};
+
+TEST_F(TestLinuxLogStorage, PutGetDeletePersist)
+{
+    const uint8_t value1[] = { 0x00, 0x01, 0x02, 0xFF };
+    const uint8_t value2[] = { 0xAA };
+    uint8_t buf[8];
+    size_t len;
+
+    {
+        ChipLinuxLogStorage storage;
+        ASSERT_EQ(storage.Init(mPath.c_str()), CHIP_NO_ERROR);
+
+        EXPECT_EQ(storage.WriteValueBin("a", value1, sizeof(value1)), CHIP_NO_ERROR);
+        EXPECT_EQ(storage.WriteValueBin("b", value2, sizeof(value2)), CHIP_NO_ERROR);
+        EXPECT_EQ(storage.WriteValueBin("empty", nullptr, 0), CHIP_NO_ERROR);
+        EXPECT_EQ(storage.Commit(), CHIP_NO_ERROR);
+
+        EXPECT_EQ(storage.ClearValue("b"), CHIP_NO_ERROR);
+        EXPECT_EQ(storage.ClearValue("b"), CHIP_ERROR_KEY_NOT_FOUND);
+        EXPECT_EQ(storage.Commit(), CHIP_NO_ERROR);
+
+        EXPECT_EQ(storage.ReadValueBin("a", buf, 2, len), CHIP_ERROR_BUFFER_TOO_SMALL);
+        EXPECT_EQ(len, sizeof(value1));
+    }
+
+    ChipLinuxLogStorage storage;
+    ASSERT_EQ(storage.Init(mPath.c_str()), CHIP_NO_ERROR);
+
+    EXPECT_EQ(storage.ReadValueBin("a", buf, sizeof(buf), len), CHIP_NO_ERROR);
+    EXPECT_EQ(len, sizeof(value1));
+    EXPECT_EQ(memcmp(buf, value1, sizeof(value1)), 0);
+
+    EXPECT_TRUE(storage.HasValue("empty"));
+    EXPECT_EQ(storage.ReadValueBin("empty", buf, sizeof(buf), len), CHIP_NO_ERROR);
+    EXPECT_EQ(len, 0u);
+
+    EXPECT_FALSE(storage.HasValue("b"));
+    EXPECT_EQ(storage.ReadValueBin("b", buf, sizeof(buf), len), CHIP_ERROR_KEY_NOT_FOUND);
+}
+
+TEST_F(TestLinuxLogStorage, PartialRead)
+{
+    const uint8_t value[] = { 0, 1, 2, 3, 4, 5, 6, 7 };
+    uint8_t buf[4];
+    size_t readLen;
+    size_t valueLen;
+
+    ChipLinuxLogStorage storage;
+    ASSERT_EQ(storage.Init(mPath.c_str()), CHIP_NO_ERROR);
+    EXPECT_EQ(storage.WriteValueBin("key", value, sizeof(value)), CHIP_NO_ERROR);
+
+    EXPECT_EQ(storage.ReadValueBin("key", buf, sizeof(buf), 2, readLen, valueLen), CHIP_NO_ERROR);
+    EXPECT_EQ(readLen, sizeof(buf));
+    EXPECT_EQ(valueLen, sizeof(value));
+    EXPECT_EQ(memcmp(buf, &value[2], sizeof(buf)), 0);
+
+    EXPECT_EQ(storage.ReadValueBin("key", buf, sizeof(buf), 6, readLen, valueLen), CHIP_NO_ERROR);
+    EXPECT_EQ(readLen, 2u);
+    EXPECT_EQ(buf[1], 7);
+
+    EXPECT_EQ(storage.ReadValueBin("key", buf, sizeof(buf), sizeof(value), readLen, valueLen), CHIP_NO_ERROR);
+    EXPECT_EQ(readLen, 0u);
+
+    EXPECT_EQ(storage.ReadValueBin("key", buf, sizeof(buf), sizeof(value) + 1, readLen, valueLen), CHIP_ERROR_INVALID_ARGUMENT);
+}
+
+TEST_F(TestLinuxLogStorage, UncommittedWritesAreLost)
+{
+    const uint8_t value[] = { 1, 2, 3 };
+    uint8_t buf[8];
+    size_t len;
+
+    {
+        ChipLinuxLogStorage storage;
+        ASSERT_EQ(storage.Init(mPath.c_str()), CHIP_NO_ERROR);
+        EXPECT_EQ(storage.WriteValueBin("committed", value, sizeof(value)), CHIP_NO_ERROR);
+        EXPECT_EQ(storage.Commit(), CHIP_NO_ERROR);
+        EXPECT_EQ(storage.WriteValueBin("pending", value, sizeof(value)), CHIP_NO_ERROR);
+    }
+
+    ChipLinuxLogStorage storage;
+    ASSERT_EQ(storage.Init(mPath.c_str()), CHIP_NO_ERROR);
+    EXPECT_EQ(storage.ReadValueBin("committed", buf, sizeof(buf), len), CHIP_NO_ERROR);
+    EXPECT_EQ(storage.ReadValueBin("pending", buf, sizeof(buf), len), CHIP_ERROR_KEY_NOT_FOUND);
+}
+
+TEST_F(TestLinuxLogStorage, TornTailIsDiscarded)
+{
+    const uint8_t value[] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    uint8_t buf[16];
+    size_t len;
+    off_t goodSize;
+
+    {
+        ChipLinuxLogStorage storage;
+        ASSERT_EQ(storage.Init(mPath.c_str()), CHIP_NO_ERROR);
+        EXPECT_EQ(storage.WriteValueBin("first", value, sizeof(value)), CHIP_NO_ERROR);
+        EXPECT_EQ(storage.Commit(), CHIP_NO_ERROR);
+        goodSize = FileSize();
+
+        EXPECT_EQ(storage.WriteValueBin("second", value, sizeof(value)), CHIP_NO_ERROR);
+        EXPECT_EQ(storage.Commit(), CHIP_NO_ERROR);
+    }
+
+    // Simulate a power loss in the middle of writing the second record.
+    ASSERT_EQ(truncate(mPath.c_str(), FileSize() - 3), 0);
+
+    {
+        ChipLinuxLogStorage storage;
+        ASSERT_EQ(storage.Init(mPath.c_str()), CHIP_NO_ERROR);
+        EXPECT_EQ(storage.ReadValueBin("first", buf, sizeof(buf), len), CHIP_NO_ERROR);
+        EXPECT_EQ(storage.ReadValueBin("second", buf, sizeof(buf), len), CHIP_ERROR_KEY_NOT_FOUND);
+        EXPECT_EQ(FileSize(), goodSize);
+
+        // The log must remain appendable after recovery.
+        EXPECT_EQ(storage.WriteValueBin("third", value, sizeof(value)), CHIP_NO_ERROR);
+        EXPECT_EQ(storage.Commit(), CHIP_NO_ERROR);
+    }
+
+    // Corrupt a byte inside the last record's value.
+    {
+        int fd = open(mPath.c_str(), O_RDWR);
+        ASSERT_NE(fd, -1);
+        uint8_t garbage = 0x5A;
+        EXPECT_EQ(pwrite(fd, &garbage, 1, FileSize() - 1), 1);
+        close(fd);
+    }
+
+    ChipLinuxLogStorage storage;
+    ASSERT_EQ(storage.Init(mPath.c_str()), CHIP_NO_ERROR);
+    EXPECT_EQ(storage.ReadValueBin("first", buf, sizeof(buf), len), CHIP_NO_ERROR);
+    EXPECT_EQ(storage.ReadValueBin("third", buf, sizeof(buf), len), CHIP_ERROR_KEY_NOT_FOUND);
+}
+
+TEST_F(TestLinuxLogStorage, TornBatchIsDiscarded)
+{
+    const uint8_t value[] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    uint8_t buf[16];
+    size_t len;
+    off_t goodSize;
+
+    {
+        ChipLinuxLogStorage storage;
+        ASSERT_EQ(storage.Init(mPath.c_str()), CHIP_NO_ERROR);
+        EXPECT_EQ(storage.WriteValueBin("first", value, sizeof(value)), CHIP_NO_ERROR);
+        EXPECT_EQ(storage.Commit(), CHIP_NO_ERROR);
+        goodSize = FileSize();
+
+        // Multi-record commit
+        EXPECT_EQ(storage.WriteValueBin("second", value, sizeof(value)), CHIP_NO_ERROR);
+        EXPECT_EQ(storage.WriteValueBin("third", value, sizeof(value)), CHIP_NO_ERROR);
+        EXPECT_EQ(storage.ClearValue("first"), CHIP_NO_ERROR);
+        EXPECT_EQ(storage.Commit(), CHIP_NO_ERROR);
+    }
+
+    {
+        ChipLinuxLogStorage storage;
+        ASSERT_EQ(storage.Init(mPath.c_str()), CHIP_NO_ERROR);
+        EXPECT_EQ(storage.ReadValueBin("first", buf, sizeof(buf), len), CHIP_ERROR_KEY_NOT_FOUND);
+        EXPECT_EQ(storage.ReadValueBin("second", buf, sizeof(buf), len), CHIP_NO_ERROR);
+        EXPECT_EQ(storage.ReadValueBin("third", buf, sizeof(buf), len), CHIP_NO_ERROR);
+    }
+
+    // Simulate a power loss after the first records of the batch made it to disk.
+    ASSERT_EQ(truncate(mPath.c_str(), FileSize() - 3), 0);
+
+    ChipLinuxLogStorage storage;
+    ASSERT_EQ(storage.Init(mPath.c_str()), CHIP_NO_ERROR);
+    EXPECT_EQ(storage.ReadValueBin("first", buf, sizeof(buf), len), CHIP_NO_ERROR);
+    EXPECT_EQ(storage.ReadValueBin("second", buf, sizeof(buf), len), CHIP_ERROR_KEY_NOT_FOUND);
+    EXPECT_EQ(storage.ReadValueBin("third", buf, sizeof(buf), len), CHIP_ERROR_KEY_NOT_FOUND);
+    EXPECT_EQ(FileSize(), goodSize);
+}
+
+TEST_F(TestLinuxLogStorage, Revert)
+{
+    const uint8_t value[] = { 1, 2, 3 };
+    uint8_t buf[8];
+    size_t len;
+
+    ChipLinuxLogStorage storage;
+    ASSERT_EQ(storage.Init(mPath.c_str()), CHIP_NO_ERROR);
+    EXPECT_EQ(storage.WriteValueBin("kept", value, sizeof(value)), CHIP_NO_ERROR);
+    EXPECT_EQ(storage.Commit(), CHIP_NO_ERROR);
+
+    EXPECT_EQ(storage.WriteValueBin("dropped", value, sizeof(value)), CHIP_NO_ERROR);
+    EXPECT_EQ(storage.ClearValue("kept"), CHIP_NO_ERROR);
+    EXPECT_EQ(storage.Revert(), CHIP_NO_ERROR);
+
+    EXPECT_EQ(storage.ReadValueBin("kept", buf, sizeof(buf), len), CHIP_NO_ERROR);
+    EXPECT_EQ(storage.ReadValueBin("dropped", buf, sizeof(buf), len), CHIP_ERROR_KEY_NOT_FOUND);
+}
+
+TEST_F(TestLinuxLogStorage, Compaction)
+{
+    uint8_t value[256] = {};
+    uint8_t buf[sizeof(value)];
+    size_t len;
+
+    ChipLinuxLogStorage storage;
+    ASSERT_EQ(storage.Init(mPath.c_str()), CHIP_NO_ERROR);
+
+    // Overwrite the same key enough times to cross the compaction threshold.
+    for (unsigned i = 0; i < 1024; i++)
+    {
+        value[0] = static_cast<uint8_t>(i);
+        EXPECT_EQ(storage.WriteValueBin("counter", value, sizeof(value)), CHIP_NO_ERROR);
+        EXPECT_EQ(storage.Commit(), CHIP_NO_ERROR);
+    }
+
+    EXPECT_LT(FileSize(), static_cast<off_t>(CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_COMPACTION_THRESHOLD));
+
+    EXPECT_EQ(storage.Compact(), CHIP_NO_ERROR);
+    EXPECT_LT(FileSize(), static_cast<off_t>(2 * sizeof(value)));
+
+    ChipLinuxLogStorage reloaded;
+    ASSERT_EQ(reloaded.Init(mPath.c_str()), CHIP_NO_ERROR);
+    EXPECT_EQ(reloaded.ReadValueBin("counter", buf, sizeof(buf), len), CHIP_NO_ERROR);
+    EXPECT_EQ(len, sizeof(value));
+    EXPECT_EQ(buf[0], static_cast<uint8_t>(1023));
+}
+
+TEST_F(TestLinuxLogStorage, ImportLegacyIni)
+{
+    {
+        std::ofstream ini(mPath);
+        // "AQID" is base64 for { 1, 2, 3 }; "\x3d" is an escaped '='.
+        ini << "[DEFAULT]\n"
+            << "legacy=AQID\n"
+            << "with\\x3dequals=AQID\n";
+    }
+
+    uint8_t buf[8];
+    size_t len;
+
+    {
+        ChipLinuxLogStorage storage;
+        ASSERT_EQ(storage.Init(mPath.c_str()), CHIP_NO_ERROR);
+        EXPECT_EQ(storage.ReadValueBin("legacy", buf, sizeof(buf), len), CHIP_NO_ERROR);
+        EXPECT_EQ(len, 3u);
+        EXPECT_EQ(buf[2], 3);
+        EXPECT_TRUE(storage.HasValue("with=equals"));
+    }
+
+    // The file was converted, so reloading goes through the log path.
+    ChipLinuxLogStorage storage;
+    ASSERT_EQ(storage.Init(mPath.c_str()), CHIP_NO_ERROR);
+    EXPECT_EQ(storage.ReadValueBin("legacy", buf, sizeof(buf), len), CHIP_NO_ERROR);
+    EXPECT_EQ(len, 3u);
+}
+
+TEST_F(TestLinuxLogStorage, DamagedHeaderIsNotImported)
+{
+    const uint8_t value[] = { 1, 2, 3 };
+
+    {
+        ChipLinuxLogStorage storage;
+        ASSERT_EQ(storage.Init(mPath.c_str()), CHIP_NO_ERROR);
+        EXPECT_EQ(storage.WriteValueBin("key", value, sizeof(value)), CHIP_NO_ERROR);
+        EXPECT_EQ(storage.Commit(), CHIP_NO_ERROR);
+    }
+
+    // Corrupt the magic number.
+    {
+        int fd = open(mPath.c_str(), O_RDWR);
+        ASSERT_NE(fd, -1);
+        uint8_t garbage = 0x5A;
+        EXPECT_EQ(pwrite(fd, &garbage, 1, 0), 1);
+        close(fd);
+    }
+    off_t size = FileSize();
+
+    // The log is neither imported as INI nor overwritten.
+    ChipLinuxLogStorage storage;
+    EXPECT_EQ(storage.Init(mPath.c_str()), CHIP_ERROR_INTEGRITY_CHECK_FAILED);
+    EXPECT_EQ(FileSize(), size);
+}
+
+TEST_F(TestLinuxLogStorage, TornHeaderIsRecreated)
+{
+    const uint8_t header[] = { 0x43, 0x4B, 0x56 };
+
+    {
+        int fd = open(mPath.c_str(), O_RDWR | O_CREAT, S_IRUSR | S_IWUSR);
+        ASSERT_NE(fd, -1);
+        EXPECT_EQ(write(fd, header, sizeof(header)), static_cast<ssize_t>(sizeof(header)));
+        close(fd);
+    }
+
+    const uint8_t value[] = { 1 };
+    ChipLinuxLogStorage storage;
+    ASSERT_EQ(storage.Init(mPath.c_str()), CHIP_NO_ERROR);
+    EXPECT_EQ(storage.WriteValueBin("key", value, sizeof(value)), CHIP_NO_ERROR);
+    EXPECT_EQ(storage.Commit(), CHIP_NO_ERROR);
+}
+
+TEST_F(TestLinuxLogStorage, FailedCommitIsRolledBack)
+{
+    const uint8_t value[] = { 1, 2, 3 };
+    uint8_t large[4096]   = {};
+    uint8_t buf[8];
+    size_t len;
+
+    ChipLinuxLogStorage storage;
+    ASSERT_EQ(storage.Init(mPath.c_str()), CHIP_NO_ERROR);
+    EXPECT_EQ(storage.WriteValueBin("kept", value, sizeof(value)), CHIP_NO_ERROR);
+    EXPECT_EQ(storage.Commit(), CHIP_NO_ERROR);
+
+    // Make the next append fail by limiting the size of files.
+    struct rlimit oldLimit;
+    ASSERT_EQ(getrlimit(RLIMIT_FSIZE, &oldLimit), 0);
+    struct rlimit limit     = oldLimit;
+    limit.rlim_cur          = static_cast<rlim_t>(FileSize()) + 16;
+    sighandler_t oldHandler = signal(SIGXFSZ, SIG_IGN);
+    ASSERT_EQ(setrlimit(RLIMIT_FSIZE, &limit), 0);
+
+    EXPECT_EQ(storage.WriteValueBin("large", large, sizeof(large)), CHIP_NO_ERROR);
+    EXPECT_EQ(storage.ClearValue("kept"), CHIP_NO_ERROR);
+    EXPECT_NE(storage.Commit(), CHIP_NO_ERROR);
+
+    EXPECT_EQ(setrlimit(RLIMIT_FSIZE, &oldLimit), 0);
+    signal(SIGXFSZ, oldHandler);
+
+    // The in-memory entries match the log again.
+    EXPECT_FALSE(storage.HasValue("large"));
+    EXPECT_EQ(storage.ReadValueBin("kept", buf, sizeof(buf), len), CHIP_NO_ERROR);
+    EXPECT_EQ(len, sizeof(value));
+}
+
+TEST_F(TestLinuxLogStorage, NullKey)
+{
+    uint8_t buf[4];
+    size_t len;
+
+    ChipLinuxLogStorage storage;
+    ASSERT_EQ(storage.Init(mPath.c_str()), CHIP_NO_ERROR);
+    EXPECT_EQ(storage.WriteValueBin(nullptr, buf, sizeof(buf)), CHIP_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(storage.ReadValueBin(nullptr, buf, sizeof(buf), len), CHIP_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(storage.ClearValue(nullptr), CHIP_ERROR_INVALID_ARGUMENT);
+    EXPECT_FALSE(storage.HasValue(nullptr));
+}
+
+TEST_F(TestLinuxLogStorage, ClearAll)
+{
+    const uint8_t value[] = { 1 };
+    uint8_t buf[4];
+    size_t len;
+
+    {
+        ChipLinuxLogStorage storage;
+        ASSERT_EQ(storage.Init(mPath.c_str()), CHIP_NO_ERROR);
+        EXPECT_EQ(storage.WriteValueBin("a", value, sizeof(value)), CHIP_NO_ERROR);
+        EXPECT_EQ(storage.Commit(), CHIP_NO_ERROR);
+        EXPECT_EQ(storage.ClearAll(), CHIP_NO_ERROR);
+    }
+
+    ChipLinuxLogStorage storage;
+    ASSERT_EQ(storage.Init(mPath.c_str()), CHIP_NO_ERROR);
+    EXPECT_EQ(storage.ReadValueBin("a", buf, sizeof(buf), len), CHIP_ERROR_KEY_NOT_FOUND);
+}
+
+TEST_F(TestLinuxLogStorage, GetKeys)
+{
+    const uint8_t value[] = { 1 };
+    std::vector<std::string> keys;
+
+    ChipLinuxLogStorage storage;
+    ASSERT_EQ(storage.Init(mPath.c_str()), CHIP_NO_ERROR);
+    EXPECT_EQ(storage.GetKeys(keys), CHIP_NO_ERROR);
+    EXPECT_TRUE(keys.empty());
+
+    EXPECT_EQ(storage.WriteValueBin("f/1/n", value, sizeof(value)), CHIP_NO_ERROR);
+    EXPECT_EQ(storage.WriteValueBin("g/gfl", value, sizeof(value)), CHIP_NO_ERROR);
+    EXPECT_EQ(storage.WriteValueBin("a", value, sizeof(value)), CHIP_NO_ERROR);
+    EXPECT_EQ(storage.ClearValue("a"), CHIP_NO_ERROR);
+
+    EXPECT_EQ(storage.GetKeys(keys), CHIP_NO_ERROR);
+    EXPECT_EQ(keys, (std::vector<std::string>{ "f/1/n", "g/gfl" }));
+}
+
+} // namespace
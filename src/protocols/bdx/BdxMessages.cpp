@@ -23,6 +23,8 @@
 
 #include <protocols/bdx/BdxMessages.h>
 
+#include <lib/core/TLVReader.h>
+#include <lib/core/TLVWriter.h>
 #include <lib/support/BufferReader.h>
 #include <lib/support/BufferWriter.h>
 #include <lib/support/CodeUtils.h>
@@ -30,14 +32,68 @@
 #include <limits>
 #include <utility>
 
-namespace {
-constexpr uint8_t kVersionMask = 0x0F;
-} // namespace
-
 using namespace chip;
 using namespace chip::bdx;
 using namespace chip::Encoding::LittleEndian;
 
+namespace {
+constexpr uint8_t kVersionMask = 0x0F;
+
+// Control byte, fully-qualified 6-byte tag, no value
+constexpr size_t kWindowedTransferElementSize = 7;
+
+void EncodeWindowedTransferElement(uint8_t (&element)[kWindowedTransferElementSize])
+{
+    TLV::TLVWriter writer;
+    writer.Init(element);
+    VerifyOrDie(writer.PutBoolean(kWindowedTransferMetadataTag, true) == CHIP_NO_ERROR);
+    VerifyOrDie(writer.Finalize() == CHIP_NO_ERROR && writer.GetLengthWritten() == kWindowedTransferElementSize);
+}
+
+void PutMetadata(BufferWriter & aBuffer, const uint8_t * metadata, size_t metadataLength, bool windowed)
+{
+    if (metadata != nullptr)
+    {
+        aBuffer.Put(metadata, metadataLength);
+    }
+    if (windowed)
+    {
+        uint8_t element[kWindowedTransferElementSize];
+        EncodeWindowedTransferElement(element);
+        aBuffer.Put(element, sizeof(element));
+    }
+}
+
+/**
+ * Removes the windowed transfer element from the end of received Metadata. The element is only recognized if the Metadata
+ * before it is well-formed TLV, so that it cannot be the tail of another element.
+ */
+bool TakeWindowedTransferElement(const uint8_t *& metadata, size_t & metadataLength)
+{
+    VerifyOrReturnValue(metadata != nullptr && metadataLength >= kWindowedTransferElementSize, false);
+
+    uint8_t element[kWindowedTransferElementSize];
+    EncodeWindowedTransferElement(element);
+    const size_t otherLength = metadataLength - kWindowedTransferElementSize;
+    VerifyOrReturnValue(memcmp(&metadata[otherLength], element, sizeof(element)) == 0, false);
+
+    TLV::TLVReader reader;
+    reader.Init(metadata, otherLength);
+    CHIP_ERROR err;
+    while ((err = reader.Next()) == CHIP_NO_ERROR)
+    {
+    }
+    VerifyOrReturnValue(err == CHIP_END_OF_TLV, false);
+
+    metadataLength = otherLength;
+    if (metadataLength == 0)
+    {
+        metadata = nullptr;
+    }
+    return true;
+}
+} // namespace
+
 // WARNING: this function should never return early, since MessageSize() relies on it to calculate
 // the size of the message (even if the message is incomplete or filled out incorrectly).
 BufferWriter & TransferInit::WriteToBuffer(BufferWriter & aBuffer) const
@@ -85,10 +141,7 @@ BufferWriter & TransferInit::WriteToBuffer(BufferWriter & aBuffer) const
         aBuffer.Put(FileDesignator, static_cast<size_t>(FileDesLength));
     }
 
-    if (Metadata != nullptr)
-    {
-        aBuffer.Put(Metadata, static_cast<size_t>(MetadataLength));
-    }
+    PutMetadata(aBuffer, Metadata, MetadataLength, Windowed);
     return aBuffer;
 }
 
@@ -147,6 +200,7 @@ CHIP_ERROR TransferInit::Parse(System::PacketBufferHandle aBuffer)
         Metadata                    = &bufStart[metadataStartIndex];
         MetadataLength              = static_cast<uint16_t>(aBuffer->DataLength() - metadataStartIndex);
     }
+    Windowed = TakeWindowedTransferElement(Metadata, MetadataLength);
 
     // Retain ownership of the packet buffer so that the FileDesignator and Metadata pointers remain valid.
     Buffer = std::move(aBuffer);
@@ -209,7 +263,7 @@ bool TransferInit::operator==(const TransferInit & another) const
 
     return ((Version == another.Version) && (TransferCtlOptions == another.TransferCtlOptions) &&
             (StartOffset == another.StartOffset) && (MaxLength == another.MaxLength) && (MaxBlockSize == another.MaxBlockSize) &&
-            fileDesMatches && metadataMatches);
+            (Windowed == another.Windowed) && fileDesMatches && metadataMatches);
 }
 
 // WARNING: this function should never return early, since MessageSize() relies on it to calculate
@@ -221,10 +275,7 @@ Encoding::LittleEndian::BufferWriter & SendAccept::WriteToBuffer(Encoding::Littl
     aBuffer.Put(transferCtl.Raw());
     aBuffer.Put16(MaxBlockSize);
 
-    if (Metadata != nullptr)
-    {
-        aBuffer.Put(Metadata, static_cast<size_t>(MetadataLength));
-    }
+    PutMetadata(aBuffer, Metadata, MetadataLength, Windowed);
     return aBuffer;
 }
 
@@ -249,6 +300,7 @@ CHIP_ERROR SendAccept::Parse(System::PacketBufferHandle aBuffer)
         Metadata       = &bufStart[bufReader.OctetsRead()];
         MetadataLength = bufReader.Remaining();
     }
+    Windowed = TakeWindowedTransferElement(Metadata, MetadataLength);
 
     // Retain ownership of the packet buffer so that the Metadata pointer remains valid.
     Buffer = std::move(aBuffer);
@@ -286,7 +338,7 @@ bool SendAccept::operator==(const SendAccept & another) const
     }
 
     return ((Version == another.Version) && (TransferCtlFlags == another.TransferCtlFlags) &&
-            (MaxBlockSize == another.MaxBlockSize) && metadataMatches);
+            (MaxBlockSize == another.MaxBlockSize) && (Windowed == another.Windowed) && metadataMatches);
 }
 
 // WARNING: this function should never return early, since MessageSize() relies on it to calculate
@@ -329,10 +381,7 @@ Encoding::LittleEndian::BufferWriter & ReceiveAccept::WriteToBuffer(Encoding::Li
         }
     }
 
-    if (Metadata != nullptr)
-    {
-        aBuffer.Put(Metadata, static_cast<size_t>(MetadataLength));
-    }
+    PutMetadata(aBuffer, Metadata, MetadataLength, Windowed);
     return aBuffer;
 }
 
@@ -386,6 +435,7 @@ CHIP_ERROR ReceiveAccept::Parse(System::PacketBufferHandle aBuffer)
         Metadata       = &bufStart[bufReader.OctetsRead()];
         MetadataLength = bufReader.Remaining();
     }
+    Windowed = TakeWindowedTransferElement(Metadata, MetadataLength);
 
     // Retain ownership of the packet buffer so that the Metadata pointer remains valid.
     Buffer = std::move(aBuffer);
@@ -426,7 +476,7 @@ bool ReceiveAccept::operator==(const ReceiveAccept & another) const
 
     return ((Version == another.Version) && (TransferCtlFlags == another.TransferCtlFlags) &&
             (StartOffset == another.StartOffset) && (MaxBlockSize == another.MaxBlockSize) && (Length == another.Length) &&
-            metadataMatches);
+            (Windowed == another.Windowed) && metadataMatches);
 }
 
 // WARNING: this function should never return early, since MessageSize() relies on it to calculate
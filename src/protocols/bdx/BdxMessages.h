@@ -24,6 +24,7 @@
 
 #pragma once
 
+#include <lib/core/TLVTags.h>
 #include <lib/support/BitFlags.h>
 #include <lib/support/BufferWriter.h>
 #include <lib/support/CodeUtils.h>
@@ -60,6 +61,13 @@ enum class TransferControlFlags : uint8_t
     kAsync         = (1U << 6),
 };
 
+/**
+ * Metadata element that proposes (in an Init message) or agrees to (in an Accept message) a windowed transfer, see
+ * TransferSession. It is not part of the BDX specification: it is a boolean with a fully-qualified tag of the BDX protocol,
+ * appended after any other Metadata, so peers that do not support windowed transfers ignore it.
+ */
+inline constexpr TLV::Tag kWindowedTransferMetadataTag = TLV::ProfileTag(Protocols::BDX::Id.ToTLVProfileId(), 0x8001);
+
 enum class RangeControlFlags : uint8_t
 {
     kDefLen      = (1U),
@@ -146,6 +154,9 @@ struct TransferInit : public BdxMessage
     const uint8_t * Metadata       = nullptr;
     size_t MetadataLength          = 0;
 
+    // Proposes a windowed transfer, encoded as a kWindowedTransferMetadataTag element after the Metadata
+    bool Windowed = false;
+
     // Retain ownership of the packet buffer so that the FileDesignator and Metadata pointers remain valid.
     System::PacketBufferHandle Buffer;
 
@@ -179,6 +190,9 @@ struct SendAccept : public BdxMessage
     const uint8_t * Metadata = nullptr;
     size_t MetadataLength    = 0;
 
+    // Agrees to a windowed transfer, encoded as a kWindowedTransferMetadataTag element after the Metadata
+    bool Windowed = false;
+
     // Retain ownership of the packet buffer so that the FileDesignator and Metadata pointers remain valid.
     System::PacketBufferHandle Buffer;
 
@@ -215,6 +229,9 @@ struct ReceiveAccept : public BdxMessage
     const uint8_t * Metadata = nullptr;
     size_t MetadataLength    = 0;
 
+    // Agrees to a windowed transfer, encoded as a kWindowedTransferMetadataTag element after the Metadata
+    bool Windowed = false;
+
     // Retain ownership of the packet buffer so that the FileDesignator and Metadata pointers remain valid.
     System::PacketBufferHandle Buffer;
 
@@ -102,9 +102,10 @@ CHIP_ERROR BdxTransferDiagnosticLog::OnMessageReceived(Messaging::ExchangeContex
 
         mTransferProxy.SetFabricIndex(fabricIndex);
         mTransferProxy.SetPeerNodeId(peerNodeId);
-        auto flags(TransferControlFlags::kSenderDrive);
+        BitFlags<TransferControlFlags> flags(TransferControlFlags::kSenderDrive);
         ReturnLogErrorOnFailure(
             Responder::PrepareForTransfer(mSystemLayer, kBdxRole, flags, kMaxBdxBlockSize, kBdxTimeout, kBdxPollInterval));
+        mTransfer.SetWindowedTransferSupported(mWindowedTransferSupported);
     }
 
     return TransferFacilitator::OnMessageReceived(ec, payloadHeader, std::move(payload));
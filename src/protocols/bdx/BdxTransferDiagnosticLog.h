@@ -55,6 +55,11 @@ public:
     bool IsForFabric(FabricIndex fabricIndex) const;
     void AbortTransfer();
 
+    /**
+     * Sets whether the log may be uploaded with a windowed transfer, if the sender proposes one over a transport that allows it.
+     */
+    void SetWindowedTransferSupported(bool supported) { mWindowedTransferSupported = supported; }
+
 protected:
     /**
      * Called when a BDX message is received over the exchange context
@@ -109,7 +114,8 @@ private:
     void AbortTransferOnFailure(CHIP_ERROR error);
 
     BDXTransferProxyDiagnosticLog mTransferProxy;
-    bool mIsExchangeClosing = false;
+    bool mIsExchangeClosing         = false;
+    bool mWindowedTransferSupported = true;
 
     System::Layer * mSystemLayer;
 
@@ -37,6 +37,7 @@ CHIP_ERROR BDXTransferServer::OnUnsolicitedMessageReceived(const PayloadHeader &
     auto * logTransfer = mPoolDelegate.Allocate(mDelegate, mSystemLayer);
     VerifyOrReturnError(nullptr != logTransfer, CHIP_ERROR_NO_MEMORY);
 
+    logTransfer->SetWindowedTransferSupported(mWindowedTransferSupported);
     newDelegate = logTransfer;
     return CHIP_NO_ERROR;
 }
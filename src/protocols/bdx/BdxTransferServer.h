@@ -45,6 +45,12 @@ public:
 
     void AbortTransfersForFabric(FabricIndex fabricIndex) { mPoolDelegate.AbortTransfersForFabric(fabricIndex); }
 
+    /**
+     * Sets whether log uploads may use windowed transfers (see TransferSession). They are only negotiated when the sender proposes
+     * one over a transport that allows several messages in flight, e.g. TCP.
+     */
+    void SetWindowedTransferSupported(bool supported) { mWindowedTransferSupported = supported; }
+
 protected:
     CHIP_ERROR OnUnsolicitedMessageReceived(const PayloadHeader & payloadHeader,
                                             Messaging::ExchangeDelegate *& newDelegate) override;
@@ -55,6 +61,7 @@ private:
     Messaging::ExchangeManager * mExchangeMgr;
 
     BDXTransferServerDelegate * mDelegate;
+    bool mWindowedTransferSupported = true;
     BdxTransferDiagnosticLogPool<CHIP_CONFIG_MAX_BDX_LOG_TRANSFERS> mPoolDelegate;
 };
 
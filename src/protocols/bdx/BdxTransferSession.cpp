@@ -6,6 +6,7 @@
 
 #include <protocols/bdx/BdxTransferSession.h>
 
+#include <lib/core/CHIPEncoding.h>
 #include <lib/support/BufferReader.h>
 #include <lib/support/CodeUtils.h>
 #include <lib/support/TypeTraits.h>
@@ -22,6 +23,9 @@
 namespace {
 constexpr uint8_t kBdxVersion = 0; ///< The version of this implementation of the BDX spec
 
+// Size of the counter that precedes the data in Block and BlockEOF messages.
+constexpr uint16_t kBlockCounterSize = sizeof(uint32_t);
+
 /**
  * @brief
  *   Allocate a new PacketBuffer and write data from a BDX message struct.
@@ -151,6 +155,7 @@ CHIP_ERROR TransferSession::StartTransfer(TransferRole role, const TransferInitD
     mMaxSupportedBlockSize = initData.MaxBlockSize;
     mStartOffset           = initData.StartOffset;
     mTransferLength        = initData.Length;
+    mWindowedSupported     = initData.Windowed;
 
     // Prepare TransferInit message
     TransferInit initMsg;
@@ -163,6 +168,7 @@ CHIP_ERROR TransferSession::StartTransfer(TransferRole role, const TransferInitD
     initMsg.FileDesLength      = initData.FileDesLength;
     initMsg.Metadata           = initData.Metadata;
     initMsg.MetadataLength     = initData.MetadataLength;
+    initMsg.Windowed           = initData.Windowed;
 
     ReturnErrorOnFailure(WriteToPacketBuffer(initMsg, mPendingMsgHandle));
 
@@ -202,6 +208,7 @@ CHIP_ERROR TransferSession::AcceptTransfer(const TransferAcceptData & acceptData
     MessageType msgType;
 
     const BitFlags<TransferControlFlags> proposedControlOpts(mTransferRequestData.TransferCtlFlags);
+    const bool windowedProposed = mTransferRequestData.Windowed;
 
     VerifyOrReturnError(mState == TransferState::kNegotiateTransferParams, CHIP_ERROR_INCORRECT_STATE);
     VerifyOrReturnError(mPendingOutput == OutputEventType::kNone, CHIP_ERROR_INCORRECT_STATE);
@@ -212,6 +219,9 @@ CHIP_ERROR TransferSession::AcceptTransfer(const TransferAcceptData & acceptData
     VerifyOrReturnError(acceptData.MaxBlockSize <= mTransferRequestData.MaxBlockSize, CHIP_ERROR_INVALID_ARGUMENT);
 
     mTransferMaxBlockSize = acceptData.MaxBlockSize;
+    mControlMode          = acceptData.ControlMode;
+    mWindowed             = acceptData.Windowed && windowedProposed && mWindowedSupported &&
+        mControlMode != TransferControlFlags::kAsync;
 
     if (mRole == TransferRole::kSender)
     {
@@ -226,6 +236,7 @@ CHIP_ERROR TransferSession::AcceptTransfer(const TransferAcceptData & acceptData
         acceptMsg.Length         = acceptData.Length;
         acceptMsg.Metadata       = acceptData.Metadata;
         acceptMsg.MetadataLength = acceptData.MetadataLength;
+        acceptMsg.Windowed       = mWindowed;
 
         ReturnErrorOnFailure(WriteToPacketBuffer(acceptMsg, mPendingMsgHandle));
         msgType = MessageType::ReceiveAccept;
@@ -243,6 +254,7 @@ CHIP_ERROR TransferSession::AcceptTransfer(const TransferAcceptData & acceptData
         acceptMsg.MaxBlockSize   = acceptData.MaxBlockSize;
         acceptMsg.Metadata       = acceptData.Metadata;
         acceptMsg.MetadataLength = acceptData.MetadataLength;
+        acceptMsg.Windowed       = mWindowed;
 
         ReturnErrorOnFailure(WriteToPacketBuffer(acceptMsg, mPendingMsgHandle));
         msgType = MessageType::SendAccept;
@@ -284,7 +296,7 @@ CHIP_ERROR TransferSession::PrepareBlockQuery()
     VerifyOrReturnError(mState == TransferState::kTransferInProgress, CHIP_ERROR_INCORRECT_STATE);
     VerifyOrReturnError(mRole == TransferRole::kReceiver, CHIP_ERROR_INCORRECT_STATE);
     VerifyOrReturnError(mPendingOutput == OutputEventType::kNone, CHIP_ERROR_INCORRECT_STATE);
-    VerifyOrReturnError(!mAwaitingResponse, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(mWindowed ? (mInFlight < mWindowSize) : !mAwaitingResponse, CHIP_ERROR_INCORRECT_STATE);
 
     BlockQuery queryMsg;
     queryMsg.BlockCounter = mNextQueryNum;
@@ -298,6 +310,10 @@ CHIP_ERROR TransferSession::PrepareBlockQuery()
 
     mAwaitingResponse = true;
     mLastQueryNum     = mNextQueryNum++;
+    if (mWindowed)
+    {
+        mInFlight++;
+    }
 
     PrepareOutgoingMessageEvent(msgType, mPendingOutput, mMsgTypeData);
 
@@ -326,6 +342,11 @@ CHIP_ERROR TransferSession::PrepareBlockQueryWithSkip(const uint64_t & bytesToSk
 
     mAwaitingResponse = true;
     mLastQueryNum     = mNextQueryNum++;
+    if (mWindowed)
+    {
+        // No other query is in flight, since the skip must apply to the next Block.
+        mInFlight = 1;
+    }
 
     PrepareOutgoingMessageEvent(msgType, mPendingOutput, mMsgTypeData);
 
@@ -334,10 +355,7 @@ CHIP_ERROR TransferSession::PrepareBlockQueryWithSkip(const uint64_t & bytesToSk
 
 CHIP_ERROR TransferSession::PrepareBlock(const BlockData & inData)
 {
-    VerifyOrReturnError(mState == TransferState::kTransferInProgress, CHIP_ERROR_INCORRECT_STATE);
-    VerifyOrReturnError(mRole == TransferRole::kSender, CHIP_ERROR_INCORRECT_STATE);
-    VerifyOrReturnError(mPendingOutput == OutputEventType::kNone, CHIP_ERROR_INCORRECT_STATE);
-    VerifyOrReturnError(!mAwaitingResponse, CHIP_ERROR_INCORRECT_STATE);
+    ReturnErrorOnFailure(VerifyCanPrepareBlock());
 
     // Verify non-zero data is provided and is no longer than MaxBlockSize (BlockEOF may contain 0 length data)
     VerifyOrReturnError((inData.Data != nullptr) && (inData.Length <= mTransferMaxBlockSize), CHIP_ERROR_INVALID_ARGUMENT);
@@ -356,6 +374,70 @@ CHIP_ERROR TransferSession::PrepareBlock(const BlockData & inData)
     blockMsg.LogMessage(msgType);
 #endif // CHIP_AUTOMATION_LOGGING
 
+    OnBlockPrepared(msgType);
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR TransferSession::PrepareBlock(System::PacketBufferHandle && blockBuf, bool isEof)
+{
+    ReturnErrorOnFailure(VerifyCanPrepareBlock());
+
+    VerifyOrReturnError(!blockBuf.IsNull() && !blockBuf->HasChainedBuffer(), CHIP_ERROR_INVALID_ARGUMENT);
+    // Only a BlockEOF may be empty.
+    VerifyOrReturnError((blockBuf->DataLength() > 0 || isEof) && blockBuf->DataLength() <= mTransferMaxBlockSize,
+                        CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(blockBuf->ReservedSize() >= kBlockCounterSize, CHIP_ERROR_BUFFER_TOO_SMALL);
+
+    blockBuf->SetStart(blockBuf->Start() - kBlockCounterSize);
+    Encoding::LittleEndian::Put32(blockBuf->Start(), mNextBlockNum);
+    mPendingMsgHandle = std::move(blockBuf);
+
+    const MessageType msgType = isEof ? MessageType::BlockEOF : MessageType::Block;
+
+#if CHIP_AUTOMATION_LOGGING
+    DataBlock blockMsg;
+    blockMsg.BlockCounter = mNextBlockNum;
+    blockMsg.Data         = mPendingMsgHandle->Start() + kBlockCounterSize;
+    blockMsg.DataLength   = mPendingMsgHandle->DataLength() - kBlockCounterSize;
+    ChipLogAutomation("Sending BDX Message");
+    blockMsg.LogMessage(msgType);
+#endif // CHIP_AUTOMATION_LOGGING
+
+    OnBlockPrepared(msgType);
+
+    return CHIP_NO_ERROR;
+}
+
+System::PacketBufferHandle TransferSession::NewBlockBuffer(size_t dataLength)
+{
+    VerifyOrReturnValue(dataLength <= System::PacketBuffer::kMaxSize - MessagePacketBuffer::kMaxFooterSize, nullptr);
+    return System::PacketBufferHandle::New(dataLength + MessagePacketBuffer::kMaxFooterSize,
+                                           System::PacketBuffer::kDefaultHeaderReserve + kBlockCounterSize);
+}
+
+CHIP_ERROR TransferSession::VerifyCanPrepareBlock() const
+{
+    VerifyOrReturnError(mState == TransferState::kTransferInProgress, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(mRole == TransferRole::kSender, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(mPendingOutput == OutputEventType::kNone, CHIP_ERROR_INCORRECT_STATE);
+    if (!mWindowed)
+    {
+        VerifyOrReturnError(!mAwaitingResponse, CHIP_ERROR_INCORRECT_STATE);
+    }
+    else if (mControlMode == TransferControlFlags::kSenderDrive)
+    {
+        VerifyOrReturnError(mInFlight < mWindowSize, CHIP_ERROR_INCORRECT_STATE);
+    }
+    else
+    {
+        VerifyOrReturnError(mQueriesPending > 0, CHIP_ERROR_INCORRECT_STATE);
+    }
+    return CHIP_NO_ERROR;
+}
+
+void TransferSession::OnBlockPrepared(MessageType msgType)
+{
     if (msgType == MessageType::BlockEOF)
     {
         mState = TransferState::kAwaitingEOFAck;
@@ -363,10 +445,18 @@ CHIP_ERROR TransferSession::PrepareBlock(const BlockData & inData)
 
     mAwaitingResponse = true;
     mLastBlockNum     = mNextBlockNum++;
+    if (mWindowed && mControlMode == TransferControlFlags::kSenderDrive)
+    {
+        mInFlight++;
+    }
+    else if (mWindowed)
+    {
+        // The sender only waits for the receiver once it has answered all of its queries.
+        mQueriesPending   = (msgType == MessageType::BlockEOF) ? 0 : static_cast<uint8_t>(mQueriesPending - 1);
+        mAwaitingResponse = (mQueriesPending == 0);
+    }
 
     PrepareOutgoingMessageEvent(msgType, mPendingOutput, mMsgTypeData);
-
-    return CHIP_NO_ERROR;
 }
 
 CHIP_ERROR TransferSession::PrepareBlockAck()
@@ -389,7 +479,7 @@ CHIP_ERROR TransferSession::PrepareBlockAck()
 
     if (mState == TransferState::kTransferInProgress)
     {
-        if (mControlMode == TransferControlFlags::kSenderDrive)
+        if (mControlMode == TransferControlFlags::kSenderDrive && !mWindowed)
         {
             // In Sender Drive, a BlockAck is implied to also be a query for the next Block, so expect to receive a Block
             // message.
@@ -438,6 +528,12 @@ void TransferSession::Reset()
     mLastQueryNum      = 0;
     mNextQueryNum      = 0;
 
+    mWindowedSupported = false;
+    mWindowed          = false;
+    mWindowSize     = CHIP_CONFIG_BDX_WINDOW_SIZE;
+    mInFlight       = 0;
+    mQueriesPending = 0;
+
     mTimeout                = System::Clock::kZero;
     mTimeoutStartTime       = System::Clock::kZero;
     mShouldInitTimeoutStart = true;
@@ -575,6 +671,7 @@ void TransferSession::HandleTransferInit(MessageType msgType, System::PacketBuff
     mTransferRequestData.FileDesLength    = transferInit.FileDesLength;
     mTransferRequestData.Metadata         = transferInit.Metadata;
     mTransferRequestData.MetadataLength   = transferInit.MetadataLength;
+    mTransferRequestData.Windowed         = transferInit.Windowed;
 
     mPendingMsgHandle = std::move(msgData);
     mPendingOutput    = OutputEventType::kInitReceived;
@@ -596,7 +693,7 @@ void TransferSession::HandleReceiveAccept(System::PacketBufferHandle msgData)
     VerifyOrReturn(err == CHIP_NO_ERROR, PrepareStatusReport(StatusCode::kBadMessageContents));
 
     // Verify that Accept parameters are compatible with the original proposed parameters
-    ReturnOnFailure(VerifyProposedMode(rcvAcceptMsg.TransferCtlFlags));
+    ReturnOnFailure(VerifyProposedMode(rcvAcceptMsg.TransferCtlFlags, rcvAcceptMsg.Windowed));
 
     mTransferMaxBlockSize = rcvAcceptMsg.MaxBlockSize;
     mStartOffset          = rcvAcceptMsg.StartOffset;
@@ -610,6 +707,7 @@ void TransferSession::HandleReceiveAccept(System::PacketBufferHandle msgData)
     mTransferAcceptData.Length         = rcvAcceptMsg.Length;
     mTransferAcceptData.Metadata       = rcvAcceptMsg.Metadata;
     mTransferAcceptData.MetadataLength = rcvAcceptMsg.MetadataLength;
+    mTransferAcceptData.Windowed       = mWindowed;
 
     mPendingMsgHandle = std::move(msgData);
     mPendingOutput    = OutputEventType::kAcceptReceived;
@@ -632,7 +730,7 @@ void TransferSession::HandleSendAccept(System::PacketBufferHandle msgData)
     VerifyOrReturn(err == CHIP_NO_ERROR, PrepareStatusReport(StatusCode::kBadMessageContents));
 
     // Verify that Accept parameters are compatible with the original proposed parameters
-    ReturnOnFailure(VerifyProposedMode(sendAcceptMsg.TransferCtlFlags));
+    ReturnOnFailure(VerifyProposedMode(sendAcceptMsg.TransferCtlFlags, sendAcceptMsg.Windowed));
 
     // Note: if VerifyProposedMode() returned with no error, then mControlMode must match the proposed mode in the SendAccept
     // message
@@ -644,6 +742,7 @@ void TransferSession::HandleSendAccept(System::PacketBufferHandle msgData)
     mTransferAcceptData.Length         = mTransferLength; // Not included in SendAccept msg, so use member
     mTransferAcceptData.Metadata       = sendAcceptMsg.Metadata;
     mTransferAcceptData.MetadataLength = sendAcceptMsg.MetadataLength;
+    mTransferAcceptData.Windowed       = mWindowed;
 
     mPendingMsgHandle = std::move(msgData);
     mPendingOutput    = OutputEventType::kAcceptReceived;
@@ -659,19 +758,28 @@ void TransferSession::HandleSendAccept(System::PacketBufferHandle msgData)
 void TransferSession::HandleBlockQuery(System::PacketBufferHandle msgData)
 {
     VerifyOrReturn(mRole == TransferRole::kSender, PrepareStatusReport(StatusCode::kUnexpectedMessage));
+
+    // In a windowed transfer, the receiver may have sent queries past the end of the data before getting the BlockEOF.
+    VerifyOrReturn(!(mWindowed && mState == TransferState::kAwaitingEOFAck));
+
     VerifyOrReturn(mState == TransferState::kTransferInProgress, PrepareStatusReport(StatusCode::kUnexpectedMessage));
-    VerifyOrReturn(mAwaitingResponse, PrepareStatusReport(StatusCode::kUnexpectedMessage));
+    VerifyOrReturn(mAwaitingResponse || mWindowed, PrepareStatusReport(StatusCode::kUnexpectedMessage));
 
     BlockQuery query;
     const CHIP_ERROR err = query.Parse(std::move(msgData));
     VerifyOrReturn(err == CHIP_NO_ERROR, PrepareStatusReport(StatusCode::kBadMessageContents));
 
-    VerifyOrReturn(query.BlockCounter == mNextBlockNum, PrepareStatusReport(StatusCode::kBadBlockCounter));
+    VerifyOrReturn(query.BlockCounter == mNextBlockNum + mQueriesPending, PrepareStatusReport(StatusCode::kBadBlockCounter));
+    VerifyOrReturn(mQueriesPending < UINT8_MAX, PrepareStatusReport(StatusCode::kResponderBusy));
 
     mPendingOutput = OutputEventType::kQueryReceived;
 
     mAwaitingResponse = false;
     mLastQueryNum     = query.BlockCounter;
+    if (mWindowed)
+    {
+        mQueriesPending++;
+    }
 
 #if CHIP_AUTOMATION_LOGGING
     query.LogMessage(MessageType::BlockQuery);
@@ -688,6 +796,8 @@ void TransferSession::HandleBlockQueryWithSkip(System::PacketBufferHandle msgDat
     const CHIP_ERROR err = query.Parse(std::move(msgData));
     VerifyOrReturn(err == CHIP_NO_ERROR, PrepareStatusReport(StatusCode::kBadMessageContents));
 
+    // The skip applies to the next Block, so no other query may be pending.
+    VerifyOrReturn(mQueriesPending == 0, PrepareStatusReport(StatusCode::kUnexpectedMessage));
     VerifyOrReturn(query.BlockCounter == mNextBlockNum, PrepareStatusReport(StatusCode::kBadBlockCounter));
 
     mPendingOutput = OutputEventType::kQueryWithSkipReceived;
@@ -695,6 +805,10 @@ void TransferSession::HandleBlockQueryWithSkip(System::PacketBufferHandle msgDat
     mAwaitingResponse        = false;
     mLastQueryNum            = query.BlockCounter;
     mBytesToSkip.BytesToSkip = query.BytesToSkip;
+    if (mWindowed)
+    {
+        mQueriesPending = 1;
+    }
 
 #if CHIP_AUTOMATION_LOGGING
     query.LogMessage(MessageType::BlockQueryWithSkip);
@@ -711,7 +825,7 @@ void TransferSession::HandleBlock(System::PacketBufferHandle msgData)
     const CHIP_ERROR err = blockMsg.Parse(msgData.Retain());
     VerifyOrReturn(err == CHIP_NO_ERROR, PrepareStatusReport(StatusCode::kBadMessageContents));
 
-    VerifyOrReturn(blockMsg.BlockCounter == mLastQueryNum, PrepareStatusReport(StatusCode::kBadBlockCounter));
+    VerifyOrReturn(blockMsg.BlockCounter == GetExpectedBlockNum(), PrepareStatusReport(StatusCode::kBadBlockCounter));
     VerifyOrReturn((blockMsg.DataLength > 0) && (blockMsg.DataLength <= mTransferMaxBlockSize),
                    PrepareStatusReport(StatusCode::kBadMessageContents));
 
@@ -733,6 +847,17 @@ void TransferSession::HandleBlock(System::PacketBufferHandle msgData)
     mLastBlockNum = blockMsg.BlockCounter;
 
     mAwaitingResponse = false;
+    if (mWindowed && mControlMode == TransferControlFlags::kSenderDrive)
+    {
+        // The sender does not wait for the BlockAck before sending the next Block.
+        mLastQueryNum     = blockMsg.BlockCounter + 1;
+        mAwaitingResponse = true;
+    }
+    else if (mWindowed)
+    {
+        mInFlight--;
+        mAwaitingResponse = (mInFlight > 0);
+    }
 
 #if CHIP_AUTOMATION_LOGGING
     blockMsg.LogMessage(MessageType::Block);
@@ -749,7 +874,7 @@ void TransferSession::HandleBlockEOF(System::PacketBufferHandle msgData)
     const CHIP_ERROR err = blockEOFMsg.Parse(msgData.Retain());
     VerifyOrReturn(err == CHIP_NO_ERROR, PrepareStatusReport(StatusCode::kBadMessageContents));
 
-    VerifyOrReturn(blockEOFMsg.BlockCounter == mLastQueryNum, PrepareStatusReport(StatusCode::kBadBlockCounter));
+    VerifyOrReturn(blockEOFMsg.BlockCounter == GetExpectedBlockNum(), PrepareStatusReport(StatusCode::kBadBlockCounter));
     VerifyOrReturn(blockEOFMsg.DataLength <= mTransferMaxBlockSize, PrepareStatusReport(StatusCode::kBadMessageContents));
 
     mBlockEventData.Data         = blockEOFMsg.Data;
@@ -764,6 +889,7 @@ void TransferSession::HandleBlockEOF(System::PacketBufferHandle msgData)
     mLastBlockNum = blockEOFMsg.BlockCounter;
 
     mAwaitingResponse = false;
+    mInFlight         = 0;
     mState            = TransferState::kReceivedEOF;
 
 #if CHIP_AUTOMATION_LOGGING
@@ -774,6 +900,12 @@ void TransferSession::HandleBlockEOF(System::PacketBufferHandle msgData)
 void TransferSession::HandleBlockAck(System::PacketBufferHandle msgData)
 {
     VerifyOrReturn(mRole == TransferRole::kSender, PrepareStatusReport(StatusCode::kUnexpectedMessage));
+    if (mWindowed)
+    {
+        HandleWindowedBlockAck(std::move(msgData));
+        return;
+    }
+
     VerifyOrReturn(mState == TransferState::kTransferInProgress, PrepareStatusReport(StatusCode::kUnexpectedMessage));
     VerifyOrReturn(mAwaitingResponse, PrepareStatusReport(StatusCode::kUnexpectedMessage));
 
@@ -807,6 +939,7 @@ void TransferSession::HandleBlockAckEOF(System::PacketBufferHandle msgData)
     mPendingOutput = OutputEventType::kAckEOFReceived;
 
     mAwaitingResponse = false;
+    mInFlight         = 0;
 
     mState = TransferState::kTransferDone;
 
@@ -815,6 +948,32 @@ void TransferSession::HandleBlockAckEOF(System::PacketBufferHandle msgData)
 #endif // CHIP_AUTOMATION_LOGGING
 }
 
+void TransferSession::HandleWindowedBlockAck(System::PacketBufferHandle msgData)
+{
+    VerifyOrReturn(mState == TransferState::kTransferInProgress || mState == TransferState::kAwaitingEOFAck,
+                   PrepareStatusReport(StatusCode::kUnexpectedMessage));
+    VerifyOrReturn(mNextBlockNum > 0, PrepareStatusReport(StatusCode::kUnexpectedMessage));
+
+    BlockAck ackMsg;
+    const CHIP_ERROR err = ackMsg.Parse(std::move(msgData));
+    VerifyOrReturn(err == CHIP_NO_ERROR, PrepareStatusReport(StatusCode::kBadMessageContents));
+    VerifyOrReturn(ackMsg.BlockCounter <= mLastBlockNum, PrepareStatusReport(StatusCode::kBadBlockCounter));
+
+    if (mControlMode == TransferControlFlags::kSenderDrive)
+    {
+        // Acknowledges all the Blocks up to the counter, which must be one of those in flight.
+        VerifyOrReturn(ackMsg.BlockCounter >= mNextBlockNum - mInFlight, PrepareStatusReport(StatusCode::kBadBlockCounter));
+        mInFlight         = static_cast<uint8_t>(mLastBlockNum - ackMsg.BlockCounter);
+        mAwaitingResponse = (mInFlight > 0) || (mState == TransferState::kAwaitingEOFAck);
+    }
+
+    mPendingOutput = OutputEventType::kAckReceived;
+
+#if CHIP_AUTOMATION_LOGGING
+    ackMsg.LogMessage(MessageType::BlockAck);
+#endif // CHIP_AUTOMATION_LOGGING
+}
+
 void TransferSession::ResolveTransferControlOptions(const BitFlags<TransferControlFlags> & proposed)
 {
     // Must specify at least one synchronous option
@@ -846,7 +1005,7 @@ void TransferSession::ResolveTransferControlOptions(const BitFlags<TransferContr
     }
 }
 
-CHIP_ERROR TransferSession::VerifyProposedMode(const BitFlags<TransferControlFlags> & proposed)
+CHIP_ERROR TransferSession::VerifyProposedMode(const BitFlags<TransferControlFlags> & proposed, bool windowed)
 {
     TransferControlFlags mode;
 
@@ -869,10 +1028,11 @@ CHIP_ERROR TransferSession::VerifyProposedMode(const BitFlags<TransferControlFla
         return CHIP_ERROR_INTERNAL;
     }
 
-    // Verify the proposed mode is supported by this instance
-    if (mSuppportedXferOpts.Has(mode))
+    // Verify the proposed mode is supported by this instance, and that a windowed transfer was proposed
+    if (mSuppportedXferOpts.Has(mode) && (!windowed || mWindowedSupported))
     {
         mControlMode = mode;
+        mWindowed    = windowed;
     }
     else
     {
@@ -915,6 +1075,34 @@ bool TransferSession::IsTransferLengthDefinite() const
     return (mTransferLength > 0);
 }
 
+uint32_t TransferSession::GetExpectedBlockNum() const
+{
+    // In a windowed ReceiverDrive transfer, Blocks answer the queries in flight in order.
+    if (mWindowed && mControlMode == TransferControlFlags::kReceiverDrive)
+    {
+        return mNextQueryNum - mInFlight;
+    }
+    return mLastQueryNum;
+}
+
+CHIP_ERROR TransferSession::SetWindowSize(uint8_t windowSize)
+{
+    VerifyOrReturnError(windowSize > 0, CHIP_ERROR_INVALID_ARGUMENT);
+    mWindowSize = windowSize;
+    return CHIP_NO_ERROR;
+}
+
+bool TransferSession::IsWindowOpen() const
+{
+    VerifyOrReturnValue(mState == TransferState::kTransferInProgress && mPendingOutput == OutputEventType::kNone, false);
+
+    const bool isDriving = (mRole == TransferRole::kSender && mControlMode == TransferControlFlags::kSenderDrive) ||
+        (mRole == TransferRole::kReceiver && mControlMode == TransferControlFlags::kReceiverDrive);
+    VerifyOrReturnValue(isDriving, false);
+
+    return mWindowed ? (mInFlight < mWindowSize) : !mAwaitingResponse;
+}
+
 const char * TransferSession::OutputEvent::ToString(OutputEventType outputEventType)
 {
     return TypeToString(outputEventType);
@@ -3,10 +3,26 @@
  *      This file defines a TransferSession state machine that contains the main logic governing a Bulk Data Transfer session. It
  *      provides APIs for starting a transfer or preparing to receive a transfer request, providing input to be processed, and
  *      accessing output data (including messages to be sent, message data received by the TransferSession, or state information).
+ *
+ *      Windowed transfers
+ *
+ *      A synchronous transfer normally has a single Block or BlockQuery outstanding at a time, which makes its throughput bound by
+ *      the round-trip time. When both peers support it, the initiator proposing it with TransferInitData::Windowed and the
+ *      responder accepting it with TransferAcceptData::Windowed, the driving side may instead keep up to GetWindowSize() messages
+ *      in flight. The proposal and the agreement are carried by a kWindowedTransferMetadataTag element in the Metadata of the Init
+ *      and Accept messages; a responder only accepts after SetWindowedTransferSupported(true).
+ *
+ *        - SenderDrive: the sender sends Blocks while IsWindowOpen(). A BlockAck acknowledges all the Blocks up to its counter.
+ *        - ReceiverDrive: the receiver sends BlockQueries while IsWindowOpen(). The sender answers each of them in order.
+ *
+ *      The window size is chosen by the driving side alone and is not exchanged. Windowed transfers require a transport that
+ *      delivers messages in order and allows several of them in flight on an exchange (e.g. TCP, but not MRP), and the caller must
+ *      poll the output of the TransferSession after each received message, before the next one is handed to it.
  */
 
 #pragma once
 
+#include <lib/core/CHIPConfig.h>
 #include <lib/core/CHIPError.h>
 #include <protocols/bdx/BdxMessages.h>
 #include <system/SystemClock.h>
@@ -57,6 +73,9 @@ public:
         // Additional metadata (optional, TLV format)
         const uint8_t * Metadata = nullptr;
         size_t MetadataLength    = 0;
+
+        /// Proposes a windowed transfer, in addition to the control modes in TransferCtlFlags.
+        bool Windowed = false;
     };
 
     struct TransferAcceptData
@@ -70,6 +89,10 @@ public:
         // Additional metadata (optional, TLV format)
         const uint8_t * Metadata = nullptr;
         size_t MetadataLength    = 0;
+
+        /// Requests a windowed transfer from AcceptTransfer(), which is only agreed if the initiator proposed it and it is
+        /// supported. In a kAcceptReceived event, indicates whether the transfer is windowed.
+        bool Windowed = false;
     };
 
     struct StatusReportData
@@ -272,6 +295,26 @@ public:
      */
     CHIP_ERROR PrepareBlock(const BlockData & inData);
 
+    /**
+     * @brief
+     *   Prepare a Block message from a buffer that already contains the Block data, without copying it. The Block counter is
+     *   written in place, in front of the data.
+     *
+     * @param blockBuf A buffer allocated by NewBlockBuffer(), containing the Block data, which may only be empty for a BlockEOF
+     * @param isEof    Whether this is the last Block of the transfer, i.e. a BlockEOF message
+     *
+     * @return CHIP_ERROR The result of the preparation of a Block message. May also indicate if the TransferSession object
+     *                    is unable to handle this request.
+     */
+    CHIP_ERROR PrepareBlock(System::PacketBufferHandle && blockBuf, bool isEof);
+
+    /**
+     * @brief
+     *   Allocate a buffer for the data of a Block, reserving room for the Block counter and for the message headers and footer.
+     *   The caller writes up to dataLength bytes at Start() and sets the data length before calling PrepareBlock().
+     */
+    static System::PacketBufferHandle NewBlockBuffer(size_t dataLength);
+
     /**
      * @brief
      *   Prepare a BlockAck message. The Block counter will be populated automatically.
@@ -299,6 +342,28 @@ public:
      */
     void Reset();
 
+    /**
+     * @brief
+     *   Set whether windowed transfers may be negotiated, e.g. withdraw support because the transport does not allow more than one
+     *   message in flight on an exchange. An initiator supports them if it proposed one in StartTransfer(), a responder must call
+     *   this after WaitForTransfer(). Has no effect on a transfer that is already accepted.
+     */
+    void SetWindowedTransferSupported(bool supported) { mWindowedSupported = supported; }
+
+    /**
+     * @brief
+     *   Set the number of messages the driving side of a windowed transfer keeps in flight. Defaults to
+     *   CHIP_CONFIG_BDX_WINDOW_SIZE.
+     */
+    CHIP_ERROR SetWindowSize(uint8_t windowSize);
+
+    /**
+     * @brief
+     *   Indicates whether the driving side of the transfer can prepare its next message now: a Block for the sender in SenderDrive,
+     *   or a BlockQuery for the receiver in ReceiverDrive. Without a window, this is only the case while no response is awaited.
+     */
+    bool IsWindowOpen() const;
+
     /**
      * @brief
      *   Process a message intended for this TransferSession object.
@@ -320,6 +385,8 @@ public:
     uint16_t GetTransferBlockSize() const { return mTransferMaxBlockSize; }
     uint32_t GetNextBlockNum() const { return mNextBlockNum; }
     uint32_t GetNextQueryNum() const { return mNextQueryNum; }
+    bool IsWindowed() const { return mWindowed; }
+    uint8_t GetWindowSize() const { return mWindowSize; }
     size_t GetNumBytesProcessed() const { return mNumBytesProcessed; }
     const uint8_t * GetFileDesignator(uint16_t & fileDesignatorLen) const
     {
@@ -354,6 +421,7 @@ private:
     void HandleBlock(System::PacketBufferHandle msgData);
     void HandleBlockEOF(System::PacketBufferHandle msgData);
     void HandleBlockAck(System::PacketBufferHandle msgData);
+    void HandleWindowedBlockAck(System::PacketBufferHandle msgData);
     void HandleBlockAckEOF(System::PacketBufferHandle msgData);
 
     /**
@@ -365,13 +433,19 @@ private:
 
     /**
      * @brief
-     *   Used when handling an Accept message. Verifies that the chosen control mode is compatible with the orignal supported modes.
+     *   Used when handling an Accept message. Verifies that the chosen control mode is compatible with the orignal supported modes,
+     *   and that a windowed transfer is only agreed to if one was proposed.
      */
-    CHIP_ERROR VerifyProposedMode(const BitFlags<TransferControlFlags> & proposed);
+    CHIP_ERROR VerifyProposedMode(const BitFlags<TransferControlFlags> & proposed, bool windowed);
 
     void PrepareStatusReport(StatusCode code);
     bool IsTransferLengthDefinite() const;
 
+    // Counter of the next Block expected by the receiver.
+    uint32_t GetExpectedBlockNum() const;
+    CHIP_ERROR VerifyCanPrepareBlock() const;
+    void OnBlockPrepared(MessageType msgType);
+
     OutputEventType mPendingOutput = OutputEventType::kNone;
     TransferState mState           = TransferState::kUnitialized;
     TransferRole mRole;
@@ -403,6 +477,13 @@ private:
     uint32_t mLastQueryNum = 0;
     uint32_t mNextQueryNum = 0;
 
+    // Windowed transfers
+    bool mWindowedSupported = false;
+    bool mWindowed          = false;
+    uint8_t mWindowSize     = CHIP_CONFIG_BDX_WINDOW_SIZE;
+    uint8_t mInFlight       = 0; ///< Blocks or BlockQueries sent by the driving side and not answered yet
+    uint8_t mQueriesPending = 0; ///< BlockQueries received by the sender in ReceiverDrive and not answered yet
+
     System::Clock::Timeout mTimeout            = System::Clock::kZero;
     System::Clock::Timestamp mTimeoutStartTime = System::Clock::kZero;
     bool mShouldInitTimeoutStart               = true;
@@ -57,6 +57,13 @@ CHIP_ERROR TransferFacilitator::OnMessageReceived(chip::Messaging::ExchangeConte
 
     ChipLogDetail(BDX, "%s: message " ChipLogFormatMessageType " protocol " ChipLogFormatProtocolId, __FUNCTION__,
                   payloadHeader.GetMessageType(), ChipLogValueProtocolId(payloadHeader.GetProtocolID()));
+
+    // MRP allows a single unacknowledged message per exchange, so only windowed transfers over TCP can pipeline Blocks.
+    if (ec->HasSessionHandle() && ec->GetSessionHandle()->AllowsMRP())
+    {
+        mTransfer.SetWindowedTransferSupported(false);
+    }
+
     CHIP_ERROR err =
         mTransfer.HandleMessageReceived(payloadHeader, std::move(payload), System::SystemClock().GetMonotonicTimestamp());
     if (err != CHIP_NO_ERROR)
@@ -70,9 +77,34 @@ CHIP_ERROR TransferFacilitator::OnMessageReceived(chip::Messaging::ExchangeConte
     // transfer is finished.
     mExchangeCtx->WillSendMessage();
 
+    if (mTransfer.IsWindowed())
+    {
+        DrainOutput();
+    }
+
     return err;
 }
 
+void TransferFacilitator::DrainOutput()
+{
+    // Bounded, since handling an output event may prepare the next message to send.
+    for (uint16_t i = 0; i < 2 * (UINT8_MAX + 1); i++)
+    {
+        TransferSession::OutputEvent outEvent;
+        mTransfer.PollOutput(outEvent, System::SystemClock().GetMonotonicTimestamp());
+
+        const auto eventType = outEvent.EventType;
+        VerifyOrReturn(eventType != TransferSession::OutputEventType::kNone);
+
+        HandleTransferSessionOutput(outEvent);
+
+        // The transfer is over, and PollOutput() would report the error again.
+        VerifyOrReturn(eventType != TransferSession::OutputEventType::kInternalError &&
+                       eventType != TransferSession::OutputEventType::kStatusReceived &&
+                       eventType != TransferSession::OutputEventType::kTransferTimeout);
+    }
+}
+
 void TransferFacilitator::OnResponseTimeout(Messaging::ExchangeContext * ec)
 {
     ChipLogError(BDX, "%s, ec: " ChipLogFormatExchange, __FUNCTION__, ChipLogValueExchange(ec));
@@ -95,6 +95,12 @@ protected:
      */
     void ScheduleImmediatePoll();
 
+    /**
+     * Polls the TransferSession object until it has no more output. Used for windowed transfers, so that every Block of the
+     * window is sent as soon as it is prepared instead of one per poll period.
+     */
+    void DrainOutput();
+
     TransferSession mTransfer;
     Messaging::ExchangeContext * mExchangeCtx = nullptr;
     System::Layer * mSystemLayer              = nullptr;
@@ -108,6 +108,53 @@ TEST_F(TestBdxMessages, TestReceiveAcceptMessage)
     TestHelperWrittenAndParsedMatch<ReceiveAccept>(testMsg);
 }
 
+TEST_F(TestBdxMessages, TestWindowedTransferMetadata)
+{
+    TransferInit initMsg;
+    initMsg.TransferCtlOptions.Set(TransferControlFlags::kSenderDrive);
+    initMsg.Version      = 1;
+    initMsg.MaxBlockSize = 256;
+    initMsg.Windowed     = true;
+
+    char testFileDes[9]    = { "test.txt" };
+    initMsg.FileDesLength  = 9;
+    initMsg.FileDesignator = reinterpret_cast<uint8_t *>(testFileDes);
+
+    // Without other Metadata
+    TestHelperWrittenAndParsedMatch<TransferInit>(initMsg);
+
+    // After other Metadata, which is left untouched: an anonymous structure holding a context-tagged unsigned integer
+    uint8_t tlvMetadata[]  = { 0x15, 0x24, 0x01, 0x2A, 0x18 };
+    initMsg.Metadata       = tlvMetadata;
+    initMsg.MetadataLength = sizeof(tlvMetadata);
+    TestHelperWrittenAndParsedMatch<TransferInit>(initMsg);
+
+    SendAccept sendAcceptMsg;
+    sendAcceptMsg.Version = 1;
+    sendAcceptMsg.TransferCtlFlags.Set(TransferControlFlags::kSenderDrive);
+    sendAcceptMsg.MaxBlockSize = 256;
+    sendAcceptMsg.Windowed     = true;
+    TestHelperWrittenAndParsedMatch<SendAccept>(sendAcceptMsg);
+
+    ReceiveAccept receiveAcceptMsg;
+    receiveAcceptMsg.Version = 1;
+    receiveAcceptMsg.TransferCtlFlags.Set(TransferControlFlags::kReceiverDrive);
+    receiveAcceptMsg.MaxBlockSize   = 256;
+    receiveAcceptMsg.Windowed       = true;
+    receiveAcceptMsg.Metadata       = tlvMetadata;
+    receiveAcceptMsg.MetadataLength = sizeof(tlvMetadata);
+    TestHelperWrittenAndParsedMatch<ReceiveAccept>(receiveAcceptMsg);
+
+    // Metadata that is not well-formed TLV is never mistaken for a windowed transfer proposal
+    receiveAcceptMsg.Windowed                   = false;
+    uint8_t element[]                           = { 0xC9, 0x02, 0x00, 0x00, 0x00, 0x01, 0x80 };
+    uint8_t notTlvMetadata[1 + sizeof(element)] = { 0x15 };
+    memcpy(&notTlvMetadata[1], element, sizeof(element));
+    receiveAcceptMsg.Metadata       = notTlvMetadata;
+    receiveAcceptMsg.MetadataLength = sizeof(notTlvMetadata);
+    TestHelperWrittenAndParsedMatch<ReceiveAccept>(receiveAcceptMsg);
+}
+
 TEST_F(TestBdxMessages, TestCounterMessage)
 {
     CounterMessage testMsg;
@@ -161,6 +161,7 @@ void SendAndVerifyTransferInit(TransferSession::OutputEvent & outEvent, System::
     VerifyNoMoreOutput(responder);
     EXPECT_EQ(outEvent.EventType, TransferSession::OutputEventType::kInitReceived);
     EXPECT_EQ(outEvent.transferInitData.TransferCtlFlags, initData.TransferCtlFlags);
+    EXPECT_EQ(outEvent.transferInitData.Windowed, initData.Windowed);
     EXPECT_EQ(outEvent.transferInitData.MaxBlockSize, initData.MaxBlockSize);
     EXPECT_EQ(outEvent.transferInitData.StartOffset, initData.StartOffset);
     EXPECT_EQ(outEvent.transferInitData.Length, initData.Length);
@@ -759,3 +760,258 @@ TEST_F(TestBdxTransferSession, TestRejectTransfer)
     // Reject the transfer with a status
     SendAndVerifyRejectMsg(outEvent, respondingSender, StatusCode::kResponderBusy, initiatingReceiver);
 }
+
+// Test a windowed Sender Drive transfer: the sender keeps several Blocks in flight, and a single BlockAck acknowledges all of them.
+TEST_F(TestBdxTransferSession, TestWindowedSenderDrive)
+{
+    TransferSession::OutputEvent outEvent;
+    TransferSession initiatingSender;
+    TransferSession respondingReceiver;
+
+    // Chosen arbitrarily for this test
+    uint8_t windowSize             = 3;
+    uint16_t transferBlockSize     = 10;
+    System::Clock::Timeout timeout = System::Clock::Seconds16(24);
+
+    BitFlags<TransferControlFlags> receiverOpts(TransferControlFlags::kSenderDrive);
+
+    TransferSession::TransferInitData initOptions;
+    initOptions.TransferCtlFlags = TransferControlFlags::kSenderDrive;
+    initOptions.Windowed         = true;
+    initOptions.MaxBlockSize     = transferBlockSize;
+    char testFileDes[9]          = { "test.txt" };
+    initOptions.FileDesLength    = static_cast<uint16_t>(strlen(testFileDes));
+    initOptions.FileDesignator   = reinterpret_cast<uint8_t *>(testFileDes);
+
+    EXPECT_EQ(initiatingSender.SetWindowSize(0), CHIP_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(initiatingSender.SetWindowSize(windowSize), CHIP_NO_ERROR);
+
+    SendAndVerifyTransferInit(outEvent, timeout, initiatingSender, TransferRole::kSender, initOptions, respondingReceiver,
+                              receiverOpts, transferBlockSize);
+    respondingReceiver.SetWindowedTransferSupported(true);
+
+    TransferSession::TransferAcceptData acceptData;
+    acceptData.ControlMode  = TransferControlFlags::kSenderDrive;
+    acceptData.MaxBlockSize = transferBlockSize;
+    acceptData.Windowed     = true;
+
+    SendAndVerifyAcceptMsg(outEvent, respondingReceiver, TransferRole::kReceiver, acceptData, initiatingSender, initOptions);
+    EXPECT_TRUE(outEvent.transferAcceptData.Windowed);
+    EXPECT_TRUE(initiatingSender.IsWindowed());
+    EXPECT_TRUE(respondingReceiver.IsWindowed());
+
+    // Fill the window without waiting for any BlockAck
+    uint32_t numBlocksSent = 0;
+    for (; numBlocksSent < windowSize; numBlocksSent++)
+    {
+        EXPECT_TRUE(initiatingSender.IsWindowOpen());
+        SendAndVerifyArbitraryBlock(initiatingSender, respondingReceiver, outEvent, false, numBlocksSent);
+    }
+    EXPECT_FALSE(initiatingSender.IsWindowOpen());
+    EXPECT_FALSE(respondingReceiver.IsWindowOpen());
+
+    TransferSession::BlockData blockData;
+    uint8_t fakeData[1] = { 0 };
+    blockData.Data      = fakeData;
+    blockData.Length    = sizeof(fakeData);
+    EXPECT_EQ(initiatingSender.PrepareBlock(blockData), CHIP_ERROR_INCORRECT_STATE);
+
+    // The BlockAck for the last Block acknowledges the whole window
+    SendAndVerifyBlockAck(initiatingSender, respondingReceiver, outEvent, false);
+    EXPECT_TRUE(initiatingSender.IsWindowOpen());
+
+    SendAndVerifyArbitraryBlock(initiatingSender, respondingReceiver, outEvent, false, numBlocksSent++);
+    SendAndVerifyArbitraryBlock(initiatingSender, respondingReceiver, outEvent, true, numBlocksSent);
+    SendAndVerifyBlockAck(initiatingSender, respondingReceiver, outEvent, true);
+}
+
+// Test a windowed Receiver Drive transfer: the receiver keeps several BlockQuery messages in flight, and the sender ignores the
+// queries that arrive after it has sent the BlockEOF.
+TEST_F(TestBdxTransferSession, TestWindowedReceiverDrive)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    TransferSession::OutputEvent outEvent;
+    TransferSession initiatingReceiver;
+    TransferSession respondingSender;
+
+    // Chosen arbitrarily for this test
+    uint8_t windowSize             = 3;
+    uint16_t transferBlockSize     = 10;
+    System::Clock::Timeout timeout = System::Clock::Seconds16(24);
+
+    BitFlags<TransferControlFlags> senderOpts(TransferControlFlags::kReceiverDrive);
+
+    TransferSession::TransferInitData initOptions;
+    initOptions.TransferCtlFlags = TransferControlFlags::kReceiverDrive;
+    initOptions.Windowed         = true;
+    initOptions.MaxBlockSize     = transferBlockSize;
+    char testFileDes[9]          = { "test.txt" };
+    initOptions.FileDesLength    = static_cast<uint16_t>(strlen(testFileDes));
+    initOptions.FileDesignator   = reinterpret_cast<uint8_t *>(testFileDes);
+
+    EXPECT_EQ(initiatingReceiver.SetWindowSize(windowSize), CHIP_NO_ERROR);
+
+    SendAndVerifyTransferInit(outEvent, timeout, initiatingReceiver, TransferRole::kReceiver, initOptions, respondingSender,
+                              senderOpts, transferBlockSize);
+    respondingSender.SetWindowedTransferSupported(true);
+
+    TransferSession::TransferAcceptData acceptData;
+    acceptData.ControlMode  = TransferControlFlags::kReceiverDrive;
+    acceptData.MaxBlockSize = transferBlockSize;
+    acceptData.Windowed     = true;
+
+    SendAndVerifyAcceptMsg(outEvent, respondingSender, TransferRole::kSender, acceptData, initiatingReceiver, initOptions);
+    EXPECT_TRUE(initiatingReceiver.IsWindowed());
+    EXPECT_TRUE(respondingSender.IsWindowed());
+
+    // Fill the window with queries before any Block is sent
+    System::PacketBufferHandle queries[3];
+    TransferSession::MessageTypeData queryType;
+    for (auto & query : queries)
+    {
+        EXPECT_TRUE(initiatingReceiver.IsWindowOpen());
+        err = initiatingReceiver.PrepareBlockQuery();
+        EXPECT_EQ(err, CHIP_NO_ERROR);
+        initiatingReceiver.PollOutput(outEvent, kNoAdvanceTime);
+        VerifyBdxMessageToSend(outEvent, MessageType::BlockQuery);
+        queryType = outEvent.msgTypeData;
+        query     = std::move(outEvent.MsgData);
+    }
+    EXPECT_FALSE(initiatingReceiver.IsWindowOpen());
+    EXPECT_EQ(initiatingReceiver.PrepareBlockQuery(), CHIP_ERROR_INCORRECT_STATE);
+
+    for (int i = 0; i < 2; i++)
+    {
+        err = AttachHeaderAndSend(queryType, std::move(queries[i]), respondingSender);
+        EXPECT_EQ(err, CHIP_NO_ERROR);
+        respondingSender.PollOutput(outEvent, kNoAdvanceTime);
+        EXPECT_EQ(outEvent.EventType, TransferSession::OutputEventType::kQueryReceived);
+        VerifyNoMoreOutput(respondingSender);
+    }
+
+    // Each Block answers the oldest query, in order
+    SendAndVerifyArbitraryBlock(respondingSender, initiatingReceiver, outEvent, false, 0);
+    EXPECT_TRUE(initiatingReceiver.IsWindowOpen());
+    EXPECT_FALSE(respondingSender.IsWindowOpen());
+    SendAndVerifyArbitraryBlock(respondingSender, initiatingReceiver, outEvent, true, 1);
+
+    // The last query crossed the BlockEOF, and is silently dropped by the sender
+    err = AttachHeaderAndSend(queryType, std::move(queries[2]), respondingSender);
+    EXPECT_EQ(err, CHIP_NO_ERROR);
+    VerifyNoMoreOutput(respondingSender);
+
+    SendAndVerifyBlockAck(respondingSender, initiatingReceiver, outEvent, true);
+}
+
+// Test that a windowed transfer falls back to a lock-step transfer when the responder does not support it.
+TEST_F(TestBdxTransferSession, TestWindowedTransferNotSupported)
+{
+    TransferSession::OutputEvent outEvent;
+    TransferSession initiatingSender;
+    TransferSession respondingReceiver;
+
+    // Chosen arbitrarily for this test
+    uint16_t transferBlockSize     = 10;
+    System::Clock::Timeout timeout = System::Clock::Seconds16(24);
+
+    BitFlags<TransferControlFlags> receiverOpts(TransferControlFlags::kSenderDrive);
+
+    TransferSession::TransferInitData initOptions;
+    initOptions.TransferCtlFlags = TransferControlFlags::kSenderDrive;
+    initOptions.Windowed         = true;
+    initOptions.MaxBlockSize     = transferBlockSize;
+    char testFileDes[9]          = { "test.txt" };
+    initOptions.FileDesLength    = static_cast<uint16_t>(strlen(testFileDes));
+    initOptions.FileDesignator   = reinterpret_cast<uint8_t *>(testFileDes);
+
+    SendAndVerifyTransferInit(outEvent, timeout, initiatingSender, TransferRole::kSender, initOptions, respondingReceiver,
+                              receiverOpts, transferBlockSize);
+
+    TransferSession::TransferAcceptData acceptData;
+    acceptData.ControlMode  = TransferControlFlags::kSenderDrive;
+    acceptData.MaxBlockSize = transferBlockSize;
+    acceptData.Windowed     = true;
+
+    SendAndVerifyAcceptMsg(outEvent, respondingReceiver, TransferRole::kReceiver, acceptData, initiatingSender, initOptions);
+    EXPECT_FALSE(outEvent.transferAcceptData.Windowed);
+    EXPECT_FALSE(initiatingSender.IsWindowed());
+    EXPECT_FALSE(respondingReceiver.IsWindowed());
+
+    // Only one Block may be in flight
+    SendAndVerifyArbitraryBlock(initiatingSender, respondingReceiver, outEvent, false, 0);
+    EXPECT_FALSE(initiatingSender.IsWindowOpen());
+    SendAndVerifyBlockAck(initiatingSender, respondingReceiver, outEvent, false);
+    SendAndVerifyArbitraryBlock(initiatingSender, respondingReceiver, outEvent, true, 1);
+    SendAndVerifyBlockAck(initiatingSender, respondingReceiver, outEvent, true);
+}
+
+// Test that a Block prepared in place in a buffer from NewBlockBuffer() is received like a Block prepared from BlockData.
+TEST_F(TestBdxTransferSession, TestPrepareBlockFromBuffer)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    TransferSession::OutputEvent outEvent;
+    TransferSession initiatingSender;
+    TransferSession respondingReceiver;
+
+    // Chosen arbitrarily for this test
+    uint16_t transferBlockSize     = 10;
+    System::Clock::Timeout timeout = System::Clock::Seconds16(24);
+
+    BitFlags<TransferControlFlags> receiverOpts(TransferControlFlags::kSenderDrive);
+
+    TransferSession::TransferInitData initOptions;
+    initOptions.TransferCtlFlags = TransferControlFlags::kSenderDrive;
+    initOptions.MaxBlockSize     = transferBlockSize;
+    char testFileDes[9]          = { "test.txt" };
+    initOptions.FileDesLength    = static_cast<uint16_t>(strlen(testFileDes));
+    initOptions.FileDesignator   = reinterpret_cast<uint8_t *>(testFileDes);
+
+    SendAndVerifyTransferInit(outEvent, timeout, initiatingSender, TransferRole::kSender, initOptions, respondingReceiver,
+                              receiverOpts, transferBlockSize);
+
+    TransferSession::TransferAcceptData acceptData;
+    acceptData.ControlMode  = TransferControlFlags::kSenderDrive;
+    acceptData.MaxBlockSize = transferBlockSize;
+
+    SendAndVerifyAcceptMsg(outEvent, respondingReceiver, TransferRole::kReceiver, acceptData, initiatingSender, initOptions);
+
+    // A buffer without room for the Block counter is rejected
+    System::PacketBufferHandle unreservedBuf = System::PacketBufferHandle::New(transferBlockSize, 0);
+    ASSERT_FALSE(unreservedBuf.IsNull());
+    unreservedBuf->SetDataLength(transferBlockSize);
+    EXPECT_EQ(initiatingSender.PrepareBlock(std::move(unreservedBuf), false), CHIP_ERROR_BUFFER_TOO_SMALL);
+
+    // Only a BlockEOF may be empty
+    System::PacketBufferHandle emptyBuf = TransferSession::NewBlockBuffer(0);
+    ASSERT_FALSE(emptyBuf.IsNull());
+    EXPECT_EQ(initiatingSender.PrepareBlock(std::move(emptyBuf), false), CHIP_ERROR_INVALID_ARGUMENT);
+
+    const uint8_t blockData[] = { 'b', 'l', 'o', 'c', 'k', ' ', 'd', 'a', 't', 'a' };
+    for (uint32_t blockCounter = 0; blockCounter < 2; blockCounter++)
+    {
+        const bool isEof = (blockCounter == 1);
+
+        System::PacketBufferHandle blockBuf = TransferSession::NewBlockBuffer(sizeof(blockData));
+        ASSERT_FALSE(blockBuf.IsNull());
+        memcpy(blockBuf->Start(), blockData, sizeof(blockData));
+        blockBuf->SetDataLength(sizeof(blockData));
+
+        err = initiatingSender.PrepareBlock(std::move(blockBuf), isEof);
+        EXPECT_EQ(err, CHIP_NO_ERROR);
+        initiatingSender.PollOutput(outEvent, kNoAdvanceTime);
+        VerifyBdxMessageToSend(outEvent, isEof ? MessageType::BlockEOF : MessageType::Block);
+        VerifyNoMoreOutput(initiatingSender);
+
+        err = AttachHeaderAndSend(outEvent.msgTypeData, std::move(outEvent.MsgData), respondingReceiver);
+        EXPECT_EQ(err, CHIP_NO_ERROR);
+        respondingReceiver.PollOutput(outEvent, kNoAdvanceTime);
+        ASSERT_EQ(outEvent.EventType, TransferSession::OutputEventType::kBlockReceived);
+        EXPECT_EQ(outEvent.blockdata.BlockCounter, blockCounter);
+        EXPECT_EQ(outEvent.blockdata.IsEof, isEof);
+        ASSERT_EQ(outEvent.blockdata.Length, sizeof(blockData));
+        EXPECT_EQ(0, memcmp(outEvent.blockdata.Data, blockData, sizeof(blockData)));
+        VerifyNoMoreOutput(respondingReceiver);
+
+        SendAndVerifyBlockAck(initiatingSender, respondingReceiver, outEvent, isEof);
+    }
+}
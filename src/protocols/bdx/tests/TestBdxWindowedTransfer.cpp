@@ -0,0 +1,210 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Compares the throughput of lock-step and windowed BDX transfers between two TransferSession objects connected by an
+ *      in-memory link with a fixed latency, on a simulated clock.
+ */
+
+#include <deque>
+#include <string.h>
+
+#include <pw_unit_test/framework.h>
+
+#include <lib/core/StringBuilderAdapters.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <protocols/bdx/BdxMessages.h>
+#include <protocols/bdx/BdxTransferSession.h>
+#include <system/SystemPacketBuffer.h>
+#include <transport/raw/MessageHeader.h>
+
+using namespace ::chip;
+using namespace ::chip::bdx;
+
+namespace {
+
+constexpr System::Clock::Milliseconds64 kLinkLatency = System::Clock::Milliseconds64(50);
+constexpr System::Clock::Timeout kTransferTimeout    = System::Clock::Seconds16(60);
+constexpr uint16_t kBlockSize                        = 512;
+constexpr uint32_t kNumBlocks                        = 256;
+constexpr uint8_t kWindowSize                        = 8;
+
+// Delivers the messages sent between two TransferSession objects in order, each one kLinkLatency after it was sent.
+class LoopbackLink
+{
+public:
+    System::Clock::Timestamp Now() const { return mNow; }
+
+    void Send(TransferSession & destination, TransferSession::OutputEvent & event)
+    {
+        EXPECT_EQ(event.EventType, TransferSession::OutputEventType::kMsgToSend);
+        mInFlight.push_back({ &destination, event.msgTypeData, std::move(event.MsgData), mNow + kLinkLatency });
+    }
+
+    // Advances the clock to the delivery time of the next message and hands it to its destination.
+    TransferSession * DeliverNext()
+    {
+        VerifyOrReturnValue(!mInFlight.empty(), nullptr);
+
+        InFlightMessage message = std::move(mInFlight.front());
+        mInFlight.pop_front();
+        mNow = message.deliverAt;
+
+        PayloadHeader payloadHeader;
+        payloadHeader.SetMessageType(message.typeData.ProtocolId, message.typeData.MessageType);
+        EXPECT_EQ(message.destination->HandleMessageReceived(payloadHeader, std::move(message.payload), mNow), CHIP_NO_ERROR);
+        return message.destination;
+    }
+
+private:
+    struct InFlightMessage
+    {
+        TransferSession * destination;
+        TransferSession::MessageTypeData typeData;
+        System::PacketBufferHandle payload;
+        System::Clock::Timestamp deliverAt;
+    };
+
+    std::deque<InFlightMessage> mInFlight;
+    System::Clock::Timestamp mNow = System::Clock::kZero;
+};
+
+struct TransferResult
+{
+    System::Clock::Milliseconds64 elapsed = System::Clock::kZero;
+    uint32_t blocksReceived               = 0;
+};
+
+// Runs a Sender Drive transfer of kNumBlocks Blocks, the receiver acknowledging each Block as soon as it is received.
+TransferResult RunTransfer(bool windowed)
+{
+    LoopbackLink link;
+    TransferSession sender;
+    TransferSession receiver;
+    TransferSession::OutputEvent event;
+    TransferResult result;
+
+    BitFlags<TransferControlFlags> receiverOpts(TransferControlFlags::kSenderDrive);
+    EXPECT_EQ(receiver.WaitForTransfer(TransferRole::kReceiver, receiverOpts, kBlockSize, kTransferTimeout), CHIP_NO_ERROR);
+    receiver.SetWindowedTransferSupported(windowed);
+    EXPECT_EQ(sender.SetWindowSize(kWindowSize), CHIP_NO_ERROR);
+
+    char fileDesignator[]    = "bench.bin";
+    uint8_t data[kBlockSize] = { 0 };
+
+    TransferSession::TransferInitData initData;
+    initData.TransferCtlFlags = TransferControlFlags::kSenderDrive;
+    initData.MaxBlockSize     = kBlockSize;
+    initData.Length           = kNumBlocks * kBlockSize;
+    initData.FileDesignator   = reinterpret_cast<uint8_t *>(fileDesignator);
+    initData.FileDesLength    = static_cast<uint16_t>(strlen(fileDesignator));
+    initData.Windowed         = windowed;
+    EXPECT_EQ(sender.StartTransfer(TransferRole::kSender, initData, kTransferTimeout), CHIP_NO_ERROR);
+
+    sender.PollOutput(event, link.Now());
+    link.Send(receiver, event);
+    link.DeliverNext();
+    receiver.PollOutput(event, link.Now());
+    EXPECT_EQ(event.EventType, TransferSession::OutputEventType::kInitReceived);
+
+    TransferSession::TransferAcceptData acceptData;
+    acceptData.ControlMode  = TransferControlFlags::kSenderDrive;
+    acceptData.MaxBlockSize = kBlockSize;
+    acceptData.Length       = initData.Length;
+    acceptData.Windowed     = windowed;
+    EXPECT_EQ(receiver.AcceptTransfer(acceptData), CHIP_NO_ERROR);
+
+    receiver.PollOutput(event, link.Now());
+    link.Send(sender, event);
+    link.DeliverNext();
+    sender.PollOutput(event, link.Now());
+    EXPECT_EQ(event.EventType, TransferSession::OutputEventType::kAcceptReceived);
+    EXPECT_EQ(sender.IsWindowed(), windowed);
+
+    const System::Clock::Timestamp start = link.Now();
+    uint32_t blocksSent                  = 0;
+    bool done                            = false;
+
+    while (!done)
+    {
+        while (blocksSent < kNumBlocks && sender.IsWindowOpen())
+        {
+            TransferSession::BlockData blockData;
+            blockData.Data   = data;
+            blockData.Length = sizeof(data);
+            blockData.IsEof  = (blocksSent + 1 == kNumBlocks);
+            EXPECT_EQ(sender.PrepareBlock(blockData), CHIP_NO_ERROR);
+
+            sender.PollOutput(event, link.Now());
+            link.Send(receiver, event);
+            blocksSent++;
+        }
+
+        TransferSession * destination = link.DeliverNext();
+        VerifyOrReturnValue(destination != nullptr, result, ADD_FAILURE() << "Transfer stalled");
+
+        destination->PollOutput(event, link.Now());
+        switch (event.EventType)
+        {
+        case TransferSession::OutputEventType::kBlockReceived:
+            result.blocksReceived++;
+            EXPECT_EQ(receiver.PrepareBlockAck(), CHIP_NO_ERROR);
+            receiver.PollOutput(event, link.Now());
+            link.Send(sender, event);
+            break;
+        case TransferSession::OutputEventType::kAckReceived:
+            break;
+        case TransferSession::OutputEventType::kAckEOFReceived:
+            done = true;
+            break;
+        default:
+            ADD_FAILURE() << "Unexpected event " << TransferSession::OutputEvent::TypeToString(event.EventType);
+            return result;
+        }
+    }
+
+    result.elapsed = link.Now() - start;
+    return result;
+}
+
+struct TestBdxWindowedTransfer : public ::testing::Test
+{
+    static void SetUpTestSuite() { EXPECT_EQ(chip::Platform::MemoryInit(), CHIP_NO_ERROR); }
+    static void TearDownTestSuite() { chip::Platform::MemoryShutdown(); }
+};
+
+TEST_F(TestBdxWindowedTransfer, TestThroughputOverHighLatencyLink)
+{
+    const TransferResult lockStep = RunTransfer(false);
+    const TransferResult windowed = RunTransfer(true);
+
+    EXPECT_EQ(lockStep.blocksReceived, kNumBlocks);
+    EXPECT_EQ(windowed.blocksReceived, kNumBlocks);
+
+    const uint32_t numBytes = kNumBlocks * kBlockSize;
+    ChipLogProgress(BDX, "Transferred %u bytes in %u ms lock-step, in %u ms with a window of %u", static_cast<unsigned>(numBytes),
+                    static_cast<unsigned>(lockStep.elapsed.count()), static_cast<unsigned>(windowed.elapsed.count()),
+                    static_cast<unsigned>(kWindowSize));
+
+    // Lock-step transfers need a round trip per Block, while windowed transfers need one per window.
+    EXPECT_GE(lockStep.elapsed, kLinkLatency * 2 * kNumBlocks);
+    EXPECT_LE(windowed.elapsed, kLinkLatency * 2 * (kNumBlocks / kWindowSize + 1));
+}
+
+} // namespace
@@ -523,6 +523,37 @@ struct LwIPEvent;
 #define CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS 0
 #endif // CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
 
+/**
+ *  @def CHIP_SYSTEM_CONFIG_EVENT_LOOP_PROFILER
+ *
+ *  @brief
+ *      This defines whether (1) or not (0) the CHIP System Layer measures the time spent in every callback dispatched by
+ *      the event loop (timers, sockets and platform events), so that event loop stalls can be attributed at runtime.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_EVENT_LOOP_PROFILER
+#define CHIP_SYSTEM_CONFIG_EVENT_LOOP_PROFILER 0
+#endif // CHIP_SYSTEM_CONFIG_EVENT_LOOP_PROFILER
+
+/**
+ *  @def CHIP_SYSTEM_CONFIG_EVENT_LOOP_PROFILER_SLOWEST_COUNT
+ *
+ *  @brief
+ *      The number of slowest event loop dispatches retained by the event loop profiler.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_EVENT_LOOP_PROFILER_SLOWEST_COUNT
+#define CHIP_SYSTEM_CONFIG_EVENT_LOOP_PROFILER_SLOWEST_COUNT 8
+#endif // CHIP_SYSTEM_CONFIG_EVENT_LOOP_PROFILER_SLOWEST_COUNT
+
+/**
+ *  @def CHIP_SYSTEM_CONFIG_EVENT_LOOP_PROFILER_MAX_LABEL_DEPTH
+ *
+ *  @brief
+ *      The number of nested trace labels the event loop profiler keeps for each of the slowest dispatches.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_EVENT_LOOP_PROFILER_MAX_LABEL_DEPTH
+#define CHIP_SYSTEM_CONFIG_EVENT_LOOP_PROFILER_MAX_LABEL_DEPTH 4
+#endif // CHIP_SYSTEM_CONFIG_EVENT_LOOP_PROFILER_MAX_LABEL_DEPTH
+
 /**
  *  @def CHIP_SYSTEM_CONFIG_TEST
  *
@@ -0,0 +1,235 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ * @file
+ *  This file implements a profiler measuring the callbacks dispatched by
+ *  the event loop of the CHIP platform thread.
+ */
+
+// Include module header
+#include <system/SystemEventLoopProfiler.h>
+
+#if CHIP_SYSTEM_CONFIG_EVENT_LOOP_PROFILER
+
+#include <lib/support/CodeUtils.h>
+
+#include <algorithm>
+#include <string.h>
+
+namespace chip {
+namespace System {
+
+namespace {
+
+size_t LagBucket(Clock::Milliseconds64 lag)
+{
+    uint64_t lagMs = lag.count();
+    size_t bucket  = 0;
+    while (lagMs != 0 && bucket + 1 < EventLoopProfiler::kLagBucketCount)
+    {
+        lagMs >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+} // namespace
+
+EventLoopProfiler & EventLoopProfiler::GetInstance()
+{
+    static EventLoopProfiler sInstance;
+    return sInstance;
+}
+
+void EventLoopProfiler::Reset()
+{
+    for (auto & stats : mStats)
+    {
+        stats = {};
+    }
+    mSlowestCount = 0;
+}
+
+bool EventLoopProfiler::BeginDispatch(DispatchKind kind, uintptr_t origin, const Clock::Timestamp * dueTime)
+{
+    if (mDispatchDepth != 0)
+    {
+        // Accounted to the outermost dispatch.
+        mDispatchDepth++;
+        return true;
+    }
+    VerifyOrReturnValue(mEnabled, false);
+
+    mDispatchDepth  = 1;
+    mCurrent        = {};
+    mCurrent.kind   = kind;
+    mCurrent.origin = origin;
+    mCurrentStart   = SystemClock().GetMonotonicMicroseconds64();
+    mCurrent.start  = std::chrono::duration_cast<Clock::Timestamp>(mCurrentStart);
+    mLabelDepth     = 0;
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    mDispatchThread = pthread_self();
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    mDispatching.store(true, std::memory_order_release);
+
+    if (dueTime != nullptr)
+    {
+        // Expired timers are collected up to 1 ms early, so the lag may be negative.
+        Clock::Milliseconds64 lag = (mCurrent.start > *dueTime) ? (mCurrent.start - *dueTime) : Clock::kZero;
+        mStats[static_cast<size_t>(kind)].lagHistogram[LagBucket(lag)]++;
+    }
+
+    return true;
+}
+
+void EventLoopProfiler::EndDispatch()
+{
+    VerifyOrReturn(--mDispatchDepth == 0);
+
+    mDispatching.store(false, std::memory_order_release);
+
+    uint64_t duration = (SystemClock().GetMonotonicMicroseconds64() - mCurrentStart).count();
+    mCurrent.duration = Clock::Microseconds32(static_cast<uint32_t>(std::min<uint64_t>(duration, UINT32_MAX)));
+
+    KindStats & stats = mStats[static_cast<size_t>(mCurrent.kind)];
+    stats.count++;
+    stats.totalTime += mCurrent.duration;
+    stats.maxDuration = std::max(stats.maxDuration, mCurrent.duration);
+
+    RecordSlowDispatch();
+}
+
+void EventLoopProfiler::RecordSlowDispatch()
+{
+    if (mSlowestCount < kSlowestCount)
+    {
+        mSlowest[mSlowestCount++] = mCurrent;
+        return;
+    }
+
+    auto faster              = [](const DispatchRecord & a, const DispatchRecord & b) { return a.duration < b.duration; };
+    DispatchRecord * fastest = std::min_element(mSlowest, mSlowest + kSlowestCount, faster);
+    if (fastest->duration < mCurrent.duration)
+    {
+        *fastest = mCurrent;
+    }
+}
+
+bool EventLoopProfiler::IsDispatchThread() const
+{
+    if (!mDispatching.load(std::memory_order_acquire))
+    {
+        return false;
+    }
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    return pthread_equal(mDispatchThread, pthread_self());
+#else
+    return true;
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+}
+
+void EventLoopProfiler::PushLabel(const char * label)
+{
+    if (!IsDispatchThread())
+    {
+        return;
+    }
+
+    if (mLabelDepth < kMaxLabelDepth)
+    {
+        mLabelStack[mLabelDepth] = label;
+    }
+    mLabelDepth++;
+
+    // Keep the stack at the deepest point reached by the dispatch.
+    size_t depth = std::min(mLabelDepth, kMaxLabelDepth);
+    if (depth > mCurrent.labelCount)
+    {
+        std::copy(mLabelStack, mLabelStack + depth, mCurrent.labels);
+        mCurrent.labelCount = static_cast<uint8_t>(depth);
+    }
+}
+
+void EventLoopProfiler::PopLabel(const char * label)
+{
+    if (!IsDispatchThread() || mLabelDepth == 0)
+    {
+        return;
+    }
+
+    if (mLabelDepth > kMaxLabelDepth)
+    {
+        // The label was not stored and cannot be matched.
+        mLabelDepth--;
+        return;
+    }
+
+    // Labels opened before the dispatch started are not on the stack and are
+    // ignored. Labels left open by their scope are closed with their parent.
+    for (size_t i = mLabelDepth; i > 0; i--)
+    {
+        if (mLabelStack[i - 1] == label || strcmp(mLabelStack[i - 1], label) == 0)
+        {
+            mLabelDepth = i - 1;
+            return;
+        }
+    }
+}
+
+size_t EventLoopProfiler::GetSlowestDispatches(DispatchRecord * records, size_t maxRecords) const
+{
+    size_t count = std::min(maxRecords, mSlowestCount);
+    std::partial_sort_copy(mSlowest, mSlowest + mSlowestCount, records, records + count,
+                           [](const DispatchRecord & a, const DispatchRecord & b) { return a.duration > b.duration; });
+    return count;
+}
+
+Clock::Milliseconds32 EventLoopProfiler::GetLagBucketLimit(size_t bucket)
+{
+    if (bucket + 1 >= kLagBucketCount)
+    {
+        return Clock::Milliseconds32(UINT32_MAX);
+    }
+    return Clock::Milliseconds32(1u << bucket);
+}
+
+const char * EventLoopProfiler::KindToString(DispatchKind kind)
+{
+    switch (kind)
+    {
+    case DispatchKind::kTimer:
+        return "Timer";
+    case DispatchKind::kSocket:
+        return "Socket";
+    case DispatchKind::kLoopHandler:
+        return "LoopHandler";
+    case DispatchKind::kWork:
+        return "Work";
+    case DispatchKind::kLambda:
+        return "Lambda";
+    case DispatchKind::kDeviceEvent:
+        return "DeviceEvent";
+    default:
+        return "Unknown";
+    }
+}
+
+} // namespace System
+} // namespace chip
+
+#endif // CHIP_SYSTEM_CONFIG_EVENT_LOOP_PROFILER
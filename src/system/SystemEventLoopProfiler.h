@@ -0,0 +1,213 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ * @file
+ *  This file declares a profiler measuring the callbacks dispatched by
+ *  the event loop of the CHIP platform thread.
+ */
+
+#pragma once
+
+// Include configuration headers
+#include <system/SystemConfig.h>
+
+#if CHIP_SYSTEM_CONFIG_EVENT_LOOP_PROFILER
+
+// Include dependent headers
+#include <lib/support/DLLUtil.h>
+#include <system/SystemClock.h>
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+#include <pthread.h>
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace chip {
+namespace System {
+
+/**
+ * Measures every callback dispatched by the event loop, so that stalls of the
+ * loop (which delay every other session) can be attributed to their origin.
+ *
+ * For each kind of dispatch, the profiler keeps the number of dispatches, the
+ * time spent in them and a histogram of the loop lag, i.e. how late a timer
+ * fired relative to its expiration time. It also retains the slowest
+ * dispatches, each with the address of the dispatched callback and the stack
+ * of trace labels (see PushLabel()) that were open at the deepest point of the
+ * dispatch.
+ *
+ * Nested dispatches (e.g. a device event dispatched synchronously from a timer)
+ * are accounted to the outermost one.
+ *
+ * THREAD SAFETY:
+ *   Dispatches are recorded by the thread running the event loop, and queries
+ *   must be made with the CHIP stack lock held. With POSIX locking, labels
+ *   pushed from any other thread are ignored.
+ */
+class DLL_EXPORT EventLoopProfiler
+{
+public:
+    enum class DispatchKind : uint8_t
+    {
+        kTimer,       ///< System layer timer, including System::Layer::ScheduleWork().
+        kSocket,      ///< Socket watch callback.
+        kLoopHandler, ///< Event loop handler.
+        kWork,        ///< PlatformManager::ScheduleWork() function.
+        kLambda,      ///< PlatformManager::ScheduleLambda() or System::Layer::ScheduleLambda() lambda.
+        kDeviceEvent, ///< Any other device layer event.
+
+        kCount
+    };
+
+    static constexpr size_t kKindCount      = static_cast<size_t>(DispatchKind::kCount);
+    static constexpr size_t kSlowestCount   = CHIP_SYSTEM_CONFIG_EVENT_LOOP_PROFILER_SLOWEST_COUNT;
+    static constexpr size_t kMaxLabelDepth  = CHIP_SYSTEM_CONFIG_EVENT_LOOP_PROFILER_MAX_LABEL_DEPTH;
+    static constexpr size_t kLagBucketCount = 16;
+
+    struct DispatchRecord
+    {
+        DispatchKind kind;
+        uintptr_t origin; ///< Address of the callback or loop handler, or the event type for kDeviceEvent.
+        Clock::Timestamp start;
+        Clock::Microseconds32 duration;
+        uint8_t labelCount;
+        const char * labels[kMaxLabelDepth]; ///< Outermost label first.
+    };
+
+    struct KindStats
+    {
+        uint32_t count;
+        Clock::Microseconds64 totalTime;
+        Clock::Microseconds32 maxDuration;
+        uint32_t lagHistogram[kLagBucketCount]; ///< See GetLagBucketLimit().
+    };
+
+    /**
+     * Measures the dispatch of a callback for the lifetime of the object.
+     */
+    class Dispatch
+    {
+    public:
+        Dispatch(DispatchKind kind, uintptr_t origin) : mActive(GetInstance().BeginDispatch(kind, origin, nullptr)) {}
+        Dispatch(DispatchKind kind, uintptr_t origin, Clock::Timestamp dueTime) :
+            mActive(GetInstance().BeginDispatch(kind, origin, &dueTime))
+        {}
+        ~Dispatch()
+        {
+            if (mActive)
+            {
+                GetInstance().EndDispatch();
+            }
+        }
+
+        Dispatch(const Dispatch &)             = delete;
+        Dispatch & operator=(const Dispatch &) = delete;
+
+    private:
+        const bool mActive;
+    };
+
+    static EventLoopProfiler & GetInstance();
+
+    template <typename Function>
+    static uintptr_t OriginOf(Function * function)
+    {
+        return reinterpret_cast<uintptr_t>(function);
+    }
+
+    void SetEnabled(bool enabled) { mEnabled = enabled; }
+    bool IsEnabled() const { return mEnabled; }
+
+    /**
+     * Clear all recorded dispatches.
+     */
+    void Reset();
+
+    /**
+     * Open a trace label attributed to the dispatch in progress, if any.
+     *
+     * @p label must remain valid until the profiler is reset; trace labels are
+     * string literals.
+     */
+    void PushLabel(const char * label);
+
+    /**
+     * Close the trace label most recently opened with @p label, and all the
+     * labels opened after it.
+     */
+    void PopLabel(const char * label);
+
+    const KindStats & GetStats(DispatchKind kind) const { return mStats[static_cast<size_t>(kind)]; }
+
+    /**
+     * Copy up to @p maxRecords of the slowest dispatches to @p records, slowest
+     * first, and return the number of records copied.
+     */
+    size_t GetSlowestDispatches(DispatchRecord * records, size_t maxRecords) const;
+
+    /**
+     * Return the exclusive upper bound of a lag histogram bucket. Bucket 0 counts
+     * lags below 1 ms and bucket i counts lags in [2^(i-1), 2^i) ms, except for
+     * the last bucket, which counts all larger lags.
+     */
+    static Clock::Milliseconds32 GetLagBucketLimit(size_t bucket);
+
+    static const char * KindToString(DispatchKind kind);
+
+private:
+    bool BeginDispatch(DispatchKind kind, uintptr_t origin, const Clock::Timestamp * dueTime);
+    void EndDispatch();
+    bool IsDispatchThread() const;
+    void RecordSlowDispatch();
+
+    KindStats mStats[kKindCount]             = {};
+    DispatchRecord mSlowest[kSlowestCount]   = {};
+    size_t mSlowestCount                     = 0;
+    DispatchRecord mCurrent                  = {};
+    Clock::Microseconds64 mCurrentStart      = Clock::kZero;
+    const char * mLabelStack[kMaxLabelDepth] = {};
+    size_t mLabelDepth                       = 0;
+    unsigned mDispatchDepth                  = 0;
+    bool mEnabled                            = true;
+    std::atomic<bool> mDispatching{ false };
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    pthread_t mDispatchThread = {};
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+};
+
+} // namespace System
+} // namespace chip
+
+#define SYSTEM_PROFILE_DISPATCH(kind, origin)                                                                                      \
+    ::chip::System::EventLoopProfiler::Dispatch _systemProfiledDispatch(::chip::System::EventLoopProfiler::DispatchKind::kind,     \
+                                                                        (origin))
+
+#define SYSTEM_PROFILE_TIMER_DISPATCH(origin, dueTime)                                                                             \
+    ::chip::System::EventLoopProfiler::Dispatch _systemProfiledDispatch(::chip::System::EventLoopProfiler::DispatchKind::kTimer,   \
+                                                                        (origin), (dueTime))
+
+#else // CHIP_SYSTEM_CONFIG_EVENT_LOOP_PROFILER
+
+#define SYSTEM_PROFILE_DISPATCH(kind, origin)
+
+#define SYSTEM_PROFILE_TIMER_DISPATCH(origin, dueTime)
+
+#endif // CHIP_SYSTEM_CONFIG_EVENT_LOOP_PROFILER
@@ -24,6 +24,7 @@
 #include <lib/support/CodeUtils.h>
 #include <platform/LockTracker.h>
 #include <system/PlatformEventSupport.h>
+#include <system/SystemEventLoopProfiler.h>
 #include <system/SystemFaultInjection.h>
 #include <system/SystemLayer.h>
 #include <system/SystemLayerImplFreeRTOS.h>
@@ -191,7 +192,10 @@ CHIP_ERROR LayerImplFreeRTOS::HandlePlatformTimer()
     while ((timersHandled < CHIP_SYSTEM_CONFIG_NUM_TIMERS) && ((timer = mTimerList.PopIfEarlier(expirationTime)) != nullptr))
     {
         mHandlingTimerComplete = true;
-        mTimerPool.Invoke(timer);
+        {
+            SYSTEM_PROFILE_TIMER_DISPATCH(EventLoopProfiler::OriginOf(timer->GetCallback().GetOnComplete()), timer->AwakenTime());
+            mTimerPool.Invoke(timer);
+        }
         mHandlingTimerComplete = false;
         timersHandled++;
     }
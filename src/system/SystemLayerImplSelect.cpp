@@ -24,6 +24,7 @@
 #include <lib/support/CodeUtils.h>
 #include <lib/support/TimeUtils.h>
 #include <platform/LockTracker.h>
+#include <system/SystemEventLoopProfiler.h>
 #include <system/SystemFaultInjection.h>
 #include <system/SystemLayer.h>
 #include <system/SystemLayerImplSelect.h>
@@ -740,6 +741,7 @@ void LayerImplSelect::HandleEvents()
     TimerList::Node * timer = nullptr;
     while ((timer = mExpiredTimers.PopEarliest()) != nullptr)
     {
+        SYSTEM_PROFILE_TIMER_DISPATCH(EventLoopProfiler::OriginOf(timer->GetCallback().GetOnComplete()), timer->AwakenTime());
         mTimerPool.Invoke(timer);
     }
 
@@ -753,6 +755,7 @@ void LayerImplSelect::HandleEvents()
                 SocketEvents events = SocketEventsFromFDs(w.mFD, mSelected.mReadSet, mSelected.mWriteSet, mSelected.mErrorSet);
                 if (events.HasAny())
                 {
+                    SYSTEM_PROFILE_DISPATCH(kSocket, EventLoopProfiler::OriginOf(w.mCallback));
                     w.mCallback(events, w.mCallbackData);
                 }
             }
@@ -767,6 +770,7 @@ void LayerImplSelect::HandleEvents()
         auto & loop = *loopIter++; // advance before calling out, in case a list modification clobbers the `next` pointer
         if (LoopHandlerState(loop) == kLoopHandlerActive)
         {
+            SYSTEM_PROFILE_DISPATCH(kLoopHandler, reinterpret_cast<uintptr_t>(&loop));
             loop.HandleEvents();
         }
     }
@@ -781,6 +785,7 @@ void LayerImplSelect::HandleEvents()
 
 void LayerImplSelect::HandleTimerComplete(TimerList::Node * timer)
 {
+    SYSTEM_PROFILE_TIMER_DISPATCH(EventLoopProfiler::OriginOf(timer->GetCallback().GetOnComplete()), timer->AwakenTime());
     mTimerList.Remove(timer);
     mTimerPool.Invoke(timer);
 }
@@ -793,6 +798,7 @@ void LayerImplSelect::HandleLibEvTimer(EV_P_ struct ev_timer * t, int revents)
     VerifyOrDie(timer != nullptr);
     LayerImplSelect * layerP = dynamic_cast<LayerImplSelect *>(timer->mCallback.mSystemLayer);
     VerifyOrDie(layerP != nullptr);
+    SYSTEM_PROFILE_TIMER_DISPATCH(EventLoopProfiler::OriginOf(timer->GetCallback().GetOnComplete()), timer->AwakenTime());
     layerP->mTimerList.Remove(timer);
     layerP->mTimerPool.Invoke(timer);
 }
@@ -813,6 +819,7 @@ void LayerImplSelect::HandleLibEvIoWatcher(EV_P_ struct ev_io * i, int revents)
         }
         if (events.HasAny())
         {
+            SYSTEM_PROFILE_DISPATCH(kSocket, EventLoopProfiler::OriginOf(watch->mCallback));
             watch->mCallback(events, watch->mCallbackData);
         }
     }
@@ -0,0 +1,206 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <pw_unit_test/framework.h>
+
+#include <lib/support/CodeUtils.h>
+#include <system/SystemClock.h>
+#include <system/SystemEventLoopProfiler.h>
+
+#include <string.h>
+
+using namespace chip::System;
+
+namespace {
+
+using DispatchKind   = EventLoopProfiler::DispatchKind;
+using DispatchRecord = EventLoopProfiler::DispatchRecord;
+
+void TimerCallback(void *) {}
+
+class TestSystemEventLoopProfiler : public ::testing::Test
+{
+public:
+    void SetUp() override
+    {
+        mRealClock = &SystemClock();
+        Clock::Internal::SetSystemClockForTesting(&mMockClock);
+        mMockClock.SetMonotonic(Clock::Seconds64(100000));
+
+        EventLoopProfiler::GetInstance().SetEnabled(true);
+        EventLoopProfiler::GetInstance().Reset();
+    }
+
+    void TearDown() override { Clock::Internal::SetSystemClockForTesting(mRealClock); }
+
+    void Dispatch(DispatchKind kind, uintptr_t origin, Clock::Microseconds64 duration)
+    {
+        EventLoopProfiler::Dispatch dispatch(kind, origin);
+        mMockClock.mSystemTime += duration;
+    }
+
+    Clock::Internal::MockClock mMockClock;
+    Clock::ClockBase * mRealClock;
+};
+
+TEST_F(TestSystemEventLoopProfiler, TestDispatchStats)
+{
+    EventLoopProfiler & profiler = EventLoopProfiler::GetInstance();
+
+    Dispatch(DispatchKind::kSocket, 0x1000, Clock::Microseconds64(250));
+    Dispatch(DispatchKind::kSocket, 0x1000, Clock::Microseconds64(750));
+    Dispatch(DispatchKind::kWork, 0x2000, Clock::Microseconds64(100));
+
+    const EventLoopProfiler::KindStats & socketStats = profiler.GetStats(DispatchKind::kSocket);
+    EXPECT_EQ(socketStats.count, 2u);
+    EXPECT_EQ(socketStats.totalTime, Clock::Microseconds64(1000));
+    EXPECT_EQ(socketStats.maxDuration, Clock::Microseconds32(750));
+
+    EXPECT_EQ(profiler.GetStats(DispatchKind::kWork).count, 1u);
+    EXPECT_EQ(profiler.GetStats(DispatchKind::kTimer).count, 0u);
+
+    profiler.Reset();
+    EXPECT_EQ(profiler.GetStats(DispatchKind::kSocket).count, 0u);
+
+    DispatchRecord records[EventLoopProfiler::kSlowestCount];
+    EXPECT_EQ(profiler.GetSlowestDispatches(records, ArraySize(records)), 0u);
+}
+
+TEST_F(TestSystemEventLoopProfiler, TestTimerLag)
+{
+    EventLoopProfiler & profiler = EventLoopProfiler::GetInstance();
+    Clock::Timestamp now         = SystemClock().GetMonotonicTimestamp();
+    uintptr_t origin             = EventLoopProfiler::OriginOf(&TimerCallback);
+
+    {
+        // Timers may be dispatched before their expiration time.
+        EventLoopProfiler::Dispatch dispatch(DispatchKind::kTimer, origin, now + Clock::Milliseconds64(1));
+    }
+    {
+        EventLoopProfiler::Dispatch dispatch(DispatchKind::kTimer, origin, now - Clock::Milliseconds64(3));
+    }
+    {
+        EventLoopProfiler::Dispatch dispatch(DispatchKind::kTimer, origin, now - Clock::Seconds64(3600));
+    }
+
+    const EventLoopProfiler::KindStats & stats = profiler.GetStats(DispatchKind::kTimer);
+    EXPECT_EQ(stats.count, 3u);
+    EXPECT_EQ(stats.lagHistogram[0], 1u);
+    EXPECT_EQ(stats.lagHistogram[2], 1u);
+    EXPECT_EQ(stats.lagHistogram[EventLoopProfiler::kLagBucketCount - 1], 1u);
+
+    EXPECT_EQ(EventLoopProfiler::GetLagBucketLimit(0), Clock::Milliseconds32(1));
+    EXPECT_EQ(EventLoopProfiler::GetLagBucketLimit(2), Clock::Milliseconds32(4));
+}
+
+TEST_F(TestSystemEventLoopProfiler, TestSlowestDispatches)
+{
+    EventLoopProfiler & profiler = EventLoopProfiler::GetInstance();
+
+    // Durations 1..N+2 ms, dispatched in an order that forces evictions.
+    constexpr size_t kDispatchCount = EventLoopProfiler::kSlowestCount + 2;
+    for (size_t i = 0; i < kDispatchCount; i++)
+    {
+        size_t millis = (i % 2 == 0) ? (i / 2 + 1) : (kDispatchCount - i / 2);
+        Dispatch(DispatchKind::kLambda, 0x100 + millis, Clock::Milliseconds64(millis));
+    }
+
+    DispatchRecord records[EventLoopProfiler::kSlowestCount + 1];
+    size_t count = profiler.GetSlowestDispatches(records, ArraySize(records));
+    ASSERT_EQ(count, EventLoopProfiler::kSlowestCount);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        uint32_t expectedMillis = static_cast<uint32_t>(kDispatchCount - i);
+        EXPECT_EQ(records[i].kind, DispatchKind::kLambda);
+        EXPECT_EQ(records[i].duration, Clock::Microseconds32(expectedMillis * 1000));
+        EXPECT_EQ(records[i].origin, 0x100 + expectedMillis);
+    }
+
+    EXPECT_EQ(profiler.GetSlowestDispatches(records, 1), 1u);
+    EXPECT_EQ(records[0].duration, Clock::Microseconds32(kDispatchCount * 1000));
+}
+
+TEST_F(TestSystemEventLoopProfiler, TestNestedDispatch)
+{
+    EventLoopProfiler & profiler = EventLoopProfiler::GetInstance();
+
+    {
+        EventLoopProfiler::Dispatch outer(DispatchKind::kTimer, 0x1000);
+        mMockClock.AdvanceMonotonic(Clock::Milliseconds64(1));
+        Dispatch(DispatchKind::kDeviceEvent, 0x8000, Clock::Milliseconds64(2));
+    }
+
+    EXPECT_EQ(profiler.GetStats(DispatchKind::kTimer).count, 1u);
+    EXPECT_EQ(profiler.GetStats(DispatchKind::kTimer).totalTime, Clock::Microseconds64(3000));
+    EXPECT_EQ(profiler.GetStats(DispatchKind::kDeviceEvent).count, 0u);
+}
+
+TEST_F(TestSystemEventLoopProfiler, TestLabels)
+{
+    EventLoopProfiler & profiler = EventLoopProfiler::GetInstance();
+
+    // Labels outside of a dispatch are ignored.
+    profiler.PushLabel("Idle");
+
+    {
+        EventLoopProfiler::Dispatch dispatch(DispatchKind::kSocket, 0x1000);
+        profiler.PushLabel("Receive");
+        profiler.PushLabel("Decrypt");
+        profiler.PopLabel("Decrypt");
+        profiler.PushLabel("Handle");
+        profiler.PushLabel("Invoke");
+        profiler.PushLabel("Write");
+        profiler.PopLabel("Write");
+        profiler.PopLabel("Invoke");
+        // Closes "Handle" too, which was left open.
+        profiler.PopLabel("Receive");
+        profiler.PopLabel("Idle");
+        mMockClock.AdvanceMonotonic(Clock::Milliseconds64(1));
+    }
+
+    profiler.PopLabel("Idle");
+
+    DispatchRecord record;
+    ASSERT_EQ(profiler.GetSlowestDispatches(&record, 1), 1u);
+    ASSERT_EQ(record.labelCount, 4u);
+    EXPECT_STREQ(record.labels[0], "Receive");
+    EXPECT_STREQ(record.labels[1], "Handle");
+    EXPECT_STREQ(record.labels[2], "Invoke");
+    EXPECT_STREQ(record.labels[3], "Write");
+
+    // Labels of a previous dispatch do not leak into the next one.
+    profiler.Reset();
+    Dispatch(DispatchKind::kSocket, 0x1000, Clock::Milliseconds64(1));
+    ASSERT_EQ(profiler.GetSlowestDispatches(&record, 1), 1u);
+    EXPECT_EQ(record.labelCount, 0u);
+}
+
+TEST_F(TestSystemEventLoopProfiler, TestDisabled)
+{
+    EventLoopProfiler & profiler = EventLoopProfiler::GetInstance();
+
+    profiler.SetEnabled(false);
+    Dispatch(DispatchKind::kSocket, 0x1000, Clock::Milliseconds64(1));
+    EXPECT_EQ(profiler.GetStats(DispatchKind::kSocket).count, 0u);
+
+    profiler.SetEnabled(true);
+    Dispatch(DispatchKind::kSocket, 0x1000, Clock::Milliseconds64(1));
+    EXPECT_EQ(profiler.GetStats(DispatchKind::kSocket).count, 1u);
+}
+
+} // namespace
@@ -0,0 +1,75 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace chip {
+namespace Tracing {
+namespace Binary {
+
+/// On-disk layout of traces written by BinaryBackend.
+///
+/// A file starts with a kFileHeaderSize header, followed by kRecordSize
+/// records. All integers are little-endian.
+///
+/// File header:
+///    char     magic[8]         // kFileMagic
+///    uint32_t version          // kFormatVersion
+///    uint32_t reserved
+///    uint64_t baseTimestampNs  // steady clock, when the file was opened
+///
+/// Event records:
+///    uint8_t  type           // RecordType, anything but kString
+///    uint8_t  thread         // index of the emitting thread, stable for its lifetime
+///    uint8_t  valueType      // MetricEvent::Value::Type for metric events, 0 otherwise
+///    uint8_t  reserved
+///    uint32_t label          // string id
+///    uint32_t group          // string id, 0 if none
+///    uint32_t value          // metric value or dropped event count
+///    uint64_t timestampNs    // steady clock
+///
+/// String records define a string id before its first use:
+///    uint8_t  type           // RecordType::kString
+///    uint8_t  reserved
+///    uint16_t length
+///    uint32_t id
+///    uint8_t  reserved[16]
+///    char     value[length]  // not NUL terminated, immediately follows the record
+inline constexpr char kFileMagic[8]      = { 'M', 'T', 'R', 'B', 'T', 'R', 'C', '\0' };
+inline constexpr uint32_t kFormatVersion = 2;
+inline constexpr size_t kFileHeaderSize  = 24;
+inline constexpr size_t kRecordSize      = 24;
+
+enum class RecordType : uint8_t
+{
+    kString        = 0,
+    kBegin         = 1,
+    kEnd           = 2,
+    kInstant       = 3,
+    kCounter       = 4, // increments the counter named by label by one
+    kMetricBegin   = 5,
+    kMetricEnd     = 6,
+    kMetricInstant = 7,
+    kDropped       = 8, // value events of this thread were lost to a full ring buffer
+};
+
+} // namespace Binary
+} // namespace Tracing
+} // namespace chip
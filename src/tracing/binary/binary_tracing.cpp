@@ -0,0 +1,368 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <tracing/binary/binary_tracing.h>
+
+#include <lib/support/BufferWriter.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <tracing/metric_event.h>
+
+#include <chrono>
+#include <cstring>
+
+namespace chip {
+namespace Tracing {
+namespace Binary {
+
+namespace {
+
+/// Number of threads that may trace concurrently. Threads beyond this have
+/// their events dropped.
+constexpr size_t kMaxThreads = 32;
+
+/// Events buffered per thread between drains. Must be a power of two.
+constexpr uint32_t kRingEntries = 4096;
+static_assert((kRingEntries & (kRingEntries - 1)) == 0, "ring size must be a power of two");
+
+constexpr auto kDrainInterval = std::chrono::milliseconds(20);
+
+struct RingEntry
+{
+    uint64_t timestampNs;
+    const char * label;
+    const char * group;
+    uint32_t value;
+    RecordType type;
+    uint8_t valueType;
+};
+
+/// Single-producer single-consumer ring. The producer is the thread that
+/// currently owns it, the consumer is the drain thread.
+class ThreadRing
+{
+public:
+    void Push(const RingEntry & entry)
+    {
+        const uint32_t head = mHead.load(std::memory_order_relaxed);
+        if (head - mTail.load(std::memory_order_acquire) >= kRingEntries)
+        {
+            mDropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        mEntries[head & (kRingEntries - 1)] = entry;
+        mHead.store(head + 1, std::memory_order_release);
+    }
+
+    template <typename F>
+    void Drain(F && consume)
+    {
+        uint32_t tail       = mTail.load(std::memory_order_relaxed);
+        const uint32_t head = mHead.load(std::memory_order_acquire);
+        for (; tail != head; tail++)
+        {
+            consume(mEntries[tail & (kRingEntries - 1)]);
+        }
+        mTail.store(tail, std::memory_order_release);
+    }
+
+    uint32_t TakeDroppedCount() { return mDropped.exchange(0, std::memory_order_relaxed); }
+
+    std::atomic<bool> mOwned{ false };
+
+private:
+    alignas(64) std::atomic<uint32_t> mHead{ 0 };
+    alignas(64) std::atomic<uint32_t> mTail{ 0 };
+    std::atomic<uint32_t> mDropped{ 0 };
+    RingEntry mEntries[kRingEntries];
+};
+
+// Rings are allocated the first time a thread traces and are never freed, so
+// that exiting threads and closing backends can not race with each other.
+// A ring released by an exiting thread is reused by the next new thread.
+std::atomic<ThreadRing *> gRings[kMaxThreads];
+std::atomic<bool> gBackendOpen{ false };
+
+struct ThreadRingHandle
+{
+    ~ThreadRingHandle()
+    {
+        if (ring != nullptr)
+        {
+            ring->mOwned.store(false, std::memory_order_release);
+        }
+    }
+
+    ThreadRing * ring = nullptr;
+    uint8_t index     = 0;
+    bool exhausted    = false;
+};
+
+thread_local ThreadRingHandle gThreadRing;
+
+ThreadRing * ClaimRing(uint8_t & index)
+{
+    for (size_t i = 0; i < kMaxThreads; i++)
+    {
+        ThreadRing * ring = gRings[i].load(std::memory_order_acquire);
+        if (ring == nullptr)
+        {
+            ThreadRing * newRing = new ThreadRing();
+            newRing->mOwned.store(true, std::memory_order_relaxed);
+            if (gRings[i].compare_exchange_strong(ring, newRing, std::memory_order_acq_rel))
+            {
+                index = static_cast<uint8_t>(i);
+                return newRing;
+            }
+            delete newRing;
+            // Lost the race; `ring` now holds the winner, which is owned.
+            continue;
+        }
+
+        bool owned = false;
+        if (ring->mOwned.compare_exchange_strong(owned, true, std::memory_order_acquire))
+        {
+            index = static_cast<uint8_t>(i);
+            return ring;
+        }
+    }
+    return nullptr;
+}
+
+inline void Record(RecordType type, const char * label, const char * group, uint32_t value = 0, uint8_t valueType = 0)
+{
+    ThreadRingHandle & handle = gThreadRing;
+    if (handle.ring == nullptr)
+    {
+        VerifyOrReturn(!handle.exhausted);
+        handle.ring      = ClaimRing(handle.index);
+        handle.exhausted = (handle.ring == nullptr);
+        VerifyOrReturn(!handle.exhausted);
+    }
+
+    const uint64_t now = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+    handle.ring->Push(RingEntry{ now, label, group, value, type, valueType });
+}
+
+} // namespace
+
+CHIP_ERROR BinaryBackend::OpenFile(const char * path)
+{
+    VerifyOrReturnError(mFile == nullptr, CHIP_ERROR_INCORRECT_STATE);
+
+    bool expected = false;
+    VerifyOrReturnError(gBackendOpen.compare_exchange_strong(expected, true), CHIP_ERROR_INCORRECT_STATE);
+
+    mFile = fopen(path, "wb");
+    if (mFile == nullptr)
+    {
+        gBackendOpen.store(false);
+        return CHIP_ERROR_OPEN_FAILED;
+    }
+
+    // Every event recorded from now on is at least as recent as the base timestamp.
+    const uint64_t baseTimestampNs = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+
+    uint8_t header[kFileHeaderSize];
+    Encoding::LittleEndian::BufferWriter writer(header, sizeof(header));
+    writer.Put(kFileMagic, sizeof(kFileMagic)).Put32(kFormatVersion).Put32(0).Put64(baseTimestampNs);
+    if (fwrite(header, 1, sizeof(header), mFile) != sizeof(header))
+    {
+        fclose(mFile);
+        mFile = nullptr;
+        gBackendOpen.store(false);
+        return CHIP_ERROR_WRITE_FAILED;
+    }
+
+    // Discard whatever a previous session left behind.
+    for (auto & slot : gRings)
+    {
+        ThreadRing * ring = slot.load(std::memory_order_acquire);
+        if (ring != nullptr)
+        {
+            ring->Drain([](const RingEntry &) {});
+            ring->TakeDroppedCount();
+        }
+    }
+
+    mStringIds.clear();
+    mNextStringId = 1;
+    mStopDraining = false;
+    mDrainThread  = std::thread(&BinaryBackend::DrainLoop, this);
+    return CHIP_NO_ERROR;
+}
+
+void BinaryBackend::CloseFile()
+{
+    VerifyOrReturn(mFile != nullptr);
+
+    {
+        std::lock_guard<std::mutex> lock(mDrainMutex);
+        mStopDraining = true;
+    }
+    mDrainWakeup.notify_one();
+    mDrainThread.join();
+
+    DrainRings();
+    fclose(mFile);
+    mFile = nullptr;
+    gBackendOpen.store(false);
+}
+
+void BinaryBackend::TraceBegin(const char * label, const char * group)
+{
+    Record(RecordType::kBegin, label, group);
+}
+
+void BinaryBackend::TraceEnd(const char * label, const char * group)
+{
+    Record(RecordType::kEnd, label, group);
+}
+
+void BinaryBackend::TraceInstant(const char * label, const char * group)
+{
+    Record(RecordType::kInstant, label, group);
+}
+
+void BinaryBackend::TraceCounter(const char * label)
+{
+    Record(RecordType::kCounter, label, nullptr);
+}
+
+void BinaryBackend::LogMetricEvent(const MetricEvent & event)
+{
+    RecordType type = RecordType::kMetricInstant;
+    switch (event.type())
+    {
+    case MetricEvent::Type::kBeginEvent:
+        type = RecordType::kMetricBegin;
+        break;
+    case MetricEvent::Type::kEndEvent:
+        type = RecordType::kMetricEnd;
+        break;
+    case MetricEvent::Type::kInstantEvent:
+        type = RecordType::kMetricInstant;
+        break;
+    }
+
+    using ValueType = MetricEvent::Value::Type;
+    uint32_t value  = 0;
+    switch (event.ValueType())
+    {
+    case ValueType::kInt32:
+        value = static_cast<uint32_t>(event.ValueInt32());
+        break;
+    case ValueType::kUInt32:
+        value = event.ValueUInt32();
+        break;
+    case ValueType::kChipErrorCode:
+        value = event.ValueErrorCode();
+        break;
+    case ValueType::kUndefined:
+        break;
+    }
+
+    Record(type, event.key(), "Metric", value, to_underlying(event.ValueType()));
+}
+
+void BinaryBackend::DrainLoop()
+{
+    std::unique_lock<std::mutex> lock(mDrainMutex);
+    while (!mStopDraining)
+    {
+        mDrainWakeup.wait_for(lock, kDrainInterval);
+        lock.unlock();
+        DrainRings();
+        lock.lock();
+    }
+}
+
+void BinaryBackend::DrainRings()
+{
+    for (size_t i = 0; i < kMaxThreads; i++)
+    {
+        ThreadRing * ring = gRings[i].load(std::memory_order_acquire);
+        if (ring == nullptr)
+        {
+            continue;
+        }
+
+        const uint8_t thread = static_cast<uint8_t>(i);
+        ring->Drain([this, thread](const RingEntry & entry) {
+            WriteEvent(entry.type, thread, entry.valueType, entry.label, entry.group, entry.value, entry.timestampNs);
+        });
+
+        const uint32_t dropped = ring->TakeDroppedCount();
+        if (dropped > 0)
+        {
+            const uint64_t now = static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+            WriteEvent(RecordType::kDropped, thread, 0, "Dropped events", "Tracing", dropped, now);
+        }
+    }
+
+    fflush(mFile);
+}
+
+void BinaryBackend::WriteEvent(RecordType type, uint8_t thread, uint8_t valueType, const char * label, const char * group,
+                               uint32_t value, uint64_t timestampNs)
+{
+    const uint32_t labelId = GetStringId(label);
+    const uint32_t groupId = GetStringId(group);
+
+    uint8_t record[kRecordSize];
+    Encoding::LittleEndian::BufferWriter writer(record, sizeof(record));
+    writer.Put8(to_underlying(type))
+        .Put8(thread)
+        .Put8(valueType)
+        .Put8(0)
+        .Put32(labelId)
+        .Put32(groupId)
+        .Put32(value)
+        .Put64(timestampNs);
+    fwrite(record, 1, sizeof(record), mFile);
+}
+
+uint32_t BinaryBackend::GetStringId(const char * value)
+{
+    VerifyOrReturnValue(value != nullptr, 0);
+
+    auto it = mStringIds.find(value);
+    if (it != mStringIds.end())
+    {
+        return it->second;
+    }
+
+    const uint32_t id = mNextStringId++;
+    mStringIds.emplace(value, id);
+
+    const size_t length         = std::min<size_t>(strlen(value), UINT16_MAX);
+    uint8_t record[kRecordSize] = {};
+    Encoding::LittleEndian::BufferWriter writer(record, sizeof(record));
+    writer.Put8(to_underlying(RecordType::kString)).Put8(0).Put16(static_cast<uint16_t>(length)).Put32(id);
+    fwrite(record, 1, sizeof(record), mFile);
+    fwrite(value, 1, length, mFile);
+
+    return id;
+}
+
+} // namespace Binary
+} // namespace Tracing
+} // namespace chip
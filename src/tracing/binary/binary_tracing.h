@@ -0,0 +1,96 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#pragma once
+
+#include <lib/core/CHIPError.h>
+#include <tracing/backend.h>
+#include <tracing/binary/binary_trace_format.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+namespace chip {
+namespace Tracing {
+namespace Binary {
+
+/// A Backend that records fixed-size binary events with as little overhead
+/// as possible, for measuring timings that the json backend would distort.
+///
+/// Each tracing thread owns a lock-free single-producer ring buffer: the
+/// tracing calls only take a timestamp and copy a record into it. A
+/// background thread periodically drains all rings into the output file,
+/// where labels are written once and referenced by id afterwards. Use the
+/// chip-binary-trace-converter tool to turn the file into Chrome trace JSON,
+/// which both chrome://tracing and ui.perfetto.dev can load.
+///
+/// When a ring is full, new events of that thread are dropped and reported
+/// as a kDropped record on the next drain, rather than blocking the caller.
+///
+/// Labels and groups MUST be string literals (as for all tracing backends):
+/// only their address is recorded on the hot path.
+///
+/// As this uses std::thread, this library is NOT for use on embedded devices.
+/// Only one BinaryBackend may have a file open at any time since the ring
+/// buffers are shared by the whole process.
+class BinaryBackend : public ::chip::Tracing::Backend
+{
+public:
+    BinaryBackend() = default;
+    ~BinaryBackend() override { CloseFile(); }
+
+    /// Start writing events to the given file and start the drain thread.
+    CHIP_ERROR OpenFile(const char * path);
+
+    /// Drain any pending events, stop the drain thread and close the file.
+    void CloseFile();
+
+    bool IsOpen() const { return mFile != nullptr; }
+
+    void TraceBegin(const char * label, const char * group) override;
+    void TraceEnd(const char * label, const char * group) override;
+    void TraceInstant(const char * label, const char * group) override;
+    void TraceCounter(const char * label) override;
+    void LogMetricEvent(const MetricEvent & event) override;
+    void Close() override { CloseFile(); }
+
+private:
+    void DrainLoop();
+    void DrainRings();
+    void WriteEvent(RecordType type, uint8_t thread, uint8_t valueType, const char * label, const char * group, uint32_t value,
+                    uint64_t timestampNs);
+    uint32_t GetStringId(const char * value);
+
+    FILE * mFile = nullptr;
+
+    std::thread mDrainThread;
+    std::mutex mDrainMutex;
+    std::condition_variable mDrainWakeup;
+    bool mStopDraining = false;
+
+    // Only accessed by the drain thread, or after it has been joined.
+    std::unordered_map<const char *, uint32_t> mStringIds;
+    uint32_t mNextStringId = 1;
+};
+
+} // namespace Binary
+} // namespace Tracing
+} // namespace chip
@@ -0,0 +1,254 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <tracing/binary/trace_converter.h>
+
+#include <lib/support/BufferReader.h>
+#include <lib/support/CodeUtils.h>
+#include <tracing/binary/binary_trace_format.h>
+#include <tracing/metric_event.h>
+
+#include <cinttypes>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace chip {
+namespace Tracing {
+namespace Binary {
+
+namespace {
+
+constexpr uint32_t kChromeTracePid = 1;
+
+void WriteJsonString(FILE * output, const std::string & value)
+{
+    fputc('"', output);
+    for (char c : value)
+    {
+        switch (c)
+        {
+        case '"':
+            fputs("\\\"", output);
+            break;
+        case '\\':
+            fputs("\\\\", output);
+            break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20)
+            {
+                fprintf(output, "\\u%04x", static_cast<unsigned>(c));
+            }
+            else
+            {
+                fputc(c, output);
+            }
+            break;
+        }
+    }
+    fputc('"', output);
+}
+
+class ChromeJsonWriter
+{
+public:
+    explicit ChromeJsonWriter(FILE * output) : mOutput(output) { fputs("{\"traceEvents\":[\n", mOutput); }
+
+    void Finish() { fputs("\n],\"displayTimeUnit\":\"ns\"}\n", mOutput); }
+
+    /// Starts an event object; the caller may append more members before calling EndEvent().
+    void BeginEvent(const std::string & name, const std::string & category, char phase, uint64_t timestampNs, uint8_t thread)
+    {
+        fputs(mFirst ? "" : ",\n", mOutput);
+        mFirst = false;
+
+        fputs("{\"name\":", mOutput);
+        WriteJsonString(mOutput, name);
+        if (!category.empty())
+        {
+            fputs(",\"cat\":", mOutput);
+            WriteJsonString(mOutput, category);
+        }
+        fprintf(mOutput, ",\"ph\":\"%c\",\"ts\":%" PRIu64 ".%03u,\"pid\":%u,\"tid\":%u", phase, timestampNs / 1000,
+                static_cast<unsigned>(timestampNs % 1000), static_cast<unsigned>(kChromeTracePid), static_cast<unsigned>(thread));
+    }
+
+    void EndEvent() { fputc('}', mOutput); }
+
+    FILE * Output() { return mOutput; }
+
+private:
+    FILE * mOutput;
+    bool mFirst = true;
+};
+
+void WriteMetricValue(FILE * output, uint8_t valueType, uint32_t value)
+{
+    using ValueType = MetricEvent::Value::Type;
+    switch (static_cast<ValueType>(valueType))
+    {
+    case ValueType::kInt32:
+        fprintf(output, ",\"args\":{\"value\":%" PRId32 "}", static_cast<int32_t>(value));
+        break;
+    case ValueType::kUInt32:
+        fprintf(output, ",\"args\":{\"value\":%" PRIu32 "}", value);
+        break;
+    case ValueType::kChipErrorCode:
+        fprintf(output, ",\"args\":{\"error\":\"0x%08" PRIx32 "\"}", value);
+        break;
+    default:
+        break;
+    }
+}
+
+} // namespace
+
+CHIP_ERROR ConvertToChromeJson(FILE * input, FILE * output)
+{
+    uint8_t header[kFileHeaderSize];
+    VerifyOrReturnError(fread(header, 1, sizeof(header), input) == sizeof(header), CHIP_ERROR_INVALID_FILE_IDENTIFIER);
+    VerifyOrReturnError(memcmp(header, kFileMagic, sizeof(kFileMagic)) == 0, CHIP_ERROR_INVALID_FILE_IDENTIFIER);
+
+    uint32_t version         = 0;
+    uint32_t headerReserved  = 0;
+    uint64_t baseTimestampNs = 0;
+    Encoding::LittleEndian::Reader headerReader(header + sizeof(kFileMagic), sizeof(header) - sizeof(kFileMagic));
+    ReturnErrorOnFailure(headerReader.Read32(&version).StatusCode());
+    VerifyOrReturnError(version == kFormatVersion, CHIP_ERROR_VERSION_MISMATCH);
+    ReturnErrorOnFailure(headerReader.Read32(&headerReserved).Read64(&baseTimestampNs).StatusCode());
+
+    std::unordered_map<uint32_t, std::string> strings;
+    std::unordered_map<uint32_t, uint64_t> counters;
+    std::vector<char> stringBuffer;
+
+    ChromeJsonWriter writer(output);
+
+    uint8_t record[kRecordSize];
+    size_t recordLength;
+    while ((recordLength = fread(record, 1, sizeof(record), input)) == sizeof(record))
+    {
+        uint8_t type;
+        uint8_t thread;
+        uint8_t valueType;
+        uint8_t reserved;
+        uint32_t label;
+        uint32_t group;
+        uint32_t value;
+        uint64_t timestampNs;
+
+        Encoding::LittleEndian::Reader reader(record, sizeof(record));
+        if (record[0] == to_underlying(RecordType::kString))
+        {
+            uint16_t length;
+            ReturnErrorOnFailure(reader.Read8(&type).Read8(&reserved).Read16(&length).Read32(&label).StatusCode());
+            stringBuffer.resize(length);
+            VerifyOrReturnError(fread(stringBuffer.data(), 1, length, input) == length, CHIP_ERROR_INVALID_MESSAGE_LENGTH);
+            strings[label].assign(stringBuffer.data(), length);
+            continue;
+        }
+
+        ReturnErrorOnFailure(reader.Read8(&type)
+                                 .Read8(&thread)
+                                 .Read8(&valueType)
+                                 .Read8(&reserved)
+                                 .Read32(&label)
+                                 .Read32(&group)
+                                 .Read32(&value)
+                                 .Read64(&timestampNs)
+                                 .StatusCode());
+
+        // Rings are drained one thread at a time, so records are only ordered per thread: timestamps are
+        // relative to the opening of the file rather than to the first record. An event racing the opening
+        // may still predate it, and is clamped rather than given a negative timestamp.
+        const uint64_t ts            = timestampNs > baseTimestampNs ? timestampNs - baseTimestampNs : 0;
+        const std::string & name     = strings[label];
+        const std::string & category = strings[group];
+
+        switch (static_cast<RecordType>(type))
+        {
+        case RecordType::kBegin:
+            writer.BeginEvent(name, category, 'B', ts, thread);
+            break;
+        case RecordType::kEnd:
+            writer.BeginEvent(name, category, 'E', ts, thread);
+            break;
+        case RecordType::kInstant:
+            writer.BeginEvent(name, category, 'i', ts, thread);
+            fputs(",\"s\":\"t\"", writer.Output());
+            break;
+        case RecordType::kCounter:
+            writer.BeginEvent(name, category, 'C', ts, thread);
+            fprintf(writer.Output(), ",\"args\":{\"value\":%" PRIu64 "}", ++counters[label]);
+            break;
+        case RecordType::kMetricBegin:
+            writer.BeginEvent(name, category, 'B', ts, thread);
+            WriteMetricValue(writer.Output(), valueType, value);
+            break;
+        case RecordType::kMetricEnd:
+            writer.BeginEvent(name, category, 'E', ts, thread);
+            WriteMetricValue(writer.Output(), valueType, value);
+            break;
+        case RecordType::kMetricInstant:
+            writer.BeginEvent(name, category, 'i', ts, thread);
+            fputs(",\"s\":\"t\"", writer.Output());
+            WriteMetricValue(writer.Output(), valueType, value);
+            break;
+        case RecordType::kDropped:
+            writer.BeginEvent(name, category, 'i', ts, thread);
+            fprintf(writer.Output(), ",\"s\":\"t\",\"args\":{\"count\":%" PRIu32 "}", value);
+            break;
+        default:
+            // Unknown record types from newer writers are skipped; their layout is fixed-size.
+            continue;
+        }
+        writer.EndEvent();
+    }
+
+    writer.Finish();
+
+    // A trailing partial record means the writer did not finish (e.g. crashed). The output is still
+    // well-formed JSON with everything before it, but report the truncation.
+    VerifyOrReturnError(recordLength == 0, CHIP_ERROR_INVALID_MESSAGE_LENGTH);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ConvertToChromeJson(const char * inputPath, const char * outputPath)
+{
+    FILE * input = fopen(inputPath, "rb");
+    VerifyOrReturnError(input != nullptr, CHIP_ERROR_OPEN_FAILED);
+
+    FILE * output = fopen(outputPath, "w");
+    if (output == nullptr)
+    {
+        fclose(input);
+        return CHIP_ERROR_OPEN_FAILED;
+    }
+
+    CHIP_ERROR err = ConvertToChromeJson(input, output);
+    fclose(input);
+    if (fclose(output) != 0 && err == CHIP_NO_ERROR)
+    {
+        err = CHIP_ERROR_WRITE_FAILED;
+    }
+    return err;
+}
+
+} // namespace Binary
+} // namespace Tracing
+} // namespace chip
@@ -0,0 +1,42 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#pragma once
+
+#include <lib/core/CHIPError.h>
+
+#include <cstdio>
+
+namespace chip {
+namespace Tracing {
+namespace Binary {
+
+/// Convert a trace written by BinaryBackend into Chrome trace event JSON
+/// (the "JSON Object Format"), loadable by chrome://tracing and
+/// ui.perfetto.dev.
+///
+/// Timestamps are relative to the opening of the trace file. Every emitting
+/// thread becomes a separate track; counters are reported with their running
+/// totals and metric values as event arguments.
+CHIP_ERROR ConvertToChromeJson(FILE * input, FILE * output);
+
+/// Convenience wrapper opening and closing the given files.
+CHIP_ERROR ConvertToChromeJson(const char * inputPath, const char * outputPath);
+
+} // namespace Binary
+} // namespace Tracing
+} // namespace chip
@@ -0,0 +1,42 @@
+/*
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#include <tracing/event_loop/event_loop_backend.h>
+
+#include <system/SystemEventLoopProfiler.h>
+
+namespace chip {
+namespace Tracing {
+namespace EventLoop {
+
+EventLoopBackend & EventLoopBackend::GetInstance()
+{
+    static EventLoopBackend sInstance;
+    return sInstance;
+}
+
+void EventLoopBackend::TraceBegin(const char * label, const char * group)
+{
+    System::EventLoopProfiler::GetInstance().PushLabel(label);
+}
+
+void EventLoopBackend::TraceEnd(const char * label, const char * group)
+{
+    System::EventLoopProfiler::GetInstance().PopLabel(label);
+}
+
+} // namespace EventLoop
+} // namespace Tracing
+} // namespace chip
@@ -0,0 +1,41 @@
+/*
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#pragma once
+
+#include <tracing/backend.h>
+
+namespace chip {
+namespace Tracing {
+namespace EventLoop {
+
+/// A Backend forwarding trace scopes to the System::EventLoopProfiler, so that
+/// the slowest event loop dispatches it reports carry the labels of the trace
+/// scopes they ran.
+///
+/// Scopes only reach backends when the tracing macros are routed to them,
+/// i.e. with the multiplexed tracing config.
+class EventLoopBackend : public ::chip::Tracing::Backend
+{
+public:
+    static EventLoopBackend & GetInstance();
+
+    void TraceBegin(const char * label, const char * group) override;
+    void TraceEnd(const char * label, const char * group) override;
+};
+
+} // namespace EventLoop
+} // namespace Tracing
+} // namespace chip
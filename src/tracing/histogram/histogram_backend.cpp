@@ -0,0 +1,290 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#include <tracing/histogram/histogram_backend.h>
+
+#include <lib/support/CodeUtils.h>
+#include <system/SystemClock.h>
+#include <tracing/metric_event.h>
+
+#include <string.h>
+
+namespace chip {
+namespace Tracing {
+namespace Histograms {
+namespace {
+
+// Readers spin this many times before giving up on a contended lock.
+constexpr unsigned kMaxLockAttempts = 1000;
+
+uint64_t NowMicroseconds()
+{
+    return System::SystemClock().GetMonotonicMicroseconds64().count();
+}
+
+bool NamesMatch(const char * a, const char * b)
+{
+    return (a == b) || (strcmp(a, b) == 0);
+}
+
+} // namespace
+
+HistogramBackend & HistogramBackend::GetInstance()
+{
+    static HistogramBackend sInstance;
+    return sInstance;
+}
+
+CHIP_ERROR HistogramBackend::Track(const char * name)
+{
+    VerifyOrReturnError(name != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    for (unsigned attempt = 0; attempt < kMaxLockAttempts; attempt++)
+    {
+        ScopedTryLock lock(mLock);
+        if (!lock.IsLocked())
+        {
+            continue;
+        }
+
+        VerifyOrReturnError(FindEntry(name) == nullptr, CHIP_NO_ERROR);
+
+        size_t count = mEntryCount.load(std::memory_order_relaxed);
+        VerifyOrReturnError(count < kMaxHistograms, CHIP_ERROR_NO_MEMORY);
+
+        mEntries[count].name = name;
+        mEntries[count].histogram.Reset();
+        mEntryCount.store(count + 1, std::memory_order_release);
+        return CHIP_NO_ERROR;
+    }
+    return CHIP_ERROR_BUSY;
+}
+
+CHIP_ERROR HistogramBackend::TrackDefaults()
+{
+    ReturnErrorOnFailure(Track(kMetricDeviceCASESession));
+    ReturnErrorOnFailure(Track(kMetricDeviceMRPRoundTrip));
+    ReturnErrorOnFailure(Track(kMetricDeviceInvokeHandling));
+    ReturnErrorOnFailure(Track(kMetricDeviceReportBuild));
+    return Track(kMetricDeviceStorageCommit);
+}
+
+CHIP_ERROR HistogramBackend::Reset()
+{
+    for (unsigned attempt = 0; attempt < kMaxLockAttempts; attempt++)
+    {
+        ScopedTryLock lock(mLock);
+        if (!lock.IsLocked())
+        {
+            continue;
+        }
+
+        size_t count = mEntryCount.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < count; i++)
+        {
+            mEntries[i].histogram.Reset();
+            mEntries[i].openCount = 0;
+        }
+        mDroppedEvents.store(0, std::memory_order_relaxed);
+        return CHIP_NO_ERROR;
+    }
+    return CHIP_ERROR_BUSY;
+}
+
+CHIP_ERROR HistogramBackend::GetSummaries(Summary * summaries, size_t maxCount, size_t & count)
+{
+    count = 0;
+    VerifyOrReturnError(summaries != nullptr || maxCount == 0, CHIP_ERROR_INVALID_ARGUMENT);
+
+    for (unsigned attempt = 0; attempt < kMaxLockAttempts; attempt++)
+    {
+        ScopedTryLock lock(mLock);
+        if (!lock.IsLocked())
+        {
+            continue;
+        }
+
+        size_t entryCount = mEntryCount.load(std::memory_order_relaxed);
+        for (; count < entryCount && count < maxCount; count++)
+        {
+            const LatencyHistogram & histogram = mEntries[count].histogram;
+            Summary & summary                  = summaries[count];
+
+            summary.name  = mEntries[count].name;
+            summary.count = histogram.GetCount();
+            summary.min   = histogram.GetMin();
+            summary.p50   = histogram.GetValueAtPercentile(50.0);
+            summary.p90   = histogram.GetValueAtPercentile(90.0);
+            summary.p99   = histogram.GetValueAtPercentile(99.0);
+            summary.p999  = histogram.GetValueAtPercentile(99.9);
+            summary.max   = histogram.GetMax();
+            summary.mean  = histogram.GetMean();
+        }
+        return CHIP_NO_ERROR;
+    }
+    return CHIP_ERROR_BUSY;
+}
+
+CHIP_ERROR HistogramBackend::WriteTextSnapshot(StringBuilderBase & out)
+{
+    Summary summaries[kMaxHistograms];
+    size_t count;
+    ReturnErrorOnFailure(GetSummaries(summaries, kMaxHistograms, count));
+
+    out.Add("operation count min p50 p90 p99 p99.9 max mean (us)\n");
+    for (size_t i = 0; i < count; i++)
+    {
+        const Summary & s = summaries[i];
+        out.AddFormat("%s %u %u %u %u %u %u %u %u\n", s.name, static_cast<unsigned>(s.count), static_cast<unsigned>(s.min),
+                      static_cast<unsigned>(s.p50), static_cast<unsigned>(s.p90), static_cast<unsigned>(s.p99),
+                      static_cast<unsigned>(s.p999), static_cast<unsigned>(s.max), static_cast<unsigned>(s.mean));
+    }
+    out.AddFormat("dropped %u\n", static_cast<unsigned>(GetDroppedEventCount()));
+
+    return out.Fit() ? CHIP_NO_ERROR : CHIP_ERROR_BUFFER_TOO_SMALL;
+}
+
+void HistogramBackend::TraceBegin(const char * label, const char * group)
+{
+    BeginScope(label);
+}
+
+void HistogramBackend::TraceEnd(const char * label, const char * group)
+{
+    EndScope(label, /* record = */ true);
+}
+
+void HistogramBackend::LogMetricEvent(const MetricEvent & event)
+{
+    switch (event.type())
+    {
+    case MetricEvent::Type::kBeginEvent:
+        BeginScope(event.key());
+        break;
+    case MetricEvent::Type::kEndEvent: {
+        // Failed operations (e.g. a timed out CASE handshake) would skew the distribution.
+        bool succeeded =
+            event.ValueType() != MetricEvent::Value::Type::kChipErrorCode || event.ValueErrorCode() == CHIP_NO_ERROR.AsInteger();
+        EndScope(event.key(), succeeded);
+        break;
+    }
+    case MetricEvent::Type::kInstantEvent:
+        if (event.ValueType() == MetricEvent::Value::Type::kUInt32)
+        {
+            RecordValue(event.key(), event.ValueUInt32());
+        }
+        break;
+    }
+}
+
+HistogramBackend::Entry * HistogramBackend::FindEntry(const char * name)
+{
+    // Entries are only ever appended, so this is safe to call without the lock held.
+    size_t count = mEntryCount.load(std::memory_order_acquire);
+    for (size_t i = 0; i < count; i++)
+    {
+        if (NamesMatch(mEntries[i].name, name))
+        {
+            return &mEntries[i];
+        }
+    }
+    return nullptr;
+}
+
+void HistogramBackend::BeginScope(const char * name)
+{
+    Entry * entry = FindEntry(name);
+    VerifyOrReturn(entry != nullptr);
+
+    uint64_t now = NowMicroseconds();
+
+    ScopedTryLock lock(mLock);
+    if (!lock.IsLocked() || entry->openCount == UINT16_MAX)
+    {
+        mDroppedEvents.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    ExpireScope(*entry, now);
+    if (entry->openCount == 0)
+    {
+        entry->openSinceUs = now;
+        entry->overlapped  = false;
+    }
+    else
+    {
+        // Without a context there is no telling which end belongs to which
+        // begin, so none of the overlapping instances is measured.
+        entry->overlapped = true;
+    }
+    entry->openCount++;
+}
+
+void HistogramBackend::EndScope(const char * name, bool record)
+{
+    Entry * entry = FindEntry(name);
+    VerifyOrReturn(entry != nullptr);
+
+    uint64_t now = NowMicroseconds();
+
+    ScopedTryLock lock(mLock);
+    if (!lock.IsLocked())
+    {
+        mDroppedEvents.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    // Ends without a begin (e.g. dropped, abandoned, or begun before the
+    // backend was registered) are ignored.
+    ExpireScope(*entry, now);
+    VerifyOrReturn(entry->openCount > 0);
+
+    entry->openCount--;
+    if (entry->openCount == 0 && record && !entry->overlapped)
+    {
+        uint64_t elapsed = now - entry->openSinceUs;
+        entry->histogram.Record(elapsed > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(elapsed));
+    }
+}
+
+void HistogramBackend::ExpireScope(Entry & entry, uint64_t now)
+{
+    if (entry.openCount > 0 && now - entry.openSinceUs > kScopeTimeoutUs)
+    {
+        entry.openCount = 0;
+        mDroppedEvents.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void HistogramBackend::RecordValue(const char * name, uint32_t valueUs)
+{
+    Entry * entry = FindEntry(name);
+    VerifyOrReturn(entry != nullptr);
+
+    ScopedTryLock lock(mLock);
+    if (!lock.IsLocked())
+    {
+        mDroppedEvents.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    entry->histogram.Record(valueUs);
+}
+
+} // namespace Histograms
+} // namespace Tracing
+} // namespace chip
@@ -0,0 +1,168 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#pragma once
+
+#include <lib/core/CHIPError.h>
+#include <lib/support/StringBuilder.h>
+#include <tracing/backend.h>
+#include <tracing/histogram/latency_histogram.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/// Maximum number of operations whose latency can be tracked at once. Each
+/// costs sizeof(LatencyHistogram), about 1.6KB.
+#ifndef MATTER_TRACING_MAX_LATENCY_HISTOGRAMS
+#define MATTER_TRACING_MAX_LATENCY_HISTOGRAMS 8
+#endif
+
+/// Age after which an operation begun without a matching end is abandoned,
+/// so that a lost end event does not block its later measurements.
+#ifndef MATTER_TRACING_LATENCY_SCOPE_TIMEOUT_SEC
+#define MATTER_TRACING_LATENCY_SCOPE_TIMEOUT_SEC 120
+#endif
+
+namespace chip {
+namespace Tracing {
+namespace Histograms {
+
+/// A Backend aggregating the latency distribution of selected operations
+/// into fixed-size histograms, so that percentiles can be queried on a
+/// running device (see the `histogram` shell command).
+///
+/// An operation is identified by a name and measured either:
+///   - between TraceBegin/TraceEnd calls with that label (only when the
+///     tracing macros are routed to backends, i.e. the multiplexed config),
+///   - between kBeginEvent/kEndEvent metric events with that key; an end
+///     event carrying a failure code discards the measurement, or
+///   - directly from the value of kInstantEvent metric events with that
+///     key, which must then be a duration in microseconds.
+///
+/// Begin and end events carry no context identifying the operation instance,
+/// so an operation is only measured while a single instance of it is in
+/// progress: when a begin arrives while the same operation is already open
+/// (concurrent CASE handshakes, nested scopes), the measurements of all the
+/// overlapping instances are discarded rather than mis-paired. An operation
+/// left open for MATTER_TRACING_LATENCY_SCOPE_TIMEOUT_SEC is abandoned.
+///
+/// Only operations registered via Track() are measured; all other events
+/// return after a few string compares.
+///
+/// THREAD SAFETY:
+///   Events are recorded under a try-lock: an event arriving while another
+///   thread holds it is dropped and counted, so tracing never blocks.
+class HistogramBackend : public ::chip::Tracing::Backend
+{
+public:
+    static constexpr size_t kMaxHistograms = MATTER_TRACING_MAX_LATENCY_HISTOGRAMS;
+    static constexpr uint64_t kScopeTimeoutUs = uint64_t(MATTER_TRACING_LATENCY_SCOPE_TIMEOUT_SEC) * 1000 * 1000;
+
+    struct Summary
+    {
+        const char * name;
+        uint32_t count;
+        uint32_t min;
+        uint32_t p50;
+        uint32_t p90;
+        uint32_t p99;
+        uint32_t p999;
+        uint32_t max;
+        uint32_t mean;
+    };
+
+    HistogramBackend() = default;
+
+    static HistogramBackend & GetInstance();
+
+    /// Start tracking the given label or metric key. `name` must outlive
+    /// the backend (string literals and metric keys do).
+    ///
+    /// @retval CHIP_ERROR_NO_MEMORY  kMaxHistograms operations are already tracked.
+    CHIP_ERROR Track(const char * name);
+
+    /// Track CASE establishment, MRP round trips, invoke handling, report
+    /// building and attribute storage commits.
+    CHIP_ERROR TrackDefaults();
+
+    /// Clear all recorded values, keeping the set of tracked operations.
+    CHIP_ERROR Reset();
+
+    /// Copy a summary of up to `maxCount` histograms into `summaries`.
+    ///
+    /// @retval CHIP_ERROR_BUSY  Events kept being recorded concurrently; retry later.
+    CHIP_ERROR GetSummaries(Summary * summaries, size_t maxCount, size_t & count);
+
+    /// Append a text table with one line per tracked operation, all values
+    /// in microseconds.
+    CHIP_ERROR WriteTextSnapshot(StringBuilderBase & out);
+
+    /// Number of events dropped due to contention, plus abandoned operations.
+    uint32_t GetDroppedEventCount() const { return mDroppedEvents.load(std::memory_order_relaxed); }
+
+    void TraceBegin(const char * label, const char * group) override;
+    void TraceEnd(const char * label, const char * group) override;
+    void LogMetricEvent(const MetricEvent & event) override;
+
+private:
+    struct Entry
+    {
+        const char * name = nullptr;
+        LatencyHistogram histogram;
+
+        // Instances of the operation currently in progress, the first of
+        // which began at openSinceUs.
+        uint64_t openSinceUs = 0;
+        uint16_t openCount   = 0;
+        bool overlapped      = false;
+    };
+
+    class ScopedTryLock
+    {
+    public:
+        explicit ScopedTryLock(std::atomic_flag & flag) : mFlag(flag), mLocked(!flag.test_and_set(std::memory_order_acquire)) {}
+        ~ScopedTryLock()
+        {
+            if (mLocked)
+            {
+                mFlag.clear(std::memory_order_release);
+            }
+        }
+        bool IsLocked() const { return mLocked; }
+
+    private:
+        std::atomic_flag & mFlag;
+        const bool mLocked;
+    };
+
+    Entry * FindEntry(const char * name);
+    void BeginScope(const char * name);
+    void EndScope(const char * name, bool record);
+    void ExpireScope(Entry & entry, uint64_t now);
+    void RecordValue(const char * name, uint32_t valueUs);
+
+    Entry mEntries[kMaxHistograms];
+    std::atomic<size_t> mEntryCount{ 0 };
+
+    std::atomic_flag mLock = ATOMIC_FLAG_INIT;
+    std::atomic<uint32_t> mDroppedEvents{ 0 };
+};
+
+} // namespace Histograms
+} // namespace Tracing
+} // namespace chip
@@ -0,0 +1,118 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <tracing/histogram/latency_histogram.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace chip {
+namespace Tracing {
+namespace Histograms {
+
+namespace {
+
+unsigned MostSignificantBit(uint32_t value)
+{
+    unsigned msb = 0;
+    while (value >>= 1)
+    {
+        msb++;
+    }
+    return msb;
+}
+
+} // namespace
+
+size_t LatencyHistogram::BucketIndex(uint32_t value)
+{
+    value = std::min(value, kMaxTrackedValue);
+    if (value < 2 * kSubBucketCount)
+    {
+        return value;
+    }
+
+    // Keep the kSubBucketBits bits below the most significant one.
+    const unsigned shift = MostSignificantBit(value) - kSubBucketBits;
+    return shift * kSubBucketCount + (value >> shift);
+}
+
+uint32_t LatencyHistogram::BucketHighestValue(size_t index)
+{
+    if (index < 2 * kSubBucketCount)
+    {
+        return static_cast<uint32_t>(index);
+    }
+
+    const unsigned shift     = static_cast<unsigned>(index / kSubBucketCount) - 1;
+    const uint32_t subBucket = static_cast<uint32_t>(index % kSubBucketCount) + kSubBucketCount;
+    return ((subBucket + 1) << shift) - 1;
+}
+
+void LatencyHistogram::Record(uint32_t valueUs)
+{
+    mCounts[BucketIndex(valueUs)]++;
+    mCount++;
+    mMin = std::min(mMin, valueUs);
+    mMax = std::max(mMax, valueUs);
+    mSum += valueUs;
+}
+
+void LatencyHistogram::Reset()
+{
+    memset(mCounts, 0, sizeof(mCounts));
+    mCount = 0;
+    mMin   = UINT32_MAX;
+    mMax   = 0;
+    mSum   = 0;
+}
+
+uint32_t LatencyHistogram::GetValueAtPercentile(double percentile) const
+{
+    if (mCount == 0)
+    {
+        return 0;
+    }
+
+    // Round the rank up, ignoring floating point noise (e.g. 99% of 100 values is the 99th, not the 100th).
+    percentile           = std::min(std::max(percentile, 0.0), 100.0);
+    const double rank    = percentile * mCount / 100.0;
+    uint64_t targetCount = static_cast<uint64_t>(rank);
+    if (rank - static_cast<double>(targetCount) > 1e-9)
+    {
+        targetCount++;
+    }
+    targetCount = std::max<uint64_t>(targetCount, 1);
+
+    // The last bucket also holds every value above kMaxTrackedValue, so the
+    // loop stops before it and falls back to the exact maximum.
+    uint64_t seen = 0;
+    for (size_t i = 0; i + 1 < kBucketCount; i++)
+    {
+        seen += mCounts[i];
+        if (seen >= targetCount)
+        {
+            return std::min(std::max(BucketHighestValue(i), GetMin()), mMax);
+        }
+    }
+    return mMax;
+}
+
+} // namespace Histograms
+} // namespace Tracing
+} // namespace chip
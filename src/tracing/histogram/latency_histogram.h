@@ -0,0 +1,73 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace chip {
+namespace Tracing {
+namespace Histograms {
+
+/// Fixed-size, HDR-style histogram of latencies in microseconds.
+///
+/// Values below 32us get a bucket each; above that, every power of two is
+/// split into 16 linear sub-buckets, so any recorded value is reported
+/// with a relative error below 1/16 (6.25%). Values up to 2^28us (~268s)
+/// are resolved; larger ones are counted in the last bucket (their exact
+/// maximum is still kept).
+///
+/// Not thread safe; HistogramBackend serializes access.
+class LatencyHistogram
+{
+public:
+    static constexpr unsigned kSubBucketBits   = 4;
+    static constexpr unsigned kSubBucketCount  = 1u << kSubBucketBits;
+    static constexpr unsigned kMaxValueBits    = 28;
+    static constexpr uint32_t kMaxTrackedValue = (1u << kMaxValueBits) - 1;
+    static constexpr size_t kBucketCount       = (kMaxValueBits - kSubBucketBits + 1) * kSubBucketCount;
+
+    LatencyHistogram() { Reset(); }
+
+    void Record(uint32_t valueUs);
+    void Reset();
+
+    uint32_t GetCount() const { return mCount; }
+    uint32_t GetMin() const { return mCount > 0 ? mMin : 0; }
+    uint32_t GetMax() const { return mMax; }
+    uint32_t GetMean() const { return mCount > 0 ? static_cast<uint32_t>(mSum / mCount) : 0; }
+
+    /// Returns the smallest value such that at least `percentile` percent
+    /// (0 to 100) of the recorded values are less than or equal to it, to
+    /// within the resolution of the histogram. Returns 0 if empty.
+    uint32_t GetValueAtPercentile(double percentile) const;
+
+private:
+    static size_t BucketIndex(uint32_t value);
+    static uint32_t BucketHighestValue(size_t index);
+
+    uint32_t mCounts[kBucketCount];
+    uint32_t mCount;
+    uint32_t mMin;
+    uint32_t mMax;
+    uint64_t mSum;
+};
+
+} // namespace Histograms
+} // namespace Tracing
+} // namespace chip
@@ -78,5 +78,20 @@ constexpr MetricKey kMetricDeviceRMPRetryCount = "core_dev_rmp_retry_count";
 // Subscription setup
 constexpr MetricKey kMetricDeviceSubscriptionSetup = "core_dev_subscription_setup";
 
+// MRP round trip time in microseconds, from first transmission to ack, for messages acked without retransmission
+constexpr MetricKey kMetricDeviceMRPRoundTrip = "core_dev_mrp_round_trip";
+
+// Handling of an incoming Invoke Request
+constexpr MetricKey kMetricDeviceInvokeHandling = "core_dev_invoke_handling";
+
+// Building and sending a single report
+constexpr MetricKey kMetricDeviceReportBuild = "core_dev_report_build";
+
+// Committing a value to persistent storage
+constexpr MetricKey kMetricDeviceStorageCommit = "core_dev_storage_commit";
+
+// Server initialization
+constexpr MetricKey kMetricServerInit = "core_server_init";
+
 } // namespace Tracing
 } // namespace chip
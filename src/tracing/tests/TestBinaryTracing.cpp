@@ -0,0 +1,184 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#include <pw_unit_test/framework.h>
+
+#include <lib/core/StringBuilderAdapters.h>
+#include <lib/support/BufferWriter.h>
+#include <lib/support/TypeTraits.h>
+#include <tracing/binary/binary_trace_format.h>
+#include <tracing/binary/binary_tracing.h>
+#include <tracing/binary/trace_converter.h>
+#include <tracing/macros.h>
+#include <tracing/metric_event.h>
+#include <tracing/registry.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include <unistd.h>
+
+using namespace chip;
+using namespace chip::Tracing;
+using namespace chip::Tracing::Binary;
+
+namespace {
+
+class TestBinaryTracing : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        strcpy(mTracePath, "/tmp/chip_binary_trace-XXXXXX");
+        strcpy(mJsonPath, "/tmp/chip_binary_trace_json-XXXXXX");
+        int fd = mkstemp(mTracePath);
+        ASSERT_GE(fd, 0);
+        close(fd);
+        fd = mkstemp(mJsonPath);
+        ASSERT_GE(fd, 0);
+        close(fd);
+    }
+
+    void TearDown() override
+    {
+        unlink(mTracePath);
+        unlink(mJsonPath);
+    }
+
+    std::string ConvertTrace()
+    {
+        EXPECT_EQ(ConvertToChromeJson(mTracePath, mJsonPath), CHIP_NO_ERROR);
+        std::ifstream json(mJsonPath);
+        std::stringstream content;
+        content << json.rdbuf();
+        return content.str();
+    }
+
+    static size_t CountOccurrences(const std::string & haystack, const std::string & needle)
+    {
+        size_t count = 0;
+        for (size_t pos = haystack.find(needle); pos != std::string::npos; pos = haystack.find(needle, pos + needle.size()))
+        {
+            count++;
+        }
+        return count;
+    }
+
+    char mTracePath[64];
+    char mJsonPath[64];
+};
+
+TEST_F(TestBinaryTracing, RecordsAndConvertsEvents)
+{
+    BinaryBackend backend;
+    ASSERT_EQ(backend.OpenFile(mTracePath), CHIP_NO_ERROR);
+
+    {
+        ScopedRegistration scope(backend);
+
+        MATTER_TRACE_SCOPE("Outer", "Group");
+        MATTER_TRACE_INSTANT("Marker", "Group");
+        MATTER_TRACE_COUNTER("Counter");
+        MATTER_TRACE_COUNTER("Counter");
+        backend.LogMetricEvent(MetricEvent(MetricEvent::Type::kInstantEvent, "Metric", static_cast<uint32_t>(42)));
+
+        std::thread other([&backend] { backend.TraceInstant("OtherThread", "Group"); });
+        other.join();
+    }
+    backend.CloseFile();
+
+    std::string json = ConvertTrace();
+    EXPECT_EQ(json.rfind("{\"traceEvents\":[", 0), 0u);
+    EXPECT_EQ(CountOccurrences(json, "\"name\":\"Outer\",\"cat\":\"Group\",\"ph\":\"B\""), 1u);
+    EXPECT_EQ(CountOccurrences(json, "\"name\":\"Outer\",\"cat\":\"Group\",\"ph\":\"E\""), 1u);
+    EXPECT_EQ(CountOccurrences(json, "\"name\":\"Marker\""), 1u);
+    EXPECT_EQ(CountOccurrences(json, "\"args\":{\"value\":2}"), 1u);
+    EXPECT_EQ(CountOccurrences(json, "\"name\":\"Metric\",\"cat\":\"Metric\""), 1u);
+    EXPECT_EQ(CountOccurrences(json, "\"args\":{\"value\":42}"), 1u);
+    EXPECT_EQ(CountOccurrences(json, "\"name\":\"OtherThread\""), 1u);
+    EXPECT_EQ(CountOccurrences(json, "\"name\":\"Dropped events\""), 0u);
+}
+
+TEST_F(TestBinaryTracing, AccountsForEveryEventUnderLoad)
+{
+    constexpr uint32_t kEvents = 50000;
+
+    BinaryBackend backend;
+    ASSERT_EQ(backend.OpenFile(mTracePath), CHIP_NO_ERROR);
+
+    // A second backend can not share the process-wide ring buffers.
+    BinaryBackend other;
+    EXPECT_EQ(other.OpenFile(mJsonPath), CHIP_ERROR_INCORRECT_STATE);
+
+    for (uint32_t i = 0; i < kEvents; i++)
+    {
+        backend.TraceInstant("Hot", "Group");
+    }
+    backend.CloseFile();
+
+    // Events are either recorded or reported as dropped, never silently lost.
+    std::string json       = ConvertTrace();
+    size_t recorded        = CountOccurrences(json, "\"name\":\"Hot\"");
+    unsigned long dropped  = 0;
+    const std::string kKey = "\"args\":{\"count\":";
+    for (size_t pos = json.find(kKey); pos != std::string::npos; pos = json.find(kKey, pos + 1))
+    {
+        dropped += strtoul(json.c_str() + pos + kKey.size(), nullptr, 10);
+    }
+    EXPECT_EQ(recorded + dropped, kEvents);
+}
+
+TEST_F(TestBinaryTracing, TimestampsAreRelativeToFileOpening)
+{
+    constexpr uint64_t kBaseTimestampNs = 5000000;
+
+    // Thread 1 is drained after thread 0, but its event happened first.
+    uint8_t trace[kFileHeaderSize + kRecordSize + 1 + 2 * kRecordSize];
+    Encoding::LittleEndian::BufferWriter writer(trace, sizeof(trace));
+    writer.Put(kFileMagic, sizeof(kFileMagic)).Put32(kFormatVersion).Put32(0).Put64(kBaseTimestampNs);
+    writer.Put8(to_underlying(RecordType::kString)).Put8(0).Put16(1).Put32(1).Put32(0).Put32(0).Put64(0).Put("A", 1);
+    writer.Put8(to_underlying(RecordType::kInstant)).Put8(0).Put8(0).Put8(0).Put32(1).Put32(0).Put32(0);
+    writer.Put64(kBaseTimestampNs + 2000);
+    writer.Put8(to_underlying(RecordType::kInstant)).Put8(1).Put8(0).Put8(0).Put32(1).Put32(0).Put32(0);
+    writer.Put64(kBaseTimestampNs + 1000);
+    ASSERT_TRUE(writer.Fit());
+
+    FILE * file = fopen(mTracePath, "wb");
+    ASSERT_NE(file, nullptr);
+    EXPECT_EQ(fwrite(trace, 1, sizeof(trace), file), sizeof(trace));
+    fclose(file);
+
+    std::string json = ConvertTrace();
+    EXPECT_EQ(CountOccurrences(json, "\"ts\":2.000,\"pid\":1,\"tid\":0"), 1u);
+    EXPECT_EQ(CountOccurrences(json, "\"ts\":1.000,\"pid\":1,\"tid\":1"), 1u);
+}
+
+TEST_F(TestBinaryTracing, RejectsForeignInput)
+{
+    FILE * file = fopen(mTracePath, "wb");
+    ASSERT_NE(file, nullptr);
+    fputs("{\"traceEvents\":[]}", file);
+    fclose(file);
+
+    EXPECT_EQ(ConvertToChromeJson(mTracePath, mJsonPath), CHIP_ERROR_INVALID_FILE_IDENTIFIER);
+}
+
+} // namespace
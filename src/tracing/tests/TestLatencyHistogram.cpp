@@ -0,0 +1,217 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#include <pw_unit_test/framework.h>
+
+#include <lib/core/StringBuilderAdapters.h>
+#include <lib/support/StringBuilder.h>
+#include <system/SystemClock.h>
+#include <tracing/histogram/histogram_backend.h>
+#include <tracing/histogram/latency_histogram.h>
+#include <tracing/metric_event.h>
+#include <tracing/registry.h>
+
+#include <string.h>
+
+using namespace chip;
+using namespace chip::Tracing;
+using namespace chip::Tracing::Histograms;
+
+namespace {
+
+// Relative error guaranteed by 16 sub-buckets per power of two.
+constexpr double kMaxRelativeError = 1.0 / 16;
+
+void ExpectWithinResolution(uint32_t actual, uint32_t expected)
+{
+    EXPECT_GE(actual, expected);
+    EXPECT_LE(actual, expected + static_cast<uint32_t>(expected * kMaxRelativeError) + 1);
+}
+
+TEST(TestLatencyHistogram, TestEmpty)
+{
+    LatencyHistogram histogram;
+
+    EXPECT_EQ(histogram.GetCount(), 0u);
+    EXPECT_EQ(histogram.GetMin(), 0u);
+    EXPECT_EQ(histogram.GetMax(), 0u);
+    EXPECT_EQ(histogram.GetMean(), 0u);
+    EXPECT_EQ(histogram.GetValueAtPercentile(50), 0u);
+}
+
+TEST(TestLatencyHistogram, TestSmallValuesAreExact)
+{
+    LatencyHistogram histogram;
+
+    for (uint32_t i = 0; i < 32; i++)
+    {
+        histogram.Record(i);
+    }
+
+    EXPECT_EQ(histogram.GetCount(), 32u);
+    EXPECT_EQ(histogram.GetMin(), 0u);
+    EXPECT_EQ(histogram.GetMax(), 31u);
+    EXPECT_EQ(histogram.GetValueAtPercentile(50), 15u);
+    EXPECT_EQ(histogram.GetValueAtPercentile(100), 31u);
+}
+
+TEST(TestLatencyHistogram, TestPercentiles)
+{
+    LatencyHistogram histogram;
+
+    // 1..10000us, uniformly.
+    for (uint32_t i = 1; i <= 10000; i++)
+    {
+        histogram.Record(i);
+    }
+
+    EXPECT_EQ(histogram.GetCount(), 10000u);
+    EXPECT_EQ(histogram.GetMin(), 1u);
+    EXPECT_EQ(histogram.GetMax(), 10000u);
+    EXPECT_EQ(histogram.GetMean(), 5000u);
+
+    ExpectWithinResolution(histogram.GetValueAtPercentile(50), 5000);
+    ExpectWithinResolution(histogram.GetValueAtPercentile(90), 9000);
+    ExpectWithinResolution(histogram.GetValueAtPercentile(99), 9900);
+    EXPECT_EQ(histogram.GetValueAtPercentile(100), 10000u);
+
+    histogram.Reset();
+    EXPECT_EQ(histogram.GetCount(), 0u);
+    EXPECT_EQ(histogram.GetValueAtPercentile(99), 0u);
+}
+
+TEST(TestLatencyHistogram, TestOutliers)
+{
+    LatencyHistogram histogram;
+
+    for (int i = 0; i < 999; i++)
+    {
+        histogram.Record(100);
+    }
+    histogram.Record(UINT32_MAX);
+
+    ExpectWithinResolution(histogram.GetValueAtPercentile(99), 100);
+    EXPECT_EQ(histogram.GetValueAtPercentile(100), UINT32_MAX);
+    EXPECT_EQ(histogram.GetMax(), UINT32_MAX);
+}
+
+TEST(TestLatencyHistogram, TestBackendRecordsTrackedEvents)
+{
+    HistogramBackend backend;
+    EXPECT_EQ(backend.Track("test_rtt"), CHIP_NO_ERROR);
+    EXPECT_EQ(backend.Track("test_op"), CHIP_NO_ERROR);
+
+    {
+        ScopedRegistration scope(backend);
+
+        MATTER_LOG_METRIC("test_rtt", uint32_t(1000));
+        MATTER_LOG_METRIC("test_rtt", uint32_t(3000));
+        MATTER_LOG_METRIC("untracked", uint32_t(5000));
+
+        MATTER_LOG_METRIC_BEGIN("test_op");
+        MATTER_LOG_METRIC_END("test_op", CHIP_NO_ERROR);
+
+        // Overlapping instances of an operation cannot be told apart.
+        MATTER_LOG_METRIC_BEGIN("test_op");
+        MATTER_LOG_METRIC_BEGIN("test_op");
+        MATTER_LOG_METRIC_END("test_op", CHIP_NO_ERROR);
+        MATTER_LOG_METRIC_END("test_op");
+
+        // Failed operations and unmatched ends are not recorded.
+        MATTER_LOG_METRIC_BEGIN("test_op");
+        MATTER_LOG_METRIC_END("test_op", CHIP_ERROR_TIMEOUT);
+        MATTER_LOG_METRIC_END("test_op");
+    }
+
+    HistogramBackend::Summary summaries[HistogramBackend::kMaxHistograms];
+    size_t count;
+    EXPECT_EQ(backend.GetSummaries(summaries, HistogramBackend::kMaxHistograms, count), CHIP_NO_ERROR);
+    ASSERT_EQ(count, 2u);
+
+    EXPECT_STREQ(summaries[0].name, "test_rtt");
+    EXPECT_EQ(summaries[0].count, 2u);
+    EXPECT_EQ(summaries[0].min, 1000u);
+    EXPECT_EQ(summaries[0].max, 3000u);
+    EXPECT_EQ(summaries[0].mean, 2000u);
+
+    EXPECT_STREQ(summaries[1].name, "test_op");
+    EXPECT_EQ(summaries[1].count, 1u);
+    EXPECT_EQ(backend.GetDroppedEventCount(), 0u);
+
+    EXPECT_EQ(backend.Reset(), CHIP_NO_ERROR);
+    EXPECT_EQ(backend.GetSummaries(summaries, HistogramBackend::kMaxHistograms, count), CHIP_NO_ERROR);
+    ASSERT_EQ(count, 2u);
+    EXPECT_EQ(summaries[0].count, 0u);
+}
+
+TEST(TestLatencyHistogram, TestBackendLimits)
+{
+    HistogramBackend backend;
+    char names[HistogramBackend::kMaxHistograms][8];
+
+    for (size_t i = 0; i < HistogramBackend::kMaxHistograms; i++)
+    {
+        snprintf(names[i], sizeof(names[i]), "op%u", static_cast<unsigned>(i));
+        EXPECT_EQ(backend.Track(names[i]), CHIP_NO_ERROR);
+    }
+    EXPECT_EQ(backend.Track("op0"), CHIP_NO_ERROR);
+    EXPECT_EQ(backend.Track("another"), CHIP_ERROR_NO_MEMORY);
+}
+
+TEST(TestLatencyHistogram, TestBackendAbandonsStaleOperations)
+{
+    System::Clock::Internal::MockClock clock;
+    System::Clock::ClockBase * realClock = &System::SystemClock();
+    System::Clock::Internal::SetSystemClockForTesting(&clock);
+
+    HistogramBackend backend;
+    EXPECT_EQ(backend.Track("test_op"), CHIP_NO_ERROR);
+
+    // A begin whose end was lost.
+    backend.LogMetricEvent(MetricEvent(MetricEvent::Type::kBeginEvent, "test_op"));
+    clock.AdvanceMonotonic(System::Clock::Seconds64(MATTER_TRACING_LATENCY_SCOPE_TIMEOUT_SEC + 1));
+
+    backend.LogMetricEvent(MetricEvent(MetricEvent::Type::kBeginEvent, "test_op"));
+    clock.AdvanceMonotonic(System::Clock::Milliseconds64(5));
+    backend.LogMetricEvent(MetricEvent(MetricEvent::Type::kEndEvent, "test_op"));
+
+    HistogramBackend::Summary summary;
+    size_t count;
+    EXPECT_EQ(backend.GetSummaries(&summary, 1, count), CHIP_NO_ERROR);
+    ASSERT_EQ(count, 1u);
+    EXPECT_EQ(summary.count, 1u);
+    ExpectWithinResolution(summary.max, 5000);
+    EXPECT_EQ(backend.GetDroppedEventCount(), 1u);
+
+    System::Clock::Internal::SetSystemClockForTesting(realClock);
+}
+
+TEST(TestLatencyHistogram, TestTextSnapshot)
+{
+    HistogramBackend backend;
+    EXPECT_EQ(backend.Track(kMetricDeviceMRPRoundTrip), CHIP_NO_ERROR);
+    backend.LogMetricEvent(MetricEvent(MetricEvent::Type::kInstantEvent, kMetricDeviceMRPRoundTrip, uint32_t(250)));
+
+    StringBuilder<256> text;
+    EXPECT_EQ(backend.WriteTextSnapshot(text), CHIP_NO_ERROR);
+    EXPECT_NE(strstr(text.c_str(), "core_dev_mrp_round_trip 1 250 250 250 250 250 250 250\n"), nullptr);
+
+    StringBuilder<16> tooSmall;
+    EXPECT_EQ(backend.WriteTextSnapshot(tooSmall), CHIP_ERROR_BUFFER_TOO_SMALL);
+}
+
+} // namespace
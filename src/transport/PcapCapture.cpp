@@ -0,0 +1,286 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <transport/PcapCapture.h>
+
+#include <lib/support/BufferReader.h>
+#include <lib/support/BufferWriter.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <transport/TransportMgrBase.h>
+
+namespace chip {
+namespace Transport {
+
+namespace {
+
+constexpr uint32_t kPcapMagic             = 0xa1b2c3d4;
+constexpr uint16_t kPcapVersionMajor      = 2;
+constexpr uint16_t kPcapVersionMinor      = 4;
+constexpr size_t kPcapFileHeaderSize      = 24;
+constexpr size_t kPcapRecordHeaderSize    = 16;
+constexpr size_t kIPAddressSize           = 16;
+constexpr uint64_t kMicrosecondsPerSecond = 1000000;
+
+bool ReadExactly(FILE * file, uint8_t * buf, size_t length)
+{
+    return fread(buf, 1, length, file) == length;
+}
+
+} // namespace
+
+CHIP_ERROR PcapCaptureWriter::Open(const char * path)
+{
+    VerifyOrReturnError(mFile == nullptr, CHIP_ERROR_INCORRECT_STATE);
+
+    mFile = fopen(path, "wb");
+    VerifyOrReturnError(mFile != nullptr, CHIP_ERROR_OPEN_FAILED);
+
+    uint8_t header[kPcapFileHeaderSize];
+    Encoding::LittleEndian::BufferWriter writer(header, sizeof(header));
+    writer.Put32(kPcapMagic)
+        .Put16(kPcapVersionMajor)
+        .Put16(kPcapVersionMinor)
+        .Put32(0) // thiszone
+        .Put32(0) // sigfigs
+        .Put32(kPcapMaxRecordLength)
+        .Put32(kPcapLinkTypeUser0);
+
+    if (fwrite(header, 1, writer.Needed(), mFile) != writer.Needed())
+    {
+        Close();
+        return CHIP_ERROR_WRITE_FAILED;
+    }
+
+    mFrameCount = 0;
+    return CHIP_NO_ERROR;
+}
+
+void PcapCaptureWriter::Close()
+{
+    if (mFile != nullptr)
+    {
+        fclose(mFile);
+        mFile = nullptr;
+    }
+}
+
+CHIP_ERROR PcapCaptureWriter::WriteFrame(CaptureDirection direction, const PeerAddress & peerAddress,
+                                         System::Clock::Microseconds64 timestamp, const System::PacketBufferHandle & msg)
+{
+    VerifyOrReturnError(mFile != nullptr, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(!msg.IsNull(), CHIP_ERROR_INVALID_ARGUMENT);
+
+    // Chained buffers are rare on this path; flatten them rather than writing each buffer separately.
+    const System::PacketBufferHandle * payload = &msg;
+    System::PacketBufferHandle flattened;
+    const size_t payloadLength = msg->TotalLength();
+    VerifyOrReturnError(payloadLength + kPcapFrameHeaderSize <= kPcapMaxRecordLength, CHIP_ERROR_MESSAGE_TOO_LONG);
+    if (msg->HasChainedBuffer())
+    {
+        flattened = System::PacketBufferHandle::New(payloadLength, 0);
+        VerifyOrReturnError(!flattened.IsNull(), CHIP_ERROR_NO_MEMORY);
+        ReturnErrorOnFailure(msg->Read(flattened->Start(), payloadLength));
+        flattened->SetDataLength(payloadLength);
+        payload = &flattened;
+    }
+
+    const uint32_t recordLength = static_cast<uint32_t>(kPcapFrameHeaderSize + payloadLength);
+    uint8_t header[kPcapRecordHeaderSize + kPcapFrameHeaderSize];
+    Encoding::LittleEndian::BufferWriter writer(header, sizeof(header));
+    writer.Put32(static_cast<uint32_t>(timestamp.count() / kMicrosecondsPerSecond))
+        .Put32(static_cast<uint32_t>(timestamp.count() % kMicrosecondsPerSecond))
+        .Put32(recordLength)
+        .Put32(recordLength);
+
+    uint8_t address[kIPAddressSize];
+    uint8_t * p = address;
+    peerAddress.GetIPAddress().WriteAddress(p);
+
+    writer.Put8(kPcapFrameHeaderVersion)
+        .Put8(to_underlying(direction))
+        .Put8(to_underlying(peerAddress.GetTransportType()))
+        .Put8(0)
+        .Put16(peerAddress.GetPort())
+        .Put16(0)
+        .Put(address, sizeof(address));
+    VerifyOrReturnError(writer.Fit(), CHIP_ERROR_INTERNAL);
+
+    VerifyOrReturnError(fwrite(header, 1, sizeof(header), mFile) == sizeof(header), CHIP_ERROR_WRITE_FAILED);
+    VerifyOrReturnError(fwrite((*payload)->Start(), 1, payloadLength, mFile) == payloadLength, CHIP_ERROR_WRITE_FAILED);
+
+    mFrameCount++;
+    return CHIP_NO_ERROR;
+}
+
+void PcapCaptureWriter::OnFrameCaptured(CaptureDirection direction, const PeerAddress & peerAddress,
+                                        const System::PacketBufferHandle & msg)
+{
+    VerifyOrReturn(mFile != nullptr);
+
+    // Prefer wall-clock time so captures line up with device logs; fall back to the monotonic clock on
+    // platforms that do not track real time.
+    System::Clock::Microseconds64 timestamp;
+    if (System::SystemClock().GetClock_RealTime(timestamp) != CHIP_NO_ERROR)
+    {
+        timestamp = System::SystemClock().GetMonotonicMicroseconds64();
+    }
+
+    CHIP_ERROR err = WriteFrame(direction, peerAddress, timestamp, msg);
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(Inet, "Failed to capture frame: %" CHIP_ERROR_FORMAT, err.Format());
+    }
+}
+
+CHIP_ERROR PcapCaptureReader::Open(const char * path)
+{
+    VerifyOrReturnError(mFile == nullptr, CHIP_ERROR_INCORRECT_STATE);
+
+    mFile = fopen(path, "rb");
+    VerifyOrReturnError(mFile != nullptr, CHIP_ERROR_OPEN_FAILED);
+
+    uint8_t header[kPcapFileHeaderSize];
+    uint32_t magic    = 0;
+    uint16_t versionMajor;
+    uint16_t versionMinor;
+    uint32_t thisZone;
+    uint32_t sigFigs;
+    uint32_t snapLength;
+    uint32_t linkType = 0;
+    CHIP_ERROR err    = CHIP_ERROR_INVALID_FILE_IDENTIFIER;
+    if (ReadExactly(mFile, header, sizeof(header)))
+    {
+        Encoding::LittleEndian::Reader reader(header, sizeof(header));
+        err = reader.Read32(&magic)
+                  .Read16(&versionMajor)
+                  .Read16(&versionMinor)
+                  .Read32(&thisZone)
+                  .Read32(&sigFigs)
+                  .Read32(&snapLength)
+                  .Read32(&linkType)
+                  .StatusCode();
+    }
+
+    if (err != CHIP_NO_ERROR || magic != kPcapMagic || linkType != kPcapLinkTypeUser0)
+    {
+        Close();
+        return CHIP_ERROR_INVALID_FILE_IDENTIFIER;
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+void PcapCaptureReader::Close()
+{
+    if (mFile != nullptr)
+    {
+        fclose(mFile);
+        mFile = nullptr;
+    }
+}
+
+CHIP_ERROR PcapCaptureReader::ReadFrame(CapturedFrame & frame, bool & endOfFile)
+{
+    VerifyOrReturnError(mFile != nullptr, CHIP_ERROR_INCORRECT_STATE);
+
+    uint8_t header[kPcapRecordHeaderSize + kPcapFrameHeaderSize];
+    size_t headerLength = fread(header, 1, sizeof(header), mFile);
+    endOfFile           = (headerLength == 0);
+    VerifyOrReturnError(!endOfFile, CHIP_NO_ERROR);
+    VerifyOrReturnError(headerLength == sizeof(header), CHIP_ERROR_INVALID_MESSAGE_LENGTH);
+
+    uint32_t seconds;
+    uint32_t microseconds;
+    uint32_t recordLength;
+    uint32_t originalLength;
+    uint8_t version;
+    uint8_t direction;
+    uint8_t transportType;
+    uint8_t reserved8;
+    uint16_t port;
+    uint16_t reserved16;
+    uint8_t addressBytes[kIPAddressSize];
+    Encoding::LittleEndian::Reader reader(header, sizeof(header));
+    ReturnErrorOnFailure(reader.Read32(&seconds)
+                             .Read32(&microseconds)
+                             .Read32(&recordLength)
+                             .Read32(&originalLength)
+                             .Read8(&version)
+                             .Read8(&direction)
+                             .Read8(&transportType)
+                             .Read8(&reserved8)
+                             .Read16(&port)
+                             .Read16(&reserved16)
+                             .ReadBytes(addressBytes, sizeof(addressBytes))
+                             .StatusCode());
+
+    VerifyOrReturnError(version == kPcapFrameHeaderVersion, CHIP_ERROR_VERSION_MISMATCH);
+    VerifyOrReturnError(recordLength == originalLength && recordLength >= kPcapFrameHeaderSize &&
+                            recordLength <= kPcapMaxRecordLength,
+                        CHIP_ERROR_INVALID_MESSAGE_LENGTH);
+    VerifyOrReturnError(direction <= to_underlying(CaptureDirection::kSent), CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(transportType <= to_underlying(Type::kLast), CHIP_ERROR_INVALID_ARGUMENT);
+
+    Inet::IPAddress address;
+    const uint8_t * p = addressBytes;
+    Inet::IPAddress::ReadAddress(p, address);
+
+    const size_t payloadLength = recordLength - kPcapFrameHeaderSize;
+    System::PacketBufferHandle payload = System::PacketBufferHandle::New(payloadLength);
+    VerifyOrReturnError(!payload.IsNull() && payload->AvailableDataLength() >= payloadLength, CHIP_ERROR_NO_MEMORY);
+    VerifyOrReturnError(ReadExactly(mFile, payload->Start(), payloadLength), CHIP_ERROR_INVALID_MESSAGE_LENGTH);
+    payload->SetDataLength(payloadLength);
+
+    frame.direction   = static_cast<CaptureDirection>(direction);
+    frame.peerAddress = PeerAddress(address, static_cast<Type>(transportType)).SetPort(port);
+    frame.timestamp   = System::Clock::Microseconds64(seconds * kMicrosecondsPerSecond + microseconds);
+    frame.payload     = std::move(payload);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR PcapReplayDriver::Replay(const char * path, TransportMgrBase & transportMgr, Stats & stats)
+{
+    PcapCaptureReader reader;
+    ReturnErrorOnFailure(reader.Open(path));
+
+    stats = Stats();
+
+    CapturedFrame frame;
+    bool endOfFile = false;
+    while (true)
+    {
+        ReturnErrorOnFailure(reader.ReadFrame(frame, endOfFile));
+        VerifyOrReturnError(!endOfFile, CHIP_NO_ERROR);
+
+        if (frame.direction != CaptureDirection::kReceived)
+        {
+            stats.framesSkipped++;
+            continue;
+        }
+
+        stats.framesReplayed++;
+        stats.bytesReplayed += frame.payload->DataLength();
+
+        System::Clock::Microseconds64 start = System::SystemClock().GetMonotonicMicroseconds64();
+        transportMgr.HandleMessageReceived(frame.peerAddress, std::move(frame.payload));
+        stats.elapsed += System::SystemClock().GetMonotonicMicroseconds64() - start;
+    }
+}
+
+} // namespace Transport
+} // namespace chip
@@ -0,0 +1,153 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Records the frames passing through a TransportMgrBase into a pcap file, and replays such a file
+ *      into a headless stack.
+ *
+ *      Files use the classic little-endian pcap format with link type LINKTYPE_USER0. Every record starts
+ *      with a fixed-size frame header describing the direction and the peer, followed by the raw Matter
+ *      message exactly as it was handed to or received from the transport:
+ *
+ *          uint8_t  version;        // kPcapFrameHeaderVersion
+ *          uint8_t  direction;      // CaptureDirection
+ *          uint8_t  transportType;  // Transport::Type
+ *          uint8_t  reserved;
+ *          uint16_t port;           // little-endian
+ *          uint16_t reserved;
+ *          uint8_t  address[16];    // IPv6, or IPv4-mapped IPv6, in network byte order
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+
+#include <lib/core/CHIPError.h>
+#include <system/SystemClock.h>
+#include <system/SystemPacketBuffer.h>
+#include <transport/TransportCapture.h>
+#include <transport/raw/PeerAddress.h>
+
+namespace chip {
+
+class TransportMgrBase;
+
+namespace Transport {
+
+inline constexpr uint32_t kPcapLinkTypeUser0     = 147;
+inline constexpr uint8_t kPcapFrameHeaderVersion = 1;
+inline constexpr size_t kPcapFrameHeaderSize     = 24;
+inline constexpr uint32_t kPcapMaxRecordLength   = 262144;
+
+/**
+ * A frame read back from a capture file.
+ */
+struct CapturedFrame
+{
+    CaptureDirection direction = CaptureDirection::kReceived;
+    PeerAddress peerAddress;
+    System::Clock::Microseconds64 timestamp = System::Clock::kZero;
+    System::PacketBufferHandle payload;
+};
+
+/**
+ * Capture delegate writing every frame to a pcap file. Register it with TransportMgrBase::SetCaptureDelegate()
+ * after a successful Open().
+ *
+ * Frames are written synchronously on the Matter thread, through stdio buffering; this is meant for
+ * debugging and benchmarking builds, not for always-on use on constrained devices.
+ */
+class PcapCaptureWriter : public CaptureDelegate
+{
+public:
+    ~PcapCaptureWriter() override { Close(); }
+
+    CHIP_ERROR Open(const char * path);
+    void Close();
+    bool IsOpen() const { return mFile != nullptr; }
+
+    /**
+     * Number of frames written since the file was opened.
+     */
+    uint32_t GetFrameCount() const { return mFrameCount; }
+
+    CHIP_ERROR WriteFrame(CaptureDirection direction, const PeerAddress & peerAddress, System::Clock::Microseconds64 timestamp,
+                          const System::PacketBufferHandle & msg);
+
+    void OnFrameCaptured(CaptureDirection direction, const PeerAddress & peerAddress,
+                         const System::PacketBufferHandle & msg) override;
+
+private:
+    FILE * mFile         = nullptr;
+    uint32_t mFrameCount = 0;
+};
+
+/**
+ * Sequential reader for files written by PcapCaptureWriter.
+ */
+class PcapCaptureReader
+{
+public:
+    ~PcapCaptureReader() { Close(); }
+
+    CHIP_ERROR Open(const char * path);
+    void Close();
+
+    /**
+     * Read the next frame into a newly allocated packet buffer.
+     *
+     * @param[out] frame      The frame read, left untouched at the end of the file.
+     * @param[out] endOfFile  Set to whether no frames were left.
+     *
+     * @retval CHIP_ERROR_INVALID_MESSAGE_LENGTH  The record is truncated or larger than kPcapMaxRecordLength.
+     * @retval CHIP_ERROR_NO_MEMORY    No packet buffer is large enough for the frame.
+     */
+    CHIP_ERROR ReadFrame(CapturedFrame & frame, bool & endOfFile);
+
+private:
+    FILE * mFile = nullptr;
+};
+
+/**
+ * Feeds a capture back into a stack, e.g. one built over the loopback transport with the same session keys
+ * as the captured device, to measure its end-to-end throughput deterministically.
+ */
+class PcapReplayDriver
+{
+public:
+    struct Stats
+    {
+        uint32_t framesReplayed = 0;
+        uint32_t framesSkipped  = 0;
+        uint64_t bytesReplayed  = 0;
+        System::Clock::Microseconds64 elapsed = System::Clock::kZero;
+    };
+
+    /**
+     * Hand every received frame of the capture at `path` to `transportMgr`, back to back and ignoring the
+     * captured timestamps, as if each had just arrived from the transport. Sent frames are skipped; the
+     * stack under test produces its own. Must be called with the stack lock held.
+     *
+     * `stats.elapsed` only covers the time spent in the stack, not the time spent reading the file.
+     */
+    static CHIP_ERROR Replay(const char * path, TransportMgrBase & transportMgr, Stats & stats);
+};
+
+} // namespace Transport
+} // namespace chip
@@ -28,6 +28,7 @@
 #include <transport/CryptoContext.h>
 #include <transport/Session.h>
 #include <transport/SessionMessageCounter.h>
+#include <transport/TrafficCounters.h>
 #include <transport/raw/PeerAddress.h>
 
 namespace chip {
@@ -274,6 +275,10 @@ public:
 
     SessionMessageCounter & GetSessionMessageCounter() { return mSessionMessageCounter; }
 
+    TrafficCounters & GetTrafficCounters() { return mTrafficCounters; }
+
+    const TrafficCounters & GetTrafficCounters() const { return mTrafficCounters; }
+
     // This should be a private API, only meant to be called by SecureSessionTable
     // Session holders to this session may shift to the target session regarding SessionDelegate::GetNewSessionHandlingPolicy.
     // It requires that the target sessoin is also a CASE session, having the same peer and CATs as this session.
@@ -353,6 +358,7 @@ private:
     SessionParameters mRemoteSessionParams;
     CryptoContext mCryptoContext;
     SessionMessageCounter mSessionMessageCounter;
+    TrafficCounters mTrafficCounters;
 };
 
 } // namespace Transport
@@ -18,6 +18,7 @@
 #include "lib/support/CodeUtils.h"
 #include "lib/support/ScopedBuffer.h"
 #include <access/AuthMode.h>
+#include <credentials/FabricTable.h>
 #include <lib/support/Defer.h>
 #include <transport/SecureSession.h>
 #include <transport/SecureSessionTable.h>
@@ -403,5 +404,63 @@ Optional<uint16_t> SecureSessionTable::FindUnusedSessionId()
     return NullOptional;
 }
 
+TrafficCounters SecureSessionTable::GetReleasedTrafficCounters(FabricIndex fabricIndex) const
+{
+#if CHIP_CONFIG_ENABLE_TRAFFIC_COUNTERS
+    for (const auto & released : mReleasedTraffic)
+    {
+        if (released.inUse && released.fabricIndex == fabricIndex)
+        {
+            return released.counters;
+        }
+    }
+#endif // CHIP_CONFIG_ENABLE_TRAFFIC_COUNTERS
+    return TrafficCounters();
+}
+
+void SecureSessionTable::ClearReleasedTrafficCounters(FabricIndex fabricIndex)
+{
+#if CHIP_CONFIG_ENABLE_TRAFFIC_COUNTERS
+    for (auto & released : mReleasedTraffic)
+    {
+        if (released.inUse && released.fabricIndex == fabricIndex)
+        {
+            released = ReleasedTraffic();
+        }
+    }
+#endif // CHIP_CONFIG_ENABLE_TRAFFIC_COUNTERS
+}
+
+void SecureSessionTable::RetainTrafficCounters(const SecureSession & session)
+{
+#if CHIP_CONFIG_ENABLE_TRAFFIC_COUNTERS
+    // A session can outlive its fabric, e.g. the one that carried RemoveFabric; its counters must not
+    // reappear once the fabric's totals were cleared.
+    const FabricIndex fabricIndex = session.GetFabricIndex();
+    VerifyOrReturn(fabricIndex == kUndefinedFabricIndex || mFabricTable == nullptr ||
+                   mFabricTable->FindFabricWithIndex(fabricIndex) != nullptr);
+
+    ReleasedTraffic * freeSlot = nullptr;
+    for (auto & released : mReleasedTraffic)
+    {
+        if (released.inUse && released.fabricIndex == fabricIndex)
+        {
+            released.counters += session.GetTrafficCounters();
+            return;
+        }
+        if (!released.inUse && freeSlot == nullptr)
+        {
+            freeSlot = &released;
+        }
+    }
+
+    // Slots are cleared when fabrics are removed, so this only fails if that was missed.
+    VerifyOrReturn(freeSlot != nullptr, ChipLogError(Inet, "No slot to retain traffic counters of fabric %u", fabricIndex));
+    freeSlot->inUse       = true;
+    freeSlot->fabricIndex = fabricIndex;
+    freeSlot->counters    = session.GetTrafficCounters();
+#endif // CHIP_CONFIG_ENABLE_TRAFFIC_COUNTERS
+}
+
 } // namespace Transport
 } // namespace chip
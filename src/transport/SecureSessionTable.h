@@ -24,6 +24,9 @@
 #include <transport/SecureSession.h>
 
 namespace chip {
+
+class FabricTable;
+
 namespace Transport {
 
 inline constexpr uint16_t kMaxSessionID       = UINT16_MAX;
@@ -43,6 +46,12 @@ public:
 
     void Init() { mNextSessionId = chip::Crypto::GetRandU16(); }
 
+    /**
+     * When set, traffic counters of sessions released on a fabric that is no longer in the given
+     * table are not retained (see GetReleasedTrafficCounters).
+     */
+    void SetFabricTable(const FabricTable * fabricTable) { mFabricTable = fabricTable; }
+
     /**
      * Allocate a new secure session out of the internal resource pool.
      *
@@ -76,7 +85,20 @@ public:
     CHECK_RETURN_VALUE
     Optional<SessionHandle> CreateNewSecureSession(SecureSession::Type secureSessionType, ScopedNodeId sessionEvictionHint);
 
-    void ReleaseSession(SecureSession * session) { mEntries.ReleaseObject(session); }
+    void ReleaseSession(SecureSession * session)
+    {
+        RetainTrafficCounters(*session);
+        mEntries.ReleaseObject(session);
+    }
+
+    /**
+     * Get the summed traffic counters of all sessions released while associated with the given
+     * fabric, since the last ClearReleasedTrafficCounters for it.  PASE sessions, and CASE
+     * sessions released before joining a fabric, are counted under kUndefinedFabricIndex.
+     */
+    TrafficCounters GetReleasedTrafficCounters(FabricIndex fabricIndex) const;
+
+    void ClearReleasedTrafficCounters(FabricIndex fabricIndex);
 
     template <typename Function>
     Loop ForEachSession(Function && function)
@@ -256,9 +278,24 @@ private:
     CHECK_RETURN_VALUE
     Optional<uint16_t> FindUnusedSessionId();
 
-    bool mRunningEvictionLogic = false;
+    void RetainTrafficCounters(const SecureSession & session);
+
+    bool mRunningEvictionLogic       = false;
+    const FabricTable * mFabricTable = nullptr;
     ObjectPool<SecureSession, CHIP_CONFIG_SECURE_SESSION_POOL_SIZE> mEntries;
 
+#if CHIP_CONFIG_ENABLE_TRAFFIC_COUNTERS
+    struct ReleasedTraffic
+    {
+        bool inUse              = false;
+        FabricIndex fabricIndex = kUndefinedFabricIndex;
+        TrafficCounters counters;
+    };
+
+    // One slot per fabric, plus one for sessions without a fabric.
+    ReleasedTraffic mReleasedTraffic[CHIP_CONFIG_MAX_FABRICS + 1];
+#endif // CHIP_CONFIG_ENABLE_TRAFFIC_COUNTERS
+
     size_t GetMaxSessionTableSize() const
     {
 #if CONFIG_BUILD_FOR_HOST_UNIT_TEST
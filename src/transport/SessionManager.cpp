@@ -140,6 +140,7 @@ CHIP_ERROR SessionManager::Init(System::Layer * systemLayer, TransportMgrBase *
     mSessionKeystore       = &sessionKeystore;
 
     mSecureSessions.Init();
+    mSecureSessions.SetFabricTable(fabricTable);
 
     mGlobalUnencryptedMessageCounter.Init();
 
@@ -162,6 +163,7 @@ void SessionManager::Shutdown()
         mFabricTable->RemoveFabricDelegate(this);
         mFabricTable = nullptr;
     }
+    mSecureSessions.SetFabricTable(nullptr);
 
     // Ensure that we don't create new sessions as we iterate our session table.
     mState = State::kNotReady;
@@ -192,6 +194,7 @@ void SessionManager::Shutdown()
 void SessionManager::FabricRemoved(FabricIndex fabricIndex)
 {
     gGroupPeerTable->FabricRemoved(fabricIndex);
+    mSecureSessions.ClearReleasedTrafficCounters(fabricIndex);
 }
 
 CHIP_ERROR SessionManager::PrepareMessage(const SessionHandle & sessionHandle, PayloadHeader & payloadHeader,
@@ -296,7 +299,11 @@ CHIP_ERROR SessionManager::PrepareMessage(const SessionHandle & sessionHandle, P
         sourceNodeId = session->GetLocalScopedNodeId().GetNodeId();
         CryptoContext::BuildNonce(nonce, packetHeader.GetSecurityFlags(), messageCounter, sourceNodeId);
 
-        ReturnErrorOnFailure(SecureMessageCodec::Encrypt(session->GetCryptoContext(), nonce, payloadHeader, packetHeader, message));
+        {
+            Transport::ScopedCryptoTimer cryptoTimer(session->GetTrafficCounters());
+            ReturnErrorOnFailure(
+                SecureMessageCodec::Encrypt(session->GetCryptoContext(), nonce, payloadHeader, packetHeader, message));
+        }
 
 #if CHIP_PROGRESS_LOGGING
         destination = session->GetPeerNodeId();
@@ -459,6 +466,11 @@ CHIP_ERROR SessionManager::SendPreparedMessage(const SessionHandle & sessionHand
     VerifyOrReturnError(!msgBuf.IsNull(), CHIP_ERROR_INVALID_ARGUMENT);
     VerifyOrReturnError(!msgBuf->HasChainedBuffer(), CHIP_ERROR_INVALID_MESSAGE_LENGTH);
 
+    if (sessionHandle->IsSecureSession())
+    {
+        sessionHandle->AsSecureSession()->GetTrafficCounters().OnMessageSent(msgBuf->DataLength());
+    }
+
 #if CHIP_SYSTEM_CONFIG_MULTICAST_HOMING
     if (sessionHandle->GetSessionType() == Transport::Session::SessionType::kGroupOutgoing)
     {
@@ -530,6 +542,20 @@ CHIP_ERROR SessionManager::SendPreparedMessage(const SessionHandle & sessionHand
     return CHIP_ERROR_INCORRECT_STATE;
 }
 
+Transport::TrafficCounters SessionManager::GetPeerTrafficCounters(const ScopedNodeId & peer)
+{
+    Transport::TrafficCounters counters;
+    ForEachMatchingSession(peer, [&counters](auto * session) { counters += session->GetTrafficCounters(); });
+    return counters;
+}
+
+Transport::TrafficCounters SessionManager::GetFabricTrafficCounters(FabricIndex fabricIndex)
+{
+    Transport::TrafficCounters counters = mSecureSessions.GetReleasedTrafficCounters(fabricIndex);
+    ForEachMatchingSession(fabricIndex, [&counters](auto * session) { counters += session->GetTrafficCounters(); });
+    return counters;
+}
+
 void SessionManager::ExpireAllSessions(const ScopedNodeId & node)
 {
     ChipLogDetail(Inet, "Expiring all sessions for node " ChipLogFormatScopedNodeId "!!", ChipLogValueScopedNodeId(node));
@@ -997,8 +1023,15 @@ void SessionManager::SecureUnicastMessageDispatch(const PacketHeader & partialPa
     CryptoContext::BuildNonce(nonce, packetHeader.GetSecurityFlags(), packetHeader.GetMessageCounter(),
                               secureSession->GetSecureSessionType() == SecureSession::Type::kCASE ? secureSession->GetPeerNodeId()
                                                                                                   : kUndefinedNodeId);
-    if (SecureMessageCodec::Decrypt(secureSession->GetCryptoContext(), nonce, payloadHeader, packetHeader, msg) != CHIP_NO_ERROR)
+    Transport::TrafficCounters & trafficCounters = secureSession->GetTrafficCounters();
+    trafficCounters.OnMessageReceived(packetHeader.EncodeSizeBytes() + msg->TotalLength());
+    {
+        Transport::ScopedCryptoTimer cryptoTimer(trafficCounters);
+        err = SecureMessageCodec::Decrypt(secureSession->GetCryptoContext(), nonce, payloadHeader, packetHeader, msg);
+    }
+    if (err != CHIP_NO_ERROR)
     {
+        trafficCounters.OnAuthenticationFailure();
         ChipLogError(Inet, "Secure transport received message, but failed to decode/authenticate it, discarding");
         return;
     }
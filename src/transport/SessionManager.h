@@ -242,6 +242,45 @@ public:
         });
     }
 
+    /**
+     * Get the traffic counters of all secure sessions with the given peer, summed.  Only
+     * sessions that are still allocated are counted.
+     */
+    Transport::TrafficCounters GetPeerTrafficCounters(const ScopedNodeId & peer);
+
+    /**
+     * Get the traffic counters of all secure sessions on the given fabric, summed, including
+     * sessions that were already released.  PASE sessions are counted under kUndefinedFabricIndex.
+     */
+    Transport::TrafficCounters GetFabricTrafficCounters(FabricIndex fabricIndex);
+
+    /**
+     * Call the provided lambda once for each peer with at least one allocated secure session,
+     * with the peer's summed traffic counters (see GetPeerTrafficCounters).
+     *
+     * The lambda takes (const ScopedNodeId & peer, const Transport::TrafficCounters & counters).
+     */
+    template <typename Function>
+    void ForEachPeerTrafficCounters(Function && function)
+    {
+        mSecureSessions.ForEachSession([&](auto * session) {
+            const ScopedNodeId peer = session->GetPeer();
+
+            // Report each peer once, at its first session in the table.
+            bool seenBefore = false;
+            mSecureSessions.ForEachSession([&](auto * other) {
+                seenBefore = (other != session) && (other->GetPeer() == peer);
+                return (other == session || seenBefore) ? Loop::Break : Loop::Continue;
+            });
+
+            if (!seenBefore)
+            {
+                function(peer, GetPeerTrafficCounters(peer));
+            }
+            return Loop::Continue;
+        });
+    }
+
     /**
      * Call the provided lambda on all sessions whose remote side match the logical fabric
      * associated with the provided ScopedNodeId and target the same logical remote node.
@@ -0,0 +1,133 @@
+/*
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <lib/core/CHIPConfig.h>
+#include <system/SystemClock.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace chip {
+namespace Transport {
+
+/**
+ * Lightweight traffic accounting, kept by each SecureSession and
+ * ExchangeContext so that peers and interactions consuming bandwidth or CPU
+ * can be identified.
+ *
+ * Sessions count encrypted messages as sent or received on the wire,
+ * including duplicates and retransmissions. Exchanges count application
+ * payloads only. Updates compile to nothing when
+ * CHIP_CONFIG_ENABLE_TRAFFIC_COUNTERS is 0.
+ */
+class TrafficCounters
+{
+public:
+    void OnMessageSent(size_t length)
+    {
+#if CHIP_CONFIG_ENABLE_TRAFFIC_COUNTERS
+        mMessagesSent++;
+        mBytesSent += length;
+#endif // CHIP_CONFIG_ENABLE_TRAFFIC_COUNTERS
+    }
+
+    void OnMessageReceived(size_t length)
+    {
+#if CHIP_CONFIG_ENABLE_TRAFFIC_COUNTERS
+        mMessagesReceived++;
+        mBytesReceived += length;
+#endif // CHIP_CONFIG_ENABLE_TRAFFIC_COUNTERS
+    }
+
+    void OnRetransmission()
+    {
+#if CHIP_CONFIG_ENABLE_TRAFFIC_COUNTERS
+        mRetransmissions++;
+#endif // CHIP_CONFIG_ENABLE_TRAFFIC_COUNTERS
+    }
+
+    /// A received message could not be decrypted or authenticated.
+    void OnAuthenticationFailure()
+    {
+#if CHIP_CONFIG_ENABLE_TRAFFIC_COUNTERS
+        mAuthenticationFailures++;
+#endif // CHIP_CONFIG_ENABLE_TRAFFIC_COUNTERS
+    }
+
+    void AddCryptoTime(System::Clock::Microseconds64 duration)
+    {
+#if CHIP_CONFIG_ENABLE_TRAFFIC_COUNTERS
+        mCryptoTime += duration;
+#endif // CHIP_CONFIG_ENABLE_TRAFFIC_COUNTERS
+    }
+
+    uint32_t GetMessagesSent() const { return mMessagesSent; }
+    uint32_t GetMessagesReceived() const { return mMessagesReceived; }
+    uint64_t GetBytesSent() const { return mBytesSent; }
+    uint64_t GetBytesReceived() const { return mBytesReceived; }
+    uint32_t GetRetransmissions() const { return mRetransmissions; }
+    uint32_t GetAuthenticationFailures() const { return mAuthenticationFailures; }
+
+    /// Time spent encrypting outgoing and decrypting incoming messages.
+    System::Clock::Microseconds64 GetCryptoTime() const { return mCryptoTime; }
+
+    TrafficCounters & operator+=(const TrafficCounters & other)
+    {
+        mMessagesSent += other.mMessagesSent;
+        mMessagesReceived += other.mMessagesReceived;
+        mBytesSent += other.mBytesSent;
+        mBytesReceived += other.mBytesReceived;
+        mRetransmissions += other.mRetransmissions;
+        mAuthenticationFailures += other.mAuthenticationFailures;
+        mCryptoTime += other.mCryptoTime;
+        return *this;
+    }
+
+private:
+    uint32_t mMessagesSent           = 0;
+    uint32_t mMessagesReceived       = 0;
+    uint64_t mBytesSent              = 0;
+    uint64_t mBytesReceived          = 0;
+    uint32_t mRetransmissions        = 0;
+    uint32_t mAuthenticationFailures = 0;
+    System::Clock::Microseconds64 mCryptoTime{ 0 };
+};
+
+/**
+ * Adds the time elapsed during its lifetime to the crypto time of a
+ * TrafficCounters.
+ */
+class ScopedCryptoTimer
+{
+public:
+#if CHIP_CONFIG_ENABLE_TRAFFIC_COUNTERS
+    explicit ScopedCryptoTimer(TrafficCounters & counters) :
+        mCounters(counters), mStart(System::SystemClock().GetMonotonicMicroseconds64())
+    {}
+    ~ScopedCryptoTimer() { mCounters.AddCryptoTime(System::SystemClock().GetMonotonicMicroseconds64() - mStart); }
+
+private:
+    TrafficCounters & mCounters;
+    System::Clock::Microseconds64 mStart;
+#else
+    explicit ScopedCryptoTimer(TrafficCounters & counters) {}
+#endif // CHIP_CONFIG_ENABLE_TRAFFIC_COUNTERS
+};
+
+} // namespace Transport
+} // namespace chip
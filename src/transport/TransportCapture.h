@@ -0,0 +1,55 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Defines the hook through which TransportMgrBase reports every raw frame it sends or receives,
+ *      e.g. to record production traffic for later replay.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include <system/SystemPacketBuffer.h>
+#include <transport/raw/PeerAddress.h>
+
+namespace chip {
+namespace Transport {
+
+enum class CaptureDirection : uint8_t
+{
+    kReceived = 0, ///< Frame handed up by the transport, before any session processing.
+    kSent     = 1, ///< Frame handed down to the transport, already encoded and encrypted.
+};
+
+class CaptureDelegate
+{
+public:
+    virtual ~CaptureDelegate() = default;
+
+    /**
+     * Called synchronously, on the Matter thread, for every frame passing through the TransportMgrBase
+     * the delegate is registered with. The buffer is only valid for the duration of the call and must not
+     * be modified.
+     */
+    virtual void OnFrameCaptured(CaptureDirection direction, const PeerAddress & peerAddress,
+                                 const System::PacketBufferHandle & msg) = 0;
+};
+
+} // namespace Transport
+} // namespace chip
@@ -25,6 +25,13 @@ namespace chip {
 
 CHIP_ERROR TransportMgrBase::SendMessage(const Transport::PeerAddress & address, System::PacketBufferHandle && msgBuf)
 {
+#if CHIP_CONFIG_TRANSPORT_CAPTURE_ENABLED
+    if (mCaptureDelegate != nullptr && !msgBuf.IsNull())
+    {
+        mCaptureDelegate->OnFrameCaptured(Transport::CaptureDirection::kSent, address, msgBuf);
+    }
+#endif // CHIP_CONFIG_TRANSPORT_CAPTURE_ENABLED
+
     return mTransport->SendMessage(address, std::move(msgBuf));
 }
 
@@ -63,6 +70,9 @@ void TransportMgrBase::Close()
 {
     mSessionManager = nullptr;
     mTransport      = nullptr;
+#if CHIP_CONFIG_TRANSPORT_CAPTURE_ENABLED
+    mCaptureDelegate = nullptr;
+#endif // CHIP_CONFIG_TRANSPORT_CAPTURE_ENABLED
 }
 
 CHIP_ERROR TransportMgrBase::MulticastGroupJoinLeave(const Transport::PeerAddress & address, bool join)
@@ -86,6 +96,13 @@ void TransportMgrBase::HandleMessageReceived(const Transport::PeerAddress & peer
         return;
     }
 
+#if CHIP_CONFIG_TRANSPORT_CAPTURE_ENABLED
+    if (mCaptureDelegate != nullptr)
+    {
+        mCaptureDelegate->OnFrameCaptured(Transport::CaptureDirection::kReceived, peerAddress, msg);
+    }
+#endif // CHIP_CONFIG_TRANSPORT_CAPTURE_ENABLED
+
     if (mSessionManager != nullptr)
     {
         mSessionManager->OnMessageReceived(peerAddress, std::move(msg), ctxt);
@@ -18,6 +18,7 @@
 
 #include <lib/support/CodeUtils.h>
 #include <system/SystemPacketBuffer.h>
+#include <transport/TransportCapture.h>
 #include <transport/raw/Base.h>
 #include <transport/raw/MessageHeader.h>
 #include <transport/raw/PeerAddress.h>
@@ -66,9 +67,20 @@ public:
     void HandleMessageReceived(const Transport::PeerAddress & peerAddress, System::PacketBufferHandle && msg,
                                Transport::MessageTransportContext * ctxt = nullptr) override;
 
+#if CHIP_CONFIG_TRANSPORT_CAPTURE_ENABLED
+    /**
+     * Report every frame sent or received through this manager to the given delegate, or stop reporting
+     * when nullptr is passed.
+     */
+    void SetCaptureDelegate(Transport::CaptureDelegate * delegate) { mCaptureDelegate = delegate; }
+#endif // CHIP_CONFIG_TRANSPORT_CAPTURE_ENABLED
+
 private:
     TransportMgrDelegate * mSessionManager = nullptr;
     Transport::Base * mTransport           = nullptr;
+#if CHIP_CONFIG_TRANSPORT_CAPTURE_ENABLED
+    Transport::CaptureDelegate * mCaptureDelegate = nullptr;
+#endif // CHIP_CONFIG_TRANSPORT_CAPTURE_ENABLED
 };
 
 } // namespace chip
@@ -27,8 +27,10 @@
 #include <inet/InetInterface.h>
 #include <inet/TCPEndPoint.h>
 #include <lib/core/CHIPCore.h>
+#include <system/SystemClock.h>
 #include <transport/raw/PeerAddress.h>
 #include <transport/raw/TCPConfig.h>
+#include <transport/raw/TCPMessageReader.h>
 
 namespace chip {
 namespace Transport {
@@ -56,8 +58,12 @@ struct ActiveTCPConnectionState
     {
         mEndPoint = endPoint;
         mPeerAddr = peerAddr;
-        mReceived = nullptr;
         mAppState = nullptr;
+        mMessageReader.Reset();
+        mMessageReader.SetMaxMessageSize(TCPMessageReader::kMaxMessageSize);
+        mIdle         = false;
+        mReusePending = false;
+        mLastActivity = System::SystemClock().GetMonotonicTimestamp();
     }
 
     void Free()
@@ -68,8 +74,11 @@ struct ActiveTCPConnectionState
         }
         mPeerAddr = PeerAddress::Uninitialized();
         mEndPoint = nullptr;
-        mReceived = nullptr;
         mAppState = nullptr;
+        mMessageReader.Reset();
+        mIdle         = false;
+        mReusePending = false;
+        mGeneration++;
     }
 
     bool InUse() const { return mEndPoint != nullptr; }
@@ -78,14 +87,17 @@ struct ActiveTCPConnectionState
 
     bool IsConnecting() const { return (mEndPoint != nullptr && mConnectionState == TCPState::kConnecting); }
 
+    bool IsIdle() const { return IsConnected() && mIdle; }
+
     // Associated endpoint.
     Inet::TCPEndPoint * mEndPoint;
 
     // Peer Node Address
     PeerAddress mPeerAddr;
 
-    // Buffers received but not yet consumed.
-    System::PacketBufferHandle mReceived;
+    // Splits the received data into messages, and holds the message being received. The longest message accepted, and so
+    // the memory held for it, can be set per connection, e.g. once it is established.
+    TCPMessageReader mMessageReader;
 
     // Current state of the connection
     TCPState mConnectionState;
@@ -100,6 +112,19 @@ struct ActiveTCPConnectionState
     // corresponding application.
     AppTCPConnectionCallbackCtxt * mAppState = nullptr;
 
+    // Set while the connection, released by the upper layer, is kept open for reuse by the next connection attempt to
+    // the same peer.
+    bool mIdle = false;
+
+    // Set while the upper layer waits to be told that its connection attempt was served by an idle connection.
+    bool mReusePending = false;
+
+    // When the connection attempt started, or when the connection last became idle or was taken back into use.
+    System::Clock::Timestamp mLastActivity;
+
+    // Incremented whenever the connection is freed, so that a slot reused by a new connection can be told apart.
+    uint32_t mGeneration = 0;
+
     // KeepAlive interval in seconds
     uint16_t mTCPKeepAliveIntervalSecs = CHIP_CONFIG_TCP_KEEPALIVE_INTERVAL_SECS;
     uint16_t mTCPMaxNumKeepAliveProbes = CHIP_CONFIG_MAX_TCP_KEEPALIVE_PROBES;
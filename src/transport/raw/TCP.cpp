@@ -30,6 +30,7 @@
 #include <lib/support/logging/CHIPLogging.h>
 #include <transport/raw/MessageHeader.h>
 
+#include <algorithm>
 #include <inttypes.h>
 #include <limits>
 
@@ -42,12 +43,9 @@ using namespace chip::Encoding;
 // Packets start with a 32-bit size field.
 constexpr size_t kPacketSizeBytes = 4;
 
-static_assert(System::PacketBuffer::kLargeBufMaxSizeWithoutReserve <= UINT32_MAX, "Cast below could truncate the value");
 static_assert(System::PacketBuffer::kLargeBufMaxSizeWithoutReserve >= kPacketSizeBytes,
               "Large buffer allocation should be large enough to hold the length field");
-
-constexpr uint32_t kMaxTCPMessageSize =
-    static_cast<uint32_t>(System::PacketBuffer::kLargeBufMaxSizeWithoutReserve - kPacketSizeBytes);
+static_assert(kPacketSizeBytes == TCPMessageReader::kLengthFieldSize, "Sent and received messages should be framed alike");
 
 constexpr int kListenBacklogSize = 2;
 
@@ -77,6 +75,7 @@ CHIP_ERROR TCPBase::Init(TcpListenParameters & params)
     VerifyOrExit(mState == TCPState::kNotReady, err = CHIP_ERROR_INCORRECT_STATE);
 
     mEndpointType = params.GetAddressType();
+    mSystemLayer  = &params.GetEndPointManager()->SystemLayer();
 
     // Primary socket endpoint created to help get EndPointManager handle for creating multiple
     // connection endpoints at runtime.
@@ -124,6 +123,12 @@ void TCPBase::Close()
 
     CloseActiveConnections();
 
+    if (mSystemLayer != nullptr)
+    {
+        mSystemLayer->CancelTimer(HandleIdleTimer, this);
+        mSystemLayer->CancelTimer(HandleReusedConnections, this);
+    }
+
     mState = TCPState::kNotReady;
 }
 
@@ -154,11 +159,10 @@ ActiveTCPConnectionState * TCPBase::FindActiveConnection(const PeerAddress & add
         {
             continue;
         }
-        Inet::IPAddress addr;
-        uint16_t port;
-        mActiveConnections[i].mEndPoint->GetPeerInfo(&addr, &port);
 
-        if ((addr == address.GetIPAddress()) && (port == address.GetPort()))
+        // The peer address is recorded when the connection is set up, which saves querying the socket for each message.
+        const PeerAddress & peerAddr = mActiveConnections[i].mPeerAddr;
+        if ((peerAddr.GetIPAddress() == address.GetIPAddress()) && (peerAddr.GetPort() == address.GetPort()))
         {
             return &mActiveConnections[i];
         }
@@ -222,6 +226,9 @@ CHIP_ERROR TCPBase::SendMessage(const Transport::PeerAddress & address, System::
 
     if (connection != nullptr)
     {
+        // Like a message of the peer, sending takes a connection kept open for reuse back into use.
+        connection->mIdle         = false;
+        connection->mLastActivity = System::SystemClock().GetMonotonicTimestamp();
         return connection->mEndPoint->Send(std::move(msgBuf));
     }
 
@@ -256,6 +263,7 @@ CHIP_ERROR TCPBase::StartConnect(const PeerAddress & addr, Transport::AppTCPConn
     ReturnErrorOnFailure(endPoint->Connect(addr.GetIPAddress(), addr.GetPort(), addr.GetInterface()));
 
     mUsedEndPointCount++;
+    mConnectionMetrics.connectAttempts++;
 
     endPointHolder.release();
 
@@ -292,7 +300,7 @@ CHIP_ERROR TCPBase::SendAfterConnect(const PeerAddress & addr, System::PacketBuf
     }
 
     // Ensures sufficient active connections size exist
-    VerifyOrReturnError(mUsedEndPointCount < mActiveConnectionsSize, CHIP_ERROR_NO_MEMORY);
+    VerifyOrReturnError(mUsedEndPointCount < mActiveConnectionsSize || EvictIdleConnection(), CHIP_ERROR_NO_MEMORY);
 
     Transport::ActiveTCPConnectionState * peerConnState = nullptr;
     ReturnErrorOnFailure(StartConnect(addr, nullptr, &peerConnState));
@@ -312,85 +320,38 @@ CHIP_ERROR TCPBase::ProcessReceivedBuffer(Inet::TCPEndPoint * endPoint, const Pe
 {
     ActiveTCPConnectionState * state = FindActiveConnection(endPoint);
     VerifyOrReturnError(state != nullptr, CHIP_ERROR_INTERNAL);
-    state->mReceived.AddToEnd(std::move(buffer));
 
-    while (!state->mReceived.IsNull())
-    {
-        uint8_t messageSizeBuf[kPacketSizeBytes];
-        CHIP_ERROR err = state->mReceived->Read(messageSizeBuf);
-        if (err == CHIP_ERROR_BUFFER_TOO_SMALL)
-        {
-            // We don't have enough data to read the message size. Wait until there's more.
-            return CHIP_NO_ERROR;
-        }
-        if (err != CHIP_NO_ERROR)
-        {
-            return err;
-        }
-        uint32_t messageSize = LittleEndian::Get32(messageSizeBuf);
-        if (messageSize >= kMaxTCPMessageSize)
-        {
-            // Message is too big for this node to process. Disconnect from peer.
-            ChipLogError(Inet, "Received TCP message of length %" PRIu32 " exceeds limit.", messageSize);
-            CloseConnectionInternal(state, CHIP_ERROR_MESSAGE_TOO_LONG, SuppressCallback::No);
+    // The peer uses the connection again, e.g. to set up a new session over it: it is no longer ours to close.
+    state->mIdle         = false;
+    state->mLastActivity = System::SystemClock().GetMonotonicTimestamp();
 
-            return CHIP_ERROR_MESSAGE_TOO_LONG;
-        }
-        // The subtraction will not underflow because we successfully read kPacketSizeBytes.
-        if (messageSize > (state->mReceived->TotalLength() - kPacketSizeBytes))
-        {
-            // We have not yet received the complete message.
-            return CHIP_NO_ERROR;
-        }
-
-        state->mReceived.Consume(kPacketSizeBytes);
-
-        if (messageSize == 0)
-        {
-            // No payload but considered a valid message. Return success to keep the connection alive.
-            return CHIP_NO_ERROR;
-        }
-
-        ReturnErrorOnFailure(ProcessSingleMessage(peerAddress, state, messageSize));
+    ReceiveContext context = { this, &peerAddress, state, state->mGeneration };
+    CHIP_ERROR err         = state->mMessageReader.Feed(std::move(buffer), HandleReceivedMessage, &context);
+    if (err == CHIP_ERROR_MESSAGE_TOO_LONG)
+    {
+        // Message is too big for this node to process. Disconnect from peer.
+        CloseConnectionInternal(state, CHIP_ERROR_MESSAGE_TOO_LONG, SuppressCallback::No);
+    }
+    else if (err == CHIP_ERROR_CONNECTION_CLOSED_UNEXPECTEDLY)
+    {
+        // The upper layer closed the connection: the rest of the data is dropped.
+        return CHIP_NO_ERROR;
     }
 
-    return CHIP_NO_ERROR;
+    return err;
 }
 
-CHIP_ERROR TCPBase::ProcessSingleMessage(const PeerAddress & peerAddress, ActiveTCPConnectionState * state, size_t messageSize)
+CHIP_ERROR TCPBase::HandleReceivedMessage(void * context, System::PacketBufferHandle && message)
 {
-    // We enter with `state->mReceived` containing at least one full message, perhaps in a chain.
-    // `state->mReceived->Start()` currently points to the message data.
-    // On exit, `state->mReceived` will have had `messageSize` bytes consumed, no matter what.
-    System::PacketBufferHandle message;
+    auto * receiveContext = static_cast<ReceiveContext *>(context);
+
     MessageTransportContext msgContext;
-    msgContext.conn = state;
+    msgContext.conn = receiveContext->state;
 
-    if (state->mReceived->DataLength() == messageSize)
-    {
-        // In this case, the head packet buffer contains exactly the message.
-        // This is common because typical messages fit in a network packet, and are delivered as such.
-        // Peel off the head to pass upstream, which effectively consumes it from `state->mReceived`.
-        message = state->mReceived.PopHead();
-    }
-    else
-    {
-        // The message is either longer or shorter than the head buffer.
-        // In either case, copy the message to a fresh linear buffer to pass upstream. We always copy, rather than provide
-        // a shared reference to the current buffer, in case upper layers manipulate the buffer in ways that would affect
-        // our use, e.g. chaining it elsewhere or reusing space beyond the current message.
-        message = System::PacketBufferHandle::New(messageSize, 0);
-        if (message.IsNull())
-        {
-            return CHIP_ERROR_NO_MEMORY;
-        }
-        CHIP_ERROR err = state->mReceived->Read(message->Start(), messageSize);
-        state->mReceived.Consume(messageSize);
-        ReturnErrorOnFailure(err);
-        message->SetDataLength(messageSize);
-    }
+    receiveContext->tcp->HandleMessageReceived(*receiveContext->peerAddress, std::move(message), &msgContext);
 
-    HandleMessageReceived(peerAddress, std::move(message), &msgContext);
+    // The upper layer may have closed the connection, and even opened another one in the same slot.
+    VerifyOrReturnError(receiveContext->state->mGeneration == receiveContext->generation, CHIP_ERROR_CONNECTION_CLOSED_UNEXPECTEDLY);
     return CHIP_NO_ERROR;
 }
 
@@ -491,6 +452,12 @@ void TCPBase::HandleTCPEndPointConnectComplete(Inet::TCPEndPoint * endPoint, CHI
         // Set to Connected state
         activeConnection->mConnectionState = TCPState::kConnected;
 
+        const System::Clock::Milliseconds32 connectTime = std::chrono::duration_cast<System::Clock::Milliseconds32>(
+            System::SystemClock().GetMonotonicTimestamp() - activeConnection->mLastActivity);
+        tcp->mConnectionMetrics.lastConnectTime = connectTime;
+        tcp->mConnectionMetrics.maxConnectTime  = std::max(tcp->mConnectionMetrics.maxConnectTime, connectTime);
+        tcp->mConnectionMetrics.totalConnectTime += connectTime;
+
         // Disable TCP Nagle buffering by setting TCP_NODELAY socket option to true.
         // This is to expedite transmission of payload data and not rely on the
         // network stack's configuration of collating enough data in the TCP
@@ -521,7 +488,8 @@ void TCPBase::HandleTCPEndPointConnectComplete(Inet::TCPEndPoint * endPoint, CHI
         // Set the TCPKeepalive configurations on the established connection
         endPoint->EnableKeepAlive(activeConnection->mTCPKeepAliveIntervalSecs, activeConnection->mTCPMaxNumKeepAliveProbes);
 
-        ChipLogProgress(Inet, "Connection established successfully with %s.", addrStr);
+        ChipLogProgress(Inet, "Connection established successfully with %s in %" PRIu32 " ms.", addrStr,
+                        tcp->mConnectionMetrics.lastConnectTime.count());
 
         // Let higher layer/delegate know that connection is successfully
         // established
@@ -532,6 +500,7 @@ void TCPBase::HandleTCPEndPointConnectComplete(Inet::TCPEndPoint * endPoint, CHI
         ChipLogError(Inet, "Connection establishment with %s encountered an error: %" CHIP_ERROR_FORMAT, addrStr, err.Format());
         endPoint->Free();
         tcp->mUsedEndPointCount--;
+        tcp->mConnectionMetrics.connectFailures++;
     }
 }
 
@@ -568,7 +537,7 @@ void TCPBase::HandleIncomingConnection(Inet::TCPEndPoint * listenEndPoint, Inet:
     endPoint->GetInterfaceId(&interfaceId);
     PeerAddress addr = PeerAddress::TCP(ipAddress, port, interfaceId);
 
-    if (tcp->mUsedEndPointCount < tcp->mActiveConnectionsSize)
+    if (tcp->mUsedEndPointCount < tcp->mActiveConnectionsSize || tcp->EvictIdleConnection())
     {
         activeConnection = tcp->AllocateConnection();
 
@@ -617,10 +586,26 @@ CHIP_ERROR TCPBase::TCPConnect(const PeerAddress & address, Transport::AppTCPCon
     // Verify that PeerAddress AddressType is TCP
     VerifyOrReturnError(address.GetTransportType() == Transport::Type::kTcp, CHIP_ERROR_INVALID_ARGUMENT);
 
-    VerifyOrReturnError(mUsedEndPointCount < mActiveConnectionsSize, CHIP_ERROR_NO_MEMORY);
-
     char addrStr[Transport::PeerAddress::kMaxToStringSize];
     address.ToString(addrStr);
+
+    // Skip the TCP handshake if a connection to the peer is kept open.
+    ActiveTCPConnectionState * connection = FindActiveConnection(address);
+    if (connection != nullptr && connection->IsIdle())
+    {
+        ChipLogProgress(Inet, "Reusing idle connection to peer %s.", addrStr);
+        connection->mIdle         = false;
+        connection->mReusePending = true;
+        connection->mAppState     = appState;
+        *outPeerConnState         = connection;
+        mConnectionMetrics.reusedConnections++;
+
+        // Like for a new connection, the upper layer is told of the completion once this call returns.
+        return mSystemLayer->ScheduleWork(HandleReusedConnections, this);
+    }
+
+    VerifyOrReturnError(mUsedEndPointCount < mActiveConnectionsSize || EvictIdleConnection(), CHIP_ERROR_NO_MEMORY);
+
     ChipLogProgress(Inet, "Connecting to peer %s.", addrStr);
 
     ReturnErrorOnFailure(StartConnect(address, appState, outPeerConnState));
@@ -671,10 +656,116 @@ void TCPBase::TCPDisconnect(Transport::ActiveTCPConnectionState * conn, bool sho
 
     if (conn->IsConnected() && !shouldAbort)
     {
+        if (mIdleConnectionTimeout > System::Clock::kZero)
+        {
+            ReleaseToIdle(conn);
+            return;
+        }
+
         CloseConnectionInternal(conn, CHIP_NO_ERROR, SuppressCallback::Yes);
     }
 }
 
+void TCPBase::ReleaseToIdle(ActiveTCPConnectionState * connection)
+{
+    char addrStr[Transport::PeerAddress::kMaxToStringSize];
+    connection->mPeerAddr.ToString(addrStr);
+    ChipLogProgress(Inet, "Keeping idle connection with peer %s.", addrStr);
+
+    // The upper layer is done with the connection: it must not be called back anymore.
+    connection->mAppState     = nullptr;
+    connection->mReusePending = false;
+    connection->mIdle         = true;
+    connection->mLastActivity = System::SystemClock().GetMonotonicTimestamp();
+
+    ScheduleIdleTimer();
+}
+
+bool TCPBase::EvictIdleConnection()
+{
+    ActiveTCPConnectionState * leastRecentlyUsed = nullptr;
+    for (size_t i = 0; i < mActiveConnectionsSize; i++)
+    {
+        ActiveTCPConnectionState & connection = mActiveConnections[i];
+        if (connection.IsIdle() && (leastRecentlyUsed == nullptr || connection.mLastActivity < leastRecentlyUsed->mLastActivity))
+        {
+            leastRecentlyUsed = &connection;
+        }
+    }
+    VerifyOrReturnValue(leastRecentlyUsed != nullptr, false);
+
+    CloseConnectionInternal(leastRecentlyUsed, CHIP_NO_ERROR, SuppressCallback::Yes);
+    mConnectionMetrics.idleEvictions++;
+    return true;
+}
+
+void TCPBase::ScheduleIdleTimer()
+{
+    const System::Clock::Timestamp now = System::SystemClock().GetMonotonicTimestamp();
+    System::Clock::Timeout nextExpiry  = System::Clock::Timeout::max();
+
+    for (size_t i = 0; i < mActiveConnectionsSize; i++)
+    {
+        const ActiveTCPConnectionState & connection = mActiveConnections[i];
+        if (connection.IsIdle())
+        {
+            const System::Clock::Timestamp expiry = connection.mLastActivity + mIdleConnectionTimeout;
+            nextExpiry = std::min(nextExpiry, (expiry > now) ? System::Clock::Timeout(expiry - now) : System::Clock::kZero);
+        }
+    }
+
+    if (nextExpiry == System::Clock::Timeout::max())
+    {
+        mSystemLayer->CancelTimer(HandleIdleTimer, this);
+        return;
+    }
+
+    // Starting the timer again replaces the previous expiry.
+    LogErrorOnFailure(mSystemLayer->StartTimer(nextExpiry, HandleIdleTimer, this));
+}
+
+void TCPBase::HandleIdleTimer(System::Layer * layer, void * appState)
+{
+    TCPBase * tcp                      = static_cast<TCPBase *>(appState);
+    const System::Clock::Timestamp now = System::SystemClock().GetMonotonicTimestamp();
+
+    for (size_t i = 0; i < tcp->mActiveConnectionsSize; i++)
+    {
+        ActiveTCPConnectionState & connection = tcp->mActiveConnections[i];
+        if (connection.IsIdle() && connection.mLastActivity + tcp->mIdleConnectionTimeout <= now)
+        {
+            tcp->CloseConnectionInternal(&connection, CHIP_NO_ERROR, SuppressCallback::Yes);
+            tcp->mConnectionMetrics.idleTimeouts++;
+        }
+    }
+
+    tcp->ScheduleIdleTimer();
+}
+
+void TCPBase::HandleReusedConnections(System::Layer * layer, void * appState)
+{
+    TCPBase * tcp = static_cast<TCPBase *>(appState);
+
+    for (size_t i = 0; i < tcp->mActiveConnectionsSize; i++)
+    {
+        ActiveTCPConnectionState & connection = tcp->mActiveConnections[i];
+        if (!connection.mReusePending || !connection.IsConnected())
+        {
+            continue;
+        }
+        connection.mReusePending = false;
+
+        if (connection.mAppState == nullptr)
+        {
+            // The upper layer gave up on the connection attempt in the meantime.
+            tcp->ReleaseToIdle(&connection);
+            continue;
+        }
+
+        tcp->HandleConnectionAttemptComplete(&connection, CHIP_NO_ERROR);
+    }
+}
+
 bool TCPBase::HasActiveConnections() const
 {
     for (size_t i = 0; i < mActiveConnectionsSize; i++)
@@ -126,6 +126,23 @@ protected:
     };
 
 public:
+    /**
+     * Counters and timings of the connections initiated by this transport.
+     */
+    struct ConnectionMetrics
+    {
+        uint32_t connectAttempts   = 0; // Connections initiated to peers
+        uint32_t connectFailures   = 0; // Connection attempts that failed, e.g. timed out
+        uint32_t reusedConnections = 0; // Connection attempts served by an idle connection
+        uint32_t idleEvictions     = 0; // Idle connections closed to make room for other connections
+        uint32_t idleTimeouts      = 0; // Idle connections closed once unused for the idle timeout
+
+        // Time taken by the TCP handshake of the established connections.
+        System::Clock::Milliseconds32 lastConnectTime  = System::Clock::kZero;
+        System::Clock::Milliseconds32 maxConnectTime   = System::Clock::kZero;
+        System::Clock::Milliseconds64 totalConnectTime = System::Clock::kZero;
+    };
+
     using PendingPacketPoolType = PoolInterface<PendingPacket, const PeerAddress &, System::PacketBufferHandle &&>;
     TCPBase(ActiveTCPConnectionState * activeConnectionsBuffer, size_t bufferSize, PendingPacketPoolType & packetBuffers) :
         mActiveConnections(activeConnectionsBuffer), mActiveConnectionsSize(bufferSize), mPendingPackets(packetBuffers)
@@ -153,6 +170,15 @@ public:
      */
     void SetConnectTimeout(const uint32_t connTimeoutMsecs) { mConnectTimeout = connTimeoutMsecs; }
 
+    /**
+     * Set how long a connection released by the upper layer, through TCPDisconnect() without abort, is kept open for
+     * reuse by the next TCPConnect() to the same peer. Idle connections are also closed, least recently used first, when
+     * room is needed for other connections. Zero closes connections as soon as they are released.
+     */
+    void SetIdleConnectionTimeout(System::Clock::Seconds16 timeout) { mIdleConnectionTimeout = timeout; }
+
+    const ConnectionMetrics & GetConnectionMetrics() const { return mConnectionMetrics; }
+
     /**
      * Close the open endpoint without destroying the object
      */
@@ -234,6 +260,27 @@ private:
      */
     ActiveTCPConnectionState * FindInUseConnection(const Inet::TCPEndPoint * endPoint);
 
+    /**
+     * Keep a connection released by the upper layer open for reuse, until the idle timeout.
+     */
+    void ReleaseToIdle(ActiveTCPConnectionState * connection);
+
+    /**
+     * Close the least recently used idle connection, if any, to make room for another connection.
+     *
+     * @return true if a connection was closed.
+     */
+    bool EvictIdleConnection();
+
+    // Arms the timer for the next idle connection to expire, if any.
+    void ScheduleIdleTimer();
+
+    // Callback handler for the timer closing the idle connections that expired.
+    static void HandleIdleTimer(System::Layer * layer, void * appState);
+
+    // Callback handler telling the upper layer that its connection attempts were served by idle connections.
+    static void HandleReusedConnections(System::Layer * layer, void * appState);
+
     /**
      * Sends the specified message once a connection has been established.
      *
@@ -258,16 +305,17 @@ private:
     CHIP_ERROR ProcessReceivedBuffer(Inet::TCPEndPoint * endPoint, const PeerAddress & peerAddress,
                                      System::PacketBufferHandle && buffer);
 
-    /**
-     * Process a single message of the specified size from a buffer.
-     *
-     * @param[in]     peerAddress   The peer the data is coming from.
-     * @param[in,out] state         The connection state, which contains the message. On entry, the payload points to the message
-     *                              body (after the length). On exit, it points after the message (or the queue is null, if there
-     *                              is no other data).
-     * @param[in]     messageSize   Size of the single message.
-     */
-    CHIP_ERROR ProcessSingleMessage(const PeerAddress & peerAddress, ActiveTCPConnectionState * state, size_t messageSize);
+    struct ReceiveContext
+    {
+        TCPBase * tcp;
+        const PeerAddress * peerAddress;
+        ActiveTCPConnectionState * state;
+        uint32_t generation;
+    };
+
+    // Hands a message received on a connection over to the upper layer.
+    // @see TCPMessageReader::MessageHandler
+    static CHIP_ERROR HandleReceivedMessage(void * context, System::PacketBufferHandle && message);
 
     /**
      * Initiate a connection to the given peer. On connection completion,
@@ -315,6 +363,13 @@ private:
     // giving up.
     uint32_t mConnectTimeout = CHIP_CONFIG_TCP_CONNECT_TIMEOUT_MSECS;
 
+    // How long connections released by the upper layer are kept open for reuse.
+    System::Clock::Timeout mIdleConnectionTimeout = System::Clock::Seconds16(CHIP_CONFIG_TCP_IDLE_CONNECTION_TIMEOUT_SECS);
+
+    System::Layer * mSystemLayer = nullptr;
+
+    ConnectionMetrics mConnectionMetrics;
+
     // Number of active and 'pending connection' endpoints
     size_t mUsedEndPointCount = 0;
 
@@ -103,6 +103,22 @@ namespace chip {
 #define CHIP_CONFIG_MAX_TCP_KEEPALIVE_PROBES (5)
 #endif // CHIP_CONFIG_MAX_TCP_KEEPALIVE_PROBES
 
+/**
+ *  @def CHIP_CONFIG_TCP_IDLE_CONNECTION_TIMEOUT_SECS
+ *
+ *  @brief
+ *    This defines the default time (in seconds) for which a
+ *    connection released by the upper layer is kept open, so
+ *    that the next connection attempt to the same peer reuses
+ *    it instead of going through the TCP handshake again.
+ *    A value of 0 closes connections as soon as they are
+ *    released.
+ *
+ */
+#ifndef CHIP_CONFIG_TCP_IDLE_CONNECTION_TIMEOUT_SECS
+#define CHIP_CONFIG_TCP_IDLE_CONNECTION_TIMEOUT_SECS (0)
+#endif // CHIP_CONFIG_TCP_IDLE_CONNECTION_TIMEOUT_SECS
+
 /**
  *  @def CHIP_CONFIG_MAX_UNACKED_DATA_TIMEOUT_SECS
  *
@@ -0,0 +1,185 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <transport/raw/TCPMessageReader.h>
+
+#include <lib/core/CHIPEncoding.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+#include <algorithm>
+#include <inttypes.h>
+#include <string.h>
+
+namespace chip {
+namespace Transport {
+
+static_assert(System::PacketBuffer::kLargeBufMaxSizeWithoutReserve <= UINT32_MAX, "Cast below could truncate the value");
+static_assert(System::PacketBuffer::kLargeBufMaxSizeWithoutReserve >= TCPMessageReader::kLengthFieldSize,
+              "Large buffer allocation should be large enough to hold the length field");
+
+CHIP_ERROR TCPMessageReader::Feed(System::PacketBufferHandle && data, MessageHandler handler, void * context)
+{
+    System::PacketBufferHandle chain = std::move(data);
+
+    while (!chain.IsNull())
+    {
+        System::PacketBufferHandle buffer = chain.PopHead();
+
+        // Each step consumes data from the buffer, or takes the buffer over.
+        while (!buffer.IsNull() && buffer->DataLength() > 0)
+        {
+            if (mLengthFieldRead < kLengthFieldSize)
+            {
+                ReturnErrorOnFailure(ReadLengthField(buffer));
+            }
+            else if (mMessage.IsNull())
+            {
+                ReturnErrorOnFailure(StartMessage(buffer, handler, context));
+            }
+            else
+            {
+                ReturnErrorOnFailure(ContinueMessage(buffer, handler, context));
+            }
+        }
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+void TCPMessageReader::Reset()
+{
+    mLengthFieldRead = 0;
+    mMessageSize     = 0;
+    mMessage         = nullptr;
+}
+
+void TCPMessageReader::SetMaxMessageSize(uint32_t maxMessageSize)
+{
+    mMaxMessageSize = std::min(maxMessageSize, kMaxMessageSize);
+}
+
+size_t TCPMessageReader::GetPendingLength() const
+{
+    return mLengthFieldRead + (mMessage.IsNull() ? 0 : mMessage->DataLength());
+}
+
+CHIP_ERROR TCPMessageReader::ReadLengthField(System::PacketBufferHandle & buffer)
+{
+    // The length field may itself be split across buffers.
+    const size_t length = std::min(kLengthFieldSize - mLengthFieldRead, buffer->DataLength());
+    memcpy(mLengthField + mLengthFieldRead, buffer->Start(), length);
+    buffer->ConsumeHead(length);
+    mLengthFieldRead += length;
+    VerifyOrReturnError(mLengthFieldRead == kLengthFieldSize, CHIP_NO_ERROR);
+
+    mMessageSize = Encoding::LittleEndian::Get32(mLengthField);
+    if (mMessageSize > mMaxMessageSize)
+    {
+        // Message is too big for this node to process.
+        ChipLogError(Inet, "Received TCP message of length %" PRIu32 " exceeds limit.", mMessageSize);
+        return CHIP_ERROR_MESSAGE_TOO_LONG;
+    }
+
+    if (mMessageSize == 0)
+    {
+        // No payload but considered a valid message.
+        mLengthFieldRead = 0;
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR TCPMessageReader::StartMessage(System::PacketBufferHandle & buffer, MessageHandler handler, void * context)
+{
+    const size_t available = buffer->DataLength();
+
+    if (available < mMessageSize)
+    {
+        if (buffer->AvailableDataLength() >= mMessageSize - available)
+        {
+            // The rest of the message fits after this part of it.
+            mMessage = std::move(buffer);
+            return CHIP_NO_ERROR;
+        }
+
+        mMessage = System::PacketBufferHandle::New(mMessageSize, 0);
+        VerifyOrReturnError(!mMessage.IsNull(), CHIP_ERROR_NO_MEMORY);
+        return ContinueMessage(buffer, handler, context);
+    }
+
+    const size_t following = available - mMessageSize;
+    System::PacketBufferHandle message;
+
+    if (following == 0)
+    {
+        // This is common because typical messages fit in a network packet, and are delivered as such.
+        message = std::move(buffer);
+        mCounters.zeroCopyMessages++;
+    }
+    else if (following < mMessageSize)
+    {
+        // Hand over this buffer, moving the data that follows the message out of it. The data is moved rather than
+        // shared, in case upper layers reuse the space beyond the message.
+        System::PacketBufferHandle rest = System::PacketBufferHandle::New(following, 0);
+        VerifyOrReturnError(!rest.IsNull(), CHIP_ERROR_NO_MEMORY);
+        memcpy(rest->Start(), buffer->Start() + mMessageSize, following);
+        rest->SetDataLength(following);
+        buffer->SetDataLength(mMessageSize);
+
+        message = std::move(buffer);
+        buffer  = std::move(rest);
+        mCounters.zeroCopyMessages++;
+        mCounters.copiedBytes += following;
+    }
+    else
+    {
+        message = System::PacketBufferHandle::New(mMessageSize, 0);
+        VerifyOrReturnError(!message.IsNull(), CHIP_ERROR_NO_MEMORY);
+        memcpy(message->Start(), buffer->Start(), mMessageSize);
+        message->SetDataLength(mMessageSize);
+        buffer->ConsumeHead(mMessageSize);
+        mCounters.copiedBytes += mMessageSize;
+    }
+
+    return HandOver(std::move(message), handler, context);
+}
+
+CHIP_ERROR TCPMessageReader::ContinueMessage(System::PacketBufferHandle & buffer, MessageHandler handler, void * context)
+{
+    const size_t received = mMessage->DataLength();
+    const size_t length   = std::min(mMessageSize - received, buffer->DataLength());
+    memcpy(mMessage->Start() + received, buffer->Start(), length);
+    mMessage->SetDataLength(received + length);
+    buffer->ConsumeHead(length);
+    mCounters.copiedBytes += length;
+
+    VerifyOrReturnError(mMessage->DataLength() == mMessageSize, CHIP_NO_ERROR);
+    System::PacketBufferHandle message = std::move(mMessage);
+    return HandOver(std::move(message), handler, context);
+}
+
+CHIP_ERROR TCPMessageReader::HandOver(System::PacketBufferHandle && message, MessageHandler handler, void * context)
+{
+    mLengthFieldRead = 0;
+    mCounters.messages++;
+    return handler(context, std::move(message));
+}
+
+} // namespace Transport
+} // namespace chip
@@ -0,0 +1,114 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines the reader that splits the byte stream of a TCP connection into messages.
+ */
+
+#pragma once
+
+#include <lib/core/CHIPError.h>
+#include <system/SystemPacketBuffer.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace chip {
+namespace Transport {
+
+/**
+ * @brief Splits the byte stream received on a TCP connection into the messages it carries, each one preceded by its
+ *        32-bit little-endian length.
+ *
+ * Messages are handed over in the buffers they were received in whenever possible, instead of being copied to a fresh
+ * buffer:
+ *  - A received buffer that holds exactly one message is handed over as is.
+ *  - A received buffer that holds a message followed by more data is split: the smaller of the message and the
+ *    following data is moved to a new buffer.
+ *  - A message split across received buffers is assembled in the first of them if it has enough room, or else in a
+ *    buffer allocated once for the whole message. Received buffers are released as soon as they are consumed, so at
+ *    most one message is held per connection, instead of the whole received chain.
+ */
+class TCPMessageReader
+{
+public:
+    // Messages start with a 32-bit length field.
+    static constexpr size_t kLengthFieldSize = 4;
+
+    // Largest message that fits in a packet buffer.
+    static constexpr uint32_t kMaxMessageSize =
+        static_cast<uint32_t>(System::PacketBuffer::kLargeBufMaxSizeWithoutReserve - kLengthFieldSize);
+
+    /**
+     * Called for each complete message, in order.
+     */
+    using MessageHandler = CHIP_ERROR (*)(void * context, System::PacketBufferHandle && message);
+
+    struct Counters
+    {
+        uint32_t messages         = 0; // Messages handed over
+        uint32_t zeroCopyMessages = 0; // Messages handed over in the buffer they were received in
+        uint64_t copiedBytes      = 0; // Bytes copied between buffers
+    };
+
+    /**
+     * Processes received data, handing over the messages it completes.
+     *
+     * @retval CHIP_ERROR_MESSAGE_TOO_LONG if a message is longer than GetMaxMessageSize(). The connection should be closed,
+     *                                     as the stream cannot be resynchronized.
+     * @retval CHIP_ERROR_NO_MEMORY        if a buffer for a message cannot be allocated.
+     * @return the first error returned by the handler, in which case the rest of the data is discarded.
+     */
+    CHIP_ERROR Feed(System::PacketBufferHandle && data, MessageHandler handler, void * context);
+
+    /**
+     * Discards the partially received message, if any, e.g. once the connection is closed.
+     */
+    void Reset();
+
+    /**
+     * Sets the longest message accepted on the connection, which is also the most memory held for a partially received
+     * message. It cannot exceed kMaxMessageSize.
+     */
+    void SetMaxMessageSize(uint32_t maxMessageSize);
+    uint32_t GetMaxMessageSize() const { return mMaxMessageSize; }
+
+    /**
+     * Returns the number of bytes received of the message in progress, including its length field.
+     */
+    size_t GetPendingLength() const;
+
+    const Counters & GetCounters() const { return mCounters; }
+
+private:
+    CHIP_ERROR ReadLengthField(System::PacketBufferHandle & buffer);
+    CHIP_ERROR StartMessage(System::PacketBufferHandle & buffer, MessageHandler handler, void * context);
+    CHIP_ERROR ContinueMessage(System::PacketBufferHandle & buffer, MessageHandler handler, void * context);
+    CHIP_ERROR HandOver(System::PacketBufferHandle && message, MessageHandler handler, void * context);
+
+    uint8_t mLengthField[kLengthFieldSize];
+    size_t mLengthFieldRead = 0;
+    uint32_t mMessageSize   = 0; // Valid once the length field is read
+    System::PacketBufferHandle mMessage;
+    uint32_t mMaxMessageSize = kMaxMessageSize;
+    Counters mCounters;
+};
+
+} // namespace Transport
+} // namespace chip
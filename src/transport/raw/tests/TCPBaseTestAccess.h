@@ -44,6 +44,20 @@ public:
     {
         return tcp.ProcessReceivedBuffer(endPoint, peerAddress, std::move(buffer));
     }
+
+    // Sums the counters of the message readers of all the connections.
+    static TCPMessageReader::Counters GetReceiveCounters(TCPImpl & tcp)
+    {
+        TCPMessageReader::Counters counters;
+        for (size_t i = 0; i < tcp.mActiveConnectionsSize; i++)
+        {
+            const TCPMessageReader::Counters & connectionCounters = tcp.mActiveConnections[i].mMessageReader.GetCounters();
+            counters.messages += connectionCounters.messages;
+            counters.zeroCopyMessages += connectionCounters.zeroCopyMessages;
+            counters.copiedBytes += connectionCounters.copiedBytes;
+        }
+        return counters;
+    }
 };
 } // namespace Transport
 } // namespace chip
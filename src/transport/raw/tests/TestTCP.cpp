@@ -23,7 +23,9 @@
 
 #include "NetworkTestHelpers.h"
 
+#include <algorithm>
 #include <errno.h>
+#include <inttypes.h>
 #include <stdlib.h>
 #include <string.h>
 #include <utility>
@@ -241,6 +243,41 @@ public:
         EXPECT_EQ(mHandleConnectionCloseCalled, true);
     }
 
+    void IdleConnectionReuseTest(TCPImpl & tcp, const IPAddress & addr, uint16_t port)
+    {
+        tcp.SetIdleConnectionTimeout(chip::System::Clock::Seconds16(1));
+        HandleConnectCompleteCbCalledTest(tcp, addr, port);
+        chip::Transport::ActiveTCPConnectionState * conn = gActiveTCPConnState;
+
+        // The released connection is kept open, and the next connection attempt to the peer is served by it.
+        tcp.TCPDisconnect(conn, /* shouldAbort = */ false);
+        EXPECT_TRUE(tcp.HasActiveConnections());
+
+        mHandleConnectionCompleteCalled = false;
+        CHIP_ERROR err = tcp.TCPConnect(Transport::PeerAddress::TCP(addr, port), &gAppTCPConnCbCtxt, &gActiveTCPConnState);
+        EXPECT_EQ(err, CHIP_NO_ERROR);
+        EXPECT_EQ(gActiveTCPConnState, conn);
+        EXPECT_FALSE(mHandleConnectionCompleteCalled);
+
+        mIOContext->DriveIOUntil(chip::System::Clock::Seconds16(5), [this]() { return mHandleConnectionCompleteCalled; });
+        EXPECT_TRUE(mHandleConnectionCompleteCalled);
+        EXPECT_EQ(tcp.GetConnectionMetrics().connectAttempts, 1u);
+        EXPECT_EQ(tcp.GetConnectionMetrics().reusedConnections, 1u);
+
+        // A message sent to the peer by address also takes the idle connection back into use.
+        tcp.TCPDisconnect(conn, /* shouldAbort = */ false);
+        EXPECT_TRUE(conn->IsIdle());
+        mReceiveHandlerCallCount = 0;
+        SingleMessageTest(tcp, addr, port);
+        EXPECT_FALSE(conn->IsIdle());
+
+        // Released again, the connection is closed once idle for the timeout.
+        tcp.TCPDisconnect(conn, /* shouldAbort = */ false);
+        mIOContext->DriveIOUntil(chip::System::Clock::Seconds16(5), [&tcp]() { return !tcp.HasActiveConnections(); });
+        EXPECT_FALSE(tcp.HasActiveConnections());
+        EXPECT_EQ(tcp.GetConnectionMetrics().idleTimeouts, 1u);
+    }
+
     void DisconnectTest(TCPImpl & tcp, chip::Transport::ActiveTCPConnectionState * conn)
     {
         // Disconnect and wait for seeing peer close
@@ -516,6 +553,17 @@ protected:
         gMockTransportMgrDelegate.DisconnectTest(tcp, addr, port);
     }
 
+    void IdleConnectionTest(const IPAddress & addr)
+    {
+        TCPImpl tcp;
+
+        uint16_t port = GetRandomPort();
+        MockTransportMgrDelegate gMockTransportMgrDelegate(mIOContext);
+        gMockTransportMgrDelegate.InitializeMessageTest(tcp, addr, port);
+        gMockTransportMgrDelegate.IdleConnectionReuseTest(tcp, addr, port);
+        gMockTransportMgrDelegate.DisconnectTest(tcp, addr, port);
+    }
+
     // Callback used by CheckProcessReceivedBuffer.
     static int TestDataCallbackCheck(const uint8_t * message, size_t length, int count, void * data)
     {
@@ -617,6 +665,13 @@ TEST_F(TestTCP, HandleConnCompleteCalledTest4)
     IPAddress::FromString("127.0.0.1", addr);
     HandleConnCompleteTest(addr);
 }
+
+TEST_F(TestTCP, IdleConnectionTest4)
+{
+    IPAddress addr;
+    IPAddress::FromString("127.0.0.1", addr);
+    IdleConnectionTest(addr);
+}
 #endif // INET_CONFIG_ENABLE_IPV4
 
 TEST_F(TestTCP, ConnectToSelfTest6)
@@ -647,6 +702,13 @@ TEST_F(TestTCP, HandleConnCloseCalledTest6)
     HandleConnCloseTest(addr);
 }
 
+TEST_F(TestTCP, IdleConnectionTest6)
+{
+    IPAddress addr;
+    IPAddress::FromString("::1", addr);
+    IdleConnectionTest(addr);
+}
+
 TEST_F(TestTCP, CheckTCPEndpointAfterCloseTest)
 {
     TCPImpl tcp;
@@ -757,4 +819,64 @@ TEST_F(TestTCP, CheckProcessReceivedBuffer)
     EXPECT_EQ(TestAccess::GetEndpoint(state), nullptr);
 }
 
+// Reports the throughput of large messages sent to self over the loopback interface, and how much of them the receiving
+// side had to copy to split the stream into messages.
+TEST_F(TestTCP, CheckLoopbackThroughput)
+{
+    constexpr size_t kMessageCount = 256;
+    constexpr size_t kPayloadSize  = 16 * 1024;
+
+    TCPImpl tcp;
+
+    IPAddress addr;
+    IPAddress::FromString("::1", addr);
+
+    uint16_t port = GetRandomPort();
+    MockTransportMgrDelegate gMockTransportMgrDelegate(mIOContext);
+    gMockTransportMgrDelegate.InitializeMessageTest(tcp, addr, port);
+
+    // Establish the connection first, as the packets sent while connecting are limited.
+    gMockTransportMgrDelegate.SingleMessageTest(tcp, addr, port);
+    gMockTransportMgrDelegate.mReceiveHandlerCallCount = 0;
+    const Transport::TCPMessageReader::Counters before = TestAccess::GetReceiveCounters(tcp);
+
+    PacketHeader header;
+    header.SetSourceNodeId(kSourceNodeId).SetDestinationNodeId(kDestinationNodeId).SetMessageCounter(kMessageCounter);
+
+    // Platforms allocating buffers from a pool may not support buffers this large.
+    System::PacketBufferHandle probe = System::PacketBufferHandle::New(kPayloadSize);
+    if (probe.IsNull() || probe->AvailableDataLength() < kPayloadSize)
+    {
+        gMockTransportMgrDelegate.DisconnectTest(tcp, addr, port);
+        GTEST_SKIP() << "Large packet buffers are not supported";
+    }
+
+    const System::Clock::Timestamp start = System::SystemClock().GetMonotonicTimestamp();
+    for (size_t i = 0; i < kMessageCount; i++)
+    {
+        System::PacketBufferHandle buffer = System::PacketBufferHandle::New(kPayloadSize);
+        ASSERT_FALSE(buffer.IsNull());
+        memset(buffer->Start(), static_cast<int>(i), kPayloadSize);
+        buffer->SetDataLength(kPayloadSize);
+        ASSERT_EQ(header.EncodeBeforeData(buffer), CHIP_NO_ERROR);
+        ASSERT_EQ(tcp.SendMessage(Transport::PeerAddress::TCP(addr, port), std::move(buffer)), CHIP_NO_ERROR);
+    }
+
+    mIOContext->DriveIOUntil(chip::System::Clock::Seconds16(30), [&gMockTransportMgrDelegate]() {
+        return gMockTransportMgrDelegate.mReceiveHandlerCallCount == static_cast<int>(kMessageCount);
+    });
+    const System::Clock::Milliseconds64 elapsed = System::SystemClock().GetMonotonicTimestamp() - start;
+    EXPECT_EQ(gMockTransportMgrDelegate.mReceiveHandlerCallCount, static_cast<int>(kMessageCount));
+
+    const Transport::TCPMessageReader::Counters after = TestAccess::GetReceiveCounters(tcp);
+    const uint64_t totalBytes                         = kMessageCount * kPayloadSize;
+    ChipLogProgress(Inet, "TCP loopback: %u messages of %u bytes in %" PRIu64 " ms, %" PRIu64 " kB/s",
+                    static_cast<unsigned>(kMessageCount), static_cast<unsigned>(kPayloadSize), elapsed.count(),
+                    totalBytes / std::max<uint64_t>(elapsed.count(), 1));
+    ChipLogProgress(Inet, "TCP loopback: %" PRIu32 " messages received without copy, %" PRIu64 " bytes copied",
+                    after.zeroCopyMessages - before.zeroCopyMessages, after.copiedBytes - before.copiedBytes);
+
+    gMockTransportMgrDelegate.DisconnectTest(tcp, addr, port);
+}
+
 } // namespace
@@ -0,0 +1,224 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <transport/raw/TCPMessageReader.h>
+
+#include <lib/core/CHIPEncoding.h>
+#include <lib/core/StringBuilderAdapters.h>
+#include <lib/support/CHIPMem.h>
+#include <pw_unit_test/framework.h>
+
+#include <initializer_list>
+#include <vector>
+
+using namespace chip;
+using namespace chip::Transport;
+
+namespace {
+
+using Bytes = std::vector<uint8_t>;
+
+// Collects the messages handed over by the reader.
+struct Receiver
+{
+    static CHIP_ERROR OnMessage(void * context, System::PacketBufferHandle && message)
+    {
+        auto * receiver = static_cast<Receiver *>(context);
+        receiver->messages.emplace_back(message->Start(), message->Start() + message->DataLength());
+        receiver->starts.push_back(message->Start());
+        return receiver->error;
+    }
+
+    std::vector<Bytes> messages;
+    std::vector<const uint8_t *> starts;
+    CHIP_ERROR error = CHIP_NO_ERROR;
+};
+
+Bytes MakeMessage(size_t length, uint8_t seed)
+{
+    Bytes message(length);
+    for (size_t i = 0; i < length; i++)
+    {
+        message[i] = static_cast<uint8_t>(seed + i);
+    }
+    return message;
+}
+
+// Frames the messages as they are sent on a TCP connection.
+Bytes MakeStream(std::initializer_list<Bytes> messages)
+{
+    Bytes stream;
+    for (const Bytes & message : messages)
+    {
+        uint8_t length[TCPMessageReader::kLengthFieldSize];
+        Encoding::LittleEndian::Put32(length, static_cast<uint32_t>(message.size()));
+        stream.insert(stream.end(), length, length + sizeof(length));
+        stream.insert(stream.end(), message.begin(), message.end());
+    }
+    return stream;
+}
+
+// Splits the stream into a chain of buffers of the given sizes, the last one taking the rest of the stream.
+System::PacketBufferHandle MakeChain(const Bytes & stream, std::initializer_list<size_t> sizes = {})
+{
+    System::PacketBufferHandle chain;
+    size_t offset = 0;
+    auto size     = sizes.begin();
+    while (offset < stream.size())
+    {
+        const size_t length = (size == sizes.end()) ? stream.size() - offset : *size++;
+        chain.AddToEnd(System::PacketBufferHandle::NewWithData(stream.data() + offset, length));
+        offset += length;
+    }
+    return chain;
+}
+
+class TestTCPMessageReader : public ::testing::Test
+{
+public:
+    static void SetUpTestSuite() { ASSERT_EQ(chip::Platform::MemoryInit(), CHIP_NO_ERROR); }
+    static void TearDownTestSuite() { chip::Platform::MemoryShutdown(); }
+};
+
+TEST_F(TestTCPMessageReader, TestSingleMessage)
+{
+    TCPMessageReader reader;
+    Receiver receiver;
+    const Bytes message = MakeMessage(100, 1);
+
+    System::PacketBufferHandle buffer = MakeChain(MakeStream({ message }));
+    const uint8_t * data              = buffer->Start();
+    EXPECT_EQ(reader.Feed(std::move(buffer), Receiver::OnMessage, &receiver), CHIP_NO_ERROR);
+
+    ASSERT_EQ(receiver.messages.size(), 1u);
+    EXPECT_EQ(receiver.messages[0], message);
+
+    // The message is handed over in the buffer it was received in.
+    EXPECT_EQ(receiver.starts[0], data + TCPMessageReader::kLengthFieldSize);
+    EXPECT_EQ(reader.GetCounters().zeroCopyMessages, 1u);
+    EXPECT_EQ(reader.GetCounters().copiedBytes, 0u);
+    EXPECT_EQ(reader.GetPendingLength(), 0u);
+}
+
+TEST_F(TestTCPMessageReader, TestMessagesInOneBuffer)
+{
+    TCPMessageReader reader;
+    Receiver receiver;
+    const Bytes large = MakeMessage(200, 2);
+    const Bytes small = MakeMessage(10, 3);
+
+    // The short message that follows is moved out of the buffer of the long one.
+    System::PacketBufferHandle buffer = MakeChain(MakeStream({ large, small }));
+    const uint8_t * data              = buffer->Start();
+    EXPECT_EQ(reader.Feed(std::move(buffer), Receiver::OnMessage, &receiver), CHIP_NO_ERROR);
+
+    ASSERT_EQ(receiver.messages.size(), 2u);
+    EXPECT_EQ(receiver.messages[0], large);
+    EXPECT_EQ(receiver.messages[1], small);
+    EXPECT_EQ(receiver.starts[0], data + TCPMessageReader::kLengthFieldSize);
+    EXPECT_EQ(reader.GetCounters().zeroCopyMessages, 2u);
+    EXPECT_EQ(reader.GetCounters().copiedBytes, small.size() + TCPMessageReader::kLengthFieldSize);
+
+    // The short message that comes first is copied out of the buffer of the long one.
+    TCPMessageReader reader2;
+    Receiver receiver2;
+    buffer = MakeChain(MakeStream({ small, large }));
+    data   = buffer->Start();
+    EXPECT_EQ(reader2.Feed(std::move(buffer), Receiver::OnMessage, &receiver2), CHIP_NO_ERROR);
+
+    ASSERT_EQ(receiver2.messages.size(), 2u);
+    EXPECT_EQ(receiver2.messages[0], small);
+    EXPECT_EQ(receiver2.messages[1], large);
+    EXPECT_EQ(receiver2.starts[1], data + 2 * TCPMessageReader::kLengthFieldSize + small.size());
+    EXPECT_EQ(reader2.GetCounters().copiedBytes, small.size());
+}
+
+TEST_F(TestTCPMessageReader, TestMessageAcrossBuffers)
+{
+    TCPMessageReader reader;
+    Receiver receiver;
+    const Bytes first  = MakeMessage(300, 4);
+    const Bytes second = MakeMessage(50, 5);
+
+    // The length fields are split across buffers too.
+    const Bytes stream = MakeStream({ first, second });
+    const size_t split = TCPMessageReader::kLengthFieldSize + first.size() + 1;
+    EXPECT_EQ(reader.Feed(MakeChain(Bytes(stream.begin(), stream.begin() + split), { 1, 2, 100, 150 }), Receiver::OnMessage,
+                          &receiver),
+              CHIP_NO_ERROR);
+
+    ASSERT_EQ(receiver.messages.size(), 1u);
+    EXPECT_EQ(receiver.messages[0], first);
+    EXPECT_EQ(reader.GetPendingLength(), 1u);
+
+    // The rest of the stream arrives later.
+    EXPECT_EQ(reader.Feed(MakeChain(Bytes(stream.begin() + split, stream.end()), { 20 }), Receiver::OnMessage, &receiver),
+              CHIP_NO_ERROR);
+
+    ASSERT_EQ(receiver.messages.size(), 2u);
+    EXPECT_EQ(receiver.messages[1], second);
+    EXPECT_EQ(reader.GetCounters().messages, 2u);
+    EXPECT_EQ(reader.GetPendingLength(), 0u);
+}
+
+TEST_F(TestTCPMessageReader, TestEmptyMessage)
+{
+    TCPMessageReader reader;
+    Receiver receiver;
+    const Bytes message = MakeMessage(20, 6);
+
+    EXPECT_EQ(reader.Feed(MakeChain(MakeStream({ Bytes(), message, Bytes() })), Receiver::OnMessage, &receiver), CHIP_NO_ERROR);
+
+    ASSERT_EQ(receiver.messages.size(), 1u);
+    EXPECT_EQ(receiver.messages[0], message);
+    EXPECT_EQ(reader.GetPendingLength(), 0u);
+}
+
+TEST_F(TestTCPMessageReader, TestMessageTooLong)
+{
+    TCPMessageReader reader;
+    Receiver receiver;
+
+    reader.SetMaxMessageSize(64);
+    EXPECT_EQ(reader.GetMaxMessageSize(), 64u);
+    EXPECT_EQ(reader.Feed(MakeChain(MakeStream({ MakeMessage(64, 7) })), Receiver::OnMessage, &receiver), CHIP_NO_ERROR);
+    EXPECT_EQ(reader.Feed(MakeChain(MakeStream({ MakeMessage(65, 8) }), { 8 }), Receiver::OnMessage, &receiver),
+              CHIP_ERROR_MESSAGE_TOO_LONG);
+    EXPECT_EQ(receiver.messages.size(), 1u);
+
+    reader.SetMaxMessageSize(UINT32_MAX);
+    EXPECT_EQ(reader.GetMaxMessageSize(), TCPMessageReader::kMaxMessageSize);
+}
+
+TEST_F(TestTCPMessageReader, TestHandlerError)
+{
+    TCPMessageReader reader;
+    Receiver receiver;
+
+    receiver.error = CHIP_ERROR_INTERNAL;
+    EXPECT_EQ(reader.Feed(MakeChain(MakeStream({ MakeMessage(10, 9), MakeMessage(10, 10) })), Receiver::OnMessage, &receiver),
+              CHIP_ERROR_INTERNAL);
+    EXPECT_EQ(receiver.messages.size(), 1u);
+
+    reader.Reset();
+    receiver.error = CHIP_NO_ERROR;
+    EXPECT_EQ(reader.Feed(MakeChain(MakeStream({ MakeMessage(10, 11) })), Receiver::OnMessage, &receiver), CHIP_NO_ERROR);
+    EXPECT_EQ(receiver.messages.size(), 2u);
+}
+
+} // namespace
@@ -1021,4 +1021,116 @@ TEST_F(TestSessionManager, TestFindSecureSessionForNode)
     sessionManager.Shutdown();
 }
 
+#if CHIP_CONFIG_ENABLE_TRAFFIC_COUNTERS
+TEST_F(TestSessionManager, TrafficCountersTest)
+{
+    IPAddress addr;
+    IPAddress::FromString("::1", addr);
+
+    NodeId aliceNodeId           = 0x11223344ull;
+    NodeId bobNodeId             = 0x12344321ull;
+    FabricIndex aliceFabricIndex = kUndefinedFabricIndex;
+
+    TestSessMgrCallback callback;
+    FabricTableHolder fabricTableHolder;
+    secure_channel::MessageCounterManager messageCounterManager;
+    TestPersistentStorageDelegate deviceStorage;
+    chip::Crypto::DefaultSessionKeystore sessionKeystore;
+    SessionManager sessionManager;
+
+    EXPECT_EQ(CHIP_NO_ERROR, fabricTableHolder.Init());
+    EXPECT_EQ(CHIP_NO_ERROR,
+              sessionManager.Init(&mContext.GetSystemLayer(), &mContext.GetTransportMgr(), &messageCounterManager, &deviceStorage,
+                                  &fabricTableHolder.GetFabricTable(), sessionKeystore));
+    sessionManager.SetMessageDelegate(&callback);
+
+    FabricTable & fabricTable = fabricTableHolder.GetFabricTable();
+    EXPECT_EQ(CHIP_NO_ERROR,
+              fabricTable.AddNewFabricForTestIgnoringCollisions(GetRootACertAsset().mCert, GetIAA1CertAsset().mCert,
+                                                                GetNodeA1CertAsset().mCert, GetNodeA1CertAsset().mKey,
+                                                                &aliceFabricIndex));
+
+    Transport::PeerAddress peer(Transport::PeerAddress::UDP(addr, CHIP_PORT));
+
+    SessionHolder aliceToBobSession;
+    CHIP_ERROR err = sessionManager.InjectCaseSessionWithTestKey(aliceToBobSession, 2, 1, aliceNodeId, bobNodeId, aliceFabricIndex,
+                                                                 peer, CryptoContext::SessionRole::kInitiator);
+    EXPECT_EQ(err, CHIP_NO_ERROR);
+
+    SessionHolder bobToAliceSession;
+    err = sessionManager.InjectCaseSessionWithTestKey(bobToAliceSession, 1, 2, bobNodeId, aliceNodeId, aliceFabricIndex, peer,
+                                                      CryptoContext::SessionRole::kResponder);
+    EXPECT_EQ(err, CHIP_NO_ERROR);
+
+    PayloadHeader payloadHeader;
+    payloadHeader.SetMessageType(chip::Protocols::Echo::MsgType::EchoRequest);
+    payloadHeader.SetInitiator(true);
+
+    EncryptedPacketBufferHandle preparedMessage;
+    err = sessionManager.PrepareMessage(aliceToBobSession.Get().Value(), payloadHeader,
+                                        chip::MessagePacketBuffer::NewWithData(PAYLOAD, sizeof(PAYLOAD)), preparedMessage);
+    EXPECT_EQ(err, CHIP_NO_ERROR);
+    const size_t messageLength = preparedMessage.CastToWritable()->DataLength();
+    EXPECT_GT(messageLength, sizeof(PAYLOAD));
+
+    EXPECT_EQ(sessionManager.SendPreparedMessage(aliceToBobSession.Get().Value(), preparedMessage), CHIP_NO_ERROR);
+    mContext.DrainAndServiceIO();
+    EXPECT_EQ(callback.ReceiveHandlerCallCount, 1);
+
+    const TrafficCounters & sent = aliceToBobSession->AsSecureSession()->GetTrafficCounters();
+    EXPECT_EQ(sent.GetMessagesSent(), 1u);
+    EXPECT_EQ(sent.GetBytesSent(), messageLength);
+    EXPECT_EQ(sent.GetMessagesReceived(), 0u);
+
+    const TrafficCounters & received = bobToAliceSession->AsSecureSession()->GetTrafficCounters();
+    EXPECT_EQ(received.GetMessagesReceived(), 1u);
+    EXPECT_EQ(received.GetBytesReceived(), messageLength);
+    EXPECT_EQ(received.GetAuthenticationFailures(), 0u);
+
+    // Corrupt the MIC: the message is counted but fails authentication.
+    EncryptedPacketBufferHandle badMessage = preparedMessage.CloneData();
+    System::PacketBufferHandle badBuffer   = badMessage.CastToWritable();
+    badBuffer->Start()[badBuffer->DataLength() - 1] ^= 0xFF;
+    badMessage = EncryptedPacketBufferHandle::MarkEncrypted(std::move(badBuffer));
+
+    EXPECT_EQ(sessionManager.SendPreparedMessage(aliceToBobSession.Get().Value(), badMessage), CHIP_NO_ERROR);
+    mContext.DrainAndServiceIO();
+    EXPECT_EQ(callback.ReceiveHandlerCallCount, 1);
+    EXPECT_EQ(received.GetMessagesReceived(), 2u);
+    EXPECT_EQ(received.GetAuthenticationFailures(), 1u);
+
+    // Roll up per peer and per fabric.
+    EXPECT_EQ(sessionManager.GetPeerTrafficCounters(ScopedNodeId(bobNodeId, aliceFabricIndex)).GetMessagesSent(), 2u);
+    EXPECT_EQ(sessionManager.GetPeerTrafficCounters(ScopedNodeId(aliceNodeId, aliceFabricIndex)).GetMessagesReceived(), 2u);
+
+    int peerCount = 0;
+    sessionManager.ForEachPeerTrafficCounters([&](const ScopedNodeId & peerId, const TrafficCounters & counters) {
+        EXPECT_EQ(peerId.GetFabricIndex(), aliceFabricIndex);
+        peerCount++;
+    });
+    EXPECT_EQ(peerCount, 2);
+
+    // Counters of released sessions are kept in the fabric totals.
+    aliceToBobSession->AsSecureSession()->MarkForEviction();
+    EXPECT_FALSE(aliceToBobSession);
+
+    TrafficCounters fabricCounters = sessionManager.GetFabricTrafficCounters(aliceFabricIndex);
+    EXPECT_EQ(fabricCounters.GetMessagesSent(), 2u);
+    EXPECT_EQ(fabricCounters.GetMessagesReceived(), 2u);
+    EXPECT_EQ(fabricCounters.GetAuthenticationFailures(), 1u);
+    EXPECT_EQ(sessionManager.GetPeerTrafficCounters(ScopedNodeId(bobNodeId, aliceFabricIndex)).GetMessagesSent(), 0u);
+
+    // Removing the fabric drops its totals, including those of sessions released later on.
+    EXPECT_EQ(fabricTable.Delete(aliceFabricIndex), CHIP_NO_ERROR);
+    EXPECT_EQ(sessionManager.GetFabricTrafficCounters(aliceFabricIndex).GetMessagesReceived(), 2u);
+
+    bobToAliceSession->AsSecureSession()->MarkForEviction();
+    EXPECT_FALSE(bobToAliceSession);
+    EXPECT_EQ(sessionManager.GetFabricTrafficCounters(aliceFabricIndex).GetMessagesSent(), 0u);
+    EXPECT_EQ(sessionManager.GetFabricTrafficCounters(aliceFabricIndex).GetMessagesReceived(), 0u);
+
+    sessionManager.Shutdown();
+}
+#endif // CHIP_CONFIG_ENABLE_TRAFFIC_COUNTERS
+
 } // namespace